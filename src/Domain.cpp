@@ -791,6 +791,26 @@ void Domain::updateMaxMoleculeID(ParticleContainer* particleContainer, DomainDec
 #endif
 }
 
+const LocalDensity& Domain::getLocalDensity(ParticleContainer* particleContainer, double cutoff, unsigned long simstep)
+{
+	LocalDensityEntry& entry = _localDensities[cutoff];
+	const unsigned long numParticles = particleContainer->getNumberOfParticles(ParticleIterator::ALL_CELLS);
+	if(not entry.valid || entry.particleContainer != particleContainer || entry.simstep != simstep || entry.numParticles != numParticles) {
+		entry.localDensity.bin(particleContainer, cutoff);
+		entry.particleContainer = particleContainer;
+		entry.simstep = simstep;
+		entry.numParticles = numParticles;
+		entry.valid = true;
+	}
+	return entry.localDensity;
+}
+
+void Domain::invalidateLocalDensities()
+{
+	for(auto& entry : _localDensities)
+		entry.second.valid = false;
+}
+
 double Domain::getglobalRho() const { return _globalRho;}
 
 void Domain::setglobalRho(double grho) { _globalRho = grho;}
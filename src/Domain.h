@@ -10,6 +10,7 @@
 #include "molecules/Comp2Param.h"
 #include "molecules/Component.h"
 #include "ensemble/EnsembleBase.h"
+#include "particleContainer/LocalDensity.h"
 #include "utils/CommVar.h"
 /*
  * TODO add comments for variables
@@ -207,6 +208,17 @@ public:
 	//! @brief update max. moleculeID
 	void updateMaxMoleculeID(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp);
 
+	//! @brief local densities of all molecules of the subdomain within the cutoff radius at time step simstep
+	//!
+	//! The molecules are binned once per time step and cutoff radius, so all plugins asking for the same cutoff
+	//! share the binning. It is redone if the number of molecules in the container changed since.
+	const LocalDensity& getLocalDensity(ParticleContainer* particleContainer, double cutoff, unsigned long simstep);
+
+	//! @brief forces the next getLocalDensity to bin the molecules again
+	//!
+	//! Has to be called by everyone changing positions or components of molecules without changing their number.
+	void invalidateLocalDensities();
+
 	//! @brief get the global pressure
 	double getGlobalPressure();
 
@@ -429,6 +441,15 @@ private:
 	//! @todo redundancy?
 	unsigned long _globalNumMolecules;
 	CommVar<uint64_t> _maxMoleculeID;
+	//! binned molecules per cutoff radius, see getLocalDensity
+	struct LocalDensityEntry {
+		LocalDensity localDensity;
+		ParticleContainer* particleContainer = nullptr;
+		unsigned long simstep = 0;
+		unsigned long numParticles = 0;
+		bool valid = false;
+	};
+	std::map<double, LocalDensityEntry> _localDensities;
 	//! side length of the cubic simulation box
 	double _globalLength[3];
 
@@ -46,6 +46,8 @@ void initOptions(optparse::OptionParser *op) {
 	op->add_option("--print-meminfo").dest("print-meminfo").type("bool").action("store_true").set_default(false).help("Print memory consumtion info (default: %default)");
 	op->add_option("--logfile").dest("logfile").type("string").metavar("PREFIX").set_default("MarDyn").help("enable output to logfile using given prefix for the filename (default: %default)");
 	op->add_option("--legacy-cell-processor").dest("legacy-cell-processor").type("bool").action("store_true").set_default(false).help("use legacyCellProcessor (AoS) (default: %default)");
+	op->add_option("--cluster-cell-processor").dest("cluster-cell-processor").type("bool").action("store_true").set_default(false).help("use ClusterPairCellProcessor (SIMD clusters, Lennard-Jones only) (default: %default)");
+	op->add_option("--replay-benchmark").dest("replay-benchmark").type("int").metavar("NUM").set_default(0).help("time the phases of a time step NUM times on the loaded phase space instead of simulating, without plugins (default: %default)");
 	op->add_option("--final-checkpoint").dest("final-checkpoint").type("int").metavar("(1|0)").set_default(1).help("enable/disable final checkopint (default: %default)");
 	op->add_option("--timed-checkpoint").dest("timed-checkpoint").type("float").metavar("TIME").set_default(-1).help("Execution time of the simulation in seconds after which a checkpoint is forced, disable: -1. (default: %default)");
 #ifdef ENABLE_SIGHANDLER
@@ -227,6 +229,15 @@ int main(int argc, char** argv) {
 		simulation.useLegacyCellProcessor();
 		Log::global_log->info() << "--legacy-cell-processor specified, using legacyCellProcessor" << std::endl;
 	}
+	if ( (int) options.get("cluster-cell-processor") > 0 ) {
+		simulation.useClusterCellProcessor();
+		Log::global_log->info() << "--cluster-cell-processor specified, using ClusterPairCellProcessor" << std::endl;
+	}
+
+	if ( (int) options.get("replay-benchmark") > 0 ) {
+		simulation.enableReplayBenchmark(options.get("replay-benchmark").operator unsigned long int());
+		Log::global_log->info() << "--replay-benchmark specified, timing phases instead of simulating" << std::endl;
+	}
 
 	if ( (int) options.get("final-checkpoint") > 0 ) {
 		simulation.enableFinalCheckpoint();
@@ -265,37 +276,42 @@ int main(int argc, char** argv) {
 
 	simulation.prepare_start();
 
-	Timer sim_timer;
-	sim_timer.start();
-	simulation.simulate();
-	sim_timer.stop();
-	double runtime = sim_timer.get_etime();
-	//!@todo time only for simulation.simulate not "main"!
-	Log::global_log->info() << "main: used " << std::fixed << std::setprecision(2) << runtime << " seconds" << std::endl << std::fixed << std::setprecision(5);
-	//  FIXME: The statements "<< std::fixed << std::setprecision(5)" after endl are so that the next logger timestamp appears as expected. A better solution would be nice, of course.
-
-	// print out total simulation speed
-	const unsigned long numTimesteps = simulation.getNumTimesteps() - simulation.getNumInitTimesteps();
-	const double speed = simulation.getTotalNumberOfMolecules() * numTimesteps / runtime;
-	Log::global_log->info() << "Simulation speed: " << std::scientific << std::setprecision(6) << speed << " Molecule-updates per second." << std::endl << std::fixed << std::setprecision(5);
-
-	const double iterationsPerSecond = numTimesteps / runtime;
-	Log::global_log->info() << "Iterations per second: " << std::fixed << std::setprecision(3) << iterationsPerSecond << std::endl << std::fixed << std::setprecision(5);
-	Log::global_log->info() << "Time per iteration: " << std::fixed << std::setprecision(3) << 1.0 / iterationsPerSecond << " seconds." << std::endl << std::fixed << std::setprecision(5);
-
-	double resources = runtime / 3600.0;
+	if (simulation.replayBenchmarkEnabled()) {
+		simulation.replayBenchmark();
+		simulation.finalize();
+	} else {
+		Timer sim_timer;
+		sim_timer.start();
+		simulation.simulate();
+		sim_timer.stop();
+		double runtime = sim_timer.get_etime();
+		//!@todo time only for simulation.simulate not "main"!
+		Log::global_log->info() << "main: used " << std::fixed << std::setprecision(2) << runtime << " seconds" << std::endl << std::fixed << std::setprecision(5);
+		//  FIXME: The statements "<< std::fixed << std::setprecision(5)" after endl are so that the next logger timestamp appears as expected. A better solution would be nice, of course.
+
+		// print out total simulation speed
+		const unsigned long numTimesteps = simulation.getNumTimesteps() - simulation.getNumInitTimesteps();
+		const double speed = simulation.getTotalNumberOfMolecules() * numTimesteps / runtime;
+		Log::global_log->info() << "Simulation speed: " << std::scientific << std::setprecision(6) << speed << " Molecule-updates per second." << std::endl << std::fixed << std::setprecision(5);
+
+		const double iterationsPerSecond = numTimesteps / runtime;
+		Log::global_log->info() << "Iterations per second: " << std::fixed << std::setprecision(3) << iterationsPerSecond << std::endl << std::fixed << std::setprecision(5);
+		Log::global_log->info() << "Time per iteration: " << std::fixed << std::setprecision(3) << 1.0 / iterationsPerSecond << " seconds." << std::endl << std::fixed << std::setprecision(5);
+
+		double resources = runtime / 3600.0;
 #if defined(_OPENMP)
-	resources *= mardyn_get_max_threads();
+		resources *= mardyn_get_max_threads();
 #endif
 
 #ifdef ENABLE_MPI
-	int world_size = 1;
-	MPI_CHECK(MPI_Comm_size(MPI_COMM_WORLD, &world_size));
-	resources *= world_size;
+		int world_size = 1;
+		MPI_CHECK(MPI_Comm_size(MPI_COMM_WORLD, &world_size));
+		resources *= world_size;
 #endif
-	Log::global_log->info() << "Used resources: " << std::fixed << std::setprecision(3) << resources << " core-hours" << std::endl << std::fixed << std::setprecision(5);
+		Log::global_log->info() << "Used resources: " << std::fixed << std::setprecision(3) << resources << " core-hours" << std::endl << std::fixed << std::setprecision(5);
 
-	simulation.finalize();
+		simulation.finalize();
+	}
 
 	} // End of scope to exclude MPI_Init() and MPI_Finalize()
 
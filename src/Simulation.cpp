@@ -2,6 +2,7 @@
 #include "Simulation.h"
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <iomanip>
 #include <iostream>
@@ -20,6 +21,8 @@
 
 #ifdef MARDYN_AUTOPAS
 #include "particleContainer/AutoPasContainer.h"
+#else
+#include "particleContainer/TraversalTuner.h"
 #endif
 
 #include "parallel/DomainDecompBase.h"
@@ -37,6 +40,7 @@
 #include "particleContainer/adapter/ParticlePairs2PotForceAdapter.h"
 #include "particleContainer/adapter/LegacyCellProcessor.h"
 #include "particleContainer/adapter/VectorizedCellProcessor.h"
+#include "particleContainer/adapter/ClusterPairCellProcessor.h"
 #include "particleContainer/adapter/VCP1CLJRMM.h"
 #include "integrators/Integrator.h"
 #include "integrators/Leapfrog.h"
@@ -73,10 +77,12 @@
 #include "utils/FileUtils.h"
 #include "utils/Logger.h"
 #include "utils/mardyn_assert.h"
+#include "utils/PhaseTimings.h"
 
 #include "longRange/LongRangeCorrection.h"
 #include "longRange/Homogeneous.h"
 #include "longRange/Planar.h"
+#include "longRange/Cylindrical.h"
 #include "longRange/NoLRC.h"
 
 #include "bhfmm/FastMultipoleMethod.h"
@@ -595,6 +601,13 @@ void Simulation::readXML(XMLfileUnits& xmlconfig) {
 				_longRangeCorrection = new Planar(_cutoffRadius, _LJCutoffRadius, _domain, _domainDecomposition, _moleculeContainer, nSlabs, global_simulation);
 				_longRangeCorrection->readXML(xmlconfig);
 			}
+			else if("cylindrical" == type)
+			{
+				delete _longRangeCorrection;
+				Log::global_log->info() << "Initializing cylindrical LRC." << std::endl;
+				_longRangeCorrection = new Cylindrical(_cutoffRadius, _LJCutoffRadius, _domain, _domainDecomposition, _moleculeContainer, global_simulation);
+				_longRangeCorrection->readXML(xmlconfig);
+			}
 			else if("homogeneous" == type)
 			{
 				delete _longRangeCorrection;
@@ -609,10 +622,14 @@ void Simulation::readXML(XMLfileUnits& xmlconfig) {
 			else
 			{
 				std::ostringstream error_message;
-				error_message << "LongRangeCorrection: Wrong type. Expected type == homogeneous|planar|none. Program exit ..." << std::endl;
+				error_message << "LongRangeCorrection: Wrong type. Expected type == homogeneous|planar|cylindrical|none. Program exit ..." << std::endl;
 				MARDYN_EXIT(error_message.str());
 			}
 			xmlconfig.changecurrentnode("..");
+		} else if (not _ensemble->getTabulatedPotentials().empty()) {
+			delete _longRangeCorrection;
+			Log::global_log->warning() << "No LRC was defined, using none, as the LRCs do not support tabulated potentials." << std::endl;
+			_longRangeCorrection = new NoLRC(_cutoffRadius, _LJCutoffRadius, _domain, global_simulation);
 		} else {
 			delete _longRangeCorrection;
 			Log::global_log->info() << "Initializing default homogeneous LRC, as no LRC was defined." << std::endl;
@@ -848,10 +865,39 @@ void Simulation::prepare_start() {
 	Log::global_log->info() << "Initializing simulation" << std::endl;
 
 	Log::global_log->info() << "Initialising cell processor" << std::endl;
+#if defined(ENABLE_REDUCED_MEMORY_MODE) or defined(MARDYN_AUTOPAS)
+	// AutoPas computes the forces with its own functor, which only knows the LJ parameters
+	const bool tabulatedSupported = false;
+#else
+	const bool tabulatedSupported = !_legacyCellProcessor;
+#endif
+	if (not _ensemble->getTabulatedPotentials().empty()) {
+		if (not tabulatedSupported) {
+			std::ostringstream error_message;
+			error_message << "Tabulated potentials are only supported by the vectorized cell processor without AutoPas." << std::endl;
+			MARDYN_EXIT(error_message.str());
+		}
+		// the LRCs integrate the LJ parameters of Domain::getComp2Params(), which tabulated potentials replace
+		if (dynamic_cast<NoLRC*>(_longRangeCorrection) == nullptr) {
+			std::ostringstream error_message;
+			error_message << "Tabulated potentials do not support long range corrections, use <longrange type=\"none\"/>." << std::endl;
+			MARDYN_EXIT(error_message.str());
+		}
+	}
 	if (!_legacyCellProcessor) {
 #ifndef ENABLE_REDUCED_MEMORY_MODE
-		Log::global_log->info() << "Using vectorized cell processor." << std::endl;
-		_cellProcessor = new VectorizedCellProcessor( *_domain, _cutoffRadius, _LJCutoffRadius);
+		if (_clusterCellProcessor) {
+			Log::global_log->info() << "Using cluster pair cell processor." << std::endl;
+			_cellProcessor = new ClusterPairCellProcessor( *_domain, _cutoffRadius, _LJCutoffRadius);
+#ifndef MARDYN_AUTOPAS
+			if (auto* linkedCells = dynamic_cast<LinkedCells*>(_moleculeContainer)) {
+				linkedCells->setCellSorting(true);
+			}
+#endif
+		} else {
+			Log::global_log->info() << "Using vectorized cell processor." << std::endl;
+			_cellProcessor = new VectorizedCellProcessor( *_domain, _cutoffRadius, _LJCutoffRadius);
+		}
 #else
 		Log::global_log->info() << "Using reduced memory mode (RMM) cell processor." << std::endl;
 		_cellProcessor = new VCP1CLJRMM( *_domain, _cutoffRadius, _LJCutoffRadius);
@@ -950,6 +996,11 @@ void Simulation::prepare_start() {
 	if(nullptr != _temperatureControl)
 		_temperatureControl->prepare_start();  // Has to be called before plugin initialization (see below): plugin->init(...)
 
+	if (replayBenchmarkEnabled() and not _plugins.empty()) {
+		Log::global_log->info() << "Replay benchmark: plugins are not used" << std::endl;
+		_plugins.remove_if([](PluginBase * plugin) { delete plugin; return true; });
+	}
+
 	// initializing plugins and starting plugin timers
 	for (auto& plugin : _plugins) {
 		Log::global_log->info() << "Initializing plugin " << plugin->getPluginName() << std::endl;
@@ -1007,6 +1058,145 @@ void Simulation::simulate() {
 	postSimLoopSteps();
 }
 
+void Simulation::replayBenchmark() {
+	const unsigned long repetitions = _replayBenchmarkRepetitions;
+	Log::global_log->info() << "Replay benchmark: running each phase " << repetitions << " times after one warm-up run"
+							<< std::endl;
+
+	PhaseTimings timings;
+	Timer timer;
+	// the barrier keeps the time spent waiting for other ranks in the previous phase out of the sample
+	auto sample = [&](const std::string& phase, unsigned long repetition, auto&& run) {
+		_domainDecomposition->barrier();
+		timer.reset();
+		timer.start();
+		run();
+		timer.stop();
+		if (repetition > 0) {
+			timings.add(phase, timer.get_etime());
+		}
+	};
+	// the traversal of prepare_start() has selected the traversal
+	const bool forceExchange = _moleculeContainer->requiresForceExchange();
+
+	for (unsigned long i = 0; i <= repetitions; ++i) {
+#ifndef MARDYN_AUTOPAS
+		_moleculeContainer->deleteOuterParticles();
+#endif
+		sample("container update", i, [&] { _moleculeContainer->update(); });
+		// as in the simulation, dynamic decompositions might rebalance according to their configuration
+		sample("molecule exchange", i, [&] {
+			_domainDecomposition->balanceAndExchange(1.0, false, _moleculeContainer, _domain);
+			_domainDecomposition->removeNonPeriodicHalos(_moleculeContainer);
+		});
+		sample("cache update", i, [&] { _moleculeContainer->updateMoleculeCaches(); });
+	}
+
+	_cellProcessor->setCalculateMacroscopic(true);
+	auto traverse = [&] { _moleculeContainer->traverseCells(*_cellProcessor); };
+#ifndef MARDYN_AUTOPAS
+	auto* linkedCells = dynamic_cast<LinkedCells*>(_moleculeContainer);
+	if (linkedCells != nullptr and not forceExchange) {
+		// all traversals computing the interactions of the owned molecules without force exchange
+		using Tuner = TraversalTuner<ParticleCell>;
+		Tuner& tuner = linkedCells->getTraversalTuner();
+		const auto configured = tuner.getSelectedTraversal();
+		const std::array<Tuner::traversalNames, 4> names = {Tuner::ORIGINAL, Tuner::C08, Tuner::C04,
+																	 Tuner::SLICED};
+		// applicability depends on the local cell dims, but every rank has to time the same traversals,
+		// as each sample starts with a barrier
+		std::array<int, 4> applicable;
+		for (size_t t = 0; t < names.size(); ++t) {
+			applicable[t] = tuner.isTraversalApplicable(names[t]) ? 1 : 0;
+		}
+#ifdef ENABLE_MPI
+		MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, applicable.data(), static_cast<int>(applicable.size()), MPI_INT,
+								MPI_LAND, _domainDecomposition->getCommunicator()));
+#endif
+		for (size_t t = 0; t < names.size(); ++t) {
+			if (not applicable[t]) {
+				continue;
+			}
+			const auto name = names[t];
+			tuner.selectTraversal(name);
+			const std::string phase = "traversal " + Tuner::getTraversalName(name);
+			for (unsigned long i = 0; i <= repetitions; ++i) {
+				sample(phase, i, traverse);
+			}
+		}
+		tuner.selectTraversal(configured);
+	} else
+#endif
+	{
+		for (unsigned long i = 0; i <= repetitions; ++i) {
+			sample("traversal", i, traverse);
+		}
+	}
+
+	if (forceExchange) {
+		for (unsigned long i = 0; i <= repetitions; ++i) {
+			sample("force exchange", i, [&] { _domainDecomposition->exchangeForces(_moleculeContainer, _domain); });
+		}
+	}
+
+	if (_FMM != nullptr) {
+		for (unsigned long i = 0; i <= repetitions; ++i) {
+			sample("FMM", i, [&] { _FMM->computeElectrostatics(_moleculeContainer); });
+		}
+	}
+
+	for (unsigned long i = 0; i <= repetitions; ++i) {
+		sample("global values", i, [&] {
+			_domain->calculateGlobalValues(_domainDecomposition, _moleculeContainer, true, 1.0);
+		});
+	}
+
+	// count, mean, min, median, p90, max of each phase, gathered on the root
+	const auto& phases = timings.getPhases();
+	constexpr int numValues = 6;
+	std::vector<double> local;
+	for (const auto& phase : phases) {
+		const auto summary = timings.getSummary(phase);
+		local.insert(local.end(), {static_cast<double>(summary.count), summary.mean, summary.min, summary.median,
+								   summary.p90, summary.max});
+	}
+	const int numProcs = _domainDecomposition->getNumProcs();
+#ifdef ENABLE_MPI
+	std::vector<double> all(local.size() * numProcs);
+	const int count = static_cast<int>(local.size());
+	int minCount = count, maxCount = count;
+	MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, &minCount, 1, MPI_INT, MPI_MIN, _domainDecomposition->getCommunicator()));
+	MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, &maxCount, 1, MPI_INT, MPI_MAX, _domainDecomposition->getCommunicator()));
+	if (minCount != maxCount) {
+		std::ostringstream error_message;
+		error_message << "Replay benchmark: the ranks timed different numbers of phases (" << minCount / numValues << " to "
+					  << maxCount / numValues << ")." << std::endl;
+		MARDYN_EXIT(error_message.str());
+	}
+	MPI_CHECK(MPI_Gather(local.data(), count, MPI_DOUBLE, all.data(), count, MPI_DOUBLE, 0,
+						 _domainDecomposition->getCommunicator()));
+#else
+	const std::vector<double>& all = local;
+#endif
+
+	Log::global_log->info() << "Replay benchmark results in seconds:" << std::endl;
+	Log::global_log->info() << std::left << std::setw(22) << "phase" << std::right << std::setw(6) << "rank"
+							<< std::setw(8) << "runs" << std::setw(13) << "mean" << std::setw(13) << "min"
+							<< std::setw(13) << "median" << std::setw(13) << "p90" << std::setw(13) << "max"
+							<< std::endl;
+	for (size_t p = 0; p < phases.size(); ++p) {
+		for (int rank = 0; rank < numProcs; ++rank) {
+			const double* values = &all[(rank * phases.size() + p) * numValues];
+			Log::global_log->info() << std::left << std::setw(22) << phases[p] << std::right << std::setw(6) << rank
+									<< std::setw(8) << static_cast<unsigned long>(values[0]) << std::scientific
+									<< std::setprecision(4) << std::setw(13) << values[1] << std::setw(13)
+									<< values[2] << std::setw(13) << values[3] << std::setw(13) << values[4]
+									<< std::setw(13) << values[5] << std::endl
+									<< std::fixed << std::setprecision(5);
+		}
+	}
+}
+
 void Simulation::preSimLoopSteps()
 {
 	//sanity checks
@@ -1136,6 +1326,10 @@ void Simulation::simulateOneTimestep()
 #endif
 
 	double startEtime = global_simulation->timers()->getTimer("SIMULATION_COMPUTATION")->get_etime();
+	// both branches traverse the cells, the overlapping one from within NonBlockingMPIMultiStepHandler
+	_cellProcessor->setCalculateMacroscopic(macroscopicValuesRequired(_simstep));
+	// the container update moves the molecules, so local densities binned before point to stale molecules
+	_domain->invalidateLocalDensities();
 	if (overlapCommComp) {
 		double currentTime = _timerForLoad->get_etime();
 		performOverlappingDecompositionAndCellTraversalStep(currentTime - previousTimeForLoad);
@@ -1365,6 +1559,18 @@ void Simulation::postSimLoopSteps()
 	postSimLoopStepsDone = true;
 }
 
+bool Simulation::macroscopicValuesRequired(unsigned long simstep) {
+	if (_ensemble->requiresMacroscopicValues(simstep)) {
+		return true;
+	}
+	for (auto plugin : _plugins) {
+		if (plugin->requiresMacroscopicValues(simstep)) {
+			return true;
+		}
+	}
+	return false;
+}
+
 void Simulation::pluginEndStepCall(unsigned long simstep) {
 
 	std::list<PluginBase*>::iterator pluginIter;
@@ -1380,11 +1586,18 @@ void Simulation::pluginEndStepCall(unsigned long simstep) {
 	if (_domain->thermostatWarning())
 		Log::global_log->warning() << "Thermostat!" << std::endl;
 	/* TODO: thermostat */
-	Log::global_log->info() << "Simstep = " << simstep << "\tT = "
-					   << _domain->getGlobalCurrentTemperature() << "\tU_pot = "
-					   << _domain->getGlobalUpot() << "\tp = "
-					   << _domain->getGlobalPressure() << std::endl;
-	if (std::isnan(_domain->getGlobalCurrentTemperature()) || std::isnan(_domain->getGlobalUpot()) || std::isnan(_domain->getGlobalPressure())) {
+	// potential energy and pressure are only available on steps on which they were requested
+	const bool macroscopic = _cellProcessor->getCalculateMacroscopic();
+	if (macroscopic) {
+		Log::global_log->info() << "Simstep = " << simstep << "\tT = "
+						   << _domain->getGlobalCurrentTemperature() << "\tU_pot = "
+						   << _domain->getGlobalUpot() << "\tp = "
+						   << _domain->getGlobalPressure() << std::endl;
+	} else {
+		Log::global_log->info() << "Simstep = " << simstep << "\tT = "
+						   << _domain->getGlobalCurrentTemperature() << std::endl;
+	}
+	if (std::isnan(_domain->getGlobalCurrentTemperature()) || (macroscopic && (std::isnan(_domain->getGlobalUpot()) || std::isnan(_domain->getGlobalPressure())))) {
 		std::ostringstream error_message;
 		error_message << "NaN detected, exiting." << std::endl;
 		MARDYN_EXIT(error_message.str());
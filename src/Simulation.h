@@ -9,6 +9,7 @@
 #include "utils/FixedSizeQueue.h"
 #include "utils/FunctionWrapper.h"
 #include "utils/SysMon.h"
+#include "utils/MemoryPool.h"
 #include "utils/Random.h"
 
 
@@ -173,6 +174,17 @@ public:
 	 */
 	void simulate();
 
+	/** @brief Time the phases of a time step repeatedly on the prepared phase space instead of simulating.
+	 *
+	 * To be called after prepare_start(). Container update, molecule exchange, cache update, cell traversal,
+	 * force exchange (if required), FMM and the calculation of the global values are each run the number of
+	 * repetitions set by enableReplayBenchmark(), after one warm-up run which is not recorded. The cell traversal is
+	 * timed with each LinkedCells traversal computing the same interactions as the configured one. The molecules
+	 * are not moved and the simulation time does not advance. Mean, minimum, median, 90th percentile and maximum
+	 * of each phase are logged for every rank.
+	 */
+	void replayBenchmark();
+
 	/** @brief call plugins every nth-simstep
 	 *
 	 * The present method serves as a redirection to the actual plugins.
@@ -183,6 +195,12 @@ public:
 	 */
 	void pluginEndStepCall(unsigned long simstep);
 
+	/** @brief Whether the ensemble or any plugin needs potential energy and virial of time step simstep.
+	 *
+	 * On other steps the force kernels skip their computation.
+	 */
+	bool macroscopicValuesRequired(unsigned long simstep);
+
 	/** @brief clean up simulation */
 	void finalize();
 
@@ -421,10 +439,17 @@ public:
 
 	void useLegacyCellProcessor() { _legacyCellProcessor = true; }
 
+	void useClusterCellProcessor() { _clusterCellProcessor = true; }
+
+	/** Run replayBenchmark() with the given number of repetitions instead of simulate(), plugins are not initialized. */
+	void enableReplayBenchmark(unsigned long repetitions) { _replayBenchmarkRepetitions = repetitions; }
+	bool replayBenchmarkEnabled() const { return _replayBenchmarkRepetitions > 0; }
+
 	void enableMemoryProfiler() {
 		_memoryProfiler = std::make_shared<MemoryProfiler>();
 		_memoryProfiler->registerObject(reinterpret_cast<MemoryProfilable**>(&_moleculeContainer));
 		_memoryProfiler->registerObject(reinterpret_cast<MemoryProfilable**>(&_domainDecomposition));
+		_memoryProfiler->registerObject(MemoryPool::profilable());
 	}
 
 	void setForcedCheckpointTime(double time) { _forced_checkpoint_time = time; }
@@ -475,6 +500,11 @@ private:
 	/** use legacyCellProcessor instead of vectorizedCellProcessor */
 	bool _legacyCellProcessor = false;
 
+	bool _clusterCellProcessor = false;
+
+	/** repetitions of each phase in replayBenchmark(), 0 for a regular simulation */
+	unsigned long _replayBenchmarkRepetitions = 0;
+
 	/**
 	 * Specifies whether to use overlapping p2p (peer-to-peer) communication or not.
 	 * If false: overlapping is only performed for unpacking and packing of particles.
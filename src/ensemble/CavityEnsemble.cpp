@@ -1,12 +1,20 @@
 
 #include "CavityEnsemble.h"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+#include "WrapOpenMP.h"
 #include "parallel/DomainDecompBase.h"
 #include "utils/Logger.h"
 #include "molecules/Quaternion.h"
 #include "utils/mardyn_assert.h"
 #include "particleContainer/ParticleContainer.h"
 
+#include <vector>
+
 #define COMMUNICATION_THRESHOLD 3
 
 CavityEnsemble::CavityEnsemble() {
@@ -35,8 +43,14 @@ CavityEnsemble::CavityEnsemble() {
     control_top[1] = 1.0;
     control_top[2] = 1.0;
 
-    this->active = std::set<unsigned long>();
-    this->reservoir = std::map<unsigned long, Molecule *>();
+    this->latticeSize[0] = 0;
+    latticeSize[1] = 0;
+    latticeSize[2] = 0;
+    for (int d = 0; d < 3; d++) {
+        this->latticeMin[d] = 0;
+        this->latticeMax[d] = -1;
+    }
+    this->localActive = 0;
     this->globalActive = 0;
 
     this->boundarySpecified = false;
@@ -63,7 +77,7 @@ void CavityEnsemble::setSystem(double x, double y, double z, int maxNeighbors, f
 
 void CavityEnsemble::setSubdomain(int rank, double x0, double x1, double y0, double y1, double z0, double z1) {
     this->ownrank = rank;
-    this->async.init(8623);
+    this->async = CounterBasedRandom(8623, RNG_PURPOSE_CAVITY);
 
     for (int d = 0; d < 3; d++)
         if (control_bottom[d] >= control_top[d])
@@ -146,6 +160,16 @@ void CavityEnsemble::init(Component *component, unsigned Nx, unsigned Ny, unsign
     for (int d = 0; d < 3; d++) {
         minlu[d] = (int) round(nun[d] * this->minredco[d] - 0.0009756);
         maxlu[d] = (int) round(nun[d] * this->maxredco[d] - 0.0009756) - 1;
+        // the subdomain may reach beyond the control volume
+        minlu[d] = std::max(minlu[d], 0);
+        maxlu[d] = std::min(maxlu[d], (int) nun[d] - 1);
+    }
+    this->latticeSize[0] = Nx;
+    latticeSize[1] = Ny;
+    latticeSize[2] = Nz;
+    for (int d = 0; d < 3; d++) {
+        this->latticeMin[d] = minlu[d];
+        this->latticeMax[d] = maxlu[d];
     }
 /*
    cout << "nun: " << nun[0] << " / " << nun[1] << " / " << nun[2] << "\n";
@@ -162,21 +186,33 @@ void CavityEnsemble::init(Component *component, unsigned Nx, unsigned Ny, unsign
         if (grid_spacing[d] > max_spacing) max_spacing = grid_spacing[d];
     }
 
-    int tid;
+    unsigned long tid;
     int tlu[3];
     double tq[3];
-    Molecule *tm;
+    size_t numLattice = 1;
+    for (int d = 0; d < 3; d++) numLattice *= maxlu[d] >= minlu[d] ? maxlu[d] - minlu[d] + 1 : 0;
+    this->reservoir.reserve(numLattice);
+    // ten random numbers per cavity, drawn for a whole row of cavities at once
+    const unsigned numRandom = 10;
+    const size_t rowLength = maxlu[2] >= minlu[2] ? maxlu[2] - minlu[2] + 1 : 0;
+    std::vector<uint64_t> rowIDs(rowLength);
+    std::vector<double> rowRandom(numRandom * rowLength);
     for (tlu[0] = minlu[0]; maxlu[0] >= tlu[0]; tlu[0]++) {
         for (tlu[1] = minlu[1]; maxlu[1] >= tlu[1]; tlu[1]++) {
+            for (size_t i = 0; i < rowLength; i++)
+                rowIDs[i] = ((unsigned long) tlu[0] * Ny + tlu[1]) * Nz + minlu[2] + i + 1;
+            this->async.uniformBulk(rowIDs.data(), rowLength, 0, rowRandom.data(), numRandom);
+
             for (tlu[2] = minlu[2]; maxlu[2] >= tlu[2]; tlu[2]++) {
-                tid = tlu[0] * Ny * Nz + tlu[1] * Nz + tlu[2] + 1; // + this->idoffset;
+                tid = ((unsigned long) tlu[0] * Ny + tlu[1]) * Nz + tlu[2] + 1; // + this->idoffset;
+                const double *rnd = &rowRandom[tlu[2] - minlu[2]];
                 for (int d = 0; d < 3; d++)
                     tq[d] = control_bottom[d] + (0.5009756 + tlu[d]) * grid_spacing[d];
 
                 double v[3];
                 double vv = 0.0;
                 for (int d = 0; d < 3; d++) {
-                    v[d] = -0.5 + this->async.rnd();
+                    v[d] = -0.5 + rnd[d * rowLength];
                     vv += v[d] * v[d];
                 }
                 double vnorm = sqrt(3.0 * T / (vv * component->m()));
@@ -184,7 +220,7 @@ void CavityEnsemble::init(Component *component, unsigned Nx, unsigned Ny, unsign
                 double qtr[4];
                 double qqtr = 0.0;
                 for (int d = 0; d < 4; d++) {
-                    qtr[d] = -0.5 + this->async.rnd();
+                    qtr[d] = -0.5 + rnd[(3 + d) * rowLength];
                     qqtr += qtr[d] * qtr[d];
                 }
                 double qtrnorm = sqrt(1.0 / qqtr);
@@ -192,7 +228,7 @@ void CavityEnsemble::init(Component *component, unsigned Nx, unsigned Ny, unsign
                 std::array<double, 3> D;
                 double Dnorm = 0.0;
                 if (rotdof > 0) {
-                    for (int d = 0; d < 3; d++) D[d] = -0.5 + this->async.rnd();
+                    for (int d = 0; d < 3; d++) D[d] = -0.5 + rnd[(7 + d) * rowLength];
 
                     std::array<double, 3> w;
                     Quaternion tqtr = Quaternion(qtr[0] * qtrnorm, qtr[1] * qtrnorm, qtr[2] * qtrnorm,
@@ -209,21 +245,20 @@ void CavityEnsemble::init(Component *component, unsigned Nx, unsigned Ny, unsign
                     D[2] = 0.0;
                 }
 
-                tm = new Molecule(tid, component, tq[0], tq[1], tq[2], v[0] * vnorm, v[1] * vnorm, v[2] * vnorm,
-                                  qtr[0] * qtrnorm, qtr[1] * qtrnorm, qtr[2] * qtrnorm, qtr[3] * qtrnorm, D[0] * Dnorm,
-                                  D[1] * Dnorm, D[2] * Dnorm);
-
-                this->reservoir[tid] = tm;
+                this->reservoir.emplace_back(tid, component, tq[0], tq[1], tq[2], v[0] * vnorm, v[1] * vnorm,
+                                             v[2] * vnorm, qtr[0] * qtrnorm, qtr[1] * qtrnorm, qtr[2] * qtrnorm,
+                                             qtr[3] * qtrnorm, D[0] * Dnorm, D[1] * Dnorm, D[2] * Dnorm);
             }
         }
     }
+    this->active.assign(this->reservoir.size(), 0);
 
     this->initialized = true;
 }
 
 unsigned long CavityEnsemble::communicateNumCavities(DomainDecompBase *comm) {
     comm->collCommInit(1);
-    comm->collCommAppendUnsLong(this->active.size());
+    comm->collCommAppendUnsLong(this->localActive);
     comm->collCommAllreduceSum();
     this->globalActive = comm->collCommGetUnsLong();
     comm->collCommFinalize();
@@ -235,99 +270,156 @@ void CavityEnsemble::preprocessStep() {
     if (this->rotated) return;
     if (this->reservoir.size() == 0) return;
 
-    std::map<unsigned long, Molecule *>::iterator resit = this->reservoir.begin();
-
     double qtr[4];
-    Component *tc = resit->second->component();
+    Component *tc = this->reservoir.front().component();
     unsigned rotdof = tc->getRotationalDegreesOfFreedom();
     if (rotdof > 0) {
-        for (resit = reservoir.begin(); resit != reservoir.end(); resit++) {
+        for (Molecule &probe : this->reservoir) {
             double qqtr = 0.0;
+            this->async.uniform(probe.getID(), 1, qtr, 4);
             for (int d = 0; d < 4; d++) {
-                qtr[d] = -0.5 + this->async.rnd();
+                qtr[d] -= 0.5;
                 qqtr += qtr[d] * qtr[d];
             }
             double qtrnorm = sqrt(1.0 / qqtr);
-            resit->second->setq(Quaternion(qtrnorm * qtr[0], qtrnorm * qtr[1], qtrnorm * qtr[2], qtrnorm * qtr[3]));
+            probe.setq(Quaternion(qtrnorm * qtr[0], qtrnorm * qtr[1], qtrnorm * qtr[2], qtrnorm * qtr[3]));
         }
     }
     this->rotated = true;
 }
 
-bool CavityEnsemble::decideActivity(unsigned neighbours, unsigned long tmid) {
-    bool isActive = (neighbours <= this->maxNeighbours);
-    if (isActive) this->active.insert(tmid);
-    else this->active.erase(tmid);
-    return isActive;
-}
-
-bool CavityEnsemble::decideActivity(double /*uPotTilde*/, unsigned long tmid) {
-    /*** ADD CAVITY ENSEMBLE ***/
-
-    this->active.erase(tmid);
-
-    /*** ADD CAVITY ENSEMBLE ***/
-
-    return false;
-}
-
-std::map<unsigned long, Molecule *> CavityEnsemble::activeParticleContainer() {
-    std::map<unsigned long, Molecule *> retv;
-    std::set<unsigned long>::iterator resit;
-    for (resit = this->active.begin(); resit != active.end(); resit++) {
-        retv[*resit] = this->reservoir[*resit];
+std::vector<const Molecule *> CavityEnsemble::activeParticleContainer() const {
+    std::vector<const Molecule *> retv;
+    retv.reserve(this->localActive);
+    for (size_t i = 0; i < this->reservoir.size(); i++) {
+        if (this->active[i]) retv.push_back(&this->reservoir[i]);
     }
     return retv;
 }
 
-unsigned CavityEnsemble::countNeighbours(ParticleContainer *container, Molecule *m1) const {
-    unsigned m1neigh = 0;
-
-    double RR = getRR();
-    double R = std::sqrt(RR);
-
-    // the lower and higher corners of a box, centered at the molecule
-    // with side-length two times the search radius
-    double lo[3], hi[3];
-    for (int d = 0; d < 3; ++d) {
-        lo[d] = std::max(0.0, m1->r(d) - R);
-        hi[d] = std::min(system[d], m1->r(d) + R);
+void CavityEnsemble::cavityStep(const LocalDensity &neighbourSearch) {
+    this->localActive = 0;
+    if (this->reservoir.empty()) return;
+
+    unsigned long numActive = 0;
+    const long numProbes = this->reservoir.size();
+    #if defined(_OPENMP)
+    #pragma omp parallel for schedule(static) reduction(+ : numActive)
+    #endif
+    for (long i = 0; i < numProbes; i++) {
+        const Molecule &probe = this->reservoir[i];
+        const double r[3] = {probe.r(0), probe.r(1), probe.r(2)};
+        const bool isActive = neighbourSearch.countNeighbours(r, this->maxNeighbours) <= this->maxNeighbours;
+        this->active[i] = isActive;
+        numActive += isActive;
     }
-    //global_log->info() << "[CavityWriter] post_lo_hi" << std::endl;
+    this->localActive = numActive;
+}
 
-    //global_log->info() << "[CavityWriter] post region iterator" << std::endl;
+std::map<unsigned long, unsigned long> CavityEnsemble::clusterSizeDistribution(DomainDecompBase *comm) const {
+    // one bit per pseudo-molecule of this subdomain, in the order of the reservoir (the lattice block of the subdomain)
+    std::vector<uint64_t> localBits((this->reservoir.size() + 63) / 64, 0);
+    for (size_t i = 0; i < this->reservoir.size(); i++) {
+        if (this->active[i]) localBits[i / 64] |= uint64_t(1) << (i % 64);
+    }
 
-	for (auto m2 = container->regionIterator(lo, hi, ParticleIterator::ALL_CELLS); m2.isValid(); ++m2) {
-		if (m2->getID() == m1->getID()) {
-            //global_log->info() << "[CavityWriter] same ID" << std::endl;
-            continue;
+    // on rank 0, one bit per lattice site, the lattice index is the ID of the pseudo-molecule - 1
+    const size_t numSites = (size_t) this->latticeSize[0] * latticeSize[1] * latticeSize[2];
+    std::vector<uint64_t> cavityBits;
+    auto insertBlock = [this, &cavityBits](const int *blockMin, const int *blockMax, const uint64_t *bits) {
+        size_t i = 0;
+        for (long l0 = blockMin[0]; l0 <= blockMax[0]; l0++) {
+            for (long l1 = blockMin[1]; l1 <= blockMax[1]; l1++) {
+                for (long l2 = blockMin[2]; l2 <= blockMax[2]; l2++, i++) {
+                    if (bits[i / 64] & (uint64_t(1) << (i % 64))) {
+                        const size_t site = (l0 * latticeSize[1] + l1) * latticeSize[2] + l2;
+                        cavityBits[site / 64] |= uint64_t(1) << (site % 64);
+                    }
+                }
+            }
         }
-        double distanceVectorDummy[3] = {0.0, 0.0, 0.0};
-        double dd = m2->dist2(*m1, distanceVectorDummy);
-        //global_log->info() << "[CavityWriter] post distance" << std::endl;
-        if (dd < RR) {
-            ++m1neigh;
+    };
+    if (comm->getRank() == 0) cavityBits.assign((numSites + 63) / 64, 0);
+
+#ifdef ENABLE_MPI
+    // every process only sends the flags of its own lattice block
+    const int numProcs = comm->getNumProcs();
+    int localBlock[7] = {latticeMin[0], latticeMin[1], latticeMin[2], latticeMax[0], latticeMax[1], latticeMax[2],
+                         (int) localBits.size()};
+    std::vector<int> blocks(comm->getRank() == 0 ? 7 * numProcs : 0);
+    MPI_CHECK(MPI_Gather(localBlock, 7, MPI_INT, blocks.data(), 7, MPI_INT, 0, comm->getCommunicator()));
+    std::vector<int> recvcounts, displs;
+    std::vector<uint64_t> blockBits;
+    if (comm->getRank() == 0) {
+        recvcounts.resize(numProcs);
+        displs.resize(numProcs);
+        // the displacements of MPI_Gatherv are ints
+        long long numWords = 0;
+        for (int r = 0; r < numProcs; r++) {
+            recvcounts[r] = blocks[7 * r + 6];
+            displs[r] = (int) numWords;
+            numWords += recvcounts[r];
+            if (numWords > std::numeric_limits<int>::max()) {
+                std::ostringstream error_message;
+                error_message << "\nCavity flags of the lattice blocks exceed " << std::numeric_limits<int>::max()
+                              << " words, use a coarser lattice.\n";
+                MARDYN_EXIT(error_message.str());
+            }
         }
+        blockBits.resize(numWords);
     }
-
-    return m1neigh;
-}
-
-void CavityEnsemble::cavityStep(ParticleContainer *globalMoleculeContainer) {
-
-    // don't confuse with the other ParticleContainer, the base-class of LinkedCells!
-    std::map<unsigned long, Molecule *> *pc = this->particleContainer();
-
-    for (auto pcit = pc->begin(); pcit != pc->end(); pcit++) {
-        mardyn_assert(pcit->second != NULL);
-        Molecule *m1 = pcit->second;
-        //global_log->info() << "[CavityWriter] pre-neighbors" << std::endl;
-        unsigned neigh = this->countNeighbours(globalMoleculeContainer, m1);
-        //global_log->info() << "[CavityWriter] post-neighbors" << std::endl;
-        unsigned long m1id = pcit->first;
-        mardyn_assert(m1id == m1->getID());
-        this->decideActivity(neigh, m1id);
-        //global_log->info() << "[CavityWriter] post-activity" << std::endl;
-
+    MPI_CHECK(MPI_Gatherv(localBits.data(), localBits.size(), MPI_UINT64_T, blockBits.data(), recvcounts.data(),
+                          displs.data(), MPI_UINT64_T, 0, comm->getCommunicator()));
+    if (comm->getRank() == 0) {
+        for (int r = 0; r < numProcs; r++) {
+            insertBlock(&blocks[7 * r], &blocks[7 * r + 3], blockBits.data() + displs[r]);
+        }
+    }
+#else
+    insertBlock(latticeMin, latticeMax, localBits.data());
+#endif
+
+    std::map<unsigned long, unsigned long> distribution;
+    if (comm->getRank() != 0) return distribution;
+
+    // the lattice is periodic if it spans the whole system
+    const bool periodic = not this->restrictedControlVolume;
+    const long N[3] = {latticeSize[0], latticeSize[1], latticeSize[2]};
+    auto testAndClear = [&cavityBits](size_t site) {
+        const uint64_t mask = uint64_t(1) << (site % 64);
+        const bool isSet = cavityBits[site / 64] & mask;
+        cavityBits[site / 64] &= ~mask;
+        return isSet;
+    };
+
+    // flood fill, every visited cavity is cleared from the bit field
+    std::vector<size_t> stack;
+    for (size_t word = 0; word < cavityBits.size(); word++) {
+        while (cavityBits[word] != 0) {
+            const size_t seed = word * 64 + __builtin_ctzll(cavityBits[word]);
+            testAndClear(seed);
+            stack.push_back(seed);
+            unsigned long size = 0;
+            while (not stack.empty()) {
+                const size_t site = stack.back();
+                stack.pop_back();
+                size++;
+                const long l[3] = {(long) (site / (N[1] * N[2])), (long) (site / N[2] % N[1]), (long) (site % N[2])};
+                for (int d = 0; d < 3; d++) {
+                    for (int dir = -1; dir <= 1; dir += 2) {
+                        long n[3] = {l[0], l[1], l[2]};
+                        n[d] += dir;
+                        if (n[d] < 0 or n[d] >= N[d]) {
+                            if (not periodic) continue;
+                            n[d] = (n[d] + N[d]) % N[d];
+                        }
+                        const size_t neighbour = (n[0] * N[1] + n[1]) * N[2] + n[2];
+                        if (testAndClear(neighbour)) stack.push_back(neighbour);
+                    }
+                }
+            }
+            distribution[size]++;
+        }
     }
+    return distribution;
 }
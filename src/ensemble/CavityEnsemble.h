@@ -2,10 +2,13 @@
 #ifndef CAVITYENSEMBLE_H_
 #define CAVITYENSEMBLE_H_
 
+#include <cstdint>
 #include <map>
-#include <set>
+#include <vector>
 
-#include "utils/Random.h"
+#include "molecules/Molecule.h"
+#include "particleContainer/LocalDensity.h"
+#include "utils/CounterBasedRandom.h"
 
 
 class DomainDecompBase;
@@ -14,8 +17,6 @@ class ParticleContainer;
 
 class Component;
 
-#include "molecules/MoleculeForwardDeclaration.h"
-
 class CavityEnsemble {
 public:
     CavityEnsemble();
@@ -43,33 +44,35 @@ public:
 
     void preprocessStep();
 
-    bool decideActivity(unsigned neighbours, unsigned long tmid);
-
-    bool decideActivity(double uPotTilde, unsigned long tmid);
-
     void setIdOffset(unsigned long offset) { this->idoffset = offset; }
 
     unsigned long communicateNumCavities(DomainDecompBase *comm);
 
     unsigned long numCavities() { return this->globalActive; }
 
-    std::map<unsigned long, Molecule *> *particleContainer() { return &(this->reservoir); }
-
-    std::map<unsigned long, Molecule *> activeParticleContainer();
-
-    void determineBoundary();
+    //! @brief the pseudo-molecules of this subdomain, sorted by ID (the lattice index + 1)
+    const std::vector<Molecule> &particleContainer() const { return this->reservoir; }
 
-    void processBoundary();
+    //! @brief pseudo-molecules which were found to be cavities in the last cavityStep
+    std::vector<const Molecule *> activeParticleContainer() const;
 
-    void cavityStep(ParticleContainer *globalMoleculeContainer);
+    /**
+     * Determine for all pseudo-molecules whether they are a cavity, i.e., whether at most maxNeighbours molecules
+     * are within the search radius. The molecules are binned into a grid with bins of at least the search radius,
+     * so every pseudo-molecule only has to check the 27 surrounding bins.
+     * @param neighbourSearch molecules of the subdomain binned with a cutoff radius of sqrt(getRR()), see
+     * Domain::getLocalDensity
+     */
+    void cavityStep(const LocalDensity &neighbourSearch);
 
-private:
     /**
-     * iterate a box of center this molecule and side-lengths two times the search-radius
-     * and count the neighbours contained in it.
+     * Cavities which are neighbours on the lattice of pseudo-molecules form one cluster. Collective operation, every
+     * process sends the cavity flags of its own lattice block to rank 0, which labels the clusters.
+     * @return on rank 0 the number of clusters per cluster size (in pseudo-molecules), empty on all other ranks
      */
-    unsigned countNeighbours(ParticleContainer *container, Molecule *m1) const;
+    std::map<unsigned long, unsigned long> clusterSizeDistribution(DomainDecompBase *comm) const;
 
+private:
     int ownrank;  // for debugging purposes (indicate rank in console output)
     bool initialized;
     bool rotated;
@@ -87,8 +90,12 @@ private:
     double control_top[3];
 
     unsigned long idoffset;
-    std::set<unsigned long> active;
-    std::map<unsigned long, Molecule *> reservoir;
+    unsigned latticeSize[3];  // Nx, Ny, Nz
+    int latticeMin[3];  // lattice block of this subdomain, the reservoir holds its sites in row-major order
+    int latticeMax[3];
+    std::vector<Molecule> reservoir;
+    std::vector<char> active;  // one flag per pseudo-molecule in reservoir
+    unsigned long localActive;
     unsigned long globalActive;
 
     bool boundarySpecified;
@@ -98,7 +105,7 @@ private:
     unsigned maxNeighbours;
     double r2n;
 
-    Random async;
+    CounterBasedRandom async;  //!< keyed by cavity ID, independent of the decomposition
 };
 
 #endif
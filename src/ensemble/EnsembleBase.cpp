@@ -92,6 +92,36 @@ void Ensemble::readXML(XMLfileUnits& xmlconfig) {
 		}
 	}
 	xmlconfig.changecurrentnode(oldpath);
+
+	/* tabulated potentials */
+	if (xmlconfig.changecurrentnode("components/tabulated")) {
+		xmlconfig.getNodeValueReduced("rmin", _tabulationGrid.rmin);
+		xmlconfig.getNodeValue("bins", _tabulationGrid.bins);
+		std::string interpolation = "cubic";
+		xmlconfig.getNodeValue("interpolation", interpolation);
+		_tabulationGrid.cubic = (interpolation != "linear");
+		if (_tabulationGrid.rmin <= 0.0 or _tabulationGrid.bins == 0) {
+			std::ostringstream error_message;
+			error_message << "Tabulated potentials: rmin and bins must be greater than zero" << std::endl;
+			MARDYN_EXIT(error_message.str());
+		}
+		Log::global_log->info() << "Tabulated potentials: " << _tabulationGrid.bins << " bins in r^2 from rmin=" << _tabulationGrid.rmin
+								<< ", " << (_tabulationGrid.cubic ? "cubic" : "linear") << " interpolation" << std::endl;
+		query = xmlconfig.query("potential");
+		for (auto potentialIter = query.begin(); potentialIter; potentialIter++) {
+			xmlconfig.changecurrentnode(potentialIter);
+			auto potential = std::make_shared<TabulatedPotential>();
+			potential->readXML(xmlconfig);
+			if (potential->getCid2() >= numComponents) {
+				std::ostringstream error_message;
+				error_message << "Tabulated potential: cid=" << potential->getCid2() + 1 << " is larger than number of components ("
+							  << numComponents << ")" << std::endl;
+				MARDYN_EXIT(error_message.str());
+			}
+			_tabulatedPotentials.push_back(potential);
+		}
+		xmlconfig.changecurrentnode(oldpath);
+	}
 	setComponentLookUpIDs();
 }
 
@@ -10,6 +10,7 @@
 #include "DomainBase.h"
 #include "molecules/MoleculeForwardDeclaration.h"
 #include "molecules/mixingrules/MixingRuleBase.h"
+#include "molecules/TabulatedPotential.h"
 
 class ParticleContainer;
 
@@ -118,6 +119,9 @@ public:
 	/*! runs before temperature control is applied, but after force calculations */
 	virtual void beforeThermostat(unsigned long simstep, unsigned long initStatistics) {};
 
+	/*! whether potential energy and virial of the force calculation in simstep are needed by the ensemble */
+	virtual bool requiresMacroscopicValues(unsigned long /* simstep */) { return false; }
+
 	/*! Store Sample molecule from old input readers in lmu */
 	virtual void storeSample(Molecule* m, uint32_t componentid) {};
 
@@ -126,6 +130,12 @@ public:
 	// Set one mixing rule
 	void setMixingrule(std::shared_ptr<MixingRuleBase> mixingrule);
 
+	//! Tabulated potentials replacing the LJ interaction of a component pair
+	const std::vector<std::shared_ptr<TabulatedPotential>>& getTabulatedPotentials() const { return _tabulatedPotentials; }
+	const TabulationGrid& getTabulationGrid() const { return _tabulationGrid; }
+	void addTabulatedPotential(std::shared_ptr<TabulatedPotential> potential) { _tabulatedPotentials.push_back(potential); }
+	void setTabulationGrid(const TabulationGrid& grid) { _tabulationGrid = grid; }
+
 protected:
 
 
@@ -134,6 +144,8 @@ protected:
 	// The mixing rules (xi,eta) can be accessed by _mixingrules[cid1][cid2]
 	// Note that cid1 < cid2 and that cid is in internal format, i.e. starts with 0
 	MixingRuleBase::MixRulesType _mixingrules;
+	std::vector<std::shared_ptr<TabulatedPotential>> _tabulatedPotentials;
+	TabulationGrid _tabulationGrid;
 	DomainBase* _domain;
 	Type _type = undefined;
 
@@ -0,0 +1,132 @@
+/*
+ * CavityEnsembleTest.cpp
+ */
+
+#include "CavityEnsembleTest.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#include "ensemble/CavityEnsemble.h"
+#include "molecules/Component.h"
+#include "molecules/Molecule.h"
+#include "parallel/DomainDecompBase.h"
+#include "particleContainer/LinkedCells.h"
+#include "particleContainer/LocalDensity.h"
+
+TEST_SUITE_REGISTRATION(CavityEnsembleTest);
+
+namespace {
+constexpr unsigned latticeLength = 6;
+
+// lattice sites left empty: a single site, a row of three and a pair across the periodic boundary in x
+const std::vector<std::array<unsigned, 3>> emptySites = {
+	{1, 1, 1}, {3, 3, 1}, {3, 3, 2}, {3, 3, 3}, {5, 1, 4}, {0, 1, 4}};
+
+unsigned long siteID(const std::array<unsigned, 3>& site) {
+	return (site[0] * latticeLength + site[1]) * latticeLength + site[2] + 1;
+}
+}  // namespace
+
+CavityEnsembleTest::CavityEnsembleTest() {}
+
+CavityEnsembleTest::~CavityEnsembleTest() {}
+
+std::map<unsigned long, unsigned long> CavityEnsembleTest::detectCavities(double xMin,
+																		  std::vector<unsigned long>& cavityIDs) {
+	const double length = latticeLength;
+	const double radius = 0.4;
+
+	Component component(0);
+	component.addLJcenter(0., 0., 0., 1., 1., 1., 2.5, false);
+
+	// one molecule at every occupied lattice site, slightly off the position of the pseudo-molecule
+	double boxMin[3] = {0., 0., 0.};
+	double boxMax[3] = {length, length, length};
+	LinkedCells container(boxMin, boxMax, 1.);
+	unsigned long id = 1;
+	for (unsigned l0 = 0; l0 < latticeLength; l0++) {
+		for (unsigned l1 = 0; l1 < latticeLength; l1++) {
+			for (unsigned l2 = 0; l2 < latticeLength; l2++) {
+				const std::array<unsigned, 3> site = {l0, l1, l2};
+				if (std::find(emptySites.begin(), emptySites.end(), site) != emptySites.end()) {
+					continue;
+				}
+				Molecule molecule(id++, &component, l0 + 0.6, l1 + 0.5, l2 + 0.5);
+				container.addParticle(molecule);
+			}
+		}
+	}
+
+	CavityEnsemble cavities;
+	cavities.setSystem(length, length, length, 0, radius);
+	cavities.setSubdomain(0, xMin, length, 0., length, 0., length);
+	cavities.submitTemperature(1.);
+	cavities.init(&component, latticeLength, latticeLength, latticeLength);
+
+	LocalDensity neighbourSearch;
+	neighbourSearch.bin(&container, std::sqrt(cavities.getRR()));
+	cavities.cavityStep(neighbourSearch);
+	cavities.communicateNumCavities(_domainDecomposition);
+
+	cavityIDs.clear();
+	for (const Molecule* cavity : cavities.activeParticleContainer()) {
+		cavityIDs.push_back(cavity->getID());
+	}
+	std::sort(cavityIDs.begin(), cavityIDs.end());
+	ASSERT_EQUAL(cavityIDs.size(), static_cast<size_t>(cavities.numCavities()));
+
+	return cavities.clusterSizeDistribution(_domainDecomposition);
+}
+
+void CavityEnsembleTest::testCavityDetection() {
+	if (_domainDecomposition->getNumProcs() != 1) {
+		test_log->info() << "CavityEnsembleTest::testCavityDetection() not executed (rerun with only 1 Process!)" << std::endl;
+		return;
+	}
+
+	std::vector<unsigned long> cavityIDs;
+	detectCavities(0., cavityIDs);
+
+	std::vector<unsigned long> expected;
+	for (const auto& site : emptySites) {
+		expected.push_back(siteID(site));
+	}
+	std::sort(expected.begin(), expected.end());
+	ASSERT_EQUAL(expected.size(), cavityIDs.size());
+	for (size_t i = 0; i < expected.size(); i++) {
+		ASSERT_EQUAL(expected[i], cavityIDs[i]);
+	}
+}
+
+void CavityEnsembleTest::testClusterSizes() {
+	if (_domainDecomposition->getNumProcs() != 1) {
+		test_log->info() << "CavityEnsembleTest::testClusterSizes() not executed (rerun with only 1 Process!)" << std::endl;
+		return;
+	}
+
+	std::vector<unsigned long> cavityIDs;
+	const std::map<unsigned long, unsigned long> distribution = detectCavities(0., cavityIDs);
+	const std::map<unsigned long, unsigned long> expected = {{1, 1}, {2, 1}, {3, 1}};
+	ASSERT_TRUE(expected == distribution);
+}
+
+void CavityEnsembleTest::testClusterSizesOfSubdomain() {
+	if (_domainDecomposition->getNumProcs() != 1) {
+		test_log->info() << "CavityEnsembleTest::testClusterSizesOfSubdomain() not executed (rerun with only 1 Process!)" << std::endl;
+		return;
+	}
+
+	// the lattice block x = 3..5 contains the row of three and one site of the pair
+	std::vector<unsigned long> cavityIDs;
+	const std::map<unsigned long, unsigned long> distribution = detectCavities(3., cavityIDs);
+	const std::vector<unsigned long> expectedIDs = {siteID({3, 3, 1}), siteID({3, 3, 2}), siteID({3, 3, 3}),
+													siteID({5, 1, 4})};
+	ASSERT_EQUAL(expectedIDs.size(), cavityIDs.size());
+	for (size_t i = 0; i < expectedIDs.size(); i++) {
+		ASSERT_EQUAL(expectedIDs[i], cavityIDs[i]);
+	}
+	const std::map<unsigned long, unsigned long> expected = {{1, 1}, {3, 1}};
+	ASSERT_TRUE(expected == distribution);
+}
@@ -0,0 +1,46 @@
+/*
+ * CavityEnsembleTest.h
+ */
+
+#pragma once
+
+#include "utils/TestWithSimulationSetup.h"
+
+#include <map>
+#include <vector>
+
+/**
+ * Detects cavities on a 6x6x6 lattice of pseudo-molecules, where all sites but a few are occupied by molecules, and
+ * checks the detected cavities and their cluster sizes.
+ */
+class CavityEnsembleTest : public utils::TestWithSimulationSetup {
+
+	TEST_SUITE(CavityEnsembleTest);
+	TEST_METHOD(testCavityDetection);
+	TEST_METHOD(testClusterSizes);
+	TEST_METHOD(testClusterSizesOfSubdomain);
+	TEST_SUITE_END();
+
+public:
+
+	CavityEnsembleTest();
+
+	virtual ~CavityEnsembleTest();
+
+	//! Exactly the empty lattice sites are detected as cavities.
+	void testCavityDetection();
+
+	//! Neighbouring cavities form one cluster, also across the periodic boundary.
+	void testClusterSizes();
+
+	//! Only the lattice block of the subdomain contributes to the clusters.
+	void testClusterSizesOfSubdomain();
+
+private:
+	/**
+	 * Runs the cavity detection for the subdomain [xMin, 6) x [0, 6) x [0, 6).
+	 * @param[out] cavityIDs sorted IDs of the detected cavities
+	 * @return the cluster size distribution
+	 */
+	std::map<unsigned long, unsigned long> detectCavities(double xMin, std::vector<unsigned long>& cavityIDs);
+};
@@ -7,12 +7,16 @@
 #ifdef ENABLE_ADIOS2
 #include "Adios2Writer.h"
 
+#include <algorithm>
 #include <numeric>
+#include <type_traits>
 
 #include "Domain.h"
 #include "Simulation.h"
+#include "molecules/Molecule.h"
 #include "parallel/DomainDecompBase.h"
 #include "particleContainer/ParticleContainer.h"
+#include "utils/String_utils.h"
 #include "utils/mardyn_assert.h"
 #include "utils/xmlfile.h"
 
@@ -36,41 +40,62 @@ constexpr char const* lbox_name = "local_box";
 constexpr char const* offsets_name = "offsets";
 constexpr char const* simtime_name = "simulationtime";
 
-void Adios2Writer::resetContainers() {
-	// set variable name to write
-	_vars[mol_id_name] = std::vector<uint64_t>();
-	_vars[comp_id_name] = std::vector<uint64_t>();
-	_vars[ry_name] = std::vector<PRECISION>();
-	_vars[rx_name] = std::vector<PRECISION>();
-	_vars[rz_name] = std::vector<PRECISION>();
-	_vars[vx_name] = std::vector<PRECISION>();
-	_vars[vy_name] = std::vector<PRECISION>();
-	_vars[vz_name] = std::vector<PRECISION>();
-	if (!_singleCenter) {
-		_vars[qw_name] = std::vector<PRECISION>();
-		_vars[qx_name] = std::vector<PRECISION>();
-		_vars[qy_name] = std::vector<PRECISION>();
-		_vars[qz_name] = std::vector<PRECISION>();
-		_vars[Lx_name] = std::vector<PRECISION>();
-		_vars[Ly_name] = std::vector<PRECISION>();
-		_vars[Lz_name] = std::vector<PRECISION>();
-	}
+const std::vector<Adios2Writer::Quantity>& Adios2Writer::quantities() {
+	static const std::vector<Quantity> quantities = {
+		{mol_id_name, false, [](const Molecule& m) -> uint64_t { return m.getID(); }, nullptr},
+		{comp_id_name, false, [](const Molecule& m) -> uint64_t { return m.componentid(); }, nullptr},
+		{rx_name, false, nullptr, [](const Molecule& m) { return m.r(0); }},
+		{ry_name, false, nullptr, [](const Molecule& m) { return m.r(1); }},
+		{rz_name, false, nullptr, [](const Molecule& m) { return m.r(2); }},
+		{vx_name, false, nullptr, [](const Molecule& m) { return m.v(0); }},
+		{vy_name, false, nullptr, [](const Molecule& m) { return m.v(1); }},
+		{vz_name, false, nullptr, [](const Molecule& m) { return m.v(2); }},
+		{qw_name, true, nullptr, [](const Molecule& m) { return m.q().qw(); }},
+		{qx_name, true, nullptr, [](const Molecule& m) { return m.q().qx(); }},
+		{qy_name, true, nullptr, [](const Molecule& m) { return m.q().qy(); }},
+		{qz_name, true, nullptr, [](const Molecule& m) { return m.q().qz(); }},
+		{Lx_name, true, nullptr, [](const Molecule& m) { return m.D(0); }},
+		{Ly_name, true, nullptr, [](const Molecule& m) { return m.D(1); }},
+		{Lz_name, true, nullptr, [](const Molecule& m) { return m.D(2); }},
+	};
+	return quantities;
 }
 
-void Adios2Writer::clearContainers() {
-	for (auto& [variableName, variableContainer] : _vars) {
-		if (std::holds_alternative<std::vector<PRECISION>>(variableContainer)) {
-			std::get<std::vector<PRECISION>>(variableContainer).clear();
-		} else {
-			std::get<std::vector<uint64_t>>(variableContainer).clear();
+void Adios2Writer::selectQuantities() {
+	const auto& all = quantities();
+	_fullQuantities.clear();
+	for (size_t i = 0; i < all.size(); ++i) {
+		if (!_singleCenter || !all[i].rotational) {
+			_fullQuantities.push_back(i);
+		}
+	}
+
+	if (_variables.empty()) {
+		_thinQuantities = _fullQuantities;
+		return;
+	}
+	_thinQuantities.clear();
+	for (const auto& token : string_utils::split(_variables, ',')) {
+		const auto name = string_utils::trim(token);
+		const auto it = std::find_if(all.begin(), all.end(), [&](const Quantity& q) { return name == q.name; });
+		if (it == all.end()) {
+			std::ostringstream error_message;
+			error_message << "[Adios2Writer] Unknown variable: " << name << std::endl;
+			MARDYN_EXIT(error_message.str());
+		}
+		const size_t index = std::distance(all.begin(), it);
+		if (std::find(_thinQuantities.begin(), _thinQuantities.end(), index) == _thinQuantities.end()) {
+			_thinQuantities.push_back(index);
 		}
 	}
 }
 
-void Adios2Writer::defineVariables(const uint64_t global, const uint64_t offset, const uint64_t local, const int numProcs, const int rank) {
-	for (auto& [variableName, variableContainer] : _vars) {
-		Log::global_log->info() << "[Adios2Writer] Defining Variable " << variableName << std::endl;
-		if (std::holds_alternative<std::vector<PRECISION>>(variableContainer)) {
+void Adios2Writer::defineVariables(const uint64_t global, const uint64_t offset, const uint64_t local, const int numProcs, const int rank,
+								   const std::vector<size_t>& selectedQuantities) {
+	for (const size_t q : selectedQuantities) {
+		const std::string variableName = quantities()[q].name;
+		Log::global_log->debug() << "[Adios2Writer] Defining Variable " << variableName << std::endl;
+		if (quantities()[q].value != nullptr) {
 			auto advar_prec =
 				_io->DefineVariable<PRECISION>(variableName, {global}, {offset}, {local}, adios2::ConstantDims);
 
@@ -118,10 +143,43 @@ void Adios2Writer::defineVariables(const uint64_t global, const uint64_t offset,
 	_io->DefineVariable<double>(simtime_name);
 }
 
-void Adios2Writer::init(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp, Domain* domain) {
-	resetContainers();
+template <typename T>
+void Adios2Writer::putQuantity(const Quantity& quantity, ParticleContainer* particleContainer,
+							   uint64_t localNumParticles) {
+	const auto variable = _io->InquireVariable<T>(quantity.name);
+	auto fill = [&](T* data) {
+		size_t i = 0;
+		for (auto m = particleContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); m.isValid(); ++m, ++i) {
+			if constexpr (std::is_same_v<T, uint64_t>) {
+				data[i] = quantity.index(*m);
+			} else {
+				data[i] = static_cast<T>(quantity.value(*m));
+			}
+		}
+		mardyn_assert(i == localNumParticles);
+	};
+
+	if (_zeroCopy) {
+		// the span points into the buffer of the engine and is only valid until the next Put, so it is filled right away
+		auto span = _engine->Put(variable);
+		fill(span.data());
+	} else {
+		// operators do not support spans: the values are copied (and compressed) by a synchronous Put, so one buffer
+		// suffices for all variables
+		std::vector<T>* buffer;
+		if constexpr (std::is_same_v<T, uint64_t>) {
+			buffer = &_indexBuffer;
+		} else {
+			buffer = &_valueBuffer;
+		}
+		buffer->resize(localNumParticles);
+		fill(buffer->data());
+		_engine->Put<T>(variable, buffer->data(), adios2::Mode::Sync);
+	}
 }
 
+void Adios2Writer::init(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp, Domain* domain) {}
+
 void Adios2Writer::readXML(XMLfileUnits& xmlconfig) {
 	using std::endl;
 	_outputfile = "mardyn.bp";
@@ -148,6 +206,12 @@ void Adios2Writer::readXML(XMLfileUnits& xmlconfig) {
 	_num_files = -1;
 	xmlconfig.getNodeValue("numfiles", _num_files);
 	Log::global_log->info() << "[Adios2Writer] Number of files: " << _num_files << std::endl;
+	_variables.clear();
+	xmlconfig.getNodeValue("variables", _variables);
+	Log::global_log->info() << "[Adios2Writer] Variables: " << (_variables.empty() ? "all" : _variables) << std::endl;
+	_fullsnapshotfrequency = 0;
+	xmlconfig.getNodeValue("fullsnapshotfrequency", _fullsnapshotfrequency);
+	Log::global_log->info() << "[Adios2Writer] full snapshot frequency: " << _fullsnapshotfrequency << std::endl;
 
 
 	xmlconfig.changecurrentnode("/");
@@ -262,7 +326,8 @@ void Adios2Writer::initAdios2() {
 				_io->DefineAttribute<std::string>(component_id + "_element_names", component_elements);
 			}
 		}
-		resetContainers();
+		_zeroCopy = _compressionOperator.Type().empty();
+		selectQuantities();
 	} catch (std::invalid_argument& e) {
 		std::ostringstream error_message;
 		error_message << "Invalid argument exception:" << std::endl;
@@ -299,7 +364,10 @@ void Adios2Writer::afterForces(ParticleContainer* particleContainer, DomainDecom
 
 void Adios2Writer::endStep(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp, Domain* domain,
 						   unsigned long simstep) {
-	if (simstep % _writefrequency != 0) return;
+	// the full snapshots contain all variables, the thin ones only the selected
+	const bool fullSnapshot = _fullsnapshotfrequency > 0 && simstep % _fullsnapshotfrequency == 0;
+	if (!fullSnapshot && simstep % _writefrequency != 0) return;
+	const auto& selectedQuantities = fullSnapshot ? _fullQuantities : _thinQuantities;
 
 	// for all outputs
 	const uint64_t globalNumParticles = domain->getglobalNumMolecules(true, particleContainer, domainDecomp);
@@ -307,45 +375,6 @@ void Adios2Writer::endStep(ParticleContainer* particleContainer, DomainDecompBas
 	const auto numProcs = domainDecomp->getNumProcs();
 	int const rank = domainDecomp->getRank();
 
-	std::vector<uint64_t> m_id;
-	m_id.reserve(localNumParticles);
-
-	std::vector<uint32_t> comp_id;
-	comp_id.reserve(localNumParticles);
-
-	for (auto& [variableName, variableContainer] : _vars) {
-		if (std::holds_alternative<std::vector<PRECISION>>(variableContainer)) {
-			std::get<std::vector<PRECISION>>(variableContainer).reserve(localNumParticles);
-		} else {
-			std::get<std::vector<uint64_t>>(variableContainer).reserve(localNumParticles);
-		}
-	}
-
-	for (auto m = particleContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); m.isValid(); ++m) {
-		std::get<std::vector<uint64_t>>(_vars[mol_id_name]).emplace_back(m->getID());
-		std::get<std::vector<uint64_t>>(_vars[comp_id_name]).emplace_back(m->componentid());
-		std::get<std::vector<PRECISION>>(_vars[rx_name]).emplace_back(m->r(0));
-		std::get<std::vector<PRECISION>>(_vars[ry_name]).emplace_back(m->r(1));
-		std::get<std::vector<PRECISION>>(_vars[rz_name]).emplace_back(m->r(2));
-		std::get<std::vector<PRECISION>>(_vars[vx_name]).emplace_back(m->v(0));
-		std::get<std::vector<PRECISION>>(_vars[vy_name]).emplace_back(m->v(1));
-		std::get<std::vector<PRECISION>>(_vars[vz_name]).emplace_back(m->v(2));
-		if (!_singleCenter) {
-			auto q = m->q();
-			std::get<std::vector<PRECISION>>(_vars[qw_name]).emplace_back(q.qw());
-			std::get<std::vector<PRECISION>>(_vars[qx_name]).emplace_back(q.qx());
-			std::get<std::vector<PRECISION>>(_vars[qy_name]).emplace_back(q.qy());
-			std::get<std::vector<PRECISION>>(_vars[qz_name]).emplace_back(q.qz());
-			std::get<std::vector<PRECISION>>(_vars[Lx_name]).emplace_back(m->D(0));
-			std::get<std::vector<PRECISION>>(_vars[Ly_name]).emplace_back(m->D(1));
-			std::get<std::vector<PRECISION>>(_vars[Lz_name]).emplace_back(m->D(2));
-		}
-
-		m_id.emplace_back(m->getID());
-		comp_id.emplace_back(m->componentid());
-
-	}
-
 	// gather offsets
 	Log::global_log->debug() << "[Adios2Writer] numProcs: " << numProcs << std::endl;
 
@@ -370,14 +399,12 @@ void Adios2Writer::endStep(ParticleContainer* particleContainer, DomainDecompBas
 	try {
 		_engine->BeginStep();
 		_io->RemoveAllVariables();
-		defineVariables(globalNumParticles, offset, localNumParticles, numProcs, rank);
-		for (auto& [variableName, variableContainer] : _vars) {
-			if (std::holds_alternative<std::vector<PRECISION>>(variableContainer)) {
-				const auto adios2Var = _io->InquireVariable<PRECISION>(variableName);
-				_engine->Put<PRECISION>(adios2Var, std::get<std::vector<PRECISION>>(variableContainer).data());
+		defineVariables(globalNumParticles, offset, localNumParticles, numProcs, rank, selectedQuantities);
+		for (const size_t q : selectedQuantities) {
+			if (quantities()[q].value != nullptr) {
+				putQuantity<PRECISION>(quantities()[q], particleContainer, localNumParticles);
 			} else {
-				const auto adios2Var = _io->InquireVariable<uint64_t>(variableName);
-				_engine->Put<uint64_t>(adios2Var, std::get<std::vector<uint64_t>>(variableContainer).data());
+				putQuantity<uint64_t>(quantities()[q], particleContainer, localNumParticles);
 			}
 		}
 
@@ -419,8 +446,6 @@ void Adios2Writer::endStep(ParticleContainer* particleContainer, DomainDecompBas
 
 		// wait for completion of write
 		_engine->EndStep();
-
-		clearContainers();
 	} catch (std::invalid_argument& e) {
 		std::ostringstream error_message;
 		error_message << "[Adios2Writer] Invalid argument exception:" << std::endl;
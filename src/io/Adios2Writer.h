@@ -12,11 +12,9 @@
 #include "molecules/MoleculeForwardDeclaration.h"
 #include "plugins/PluginBase.h"
 
-#include <map>
 #include <memory>
 #include <sstream>
 #include <string>
-#include <variant>
 #include <vector>
 
 #include <adios2.h>
@@ -50,6 +48,8 @@ public:
 		 <compressionrate><!-- Parameter for the ZFP compression lib (default: 8) --></compressionrate>
 		 <appendmode><!-- Enables the append mode to append data to existing files/checkpoints (default: OFF) --></appendmode>
 		 <numfiles><!-- Number of Aggregators in ADIOS2 IO object (default: -1) --></numfiles>
+		 <variables><!-- Comma separated list of the molecule variables written every writefrequency steps, e.g. rx,ry,rz,molecule_id (default: all) --></variables>
+		 <fullsnapshotfrequency><!-- All molecule variables are written every this many steps (default: 0, never) --></fullsnapshotfrequency>
 	   </outputplugin>
 	   \endcode
 	 */
@@ -79,10 +79,28 @@ public:
 protected:
 	//
 private:
-	void resetContainers();
-	void clearContainers();
+	//! a molecule variable which can be written, either an index (uint64_t) or a value (PRECISION)
+	struct Quantity {
+		const char* name;
+		bool rotational;  // only written by default if there are multi-center components
+		uint64_t (*index)(const Molecule&);
+		double (*value)(const Molecule&);
+	};
+	static const std::vector<Quantity>& quantities();
+
+	/**
+	 * @brief determine the variables of the full and the thin snapshots
+	 */
+	void selectQuantities();
 	void defineVariables(const uint64_t global, const uint64_t offset, const uint64_t local, const int numProcs,
-						 const int rank);
+						 const int rank, const std::vector<size_t>& selectedQuantities);
+	/**
+	 * @brief write one variable of all local molecules
+	 * @details Without compression the values are written directly into the buffer of the engine (span), otherwise
+	 * they are collected in a buffer which is reused for all variables.
+	 */
+	template <typename T>
+	void putQuantity(const Quantity& quantity, ParticleContainer* particleContainer, uint64_t localNumParticles);
 	void initAdios2();
 	std::vector<Component> _comps;
 	// output filename, from XML
@@ -95,8 +113,15 @@ private:
 	std::string _compression_rate;
 	std::string _append_mode;
 	int32_t _num_files;
-	// variables to write, see documentation
-	std::map<std::string, std::variant<std::vector<double>, std::vector<float>, std::vector<uint64_t>>> _vars;
+	std::string _variables;
+	uint32_t _fullsnapshotfrequency = 0;
+	// indices into quantities() of the variables to write, see documentation
+	std::vector<size_t> _fullQuantities;
+	std::vector<size_t> _thinQuantities;
+	// buffers for writing with compression, spans are used otherwise
+	bool _zeroCopy = true;
+	std::vector<PRECISION> _valueBuffer;
+	std::vector<uint64_t> _indexBuffer;
 	// main instance
 	std::shared_ptr<adios2::ADIOS> _inst;
 	std::shared_ptr<adios2::Engine> _engine;
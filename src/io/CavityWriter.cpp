@@ -1,5 +1,6 @@
 #include "io/CavityWriter.h"
 
+#include <cmath>
 #include <fstream>
 #include <sstream>
 
@@ -34,6 +35,16 @@ void CavityWriter::readXML(XMLfileUnits &xmlconfig) {
     }
     Log::global_log->info() << "[CavityWriter] Append timestamp: " << _appendTimestamp << std::endl;
 
+    int writeCoordinates = 1;
+    xmlconfig.getNodeValue("writeCoordinates", writeCoordinates);
+    _writeCoordinates = (writeCoordinates != 0);
+    Log::global_log->info() << "[CavityWriter] Write coordinates: " << _writeCoordinates << std::endl;
+
+    int writeSizeDistribution = 0;
+    xmlconfig.getNodeValue("writeSizeDistribution", writeSizeDistribution);
+    _writeSizeDistribution = (writeSizeDistribution != 0);
+    Log::global_log->info() << "[CavityWriter] Write size distribution: " << _writeSizeDistribution << std::endl;
+
 
     xmlconfig.getNodeValue("maxNeighbours", _maxNeighbors);
     if (_maxNeighbors <= 0) {
@@ -169,7 +180,9 @@ void CavityWriter::afterForces(
         std::map<unsigned, CavityEnsemble *>::iterator ceit;
         for (ceit = this->_mcav.begin(); ceit != this->_mcav.end(); ceit++) {
 
-            ceit->second->cavityStep(particleContainer);
+            const LocalDensity &neighbourSearch = global_simulation->getDomain()->getLocalDensity(
+                    particleContainer, std::sqrt(ceit->second->getRR()), simstep);
+            ceit->second->cavityStep(neighbourSearch);
             ceit->second->communicateNumCavities(domainDecomp);
 
         }
@@ -196,43 +209,52 @@ void CavityWriter::endStep(ParticleContainer * /*particleContainer*/, DomainDeco
             }
         }
 
-        for (ceit = _mcav.begin(); ceit != _mcav.end(); ceit++) {
-            *cav_filenamestream[ceit->first] << ".cav.xyz";
-            Log::global_log->info() << "[CavityWriter] outputName: " << cav_filenamestream[ceit->first]->str() << std::endl;
-        }
-
         int ownRank = domainDecomp->getRank();
-        if (ownRank == 0) {
+        if (_writeSizeDistribution) {
             for (ceit = _mcav.begin(); ceit != _mcav.end(); ceit++) {
-                std::ofstream cavfilestream(cav_filenamestream[ceit->first]->str().c_str());
-                cavfilestream << ceit->second->numCavities() << std::endl;
-                cavfilestream << "comment line" << std::endl;
-                cavfilestream.close();
+                const std::map<unsigned long, unsigned long> sizes = ceit->second->clusterSizeDistribution(domainDecomp);
+                if (ownRank == 0) {
+                    std::ofstream histfilestream(cav_filenamestream[ceit->first]->str() + ".cav.hist");
+                    histfilestream << "# cluster size\tnumber of clusters" << std::endl;
+                    for (const auto &sizeAndCount : sizes) {
+                        histfilestream << sizeAndCount.first << "\t" << sizeAndCount.second << "\n";
+                    }
+                }
             }
         }
+        if (_writeCoordinates) {
+            for (ceit = _mcav.begin(); ceit != _mcav.end(); ceit++) {
+                *cav_filenamestream[ceit->first] << ".cav.xyz";
+                Log::global_log->info() << "[CavityWriter] outputName: " << cav_filenamestream[ceit->first]->str() << std::endl;
+            }
 
-        for (int process = 0; process < domainDecomp->getNumProcs(); process++) {
-            domainDecomp->barrier();
-            if (ownRank == process) {
+            if (ownRank == 0) {
                 for (ceit = _mcav.begin(); ceit != _mcav.end(); ceit++) {
+                    std::ofstream cavfilestream(cav_filenamestream[ceit->first]->str().c_str());
+                    cavfilestream << ceit->second->numCavities() << std::endl;
+                    cavfilestream << "comment line" << std::endl;
+                    cavfilestream.close();
+                }
+            }
 
-                    std::ofstream cavfilestream(cav_filenamestream[ceit->first]->str().c_str(), std::ios::app);
+            for (int process = 0; process < domainDecomp->getNumProcs(); process++) {
+                domainDecomp->barrier();
+                if (ownRank == process) {
+                    for (ceit = _mcav.begin(); ceit != _mcav.end(); ceit++) {
 
-                    std::map<unsigned long, Molecule *> tcav = ceit->second->activeParticleContainer();
-                    std::map<unsigned long, Molecule *>::iterator tcit;
-                    for (tcit = tcav.begin(); tcit != tcav.end(); tcit++) {
-                        //global_log->info() << "[CavityWriter] output6" << std::endl;
+                        std::ofstream cavfilestream(cav_filenamestream[ceit->first]->str().c_str(), std::ios::app);
 
-                        if (ceit->first == 0) { cavfilestream << "C "; }
-                        else if (ceit->first == 1) { cavfilestream << "N "; }
-                        else if (ceit->first == 2) { cavfilestream << "O "; }
-                        else if (ceit->first == 3) { cavfilestream << "F "; }
-                        else { cavfilestream << "Ne "; }
-                        cavfilestream << tcit->second->r(0) << "\t" << tcit->second->r(1) << "\t" << tcit->second->r(2)
-                                      << "\n";
-                    }
+                        for (const Molecule *tcav : ceit->second->activeParticleContainer()) {
+                            if (ceit->first == 0) { cavfilestream << "C "; }
+                            else if (ceit->first == 1) { cavfilestream << "N "; }
+                            else if (ceit->first == 2) { cavfilestream << "O "; }
+                            else if (ceit->first == 3) { cavfilestream << "F "; }
+                            else { cavfilestream << "Ne "; }
+                            cavfilestream << tcav->r(0) << "\t" << tcav->r(1) << "\t" << tcav->r(2) << "\n";
+                        }
 
-                    cavfilestream.close();
+                        cavfilestream.close();
+                    }
                 }
             }
         }
@@ -24,6 +24,9 @@ public:
      *	radius: search radius around pseudo-molecules to look for neighbors with componentid=0/1...<br>
      *	maxNeighbours: number of neighbours allowed in radius for a pseudo-molecule to count as a cavity<br>
      *	Nx,Ny,Nz: grid numbers for grid of pseudo-molecules, sampling cavity properties at their grid position<br>
+     *	writeCoordinates: write the positions of all cavities to .cav.xyz files (default 1)<br>
+     *	writeSizeDistribution: write the number of cavity clusters per cluster size to .cav.hist files (default 0),
+     *	cavities which are neighbours on the grid belong to the same cluster<br>
      *	<br>
      *	for non-overlapping coverage: radius*N_xyz = domainSize_xyz<br>
      *	<br>
@@ -37,6 +40,8 @@ public:
                 <Nx>40</Nx>
                 <Ny>40</Ny>
                 <Nz>40</Nz>
+                <writeCoordinates>1</writeCoordinates>
+                <writeSizeDistribution>1</writeSizeDistribution>
                 <ControlVolume>
                     <x0> LowerBound (1.0) </x0>
                     <x1> UpperBound (2.0) </x1>
@@ -123,6 +128,8 @@ private:
     unsigned long _writeFrequency;
     bool _appendTimestamp;
     bool _incremental;
+    bool _writeCoordinates;
+    bool _writeSizeDistribution;
     int _Nx = 0, _Ny = 0, _Nz = 0;
     int _maxNeighbors = 0;
     float _radius = 0.0f;
@@ -38,6 +38,8 @@ public:
 	void finish(ParticleContainer *particleContainer,
 				DomainDecompBase *domainDecomp, Domain *domain);
 
+	bool requiresMacroscopicValues(unsigned long) override { return false; }
+
 	std::string getPluginName() {
 		return std::string("CheckpointWriter");
 	}
@@ -44,6 +44,8 @@ public:
 	void finish(ParticleContainer *particleContainer,
 				DomainDecompBase *domainDecomp, Domain *domain);
 
+	bool requiresMacroscopicValues(unsigned long simstep) override { return simstep % _writeFrequency == 0; }
+
 	std::string getPluginName() {
 		return std::string("EnergyLogWriter");
 	}
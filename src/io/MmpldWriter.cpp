@@ -18,7 +18,9 @@
 #include <vector>
 #include <array>
 #include <iostream>
+#include <algorithm>
 #include <cstdint>
+#include <limits>
 
 #include "Common.h"
 #include "Domain.h"
@@ -29,6 +31,7 @@
 #include "utils/FileUtils.h"
 #include "utils/Logger.h"
 #include "utils/mardyn_assert.h"
+#include "WrapOpenMP.h"
 
 
 // default version to use for mmpld format writing. possible values: 100 or 102
@@ -43,14 +46,14 @@ std::string MmpldWriter::getOutputFilename() {
 }
 
 MmpldWriter::MmpldWriter() :
-		_startTimestep(0), _writeFrequency(1000), _stopTimestep(std::numeric_limits<uint64_t>::max()), _writeBufferSize(32768), _outputPrefix("unknown"),
+		_startTimestep(0), _writeFrequency(1000), _stopTimestep(std::numeric_limits<uint64_t>::max()), _aggregateNodes(false), _outputPrefix("unknown"),
 		_bInitSphereData(ISD_READ_FROM_XML), _bWriteControlPrepared(false),
 		_fileCount(1), _numFramesPerFile(0), _mmpldversion(MMPLD_DEFAULT_VERSION), _vertex_type(MMPLD_VERTEX_FLOAT_XYZ), _color_type(MMPLD_COLOR_NONE)
 {}
 
 MmpldWriter::MmpldWriter(uint64_t startTimestep, uint64_t writeFrequency, uint64_t stopTimestep, uint64_t numFramesPerFile,
 		std::string outputPrefix)
-		:	_startTimestep(startTimestep), _writeFrequency(writeFrequency), _stopTimestep(stopTimestep), _writeBufferSize(32768),
+		:	_startTimestep(startTimestep), _writeFrequency(writeFrequency), _stopTimestep(stopTimestep), _aggregateNodes(false),
 		_outputPrefix(outputPrefix), _bInitSphereData(ISD_READ_FROM_XML), _bWriteControlPrepared(false),
 		_fileCount(1),_numFramesPerFile(numFramesPerFile),  _vertex_type(MMPLD_VERTEX_FLOAT_XYZ),
 		_color_type(MMPLD_COLOR_NONE)
@@ -62,6 +65,19 @@ MmpldWriter::MmpldWriter(uint64_t startTimestep, uint64_t writeFrequency, uint64
 	}
 }
 
+MmpldWriter::~MmpldWriter()
+{
+#ifdef ENABLE_MPI
+	// processes not writing with node aggregation hold MPI_COMM_SELF as placeholder, which must not be freed
+	if (_ioComm != MPI_COMM_NULL && _ioComm != MPI_COMM_SELF) {
+		MPI_CHECK( MPI_Comm_free(&_ioComm) );
+	}
+	if (_nodeComm != MPI_COMM_NULL) {
+		MPI_CHECK( MPI_Comm_free(&_nodeComm) );
+	}
+#endif
+}
+
 void MmpldWriter::readXML(XMLfileUnits& xmlconfig)
 {
 	// color type
@@ -75,12 +91,12 @@ void MmpldWriter::readXML(XMLfileUnits& xmlconfig)
 	xmlconfig.getNodeValue("writecontrol/writefrequency", _writeFrequency);
 	xmlconfig.getNodeValue("writecontrol/stop", _stopTimestep);
 	xmlconfig.getNodeValue("writecontrol/framesperfile", _numFramesPerFile);
-	xmlconfig.getNodeValue("writecontrol/writeBufferSize", _writeBufferSize);
 	Log::global_log->info() << "[MMPLD Writer] Start sampling from simstep: " << _startTimestep << std::endl;
 	Log::global_log->info() << "[MMPLD Writer] Write with frequency: " << _writeFrequency << std::endl;
 	Log::global_log->info() << "[MMPLD Writer] Stop sampling at simstep: " << _stopTimestep << std::endl;
 	Log::global_log->info() << "[MMPLD Writer] Split files every " << _numFramesPerFile << "th frame."<< std::endl;
-	Log::global_log->info() << "[MMPLD Writer] Write buffer size: " << _writeBufferSize << " Byte" << std::endl;
+	xmlconfig.getNodeValue("aggregatenodes", _aggregateNodes);
+	Log::global_log->info() << "[MMPLD Writer] Aggregate data per node: " << (_aggregateNodes ? "yes" : "no") << std::endl;
 
 	int mmpldversion = MMPLD_DEFAULT_VERSION;
 	xmlconfig.getNodeValue("mmpldversion", mmpldversion);
@@ -155,6 +171,25 @@ void MmpldWriter::init(ParticleContainer *particleContainer,
 	// only executed once
 	this->PrepareWriteControl();
 
+#ifdef ENABLE_MPI
+	if (_ioComm == MPI_COMM_NULL) {
+		if (_aggregateNodes) {
+			int worldRank;
+			MPI_CHECK( MPI_Comm_rank(MPI_COMM_WORLD, &worldRank) );
+			MPI_CHECK( MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, worldRank, MPI_INFO_NULL, &_nodeComm) );
+			int nodeRank;
+			MPI_CHECK( MPI_Comm_rank(_nodeComm, &nodeRank) );
+			// the first process of every node writes, ordered as in MPI_COMM_WORLD, so world rank 0 writes the headers
+			MPI_CHECK( MPI_Comm_split(MPI_COMM_WORLD, nodeRank == 0 ? 0 : MPI_UNDEFINED, worldRank, &_ioComm) );
+			if (nodeRank != 0) {
+				_ioComm = MPI_COMM_SELF;  // marks the communicators as set up, not used for writing
+			}
+		} else {
+			MPI_CHECK( MPI_Comm_dup(MPI_COMM_WORLD, &_ioComm) );
+		}
+	}
+#endif
+
 	_frameCount = 0;
 
 	// number of components / sites
@@ -230,31 +265,138 @@ void MmpldWriter::init(ParticleContainer *particleContainer,
 
 
 void MmpldWriter::write_frame(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp) {
-	std::string filename = getOutputFilename();
+	const long particleDataSize = get_particle_data_size();
+
+	// convert the molecules into the sphere data of every sphere type, in parallel over the cells
+	std::vector<std::vector<std::vector<char>>> threadData(mardyn_get_max_threads(),
+		std::vector<std::vector<char>>(_numSphereTypes));
+	#if defined(_OPENMP)
+	#pragma omp parallel
+	#endif
+	{
+		auto& localData = threadData[mardyn_get_thread_num()];
+		for (auto mol = particleContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); mol.isValid(); ++mol) {
+			for (uint8_t sphereTypeId = 0; sphereTypeId < _numSphereTypes; ++sphereTypeId) {
+				// large enough for the largest vertex and color types
+				float sphere[8] = {0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f};
+				if (GetSpherePos(sphere, &(*mol), sphereTypeId)) {
+					const char* sphereBytes = reinterpret_cast<const char*>(sphere);
+					localData[sphereTypeId].insert(localData[sphereTypeId].end(), sphereBytes, sphereBytes + particleDataSize);
+				}
+			}
+		}
+	}
 
-	// calculate local number of spheres per component|siteType
-	std::vector<uint64_t> numSpheresPerType(_numSphereTypes);
-	this->CalcNumSpheresPerType(particleContainer, numSpheresPerType.data());
+	std::vector<uint64_t> numSpheresPerType(_numSphereTypes, 0);
+	std::vector<std::vector<Segment>> segments(_numSphereTypes);
+	for (uint8_t sphereTypeId = 0; sphereTypeId < _numSphereTypes; ++sphereTypeId) {
+		for (const auto& localData : threadData) {
+			const auto& data = localData[sphereTypeId];
+			numSpheresPerType[sphereTypeId] += data.size() / particleDataSize;
+			segments[sphereTypeId].push_back({data.data(), data.size()});
+		}
+	}
 
 #ifdef ENABLE_MPI
-	int rank = domainDecomp->getRank();
+	if (_aggregateNodes) {
+		int nodeRank, nodeSize;
+		MPI_CHECK( MPI_Comm_rank(_nodeComm, &nodeRank) );
+		MPI_CHECK( MPI_Comm_size(_nodeComm, &nodeSize) );
+
+		// number of spheres per type of every process of the node
+		std::vector<uint64_t> nodeNumSpheres(nodeRank == 0 ? nodeSize * _numSphereTypes : 0);
+		MPI_CHECK( MPI_Gather(numSpheresPerType.data(), _numSphereTypes, MPI_UINT64_T, nodeNumSpheres.data(),
+							  _numSphereTypes, MPI_UINT64_T, 0, _nodeComm) );
+
+		// send the segments of all types at once, they arrive contiguously, ordered by type
+		std::vector<int> blockLengths;
+		std::vector<MPI_Aint> addresses;
+		uint64_t sendSize = 0;
+		for (const auto& typeSegments : segments) {
+			for (const auto& segment : typeSegments) {
+				if (segment.size == 0) {
+					continue;
+				}
+				MPI_Aint address;
+				MPI_CHECK( MPI_Get_address(segment.data, &address) );
+				addresses.push_back(address);
+				blockLengths.push_back(static_cast<int>(segment.size));
+				sendSize += segment.size;
+			}
+		}
+		if (sendSize > static_cast<uint64_t>(std::numeric_limits<int>::max())) {
+			std::ostringstream error_message;
+			error_message << "[MMPLD Writer] Sphere data of " << sendSize << " bytes is too large to be gathered on the node." << std::endl;
+			MARDYN_EXIT(error_message.str());
+		}
+		MPI_Datatype sendType;
+		MPI_CHECK( MPI_Type_create_hindexed(blockLengths.size(), blockLengths.data(), addresses.data(), MPI_BYTE, &sendType) );
+		MPI_CHECK( MPI_Type_commit(&sendType) );
+
+		std::vector<int> recvCounts(nodeSize, 0), displacements(nodeSize, 0);
+		if (nodeRank == 0) {
+			uint64_t nodeBytes = 0;
+			for (int r = 0; r < nodeSize; ++r) {
+				uint64_t bytes = 0;
+				for (uint8_t sphereTypeId = 0; sphereTypeId < _numSphereTypes; ++sphereTypeId) {
+					bytes += get_data_list_size(nodeNumSpheres[r * _numSphereTypes + sphereTypeId]);
+				}
+				recvCounts[r] = static_cast<int>(bytes);
+				displacements[r] = static_cast<int>(nodeBytes);
+				nodeBytes += bytes;
+			}
+			if (nodeBytes > static_cast<uint64_t>(std::numeric_limits<int>::max())) {
+				std::ostringstream error_message;
+				error_message << "[MMPLD Writer] Sphere data of " << nodeBytes << " bytes is too large to be gathered on the node." << std::endl;
+				MARDYN_EXIT(error_message.str());
+			}
+		}
+		std::vector<char> nodeData(nodeRank == 0 ? displacements.back() + recvCounts.back() : 0);
+		MPI_CHECK( MPI_Gatherv(MPI_BOTTOM, sendSize > 0 ? 1 : 0, sendType, nodeData.data(), recvCounts.data(),
+							   displacements.data(), MPI_BYTE, 0, _nodeComm) );
+		MPI_CHECK( MPI_Type_free(&sendType) );
+
+		if (nodeRank != 0) {
+			_frameCount++;
+			return;
+		}
+		// the node's data replaces the local one
+		for (uint8_t sphereTypeId = 0; sphereTypeId < _numSphereTypes; ++sphereTypeId) {
+			segments[sphereTypeId].clear();
+			numSpheresPerType[sphereTypeId] = 0;
+		}
+		for (int r = 0; r < nodeSize; ++r) {
+			const char* data = nodeData.data() + displacements[r];
+			for (uint8_t sphereTypeId = 0; sphereTypeId < _numSphereTypes; ++sphereTypeId) {
+				const uint64_t numSpheres = nodeNumSpheres[r * _numSphereTypes + sphereTypeId];
+				segments[sphereTypeId].push_back({data, static_cast<uint64_t>(get_data_list_size(numSpheres))});
+				numSpheresPerType[sphereTypeId] += numSpheres;
+				data += get_data_list_size(numSpheres);
+			}
+		}
+		write_frame_data(segments, numSpheresPerType);
+		return;
+	}
+#endif
+	write_frame_data(segments, numSpheresPerType);
+}
 
-	MPI_File_open(MPI_COMM_WORLD, const_cast<char*>(filename.c_str()), MPI_MODE_WRONLY|MPI_MODE_CREATE, _mpiinfo, &_mpifh);
+void MmpldWriter::write_frame_data(const std::vector<std::vector<Segment>>& segments,
+								   const std::vector<uint64_t>& numSpheresPerType) {
+	std::string filename = getOutputFilename();
+	int rank = 0;
 
 	//distribute global component particle count and offset counts for distrubted write
-	std::vector<uint64_t> globalNumCompSpheres(_numSphereTypes);
-	std::vector<uint64_t> exscanNumCompSpheres(_numSphereTypes);
-	MPI_Exscan(numSpheresPerType.data(), exscanNumCompSpheres.data(), _numSphereTypes, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD);
-	for(int i = 0; i < _numSphereTypes; ++i) {
-		globalNumCompSpheres[i] = exscanNumCompSpheres[i] + numSpheresPerType[i];
-	}
-	int lastrank = domainDecomp->getNumProcs() - 1;
-	MPI_Bcast(globalNumCompSpheres.data(), _numSphereTypes, MPI_UINT64_T, lastrank, MPI_COMM_WORLD);
-
-	if(rank == 0) {
-		MPI_File_seek(_mpifh, _seekTable.at(_frameCount), MPI_SEEK_SET);
-		write_frame_header(_numSphereTypes);
+	std::vector<uint64_t> globalNumCompSpheres(numSpheresPerType);
+	std::vector<uint64_t> exscanNumCompSpheres(_numSphereTypes, 0);
+#ifdef ENABLE_MPI
+	MPI_CHECK( MPI_Comm_rank(_ioComm, &rank) );
+	MPI_CHECK( MPI_Exscan(numSpheresPerType.data(), exscanNumCompSpheres.data(), _numSphereTypes, MPI_UINT64_T, MPI_SUM, _ioComm) );
+	MPI_CHECK( MPI_Allreduce(numSpheresPerType.data(), globalNumCompSpheres.data(), _numSphereTypes, MPI_UINT64_T, MPI_SUM, _ioComm) );
+	if (rank == 0) {
+		std::fill(exscanNumCompSpheres.begin(), exscanNumCompSpheres.end(), 0);
 	}
+#endif
 
 	/* positions of data lists relative to frame begin */
 	std::vector<uint64_t> dataListBeginOffsets(_numSphereTypes);
@@ -262,52 +404,83 @@ void MmpldWriter::write_frame(ParticleContainer* particleContainer, DomainDecomp
 	for(int i = 1; i < _numSphereTypes; ++i) {
 		dataListBeginOffsets[i] = dataListBeginOffsets[i-1] + get_data_list_header_size() + get_data_list_size(globalNumCompSpheres[i-1]);
 	}
-	/* calculate write positions inside data lists for this process */
-	std::vector<uint64_t> dataListWriteOffsets(_numSphereTypes);
-	for(int i = 0; i < _numSphereTypes; ++i) {
-		dataListWriteOffsets[i] = get_data_list_header_size() + get_data_list_size(exscanNumCompSpheres[i]);
+	const uint64_t frameBegin = _seekTable.at(_frameCount);
+	const uint64_t frame_offset = dataListBeginOffsets.back() + get_data_list_header_size() + get_data_list_size(globalNumCompSpheres.back());
+	_frameCount++;
+	_seekTable.at(_frameCount) = frameBegin + frame_offset;
+
+	// pieces of the file written by this process, in increasing order of their position in the file
+	std::vector<uint64_t> filePositions;
+	std::vector<Segment> pieces;
+	auto addPiece = [&](uint64_t position, const char* data, uint64_t size) {
+		if (size > 0) {
+			filePositions.push_back(position);
+			pieces.push_back({data, size});
+		}
+	};
+	// the headers are only written by the first process
+	const uint32_t frameCount_le = htole32(_frameCount);
+	const uint64_t seekTableEntry_le = htole64(_seekTable.at(_frameCount));
+	std::vector<char> frameHeader;
+	std::vector<std::vector<char>> listHeaders(_numSphereTypes);
+	if (rank == 0) {
+		// 8: frame count position in file header
+		addPiece(8, reinterpret_cast<const char*>(&frameCount_le), sizeof(frameCount_le));
+		addPiece(MMPLD_SEEK_TABLE_OFFSET + _frameCount * sizeof(uint64_t),
+				 reinterpret_cast<const char*>(&seekTableEntry_le), sizeof(seekTableEntry_le));
+		write_frame_header(_numSphereTypes, frameHeader);
+		addPiece(frameBegin, frameHeader.data(), frameHeader.size());
 	}
-
-	char* writeBuffer = new char[_writeBufferSize];
-	long buffer_pos = 0;
 	/* write particle list for each component|site (sphere type)`*/
-	for (uint8_t sphereTypeId = 0; sphereTypeId < _numSphereTypes; ++sphereTypeId){
-		//write particle list header
-		if(rank == 0) {
-			long offset = _seekTable.at(_frameCount) + dataListBeginOffsets[sphereTypeId];
-			MPI_File_seek(_mpifh, offset, MPI_SEEK_SET);
-			write_particle_list_header(globalNumCompSpheres[sphereTypeId], sphereTypeId);
+	for (uint8_t sphereTypeId = 0; sphereTypeId < _numSphereTypes; ++sphereTypeId) {
+		uint64_t position = frameBegin + dataListBeginOffsets[sphereTypeId];
+		if (rank == 0) {
+			write_particle_list_header(globalNumCompSpheres[sphereTypeId], sphereTypeId, listHeaders[sphereTypeId]);
+			addPiece(position, listHeaders[sphereTypeId].data(), listHeaders[sphereTypeId].size());
 		}
-		long offset = _seekTable.at(_frameCount) + dataListBeginOffsets[sphereTypeId] + dataListWriteOffsets[sphereTypeId];
-		MPI_File_seek(_mpifh, offset, MPI_SEEK_SET);
-		buffer_pos = 0;
-		for (auto moleculeIter = particleContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); moleculeIter.isValid(); ++moleculeIter) {
-			if(true == GetSpherePos(reinterpret_cast<float*>(&writeBuffer[buffer_pos]), &(*moleculeIter), sphereTypeId)) {
-				buffer_pos += get_particle_data_size();
-				if(buffer_pos > _writeBufferSize - get_particle_data_size()) {
-					MPI_Status status;
-					MPI_File_write(_mpifh, writeBuffer, buffer_pos, MPI_BYTE, &status);
-					buffer_pos = 0;
-				}
-			}
+		position += get_data_list_header_size() + get_data_list_size(exscanNumCompSpheres[sphereTypeId]);
+		for (const auto& segment : segments[sphereTypeId]) {
+			addPiece(position, segment.data, segment.size);
+			position += segment.size;
 		}
-		MPI_Status status;
-		MPI_File_write(_mpifh, writeBuffer, buffer_pos, MPI_BYTE, &status);
 	}
-	delete[] writeBuffer;
-	// data of frame is written
-	_frameCount++;
-	uint64_t frame_offset = dataListBeginOffsets.back() + get_data_list_header_size() + get_data_list_size(globalNumCompSpheres.back());
-	_seekTable.at(_frameCount) = _seekTable.at(_frameCount - 1) + frame_offset;
-	// write seek table entry and update frame count
-	if (rank == 0) {
-		writeSeekTableEntry(_frameCount, _seekTable.at(_frameCount));
-		MPI_Status status;
-		uint32_t frameCount = htole32(_frameCount);
-		// 8: frame count position in file header
-		MPI_File_write_at(_mpifh, 8, &frameCount, sizeof(frameCount), MPI_BYTE, &status);
+
+#ifdef ENABLE_MPI
+	std::vector<int> blockLengths(pieces.size());
+	std::vector<MPI_Aint> fileDisplacements(pieces.size());
+	std::vector<MPI_Aint> addresses(pieces.size());
+	for (size_t i = 0; i < pieces.size(); ++i) {
+		if (pieces[i].size > static_cast<uint64_t>(std::numeric_limits<int>::max())) {
+			std::ostringstream error_message;
+			error_message << "[MMPLD Writer] Sphere data of " << pieces[i].size << " bytes is too large for one write." << std::endl;
+			MARDYN_EXIT(error_message.str());
+		}
+		blockLengths[i] = static_cast<int>(pieces[i].size);
+		fileDisplacements[i] = static_cast<MPI_Aint>(filePositions[i]);
+		MPI_CHECK( MPI_Get_address(pieces[i].data, &addresses[i]) );
+	}
+	MPI_Datatype fileType, memoryType;
+	MPI_CHECK( MPI_Type_create_hindexed(pieces.size(), blockLengths.data(), fileDisplacements.data(), MPI_BYTE, &fileType) );
+	MPI_CHECK( MPI_Type_commit(&fileType) );
+	MPI_CHECK( MPI_Type_create_hindexed(pieces.size(), blockLengths.data(), addresses.data(), MPI_BYTE, &memoryType) );
+	MPI_CHECK( MPI_Type_commit(&memoryType) );
+
+	MPI_CHECK( MPI_File_open(_ioComm, const_cast<char*>(filename.c_str()), MPI_MODE_WRONLY|MPI_MODE_CREATE, _mpiinfo, &_mpifh) );
+	MPI_CHECK( MPI_File_set_view(_mpifh, 0, MPI_BYTE, fileType, "native", _mpiinfo) );
+	MPI_CHECK( MPI_File_write_at_all(_mpifh, 0, MPI_BOTTOM, 1, memoryType, MPI_STATUS_IGNORE) );
+	MPI_CHECK( MPI_File_close(&_mpifh) );
+
+	MPI_CHECK( MPI_Type_free(&fileType) );
+	MPI_CHECK( MPI_Type_free(&memoryType) );
+#else
+	std::fstream mmpldfstream(filename.c_str(), std::ios::binary|std::ios::in|std::ios::out);
+	for (size_t i = 0; i < pieces.size(); ++i) {
+		mmpldfstream.seekp(filePositions[i]);
+		mmpldfstream.write(pieces[i].data, pieces[i].size);
+	}
+	if (not mmpldfstream) {
+		Log::global_log->error() << "[MMPLD Writer] Could not write frame to " << filename << std::endl;
 	}
-	MPI_File_close(&_mpifh);
 #endif
 }
 
@@ -463,63 +636,42 @@ long MmpldWriter::get_data_list_size(uint64_t particle_count) {
 }
 
 
-void MmpldWriter::write_frame_header(uint32_t num_data_lists) {
-#ifdef ENABLE_MPI
-	MPI_Status status;
+void MmpldWriter::write_frame_header(uint32_t num_data_lists, std::vector<char>& buffer) {
+	auto append = [&buffer](const void* data, size_t size) {
+		buffer.insert(buffer.end(), static_cast<const char*>(data), static_cast<const char*>(data) + size);
+	};
 	if (_mmpldversion == 102){
 		float frameHeader_timestamp = _simulation.getSimulationTime();
-		MPI_File_write(_mpifh, &frameHeader_timestamp, 1, MPI_FLOAT, &status);
+		append(&frameHeader_timestamp, sizeof(frameHeader_timestamp));
 	}
 	uint32_t num_data_lists_le = htole32(num_data_lists);
-	MPI_File_write(_mpifh, &num_data_lists_le, sizeof(num_data_lists_le), MPI_BYTE, &status);
-#else
-	/** @todo need to implement serial version */
-#endif
+	append(&num_data_lists_le, sizeof(num_data_lists_le));
 }
 
 long MmpldWriter::get_seekTable_size(){
 	return _numSeekEntries * sizeof(uint64_t);
 }
 
-void MmpldWriter::writeSeekTableEntry(int id, uint64_t offset) {
-#ifdef ENABLE_MPI
-	MPI_Offset seekpos = MMPLD_SEEK_TABLE_OFFSET + id*sizeof(uint64_t);
-	uint64_t offset_le = htole64(offset);
-	MPI_Status status;
-	MPI_File_write_at(_mpifh, seekpos, &offset_le, 8, MPI_BYTE, &status);
-#endif
-}
-
-void MmpldWriter::write_particle_list_header(uint64_t particle_count, int sphereId) {
-#ifdef ENABLE_MPI
-	MPI_Status status;
-	MPI_File_write(_mpifh, &_vertex_type,  1, MPI_BYTE, &status);
-	MPI_File_write(_mpifh, &_color_type,   1, MPI_BYTE, &status);
+void MmpldWriter::write_particle_list_header(uint64_t particle_count, int sphereId, std::vector<char>& buffer) {
+	auto append = [&buffer](const void* data, size_t size) {
+		buffer.insert(buffer.end(), static_cast<const char*>(data), static_cast<const char*>(data) + size);
+	};
+	append(&_vertex_type, 1);
+	append(&_color_type, 1);
 	if(_vertex_type == MMPLD_VERTEX_FLOAT_XYZ || _vertex_type == MMPLD_VERTEX_SHORT_XYZ) {
-		MPI_File_write(_mpifh, &_global_radius[sphereId], 4, MPI_BYTE, &status);
+		append(&_global_radius[sphereId], 4);
 	}
 	if(_color_type == MMPLD_COLOR_NONE) {
-		MPI_File_write(_mpifh, &_global_rgba[sphereId],   4, MPI_BYTE, &status);
+		append(&_global_rgba[sphereId], 4);
 	} else if(_color_type == MMPLD_COLOR_FLOAT_I) {
-		MPI_File_write(_mpifh, &_global_intensity_range[sphereId],   8, MPI_BYTE, &status);
+		append(&_global_intensity_range[sphereId], 8);
 	}
 	uint64_t particle_count_le = htole64(particle_count);
-	MPI_File_write(_mpifh, &particle_count_le, sizeof(particle_count_le), MPI_BYTE, &status);
-#else
-	/** @todo need to implement serial version */
-#endif
+	append(&particle_count_le, sizeof(particle_count_le));
 }
 
 
 // derived classes
-void MmpldWriterSimpleSphere::CalcNumSpheresPerType(ParticleContainer* particleContainer, uint64_t* numSpheresPerType)
-{
-	for (auto mol = particleContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); mol.isValid(); ++mol) {
-		uint8_t cid = mol->componentid();
-		numSpheresPerType[cid]++;
-	}
-}
-
 bool MmpldWriterSimpleSphere::GetSpherePos(float *spherePos, Molecule* mol, uint8_t& nSphereTypeIndex)
 {
 	uint8_t cid = mol->componentid();
@@ -530,16 +682,6 @@ bool MmpldWriterSimpleSphere::GetSpherePos(float *spherePos, Molecule* mol, uint
 }
 
 
-void MmpldWriterMultiSphere::CalcNumSpheresPerType(ParticleContainer* particleContainer, uint64_t* numSpheresPerType)
-{
-	for (auto mol = particleContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); mol.isValid(); ++mol) {
-		uint8_t cid = mol->componentid();
-		uint8_t offset = _nCompSitesOffset.at(cid);
-		for (uint8_t si = 0; si < _numSitesPerComp.at(cid); ++si)
-			numSpheresPerType[offset+si]++;
-	}
-}
-
 bool MmpldWriterMultiSphere::GetSpherePos(float *spherePos, Molecule* mol, uint8_t& nSphereTypeIndex)
 {
 	bool ret = false;
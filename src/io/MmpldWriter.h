@@ -37,6 +37,11 @@ enum MMPLD_Color_type : std::uint8_t {
 };
 
 /** @brief Output plugin to generate a MegaMol™ Particle List Data file (*.mmpld).
+ *
+ * The sphere data of a frame is converted in parallel over the cells with OpenMP and written with one collective
+ * MPI-IO call, the processes determine their positions in the particle lists by an exclusive scan. With
+ * <aggregatenodes>true</aggregatenodes> the processes of a node first gather their data on the node's first process,
+ * so only one process per node accesses the file.
  */
 class MmpldWriter : public PluginBase
 {
@@ -55,10 +60,9 @@ protected:
 	//! @param writeFrequency Controls the frequency of writing out the data (every timestep, every 10th, 100th, ... timestep)
 	MmpldWriter(std::uint64_t startTimestep, std::uint64_t writeFrequency, std::uint64_t stopTimestep, std::uint64_t numFramesPerFile,
 			std::string outputPrefix);
-	virtual ~MmpldWriter() {}
+	virtual ~MmpldWriter();
 
 	virtual void SetNumSphereTypes() {}
-	virtual void CalcNumSpheresPerType(ParticleContainer* particleContainer, std::uint64_t* numSpheresPerType) {}
 	virtual bool GetSpherePos(float *spherePos, Molecule* mol, std::uint8_t& nSphereTypeIndex) { return false; }
 
 	void InitSphereData();
@@ -75,6 +79,8 @@ public:
     );
 	void finish(ParticleContainer *particleContainer, DomainDecompBase *domainDecomp, Domain *domain) {}
 
+	bool requiresMacroscopicValues(unsigned long) override { return false; }
+
 	std::string getPluginName() {
 		return std::string("MmpldWriter");
 	}
@@ -91,14 +97,22 @@ protected:
 	void PrepareWriteControl();
 	long get_data_frame_header_size();
 	long get_seekTable_size();
-	void writeSeekTableEntry(int id, std::uint64_t offset);
 	long get_data_list_header_size();
 	long get_particle_data_size();
 	long get_data_list_size(std::uint64_t particle_count);
-	void write_frame_header(std::uint32_t num_data_lists);
-	void write_particle_list_header(std::uint64_t particle_count, int sphereId);
+	void write_frame_header(std::uint32_t num_data_lists, std::vector<char>& buffer);
+	void write_particle_list_header(std::uint64_t particle_count, int sphereId, std::vector<char>& buffer);
 	void write_frame(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp);
 
+	//! @brief contiguous sphere data in memory
+	struct Segment {
+		const char* data;
+		std::uint64_t size;
+	};
+	//! @brief write the local sphere data, given per sphere type, and the frame headers. Collective operation.
+	void write_frame_data(const std::vector<std::vector<Segment>>& segments,
+						  const std::vector<std::uint64_t>& numSpheresPerType);
+
 protected:
 	/** First time step to be recorded */
 	std::uint64_t _startTimestep;
@@ -106,7 +120,8 @@ protected:
 	std::uint64_t _writeFrequency;
 	/** Max time step up to which shall be recorded */
 	std::uint64_t _stopTimestep;
-	long _writeBufferSize;
+	/** Gather the data of the processes of a node, so only one process per node writes */
+	bool _aggregateNodes;
 	std::string _outputPrefix;
 	std::string _timestampString;
 	std::uint32_t _frameCount;
@@ -135,6 +150,10 @@ protected:
 #ifdef ENABLE_MPI
 	MPI_File _mpifh;
 	MPI_Info_object _mpiinfo;
+	/** processes of the same node, only used with node aggregation */
+	MPI_Comm _nodeComm = MPI_COMM_NULL;
+	/** processes accessing the file: all, or the first of every node with node aggregation */
+	MPI_Comm _ioComm = MPI_COMM_NULL;
 #endif
 };
 
@@ -151,7 +170,6 @@ public:
 	virtual ~MmpldWriterSimpleSphere() {}
 
 	virtual void SetNumSphereTypes() {_numSphereTypes = _numComponents;}
-	virtual void CalcNumSpheresPerType(ParticleContainer* particleContainer, std::uint64_t* numSpheresPerType);
 	virtual bool GetSpherePos(float *spherePos, Molecule* mol, std::uint8_t& nSphereTypeIndex);
 };
 
@@ -168,7 +186,6 @@ public:
 	virtual ~MmpldWriterMultiSphere() {}
 
 	virtual void SetNumSphereTypes() {_numSphereTypes = _numSitesTotal;}
-	virtual void CalcNumSpheresPerType(ParticleContainer* particleContainer, std::uint64_t* numSpheresPerType);
 	virtual bool GetSpherePos(float *spherePos, Molecule* mol, std::uint8_t& nSphereTypeIndex);
 };
 
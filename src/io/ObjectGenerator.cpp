@@ -1,5 +1,6 @@
 #include "io/ObjectGenerator.h"
 
+#include <algorithm>
 #include <limits>
 #include <chrono>
 #include <sstream>
@@ -8,6 +9,7 @@
 #include "ensemble/EnsembleBase.h"
 #include "molecules/Molecule.h"
 #include "molecules/MoleculeIdPool.h"
+#include "particleContainer/ParticleContainer.h"
 #include "parallel/DomainDecompBase.h"
 #include "utils/generator/ObjectFillerBase.h"
 #include "utils/generator/ObjectFillerFactory.h"
@@ -63,7 +65,7 @@ void ObjectGenerator::readXML(XMLfileUnits& xmlconfig) {
 		xmlconfig.getNodeValue("@type", velocityAssignerName);
 		Log::global_log->info() << "Velocity assigner: " << velocityAssignerName << std::endl;
 
-		const long seed = [&]() -> long {
+		_seed = [&]() -> long {
 			bool enableRandomSeed = false;
 			xmlconfig.getNodeValue("@enableRandomSeed", enableRandomSeed);
 			if(enableRandomSeed) {
@@ -78,11 +80,11 @@ void ObjectGenerator::readXML(XMLfileUnits& xmlconfig) {
 				return 0;
 			}
 		}();
-		Log::global_log->info() << "Seed for velocity assigner: " << seed << std::endl;
+		Log::global_log->info() << "Seed for velocity assigner and filler: " << _seed << std::endl;
 		if(velocityAssignerName == "EqualVelocityDistribution") {
-			_velocityAssigner = std::make_shared<EqualVelocityAssigner>(0, seed);
+			_velocityAssigner = std::make_shared<EqualVelocityAssigner>(0, _seed);
 		} else if(velocityAssignerName == "MaxwellVelocityDistribution") {
-			_velocityAssigner = std::make_shared<MaxwellVelocityAssigner>(0, seed);
+			_velocityAssigner = std::make_shared<MaxwellVelocityAssigner>(0, _seed);
 		} else {
 			std::ostringstream error_message;
 			error_message << "Unknown velocity assigner specified." << std::endl;
@@ -131,21 +133,33 @@ ObjectGenerator::readPhaseSpace(ParticleContainer* particleContainer, Domain* do
 	std::shared_ptr<Object> bBox = std::make_shared<BoundingBox>(bBoxMin, bBoxMax);
 	std::shared_ptr<Object> boundedObject = std::make_shared<ObjectIntersection>(bBox, _object);
 	_filler->setObject(boundedObject);
+	_filler->setSeed(_seed);
 	_filler->init();
 
-	Molecule molecule;
-	unsigned long moleculeID = _moleculeIdPool->getNewMoleculeId();
-	while(_filler->getMolecule(&molecule) > 0) {
-		molecule.setid(moleculeID);
-		if(_velocityAssigner) {
-			_velocityAssigner->assignVelocity(&molecule);
-		}
-		// only add particle if it is inside of the own domain!
-		if(particleContainer->isInBoundingBox(molecule.r_arr().data())) {
-			particleContainer->addParticle(molecule, true, false);
-			numMolecules++;
-			moleculeID = _moleculeIdPool->getNewMoleculeId();
+	std::vector<Molecule> molecules;
+	while(_filler->getMolecules(molecules, _batchSize) > 0) {
+		// only add particles which are inside of the own domain!
+		molecules.erase(std::remove_if(molecules.begin(), molecules.end(), [particleContainer](Molecule& molecule) {
+			return not particleContainer->isInBoundingBox(molecule.r_arr().data());
+		}), molecules.end());
+
+		const long numBatch = molecules.size();
+		const unsigned long firstID = _moleculeIdPool->getNewMoleculeIds(numBatch);
+		const VelocityAssignerBase* velocityAssigner = _velocityAssigner.get();
+		#if defined(_OPENMP)
+		#pragma omp parallel for schedule(static)
+		#endif
+		for(long i = 0; i < numBatch; i++) {
+			const unsigned long moleculeID = firstID + i;
+			molecules[i].setid(moleculeID);
+			if(velocityAssigner) {
+				velocityAssigner->assignVelocity(&molecules[i], moleculeID);
+			}
 		}
+
+		particleContainer->addParticles(molecules);
+		numMolecules += numBatch;
+		molecules.clear();
 	}
 	return numMolecules;
 }
@@ -18,10 +18,14 @@ class MoleculeIdPool;
  * The idea of the ObjectGenerator is to create a composite 3D volumetric Object and fill this with molecules.
  * The molecule placement into the object is performed by a Filler. The assignment of molecule velocities is
  * performed by a VelocityAssigner. The molecule IDs are provided by a MoleculeIdPool.
+ *
+ * Molecules are requested from the filler in batches, get consecutive IDs and velocities from a
+ * counter-based random number generator keyed by the ID (in parallel), and are inserted into the
+ * particle container batch-wise.
  */
 class ObjectGenerator : public InputBase {
 public:
-	ObjectGenerator() : _filler(nullptr), _object(nullptr), _velocityAssigner(nullptr), _moleculeIdPool(nullptr) {};
+	ObjectGenerator() : _filler(nullptr), _object(nullptr), _velocityAssigner(nullptr), _moleculeIdPool(nullptr), _seed(0) {};
 
 	/** @brief Read in XML configuration for ObjectGenerator and all its included objects.
 	 *
@@ -31,9 +35,10 @@ public:
 	   <objectgenerator>
 	     <filler type="STRING"> <!-- see Filler documentation --> </filler>
 	     <object type="STRING"> <!-- see Object documentation --> </object>
-	     <velocityAssigner type="STRING"> <!-- see VelocityAssignerBase documentation --> </velocityAssigner>
+	     <velocityAssigner type="STRING" enableRandomSeed="BOOL"> <!-- see VelocityAssignerBase documentation --> </velocityAssigner>
 	   </objectgenerator>
 	   \endcode
+	 * The seed, 0 unless enableRandomSeed is set, is used by the velocity assigner and the filler.
 	 */
 	virtual void readXML(XMLfileUnits& xmlconfig);
 
@@ -54,6 +59,10 @@ private:
 	std::shared_ptr<Object> _object;
 	std::shared_ptr<VelocityAssignerBase> _velocityAssigner;
 	std::shared_ptr<MoleculeIdPool> _moleculeIdPool;
+	long _seed;  //!< seed of the random numbers of the velocity assigner and the filler
+
+	//! number of molecules requested from the filler and inserted into the container at once
+	static constexpr unsigned long _batchSize = 1ul << 18;
 };
 
 #endif  // SRC_IO_OBJECTGENERATOR_H_
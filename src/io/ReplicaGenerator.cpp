@@ -3,6 +3,7 @@
 /* the following macro has to be defined to use math constants in cmath */
 #define _USE_MATH_DEFINES  1
 
+#include <algorithm>
 #include <cmath>
 #include <vector>
 #include <cstdint>
@@ -14,11 +15,6 @@
 
 #include "parallel/DomainDecompBase.h"
 
-#ifdef ENABLE_MPI
-#include "parallel/ParticleData.h"
-#include "parallel/DomainDecomposition.h"
-#endif
-
 #include "ensemble/EnsembleBase.h"
 #include "molecules/Molecule.h"
 #include "particleContainer/ParticleContainer.h"
@@ -39,7 +35,6 @@ ReplicaGenerator::ReplicaGenerator()
 		_nIndexLiqBeginY(0),
 		_nIndexLiqEndY(0),
 		_nMoleculeFormat(ICRVQD),
-		_moleculeDataReader(nullptr),
 		_dMoleculeDiameter(0.),
 		_fspY{0., 0., 0., 0., 0., 0.},
 		_nSystemType(ST_UNKNOWN) {
@@ -100,82 +95,82 @@ void ReplicaGenerator::readReplicaPhaseSpaceHeader(SubDomain& subDomain) {
 	}
 }
 
-void ReplicaGenerator::readReplicaPhaseSpaceData(SubDomain& subDomain, DomainDecompBase* domainDecomp) {
-#ifdef ENABLE_MPI
-	if(domainDecomp->getRank() == 0) {
-#endif
-	subDomain.strFilePathData = string_utils::trim(subDomain.strFilePathData);
-	Log::global_log->info() << "Opening phase space file " << subDomain.strFilePathData << std::endl;
-	std::ifstream ifs;
-	ifs.open(subDomain.strFilePathData.c_str(), std::ios::binary | std::ios::in);
-	if(!ifs.is_open()) {
-		std::ostringstream error_message;
-		error_message << "Could not open phaseSpaceFile " << subDomain.strFilePathData << std::endl;
-		MARDYN_EXIT(error_message.str());
-	}
-
-	Log::global_log->info() << "Reading phase space file " << subDomain.strFilePathData << std::endl;
+namespace {
 
-	std::vector<Component>& components = *(_simulation.getEnsemble()->getComponents());
-
-	// Select appropriate reader
-	switch (_nMoleculeFormat) {
+/** Decoder of the binary records of the molecule format */
+std::unique_ptr<MoleculeDataReader> createMoleculeDataReader(uint32_t format) {
+	switch (format) {
 		case ICRVQD:
-			_moleculeDataReader = std::make_unique<MoleculeDataReaderICRVQD>();
-			break;
+			return std::make_unique<MoleculeDataReaderICRVQD>();
 		case ICRV:
-			_moleculeDataReader = std::make_unique<MoleculeDataReaderICRV>();
-			break;
+			return std::make_unique<MoleculeDataReaderICRV>();
 		case IRV:
-			_moleculeDataReader = std::make_unique<MoleculeDataReaderIRV>();
-			break;
+			return std::make_unique<MoleculeDataReaderIRV>();
 	}
+	std::ostringstream error_message;
+	error_message << "Unknown molecule format " << format << std::endl;
+	MARDYN_EXIT(error_message.str());
+	return nullptr;
+}
 
-	for(uint64_t pi = 0; pi < subDomain.numParticles; pi++) {
-		Molecule mol;
-		_moleculeDataReader->read(ifs, mol, components);
-		subDomain.vecParticles.push_back(mol);
+/** Decode the binary records of a replica in parallel */
+void decodeMolecules(const std::vector<char>& buffer, const MoleculeDataReader& reader, uint64_t numParticles,
+					 std::vector<Component>& components, std::vector<Molecule>& molecules) {
+	const size_t size = reader.recordSize();
+	molecules.resize(numParticles);
+
+	#if defined(_OPENMP)
+	#pragma omp parallel for schedule(static)
+	#endif
+	for (int64_t pi = 0; pi < static_cast<int64_t>(numParticles); ++pi) {
+		reader.decode(buffer.data() + pi * size, molecules[pi], components);
 	}
-#ifdef ENABLE_MPI
-	}
-#endif
+}
 
-	/* distribute molecules to other MPI processes */
+}  // namespace
+
+void ReplicaGenerator::readReplicaPhaseSpaceData(SubDomain& subDomain, DomainDecompBase* domainDecomp) {
+	subDomain.strFilePathData = string_utils::trim(subDomain.strFilePathData);
+	const std::unique_ptr<MoleculeDataReader> reader = createMoleculeDataReader(_nMoleculeFormat);
+	const uint64_t numBytes = subDomain.numParticles * reader->recordSize();
+	std::vector<char> buffer(numBytes);
+
+	// The replica is read by one process per node and shared with the other processes of the node.
+	int readerRank = 0;
 #ifdef ENABLE_MPI
-	unsigned long num_particles = subDomain.vecParticles.size();
-	MPI_CHECK( MPI_Bcast(&num_particles, 1, MPI_UNSIGNED_LONG, 0, domainDecomp->getCommunicator()) );
-
-#define PARTICLE_BUFFER_SIZE  (16*1024)
-	ParticleData particle_buff[PARTICLE_BUFFER_SIZE];
-	int particle_buff_pos = 0;
-	MPI_Datatype mpi_Particle;
-	ParticleData::getMPIType(mpi_Particle);
-
-	if(domainDecomp->getRank() == 0) {
-		for(unsigned long i = 0; i < num_particles; ++i) {
-			ParticleData::MoleculeToParticleData(particle_buff[particle_buff_pos], subDomain.vecParticles[i]);
-			particle_buff_pos++;
-			if ((particle_buff_pos >= PARTICLE_BUFFER_SIZE) || (i == num_particles - 1)) {
-				Log::global_log->debug() << "broadcasting(sending) particles" << std::endl;
-				MPI_Bcast(particle_buff, PARTICLE_BUFFER_SIZE, mpi_Particle, 0, domainDecomp->getCommunicator());
-				particle_buff_pos = 0;
-			}
+	MPI_Comm nodeComm;
+	MPI_CHECK( MPI_Comm_split_type(domainDecomp->getCommunicator(), MPI_COMM_TYPE_SHARED, domainDecomp->getRank(),
+								   MPI_INFO_NULL, &nodeComm) );
+	MPI_CHECK( MPI_Comm_rank(nodeComm, &readerRank) );
+#endif
+	if(readerRank == 0) {
+		Log::global_log->info() << "Reading phase space file " << subDomain.strFilePathData << std::endl;
+		std::ifstream ifs(subDomain.strFilePathData.c_str(), std::ios::binary | std::ios::in);
+		if(!ifs.is_open()) {
+			std::ostringstream error_message;
+			error_message << "Could not open phaseSpaceFile " << subDomain.strFilePathData << std::endl;
+			MARDYN_EXIT(error_message.str());
 		}
-	} else {
-		for(unsigned long i = 0; i < num_particles; ++i) {
-			if(i % PARTICLE_BUFFER_SIZE == 0) {
-				Log::global_log->debug() << "broadcasting(receiving) particles" << std::endl;
-				MPI_Bcast(particle_buff, PARTICLE_BUFFER_SIZE, mpi_Particle, 0, domainDecomp->getCommunicator());
-				particle_buff_pos = 0;
-			}
-			Molecule m;
-			ParticleData::ParticleDataToMolecule(particle_buff[particle_buff_pos], m);
-			particle_buff_pos++;
-			subDomain.vecParticles.push_back(m);
+		ifs.read(buffer.data(), numBytes);
+		if(static_cast<uint64_t>(ifs.gcount()) != numBytes) {
+			std::ostringstream error_message;
+			error_message << "Phase space file " << subDomain.strFilePathData << " contains less than "
+						  << subDomain.numParticles << " molecules." << std::endl;
+			MARDYN_EXIT(error_message.str());
 		}
 	}
-	Log::global_log->debug() << "broadcasting(sending/receiving) particles complete" << std::endl;
+#ifdef ENABLE_MPI
+	// broadcast in chunks, as MPI counts are limited to int
+	const uint64_t chunkSize = 1ul << 30;
+	for(uint64_t offset = 0; offset < numBytes; offset += chunkSize) {
+		const int count = std::min(chunkSize, numBytes - offset);
+		MPI_CHECK( MPI_Bcast(buffer.data() + offset, count, MPI_CHAR, 0, nodeComm) );
+	}
+	MPI_CHECK( MPI_Comm_free(&nodeComm) );
 #endif
+
+	std::vector<Component>& components = *(_simulation.getEnsemble()->getComponents());
+	decodeMolecules(buffer, *reader, subDomain.numParticles, components, subDomain.vecParticles);
 	Log::global_log->info() << "Reading Molecules done" << std::endl;
 }
 
@@ -446,70 +441,93 @@ ReplicaGenerator::readPhaseSpace(ParticleContainer* particleContainer, Domain* d
 	// set componnet
 	std::vector<Component>* ptrComponents = global_simulation->getEnsemble()->getComponents();
 
-	uint64_t bi[3];  // block index
+	// only the blocks intersecting the own subdomain are replicated, in parallel
+	std::vector<std::array<uint64_t, 3>> blocks;
+	std::array<uint64_t, 3> bi;  // block index
 	for(bi[0] = startIndex[0]; bi[0] < startIndex[0] + numBlocks[0]; ++bi[0]) {
 		for(bi[2] = startIndex[2]; bi[2] < startIndex[2] + numBlocks[2]; ++bi[2]) {
 			for(bi[1] = startIndex[1]; bi[1] < startIndex[1] + numBlocks[1]; ++bi[1]) {
-				// shift particle position
-				double dShift[3];
-				for(uint8_t di = 0; di < 3; ++di)
-					dShift[di] = bi[di] * bl.at(di);
-
-				std::vector<Molecule>* ptrVec;
-				std::vector<uint32_t>* ptrChangeVec;
-				if(_nSystemType != ST_HOMOGENEOUS && bi[1] >= _nIndexLiqBeginY && bi[1] <= _nIndexLiqEndY) {
-					ptrVec = vecParticlesLiq;
-					ptrChangeVec = &_vecChangeCompIDsLiq;
-				} else {
-					ptrVec = vecParticlesVap;
-					ptrChangeVec = &_vecChangeCompIDsVap;
-				}
-
-				for(auto&& mi : *ptrVec) {
-					Molecule mol = mi;
-					double r[3];
-					for(uint8_t di = 0; di < 3; ++di) {
-						r[di] = mol.r(di) + dShift[di];
-						mol.setr(di, r[di]);
-					}
-
-					// Add particle to container
-					double ry = r[1];
-					bool bIsInsideFreespace = false;
-					if(_nSystemType != ST_HOMOGENEOUS)
-						bIsInsideFreespace = (ry > _fspY[0] && ry < _fspY[1]) || (ry > _fspY[2] && ry < _fspY[3]) ||
-											 (ry > _fspY[4] && ry < _fspY[5]);
-
-					if(particleContainer->isInBoundingBox(r)) {
-						if(not bIsInsideFreespace) {
-							// set component
-							uint32_t cid = mol.componentid();
-							Component* comp = &ptrComponents->at(ptrChangeVec->at(cid));
-							mol.setComponent(comp);
-							mol.setid(numAddedParticlesLocal);
-							// inbox check already performed a few lines earlier.
-							bool added = particleContainer->addParticle(mol, true, false);
-							mardyn_assert(added);
-							numAddedParticlesLocal++;
-						} else {
-							numAddedParticlesFreespaceLocal++;
-						}
-					}
-				}
+				blocks.push_back(bi);
+			}
+		}
+	}
+	const int numBlockJobs = blocks.size();
+	std::vector<std::vector<Molecule>> blockParticles(numBlockJobs);
+
+	#if defined(_OPENMP)
+	#pragma omp parallel for schedule(dynamic) reduction(+:numAddedParticlesFreespaceLocal)
+	#endif
+	for(int job = 0; job < numBlockJobs; ++job) {
+		const std::array<uint64_t, 3>& block = blocks[job];
+		// shift particle position
+		double dShift[3];
+		for(uint8_t di = 0; di < 3; ++di)
+			dShift[di] = block[di] * bl.at(di);
+
+		std::vector<Molecule>* ptrVec;
+		std::vector<uint32_t>* ptrChangeVec;
+		if(_nSystemType != ST_HOMOGENEOUS && block[1] >= _nIndexLiqBeginY && block[1] <= _nIndexLiqEndY) {
+			ptrVec = vecParticlesLiq;
+			ptrChangeVec = &_vecChangeCompIDsLiq;
+		} else {
+			ptrVec = vecParticlesVap;
+			ptrChangeVec = &_vecChangeCompIDsVap;
+		}
+
+		std::vector<Molecule>& added = blockParticles[job];
+		for(auto&& mi : *ptrVec) {
+			double r[3];
+			for(uint8_t di = 0; di < 3; ++di) {
+				r[di] = mi.r(di) + dShift[di];
+			}
+			if(not particleContainer->isInBoundingBox(r)) {
+				continue;
 			}
+
+			// Add particle to container
+			double ry = r[1];
+			bool bIsInsideFreespace = false;
+			if(_nSystemType != ST_HOMOGENEOUS)
+				bIsInsideFreespace = (ry > _fspY[0] && ry < _fspY[1]) || (ry > _fspY[2] && ry < _fspY[3]) ||
+									 (ry > _fspY[4] && ry < _fspY[5]);
+
+			if(bIsInsideFreespace) {
+				numAddedParticlesFreespaceLocal++;
+				continue;
+			}
+			added.push_back(mi);
+			Molecule& mol = added.back();
+			for(uint8_t di = 0; di < 3; ++di) {
+				mol.setr(di, r[di]);
+			}
+			// set component
+			uint32_t cid = mol.componentid();
+			Component* comp = &ptrComponents->at(ptrChangeVec->at(cid));
+			mol.setComponent(comp);
 		}
 	}
 
+	std::vector<Molecule> particles;
+	for(auto& added : blockParticles) {
+		numAddedParticlesLocal += added.size();
+	}
+	particles.reserve(numAddedParticlesLocal);
+	for(auto& added : blockParticles) {
+		particles.insert(particles.end(), added.begin(), added.end());
+		std::vector<Molecule>().swap(added);
+	}
 
+	// unique ID's: consecutive numbering across all processes
 	domainDecomp->collCommInit(1);
 	domainDecomp->collCommAppendUnsLong(numAddedParticlesLocal);//number of local molecules
 	domainDecomp->collCommScanSum();
 	unsigned long idOffset = domainDecomp->collCommGetUnsLong() - numAddedParticlesLocal;
 	domainDecomp->collCommFinalize();
-	// fix ID's to be unique:
-	for (auto mol = particleContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); mol.isValid(); ++mol) {
-		mol->setid(mol->getID() + idOffset);
+	for(uint64_t i = 0; i < numAddedParticlesLocal; ++i) {
+		particles[i].setid(idOffset + i);
 	}
+	// inbox check already performed during the replication.
+	particleContainer->addParticles(particles);
 
 
 	// update global number of particles, perform number checks
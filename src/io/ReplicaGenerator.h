@@ -9,6 +9,7 @@
 #include <string>
 #include <iostream>
 #include <cstdint>
+#include <cstring>
 #include <memory>
 
 
@@ -62,6 +63,8 @@ private:
 
 	void readReplicaPhaseSpaceHeader(SubDomain& subDomain);
 
+	/** Read the binary replica data in one piece (one process per node, shared with the other processes of the node)
+	 * and decode it into subDomain.vecParticles. */
 	void readReplicaPhaseSpaceData(SubDomain& subDomain, DomainDecompBase* domainDecomp);
 
 private:
@@ -73,7 +76,6 @@ private:
 	uint32_t _nIndexLiqBeginY;
 	uint32_t _nIndexLiqEndY;
 	uint32_t _nMoleculeFormat;
-	std::unique_ptr<MoleculeDataReader> _moleculeDataReader;
 	double _dMoleculeDiameter;
 	double _fspY[6];  // free space positions
 	uint8_t _nSystemType;
@@ -81,116 +83,74 @@ private:
 	std::vector<uint32_t> _vecChangeCompIDsLiq;
 };
 
+/** @brief Decoder of the binary molecule records of replica and MettDeamon phase space files.
+ *
+ * Formats without orientation (ICRV, IRV) get the identity orientation q0=1, q1=q2=q3=0, as in BinaryReader,
+ * and no angular momentum. IRV molecules belong to the first component.
+ */
 class MoleculeDataReader {
 protected:
-	MoleculeDataReader() {}
+	MoleculeDataReader(bool hasComponent, bool hasOrientation)
+		: _hasComponent(hasComponent), _hasOrientation(hasOrientation) {}
 
 public:
 	virtual ~MoleculeDataReader() {};
 
-	virtual void read(std::ifstream& ifs, Molecule& mol, std::vector<Component>& components) = 0;
-};
-
-class MoleculeDataReaderICRVQD : public MoleculeDataReader {
-public:
-	MoleculeDataReaderICRVQD() {}
-
-public:
-	virtual ~MoleculeDataReaderICRVQD() {};
+	//! size of one record in bytes
+	size_t recordSize() const {
+		return 8 + (_hasComponent ? 4 : 0) + (_hasOrientation ? 13 : 6) * 8;
+	}
 
-	virtual void read(std::ifstream& ifs, Molecule& mol, std::vector<Component>& components) {
-		double rx, ry, rz, vx, vy, vz, q0, q1, q2, q3, Dx, Dy, Dz;
-		rx = ry = rz = vx = vy = vz = q0 = q1 = q2 = q3 = Dx = Dy = Dz = 0.;
+	//! decode the record starting at record
+	void decode(const char* record, Molecule& mol, std::vector<Component>& components) const {
 		uint64_t id = 0;
-		uint32_t cid = 0;
-
-		ifs.read(reinterpret_cast<char*> (&id), 8);
-		ifs.read(reinterpret_cast<char*> (&cid), 4);
-		ifs.read(reinterpret_cast<char*> (&rx), 8);
-		ifs.read(reinterpret_cast<char*> (&ry), 8);
-		ifs.read(reinterpret_cast<char*> (&rz), 8);
-		ifs.read(reinterpret_cast<char*> (&vx), 8);
-		ifs.read(reinterpret_cast<char*> (&vy), 8);
-		ifs.read(reinterpret_cast<char*> (&vz), 8);
-		ifs.read(reinterpret_cast<char*> (&q0), 8);
-		ifs.read(reinterpret_cast<char*> (&q1), 8);
-		ifs.read(reinterpret_cast<char*> (&q2), 8);
-		ifs.read(reinterpret_cast<char*> (&q3), 8);
-		ifs.read(reinterpret_cast<char*> (&Dx), 8);
-		ifs.read(reinterpret_cast<char*> (&Dy), 8);
-		ifs.read(reinterpret_cast<char*> (&Dz), 8);
+		uint32_t cid = 1;
+		// rx, ry, rz, vx, vy, vz, q0, q1, q2, q3, Dx, Dy, Dz
+		double values[13] = {0., 0., 0., 0., 0., 0., 1., 0., 0., 0., 0., 0., 0.};
+		std::memcpy(&id, record, 8);
+		record += 8;
+		if (_hasComponent) {
+			std::memcpy(&cid, record, 4);
+			record += 4;
+		}
+		std::memcpy(values, record, (_hasOrientation ? 13 : 6) * 8);
 
 		Component* component = &components.at(cid - 1);
-		Molecule tmp(id, component,
-					 rx, ry, rz,
-					 vx, vy, vz,
-					 q0, q1, q2, q3,
-					 Dx, Dy, Dz);
-		mol = tmp;
+		mol = Molecule(id, component,
+					   values[0], values[1], values[2],
+					   values[3], values[4], values[5],
+					   values[6], values[7], values[8], values[9],
+					   values[10], values[11], values[12]);
+	}
+
+	//! read the next record from the stream
+	void read(std::ifstream& ifs, Molecule& mol, std::vector<Component>& components) {
+		char record[8 + 4 + 13 * 8];
+		ifs.read(record, recordSize());
+		decode(record, mol, components);
 	}
+
+private:
+	bool _hasComponent;
+	bool _hasOrientation;
 };
 
-class MoleculeDataReaderICRV : public MoleculeDataReader {
+//! id, component id, position, velocity, orientation, angular momentum
+class MoleculeDataReaderICRVQD : public MoleculeDataReader {
 public:
-	MoleculeDataReaderICRV() {}
+	MoleculeDataReaderICRVQD() : MoleculeDataReader(true, true) {}
+};
 
+//! id, component id, position, velocity
+class MoleculeDataReaderICRV : public MoleculeDataReader {
 public:
-	virtual ~MoleculeDataReaderICRV() {};
-
-	virtual void read(std::ifstream& ifs, Molecule& mol, std::vector<Component>& components) {
-		double rx, ry, rz, vx, vy, vz, q0, q1, q2, q3, Dx, Dy, Dz;
-		rx = ry = rz = vx = vy = vz = q0 = q1 = q2 = q3 = Dx = Dy = Dz = 0.;
-		uint64_t id = 0;
-		uint32_t cid = 0;
-
-		ifs.read(reinterpret_cast<char*> (&id), 8);
-		ifs.read(reinterpret_cast<char*> (&cid), 4);
-		ifs.read(reinterpret_cast<char*> (&rx), 8);
-		ifs.read(reinterpret_cast<char*> (&ry), 8);
-		ifs.read(reinterpret_cast<char*> (&rz), 8);
-		ifs.read(reinterpret_cast<char*> (&vx), 8);
-		ifs.read(reinterpret_cast<char*> (&vy), 8);
-		ifs.read(reinterpret_cast<char*> (&vz), 8);
-
-		Component* component = &components.at(cid - 1);
-		Molecule tmp(id, component,
-					 rx, ry, rz,
-					 vx, vy, vz,
-					 q0, q1, q2, q3,
-					 Dx, Dy, Dz);
-		mol = tmp;
-	}
+	MoleculeDataReaderICRV() : MoleculeDataReader(true, false) {}
 };
 
+//! id, position, velocity
 class MoleculeDataReaderIRV : public MoleculeDataReader {
 public:
-	MoleculeDataReaderIRV() {}
-
-public:
-	virtual ~MoleculeDataReaderIRV() {};
-
-	virtual void read(std::ifstream& ifs, Molecule& mol, std::vector<Component>& components) {
-		double rx, ry, rz, vx, vy, vz, q0, q1, q2, q3, Dx, Dy, Dz;
-		rx = ry = rz = vx = vy = vz = q0 = q1 = q2 = q3 = Dx = Dy = Dz = 0.;
-		uint64_t id = 0;
-		uint32_t cid = 0;
-
-		ifs.read(reinterpret_cast<char*> (&id), 8);
-		ifs.read(reinterpret_cast<char*> (&rx), 8);
-		ifs.read(reinterpret_cast<char*> (&ry), 8);
-		ifs.read(reinterpret_cast<char*> (&rz), 8);
-		ifs.read(reinterpret_cast<char*> (&vx), 8);
-		ifs.read(reinterpret_cast<char*> (&vy), 8);
-		ifs.read(reinterpret_cast<char*> (&vz), 8);
-
-		Component* component = &components.at(0);
-		Molecule tmp(id, component,
-					 rx, ry, rz,
-					 vx, vy, vz,
-					 q0, q1, q2, q3,
-					 Dx, Dy, Dz);
-		mol = tmp;
-	}
+	MoleculeDataReaderIRV() : MoleculeDataReader(false, false) {}
 };
 
 #endif /* REPLICA_GENERATOR_H */
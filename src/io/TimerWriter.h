@@ -48,6 +48,8 @@ public:
 		/* nothing to do */
 	}
 
+	bool requiresMacroscopicValues(unsigned long) override { return false; }
+
 	std::string getPluginName() override { return std::string("TimerWriter"); }
 	static PluginBase *createInstance() { return new TimerWriter(); }
 
@@ -5,7 +5,8 @@
  * @Author: eckhardw
  */
 
-#include "io/vtk/VTKMoleculeWriter.h"
+#include "io/VTKMoleculeWriter.h"
+#include "io/VTKMoleculeWriterAppended.h"
 #include "particleContainer/ParticleContainer.h"
 #include "parallel/DomainDecompBase.h"
 #include "utils/Logger.h"
@@ -34,6 +35,24 @@ void VTKMoleculeWriter::readXML(XMLfileUnits& xmlconfig) {
 	}
 	xmlconfig.getNodeValue("outputprefix", _fileName);
 	Log::global_log->info() << "VTKMoleculeWriter: Output prefix: " << _fileName << std::endl;
+	std::string format = _appendedFormat ? "appended" : "ascii";
+	xmlconfig.getNodeValue("format", format);
+	if (format == "appended") {
+		_appendedFormat = true;
+	} else if (format == "ascii") {
+#ifdef VTK
+		_appendedFormat = false;
+#else
+		std::ostringstream error_message;
+		error_message << "VTKMoleculeWriter: Format ascii requires compiling with VTK=1, use appended!" << std::endl;
+		MARDYN_EXIT(error_message.str());
+#endif
+	} else {
+		std::ostringstream error_message;
+		error_message << "VTKMoleculeWriter: Unknown format " << format << ", expected ascii or appended!" << std::endl;
+		MARDYN_EXIT(error_message.str());
+	}
+	Log::global_log->info() << "VTKMoleculeWriter: Format: " << format << std::endl;
 
 	if (_writeFrequency <= 0) {
 		std::ostringstream error_message;
@@ -56,6 +75,24 @@ void VTKMoleculeWriter::endStep(
 
 	int rank = domainDecomp->getRank();
 
+	if (_appendedFormat) {
+		VTKMoleculeWriterAppended writer(rank, true);
+		for (auto tmpMolecule = particleContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY);
+			 tmpMolecule.isValid(); ++tmpMolecule) {
+			writer.plotMolecule(*tmpMolecule);
+		}
+		std::stringstream fileNameStream;
+		fileNameStream << _fileName << "_" << simstep << ".vtu";
+#ifdef ENABLE_MPI
+		writer.writeVTKFile(fileNameStream.str(), domainDecomp->getCommunicator());
+#else
+		writer.writeVTKFile(fileNameStream.str());
+#endif
+		return;
+	}
+
+#ifdef VTK
+
 	VTKMoleculeWriterImplementation impl(rank, true);
 
 	impl.initializeVTKFile();
@@ -79,9 +116,11 @@ void VTKMoleculeWriter::endStep(
 #endif
 	fileNameStream << "_" << simstep << ".vtu";
 	impl.writeVTKFile(fileNameStream.str());
+#endif
 }
 
 
+#ifdef VTK
 void VTKMoleculeWriter::outputParallelVTKFile(unsigned int numProcs, unsigned long simstep,
 		VTKMoleculeWriterImplementation& impl) {
 
@@ -102,6 +141,7 @@ void VTKMoleculeWriter::outputParallelVTKFile(unsigned int numProcs, unsigned lo
 	impl.initializeParallelVTKFile(procFileNames);
 	impl.writeParallelVTKFile(fileNameStream.str());
 }
+#endif
 
 
 //! NOP
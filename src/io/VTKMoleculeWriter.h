@@ -11,7 +11,9 @@
 #include <utility>
 
 #include "plugins/PluginBase.h"
+#ifdef VTK
 #include "io/vtk/VTKMoleculeWriterImplementation.h"
+#endif
 
 /**
  * This class is an implementation of the OutputBase for the VTK file format.
@@ -42,6 +44,17 @@ private:
 
 	std::string _fileName{};
 
+	/**
+	 * Whether all processes write into a single file per output step, with the data as raw binary blocks appended to
+	 * the xml (see VTKMoleculeWriterAppended). Otherwise, every process writes its own ascii file and the root process
+	 * a .pvtu file referencing them, which requires compiling with VTK=1.
+	 */
+#ifdef VTK
+	bool _appendedFormat{false};
+#else
+	bool _appendedFormat{true};
+#endif
+
 public:
 	VTKMoleculeWriter() = default;
 
@@ -69,11 +82,26 @@ public:
 	}
 	static PluginBase* createInstance() { return new VTKMoleculeWriter(); }
 
+	/** @brief Read in XML configuration for VTKMoleculeWriter.
+	 *
+	 * The following xml object structure is handled by this method:
+	 * \code{.xml}
+	   <outputplugin name="VTKMoleculeWriter">
+		 <outputprefix>STRING</outputprefix>
+		 <writefrequency>INTEGER</writefrequency>
+		 <writefrequencyOffset>INTEGER</writefrequencyOffset>
+		 <writeInitialState>BOOL</writeInitialState>  <!-- only read if the offset is not 0 -->
+		 <format>ascii|appended</format>  <!-- appended: one file per step for all processes, binary data (default: ascii, appended without VTK) -->
+	   </outputplugin>
+	   \endcode
+	 */
 	void readXML(XMLfileUnits& xmlconfig);
 
 private:
+#ifdef VTK
 	void outputParallelVTKFile(unsigned int numProcs, unsigned long simstep,
 			VTKMoleculeWriterImplementation& impl);
+#endif
 
 };
 
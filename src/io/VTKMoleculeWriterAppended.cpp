@@ -0,0 +1,222 @@
+/*
+ * VTKMoleculeWriterAppended.cpp
+ */
+
+#include "io/VTKMoleculeWriterAppended.h"
+#include "molecules/Molecule.h"
+#include "utils/Logger.h"
+#include "utils/mardyn_assert.h"
+
+#include <array>
+#include <climits>
+#include <fstream>
+#include <sstream>
+
+
+VTKMoleculeWriterAppended::VTKMoleculeWriterAppended(int rank, bool plotCenters)
+: _rank(rank), _plotCenters(plotCenters) {
+}
+
+
+void VTKMoleculeWriterAppended::plotMolecule(Molecule& molecule) {
+	if (_plotCenters) {
+		int centerID = 0;
+		for (size_t i = 0; i < molecule.numLJcenters(); i++) {
+			plotCenter(molecule, centerID, LJ);
+			centerID++;
+		}
+		for (size_t i = 0; i < molecule.numCharges(); i++) {
+			plotCenter(molecule, centerID, Charge);
+			centerID++;
+		}
+		for (size_t i = 0; i < molecule.numDipoles(); i++) {
+			plotCenter(molecule, centerID, Dipole);
+			centerID++;
+		}
+		for (size_t i = 0; i < molecule.numQuadrupoles(); i++) {
+			plotCenter(molecule, centerID, Quadrupole);
+			centerID++;
+		}
+	} else {
+		_ids.push_back(molecule.getID());
+		_componentIds.push_back(molecule.componentid());
+		_ranks.push_back(_rank);
+		for (int d = 0; d < 3; d++) {
+			_forces.push_back(molecule.F(d));
+			_points.push_back(molecule.r(d));
+		}
+	}
+}
+
+
+void VTKMoleculeWriterAppended::plotCenter(Molecule& molecule, int centerID, CenterType centerType) {
+	_ids.push_back(molecule.getID());
+	_componentIds.push_back(molecule.componentid());
+	_ranks.push_back(_rank);
+	const std::array<double, 3> center_force = molecule.site_F(centerID);
+	const std::array<double, 3> curr_center = molecule.site_d_abs(centerID);
+	for (int d = 0; d < 3; d++) {
+		_forces.push_back(center_force[d]);
+		_points.push_back(curr_center[d]);
+	}
+	_centerIds.push_back(centerID);
+	_centerTypes.push_back(centerType);
+}
+
+
+std::vector<VTKMoleculeWriterAppended::DataArray> VTKMoleculeWriterAppended::dataArrays() const {
+	// same arrays as written by VTKMoleculeWriterImplementation
+	std::vector<DataArray> arrays = {
+		{"PointData", "id", "UInt64", 1, sizeof(uint64_t), _ids.data()},
+		{"PointData", "component-id", "Int32", 1, sizeof(int32_t), _componentIds.data()},
+		{"PointData", "node-rank", "Int32", 1, sizeof(int32_t), _ranks.data()},
+		{"PointData", "forces", "Float32", 3, 3 * sizeof(float), _forces.data()},
+	};
+	if (_plotCenters) {
+		arrays.push_back({"PointData", "center-id", "Float32", 1, sizeof(float), _centerIds.data()});
+		arrays.push_back({"PointData", "center-type", "UInt8", 1, sizeof(uint8_t), _centerTypes.data()});
+	}
+	arrays.push_back({"Points", "points", "Float32", 3, 3 * sizeof(float), _points.data()});
+	// there are no cells, but readers expect the arrays describing them
+	arrays.push_back({"Cells", "connectivity", "Int64", 1, 0, nullptr});
+	arrays.push_back({"Cells", "offsets", "Int64", 1, 0, nullptr});
+	arrays.push_back({"Cells", "types", "UInt8", 1, 0, nullptr});
+	return arrays;
+}
+
+
+std::string VTKMoleculeWriterAppended::header(uint64_t numberOfPoints, const std::vector<uint64_t>& offsets) const {
+	const uint16_t endianTest = 1;
+	const bool littleEndian = *reinterpret_cast<const uint8_t*>(&endianTest) == 1;
+
+	std::ostringstream xml;
+	xml << "<?xml version=\"1.0\"?>\n";
+	xml << "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\""
+		<< (littleEndian ? "LittleEndian" : "BigEndian") << "\" header_type=\"UInt64\">\n";
+	xml << "  <UnstructuredGrid>\n";
+	xml << "    <Piece NumberOfPoints=\"" << numberOfPoints << "\" NumberOfCells=\"0\">\n";
+	const auto arrays = dataArrays();
+	std::string section;
+	for (size_t a = 0; a < arrays.size(); a++) {
+		if (arrays[a].section != section) {
+			if (not section.empty()) {
+				xml << "      </" << section << ">\n";
+			}
+			section = arrays[a].section;
+			xml << "      <" << section << ">\n";
+		}
+		xml << "        <DataArray type=\"" << arrays[a].type << "\" Name=\"" << arrays[a].name
+			<< "\" NumberOfComponents=\"" << arrays[a].numberOfComponents << "\" format=\"appended\" offset=\""
+			<< offsets[a] << "\"/>\n";
+	}
+	xml << "      </" << section << ">\n";
+	xml << "    </Piece>\n";
+	xml << "  </UnstructuredGrid>\n";
+	xml << "  <AppendedData encoding=\"raw\">\n   _";
+	return xml.str();
+}
+
+
+#ifdef ENABLE_MPI
+void VTKMoleculeWriterAppended::writeVTKFile(const std::string& fileName, MPI_Comm comm) {
+#else
+void VTKMoleculeWriterAppended::writeVTKFile(const std::string& fileName) {
+#endif
+	const uint64_t localNumberOfPoints = _ids.size();
+	uint64_t numberOfPoints = localNumberOfPoints;
+	uint64_t pointOffset = 0;  // number of points of the processes with lower rank
+#ifdef ENABLE_MPI
+	int commRank;
+	MPI_CHECK( MPI_Comm_rank(comm, &commRank) );
+	MPI_CHECK( MPI_Allreduce(&localNumberOfPoints, &numberOfPoints, 1, MPI_UINT64_T, MPI_SUM, comm) );
+	MPI_CHECK( MPI_Exscan(&localNumberOfPoints, &pointOffset, 1, MPI_UINT64_T, MPI_SUM, comm) );
+	if (commRank == 0) {
+		pointOffset = 0;
+	}
+#endif
+
+	// every block of the appended data consists of its size in bytes, followed by the values of all processes
+	const auto arrays = dataArrays();
+	std::vector<uint64_t> blockSizes(arrays.size());
+	std::vector<uint64_t> offsets(arrays.size() + 1, 0);
+	for (size_t a = 0; a < arrays.size(); a++) {
+		blockSizes[a] = numberOfPoints * arrays[a].bytesPerPoint;
+		offsets[a + 1] = offsets[a] + sizeof(uint64_t) + blockSizes[a];
+	}
+	const std::string xmlHeader = header(numberOfPoints, offsets);
+	const std::string xmlFooter = "\n  </AppendedData>\n</VTKFile>\n";
+
+#ifdef ENABLE_MPI
+	// pieces of the file written by this process, in increasing order of their position in the file
+	std::vector<MPI_Aint> fileDisplacements;
+	std::vector<MPI_Aint> memoryAddresses;
+	std::vector<int> lengths;
+	auto addPiece = [&](uint64_t position, const void* data, uint64_t length) {
+		if (length == 0) {
+			return;
+		}
+		if (length > static_cast<uint64_t>(INT_MAX)) {
+			std::ostringstream error_message;
+			error_message << "VTKMoleculeWriterAppended: data array of " << length << " bytes is too large for MPI-IO."
+						  << std::endl;
+			MARDYN_EXIT(error_message.str());
+		}
+		MPI_Aint address;
+		MPI_CHECK( MPI_Get_address(data, &address) );
+		fileDisplacements.push_back(static_cast<MPI_Aint>(position));
+		memoryAddresses.push_back(address);
+		lengths.push_back(static_cast<int>(length));
+	};
+
+	const uint64_t dataBegin = xmlHeader.size();
+	if (commRank == 0) {
+		addPiece(0, xmlHeader.data(), xmlHeader.size());
+	}
+	for (size_t a = 0; a < arrays.size(); a++) {
+		if (commRank == 0) {
+			addPiece(dataBegin + offsets[a], &blockSizes[a], sizeof(uint64_t));
+		}
+		addPiece(dataBegin + offsets[a] + sizeof(uint64_t) + pointOffset * arrays[a].bytesPerPoint, arrays[a].data,
+				 localNumberOfPoints * arrays[a].bytesPerPoint);
+	}
+	const uint64_t fileSize = dataBegin + offsets.back() + xmlFooter.size();
+	if (commRank == 0) {
+		addPiece(dataBegin + offsets.back(), xmlFooter.data(), xmlFooter.size());
+	}
+
+	MPI_Datatype fileType, memoryType;
+	MPI_CHECK( MPI_Type_create_hindexed(lengths.size(), lengths.data(), fileDisplacements.data(), MPI_BYTE, &fileType) );
+	MPI_CHECK( MPI_Type_commit(&fileType) );
+	MPI_CHECK( MPI_Type_create_hindexed(lengths.size(), lengths.data(), memoryAddresses.data(), MPI_BYTE, &memoryType) );
+	MPI_CHECK( MPI_Type_commit(&memoryType) );
+
+	MPI_File fh;
+	MPI_CHECK( MPI_File_open(comm, fileName.c_str(), MPI_MODE_WRONLY | MPI_MODE_CREATE, MPI_INFO_NULL, &fh) );
+	// discard the remainder of an older, larger file
+	MPI_CHECK( MPI_File_set_size(fh, static_cast<MPI_Offset>(fileSize)) );
+	MPI_CHECK( MPI_File_set_view(fh, 0, MPI_BYTE, fileType, "native", MPI_INFO_NULL) );
+	MPI_CHECK( MPI_File_write_all(fh, MPI_BOTTOM, 1, memoryType, MPI_STATUS_IGNORE) );
+	MPI_CHECK( MPI_File_close(&fh) );
+
+	MPI_CHECK( MPI_Type_free(&fileType) );
+	MPI_CHECK( MPI_Type_free(&memoryType) );
+#else
+	std::ofstream file(fileName.c_str(), std::ios::binary);
+	file.write(xmlHeader.data(), xmlHeader.size());
+	for (size_t a = 0; a < arrays.size(); a++) {
+		file.write(reinterpret_cast<const char*>(&blockSizes[a]), sizeof(uint64_t));
+		if (blockSizes[a] > 0) {
+			file.write(static_cast<const char*>(arrays[a].data), blockSizes[a]);
+		}
+	}
+	file.write(xmlFooter.data(), xmlFooter.size());
+	if (not file) {
+		Log::global_log->error() << "VTKMoleculeWriterAppended: could not write " << fileName << std::endl;
+	}
+#endif
+}
+
+
+unsigned long VTKMoleculeWriterAppended::getNumMoleculesPlotted() const {
+	return _ids.size();
+}
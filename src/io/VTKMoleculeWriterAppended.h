@@ -0,0 +1,105 @@
+/*
+ * VTKMoleculeWriterAppended.h
+ */
+
+#ifndef VTKMOLECULEWRITERAPPENDED_H_
+#define VTKMOLECULEWRITERAPPENDED_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "molecules/MoleculeForwardDeclaration.h"
+
+#ifdef ENABLE_MPI
+#include <mpi.h>
+#endif
+
+/**
+ * Writes molecules as the points of a vtk unstructured grid, like VTKMoleculeWriterImplementation, but into a
+ * single .vtu file for all processes with the data arrays stored as raw binary blocks in the appended data section.
+ *
+ * The file does not depend on the serialization classes generated by codesynthesis xsd: the xml header only
+ * contains the global number of points and the offsets of the blocks, so every process can compute it. With MPI, the
+ * processes then write their parts of all blocks with one collective MPI-IO call, in the order of their ranks.
+ * It does not need VTK support, unlike the writers in io/vtk.
+ */
+class VTKMoleculeWriterAppended {
+
+private:
+
+	//! the rank of the process
+	int _rank;
+
+	//! if all centers should be ploted separately
+	bool _plotCenters;
+
+	enum CenterType { Charge = 1, LJ = 2, Dipole = 3, Quadrupole = 4};
+
+	//! point data, one value or vector per plotted molecule or center
+	std::vector<uint64_t> _ids;
+	std::vector<int32_t> _componentIds;
+	std::vector<int32_t> _ranks;
+	std::vector<float> _forces;
+	std::vector<float> _centerIds;
+	std::vector<uint8_t> _centerTypes;
+	std::vector<float> _points;
+
+	//! a data array of the file and the local values
+	struct DataArray {
+		std::string section;
+		std::string name;
+		std::string type;
+		int numberOfComponents;
+		size_t bytesPerPoint;
+		const void* data;
+	};
+
+	std::vector<DataArray> dataArrays() const;
+
+	/**
+	 * the xml part of the file, up to and including the '_' starting the appended data
+	 * @param offsets offsets of the blocks of the data arrays in the appended data
+	 */
+	std::string header(uint64_t numberOfPoints, const std::vector<uint64_t>& offsets) const;
+
+	/**
+	 * plots one single center
+	 */
+	void plotCenter(Molecule& molecule, int centerID, CenterType centerType);
+
+public:
+
+	/**
+	 * @param rank the MPI rank of the process
+	 */
+	VTKMoleculeWriterAppended(int rank, bool plotCenters = false);
+
+	/**
+	 * Plot a molecule.
+	 *
+	 * @param molecule the molecule to plot
+	 */
+	void plotMolecule(Molecule& molecule);
+
+#ifdef ENABLE_MPI
+	/**
+	 * Write the molecules of all processes of comm to one file. Collective operation on comm.
+	 *
+	 * @param fileName the name of the file written
+	 * @param comm the processes writing, usually the communicator of the domain decomposition
+	 */
+	void writeVTKFile(const std::string& fileName, MPI_Comm comm);
+#else
+	/**
+	 * Write the molecules to one file.
+	 *
+	 * @param fileName the name of the file written
+	 */
+	void writeVTKFile(const std::string& fileName);
+#endif
+
+	unsigned long getNumMoleculesPlotted() const;
+};
+
+#endif /* VTKMOLECULEWRITERAPPENDED_H_ */
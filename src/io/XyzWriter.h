@@ -42,6 +42,8 @@ public:
 	void finish(ParticleContainer *particleContainer,
 				DomainDecompBase *domainDecomp, Domain *domain) override;
 
+	bool requiresMacroscopicValues(unsigned long) override { return false; }
+
 	std::string getPluginName() override {
 		return std::string("XyzWriter");
 	}
@@ -0,0 +1,82 @@
+/*
+ * VTKMoleculeWriterAppendedTest.cpp
+ */
+
+#include "VTKMoleculeWriterAppendedTest.h"
+#include "io/VTKMoleculeWriterAppended.h"
+#include "utils/FileUtils.h"
+#include "molecules/Molecule.h"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#ifdef ENABLE_MPI
+#include <mpi.h>
+#endif
+
+TEST_SUITE_REGISTRATION(VTKMoleculeWriterAppendedTest);
+
+VTKMoleculeWriterAppendedTest::VTKMoleculeWriterAppendedTest() {
+}
+
+VTKMoleculeWriterAppendedTest::~VTKMoleculeWriterAppendedTest() {
+}
+
+void VTKMoleculeWriterAppendedTest::testWriteVTKFile() {
+	int rank = 0;
+	int numProcs = 1;
+#ifdef ENABLE_MPI
+	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+	MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
+#endif
+	VTKMoleculeWriterAppended writer(rank);
+
+	std::vector<Component> components;
+	Component dummyComponent(0);
+	dummyComponent.addLJcenter(0,0,0,0,0,0,0,false);
+	components.push_back(dummyComponent);
+
+	Molecule first(2 * rank, &components[0], rank, 1., 2., 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+	Molecule second(2 * rank + 1, &components[0], rank, 3., 4., 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+	writer.plotMolecule(first);
+	writer.plotMolecule(second);
+	ASSERT_EQUAL(writer.getNumMoleculesPlotted(), 2ul);
+
+#ifdef ENABLE_MPI
+	writer.writeVTKFile("VTKMoleculeWriterAppended00.vtu", MPI_COMM_WORLD);
+#else
+	writer.writeVTKFile("VTKMoleculeWriterAppended00.vtu");
+#endif
+	if (rank != 0) {
+		return;
+	}
+	ASSERT_TRUE(fileExists("VTKMoleculeWriterAppended00.vtu"));
+
+	std::ifstream file("VTKMoleculeWriterAppended00.vtu", std::ios::binary);
+	const std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	const std::string numberOfPoints = "NumberOfPoints=\"" + std::to_string(2 * numProcs) + "\"";
+	ASSERT_TRUE(content.find(numberOfPoints) != std::string::npos);
+
+	// the block of the positions: its size, followed by x, y, z of all molecules
+	const size_t pointsOffsetBegin = content.find("offset=\"", content.find("Name=\"points\"")) + 8;
+	const size_t pointsOffset = std::stoul(content.substr(pointsOffsetBegin));
+	const size_t dataBegin = content.find("_", content.find("<AppendedData")) + 1;
+	uint64_t blockSize;
+	std::memcpy(&blockSize, content.data() + dataBegin + pointsOffset, sizeof(blockSize));
+	ASSERT_EQUAL(blockSize, static_cast<uint64_t>(2 * numProcs * 3 * sizeof(float)));
+	std::vector<float> points(2 * numProcs * 3);
+	std::memcpy(points.data(), content.data() + dataBegin + pointsOffset + sizeof(blockSize), blockSize);
+	for (int r = 0; r < numProcs; r++) {
+		ASSERT_DOUBLES_EQUAL(r, points[6 * r + 0], 1e-6);
+		ASSERT_DOUBLES_EQUAL(1., points[6 * r + 1], 1e-6);
+		ASSERT_DOUBLES_EQUAL(2., points[6 * r + 2], 1e-6);
+		ASSERT_DOUBLES_EQUAL(r, points[6 * r + 3], 1e-6);
+		ASSERT_DOUBLES_EQUAL(3., points[6 * r + 4], 1e-6);
+		ASSERT_DOUBLES_EQUAL(4., points[6 * r + 5], 1e-6);
+	}
+	ASSERT_TRUE(content.find("</VTKFile>") != std::string::npos);
+
+	removeFile("VTKMoleculeWriterAppended00.vtu");
+}
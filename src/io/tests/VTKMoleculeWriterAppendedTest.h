@@ -0,0 +1,28 @@
+/*
+ * VTKMoleculeWriterAppendedTest.h
+ */
+
+#ifndef VTKMOLECULEWRITERAPPENDEDTEST_H_
+#define VTKMOLECULEWRITERAPPENDEDTEST_H_
+
+#include "utils/Testing.h"
+
+class VTKMoleculeWriterAppendedTest : public utils::Test {
+
+	TEST_SUITE(VTKMoleculeWriterAppendedTest);
+	TEST_METHOD(testWriteVTKFile);
+	TEST_SUITE_END();
+
+public:
+
+	VTKMoleculeWriterAppendedTest();
+
+	virtual ~VTKMoleculeWriterAppendedTest();
+
+	/**
+	 * Every process plots two molecules, the single file has to contain the positions of all of them, ordered by rank.
+	 */
+	void testWriteVTKFile();
+};
+
+#endif /* VTKMOLECULEWRITERAPPENDEDTEST_H_ */
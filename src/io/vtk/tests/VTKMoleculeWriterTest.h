@@ -10,7 +10,7 @@
 
 #include "utils/Testing.h"
 #include "utils/TestWithSimulationSetup.h"
-#include "io/vtk/VTKMoleculeWriter.h"
+#include "io/VTKMoleculeWriter.h"
 
 //we need global_simulation for RMM mode LinkedCells constructor, as ParticleCell instantiates a Molecule...
 class VTKMoleculeWriterTest : public utils::TestWithSimulationSetup {
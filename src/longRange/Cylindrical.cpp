@@ -0,0 +1,436 @@
+#include "longRange/Cylindrical.h"
+
+#include "Domain.h"
+#include "Simulation.h"
+#include "molecules/Molecule.h"
+#include "parallel/DomainDecompBase.h"
+#include "particleContainer/ParticleContainer.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <utility>
+
+#include "utils/FileUtils.h"
+#include "utils/Logger.h"
+#include "utils/mardyn_assert.h"
+#include "utils/xmlfileUnits.h"
+
+
+Cylindrical::Cylindrical(double /*cutoffT*/, double cutoffLJ, Domain* domain, DomainDecompBase* domainDecomposition,
+		ParticleContainer* particleContainer, Simulation* /*simulation*/) :
+		_axis(2),
+		_planeAxes{0, 1},
+		_bins(64),
+		_binWidth{0., 0.},
+		_binVolume(0.),
+		_cutoff(cutoffLJ),
+		_frequency(10),
+		_simstep(0),
+		_numComp(0),
+		_numLJSum(0),
+		_particleContainer(particleContainer),
+		_domain(domain),
+		_domainDecomposition(domainDecomposition),
+		_nStartWritingProfiles(1),
+		_nWriteFreqProfiles(10),
+		_nStopWritingProfiles(100)
+{
+	Log::global_log->info() << "Long Range Correction for cylindrical interfaces is used" << std::endl;
+}
+
+void Cylindrical::readXML(XMLfileUnits& xmlconfig) {
+	Log::global_log->info() << "[Long Range Correction] Reading xml config" << std::endl;
+
+	xmlconfig.getNodeValue("direction", _axis);
+	xmlconfig.getNodeValue("bins", _bins);
+	xmlconfig.getNodeValue("frequency", _frequency);
+	if (_axis > 2) {
+		std::ostringstream error_message;
+		error_message << "Long Range Correction: direction must be 0 (x), 1 (y) or 2 (z)! Programm exit ..." << std::endl;
+		MARDYN_EXIT(error_message.str());
+	}
+	if (_bins < 1 || _frequency < 1) {
+		std::ostringstream error_message;
+		error_message << "Long Range Correction: bins and frequency have to be >= 1! Programm exit ..." << std::endl;
+		MARDYN_EXIT(error_message.str());
+	}
+	_planeAxes[0] = (_axis + 1) % 3;
+	_planeAxes[1] = (_axis + 2) % 3;
+
+	Log::global_log->info() << "Long Range Correction: cylinder axis in direction " << _axis << ", using "
+							<< _bins << "x" << _bins << " bins in the normal plane." << std::endl;
+	Log::global_log->info() << "Long Range Correction: sampling profiles every " << _frequency << "th simstep." << std::endl;
+
+	// write control
+	bool bRet1 = xmlconfig.getNodeValue("writecontrol/start", _nStartWritingProfiles);
+	bool bRet2 = xmlconfig.getNodeValue("writecontrol/frequency", _nWriteFreqProfiles);
+	bool bRet3 = xmlconfig.getNodeValue("writecontrol/stop", _nStopWritingProfiles);
+	if (_nWriteFreqProfiles < 1) {
+		std::ostringstream error_message;
+		error_message << "Long Range Correction: Write frequency < 1! Programm exit ..." << std::endl;
+		MARDYN_EXIT(error_message.str());
+	}
+	if (_nStopWritingProfiles <= _nStartWritingProfiles) {
+		std::ostringstream error_message;
+		error_message << "Long Range Correction: Writing profiles 'stop' <= 'start'! Programm exit ..." << std::endl;
+		MARDYN_EXIT(error_message.str());
+	}
+	if (!(bRet1 && bRet2 && bRet3)) {
+		std::ostringstream error_message;
+		error_message << "Long Range Correction: Write control parameters not valid! Programm exit ..." << std::endl;
+		MARDYN_EXIT(error_message.str());
+	}
+	Log::global_log->info() << "Long Range Correction->writecontrol: Start writing profiles at simstep: " << _nStartWritingProfiles << std::endl;
+	Log::global_log->info() << "Long Range Correction->writecontrol: Writing profiles with frequency: " << _nWriteFreqProfiles << std::endl;
+	Log::global_log->info() << "Long Range Correction->writecontrol: Stop writing profiles at simstep: " << _nStopWritingProfiles << std::endl;
+}
+
+void Cylindrical::init() {
+	std::vector<Component>& components = *_simulation.getEnsemble()->getComponents();
+	_numComp = components.size();
+	_numLJ.resize(_numComp);
+	_ljOffset.resize(_numComp);
+	_numLJSum = 0;
+	for (unsigned i = 0; i < _numComp; i++) {
+		_numLJ[i] = components[i].numLJcenters();
+		_ljOffset[i] = _numLJSum;
+		_numLJSum += _numLJ[i];
+	}
+
+	for (unsigned k = 0; k < 2; k++) {
+		_binWidth[k] = _domain->getGlobalLength(_planeAxes[k]) / _bins;
+	}
+	_binVolume = _binWidth[0] * _binWidth[1] * _domain->getGlobalLength(_axis);
+
+	const unsigned numValues = _numLJSum * _bins * _bins;
+	_rho.resize(numValues);
+	_u.resize(numValues);
+	_vAxis.resize(numValues);
+	for (unsigned k = 0; k < 2; k++) {
+		_vPlane[k].resize(numValues);
+		_f[k].resize(numValues);
+	}
+	_rhoHistogram.resize(numValues);
+
+	initGridKernels();
+}
+
+void Cylindrical::initGridKernels() {
+	_convolution.init(_bins, _bins);
+
+	// key: {epsilon, sigma^2}
+	std::map<std::pair<double, double>, unsigned> kernelIds;
+	_kernels.clear();
+	_kernelIndex.assign(_numLJSum * _numLJSum, 0);
+	for (unsigned ci = 0; ci < _numComp; ++ci) {
+		for (unsigned cj = 0; cj < _numComp; ++cj) {
+			ParaStrm& params = _domain->getComp2Params()(ci, cj);
+			params.reset_read();
+			for (unsigned si = 0; si < _numLJ[ci]; ++si) {
+				for (unsigned sj = 0; sj < _numLJ[cj]; ++sj) {
+					double eps24;
+					double sig2;
+					double shift6;
+					params >> eps24;
+					params >> sig2;
+					params >> shift6;
+					const std::pair<double, double> key(eps24 / 24, sig2);
+
+					auto kernelId = kernelIds.find(key);
+					if (kernelId == kernelIds.end()) {
+						_kernels.emplace_back();
+						buildGridKernel(key.first, key.second, _kernels.back());
+						kernelId = kernelIds.emplace(key, _kernels.size() - 1).first;
+					}
+					_kernelIndex[(_ljOffset[ci] + si) * _numLJSum + _ljOffset[cj] + sj] = kernelId->second;
+				}
+			}
+		}
+	}
+	Log::global_log->info() << "Long Range Correction: precomputed " << _kernels.size() << " grid kernels." << std::endl;
+}
+
+void Cylindrical::buildGridKernel(double eps, double sig2, GridKernel& kernel) const {
+	const unsigned numBins = _bins * _bins;
+	const double binArea = _binWidth[0] * _binWidth[1];
+	std::vector<double> kernelU(numBins, 0.0), kernelVAxis(numBins, 0.0);
+	std::vector<double> kernelVPlane[2], kernelF[2];
+	for (unsigned k = 0; k < 2; k++) {
+		kernelVPlane[k].assign(numBins, 0.0);
+		kernelF[k].assign(numBins, 0.0);
+	}
+
+	for (unsigned o1 = 0; o1 < _bins; ++o1) {
+		for (unsigned o0 = 0; o0 < _bins; ++o0) {
+			// minimum image separation in the plane
+			const unsigned offset[2] = {o0, o1};
+			double s[2];
+			double forceSign[2];
+			for (unsigned k = 0; k < 2; k++) {
+				if (offset[k] < _bins - offset[k]) {
+					s[k] = offset[k] * _binWidth[k];
+					forceSign[k] = 1.0;
+				} else {
+					s[k] = (static_cast<double>(offset[k]) - _bins) * _binWidth[k];
+					// bins exactly half a box away pull equally in both directions
+					forceSign[k] = (offset[k] == _bins - offset[k]) ? 0.0 : 1.0;
+				}
+			}
+			double iU, iW, iWZ2;
+			lineIntegrals(eps, sig2, std::sqrt(s[0] * s[0] + s[1] * s[1]), iU, iW, iWZ2);
+
+			// energy and virial are split between the two partners, the force acts on every site
+			const unsigned index = o0 + _bins * o1;
+			kernelU[index] = 0.5 * binArea * iU;
+			kernelVAxis[index] = -0.5 * binArea * iWZ2;
+			for (unsigned k = 0; k < 2; k++) {
+				kernelVPlane[k][index] = -0.5 * binArea * iW * s[k] * s[k];
+				kernelF[k][index] = forceSign[k] * binArea * iW * s[k];
+			}
+		}
+	}
+
+	_convolution.transformKernel(kernelU.data(), kernel.u);
+	_convolution.transformKernel(kernelVAxis.data(), kernel.vAxis);
+	for (unsigned k = 0; k < 2; k++) {
+		_convolution.transformKernel(kernelVPlane[k].data(), kernel.vPlane[k]);
+		_convolution.transformKernel(kernelF[k].data(), kernel.f[k]);
+	}
+}
+
+void Cylindrical::lineIntegrals(double eps, double sig2, double s, double& iU, double& iW, double& iWZ2) const {
+	const double sig6 = sig2 * sig2 * sig2;
+	const double sig12 = sig6 * sig6;
+	const double rc2 = _cutoff * _cutoff;
+
+	// composite Simpson rule; the integrands vanish at both ends of the transformed intervals
+	const int numIntervals = 512;
+	iU = iW = iWZ2 = 0.0;
+
+	auto accumulate = [&](double r, double z, double jacobian, double weight) {
+		const double r2inv = 1.0 / (r * r);
+		const double lj6 = sig6 * r2inv * r2inv * r2inv;
+		const double lj12 = lj6 * lj6;
+		const double u = 4.0 * eps * (lj12 - lj6);
+		// u'(r)/r
+		const double w = 4.0 * eps * (6.0 * lj6 - 12.0 * lj12) * r2inv;
+		iU += weight * jacobian * u;
+		iW += weight * jacobian * w;
+		iWZ2 += weight * jacobian * w * z * z;
+	};
+
+	if (s * s < 1e-12 * rc2) {
+		// on the axis: z = rc / t, t in (0, 1]
+		const double h = 1.0 / numIntervals;
+		for (int n = 1; n <= numIntervals; ++n) {
+			const double t = n * h;
+			const double weight = (n == numIntervals) ? 1.0 : ((n % 2 == 1) ? 4.0 : 2.0);
+			const double z = _cutoff / t;
+			accumulate(z, z, _cutoff / (t * t), weight * h / 3.0);
+		}
+	}
+	else {
+		// z = s * tan(theta), only the part of the line outside of the cutoff sphere contributes
+		const double z0 = std::sqrt(std::max(rc2 - s * s, 0.0));
+		const double theta0 = std::atan(z0 / s);
+		const double h = (0.5 * M_PI - theta0) / numIntervals;
+		for (int n = 0; n < numIntervals; ++n) {
+			const double theta = theta0 + n * h;
+			const double weight = (n == 0) ? 1.0 : ((n % 2 == 1) ? 4.0 : 2.0);
+			const double cosTheta = std::cos(theta);
+			accumulate(s / cosTheta, s * std::tan(theta), s / (cosTheta * cosTheta), weight * h / 3.0);
+		}
+	}
+
+	// both halves of the line
+	iU *= 2.0;
+	iW *= 2.0;
+	iWZ2 *= 2.0;
+}
+
+unsigned Cylindrical::binIndex(const std::array<double, 3>& r) const {
+	int bin[2];
+	for (unsigned k = 0; k < 2; k++) {
+		bin[k] = static_cast<int>(std::floor(r[_planeAxes[k]] / _binWidth[k]));
+		if (bin[k] < 0) {
+			bin[k] += _bins;
+		}
+		else if (bin[k] >= static_cast<int>(_bins)) {
+			bin[k] -= _bins;
+		}
+	}
+	return bin[0] + _bins * bin[1];
+}
+
+void Cylindrical::sampleDensityProfiles() {
+	const double binVolumeInv = 1.0 / _binVolume;
+	const unsigned numBins = _bins * _bins;
+
+	_rhoHistogram.clear();
+	#if defined(_OPENMP)
+	#pragma omp parallel
+	#endif
+	{
+		std::vector<double>& histogram = _rhoHistogram.threadBuffer();
+		for (auto tempMol = _particleContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); tempMol.isValid(); ++tempMol) {
+			const unsigned cid = tempMol->componentid();
+			for (unsigned i = 0; i < _numLJ[cid]; i++) {
+				histogram[binIndex(tempMol->ljcenter_d_abs(i)) + numBins * (_ljOffset[cid] + i)] += binVolumeInv;
+			}
+		}
+	}
+	std::fill(_rho.begin(), _rho.end(), 0.0);
+	_rhoHistogram.addTo(_rho.data(), 0, _rho.size());
+
+	_domainDecomposition->collCommInit(_rho.size());
+	for (double rho : _rho) {
+		_domainDecomposition->collCommAppendDouble(rho);
+	}
+	_domainDecomposition->collCommAllreduceSum();
+	for (double& rho : _rho) {
+		rho = _domainDecomposition->collCommGetDouble();
+	}
+	_domainDecomposition->collCommFinalize();
+}
+
+void Cylindrical::convolveProfiles() {
+	const unsigned numBins = _bins * _bins;
+	std::fill(_u.begin(), _u.end(), 0.0);
+	std::fill(_vAxis.begin(), _vAxis.end(), 0.0);
+	for (unsigned k = 0; k < 2; k++) {
+		std::fill(_vPlane[k].begin(), _vPlane[k].end(), 0.0);
+		std::fill(_f[k].begin(), _f[k].end(), 0.0);
+	}
+
+	std::vector<PeriodicConvolution::Spectrum> rhoSpectra(_numLJSum);
+	#if defined(_OPENMP)
+	#pragma omp parallel for
+	#endif
+	for (int site = 0; site < static_cast<int>(_numLJSum); ++site) {
+		_convolution.transformSignal(&_rho[site * numBins], rhoSpectra[site]);
+	}
+
+	#if defined(_OPENMP)
+	#pragma omp parallel
+	#endif
+	{
+		PeriodicConvolution::Spectrum accU, accVAxis, accVPlane[2], accF[2];
+
+		#if defined(_OPENMP)
+		#pragma omp for schedule(dynamic)
+		#endif
+		for (int siteA = 0; siteA < static_cast<int>(_numLJSum); ++siteA) {
+			_convolution.clearSpectrum(accU);
+			_convolution.clearSpectrum(accVAxis);
+			for (unsigned k = 0; k < 2; k++) {
+				_convolution.clearSpectrum(accVPlane[k]);
+				_convolution.clearSpectrum(accF[k]);
+			}
+			for (unsigned siteB = 0; siteB < _numLJSum; ++siteB) {
+				const GridKernel& kernel = _kernels[_kernelIndex[siteA * _numLJSum + siteB]];
+				PeriodicConvolution::multiplyAdd(kernel.u, rhoSpectra[siteB], accU);
+				PeriodicConvolution::multiplyAdd(kernel.vAxis, rhoSpectra[siteB], accVAxis);
+				for (unsigned k = 0; k < 2; k++) {
+					PeriodicConvolution::multiplyAdd(kernel.vPlane[k], rhoSpectra[siteB], accVPlane[k]);
+					PeriodicConvolution::multiplyAdd(kernel.f[k], rhoSpectra[siteB], accF[k]);
+				}
+			}
+			const unsigned offsetA = siteA * numBins;
+			_convolution.backTransformAdd(accU, &_u[offsetA]);
+			_convolution.backTransformAdd(accVAxis, &_vAxis[offsetA]);
+			for (unsigned k = 0; k < 2; k++) {
+				_convolution.backTransformAdd(accVPlane[k], &_vPlane[k][offsetA]);
+				_convolution.backTransformAdd(accF[k], &_f[k][offsetA]);
+			}
+		}
+	}
+}
+
+void Cylindrical::calculateLongRange() {
+	if (_simstep % _frequency == 0) {
+		sampleDensityProfiles();
+		convolveProfiles();
+	}
+
+	const unsigned numBins = _bins * _bins;
+	double Upot_c = 0.0;
+	double Virial_c = 0.0;
+
+	#if defined(_OPENMP)
+	#pragma omp parallel reduction(+:Upot_c, Virial_c)
+	#endif
+	for (auto tempMol = _particleContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); tempMol.isValid(); ++tempMol) {
+		const unsigned cid = tempMol->componentid();
+		for (unsigned i = 0; i < _numLJ[cid]; i++) {
+			const unsigned index = binIndex(tempMol->ljcenter_d_abs(i)) + numBins * (_ljOffset[cid] + i);
+			double Fa[3] = {0.0, 0.0, 0.0};
+			double Via[3] = {0.0, 0.0, 0.0};
+			for (unsigned k = 0; k < 2; k++) {
+				Fa[_planeAxes[k]] = _f[k][index];
+				Via[_planeAxes[k]] = _vPlane[k][index];
+			}
+			Via[_axis] = _vAxis[index];
+			tempMol->Fljcenteradd(i, Fa);
+			tempMol->Viadd(Via);
+			Upot_c += _u[index];
+			Virial_c += Via[0] + Via[1] + Via[2];
+		}
+	}
+
+	_domainDecomposition->collCommInit(2);
+	_domainDecomposition->collCommAppendDouble(Upot_c);
+	_domainDecomposition->collCommAppendDouble(Virial_c);
+	_domainDecomposition->collCommAllreduceSum();
+	Upot_c = _domainDecomposition->collCommGetDouble();
+	Virial_c = _domainDecomposition->collCommGetDouble();
+	_domainDecomposition->collCommFinalize();
+
+	_domain->setUpotCorr(Upot_c);
+	_domain->setVirialCorr(Virial_c);
+
+	_simstep++;
+}
+
+void Cylindrical::writeProfiles(DomainDecompBase* domainDecomp, Domain* /*domain*/, unsigned long simstep) {
+	if (0 != simstep % _nWriteFreqProfiles || simstep < _nStartWritingProfiles || simstep > _nStopWritingProfiles)
+		return;
+
+	if (domainDecomp->getRank() != 0)
+		return;
+
+	std::stringstream filenamestream;
+	filenamestream << "LRC_cylindrical" << "_TS" << fill_width('0', 9) << simstep << ".dat";
+
+	const unsigned numBins = _bins * _bins;
+	std::stringstream outputstream;
+	outputstream << "                      p0                      p1";
+	for (unsigned si = 0; si < _numLJSum; ++si) {
+		outputstream << "            rho_l_LRC[" << si << "]";
+		outputstream << "               F0_LRC[" << si << "]";
+		outputstream << "               F1_LRC[" << si << "]";
+		outputstream << "                u_LRC[" << si << "]";
+	}
+	outputstream << std::endl;
+
+	for (unsigned b1 = 0; b1 < _bins; ++b1) {
+		for (unsigned b0 = 0; b0 < _bins; ++b0) {
+			const unsigned bin = b0 + _bins * b1;
+			outputstream << std::setw(24) << _binWidth[0] * (b0 + 0.5) << std::setw(24) << _binWidth[1] * (b1 + 0.5);
+			for (unsigned si = 0; si < _numLJSum; ++si) {
+				const unsigned index = bin + numBins * si;
+				outputstream << std::setw(24) << FORMAT_SCI_MAX_DIGITS << _rho[index];
+				outputstream << std::setw(24) << FORMAT_SCI_MAX_DIGITS << _f[0][index];
+				outputstream << std::setw(24) << FORMAT_SCI_MAX_DIGITS << _f[1][index];
+				outputstream << std::setw(24) << FORMAT_SCI_MAX_DIGITS << _u[index];
+			}
+			outputstream << std::endl;
+		}
+	}
+
+	std::ofstream fileout(filenamestream.str().c_str(), std::ios::out);
+	fileout << outputstream.str();
+	fileout.close();
+}
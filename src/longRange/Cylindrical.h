@@ -0,0 +1,112 @@
+#ifndef CYLINDRICAL_H_
+#define CYLINDRICAL_H_
+
+#include "LongRangeCorrection.h"
+#include "PeriodicConvolution.h"
+#include "ThreadLocalHistogram.h"
+
+#include <array>
+#include <vector>
+#include <cstdint>
+
+class Simulation;
+class Domain;
+class ParticleContainer;
+
+
+/** @brief Long range correction for systems which are homogeneous along one axis only (cylindrical jets, droplets, films)
+ *
+ * The density of the LJ sites is sampled on a periodic grid in the plane normal to the axis. The tail of the
+ * LJ interaction (r > rc) is integrated along the axis, which gives a kernel per in-plane grid offset.
+ * Force, energy and virial of every site follow from periodic 2D convolutions of the density with these kernels,
+ * which are precomputed once and applied by FFT (same infrastructure as the planar correction).
+ *
+ * Electrostatic sites are not corrected, all LJ sites are treated as LJ centres.
+ */
+class Cylindrical : public LongRangeCorrection {
+	friend class CylindricalTest;
+
+public:
+	Cylindrical(double cutoffT, double cutoffLJ, Domain* domain, DomainDecompBase* domainDecomposition, ParticleContainer* particleContainer, Simulation* simulation);
+	virtual ~Cylindrical() {}
+
+	void init() override;
+
+	/** @brief Read in XML configuration for cylindrical long range corrections.
+	 *
+	 * The following XML object structure is handled by this method:
+	 * \code{.xml}
+		<longrange type="cylindrical">
+			<direction>INT</direction> <!-- axis along which the system is homogeneous: 0: x | 1: y | 2: z (default) -->
+			<bins>INT</bins> <!-- number of bins in each direction of the plane normal to the axis -->
+			<frequency>INT</frequency> <!-- Frequency at which the LRC is recalculated in number of timesteps between -->
+			<writecontrol> <!-- Parameters to control output in file -->
+				<start>INT</start>
+				<frequency>INT</frequency>
+				<stop>INT</stop>
+			</writecontrol>
+		</longrange>
+	   \endcode
+	 */
+	void readXML(XMLfileUnits& xmlconfig) override;
+	void calculateLongRange() override;
+	void writeProfiles(DomainDecompBase* domainDecomp, Domain* domain, unsigned long simstep) override;
+
+private:
+	/** Energy, virial (in-plane directions 0 and 1, axial) and in-plane force terms in spectral space */
+	struct GridKernel {
+		PeriodicConvolution::Spectrum u;
+		PeriodicConvolution::Spectrum vPlane[2];
+		PeriodicConvolution::Spectrum vAxis;
+		PeriodicConvolution::Spectrum f[2];
+	};
+
+	//! Precompute the kernels of all LJ site pairs, identical parameters share one kernel.
+	void initGridKernels();
+	void buildGridKernel(double eps, double sig2, GridKernel& kernel) const;
+	//! Integrals of the LJ tail along the axis at in-plane distance s: energy u, u'(r)/r and u'(r)/r * z^2
+	void lineIntegrals(double eps, double sig2, double s, double& iU, double& iW, double& iWZ2) const;
+	//! Bin index of the in-plane position of r
+	unsigned binIndex(const std::array<double, 3>& r) const;
+
+	void sampleDensityProfiles();
+	void convolveProfiles();
+
+	unsigned _axis;
+	unsigned _planeAxes[2];
+	unsigned _bins;
+	double _binWidth[2];
+	double _binVolume;
+	double _cutoff;
+	int _frequency;
+	unsigned long _simstep;
+
+	unsigned _numComp;
+	std::vector<unsigned> _numLJ;
+	std::vector<unsigned> _ljOffset;  // first LJ site of every component
+	unsigned _numLJSum;
+
+	PeriodicConvolution _convolution;
+	std::vector<GridKernel> _kernels;
+	std::vector<unsigned> _kernelIndex;  // kernel of LJ sites (a,b) at a*_numLJSum+b
+	ThreadLocalHistogram _rhoHistogram;
+
+	// profiles per LJ site and bin
+	std::vector<double> _rho;
+	std::vector<double> _u;
+	std::vector<double> _vPlane[2];
+	std::vector<double> _vAxis;
+	std::vector<double> _f[2];
+
+	ParticleContainer* _particleContainer;
+	Domain* _domain;
+	DomainDecompBase* _domainDecomposition;
+
+	// write control
+	uint64_t _nStartWritingProfiles;
+	uint64_t _nWriteFreqProfiles;
+	uint64_t _nStopWritingProfiles;
+};
+
+
+#endif /* CYLINDRICAL_H_ */
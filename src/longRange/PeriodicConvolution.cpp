@@ -0,0 +1,135 @@
+#include "longRange/PeriodicConvolution.h"
+
+#include <cmath>
+#include <utility>
+
+#include "utils/mardyn_assert.h"
+
+
+void PeriodicConvolution::init(unsigned length0, unsigned length1) {
+	initDimension(_dims[0], length0);
+	initDimension(_dims[1], length1);
+}
+
+void PeriodicConvolution::initDimension(Dimension& dim, unsigned length) {
+	dim.length = length;
+	dim.fftSize = 1;
+	while (dim.fftSize < 2 * dim.length - 1 && dim.length > 0) {
+		dim.fftSize <<= 1;
+	}
+
+	unsigned numBits = 0;
+	while ((1u << numBits) < dim.fftSize) {
+		++numBits;
+	}
+	dim.bitReverse.resize(dim.fftSize);
+	for (unsigned i = 0; i < dim.fftSize; ++i) {
+		unsigned reversed = 0;
+		for (unsigned b = 0; b < numBits; ++b) {
+			reversed |= ((i >> b) & 1u) << (numBits - 1 - b);
+		}
+		dim.bitReverse[i] = reversed;
+	}
+
+	dim.twiddles.resize(dim.fftSize / 2);
+	for (unsigned k = 0; k < dim.fftSize / 2; ++k) {
+		const double phi = -2.0 * M_PI * k / dim.fftSize;
+		dim.twiddles[k] = std::complex<double>(std::cos(phi), std::sin(phi));
+	}
+}
+
+void PeriodicConvolution::transformKernel(const double* kernel, Spectrum& result) const {
+	// out[i] = sum_o kernel[o] * in[i+o] is a correlation, i.e. a convolution with the mirrored kernel
+	const unsigned l0 = _dims[0].length;
+	const unsigned l1 = _dims[1].length;
+	clearSpectrum(result);
+	for (unsigned k1 = 0; k1 < l1; ++k1) {
+		for (unsigned k0 = 0; k0 < l0; ++k0) {
+			result[k0 + _dims[0].fftSize * k1] = kernel[(l0 - k0) % l0 + l0 * ((l1 - k1) % l1)];
+		}
+	}
+	fft(result, false);
+}
+
+void PeriodicConvolution::transformSignal(const double* signal, Spectrum& result) const {
+	const unsigned l0 = _dims[0].length;
+	clearSpectrum(result);
+	for (unsigned k1 = 0; k1 < _dims[1].length; ++k1) {
+		for (unsigned k0 = 0; k0 < l0; ++k0) {
+			result[k0 + _dims[0].fftSize * k1] = signal[k0 + l0 * k1];
+		}
+	}
+	fft(result, false);
+}
+
+void PeriodicConvolution::multiplyAdd(const Spectrum& kernel, const Spectrum& signal, Spectrum& accumulator) {
+	mardyn_assert(kernel.size() == signal.size() && signal.size() == accumulator.size());
+	const size_t n = accumulator.size();
+	for (size_t k = 0; k < n; ++k) {
+		accumulator[k] += kernel[k] * signal[k];
+	}
+}
+
+void PeriodicConvolution::backTransformAdd(Spectrum& accumulator, double* out) const {
+	mardyn_assert(accumulator.size() == _dims[0].fftSize * _dims[1].fftSize);
+	fft(accumulator, true);
+	const unsigned l0 = _dims[0].length;
+	const unsigned l1 = _dims[1].length;
+	const unsigned n0 = _dims[0].fftSize;
+	const unsigned n1 = _dims[1].fftSize;
+	const double norm = 1.0 / (n0 * n1);
+	for (unsigned i1 = 0; i1 < l1; ++i1) {
+		for (unsigned i0 = 0; i0 < l0; ++i0) {
+			// fold the parts of the linear convolution which wrap around the periodic boundaries
+			double value = 0.0;
+			for (unsigned j1 = i1; j1 < n1; j1 += l1) {
+				for (unsigned j0 = i0; j0 < n0; j0 += l0) {
+					value += accumulator[j0 + n0 * j1].real();
+				}
+			}
+			out[i0 + l0 * i1] += value * norm;
+		}
+	}
+}
+
+void PeriodicConvolution::fft(Spectrum& data, bool inverse) const {
+	const unsigned n0 = _dims[0].fftSize;
+	const unsigned n1 = _dims[1].fftSize;
+	if (n0 > 1) {
+		for (unsigned k1 = 0; k1 < n1; ++k1) {
+			fft1D(_dims[0], &data[n0 * k1], 1, inverse);
+		}
+	}
+	if (n1 > 1) {
+		for (unsigned k0 = 0; k0 < n0; ++k0) {
+			fft1D(_dims[1], &data[k0], n0, inverse);
+		}
+	}
+}
+
+void PeriodicConvolution::fft1D(const Dimension& dim, std::complex<double>* data, unsigned stride, bool inverse) {
+	const unsigned n = dim.fftSize;
+	for (unsigned i = 0; i < n; ++i) {
+		if (i < dim.bitReverse[i]) {
+			std::swap(data[i * stride], data[dim.bitReverse[i] * stride]);
+		}
+	}
+	for (unsigned len = 2; len <= n; len <<= 1) {
+		const unsigned halfLen = len / 2;
+		const unsigned twiddleStride = n / len;
+		for (unsigned start = 0; start < n; start += len) {
+			for (unsigned k = 0; k < halfLen; ++k) {
+				std::complex<double> w = dim.twiddles[k * twiddleStride];
+				if (inverse) {
+					w = std::conj(w);
+				}
+				std::complex<double>& evenRef = data[(start + k) * stride];
+				std::complex<double>& oddRef = data[(start + k + halfLen) * stride];
+				const std::complex<double> even = evenRef;
+				const std::complex<double> odd = oddRef * w;
+				evenRef = even + odd;
+				oddRef = even - odd;
+			}
+		}
+	}
+}
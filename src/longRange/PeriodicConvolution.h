@@ -0,0 +1,66 @@
+#ifndef PERIODICCONVOLUTION_H_
+#define PERIODICCONVOLUTION_H_
+
+#include <complex>
+#include <vector>
+
+
+/** @brief Periodic (circular) convolution of 1D or 2D profiles by means of a radix-2 FFT
+ *
+ * Computes out[i] += sum_o kernel[o] * in[(i + o) % length] for all i in O(length * log(length)),
+ * for 2D profiles (bin index i0 + length0 * i1) the offsets are periodic in both dimensions.
+ * Every dimension is zero-padded to the next power of two >= 2*length-1, the wrapped part of the
+ * linear convolution is folded back onto the profile.
+ *
+ * Since the transform is linear, several kernel/signal products can be accumulated in
+ * spectral space and transformed back only once.
+ */
+class PeriodicConvolution {
+public:
+	typedef std::vector<std::complex<double>> Spectrum;
+
+	PeriodicConvolution() = default;
+
+	/** @brief Prepare the FFT (twiddle factors, bit reversal) for profiles with length0 x length1 bins. */
+	void init(unsigned length0, unsigned length1 = 1);
+
+	/** @brief Total number of bins of a profile */
+	unsigned getLength() const { return _dims[0].length * _dims[1].length; }
+
+	/** @brief Transform a kernel given per offset o = o0 + length0 * o1. */
+	void transformKernel(const double* kernel, Spectrum& result) const;
+
+	/** @brief Transform a profile. */
+	void transformSignal(const double* signal, Spectrum& result) const;
+
+	/** @brief Set a spectrum to zero with the size used by this convolution. */
+	void clearSpectrum(Spectrum& spectrum) const {
+		spectrum.assign(_dims[0].fftSize * _dims[1].fftSize, std::complex<double>(0., 0.));
+	}
+
+	/** @brief accumulator += kernel * signal (element-wise in spectral space) */
+	static void multiplyAdd(const Spectrum& kernel, const Spectrum& signal, Spectrum& accumulator);
+
+	/** @brief Transform the accumulated spectrum back and add the periodic result to the profile out.
+	 *
+	 * The accumulator is used as workspace and is overwritten.
+	 */
+	void backTransformAdd(Spectrum& accumulator, double* out) const;
+
+private:
+	struct Dimension {
+		unsigned length {0};
+		unsigned fftSize {1};
+		std::vector<unsigned> bitReverse;
+		Spectrum twiddles;
+	};
+
+	static void initDimension(Dimension& dim, unsigned length);
+	void fft(Spectrum& data, bool inverse) const;
+	static void fft1D(const Dimension& dim, std::complex<double>* data, unsigned stride, bool inverse);
+
+	Dimension _dims[2];
+};
+
+
+#endif /* PERIODICCONVOLUTION_H_ */
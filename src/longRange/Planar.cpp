@@ -10,6 +10,8 @@
 #include <vector>
 #include <cmath>
 #include <algorithm>
+#include <array>
+#include <map>
 
 #include "utils/Logger.h"
 #include "utils/xmlfileUnits.h"
@@ -31,6 +33,7 @@ Planar::Planar(double /*cutoffT*/, double cutoffLJ, Domain* domain, DomainDecomp
 	_slabs = slabs;
 	frequency=10;
 	numComp=0;
+	_axis=1;
 }
 
 Planar::~Planar() {
@@ -130,18 +133,22 @@ void Planar::init()
 		}
 	}
 
-	ymax=_domain->getGlobalLength(1);
-	boxlength[0]=_domain->getGlobalLength(0);
-	boxlength[2]=_domain->getGlobalLength(2);
-	cutoff_slabs=cutoff*_slabs/ymax; // Number of slabs to cutoff
-	delta=ymax/_slabs;
-	V=ymax*_domain->getGlobalLength(0)*_domain->getGlobalLength(2); // Volume
+	for (unsigned short d = 0; d < 3; d++) {
+		boxlength[d]=_domain->getGlobalLength(d);
+	}
+	normalLength=boxlength[_axis];
+	cutoff_slabs=cutoff*_slabs/normalLength; // Number of slabs to cutoff
+	delta=normalLength/_slabs;
+	V=boxlength[0]*boxlength[1]*boxlength[2]; // Volume
 
 	sint=_slabs;
 	simstep = 0;
 
 	temp=_domain->getTargetTemperature(0);
 
+	_rhoHistogram.resize(_slabs*(numLJSum+numDipoleSum));
+	initSlabKernels();
+
 	if (_region.refPosID[0]+_region.refPosID[1] > 0) {
 		_subject = getSubject();
 		if (nullptr != _subject) {
@@ -163,6 +170,12 @@ void Planar::readXML(XMLfileUnits& xmlconfig)
 	xmlconfig.getNodeValue("slabs", _slabs);
 	xmlconfig.getNodeValue("smooth", _smooth);
 	xmlconfig.getNodeValue("frequency", frequency);
+	xmlconfig.getNodeValue("direction", _axis);
+	if (_axis > 2) {
+		std::ostringstream error_message;
+		error_message << "Long Range Correction: direction must be 0 (x), 1 (y) or 2 (z)! Programm exit ..." << std::endl;
+		MARDYN_EXIT(error_message.str());
+	}
 
 	std::string strVal;
 	_region.refPosID[0] = 0; _region.refPosID[1] = 0;
@@ -172,7 +185,7 @@ void Planar::readXML(XMLfileUnits& xmlconfig)
 	// In order to still get correct state values in the bulks, the LRC for the virial and potential energy is also applied outside of the region.
 	if (xmlconfig.getNodeValue("region/left", _region.refPos[0]) && xmlconfig.getNodeValue("region/right", strVal)) {
 		// accept "box" as input
-		_region.refPos[1] = (strVal == "box") ? _domain->getGlobalLength(1) : atof(strVal.c_str() );
+		_region.refPos[1] = (strVal == "box") ? _domain->getGlobalLength(_axis) : atof(strVal.c_str() );
 		_region.actPos[0] = _region.refPos[0];
 		_region.actPos[1] = _region.refPos[1];
 		// read reference coords IDs
@@ -180,13 +193,13 @@ void Planar::readXML(XMLfileUnits& xmlconfig)
 		xmlconfig.getNodeValue("region/right@refcoordsID", _region.refPosID[1] );
 	} else {
 		_region.refPos[0] = _region.actPos[0] = 0.0;
-		_region.refPos[1] = _region.actPos[1] = _domain->getGlobalLength(1);
+		_region.refPos[1] = _region.actPos[1] = _domain->getGlobalLength(_axis);
 	}
 
-	Log::global_log->info() << "Long Range Correction: using " << _slabs << " slabs for profiles to calculate LRC." << std::endl;
+	Log::global_log->info() << "Long Range Correction: using " << _slabs << " slabs normal to direction " << _axis << " for profiles to calculate LRC." << std::endl;
 	Log::global_log->info() << "Long Range Correction: sampling profiles every " << frequency << "th simstep." << std::endl;
 	Log::global_log->info() << "Long Range Correction: profiles are smoothed (averaged over time): " << std::boolalpha << _smooth << std::endl;
-	Log::global_log->info() << "Long Range Correction: force corrections are applied to particles within yRef = " << _region.refPos[0] << " (refID: " << _region.refPosID[0] << ") and " << _region.refPos[1] << " (refID: " << _region.refPosID[1] << ")" << std::endl;
+	Log::global_log->info() << "Long Range Correction: force corrections are applied to particles within coordinates " << _region.refPos[0] << " (refID: " << _region.refPosID[0] << ") and " << _region.refPos[1] << " (refID: " << _region.refPosID[1] << ")" << std::endl;
 	Log::global_log->info() << "Long Range Correction: pot. energy and virial corrections are applied within whole domain" << std::endl;
 
 	// write control
@@ -219,45 +232,10 @@ void Planar::readXML(XMLfileUnits& xmlconfig)
 		MARDYN_EXIT(error_message.str());
 	}
 }
-
 void Planar::calculateLongRange() {
 
 	if (_smooth){
-		const double delta_inv = 1.0 / delta;
-		const double slabsPerV = _slabs / V;
-
-		#if defined(_OPENMP)
-		#pragma omp parallel
-		#endif
-		for(auto tempMol = _particleContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); tempMol.isValid(); ++tempMol){
-			unsigned cid=tempMol->componentid();
-
-			for (unsigned i=0; i<numLJ[cid]; i++){
-				int loc=(tempMol->ljcenter_d_abs(i)[1]) * delta_inv;
-				if (loc < 0){
-					loc=loc+_slabs;
-				}
-				else if (loc > sint-1){
-					loc=loc-_slabs;
-				}
-				const int index = loc + _slabs * (i + numLJSum2[cid]);
-
-				#if defined(_OPENMP)
-				#pragma omp atomic
-				#endif
-				rho_g[index] += slabsPerV;
-			}
-			if (numDipole[cid] != 0){
-				int loc=tempMol->r(1) * delta_inv;
-
-				const int index = loc + _slabs * (numDipoleSum2[cid]);
-
-				#if defined(_OPENMP)
-				#pragma omp atomic
-				#endif
-				rhoDipole[index] += slabsPerV;
-			}
-		}
+		sampleDensityProfiles(rho_g, rhoDipole);
 	}
 	if (simstep % frequency == 0){	// The Density Profile is only calculated once in 10 simulation steps
 
@@ -275,40 +253,7 @@ void Planar::calculateLongRange() {
 
 		// Calculation of the density profile for s slabs
 		if (!_smooth){
-			const double delta_inv = 1.0 / delta;
-			const double slabsPerV = _slabs / V;
-
-			#if defined(_OPENMP)
-			#pragma omp parallel
-			#endif
-			for(auto tempMol = _particleContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); tempMol.isValid(); ++tempMol){
-				unsigned cid=tempMol->componentid();
-
-				for (unsigned i=0; i<numLJ[cid]; i++){
-					int loc=(tempMol->ljcenter_d_abs(i)[1]) * delta_inv;
-					if (loc < 0){
-						loc=loc+_slabs;
-					}
-					else if (loc > sint-1){
-						loc=loc-_slabs;
-					}
-					const int index = loc+_slabs*(i+numLJSum2[cid]);
-
-					#if defined(_OPENMP)
-					#pragma omp atomic
-					#endif
-					rho_l[index] += slabsPerV;
-				}
-				if (numDipole[cid] != 0){
-					int loc=tempMol->r(1) * delta_inv;
-					const int index = loc+_slabs*numDipoleSum2[cid];
-
-					#if defined(_OPENMP)
-					#pragma omp atomic
-					#endif
-					rhoDipoleL[index] += slabsPerV;
-				}
-			}
+			sampleDensityProfiles(rho_l, rhoDipoleL);
 		}
 		else{
 			for (unsigned i=0; i<_slabs*numLJSum; i++){
@@ -338,69 +283,10 @@ void Planar::calculateLongRange() {
 
 		_domainDecomposition->collCommFinalize();
 
-		for (unsigned ci = 0; ci < numComp; ++ci){
-			for (unsigned cj = 0; cj < numComp; ++cj){
-				ParaStrm& params = _domain->getComp2Params()(ci,cj);
-				params.reset_read();
-				for (unsigned si = 0; si < numLJ[ci]; ++si) { // Long Range Correction for Lennard-Jones sites
-					for (unsigned sj = 0; sj < numLJ[cj]; ++sj) {
-						double eps24;
-						double sig2;
-						double shift6;
-						double eps;
-						params >> eps24;
-						params >> sig2;
-						params >> shift6;
-						sig2=sqrt(sig2);
-						eps=eps24/24;
-						if (eLong[numLJSum2[ci]+si] ==0 && eLong[numLJSum2[cj]+sj] == 0){
-							centerCenter(sig2,eps,ci,cj,si,sj);
-						}
-						else if (eLong[numLJSum2[ci]+si] ==0 || eLong[numLJSum2[cj]+sj] == 0){
-							centerSite(sig2,eps,ci,cj,si,sj);
-						}
-						else{
-							siteSite(sig2,eps,ci,cj,si,sj);
-						}
-					}
-				}
-
-				for (unsigned si=0; si< numDipole[ci]; si++){	//Long Range Correction for Dipoles
-					for (unsigned sj=0; sj< numDipole[cj]; sj++){
-						 dipoleDipole(ci,cj,si,sj);
-					}
-				}
-			}
-	 	}
-
-		// Distribution of the Force, Energy and Virial to every Node
-		_domainDecomposition->collCommInit(_slabs*(4*numLJSum+4*numDipoleSum));
-		for (unsigned i=0; i<_slabs*numLJSum; i++){
-			_domainDecomposition->collCommAppendDouble(uLJ[i]);
-			_domainDecomposition->collCommAppendDouble(vNLJ[i]);
-			_domainDecomposition->collCommAppendDouble(vTLJ[i]);
-			_domainDecomposition->collCommAppendDouble(fLJ[i]);
-		}
-		for (unsigned i=0; i<_slabs*numDipoleSum; i++){
-			_domainDecomposition->collCommAppendDouble(uDipole[i]);
-			_domainDecomposition->collCommAppendDouble(fDipole[i]);
-			_domainDecomposition->collCommAppendDouble(vNDipole[i]);
-			_domainDecomposition->collCommAppendDouble(vTDipole[i]);
-		}
-		_domainDecomposition->collCommAllreduceSum();
-		for (unsigned i=0; i<_slabs*numLJSum; i++){
-			uLJ[i]=_domainDecomposition->collCommGetDouble();
-			vNLJ[i]=_domainDecomposition->collCommGetDouble();
-			vTLJ[i]=_domainDecomposition->collCommGetDouble();
-			fLJ[i]=_domainDecomposition->collCommGetDouble();
-		}
-		for (unsigned i=0; i<_slabs*numDipoleSum; i++){
-		      uDipole[i]=_domainDecomposition->collCommGetDouble();
-		      fDipole[i]=_domainDecomposition->collCommGetDouble();
-		      vNDipole[i]=_domainDecomposition->collCommGetDouble();
-		      vTDipole[i]=_domainDecomposition->collCommGetDouble();
-		}
-		_domainDecomposition->collCommFinalize();
+		// Force, energy and virial profiles: periodic convolutions of the density profiles with the slab kernels.
+		// Every rank knows the full density profile, so no further communication is needed.
+		convolveProfiles(rho_l, numLJSum, _ljKernels, _ljKernelIndex, uLJ, vNLJ, vTLJ, fLJ);
+		convolveProfiles(rhoDipoleL, numDipoleSum, _dipoleKernels, _dipoleKernelIndex, uDipole, vNDipole, vTDipole, fDipole);
 	}
 
 	// Adding the Force to the Molecules; this is done in every timestep
@@ -421,7 +307,7 @@ void Planar::calculateLongRange() {
 		unsigned cid = tempMol->componentid();
 
 		for (unsigned i=0; i<numLJ[cid]; i++){
-			int loc=(tempMol->ljcenter_d_abs(i)[1]) * delta_inv;
+			int loc=(tempMol->ljcenter_d_abs(i)[_axis]) * delta_inv;
 			if (loc < 0){
 				loc=loc+_slabs;
 			}
@@ -430,31 +316,27 @@ void Planar::calculateLongRange() {
 			}
 			double Fa[3]={0.0, 0.0, 0.0};
 			const int index = loc + i * _slabs + _slabs * numLJSum2[cid];
-			Fa[1] = fLJ[index];
+			Fa[_axis] = fLJ[index];
 			Upot_c += uLJ[index];
 			Virial_c += 2 * vTLJ[index] + vNLJ[index];
-			double Via[3] = {0.0, 0.0, 0.0};
-			Via[0] = vTLJ[index];
-			Via[1] = vNLJ[index];
-			Via[2] = vTLJ[index];
-			if ((tempMol->r(1) >= _region.actPos[0]) && (tempMol->r(1) <= _region.actPos[1])) {
+			double Via[3] = {vTLJ[index], vTLJ[index], vTLJ[index]};
+			Via[_axis] = vNLJ[index];
+			if ((tempMol->r(_axis) >= _region.actPos[0]) && (tempMol->r(_axis) <= _region.actPos[1])) {
 				tempMol->Fljcenteradd(i, Fa);
 			}
 			tempMol->Viadd(Via);
 //			tempMol->Uadd(uLJ[loc+i*s+_slabs*numLJSum2[cid]]);      // Storing potential energy onto the molecules is currently not implemented!
 		}
 		if (numDipole[cid] != 0){
-			int loc = tempMol->r(1) * delta_inv;
+			int loc = tempMol->r(_axis) * delta_inv;
 			double Fa[3] = {0.0, 0.0, 0.0};
 			const int index = loc + _slabs * numDipoleSum2[cid];
-			Fa[1] = fDipole[index];
+			Fa[_axis] = fDipole[index];
 			Upot_c += uDipole[index];
 			Virial_c += 2 * vTDipole[index] + vNDipole[index];
-			double Via[3] = {0.0, 0.0, 0.0};
-			Via[0] = vTDipole[index];
-			Via[1] = vNDipole[index];
-			Via[2] = vTDipole[index];
-			if ((tempMol->r(1) >= _region.actPos[0]) && (tempMol->r(1) <= _region.actPos[1])) {
+			double Via[3] = {vTDipole[index], vTDipole[index], vTDipole[index]};
+			Via[_axis] = vNDipole[index];
+			if ((tempMol->r(_axis) >= _region.actPos[0]) && (tempMol->r(_axis) <= _region.actPos[1])) {
 				tempMol->Fadd(Fa); // Force is stored on the center of mass of the molecule!
 			}
 			tempMol->Viadd(Via);
@@ -478,122 +360,247 @@ void Planar::calculateLongRange() {
 	simstep++;
 }
 
+void Planar::sampleDensityProfiles(std::vector<double>& rhoLJ, std::vector<double>& rhoDip) {
+	const double delta_inv = 1.0 / delta;
+	const double slabsPerV = _slabs / V;
+	const unsigned numLJBins = _slabs * numLJSum;
 
-void Planar::centerCenter(double sig, double eps,unsigned ci,unsigned cj,unsigned si, unsigned sj){
-	double rc=sig/cutoff;
-	double rc2=rc*rc;
-	const double rc2_inv = 1.0 / rc2;
-	double rc6=rc2*rc2*rc2;
-	double rc12=rc6*rc6;
-	double r,r2,r6,r12;
-	double rhoI,rhoJ;
-	double termU = 4*3.1416*delta*eps*sig*sig;
-	double termF = 8*3.1416*delta*eps*sig;
-	double termVN = 4*3.1416*delta*eps*sig*sig;
-	double termVT = 2*3.1416*delta*eps*sig*sig;
-	const unsigned slabsHalf = _slabs / 2;
-	for (unsigned i=_domainDecomposition->getRank(); i<slabsHalf; i+=_domainDecomposition->getNumProcs()){
-		const int index_i = i+si*_slabs+_slabs*numLJSum2[ci];
-
-		rhoI=rho_l[index_i];
-		vTLJ[index_i] += termVT*rhoI*(6*rc12*0.2-3*rc6*0.5)*rc2_inv;
-		uLJ[index_i] += termU*rhoI*(rc12*0.2-rc6*0.5)*rc2_inv;
-		for (unsigned j=i+1; j<i+slabsHalf; j++){
-			const int index_j = j+sj*_slabs+_slabs*numLJSum2[cj];
-
-			r=sig/((j-i)*delta);
-			rhoJ=rho_l[index_j];
-			if (j> i+cutoff_slabs){
-				r2=r*r;
-				r6=r2*r2*r2;
-				r12=r6*r6;
-				vTLJ[index_i]+=termVT*rhoJ*(r12*0.2-r6*0.5)/r2;
-				vTLJ[index_j]+=termVT*rhoI*(r12*0.2-r6*0.5)/r2;
+	_rhoHistogram.clear();
+	#if defined(_OPENMP)
+	#pragma omp parallel
+	#endif
+	{
+		std::vector<double>& histogram = _rhoHistogram.threadBuffer();
+
+		for(auto tempMol = _particleContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); tempMol.isValid(); ++tempMol){
+			unsigned cid=tempMol->componentid();
+
+			for (unsigned i=0; i<numLJ[cid]; i++){
+				int loc=(tempMol->ljcenter_d_abs(i)[_axis]) * delta_inv;
+				if (loc < 0){
+					loc=loc+_slabs;
+				}
+				else if (loc > sint-1){
+					loc=loc-_slabs;
+				}
+				histogram[loc + _slabs * (i + numLJSum2[cid])] += slabsPerV;
 			}
-			else{
-				r2=rc2;
-				r6=rc6;
-				r12=rc12;
-				vTLJ[index_j]+=termVT*rhoI*(r12*0.2*(6/r2-5/(r*r))-r6*0.5*(3/r2-2/(r*r)));
-				vTLJ[index_i]+=termVT*rhoJ*(r12*0.2*(6/r2-5/(r*r))-r6*0.5*(3/r2-2/(r*r)));
+			if (numDipole[cid] != 0){
+				int loc=tempMol->r(_axis) * delta_inv;
+				histogram[numLJBins + loc + _slabs * numDipoleSum2[cid]] += slabsPerV;
 			}
-			uLJ[index_i] += termU*rhoJ*(r12*0.2-r6*0.5)/r2;
-			uLJ[index_j] += termU*rhoI*(r12*0.2-r6*0.5)/r2;
-			vNLJ[index_i] += termVN*rhoJ*(r12-r6)/(r*r);
-			vNLJ[index_j] += termVN*rhoI*(r12-r6)/(r*r);
-			fLJ[index_i] += -termF*rhoJ*(r12-r6)/r;
-			fLJ[index_j] += termF*rhoI*(r12-r6)/r;
 		}
-		// Calculation of the Periodic boundary
-		for (unsigned j=slabsHalf+i; j<_slabs; j++){
-			const int index_j = j+sj*_slabs+_slabs*numLJSum2[cj];
-
-			r=sig/((_slabs-j+i)*delta);
-			rhoJ=rho_l[index_j];
-			if (j <_slabs-cutoff_slabs+i){
-				r2=r*r;
-				r6=r2*r2*r2;
-				r12=r6*r6;
-				vTLJ[index_i] += termVT*rhoJ*(r12*0.2-r6*0.5)/r2;
-				vTLJ[index_j] += termVT*rhoI*(r12*0.2-r6*0.5)/r2;
-			}
-			else{
-				r2=rc2;
-				r6=rc6;
-				r12=rc12;
-				vTLJ[index_j] += termVT*rhoI*(r12*0.2*(6/r2-5/(r*r))-r6*0.5*(3/r2-2/(r*r)));
-				vTLJ[index_i] += termVT*rhoJ*(r12*0.2*(6/r2-5/(r*r))-r6*0.5*(3/r2-2/(r*r)));
+	}
+	_rhoHistogram.addTo(rhoLJ.data(), 0, numLJBins);
+	_rhoHistogram.addTo(rhoDip.data(), numLJBins, _slabs * numDipoleSum);
+}
+
+void Planar::convolveProfiles(const std::vector<double>& rho, unsigned numSites, const std::vector<SlabKernel>& kernels,
+		const std::vector<unsigned>& kernelIndex, std::vector<double>& u, std::vector<double>& vN, std::vector<double>& vT,
+		std::vector<double>& f) {
+	if (numSites == 0) {
+		return;
+	}
+
+	std::vector<PeriodicConvolution::Spectrum> rhoSpectra(numSites);
+	#if defined(_OPENMP)
+	#pragma omp parallel for
+	#endif
+	for (int site = 0; site < static_cast<int>(numSites); ++site) {
+		_convolution.transformSignal(&rho[site * _slabs], rhoSpectra[site]);
+	}
+
+	// The profiles of site a are the sum over all sites b of the kernel (a,b) applied to the density of b.
+	// Summing up in spectral space requires only one back transformation per site and quantity.
+	#if defined(_OPENMP)
+	#pragma omp parallel
+	#endif
+	{
+		PeriodicConvolution::Spectrum accU, accVN, accVT, accF;
+
+		#if defined(_OPENMP)
+		#pragma omp for schedule(dynamic)
+		#endif
+		for (int siteA = 0; siteA < static_cast<int>(numSites); ++siteA) {
+			_convolution.clearSpectrum(accU);
+			_convolution.clearSpectrum(accVN);
+			_convolution.clearSpectrum(accVT);
+			_convolution.clearSpectrum(accF);
+
+			const unsigned offsetA = siteA * _slabs;
+			for (unsigned siteB = 0; siteB < numSites; ++siteB) {
+				const SlabKernel& kernel = kernels[kernelIndex[siteA * numSites + siteB]];
+				PeriodicConvolution::multiplyAdd(kernel.u, rhoSpectra[siteB], accU);
+				PeriodicConvolution::multiplyAdd(kernel.vN, rhoSpectra[siteB], accVN);
+				PeriodicConvolution::multiplyAdd(kernel.vT, rhoSpectra[siteB], accVT);
+				PeriodicConvolution::multiplyAdd(kernel.f, rhoSpectra[siteB], accF);
+
+				// interaction within the same slab
+				const unsigned offsetB = siteB * _slabs;
+				for (unsigned i = 0; i < _slabs; i++) {
+					u[offsetA + i] += kernel.uSelf * rho[offsetB + i];
+					vT[offsetA + i] += kernel.vTSelf * rho[offsetB + i];
+				}
 			}
-			uLJ[index_i] += termU*rhoJ*(r12*0.2-r6*0.5)/r2;
-			uLJ[index_j] += termU*rhoI*(r12*0.2-r6*0.5)/r2;
-			vNLJ[index_i] += termVN*rhoJ*(r12-r6)/(r*r);
-			vNLJ[index_j] += termVN*rhoI*(r12-r6)/(r*r);
-			fLJ[index_i] += termF*rhoJ*(r12-r6)/r;
-			fLJ[index_j] += -termF*rhoI*(r12-r6)/r;
+
+			_convolution.backTransformAdd(accU, &u[offsetA]);
+			_convolution.backTransformAdd(accVN, &vN[offsetA]);
+			_convolution.backTransformAdd(accVT, &vT[offsetA]);
+			_convolution.backTransformAdd(accF, &f[offsetA]);
 		}
 	}
+}
+
+void Planar::initSlabKernels() {
+	_convolution.init(_slabs);
+
+	std::vector<Component>& components = *_simulation.getEnsemble()->getComponents();
+
+	// Kernels only depend on the interaction parameters, so identical site pairs share one kernel.
+	// key: {kind of interaction, sigma, epsilon, smaller elongation, larger elongation}
+	std::map<std::array<double, 5>, unsigned> ljKernelIds;
+	_ljKernels.clear();
+	_ljKernelIndex.assign(numLJSum * numLJSum, 0);
+	for (unsigned ci = 0; ci < numComp; ++ci){
+		for (unsigned cj = 0; cj < numComp; ++cj){
+			ParaStrm& params = _domain->getComp2Params()(ci,cj);
+			params.reset_read();
+			for (unsigned si = 0; si < numLJ[ci]; ++si) { // Long Range Correction for Lennard-Jones sites
+				for (unsigned sj = 0; sj < numLJ[cj]; ++sj) {
+					double eps24;
+					double sig2;
+					double shift6;
+					double eps;
+					params >> eps24;
+					params >> sig2;
+					params >> shift6;
+					sig2=sqrt(sig2);
+					eps=eps24/24;
+
+					const double tI = eLong[numLJSum2[ci]+si];
+					const double tJ = eLong[numLJSum2[cj]+sj];
+					double kind = 2.;
+					if (tI == 0 && tJ == 0){
+						kind = 0.;
+					}
+					else if (tI == 0 || tJ == 0){
+						kind = 1.;
+					}
+					const std::array<double, 5> key = {kind, sig2, eps, std::min(tI, tJ), std::max(tI, tJ)};
 
-	// Calculation of the Forces on the slabs of the right hand side
-	for (unsigned i=slabsHalf+_domainDecomposition->getRank(); i<_slabs; i+=_domainDecomposition->getNumProcs()){
-		const int index_i = i+si*_slabs+_slabs*numLJSum2[ci];
-		const int index_i_cj = i+si*_slabs+_slabs*numLJSum2[cj]; // TODO: check - this is really supposed to be a mix of the i and j variables?
-
-		rhoI=rho_l[index_i];
-		vTLJ[index_i_cj] += termVT*rhoI*(6*rc12*0.2-3*rc6*0.5)*rc2_inv;
-		uLJ[index_i_cj] += termU*rhoI*(rc12*0.2-rc6*0.5)*rc2_inv;
-		for (unsigned j=i+1; j<_slabs; j++) {
-			const int index_j = j+sj*_slabs+_slabs*numLJSum2[cj];
-
-			r=sig/((j-i)*delta);
-			rhoJ=rho_l[index_j];
-			if (j> i+cutoff_slabs){
-				r2=r*r;
-				r6=r2*r2*r2;
-				r12=r6*r6;
-				vTLJ[index_i] += termVT*rhoJ*(r12*0.2-r6*0.5)/r2;
-				vTLJ[index_j] += termVT*rhoI*(r12*0.2-r6*0.5)/r2;
+					auto kernelId = ljKernelIds.find(key);
+					if (kernelId == ljKernelIds.end()) {
+						_ljKernels.emplace_back();
+						if (kind == 0.){
+							centerCenter(sig2,eps,_ljKernels.back());
+						}
+						else if (kind == 1.){
+							centerSite(sig2,eps,tI+tJ,_ljKernels.back());
+						}
+						else{
+							siteSite(sig2,eps,tI,tJ,_ljKernels.back());
+						}
+						kernelId = ljKernelIds.emplace(key, _ljKernels.size() - 1).first;
+					}
+					_ljKernelIndex[(numLJSum2[ci]+si) * numLJSum + numLJSum2[cj]+sj] = kernelId->second;
+				}
 			}
-			else{
-				r2=rc2;
-				r6=rc6;
-				r12=rc12;
-				vTLJ[index_j] += termVT*rhoI*(r12*0.2*(6/r2-5/(r*r))-r6*0.5*(3/r2-2/(r*r)));
-				vTLJ[index_i] += termVT*rhoJ*(r12*0.2*(6/r2-5/(r*r))-r6*0.5*(3/r2-2/(r*r)));
+		}
+	}
+
+	std::map<double, unsigned> dipoleKernelIds;
+	_dipoleKernels.clear();
+	_dipoleKernelIndex.assign(numDipoleSum * numDipoleSum, 0);
+	for (unsigned ci = 0; ci < numComp; ++ci){
+		for (unsigned cj = 0; cj < numComp; ++cj){
+			for (unsigned si=0; si< numDipole[ci]; si++){	//Long Range Correction for Dipoles
+				for (unsigned sj=0; sj< numDipole[cj]; sj++){
+					const double muSquareProduct = muSquare[numDipoleSum2[ci]+si] * muSquare[numDipoleSum2[cj]+sj];
+					auto kernelId = dipoleKernelIds.find(muSquareProduct);
+					if (kernelId == dipoleKernelIds.end()) {
+						_dipoleKernels.emplace_back();
+						dipoleDipole(muSquareProduct, _dipoleKernels.back());
+						kernelId = dipoleKernelIds.emplace(muSquareProduct, _dipoleKernels.size() - 1).first;
+					}
+					_dipoleKernelIndex[(numDipoleSum2[ci]+si) * numDipoleSum + numDipoleSum2[cj]+sj] = kernelId->second;
+				}
 			}
-			uLJ[index_i] += termU*rhoJ*(r12*0.2-r6*0.5)/r2;
-			uLJ[index_j] += termU*rhoI*(r12*0.2-r6*0.5)/r2;
-			vNLJ[index_i] += termVN*rhoJ*(r12-r6)/(r*r);
-			vNLJ[index_j] += termVN*rhoI*(r12-r6)/(r*r);
-			fLJ[index_i] += -termF*rhoJ*(r12-r6)/r;
-			fLJ[index_j] += termF*rhoI*(r12-r6)/r;
 		}
 	}
+
+	Log::global_log->info() << "Long Range Correction: precomputed " << _ljKernels.size() << " LJ and "
+							<< _dipoleKernels.size() << " dipole slab kernels." << std::endl;
 }
 
-void Planar::centerSite(double sig, double eps,unsigned ci,unsigned cj,unsigned si, unsigned sj){
+template<typename DistanceTerms>
+void Planar::buildSlabKernel(DistanceTerms terms, SlabKernel& kernel) const {
+	std::vector<double> kernelU(_slabs, 0.0);
+	std::vector<double> kernelVN(_slabs, 0.0);
+	std::vector<double> kernelVT(_slabs, 0.0);
+	std::vector<double> kernelF(_slabs, 0.0);
+
+	for (unsigned offset = 1; offset < _slabs; ++offset) {
+		// minimum image distance in slabs; slabs beyond half the box are reached across the periodic boundary
+		const unsigned distance = std::min(offset, _slabs - offset);
+		double u, vN, vT, f;
+		terms(distance, u, vN, vT, f);
+		kernelU[offset] = u;
+		kernelVN[offset] = vN;
+		kernelVT[offset] = vT;
+		// f is the force due to a slab in positive direction, it vanishes for slabs exactly half a box away
+		if (offset < _slabs - offset) {
+			kernelF[offset] = f;
+		}
+		else if (offset > _slabs - offset) {
+			kernelF[offset] = -f;
+		}
+	}
+
+	_convolution.transformKernel(kernelU.data(), kernel.u);
+	_convolution.transformKernel(kernelVN.data(), kernel.vN);
+	_convolution.transformKernel(kernelVT.data(), kernel.vT);
+	_convolution.transformKernel(kernelF.data(), kernel.f);
+}
+
+void Planar::centerCenter(double sig, double eps, SlabKernel& kernel) const {
+	double rc=sig/cutoff;
+	double rc2=rc*rc;
+	const double rc2_inv = 1.0 / rc2;
+	double rc6=rc2*rc2*rc2;
+	double rc12=rc6*rc6;
+	double termU = 4*3.1416*delta*eps*sig*sig;
+	double termF = 8*3.1416*delta*eps*sig;
+	double termVN = 4*3.1416*delta*eps*sig*sig;
+	double termVT = 2*3.1416*delta*eps*sig*sig;
+
+	kernel.vTSelf = termVT*(6*rc12*0.2-3*rc6*0.5)*rc2_inv;
+	kernel.uSelf = termU*(rc12*0.2-rc6*0.5)*rc2_inv;
+
+	buildSlabKernel([&](unsigned d, double& u, double& vN, double& vT, double& f) {
+		double r=sig/(d*delta);
+		double r2,r6,r12;
+		if (d > cutoff_slabs){
+			r2=r*r;
+			r6=r2*r2*r2;
+			r12=r6*r6;
+			vT=termVT*(r12*0.2-r6*0.5)/r2;
+		}
+		else{
+			r2=rc2;
+			r6=rc6;
+			r12=rc12;
+			vT=termVT*(r12*0.2*(6/r2-5/(r*r))-r6*0.5*(3/r2-2/(r*r)));
+		}
+		u = termU*(r12*0.2-r6*0.5)/r2;
+		vN = termVN*(r12-r6)/(r*r);
+		f = -termF*(r12-r6)/r;
+	}, kernel);
+}
+
+void Planar::centerSite(double sig, double eps, double t, SlabKernel& kernel) const {
 	double sig2=sig*sig;
 	double sig3=sig2*sig;
-	double t = eLong[numLJSum2[ci]+si] + eLong[numLJSum2[cj]+sj]; // one of them is equal to zero.
+	// t: one of the two elongations is equal to zero.
 	double rcPt=sig/(cutoff+t);
 	double rcPt3=rcPt*rcPt*rcPt;
 	double rcPt4=rcPt3*rcPt;
@@ -611,164 +618,46 @@ void Planar::centerSite(double sig, double eps,unsigned ci,unsigned cj,unsigned
 	double termVNRC=termFRC/2;
 	double termVTRC1=-3.1416*eps*delta*sig2/(2*t*rc)*((rcPt10-rcMt10)/5-(rcPt4-rcMt4)/2);
 	double termVTRC2=termURC/2;
-	double r,r2;
-	double rhoI,rhoJ;
-	for (unsigned i=_domainDecomposition->getRank(); i<_slabs/2; i+=_domainDecomposition->getNumProcs()){
-		const int index_i = i+si*_slabs+_slabs*numLJSum2[ci];
-
-		rhoI=rho_l[index_i];
-
-		const int index_i_sj_cj = i+sj*_slabs+_slabs*numLJSum2[cj];
-		rhoJ=rho_l[index_i_sj_cj]; // TODO: i, sj, cj? appears a few more times in other functions
-
-		vTLJ[index_i]+=rhoJ*(termVTRC1*rc2+termVTRC2);
-		uLJ[index_i]+=rhoJ*termURC;
-		for (unsigned j=i+1; j<i+_slabs/2; j++){
-			const int index_j = j+sj*_slabs+_slabs*numLJSum2[cj];
-
-			r=(j-i)*delta; // xi in Werth2014
-			r2=r*r;
-			rhoJ=rho_l[index_j];
-			if (j> i+cutoff_slabs){
-				double rPt=sig/(r+t);
-				double rPt3=rPt*rPt*rPt;
-				double rPt4=rPt3*rPt;
-				double rPt9=rPt3*rPt3*rPt3;
-				double rPt10=rPt9*rPt;
-				double rMt=sig/(r-t);
-				double rMt3=rMt*rMt*rMt;
-				double rMt4=rMt3*rMt;
-				double rMt9=rMt3*rMt3*rMt3;
-				double rMt10=rMt9*rMt;
-				double termU=-2*3.1416*eps*delta*sig3/(3*t)*((rPt9-rMt9)/15-(rPt3-rMt3)/2);
-				double termF=-2*3.1416*eps*delta*sig2/(t*r)*((rPt10-rMt10)/5-(rPt4-rMt4)/2);
-				double termVN=termF/2;
-				double termVT2=termU/2;
-				uLJ[index_i]+=rhoJ*termU;
-				uLJ[index_j]+=rhoI*termU;
-				vNLJ[index_i]+=rhoJ*termVN*r2;
-				vNLJ[index_j]+=rhoI*termVN*r2;
-				vTLJ[index_j]+=rhoI*termVT2;
-				vTLJ[index_i]+=rhoJ*termVT2;
-				fLJ[index_i]+=-rhoJ*termF*r;
-				fLJ[index_j]+=rhoI*termF*r;
-			}
-			else{
-				uLJ[index_i]+=rhoJ*termURC;
-				uLJ[index_j]+=rhoI*termURC;
-				vNLJ[index_i]+=rhoJ*termVNRC*r2;
-				vNLJ[index_j]+=rhoI*termVNRC*r2;
-				vTLJ[index_j]+=rhoI*(termVTRC1*(rc2-r2)+termVTRC2);
-				vTLJ[index_i]+=rhoJ*(termVTRC1*(rc2-r2)+termVTRC2);
-				fLJ[index_i]+=-rhoJ*termFRC*r;
-				fLJ[index_j]+=rhoI*termFRC*r;
-			}
-		}
-		// Calculation of the Periodic boundary
-		for (unsigned j=_slabs/2+i; j<_slabs; j++) {
-			const int index_j = j+sj*_slabs+_slabs*numLJSum2[cj];
 
-			r=(_slabs-j+i)*delta;
-			r2=r*r;
-			rhoJ=rho_l[index_j];
-			if (j <_slabs-cutoff_slabs+i){
-				double rPt=sig/(r+t);
-				double rPt3=rPt*rPt*rPt;
-				double rPt4=rPt3*rPt;
-				double rPt9=rPt3*rPt3*rPt3;
-				double rPt10=rPt9*rPt;
-				double rMt=sig/(r-t);
-				double rMt3=rMt*rMt*rMt;
-				double rMt4=rMt3*rMt;
-				double rMt9=rMt3*rMt3*rMt3;
-				double rMt10=rMt9*rMt;
-				double termU=-2*3.1416*eps*delta*sig3/(3*t)*((rPt9-rMt9)/15-(rPt3-rMt3)/2);
-				double termF=-2*3.1416*eps*delta*sig2/(t*r)*((rPt10-rMt10)/5-(rPt4-rMt4)/2);
-				double termVN=termF/2;
-				double termVT2=termU/2;
-				uLJ[index_i]+=rhoJ*termU;
-				uLJ[index_j]+=rhoI*termU;
-				vNLJ[index_i]+=rhoJ*termVN*r2;
-				vNLJ[index_j]+=rhoI*termVN*r2;
-				vTLJ[index_i]+=rhoJ*termVT2;
-				vTLJ[index_j]+=rhoI*termVT2;
-				fLJ[index_i]+=rhoJ*termF*r;
-				fLJ[index_j]+=-rhoI*termF*r;
-			}
-			else{
-				uLJ[index_i]+=rhoJ*termURC;
-				uLJ[index_j]+=rhoI*termURC;
-				vNLJ[index_i]+=rhoJ*termVNRC*r2;
-				vNLJ[index_j]+=rhoI*termVNRC*r2;
-				vTLJ[index_i]+=rhoJ*(termVTRC1*(rc2-r2)+termVTRC2);
-				vTLJ[index_j]+=rhoI*(termVTRC1*(rc2-r2)+termVTRC2);
-				fLJ[index_i]+=rhoJ*termFRC*r;
-				fLJ[index_j]+=-rhoI*termFRC*r;
-			}
+	kernel.vTSelf = termVTRC1*rc2+termVTRC2;
+	kernel.uSelf = termURC;
+
+	buildSlabKernel([&](unsigned d, double& u, double& vN, double& vT, double& f) {
+		double r=d*delta; // xi in Werth2014
+		double r2=r*r;
+		if (d > cutoff_slabs){
+			double rPt=sig/(r+t);
+			double rPt3=rPt*rPt*rPt;
+			double rPt4=rPt3*rPt;
+			double rPt9=rPt3*rPt3*rPt3;
+			double rPt10=rPt9*rPt;
+			double rMt=sig/(r-t);
+			double rMt3=rMt*rMt*rMt;
+			double rMt4=rMt3*rMt;
+			double rMt9=rMt3*rMt3*rMt3;
+			double rMt10=rMt9*rMt;
+			double termU=-2*3.1416*eps*delta*sig3/(3*t)*((rPt9-rMt9)/15-(rPt3-rMt3)/2);
+			double termF=-2*3.1416*eps*delta*sig2/(t*r)*((rPt10-rMt10)/5-(rPt4-rMt4)/2);
+			double termVN=termF/2;
+			double termVT2=termU/2;
+			u=termU;
+			vN=termVN*r2;
+			vT=termVT2;
+			f=-termF*r;
 		}
-	}
-
-	// Calculation of the Forces on the slabs of the right hand side
-	for (unsigned i=_slabs/2+_domainDecomposition->getRank(); i<_slabs; i+=_domainDecomposition->getNumProcs()){
-		const int index_i = i+si*_slabs+_slabs*numLJSum2[ci];
-
-		rhoI=rho_l[index_i];
-
-		const int index_i_sj_cj = i+sj*_slabs+_slabs*numLJSum2[cj];
-		rhoJ=rho_l[index_i_sj_cj];
-
-		vTLJ[index_i]+=rhoJ*(termVTRC1*rc2+termVTRC2);
-		uLJ[index_i]+=rhoJ*termURC;
-		for (unsigned j=i+1; j<_slabs; j++){
-			const int index_j = j+sj*_slabs+_slabs*numLJSum2[cj];
-
-			r=(j-i)*delta;
-			r2=r*r;
-			rhoJ=rho_l[index_j];
-			if (j> i+cutoff_slabs){
-				double rPt=sig/(r+t);
-				double rPt3=rPt*rPt*rPt;
-				double rPt4=rPt3*rPt;
-				double rPt9=rPt3*rPt3*rPt3;
-				double rPt10=rPt9*rPt;
-				double rMt=sig/(r-t);
-				double rMt3=rMt*rMt*rMt;
-				double rMt4=rMt3*rMt;
-				double rMt9=rMt3*rMt3*rMt3;
-				double rMt10=rMt9*rMt;
-				double termU=-2*3.1416*eps*delta*sig3/(3*t)*((rPt9-rMt9)/15-(rPt3-rMt3)/2);
-				double termF=-2*3.1416*eps*delta*sig2/(t*r)*((rPt10-rMt10)/5-(rPt4-rMt4)/2);
-				double termVN=termF/2;
-				double termVT2=termU/2;
-				uLJ[index_i]+=rhoJ*termU;
-				uLJ[index_j]+=rhoI*termU;
-				vNLJ[index_i]+=rhoJ*termVN*r2;
-				vNLJ[index_j]+=rhoI*termVN*r2;
-				vTLJ[index_j]+=rhoI*termVT2;
-				vTLJ[index_i]+=rhoJ*termVT2;
-				fLJ[index_i]+=-rhoJ*termF*r;
-				fLJ[index_j]+=rhoI*termF*r;
-			}
-			else{
-				uLJ[index_i]+=rhoJ*termURC;
-				uLJ[index_j]+=rhoI*termURC;
-				vNLJ[index_i]+=rhoJ*termVNRC*r2;
-				vNLJ[index_j]+=rhoI*termVNRC*r2;
-				vTLJ[index_j]+=rhoI*(termVTRC1*(rc2-r2)+termVTRC2);
-				vTLJ[index_i]+=rhoJ*(termVTRC1*(rc2-r2)+termVTRC2);
-				fLJ[index_i]+=-rhoJ*termFRC*r;
-				fLJ[index_j]+=rhoI*termFRC*r;
-			}
+		else{
+			u=termURC;
+			vN=termVNRC*r2;
+			vT=termVTRC1*(rc2-r2)+termVTRC2;
+			f=-termFRC*r;
 		}
-	}
+	}, kernel);
 }
 
-void Planar::siteSite(double sig, double eps,unsigned ci,unsigned cj,unsigned si, unsigned sj){
+void Planar::siteSite(double sig, double eps, double t1, double t2, SlabKernel& kernel) const {
 	double sig2=sig*sig;
 	double sig3=sig2*sig;
 	double sig4=sig2*sig2;
-	double t1 = eLong[numLJSum2[ci]+si];
-	double t2 = eLong[numLJSum2[cj]+sj];
 	double tP = t1 + t2; // tau+
 	double tM = t1 - t2; // tau-
 	double rcPtP=sig/(cutoff+tP);
@@ -798,293 +687,90 @@ void Planar::siteSite(double sig, double eps,unsigned ci,unsigned cj,unsigned si
 	double termVNRC=termFRC/2;
 	double termVTRC1=3.1416*eps*delta*sig3/(4*t1*t2*rc)*((rcPtP9-rcPtM9-rcMtM9+rcMtP9)/45-(rcPtP3-rcPtM3-rcMtM3+rcMtP3)/6);
 	double termVTRC2=termURC/2;
-	double r,r2;
-	double rhoI,rhoJ;
-	for (unsigned i=_domainDecomposition->getRank(); i<_slabs/2; i+=_domainDecomposition->getNumProcs()) {
-		const int index_i = i+si*_slabs+_slabs*numLJSum2[ci];
-
-		rhoI=rho_l[index_i];
-
-		const int index_i_sj_cj = i+sj*_slabs+_slabs*numLJSum2[cj];
-		rhoJ=rho_l[index_i_sj_cj];
-
-		vTLJ[index_i]+=rhoJ*(termVTRC1*rc2+termVTRC2);
-		uLJ[index_i]+=rhoJ*termURC;
-		for (unsigned j=i+1; j<i+_slabs/2; j++){
-			const int index_j = j+sj*_slabs+_slabs*numLJSum2[cj];
-
-			r=(j-i)*delta;
-			r2=r*r;
-			rhoJ=rho_l[index_j];
-			if (j> i+cutoff_slabs){
-				double rPtP=sig/(r+tP);
-				double rPtP2=rPtP*rPtP;
-				double rPtP3=rPtP2*rPtP;
-				double rPtP8=rPtP2*rPtP3*rPtP3;
-				double rPtP9=rPtP8*rPtP;
-				double rPtM=sig/(r+tM);
-				double rPtM2=rPtM*rPtM;
-				double rPtM3=rPtM2*rPtM;
-				double rPtM8=rPtM2*rPtM3*rPtM3;
-				double rPtM9=rPtM8*rPtM;
-				double rMtP=sig/(r-tP);
-				double rMtP2=rMtP*rMtP;
-				double rMtP3=rMtP2*rMtP;
-				double rMtP8=rMtP2*rMtP3*rMtP3;
-				double rMtP9=rMtP8*rMtP;
-				double rMtM=sig/(r-tM);
-				double rMtM2=rMtM*rMtM;
-				double rMtM3=rMtM2*rMtM;
-				double rMtM8=rMtM2*rMtM3*rMtM3;
-				double rMtM9=rMtM8*rMtM;
-				double termU=3.1416*eps*delta*sig4/(12*t1*t2)*((rPtP8-rPtM8-rMtM8+rMtP8)/30-(rPtP2-rPtM2-rMtM2+rMtP2));
-				double termF=3.1416*eps*delta*sig3/(3*t1*t2*r)*((rPtP9-rPtM9-rMtM9+rMtP9)/15-(rPtP3-rPtM3-rMtM3+rMtP3)/2);
-				double termVN=termF/2;
-				double termVT2=termU/2;
-				uLJ[index_i]+=rhoJ*termU;
-				uLJ[index_j]+=rhoI*termU;
-				vNLJ[index_i]+=rhoJ*termVN*r2;
-				vNLJ[index_j]+=rhoI*termVN*r2;
-				vTLJ[index_j]+=rhoI*termVT2;
-				vTLJ[index_i]+=rhoJ*termVT2;
-				fLJ[index_i]+=-rhoJ*termF*r;
-				fLJ[index_j]+=rhoI*termF*r;
-			}
-			else{
-				uLJ[index_i]+=rhoJ*termURC;
-				uLJ[index_j]+=rhoI*termURC;
-				vNLJ[index_i]+=rhoJ*termVNRC*r2;
-				vNLJ[index_j]+=rhoI*termVNRC*r2;
-				vTLJ[index_j]+=rhoI*(termVTRC1*(rc2-r2)+termVTRC2);
-				vTLJ[index_i]+=rhoJ*(termVTRC1*(rc2-r2)+termVTRC2);
-				fLJ[index_i]+=-rhoJ*termFRC*r;
-				fLJ[index_j]+=rhoI*termFRC*r;
-			}
-		}
-		// Calculation of the Periodic boundary
-		for (unsigned j=_slabs/2+i; j<_slabs; j++) {
-			const int index_j = j+sj*_slabs+_slabs*numLJSum2[cj];
 
-			r=(_slabs-j+i)*delta;
-			r2=r*r;
-			rhoJ=rho_l[index_j];
-			if (j <_slabs-cutoff_slabs+i){
-				double rPtP=sig/(r+tP);
-				double rPtP2=rPtP*rPtP;
-				double rPtP3=rPtP2*rPtP;
-				double rPtP8=rPtP2*rPtP3*rPtP3;
-				double rPtP9=rPtP8*rPtP;
-				double rPtM=sig/(r+tM);
-				double rPtM2=rPtM*rPtM;
-				double rPtM3=rPtM2*rPtM;
-				double rPtM8=rPtM2*rPtM3*rPtM3;
-				double rPtM9=rPtM8*rPtM;
-				double rMtP=sig/(r-tP);
-				double rMtP2=rMtP*rMtP;
-				double rMtP3=rMtP2*rMtP;
-				double rMtP8=rMtP2*rMtP3*rMtP3;
-				double rMtP9=rMtP8*rMtP;
-				double rMtM=sig/(r-tM);
-				double rMtM2=rMtM*rMtM;
-				double rMtM3=rMtM2*rMtM;
-				double rMtM8=rMtM2*rMtM3*rMtM3;
-				double rMtM9=rMtM8*rMtM;
-				double termU=3.1416*eps*delta*sig4/(12*t1*t2)*((rPtP8-rPtM8-rMtM8+rMtP8)/30-(rPtP2-rPtM2-rMtM2+rMtP2));
-				double termF=3.1416*eps*delta*sig3/(3*t1*t2*r)*((rPtP9-rPtM9-rMtM9+rMtP9)/15-(rPtP3-rPtM3-rMtM3+rMtP3)/2);
-				double termVN=termF/2;
-				double termVT2=termU/2;
-				uLJ[index_i]+=rhoJ*termU;
-				uLJ[index_j]+=rhoI*termU;
-				vNLJ[index_i]+=rhoJ*termVN*r2;
-				vNLJ[index_j]+=rhoI*termVN*r2;
-				vTLJ[index_j]+=rhoI*termVT2;
-				vTLJ[index_i]+=rhoJ*termVT2;
-				fLJ[index_i]+=rhoJ*termF*r;
-				fLJ[index_j]+=-rhoI*termF*r;
-			}
-			else{
-				uLJ[index_i]+=rhoJ*termURC;
-				uLJ[index_j]+=rhoI*termURC;
-				vNLJ[index_i]+=rhoJ*termVNRC*r2;
-				vNLJ[index_j]+=rhoI*termVNRC*r2;
-				vTLJ[index_j]+=rhoI*(termVTRC1*(rc2-r2)+termVTRC2);
-				vTLJ[index_i]+=rhoJ*(termVTRC1*(rc2-r2)+termVTRC2);
-				fLJ[index_i]+=rhoJ*termFRC*r;
-				fLJ[index_j]+=-rhoI*termFRC*r;
-			}
+	kernel.vTSelf = termVTRC1*rc2+termVTRC2;
+	kernel.uSelf = termURC;
+
+	buildSlabKernel([&](unsigned d, double& u, double& vN, double& vT, double& f) {
+		double r=d*delta;
+		double r2=r*r;
+		if (d > cutoff_slabs){
+			double rPtP=sig/(r+tP);
+			double rPtP2=rPtP*rPtP;
+			double rPtP3=rPtP2*rPtP;
+			double rPtP8=rPtP2*rPtP3*rPtP3;
+			double rPtP9=rPtP8*rPtP;
+			double rPtM=sig/(r+tM);
+			double rPtM2=rPtM*rPtM;
+			double rPtM3=rPtM2*rPtM;
+			double rPtM8=rPtM2*rPtM3*rPtM3;
+			double rPtM9=rPtM8*rPtM;
+			double rMtP=sig/(r-tP);
+			double rMtP2=rMtP*rMtP;
+			double rMtP3=rMtP2*rMtP;
+			double rMtP8=rMtP2*rMtP3*rMtP3;
+			double rMtP9=rMtP8*rMtP;
+			double rMtM=sig/(r-tM);
+			double rMtM2=rMtM*rMtM;
+			double rMtM3=rMtM2*rMtM;
+			double rMtM8=rMtM2*rMtM3*rMtM3;
+			double rMtM9=rMtM8*rMtM;
+			double termU=3.1416*eps*delta*sig4/(12*t1*t2)*((rPtP8-rPtM8-rMtM8+rMtP8)/30-(rPtP2-rPtM2-rMtM2+rMtP2));
+			double termF=3.1416*eps*delta*sig3/(3*t1*t2*r)*((rPtP9-rPtM9-rMtM9+rMtP9)/15-(rPtP3-rPtM3-rMtM3+rMtP3)/2);
+			double termVN=termF/2;
+			double termVT2=termU/2;
+			u=termU;
+			vN=termVN*r2;
+			vT=termVT2;
+			f=-termF*r;
 		}
-	}
-
-	// Calculation of the Forces on the slabs of the right hand side
-	for (unsigned i=_slabs/2+_domainDecomposition->getRank(); i<_slabs; i+=_domainDecomposition->getNumProcs()) {
-		const int index_i = i+si*_slabs+_slabs*numLJSum2[ci];
-
-		rhoI=rho_l[index_i];
-
-		const int index_i_sj_cj = i+sj*_slabs+_slabs*numLJSum2[cj];
-		rhoJ=rho_l[index_i_sj_cj];
-
-		vTLJ[index_i]+=rhoJ*(termVTRC1*rc2+termVTRC2);
-		uLJ[index_i]+=rhoJ*termURC;
-		for (unsigned j=i+1; j<_slabs; j++){
-			const int index_j = j+sj*_slabs+_slabs*numLJSum2[cj];
-
-			r=(j-i)*delta;
-			r2=r*r;
-			rhoJ=rho_l[index_j];
-			if (j> i+cutoff_slabs){
-				double rPtP=sig/(r+tP);
-				double rPtP2=rPtP*rPtP;
-				double rPtP3=rPtP2*rPtP;
-				double rPtP8=rPtP2*rPtP3*rPtP3;
-				double rPtP9=rPtP8*rPtP;
-				double rPtM=sig/(r+tM);
-				double rPtM2=rPtM*rPtM;
-				double rPtM3=rPtM2*rPtM;
-				double rPtM8=rPtM2*rPtM3*rPtM3;
-				double rPtM9=rPtM8*rPtM;
-				double rMtP=sig/(r-tP);
-				double rMtP2=rMtP*rMtP;
-				double rMtP3=rMtP2*rMtP;
-				double rMtP8=rMtP2*rMtP3*rMtP3;
-				double rMtP9=rMtP8*rMtP;
-				double rMtM=sig/(r-tM);
-				double rMtM2=rMtM*rMtM;
-				double rMtM3=rMtM2*rMtM;
-				double rMtM8=rMtM2*rMtM3*rMtM3;
-				double rMtM9=rMtM8*rMtM;
-				double termU=3.1416*eps*delta*sig4/(12*t1*t2)*((rPtP8-rPtM8-rMtM8+rMtP8)/30-(rPtP2-rPtM2-rMtM2+rMtP2));
-				double termF=3.1416*eps*delta*sig3/(3*t1*t2*r)*((rPtP9-rPtM9-rMtM9+rMtP9)/15-(rPtP3-rPtM3-rMtM3+rMtP3)/2);
-				double termVN=termF/2;
-				double termVT2=termU/2;
-				uLJ[index_i]+=rhoJ*termU;
-				uLJ[index_j]+=rhoI*termU;
-				vNLJ[index_i]+=rhoJ*termVN*r2;
-				vNLJ[index_j]+=rhoI*termVN*r2;
-				vTLJ[index_j]+=rhoI*termVT2;
-				vTLJ[index_i]+=rhoJ*termVT2;
-				fLJ[index_i]+=-rhoJ*termF*r;
-				fLJ[index_j]+=rhoI*termF*r;
-			}
-			else{
-				uLJ[index_i]+=rhoJ*termURC;
-				uLJ[index_j]+=rhoI*termURC;
-				vNLJ[index_i]+=rhoJ*termVNRC*r2;
-				vNLJ[index_j]+=rhoI*termVNRC*r2;
-				vTLJ[index_j]+=rhoI*(termVTRC1*(rc2-r2)+termVTRC2);
-				vTLJ[index_i]+=rhoJ*(termVTRC1*(rc2-r2)+termVTRC2);
-				fLJ[index_i]+=-rhoJ*termFRC*r;
-				fLJ[index_j]+=rhoI*termFRC*r;
-			}
+		else{
+			u=termURC;
+			vN=termVNRC*r2;
+			vT=termVTRC1*(rc2-r2)+termVTRC2;
+			f=-termFRC*r;
 		}
-	}
+	}, kernel);
 }
 
-void Planar::dipoleDipole(unsigned ci,unsigned cj,unsigned si,unsigned sj){
+void Planar::dipoleDipole(double muSquareProduct, SlabKernel& kernel) const {
 	double rc=cutoff;
 	double rc2=rc*rc;
 	double rc4=rc2*rc2;
 	double rc6=rc4*rc2;
-	double termU = 3.1416/4*muSquare[ci]*muSquare[cj]*delta / (3*temp);
-	double termF = 3.1416 * muSquare[ci]*muSquare[cj]*delta / (3*temp);
-	double termVN= 3.1416/2*muSquare[ci]*muSquare[cj]*delta / (3*temp);
+	double termU = 3.1416/4*muSquareProduct*delta / (3*temp);
+	double termF = 3.1416 * muSquareProduct*delta / (3*temp);
+	double termVN= 3.1416/2*muSquareProduct*delta / (3*temp);
 	double termVT= termU;
-	for (unsigned i=_domainDecomposition->getRank(); i<_slabs/2; i+=_domainDecomposition->getNumProcs()){
-		const int index_i = i+si*_slabs+_slabs*numDipoleSum2[ci];
-
-		double rhoI = rhoDipoleL[index_i];
-		for (unsigned j=i+1; j<i+_slabs/2; j++){
-			const int index_j = j+sj*_slabs+_slabs*numDipoleSum2[cj];
-
-			double rhoJ = rhoDipoleL[index_j];
-			double r=(j-i)*delta;
-			double r2,r4,r6;
-			if (j> i+cutoff_slabs){
-			r2=r*r;
-			r4=r2*r2;
-			r6=r4*r2;
-			}
-			else{
-			  r2=rc2;
-			  r4=rc4;
-			  r6=rc6;
-			}
-			fDipole[index_i] += termF*rhoJ/r6 * r;
-			fDipole[index_j] -= termF*rhoI/r6 * r;
-			uDipole[index_i] -= termU*rhoJ/r4;
-			uDipole[index_j] -= termU*rhoI/r4;
-			vNDipole[index_i]-= termVN*rhoJ/r6 *r*r;
-			vNDipole[index_j]-= termVN*rhoI/r6 *r*r;
-			vTDipole[index_i]-= termVT*rhoJ/r6 *(1.5*r2 - r*r);
-			vTDipole[index_j]-= termVT*rhoI/r6 *(1.5*r2 - r*r);
-
-		}
-		// Calculation of the Periodic boundary
-		for (unsigned j=_slabs/2+i; j<_slabs; j++){
-			const int index_j = j+sj*_slabs+_slabs*numDipoleSum2[cj];
-
-			double rhoJ = rhoDipoleL[index_j];
-			double r=(_slabs-j+i)*delta;
-			double r2,r4,r6;
-			if (j <_slabs-cutoff_slabs+i){
-			r2=r*r;
-			r4=r2*r2;
-			r6=r4*r2;
-			}
-			else{
-			  r2=rc2;
-			  r4=rc4;
-			  r6=rc6;
-			}
-			fDipole[index_i] -= termF*rhoJ/r6 * r;
-			fDipole[index_j] += termF*rhoI/r6 * r;
-			uDipole[index_i] -= termU*rhoJ/r4;
-			uDipole[index_j] -= termU*rhoI/r4;
-			vNDipole[index_i]-= termVN*rhoJ/r6 *r*r;
-			vNDipole[index_j]-= termVN*rhoI/r6 *r*r;
-			vTDipole[index_i]-= termVT*rhoJ/r6 *(1.5*r2 - r*r);
-			vTDipole[index_j]-= termVT*rhoI/r6 *(1.5*r2 - r*r);
-		}
-	}
-
-	// Calculation of the Forces on the slabs of the right hand side
-	for (unsigned i=_slabs/2+_domainDecomposition->getRank(); i<_slabs; i+=_domainDecomposition->getNumProcs()) {
-		const int index_i = i+si*_slabs+_slabs*numDipoleSum2[ci];
 
-		double rhoI = rhoDipoleL[index_i];
-		for (unsigned j=i+1; j<_slabs; j++){
-			const int index_j = j+sj*_slabs+_slabs*numDipoleSum2[cj];
+	kernel.vTSelf = 0.0;
+	kernel.uSelf = 0.0;
 
-			double rhoJ = rhoDipoleL[index_j];
-			double r=(j-i)*delta;
-			double r2,r4,r6;
-			if (j> i+cutoff_slabs){
+	buildSlabKernel([&](unsigned d, double& u, double& vN, double& vT, double& f) {
+		double r=d*delta;
+		double r2,r4,r6;
+		if (d > cutoff_slabs){
 			r2=r*r;
 			r4=r2*r2;
 			r6=r4*r2;
-			}
-			else{
-			  r2=rc2;
-			  r4=rc4;
-			  r6=rc6;
-			}
-			fDipole[index_i] += termF*rhoJ/r6 * r;
-			fDipole[index_j] -= termF*rhoI/r6 * r;
-			uDipole[index_i] -= termU*rhoJ/r4;
-			uDipole[index_j] -= termU*rhoI/r4;
-			vNDipole[index_i]-= termVN*rhoJ/r6 *r*r;
-			vNDipole[index_j]-= termVN*rhoI/r6 *r*r;
-			vTDipole[index_i]-= termVT*rhoJ/r6 *(1.5*r2 - r*r);
-			vTDipole[index_j]-= termVT*rhoI/r6 *(1.5*r2 - r*r);
 		}
-	}
+		else{
+			r2=rc2;
+			r4=rc4;
+			r6=rc6;
+		}
+		f = termF/r6 * r;
+		u = -termU/r4;
+		vN = -termVN/r6 *r*r;
+		vT = -termVT/r6 *(1.5*r2 - r*r);
+	}, kernel);
 }
 
 double Planar::lrcLJ(Molecule* mol){
 	double potentialEnergy = 0.;
 	unsigned cid=mol->componentid();
 	for (unsigned i=0; i<numLJ[cid]; i++){
-		int loc=(mol->r(1)+mol->ljcenter_d(i)[1])/delta;
+		int loc=(mol->r(_axis)+mol->ljcenter_d(i)[_axis])/delta;
 		if (loc < 0){
 			loc=loc+_slabs;
 		}
@@ -1094,7 +780,7 @@ double Planar::lrcLJ(Molecule* mol){
 		potentialEnergy += uLJ[loc+i*_slabs+_slabs*numLJSum2[cid]];
 	}
 	for (unsigned i=0;i<numDipole[cid]; i++){
-		int loc=(mol->r(1)+mol->dipole_d(i)[1])/delta;
+		int loc=(mol->r(_axis)+mol->dipole_d(i)[_axis])/delta;
 		if (loc < 0){
 			loc=loc+_slabs;
 		}
@@ -1127,7 +813,7 @@ void Planar::writeProfiles(DomainDecompBase* domainDecomp, Domain* domain, unsig
 #endif
 
 	std::stringstream outputstream;
-	double lengthPerSlab = _domain->getGlobalLength(1)/_slabs;
+	double lengthPerSlab = _domain->getGlobalLength(_axis)/_slabs;
 
 	// header
 	outputstream << "                     pos";
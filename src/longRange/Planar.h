@@ -2,6 +2,8 @@
 #define PLANAR_H_
 
 #include "LongRangeCorrection.h"
+#include "PeriodicConvolution.h"
+#include "ThreadLocalHistogram.h"
 
 #include "utils/ObserverBase.h"
 #include "utils/Region.h"
@@ -23,6 +25,9 @@ class ParticleContainer;
  *
  * Calculation of the surface tension in a system with planar interfaces needs a Long Range Correction.
  * The correction terms computed by this class are based on Janecek (2006) and Lustig (1988).
+ *
+ * The slab-slab interactions only depend on the distance of the slabs, therefore the force, energy and virial profiles
+ * are periodic convolutions of the density profiles with kernels, which are precomputed once in init() and applied by FFT.
  */
 class Planar : public LongRangeCorrection, public ObserverBase, public ControlInstance {
 public:
@@ -39,7 +44,8 @@ public:
 	 * The following XML object structure is handled by this method:
 	 * \code{.xml}
 		<longrange type="planar">
-			<region> <!-- y coordinates of left and right boundaries within correction of force is applied to particles; pot. energy and virial correction is always applied since it is necessary for the correct calculation of the state values -->
+			<direction>INT</direction> <!-- direction normal to the interfaces: 0: x | 1: y (default) | 2: z -->
+			<region> <!-- coordinates (along direction) of left and right boundaries within correction of force is applied to particles; pot. energy and virial correction is always applied since it is necessary for the correct calculation of the state values -->
 				<left refcoordsID="INT">FLOAT</left>  <!-- Reference of coordinate can be set (see DistControl); 0: origin (default) | 1:left interface | 2:right interface -->
 				<right refcoordsID="INT">FLOAT</right>
 			</region>
@@ -74,10 +80,33 @@ private:
 		v.resize(numElements);
 	}
 
-	void centerCenter(double sig,double eps,unsigned ci,unsigned cj,unsigned si, unsigned sj);
-	void centerSite(double sig,double eps,unsigned ci,unsigned cj,unsigned si, unsigned sj);
-	void siteSite(double sig,double eps,unsigned ci,unsigned cj,unsigned si, unsigned sj);
-	void dipoleDipole(unsigned ci,unsigned cj,unsigned si,unsigned sj);
+	/** Energy, virial and force terms of a pair of site types in spectral space and for the interaction within a slab */
+	struct SlabKernel {
+		PeriodicConvolution::Spectrum u;
+		PeriodicConvolution::Spectrum vN;
+		PeriodicConvolution::Spectrum vT;
+		PeriodicConvolution::Spectrum f;
+		double uSelf {0.0};
+		double vTSelf {0.0};
+	};
+
+	//! Precompute the kernels of all site pairs, identical pairs share one kernel.
+	void initSlabKernels();
+	//! Evaluate terms(distance, u, vN, vT, f) for all slab distances and transform them into a periodic kernel.
+	template<typename DistanceTerms>
+	void buildSlabKernel(DistanceTerms terms, SlabKernel& kernel) const;
+
+	void centerCenter(double sig,double eps,SlabKernel& kernel) const;
+	void centerSite(double sig,double eps,double t,SlabKernel& kernel) const;
+	void siteSite(double sig,double eps,double t1,double t2,SlabKernel& kernel) const;
+	void dipoleDipole(double muSquareProduct,SlabKernel& kernel) const;
+
+	//! Add the local density profiles of the LJ sites and dipoles, binned with per-thread histograms.
+	void sampleDensityProfiles(std::vector<double>& rhoLJ, std::vector<double>& rhoDip);
+	//! Add the convolutions of the density profiles of numSites sites with their kernels to the output profiles.
+	void convolveProfiles(const std::vector<double>& rho, unsigned numSites, const std::vector<SlabKernel>& kernels,
+			const std::vector<unsigned>& kernelIndex, std::vector<double>& u, std::vector<double>& vN,
+			std::vector<double>& vT, std::vector<double>& f);
 
 	unsigned _slabs;
 	unsigned numComp;
@@ -103,16 +132,23 @@ private:
 	std::vector<double> rhoDipoleL;
 	std::vector<double> muSquare;
 	std::vector<double> eLong;
+	PeriodicConvolution _convolution;
+	std::vector<SlabKernel> _ljKernels;
+	std::vector<unsigned> _ljKernelIndex;  // kernel of LJ sites (a,b) at a*numLJSum+b
+	std::vector<SlabKernel> _dipoleKernels;
+	std::vector<unsigned> _dipoleKernelIndex;  // kernel of dipoles (a,b) at a*numDipoleSum+b
+	ThreadLocalHistogram _rhoHistogram;
 	double cutoff;
 	double delta;
 	unsigned cutoff_slabs;
 	int frequency;
-	double ymax;
+	unsigned int _axis;  // direction normal to the interfaces
+	double normalLength;
 	double boxlength[3];
 	struct RegionPos {
 		int refPosID[2];  // kind of reference position, see DistControl
-		double refPos[2]; // left and right boundary (y coord) set in config.xml
-		double actPos[2]; // left and right boundary (y coord) within the correction is applied
+		double refPos[2]; // left and right boundary (coord along _axis) set in config.xml
+		double actPos[2]; // left and right boundary (coord along _axis) within the correction is applied
 	} _region;
 	SubjectBase* _subject;
 	double V;
@@ -0,0 +1,53 @@
+#ifndef THREADLOCALHISTOGRAM_H_
+#define THREADLOCALHISTOGRAM_H_
+
+#include <algorithm>
+#include <vector>
+
+#include "WrapOpenMP.h"
+
+
+/** @brief Histogram with one buffer per OpenMP thread
+ *
+ * Threads bin into their own buffer (threadBuffer() inside a parallel region), so no atomic
+ * updates are needed. The buffers are summed up afterwards with addTo().
+ */
+class ThreadLocalHistogram {
+public:
+	void resize(unsigned numBins) {
+		_buffers.resize(mardyn_get_max_threads());
+		for (auto& buffer : _buffers) {
+			buffer.assign(numBins, 0.0);
+		}
+	}
+
+	/** @brief Buffer of the calling thread */
+	std::vector<double>& threadBuffer() { return _buffers[mardyn_get_thread_num()]; }
+
+	void clear() {
+		for (auto& buffer : _buffers) {
+			std::fill(buffer.begin(), buffer.end(), 0.0);
+		}
+	}
+
+	/** @brief Add the bins [firstBin, firstBin + numBins) summed over all threads to result[0 .. numBins). */
+	void addTo(double* result, unsigned firstBin, unsigned numBins) const {
+		const int numBuffers = _buffers.size();
+		#if defined(_OPENMP)
+		#pragma omp parallel for
+		#endif
+		for (int bin = 0; bin < static_cast<int>(numBins); ++bin) {
+			double sum = 0.0;
+			for (int thread = 0; thread < numBuffers; ++thread) {
+				sum += _buffers[thread][firstBin + bin];
+			}
+			result[bin] += sum;
+		}
+	}
+
+private:
+	std::vector<std::vector<double>> _buffers;
+};
+
+
+#endif /* THREADLOCALHISTOGRAM_H_ */
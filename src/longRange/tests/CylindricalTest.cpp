@@ -0,0 +1,121 @@
+#include "CylindricalTest.h"
+#include "longRange/Cylindrical.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+TEST_SUITE_REGISTRATION(CylindricalTest);
+
+namespace {
+/** Integrals of u, u'(r)/r and u'(r)/r * z^2 along the whole line r > rc at in-plane distance s */
+void directLineIntegrals(double eps, double sig2, double cutoff, double s, double& iU, double& iW, double& iWZ2) {
+	const double sig6 = sig2 * sig2 * sig2;
+	const double z0 = std::sqrt(std::max(cutoff * cutoff - s * s, 0.0));
+	const double zMax = 100.0;
+	const int numSteps = 2000000;
+	const double h = (zMax - z0) / numSteps;
+	iU = iW = iWZ2 = 0.0;
+	for (int n = 0; n < numSteps; ++n) {
+		const double z = z0 + (n + 0.5) * h;
+		const double r2inv = 1.0 / (s * s + z * z);
+		const double lj6 = sig6 * r2inv * r2inv * r2inv;
+		const double lj12 = lj6 * lj6;
+		const double w = 4.0 * eps * (6.0 * lj6 - 12.0 * lj12) * r2inv;
+		iU += 4.0 * eps * (lj12 - lj6) * h;
+		iW += w * h;
+		iWZ2 += w * z * z * h;
+	}
+	iU *= 2.0;
+	iW *= 2.0;
+	iWZ2 *= 2.0;
+}
+}  // namespace
+
+void CylindricalTest::testAgainstDirectSum() {
+	const double cutoff = 2.5;
+	const unsigned bins = 6;
+	const double boxLength[2] = {9.0, 12.5};
+	// epsilon and sigma^2 of the site pairs (a,b), the mixed pair shares one kernel
+	const double eps[2][2] = {{1.0, 0.8}, {0.8, 0.7}};
+	const double sig2[2][2] = {{1.0, 1.21}, {1.21, 1.44}};
+
+	Cylindrical lrc(cutoff, cutoff, nullptr, nullptr, nullptr, nullptr);
+	lrc._bins = bins;
+	lrc._numLJSum = 2;
+	for (unsigned k = 0; k < 2; k++) {
+		lrc._binWidth[k] = boxLength[k] / bins;
+	}
+	lrc._convolution.init(bins, bins);
+	lrc._kernels.resize(3);
+	lrc.buildGridKernel(eps[0][0], sig2[0][0], lrc._kernels[0]);
+	lrc.buildGridKernel(eps[0][1], sig2[0][1], lrc._kernels[1]);
+	lrc.buildGridKernel(eps[1][1], sig2[1][1], lrc._kernels[2]);
+	lrc._kernelIndex = {0, 1, 1, 2};
+
+	const unsigned numBins = bins * bins;
+	const unsigned numValues = lrc._numLJSum * numBins;
+	lrc._rho.resize(numValues);
+	for (unsigned i = 0; i < numValues; ++i) {
+		lrc._rho[i] = 0.5 + 0.4 * std::sin(0.7 * i);
+	}
+	lrc._u.resize(numValues);
+	lrc._vAxis.resize(numValues);
+	for (unsigned k = 0; k < 2; k++) {
+		lrc._vPlane[k].resize(numValues);
+		lrc._f[k].resize(numValues);
+	}
+	lrc.convolveProfiles();
+
+	// minimum image separation of bin offsets; partners exactly half a box away exert no net force
+	const double binArea = lrc._binWidth[0] * lrc._binWidth[1];
+	std::vector<double> separation[2], forceSign[2];
+	for (unsigned k = 0; k < 2; k++) {
+		separation[k].resize(bins);
+		forceSign[k].resize(bins);
+		for (unsigned offset = 0; offset < bins; ++offset) {
+			const int image = (2 * offset > bins) ? static_cast<int>(offset) - static_cast<int>(bins) : static_cast<int>(offset);
+			separation[k][offset] = image * lrc._binWidth[k];
+			forceSign[k][offset] = (2 * offset == bins) ? 0.0 : 1.0;
+		}
+	}
+	// directly integrated tails of all site pairs at all offsets
+	std::vector<double> iU(4 * numBins), iW(4 * numBins), iWZ2(4 * numBins);
+	for (unsigned pair = 0; pair < 4; ++pair) {
+		for (unsigned offset = 0; offset < numBins; ++offset) {
+			const double s0 = separation[0][offset % bins];
+			const double s1 = separation[1][offset / bins];
+			const unsigned index = pair * numBins + offset;
+			directLineIntegrals(eps[pair / 2][pair % 2], sig2[pair / 2][pair % 2], cutoff, std::sqrt(s0 * s0 + s1 * s1),
+								iU[index], iW[index], iWZ2[index]);
+		}
+	}
+
+	for (unsigned siteA = 0; siteA < 2; ++siteA) {
+		for (unsigned bin = 0; bin < numBins; ++bin) {
+			double u = 0.0, vAxis = 0.0, vPlane[2] = {0.0, 0.0}, f[2] = {0.0, 0.0};
+			for (unsigned siteB = 0; siteB < 2; ++siteB) {
+				for (unsigned partner = 0; partner < numBins; ++partner) {
+					const unsigned offset[2] = {(partner % bins + bins - bin % bins) % bins, (partner / bins + bins - bin / bins) % bins};
+					const unsigned index = (2 * siteA + siteB) * numBins + offset[0] + bins * offset[1];
+					const double rho = lrc._rho[siteB * numBins + partner];
+					u += 0.5 * binArea * rho * iU[index];
+					vAxis -= 0.5 * binArea * rho * iWZ2[index];
+					for (unsigned k = 0; k < 2; k++) {
+						const double s = separation[k][offset[k]];
+						vPlane[k] -= 0.5 * binArea * rho * iW[index] * s * s;
+						f[k] += forceSign[k][offset[k]] * binArea * rho * iW[index] * s;
+					}
+				}
+			}
+
+			const unsigned index = siteA * numBins + bin;
+			ASSERT_DOUBLES_EQUAL(u, lrc._u[index], 1e-6 * std::abs(u));
+			ASSERT_DOUBLES_EQUAL(vAxis, lrc._vAxis[index], 1e-6 * std::abs(vAxis));
+			for (unsigned k = 0; k < 2; k++) {
+				ASSERT_DOUBLES_EQUAL(vPlane[k], lrc._vPlane[k][index], 1e-6 * std::abs(vPlane[k]) + 1e-12);
+				ASSERT_DOUBLES_EQUAL(f[k], lrc._f[k][index], 1e-6 * std::abs(f[k]) + 1e-12);
+			}
+		}
+	}
+}
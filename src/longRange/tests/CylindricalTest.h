@@ -0,0 +1,17 @@
+#pragma once
+
+#include "utils/Testing.h"
+
+class CylindricalTest : public utils::Test {
+
+	TEST_SUITE(CylindricalTest);
+	TEST_METHOD(testAgainstDirectSum);
+	TEST_SUITE_END();
+
+public:
+	/**
+	 * Compare the profiles of two LJ sites obtained by the FFT convolution of the precomputed grid kernels with the
+	 * direct sum over all bin pairs, where the LJ tail along the axis is integrated by a fine midpoint rule.
+	 */
+	void testAgainstDirectSum();
+};
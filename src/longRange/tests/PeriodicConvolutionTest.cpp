@@ -0,0 +1,110 @@
+#include "PeriodicConvolutionTest.h"
+#include "longRange/PeriodicConvolution.h"
+
+#include <cmath>
+#include <vector>
+
+TEST_SUITE_REGISTRATION(PeriodicConvolutionTest);
+
+namespace {
+std::vector<double> directConvolution(const std::vector<double>& kernel, const std::vector<double>& signal) {
+	const size_t n = signal.size();
+	std::vector<double> result(n, 0.0);
+	for (size_t i = 0; i < n; ++i) {
+		for (size_t o = 0; o < n; ++o) {
+			result[i] += kernel[o] * signal[(i + o) % n];
+		}
+	}
+	return result;
+}
+
+std::vector<double> testProfile(unsigned length, double phase) {
+	std::vector<double> profile(length);
+	for (unsigned i = 0; i < length; ++i) {
+		profile[i] = std::sin(0.3 * i + phase) + 0.1 * i;
+	}
+	return profile;
+}
+}  // namespace
+
+void PeriodicConvolutionTest::testAgainstDirectSum() {
+	for (unsigned length : {1u, 2u, 5u, 16u, 17u, 100u}) {
+		const std::vector<double> kernel = testProfile(length, 1.0);
+		const std::vector<double> signal = testProfile(length, 2.0);
+
+		PeriodicConvolution convolution;
+		convolution.init(length);
+		PeriodicConvolution::Spectrum kernelSpectrum, signalSpectrum, accumulator;
+		convolution.transformKernel(kernel.data(), kernelSpectrum);
+		convolution.transformSignal(signal.data(), signalSpectrum);
+		convolution.clearSpectrum(accumulator);
+		PeriodicConvolution::multiplyAdd(kernelSpectrum, signalSpectrum, accumulator);
+
+		std::vector<double> result(length, 1.0);  // the result is added
+		convolution.backTransformAdd(accumulator, result.data());
+
+		const std::vector<double> expected = directConvolution(kernel, signal);
+		for (unsigned i = 0; i < length; ++i) {
+			ASSERT_DOUBLES_EQUAL(expected[i] + 1.0, result[i], 1e-10);
+		}
+	}
+}
+
+void PeriodicConvolutionTest::testAccumulatedSpectra() {
+	const unsigned length = 33;
+	const std::vector<double> kernelA = testProfile(length, 0.5);
+	const std::vector<double> kernelB = testProfile(length, 1.5);
+	const std::vector<double> signalA = testProfile(length, 2.5);
+	const std::vector<double> signalB = testProfile(length, 3.5);
+
+	PeriodicConvolution convolution;
+	convolution.init(length);
+	PeriodicConvolution::Spectrum kA, kB, sA, sB, accumulator;
+	convolution.transformKernel(kernelA.data(), kA);
+	convolution.transformKernel(kernelB.data(), kB);
+	convolution.transformSignal(signalA.data(), sA);
+	convolution.transformSignal(signalB.data(), sB);
+	convolution.clearSpectrum(accumulator);
+	PeriodicConvolution::multiplyAdd(kA, sA, accumulator);
+	PeriodicConvolution::multiplyAdd(kB, sB, accumulator);
+
+	std::vector<double> result(length, 0.0);
+	convolution.backTransformAdd(accumulator, result.data());
+
+	const std::vector<double> expectedA = directConvolution(kernelA, signalA);
+	const std::vector<double> expectedB = directConvolution(kernelB, signalB);
+	for (unsigned i = 0; i < length; ++i) {
+		ASSERT_DOUBLES_EQUAL(expectedA[i] + expectedB[i], result[i], 1e-10);
+	}
+}
+
+void PeriodicConvolutionTest::testTwoDimensional() {
+	const unsigned length0 = 7;
+	const unsigned length1 = 4;
+	const std::vector<double> kernel = testProfile(length0 * length1, 0.7);
+	const std::vector<double> signal = testProfile(length0 * length1, 1.9);
+
+	PeriodicConvolution convolution;
+	convolution.init(length0, length1);
+	ASSERT_EQUAL(length0 * length1, convolution.getLength());
+	PeriodicConvolution::Spectrum kernelSpectrum, signalSpectrum, accumulator;
+	convolution.transformKernel(kernel.data(), kernelSpectrum);
+	convolution.transformSignal(signal.data(), signalSpectrum);
+	convolution.clearSpectrum(accumulator);
+	PeriodicConvolution::multiplyAdd(kernelSpectrum, signalSpectrum, accumulator);
+
+	std::vector<double> result(length0 * length1, 0.0);
+	convolution.backTransformAdd(accumulator, result.data());
+
+	for (unsigned i1 = 0; i1 < length1; ++i1) {
+		for (unsigned i0 = 0; i0 < length0; ++i0) {
+			double expected = 0.0;
+			for (unsigned o1 = 0; o1 < length1; ++o1) {
+				for (unsigned o0 = 0; o0 < length0; ++o0) {
+					expected += kernel[o0 + length0 * o1] * signal[(i0 + o0) % length0 + length0 * ((i1 + o1) % length1)];
+				}
+			}
+			ASSERT_DOUBLES_EQUAL(expected, result[i0 + length0 * i1], 1e-10);
+		}
+	}
+}
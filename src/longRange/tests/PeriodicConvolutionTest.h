@@ -0,0 +1,22 @@
+#pragma once
+
+#include "utils/Testing.h"
+
+class PeriodicConvolutionTest : public utils::Test {
+
+	TEST_SUITE(PeriodicConvolutionTest);
+	TEST_METHOD(testAgainstDirectSum);
+	TEST_METHOD(testAccumulatedSpectra);
+	TEST_METHOD(testTwoDimensional);
+	TEST_SUITE_END();
+
+public:
+	/** Compare the FFT based convolution with the direct O(n^2) sum for several (also odd) profile lengths. */
+	void testAgainstDirectSum();
+
+	/** Two kernel/signal products summed up in spectral space give the sum of the individual convolutions. */
+	void testAccumulatedSpectra();
+
+	/** 2D profiles are periodic in both dimensions. */
+	void testTwoDimensional();
+};
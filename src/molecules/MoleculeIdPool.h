@@ -19,11 +19,18 @@ public:
 	MoleculeIdPool(unsigned long poolsize, int numProcs, int myProcRank) :
 		_poolSize(poolsize), _numProcesses(numProcs), _myProcRank(myProcRank), _moleculesFromThisProcess(0) {}
 
-	/** get a new, jet unused molecule ID */
+	/** get a new, yet unused molecule ID */
 	unsigned long getNewMoleculeId() {
 		mardyn_assert(_moleculesFromThisProcess < localIdRangeSize());
 		return myIDoffset() + _moleculesFromThisProcess++;
 	}
+	/** get a contiguous range of count new, yet unused molecule IDs, returns the first ID of the range */
+	unsigned long getNewMoleculeIds(unsigned long count) {
+		mardyn_assert(_moleculesFromThisProcess + count <= localIdRangeSize());
+		const unsigned long firstId = myIDoffset() + _moleculesFromThisProcess;
+		_moleculesFromThisProcess += count;
+		return firstId;
+	}
 	/** get the rank of the process belonging to molecule ID */
 	int getOwnerRank(unsigned long id) {
 		return id / localIdRangeSize();
@@ -0,0 +1,206 @@
+#include "molecules/TabulatedPotential.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+#include "utils/Logger.h"
+#include "utils/mardyn_assert.h"
+#include "utils/xmlfileUnits.h"
+
+
+void TabulatedPotential::readXML(XMLfileUnits& xmlconfig) {
+	int cid1 = 0;
+	int cid2 = 0;
+	xmlconfig.getNodeValue("@cid1", cid1);
+	xmlconfig.getNodeValue("@cid2", cid2);
+	if (std::min(cid1, cid2) < 1) {
+		std::ostringstream error_message;
+		error_message << "Tabulated potential: cid1 and cid2 must be greater than zero" << std::endl;
+		MARDYN_EXIT(error_message.str());
+	}
+	// component id - 1 to convert to internal format starting with 0
+	setCids(std::min(cid1, cid2) - 1, std::max(cid1, cid2) - 1);
+
+	std::string type;
+	xmlconfig.getNodeValue("@type", type);
+	Log::global_log->info() << "Tabulated potential for components " << cid1 << " + " << cid2 << ": " << type << std::endl;
+	if (type == "Mie") {
+		double epsilon = 1.0, sigma = 1.0, n = 12.0, m = 6.0;
+		xmlconfig.getNodeValueReduced("epsilon", epsilon);
+		xmlconfig.getNodeValueReduced("sigma", sigma);
+		xmlconfig.getNodeValue("n", n);
+		xmlconfig.getNodeValue("m", m);
+		setMie(epsilon, sigma, n, m);
+	} else if (type == "Buckingham") {
+		double A = 0.0, B = 1.0, C = 0.0;
+		xmlconfig.getNodeValue("A", A);
+		xmlconfig.getNodeValue("B", B);
+		xmlconfig.getNodeValue("C", C);
+		setBuckingham(A, B, C);
+	} else if (type == "file") {
+		std::string filename;
+		xmlconfig.getNodeValue("file", filename);
+		std::ifstream ifs(filename);
+		if (not ifs.is_open()) {
+			std::ostringstream error_message;
+			error_message << "Tabulated potential: could not open file " << filename << std::endl;
+			MARDYN_EXIT(error_message.str());
+		}
+		std::vector<double> r, U, F;
+		std::string line;
+		while (std::getline(ifs, line)) {
+			if (line.empty() || line[0] == '#') {
+				continue;
+			}
+			std::istringstream iss(line);
+			double ri, Ui, Fi;
+			if (iss >> ri >> Ui >> Fi) {
+				r.push_back(ri);
+				U.push_back(Ui);
+				F.push_back(Fi);
+			}
+		}
+		setTable(r, U, F);
+	} else {
+		std::ostringstream error_message;
+		error_message << "Unknown tabulated potential type " << type << std::endl;
+		MARDYN_EXIT(error_message.str());
+	}
+	xmlconfig.getNodeValue("shifted", _shifted);
+}
+
+void TabulatedPotential::setMie(double epsilon, double sigma, double n, double m) {
+	_type = Type::mie;
+	// prefactor such that the well depth is epsilon
+	const double C = n / (n - m) * std::pow(n / m, m / (n - m));
+	_params[0] = C * epsilon;
+	_params[1] = sigma;
+	_params[2] = n;
+	_params[3] = m;
+}
+
+void TabulatedPotential::setBuckingham(double A, double B, double C) {
+	_type = Type::buckingham;
+	_params[0] = A;
+	_params[1] = B;
+	_params[2] = C;
+}
+
+void TabulatedPotential::setTable(const std::vector<double>& r, const std::vector<double>& U, const std::vector<double>& F) {
+	if (r.size() < 2 || r.size() != U.size() || r.size() != F.size() || not std::is_sorted(r.begin(), r.end())) {
+		std::ostringstream error_message;
+		error_message << "Tabulated potential: table needs at least two rows with ascending r" << std::endl;
+		MARDYN_EXIT(error_message.str());
+	}
+	_type = Type::file;
+	_r = r;
+	_U = U;
+	_F = F;
+}
+
+void TabulatedPotential::evaluate(double r, double& U, double& F) const {
+	switch (_type) {
+		case Type::mie: {
+			const double sn = std::pow(_params[1] / r, _params[2]);
+			const double sm = std::pow(_params[1] / r, _params[3]);
+			U = _params[0] * (sn - sm);
+			F = _params[0] * (_params[2] * sn - _params[3] * sm) / r;
+			break;
+		}
+		case Type::buckingham: {
+			const double e = _params[0] * std::exp(-_params[1] * r);
+			const double r6inv = 1.0 / (r * r * r * r * r * r);
+			U = e - _params[2] * r6inv;
+			F = _params[1] * e - 6.0 * _params[2] * r6inv / r;
+			break;
+		}
+		case Type::file: {
+			// cubic Hermite interpolation in r, the derivative dU/dr = -F is known at the rows
+			const size_t k = std::min<size_t>(std::max<ptrdiff_t>(std::upper_bound(_r.begin(), _r.end(), r) - _r.begin() - 1, 0), _r.size() - 2);
+			const double h = _r[k + 1] - _r[k];
+			const double t = (r - _r[k]) / h;
+			const double h00 = (1 + 2 * t) * (1 - t) * (1 - t), h10 = t * (1 - t) * (1 - t);
+			const double h01 = t * t * (3 - 2 * t), h11 = t * t * (t - 1);
+			U = h00 * _U[k] - h10 * h * _F[k] + h01 * _U[k + 1] - h11 * h * _F[k + 1];
+			const double dh00 = 6 * t * (t - 1), dh10 = (1 - t) * (1 - 3 * t);
+			const double dh01 = -dh00, dh11 = t * (3 * t - 2);
+			F = -(dh00 * _U[k] - dh10 * h * _F[k] + dh01 * _U[k + 1] - dh11 * h * _F[k + 1]) / h;
+			break;
+		}
+	}
+}
+
+std::vector<double> TabulatedPotential::tabulate(const TabulationGrid& grid, double cutoff) const {
+	if (grid.bins == 0 || grid.rmin <= 0.0 || grid.rmin >= cutoff) {
+		std::ostringstream error_message;
+		error_message << "Tabulated potential: grid needs bins > 0 and 0 < rmin < cutoff radius " << cutoff
+					  << ", got bins=" << grid.bins << " rmin=" << grid.rmin << std::endl;
+		MARDYN_EXIT(error_message.str());
+	}
+	if (_type == Type::file && (_r.front() > grid.rmin || _r.back() < cutoff)) {
+		std::ostringstream error_message;
+		error_message << "Tabulated potential: table has to cover [" << grid.rmin << ", " << cutoff << "]" << std::endl;
+		MARDYN_EXIT(error_message.str());
+	}
+	const double s0 = grid.rmin * grid.rmin;
+	const double delta = (cutoff * cutoff - s0) / grid.bins;
+	double U6shift = 0.0;
+	if (_shifted) {
+		double Uc, Fc;
+		evaluate(cutoff, Uc, Fc);
+		U6shift = 6.0 * Uc;
+	}
+
+	// 6U and w = F/r at the nodes s_k = s0 + k*delta, and their derivatives with respect to s = r^2
+	std::vector<double> u6(grid.bins + 1), w(grid.bins + 1), du6(grid.bins + 1), dw(grid.bins + 1);
+	for (unsigned k = 0; k <= grid.bins; ++k) {
+		const double s = s0 + k * delta;
+		double U, F;
+		evaluate(std::sqrt(s), U, F);
+		u6[k] = 6.0 * U - U6shift;
+		w[k] = F / std::sqrt(s);
+		// dU/ds = dU/dr / (2r) = -w/2
+		du6[k] = -3.0 * w[k];
+		const double h = 1e-3 * delta;
+		double Up, Fp, Um, Fm;
+		evaluate(std::sqrt(s + h), Up, Fp);
+		evaluate(std::sqrt(s - h), Um, Fm);
+		dw[k] = (Fp / std::sqrt(s + h) - Fm / std::sqrt(s - h)) / (2 * h);
+	}
+
+	std::vector<double> coefficients(grid.bins * numCoefficients);
+	for (unsigned k = 0; k < grid.bins; ++k) {
+		double* c = &coefficients[k * numCoefficients];
+		const double* values[2] = {u6.data(), w.data()};
+		const double* derivatives[2] = {du6.data(), dw.data()};
+		for (int q = 0; q < 2; ++q) {
+			const double p0 = values[q][k], p1 = values[q][k + 1];
+			if (grid.cubic) {
+				const double m0 = derivatives[q][k] * delta, m1 = derivatives[q][k + 1] * delta;
+				c[4 * q + 0] = p0;
+				c[4 * q + 1] = m0;
+				c[4 * q + 2] = 3 * (p1 - p0) - 2 * m0 - m1;
+				c[4 * q + 3] = 2 * (p0 - p1) + m0 + m1;
+			} else {
+				c[4 * q + 0] = p0;
+				c[4 * q + 1] = p1 - p0;
+				c[4 * q + 2] = 0.0;
+				c[4 * q + 3] = 0.0;
+			}
+		}
+	}
+	return coefficients;
+}
+
+void TabulatedPotential::interpolate(const double* coefficients, const TabulationGrid& grid, double cutoff, double r2, double& U6, double& w) {
+	const double s0 = grid.rmin * grid.rmin;
+	const double invDelta = grid.bins / (cutoff * cutoff - s0);
+	const double s = std::min(std::max((r2 - s0) * invDelta, 0.0), static_cast<double>(grid.bins));
+	const unsigned k = std::min(static_cast<unsigned>(s), grid.bins - 1);
+	const double t = s - k;
+	const double* c = coefficients + k * numCoefficients;
+	U6 = c[0] + t * (c[1] + t * (c[2] + t * c[3]));
+	w = c[4] + t * (c[5] + t * (c[6] + t * c[7]));
+}
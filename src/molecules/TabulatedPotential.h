@@ -0,0 +1,81 @@
+#ifndef TABULATEDPOTENTIAL_H_
+#define TABULATEDPOTENTIAL_H_
+
+#include <string>
+#include <vector>
+
+class XMLfileUnits;
+
+/** Grid shared by all tabulated potentials: bins uniform in r^2 between rmin^2 and the LJ cutoff radius squared */
+struct TabulationGrid {
+	double rmin {0.5};
+	unsigned bins {2048};
+	bool cubic {true};  //!< cubic Hermite interpolation in r^2, linear otherwise
+};
+
+/** @brief Site-site pair potential given as table or by an analytic form which is tabulated
+ *
+ * Replaces the LJ 12-6 interaction of all LJ centres of a component pair. The potential is
+ * sampled on a TabulationGrid and stored per bin as polynomial coefficients in the local
+ * coordinate t in [0,1) of the bin for the energy (times 6, as the LJ kernels accumulate 6*U)
+ * and the force scale w = F(r)/r, with F = -dU/dr. Like the LJ centres, the energy is only
+ * shifted to zero at the cutoff radius if requested. Only the vectorized cell processor
+ * (without AutoPas) evaluates tabulated potentials, and no long range correction may be used.
+ */
+class TabulatedPotential {
+public:
+	enum class Type { file, mie, buckingham };
+
+	static constexpr unsigned numCoefficients = 8;
+
+	/** @brief Read in XML configuration for a tabulated potential.
+	 *
+	 * The following XML object structure is handled by this method:
+	 * \code{.xml}
+		<potential cid1="INT" cid2="INT" type="file|Mie|Buckingham">
+			<file>STRING</file> <!-- type file: columns r U(r) F(r)=-dU/dr, r ascending -->
+			<epsilon>DOUBLE</epsilon> <sigma>DOUBLE</sigma> <n>DOUBLE</n> <m>DOUBLE</m> <!-- type Mie -->
+			<A>DOUBLE</A> <B>DOUBLE</B> <C>DOUBLE</C> <!-- type Buckingham: U = A exp(-B r) - C / r^6 -->
+			<shifted>BOOLEAN</shifted> <!-- shift the energy to zero at the cutoff radius, default false -->
+		</potential>
+	   \endcode
+	 */
+	void readXML(XMLfileUnits& xmlconfig);
+
+	void setMie(double epsilon, double sigma, double n, double m);
+	void setBuckingham(double A, double B, double C);
+	/** @brief Set table data, r ascending, F = -dU/dr */
+	void setTable(const std::vector<double>& r, const std::vector<double>& U, const std::vector<double>& F);
+	/** @brief Shift the tabulated energy by U(cutoff), as shift6 does for LJ centres */
+	void setShifted(bool shifted) { _shifted = shifted; }
+	bool isShifted() const { return _shifted; }
+
+	//! Internal component ids (starting with 0)
+	int getCid1() const { return _cid1; }
+	int getCid2() const { return _cid2; }
+	void setCids(int cid1, int cid2) { _cid1 = cid1; _cid2 = cid2; }
+
+	//! Potential energy and force F = -dU/dr of the underlying (not tabulated) potential
+	void evaluate(double r, double& U, double& F) const;
+
+	/** @brief Coefficients of all bins, numCoefficients per bin: 6U(t) = a0 + t(a1 + t(a2 + t a3)), w(t) likewise
+	 *
+	 * Exits if the grid is empty or does not end below the cutoff radius.
+	 */
+	std::vector<double> tabulate(const TabulationGrid& grid, double cutoff) const;
+
+	/** @brief Evaluate tabulated coefficients at r2 (reference for the vectorized kernels) */
+	static void interpolate(const double* coefficients, const TabulationGrid& grid, double cutoff, double r2, double& U6, double& w);
+
+private:
+	Type _type {Type::mie};
+	bool _shifted {false};
+	int _cid1 {0};
+	int _cid2 {0};
+	// analytic parameters: Mie (C*eps, sigma, n, m) or Buckingham (A, B, C)
+	double _params[4] {0., 1., 12., 6.};
+	// table data
+	std::vector<double> _r, _U, _F;
+};
+
+#endif /* TABULATEDPOTENTIAL_H_ */
@@ -0,0 +1,178 @@
+/*
+ * CollectiveCommunicationHierarchical.h
+ */
+#pragma once
+
+#include "CollectiveCommunication.h"
+
+#if MPI_VERSION >= 3
+
+/**
+ * CollectiveCommunicationHierarchical performs the reductions of CollectiveCommunication in two levels:
+ * The values are first reduced among the ranks sharing a node (MPI_COMM_TYPE_SHARED, so the MPI library
+ * can use shared memory), then only the node leaders take part in the allreduce across the nodes, and
+ * finally the result is broadcast within each node again.
+ * With many ranks per node this reduces the number of processes in the inter-node collective to the
+ * number of nodes.
+ * Broadcast and scan are not split, as their results depend on the global rank order.
+ * @note requires MPI >= 3!
+ */
+class CollectiveCommunicationHierarchical: public CollectiveCommunication {
+public:
+	CollectiveCommunicationHierarchical() :
+			_parentCommunicator(MPI_COMM_NULL), _nodeCommunicator(MPI_COMM_NULL), _leaderCommunicator(MPI_COMM_NULL),
+			_parentSize(1), _nodeSize(1), _numNodes(1), _emulatedNodes(0) {
+	}
+
+	~CollectiveCommunicationHierarchical() override {
+		freeCommunicators();
+	}
+
+	//! @brief allocate memory for the values to be sent, initialize counters
+	//! @details The node and leader communicators are created collectively on the first call for a communicator
+	//! and reused as long as the same communicator is passed.
+	//! @param numValues number of values that shall be communicated
+	void init(MPI_Comm communicator, int numValues, int key = 0) override {
+		CollectiveCommunication::init(communicator, numValues, key);
+		if (communicator != _parentCommunicator) {
+			splitCommunicator(communicator);
+		}
+	}
+
+	//! @brief Group the ranks into numNodes emulated nodes by rank modulo numNodes instead of by shared memory.
+	//! @details For the unit tests, which usually run on a single node: the reductions then always take both
+	//! levels, even for a single node or one rank per node. Has to be called on all ranks, 0 restores the default.
+	void emulateNodes(int numNodes) {
+		freeCommunicators();
+		_emulatedNodes = numNodes;
+	}
+
+	//! @brief number of (emulated) nodes of the last communicator passed to init
+	int getNumNodes() const {
+		return _numNodes;
+	}
+
+	void allreduceCustom(ReduceType type) override {
+		// a single node or one rank per node gains nothing from the second level (same decision on all ranks)
+		if (_emulatedNodes == 0 and (_numNodes == 1 or _numNodes == _parentSize)) {
+			CollectiveCommunication::allreduceCustom(type);
+			return;
+		}
+		Log::global_log->debug() << "CollectiveCommunicationHierarchical: custom Allreduce" << std::endl;
+		setMPIType();
+		MPI_Op agglomeratedTypeOperator;
+		const int commutative = 1;
+		valType * startOfValues = _values.data();
+
+		switch (type) {
+		case ReduceType::SUM:
+			MPI_CHECK(
+					MPI_Op_create((MPI_User_function * ) CollectiveCommunication::add, commutative,
+							&agglomeratedTypeOperator));
+			break;
+		case ReduceType::MAX:
+			MPI_CHECK(
+					MPI_Op_create((MPI_User_function * ) CollectiveCommunication::max, commutative,
+							&agglomeratedTypeOperator));
+			break;
+		case ReduceType::MIN:
+			MPI_CHECK(
+					MPI_Op_create((MPI_User_function * ) CollectiveCommunication::min, commutative,
+							&agglomeratedTypeOperator));
+			break;
+		default:
+			std::ostringstream error_message;
+			error_message << "invalid reducetype, aborting." << std::endl;
+			MARDYN_EXIT(error_message.str());
+		}
+
+		// reduce to the node leader (node-local rank 0)
+		if (_leaderCommunicator != MPI_COMM_NULL) {
+			MPI_CHECK(
+					MPI_Reduce(MPI_IN_PLACE, startOfValues, 1, _agglomeratedType, agglomeratedTypeOperator, 0,
+							_nodeCommunicator));
+			MPI_CHECK(
+					MPI_Allreduce(MPI_IN_PLACE, startOfValues, 1, _agglomeratedType, agglomeratedTypeOperator,
+							_leaderCommunicator));
+		} else {
+			MPI_CHECK(
+					MPI_Reduce(startOfValues, nullptr, 1, _agglomeratedType, agglomeratedTypeOperator, 0,
+							_nodeCommunicator));
+		}
+		MPI_CHECK(MPI_Bcast(startOfValues, 1, _agglomeratedType, 0, _nodeCommunicator));
+
+		MPI_CHECK(MPI_Op_free(&agglomeratedTypeOperator));
+		MPI_CHECK(MPI_Type_free(&_agglomeratedType));
+	}
+
+	size_t getTotalSize() override {
+		return CollectiveCommunication::getTotalSize() + 3 * sizeof(MPI_Comm);
+	}
+
+private:
+	//! @brief create the communicator of the ranks on the same node and the communicator of the node leaders
+	void splitCommunicator(MPI_Comm communicator) {
+		freeCommunicators();
+		_parentCommunicator = communicator;
+
+		int rank;
+		MPI_CHECK(MPI_Comm_rank(communicator, &rank));
+		MPI_CHECK(MPI_Comm_size(communicator, &_parentSize));
+		if (_emulatedNodes > 0) {
+			MPI_CHECK(MPI_Comm_split(communicator, rank % _emulatedNodes, rank, &_nodeCommunicator));
+		} else {
+			MPI_CHECK(MPI_Comm_split_type(communicator, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &_nodeCommunicator));
+		}
+		int nodeRank;
+		MPI_CHECK(MPI_Comm_rank(_nodeCommunicator, &nodeRank));
+		MPI_CHECK(MPI_Comm_size(_nodeCommunicator, &_nodeSize));
+
+		// only the node leaders get a valid leader communicator
+		MPI_CHECK(MPI_Comm_split(communicator, nodeRank == 0 ? 0 : MPI_UNDEFINED, rank, &_leaderCommunicator));
+		if (_leaderCommunicator != MPI_COMM_NULL) {
+			MPI_CHECK(MPI_Comm_size(_leaderCommunicator, &_numNodes));
+		}
+		MPI_CHECK(MPI_Bcast(&_numNodes, 1, MPI_INT, 0, _nodeCommunicator));
+
+		Log::global_log->debug() << "CollectiveCommunicationHierarchical: " << _numNodes << " nodes, " << _nodeSize
+				<< " ranks on this node" << std::endl;
+	}
+
+	void freeCommunicators() {
+		int finalized;
+		MPI_Finalized(&finalized);
+		if (not finalized) {
+			if (_nodeCommunicator != MPI_COMM_NULL) {
+				MPI_Comm_free(&_nodeCommunicator);
+			}
+			if (_leaderCommunicator != MPI_COMM_NULL) {
+				MPI_Comm_free(&_leaderCommunicator);
+			}
+		}
+		_nodeCommunicator = MPI_COMM_NULL;
+		_leaderCommunicator = MPI_COMM_NULL;
+		_parentCommunicator = MPI_COMM_NULL;
+		_parentSize = 1;
+		_nodeSize = 1;
+		_numNodes = 1;
+	}
+
+	//! Communicator the node and leader communicators were created from
+	MPI_Comm _parentCommunicator;
+
+	//! Ranks of _parentCommunicator sharing a node
+	MPI_Comm _nodeCommunicator;
+
+	//! Node-local rank 0 of every node, MPI_COMM_NULL on all other ranks
+	MPI_Comm _leaderCommunicator;
+
+	int _parentSize;
+	int _nodeSize;
+	//! Same on all ranks
+	int _numNodes;
+
+	//! Number of emulated nodes, 0 to split by shared memory, see emulateNodes
+	int _emulatedNodes;
+};
+
+#endif // MPI_VERSION >= 3
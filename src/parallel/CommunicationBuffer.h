@@ -10,6 +10,7 @@
 
 #include "molecules/MoleculeForwardDeclaration.h"
 #include "utils/mardyn_assert.h"
+#include "utils/PoolAllocator.h"
 
 #include <vector>
 #include <stddef.h>
@@ -101,7 +102,7 @@ private:
 	size_t readValue(size_t indexInBytes, T& passByReference) const;
 
 	typedef unsigned char byte_t;
-	std::vector<byte_t> _buffer;
+	std::vector<byte_t, PoolAllocator<byte_t, MemoryPool::COMMUNICATION>> _buffer;
 	size_t _numLeaving, _numHalo, _numForces;
 };
 
@@ -44,6 +44,7 @@ CommunicationPartner::CommunicationPartner(const int r, const double hLo[3], con
 	_recvStatus = new MPI_Status;
 	_isSending = _msgSent = _isReceiving = _countReceived = _msgReceived = false;
 	_countTested = 0;
+	_indexedForceReturn = _sentHaloCopiesIndexed = _receivedHaloCopiesIndexed = false;
 }
 
 CommunicationPartner::CommunicationPartner(const int r) {
@@ -70,6 +71,7 @@ CommunicationPartner::CommunicationPartner(const int r) {
 	_recvStatus = new MPI_Status;
 	_isSending = _msgSent = _isReceiving = _countReceived = _msgReceived = false;
 	_countTested = 0;
+	_indexedForceReturn = _sentHaloCopiesIndexed = _receivedHaloCopiesIndexed = false;
 }
 
 CommunicationPartner::CommunicationPartner(const int r, const double leavingLo[3], const double leavingHigh[3]) {
@@ -95,6 +97,7 @@ CommunicationPartner::CommunicationPartner(const int r, const double leavingLo[3
 	_recvStatus = new MPI_Status;
 	_isSending = _msgSent = _isReceiving = _countReceived = _msgReceived = false;
 	_countTested = 0;
+	_indexedForceReturn = _sentHaloCopiesIndexed = _receivedHaloCopiesIndexed = false;
 }
 
 CommunicationPartner::CommunicationPartner(const CommunicationPartner& o) {
@@ -109,6 +112,8 @@ CommunicationPartner::CommunicationPartner(const CommunicationPartner& o) {
 	_recvStatus = new MPI_Status;
 	_isSending = _msgSent = _isReceiving = _countReceived = _msgReceived = false;
 	_countTested = 0;
+	_indexedForceReturn = o._indexedForceReturn;
+	_sentHaloCopiesIndexed = _receivedHaloCopiesIndexed = false;
 }
 
 CommunicationPartner& CommunicationPartner::operator =(const CommunicationPartner& o) {
@@ -126,6 +131,8 @@ CommunicationPartner& CommunicationPartner::operator =(const CommunicationPartne
 		_recvStatus = new MPI_Status;
 		_isSending = _msgSent = _isReceiving = _countReceived = _msgReceived = false;
 		_countTested = 0;
+		_indexedForceReturn = o._indexedForceReturn;
+		_sentHaloCopiesIndexed = _receivedHaloCopiesIndexed = false;
 	}
 	return *this;
 }
@@ -142,6 +149,10 @@ void CommunicationPartner::initSend(ParticleContainer* moleculeContainer, const
 									std::vector<Molecule>& invalidParticles, bool mightUseInvalidParticles,
 									bool doHaloPositionCheck, bool removeFromContainer) {
 	_sendBuf.clear();
+	if (msgType == MessageType::LEAVING_AND_HALO_COPIES or msgType == MessageType::HALO_COPIES) {
+		_sentHaloCopySlots.clear();
+		_sentHaloCopiesIndexed = useIndexedForceReturn(moleculeContainer);
+	}
 
 	const unsigned int numHaloInfo = _haloInfo.size();
 	switch (msgType){
@@ -188,6 +199,10 @@ void CommunicationPartner::initSend(ParticleContainer* moleculeContainer, const
 		}
 		case MessageType::FORCES: {
 			Log::global_log->debug() << "sending forces" << std::endl;
+			if (_receivedHaloCopiesIndexed) {
+				collectForcesOfReceivedHaloCopies(moleculeContainer);
+				break;
+			}
 			for(unsigned int p = 0; p < numHaloInfo; p++){
 				collectMoleculesInRegion(moleculeContainer, _haloInfo[p]._leavingLow, _haloInfo[p]._leavingHigh,
 					_haloInfo[p]._shift, false, FORCES);
@@ -311,6 +326,12 @@ bool CommunicationPartner::testRecv(ParticleContainer* moleculeContainer, bool r
 				global_simulation->timers()->start("COMMUNICATION_PARTNER_TEST_RECV");
 				unsigned long totalNumMols = numLeaving + numHalo;
 
+				_receivedHaloCopiesIndexed = useIndexedForceReturn(moleculeContainer);
+				_receivedHaloCopies.clear();
+				if (_receivedHaloCopiesIndexed) {
+					_receivedHaloCopies.resize(numHalo);
+				}
+
 
 				/*#if defined(_OPENMP) and not defined (ADVANCED_OVERLAPPING)
 				#pragma omp parallel for schedule(static)
@@ -324,7 +345,13 @@ bool CommunicationPartner::testRecv(ParticleContainer* moleculeContainer, bool r
 					} else {
 						// halo
 						_recvBuf.readHaloMolecule(i - numLeaving, m);
-						moleculeContainer->addHaloParticle(m, false, removeRecvDuplicates);
+						if (_receivedHaloCopiesIndexed) {
+							ReceivedHaloCopy& copy = _receivedHaloCopies[i - numLeaving];
+							copy.id = m.getID();
+							copy.stored = moleculeContainer->addHaloParticleAndGetSlot(m, copy.slot, removeRecvDuplicates);
+						} else {
+							moleculeContainer->addHaloParticle(m, false, removeRecvDuplicates);
+						}
 					}
 				}
 			} else { // Buffer is force data
@@ -360,17 +387,21 @@ bool CommunicationPartner::testRecv(ParticleContainer* moleculeContainer, bool r
 				#pragma omp parallel for schedule(static)
 				#endif*/
 
-				double pos[3];
-				decltype(moleculeContainer->getMoleculeAtPosition(pos)) originalPreviousIter{};
+				if (_sentHaloCopiesIndexed) {
+					addForcesToSentHaloCopies(moleculeContainer, numForces);
+				} else {
+					double pos[3];
+					decltype(moleculeContainer->getMoleculeAtPosition(pos)) originalPreviousIter{};
 
-				for(unsigned i = 0; i < numForces; ++i) {
-					Molecule m;
-					_recvBuf.readForceMolecule(i, m);
-					//mols[i] = m;
-					const double position[3] = { m.r(0), m.r(1), m.r(2) };
+					for(unsigned i = 0; i < numForces; ++i) {
+						Molecule m;
+						_recvBuf.readForceMolecule(i, m);
+						//mols[i] = m;
+						const double position[3] = { m.r(0), m.r(1), m.r(2) };
 
-					originalPreviousIter =
-						addValuesAndGetIterator(moleculeContainer, position, originalPreviousIter, m);
+						originalPreviousIter =
+							addValuesAndGetIterator(moleculeContainer, position, originalPreviousIter, m);
+					}
 				}
 
 				//moleculeContainer->addParticles(mols, removeRecvDuplicates);
@@ -439,7 +470,10 @@ void CommunicationPartner::collectMoleculesInRegion(ParticleContainer* moleculeC
 	using std::vector;
 	global_simulation->timers()->start("COMMUNICATION_PARTNER_INIT_SEND");
 	std::vector<std::vector<Molecule>> threadData;
+	std::vector<std::vector<ParticleContainer::MoleculeSlot>> threadSlots;
 	std::vector<int> prefixArray;
+	// remember the molecules of the halo copies, to apply the returned forces to them
+	const bool recordSlots = haloLeaveCorr == HaloOrLeavingCorrection::HALO and _sentHaloCopiesIndexed;
 
 	// compute how many molecules are already in of this type: - adjust for Forces
 	unsigned long numMolsAlreadyIn = 0;
@@ -452,7 +486,7 @@ void CommunicationPartner::collectMoleculesInRegion(ParticleContainer* moleculeC
 	}
 
 	#if defined (_OPENMP)
-	#pragma omp parallel shared(threadData, numMolsAlreadyIn)
+	#pragma omp parallel shared(threadData, threadSlots, numMolsAlreadyIn)
 	#endif
 	{
 		// in the case of an autopas container, we only want to iterate over inner particle cells if we are sending
@@ -468,6 +502,9 @@ void CommunicationPartner::collectMoleculesInRegion(ParticleContainer* moleculeC
 		#endif
 		{
 			threadData.resize(numThreads);
+			if (recordSlots) {
+				threadSlots.resize(numThreads);
+			}
 			prefixArray.resize(numThreads + 1);
 		}
 
@@ -479,6 +516,9 @@ void CommunicationPartner::collectMoleculesInRegion(ParticleContainer* moleculeC
 			//traverse and gather all molecules in the cells containing part of the box specified as parameter
 			//i is a pointer to a Molecule; (*i) is the Molecule
 			threadData[threadNum].push_back(*i);
+			if (recordSlots) {
+				threadSlots[threadNum].push_back(moleculeContainer->getMoleculeSlot(i));
+			}
 			mardyn_assert(i->inBox(lowCorner, highCorner));
 			if (removeFromContainer) {
 				moleculeContainer->deleteMolecule(i, false);
@@ -509,6 +549,9 @@ void CommunicationPartner::collectMoleculesInRegion(ParticleContainer* moleculeC
 				_sendBuf.resizeForAppendingLeavingMolecules(totalNumMolsAppended);
 			} else if (haloLeaveCorr == HaloOrLeavingCorrection::HALO) {
 				_sendBuf.resizeForAppendingHaloMolecules(totalNumMolsAppended);
+				if (recordSlots) {
+					_sentHaloCopySlots.resize(numMolsAlreadyIn + totalNumMolsAppended);
+				}
 			} else if (haloLeaveCorr == HaloOrLeavingCorrection::FORCES) {
 				_sendBuf.resizeForAppendingForceMolecules(totalNumMolsAppended);
 			}
@@ -569,6 +612,9 @@ void CommunicationPartner::collectMoleculesInRegion(ParticleContainer* moleculeC
 				_sendBuf.addLeavingMolecule(numMolsAlreadyIn + prefixArray[threadNum] + i, mCopy);
 			} else if (haloLeaveCorr == HaloOrLeavingCorrection::HALO) {
 				_sendBuf.addHaloMolecule(numMolsAlreadyIn + prefixArray[threadNum] + i, mCopy);
+				if (recordSlots) {
+					_sentHaloCopySlots[numMolsAlreadyIn + prefixArray[threadNum] + i] = threadSlots[threadNum][i];
+				}
 			} else if (haloLeaveCorr == HaloOrLeavingCorrection::FORCES) {
 				_sendBuf.addForceMolecule(numMolsAlreadyIn + prefixArray[threadNum] + i, mCopy);
 			}
@@ -577,6 +623,59 @@ void CommunicationPartner::collectMoleculesInRegion(ParticleContainer* moleculeC
 	global_simulation->timers()->stop("COMMUNICATION_PARTNER_INIT_SEND");
 }
 
+bool CommunicationPartner::useIndexedForceReturn(ParticleContainer* moleculeContainer) const {
+	return _indexedForceReturn and moleculeContainer->providesMoleculeSlots() and
+		   moleculeContainer->requiresForceExchange();
+}
+
+void CommunicationPartner::addForcesToSentHaloCopies(ParticleContainer* moleculeContainer, unsigned long numForces) {
+	// the forces arrive in the order in which the halo copies were sent
+	if (numForces != _sentHaloCopySlots.size()) {
+		std::ostringstream error_message;
+		error_message << "CommunicationPartner: received " << numForces << " forces from rank " << _rank
+					  << ", but sent " << _sentHaloCopySlots.size() << " halo copies to it." << std::endl;
+		MARDYN_EXIT(error_message.str());
+	}
+	for (unsigned long i = 0; i < numForces; ++i) {
+		Molecule m;
+		_recvBuf.readForceMolecule(i, m);
+		auto original = moleculeContainer->getMoleculeAtSlot(_sentHaloCopySlots[i], m.getID());
+		if (not original.isValid()) {
+			std::ostringstream error_message;
+			error_message << "CommunicationPartner: molecule " << m.getID() << " whose halo copy was sent to rank "
+						  << _rank << " is missing when its force is returned." << std::endl;
+			MARDYN_EXIT(error_message.str());
+		}
+		original->Fadd(m.F_arr().data());
+		original->Madd(m.M_arr().data());
+		original->Viadd(m.Vi_arr().data());
+	}
+}
+
+void CommunicationPartner::collectForcesOfReceivedHaloCopies(ParticleContainer* moleculeContainer) {
+	global_simulation->timers()->start("COMMUNICATION_PARTNER_INIT_SEND");
+	const size_t numCopies = _receivedHaloCopies.size();
+	_sendBuf.resizeForAppendingForceMolecules(numCopies);
+
+	#if defined (_OPENMP)
+	#pragma omp parallel for schedule(static)
+	#endif
+	for (size_t i = 0; i < numCopies; ++i) {
+		const ReceivedHaloCopy& copy = _receivedHaloCopies[i];
+		// copies which were not stored, or deleted since (e.g. non-periodic halos), took no part in the force calculation
+		auto haloMolecule = copy.stored ? moleculeContainer->getMoleculeAtSlot(copy.slot, copy.id)
+										: SingleCellIterator<ParticleCell>();
+		if (haloMolecule.isValid()) {
+			_sendBuf.addForceMolecule(i, *haloMolecule);
+		} else {
+			Molecule noForce;
+			noForce.setid(copy.id);
+			_sendBuf.addForceMolecule(i, noForce);
+		}
+	}
+	global_simulation->timers()->stop("COMMUNICATION_PARTNER_INIT_SEND");
+}
+
 void CommunicationPartner::collectLeavingMoleculesFromInvalidParticles(std::vector<Molecule>& invalidParticles, double* lowCorner,
                                                                        double* highCorner, double* shift) {
 
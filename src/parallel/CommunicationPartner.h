@@ -12,6 +12,7 @@
 #include <vector>
 #include <stddef.h>
 #include "CommunicationBuffer.h"
+#include "particleContainer/ParticleContainer.h"
 
 typedef enum {
 	LEAVING_AND_HALO_COPIES = 0, /** send process-leaving particles and halo-copies together in one message */
@@ -20,8 +21,6 @@ typedef enum {
 	FORCES = 3 /** send forces */
 } MessageType;
 
-class ParticleContainer;
-
 struct PositionInfo {
 	double _bothLow[3], _bothHigh[3];
 	double _leavingLow[3], _leavingHigh[3];
@@ -113,6 +112,15 @@ public:
 	//! @param partner which to add to the current CommunicationPartner
 	void add(CommunicationPartner partner);
 
+	/**
+	 * Return the forces of the halo copies in the order in which the copies were sent, so the receiver applies them
+	 * to the original molecules by their slots instead of searching them by position. Only used if the container
+	 * provides molecule slots and requires a force exchange. Both partners have to use the same setting.
+	 */
+	void setIndexedForceReturn(bool indexedForceReturn) {
+		_indexedForceReturn = indexedForceReturn;
+	}
+
 	size_t getDynamicSize();
 
 	void print(std::ostream& stream) const;
@@ -137,9 +145,34 @@ private:
 	CommunicationBuffer _sendBuf, _recvBuf; // used to be ParticleData and
 	bool _msgSent, _countReceived, _msgReceived, _isSending, _isReceiving;
 
+	//! @return true, if the forces of the halo copies are returned by index, see setIndexedForceReturn()
+	bool useIndexedForceReturn(ParticleContainer* moleculeContainer) const;
+
+	//! collects the forces of the halo copies received from the partner, in the order they were received
+	void collectForcesOfReceivedHaloCopies(ParticleContainer* moleculeContainer);
+
+	//! adds the forces in the receive buffer to the molecules whose halo copies were sent to the partner
+	void addForcesToSentHaloCopies(ParticleContainer* moleculeContainer, unsigned long numForces);
+
+	bool _indexedForceReturn;
+	//! whether the halo copies sent to / received from the partner in this time step are returning forces by index
+	bool _sentHaloCopiesIndexed, _receivedHaloCopiesIndexed;
+	//! slots of the molecules whose halo copies were sent to the partner, in the order they were sent
+	std::vector<ParticleContainer::MoleculeSlot> _sentHaloCopySlots;
+	//! a halo copy received from the partner
+	struct ReceivedHaloCopy {
+		unsigned long id;
+		//! false, if the copy was not stored, because it is a duplicate or outside the halo. It returns no force then.
+		bool stored;
+		ParticleContainer::MoleculeSlot slot;
+	};
+	//! the halo copies received from the partner, in the order they were received
+	std::vector<ReceivedHaloCopy> _receivedHaloCopies;
+
 	void collectLeavingMoleculesFromInvalidParticles(std::vector<Molecule>& invalidParticles, double lowCorner [3], double highCorner [3], double shift [3]);
 
 	friend class NeighborAcquirerTest;
+	friend class CommunicationPartnerTest;
 };
 
 #endif /* COMMUNICATIONPARTNER_H_ */
@@ -24,6 +24,7 @@
 #include "parallel/ZonalMethods/NeutralTerritory.h"
 #include "parallel/CollectiveCommunication.h"
 #include "parallel/CollectiveCommunicationNonBlocking.h"
+#include "parallel/CollectiveCommunicationHierarchical.h"
 
 
 DomainDecompMPIBase::DomainDecompMPIBase() : DomainDecompMPIBase(MPI_COMM_WORLD) {}
@@ -128,6 +129,21 @@ void DomainDecompMPIBase::readXML(XMLfileUnits& xmlconfig) {
 	} else {
 		Log::global_log->info() << "DomainDecompMPIBase: NOT Using Overlapping Collectives" << std::endl;
 	}
+
+	bool hierarchicalCollectives = false;
+	xmlconfig.getNodeValue("hierarchicalCollectives", hierarchicalCollectives);
+	if(hierarchicalCollectives) {
+		if(overlappingCollectives) {
+			Log::global_log->warning() << "DomainDecompMPIBase: hierarchicalCollectives can not be combined with overlappingCollectives, ignoring it." << std::endl;
+		} else {
+#if MPI_VERSION >= 3
+			Log::global_log->info() << "DomainDecompMPIBase: Using node-aware hierarchical Collectives" << std::endl;
+			_collCommunication = std::unique_ptr<CollectiveCommunicationInterface>(new CollectiveCommunicationHierarchical());
+#else
+			Log::global_log->warning() << "DomainDecompMPIBase: Can not use hierarchical collectives, as the MPI version is less than MPI 3." << std::endl;
+#endif
+		}
+	}
 }
 
 int DomainDecompMPIBase::getNonBlockingStageCount() {
@@ -199,6 +199,8 @@ public:
 	   	 <overlappingCollectives>yes OR no</overlappingCollectives>
 	   	 <!--default: 5-->
 	   	 <overlappingStartAtStep></overlappingStartAtStep>
+	   	 <!--default: no; reduce within each node first, then only among node leaders-->
+	   	 <hierarchicalCollectives>yes OR no</hierarchicalCollectives>
 	   	 <!--default: yes-->
 	   	 <useSequentialFallback>yes OR no</useSequentialFallback>
 	     <!-- structure handled by DomainDecomposition or KDDecomposition -->
@@ -181,13 +181,8 @@ void GeneralDomainDecomposition::migrateParticles(Domain* domain, ParticleContai
 						false /*don't use invalid particles*/, true /*do halo position change*/,
 						true /*removeFromContainer*/);
 	}
-	// TODO: copying own molecules out and reinserting them can be done within autopas more efficiently
-	std::vector<Molecule> ownMolecules{};
-	ownMolecules.reserve(particleContainer->getNumberOfParticles());
-	for (auto iter = particleContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); iter.isValid(); ++iter) {
-		ownMolecules.push_back(*iter);
-		// TODO: This check should be in debug mode only
-		if (not iter->inBox(newMin.data(), newMax.data())) {
+	auto exitIfOutsideNewDomain = [&](const Molecule& molecule) {
+		if (not molecule.inBox(newMin.data(), newMax.data())) {
 			std::ostringstream error_message;
 			error_message
 				<< "Particle still in domain that should have been migrated."
@@ -199,14 +194,32 @@ void GeneralDomainDecomposition::migrateParticles(Domain* domain, ParticleContai
 				<< particleContainer->getBoundingBoxMax(0) << ", "
 				<< particleContainer->getBoundingBoxMax(1) << ", "
 				<< particleContainer->getBoundingBoxMax(2) << "\n"
-				<< "Particle: \n" << *iter
+				<< "Particle: \n" << molecule
 				<< std::endl;
 			MARDYN_EXIT(error_message.str());
 		}
+	};
+	if (particleContainer->isResizableInPlace(newMin.data(), newMax.data())) {
+		// the own molecules stay where they are, only the cell layers at the faces change
+#ifndef NDEBUG
+		for (auto iter = particleContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); iter.isValid(); ++iter) {
+			exitIfOutsideNewDomain(*iter);
+		}
+#endif
+		particleContainer->resizeInPlace(newMin.data(), newMax.data());
+	} else {
+		// TODO: copying own molecules out and reinserting them can be done within autopas more efficiently
+		std::vector<Molecule> ownMolecules{};
+		ownMolecules.reserve(particleContainer->getNumberOfParticles());
+		for (auto iter = particleContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); iter.isValid(); ++iter) {
+			ownMolecules.push_back(*iter);
+			// TODO: This check should be in debug mode only
+			exitIfOutsideNewDomain(*iter);
+		}
+		particleContainer->clear();
+		particleContainer->rebuild(newMin.data(), newMax.data());
+		particleContainer->addParticles(ownMolecules);
 	}
-	particleContainer->clear();
-	particleContainer->rebuild(newMin.data(), newMax.data());
-	particleContainer->addParticles(ownMolecules);
 	bool allDone = false;
 	double waitCounter = 30.0;
 	double deadlockTimeOut = 360.0;
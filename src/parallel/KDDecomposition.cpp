@@ -416,6 +416,20 @@ bool KDDecomposition::migrateParticles(const KDNode& newRoot, const KDNode& newO
 		}
 	}
 
+	double newBoxMin[3];
+	double newBoxMax[3];
+	for (int dim = 0; dim < 3; dim++) {
+		newBoxMin[dim] = (newOwnLeaf._lowCorner[dim]) * _cellSize[dim];
+		newBoxMax[dim] = (newOwnLeaf._highCorner[dim] + 1) * _cellSize[dim];
+		// for the last process the boxmax always has to be exactly domain->getGlobalLength().
+		if (newOwnLeaf._highCorner[dim] + 1 == _globalCellsPerDim[dim]) {
+			newBoxMax[dim] = domain->getGlobalLength(dim);
+		}
+	}
+	// If the container can be moved to the new region in place, the molecules staying on this process are
+	// left in the container instead of being collected and added again after the rebuild.
+	const bool resizeContainerInPlace = moleculeContainer->isResizableInPlace(newBoxMin, newBoxMax);
+
 	std::vector<CommunicationPartner> sendPartners;
 	sendPartners.clear();
 	int numProcsSend;
@@ -455,7 +469,7 @@ bool KDDecomposition::migrateParticles(const KDNode& newRoot, const KDNode& newO
 					inHaloRegion &= leavingLow[dimindex] < getBoundingBoxMax(dimindex, domain);
 					inHaloRegion &= leavingHigh[dimindex] >= getBoundingBoxMin(dimindex, domain);
 				}
-				if (inHaloRegion) {
+				if (inHaloRegion and not resizeContainerInPlace) {
 					collectMoleculesInRegion(moleculeContainer, leavingLow, leavingHigh, migrateToSelf);
 				}
 
@@ -465,18 +479,13 @@ bool KDDecomposition::migrateParticles(const KDNode& newRoot, const KDNode& newO
 			}
 		}
 	}
-	mardyn_assert(moleculeContainer->getNumberOfParticles() == 0ul);
-	double newBoxMin[3];
-	double newBoxMax[3];
-	for (int dim = 0; dim < 3; dim++) {
-		newBoxMin[dim] = (newOwnLeaf._lowCorner[dim]) * _cellSize[dim];
-		newBoxMax[dim] = (newOwnLeaf._highCorner[dim] + 1) * _cellSize[dim];
-		// for the last process the boxmax always has to be exactly domain->getGlobalLength().
-		if (newOwnLeaf._highCorner[dim] + 1 == _globalCellsPerDim[dim]) {
-			newBoxMax[dim] = domain->getGlobalLength(dim);
-		}
+	bool sendTogether;
+	if (resizeContainerInPlace) {
+		sendTogether = moleculeContainer->resizeInPlace(newBoxMin, newBoxMax);
+	} else {
+		mardyn_assert(moleculeContainer->getNumberOfParticles() == 0ul);
+		sendTogether = moleculeContainer->rebuild(newBoxMin, newBoxMax);
 	}
-	bool sendTogether = moleculeContainer->rebuild(newBoxMin, newBoxMax);
 
 	// the indirect neighborcommunicationscheme in combination with the kddecomposition is not allowed
 	// to send halo and leaving particles together, as long as halo particles are not send with all data (velocity, etc.)
@@ -4,18 +4,96 @@
  * @date 06.05.19
  */
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <set>
 #include <tuple>
 #include "NeighborAcquirer.h"
 #include "Domain.h"
 #include "HaloRegion.h"
 
+namespace {
+
+template<typename T>
+void appendBytes(std::vector<unsigned char>& buffer, const T* values, size_t count) {
+	const size_t i = buffer.size();
+	buffer.resize(i + sizeof(T) * count);
+	memcpy(buffer.data() + i, values, sizeof(T) * count);
+}
+
+template<typename T>
+size_t readBytes(const std::vector<unsigned char>& buffer, size_t i, T* values, size_t count) {
+	memcpy(values, buffer.data() + i, sizeof(T) * count);
+	return i + sizeof(T) * count;
+}
+
+// msg format one region: rmin | rmax | offset | width
+void appendRegion(std::vector<unsigned char>& buffer, const HaloRegion& region) {
+	appendBytes(buffer, region.rmin, 3);
+	appendBytes(buffer, region.rmax, 3);
+	appendBytes(buffer, region.offset, 3);
+	appendBytes(buffer, &region.width, 1);
+}
+
+size_t readRegion(const std::vector<unsigned char>& buffer, size_t i, HaloRegion& region) {
+	i = readBytes(buffer, i, region.rmin, 3);
+	i = readBytes(buffer, i, region.rmax, 3);
+	i = readBytes(buffer, i, region.offset, 3);
+	return readBytes(buffer, i, &region.width, 1);
+}
+
+/**
+ * Coarse global grid, whose cells are distributed round robin over the ranks.
+ * The rank owning a directory cell knows all ranks whose own region intersects the cell.
+ */
+struct Directory {
+	Directory(const std::array<double, 3>& domainLength, int numProcesses) : numProcesses(numProcesses) {
+		cellsPerDim = std::max(1, static_cast<int>(std::ceil(std::cbrt(static_cast<double>(numProcesses)) - 1e-9)));
+		for (int d = 0; d < 3; ++d) {
+			cellLength[d] = domainLength[d] / cellsPerDim;
+		}
+	}
+
+	// range of directory cells touched by [rmin, rmax], clamped to the domain
+	void cellRange(const double rmin[3], const double rmax[3], int low[3], int high[3]) const {
+		for (int d = 0; d < 3; ++d) {
+			low[d] = std::min(std::max(static_cast<int>(std::floor(rmin[d] / cellLength[d])), 0), cellsPerDim - 1);
+			high[d] = std::min(std::max(static_cast<int>(std::floor(rmax[d] / cellLength[d])), 0), cellsPerDim - 1);
+		}
+	}
+
+	template<typename F>
+	void forEachCell(const double rmin[3], const double rmax[3], F f) const {
+		int low[3], high[3];
+		cellRange(rmin, rmax, low, high);
+		for (int x = low[0]; x <= high[0]; ++x) {
+			for (int y = low[1]; y <= high[1]; ++y) {
+				for (int z = low[2]; z <= high[2]; ++z) {
+					const long cell = (static_cast<long>(x) * cellsPerDim + y) * cellsPerDim + z;
+					f(cell, static_cast<int>(cell % numProcesses));
+				}
+			}
+		}
+	}
+
+	int numProcesses;
+	int cellsPerDim;
+	double cellLength[3];
+};
+
+}  // namespace
+
 /*
- * 1. Initial Exchange of all desired regions.
- * 2. Each process checks whether he owns parts of the desired regions and will save those regions in partners02.
- * 3. Each process will notify the other processes whether they own parts of their desired domains (i.e. whether they
- * are a partner for them)
- * 4. The processes talk with each other to specify the exact domains they will communicate. Received parts will be
+ * Nothing in here scales with the number of processes, all messages go to a few ranks only:
+ * 1. Every process registers its own region at the owners of the directory cells (coarse global grid) it intersects.
+ * 2. Every process sends each desired region (all its periodic images) to the owners of the directory cells the
+ * images intersect.
+ * 3. The directory owners forward the desired regions to the processes whose registered region intersects an image.
+ * 4. Each process checks whether he owns parts of the desired regions and will save those regions in partners02.
+ * It then sends the exact domains they will communicate back to the requesting process. Received parts will be
  * saved in partners01.
+ * All exchanges are sparse (see sparseExchange).
  */
 std::tuple<std::vector<CommunicationPartner>, std::vector<CommunicationPartner>> NeighborAcquirer::acquireNeighbors(
 	const std::array<double, 3> &globalDomainLength, HaloRegion *ownRegion, std::vector<HaloRegion> &desiredRegions,
@@ -26,234 +104,142 @@ std::tuple<std::vector<CommunicationPartner>, std::vector<CommunicationPartner>>
 	int num_processes;  // the number of processes in comm
 	MPI_Comm_size(comm, &num_processes);
 
-	int num_regions = desiredRegions.size();  // the number of regions I would like to acquire from other processes
-
-	// tell the other processes how much you are going to send
-	int num_bytes_send =
-		sizeof(int) * 2 + (sizeof(double) * 3 + sizeof(double) * 3 + sizeof(int) * 3 + sizeof(double) * 1) *
-							  num_regions;  // how many bytes am I going to send to all the other processes?
-	std::vector<int> num_bytes_receive_vec(num_processes, 0);  // vector of number of bytes I am going to receive
-	// MPI_Allreduce(&num_bytes_send, &num_bytes_receive, 1, MPI_INT, MPI_SUM, comm);
-	MPI_Allgather(&num_bytes_send, 1, MPI_INT, num_bytes_receive_vec.data(), 1, MPI_INT, comm);
-
-	// create byte buffer
-	std::vector<unsigned char> outgoingDesiredRegionsVector(num_bytes_send);  // outgoing byte buffer
-	int i = 0;
-	int p = 0;
-
-	// msg format: rank | number_of_regions | region_01 | region_02 | ...
-
-	memcpy(outgoingDesiredRegionsVector.data() + i, &my_rank, sizeof(int));
-	i += sizeof(int);
-	memcpy(outgoingDesiredRegionsVector.data() + i, &num_regions, sizeof(int));
-	i += sizeof(int);
-
-	for (auto &region : desiredRegions) {  // filling up the outgoing byte buffer
-		memcpy(outgoingDesiredRegionsVector.data() + i, region.rmin, sizeof(double) * 3);
-		i += sizeof(double) * 3;
-		memcpy(outgoingDesiredRegionsVector.data() + i, region.rmax, sizeof(double) * 3);
-		i += sizeof(double) * 3;
-		memcpy(outgoingDesiredRegionsVector.data() + i, region.offset, sizeof(int) * 3);
-		i += sizeof(int) * 3;
-		memcpy(outgoingDesiredRegionsVector.data() + i, &region.width, sizeof(double));
-		i += sizeof(double);
-	}
+	const Directory directory(globalDomainLength, num_processes);
 
-	int num_bytes_receive = 0;
-	std::vector<int> num_bytes_displacements(num_processes, 0);  // vector of number of bytes I am going to receive
-	for (int j = 0; j < num_processes; j++) {
-		num_bytes_displacements[j] = num_bytes_receive;
-		num_bytes_receive += num_bytes_receive_vec[j];
+	// 1. register the own region at the directory: rmin | rmax
+	std::map<int, std::vector<unsigned char>> registrations;
+	directory.forEachCell(ownRegion->rmin, ownRegion->rmax, [&](long /*cell*/, int cellOwner) {
+		auto& buffer = registrations[cellOwner];
+		if (buffer.empty()) {
+			appendBytes(buffer, ownRegion->rmin, 3);
+			appendBytes(buffer, ownRegion->rmax, 3);
+		}
+	});
+
+	// registered regions of the ranks intersecting my directory cells
+	std::vector<std::pair<int, HaloRegion>> registeredRegions;
+	for (auto& [source, buffer] : sparseExchange(registrations, comm, 1)) {
+		HaloRegion region{};
+		size_t i = readBytes(buffer, 0, region.rmin, 3);
+		readBytes(buffer, i, region.rmax, 3);
+		registeredRegions.emplace_back(source, region);
 	}
 
-	std::vector<unsigned char> incomingDesiredRegionsVector(num_bytes_receive);  // the incoming byte buffer
+	// 2. send the desired regions to the directory: index | region | image rmin | image rmax
+	std::map<int, std::vector<unsigned char>> queries;
+	for (int regionIndex = 0; regionIndex < static_cast<int>(desiredRegions.size()); ++regionIndex) {
+		const HaloRegion& region = desiredRegions[regionIndex];
+		for (const auto& image : getPotentiallyShiftedRegions(globalDomainLength, region).first) {
+			std::set<int> cellOwners;
+			directory.forEachCell(image.rmin, image.rmax, [&](long, int cellOwner) { cellOwners.insert(cellOwner); });
+			for (int cellOwner : cellOwners) {
+				auto& buffer = queries[cellOwner];
+				appendBytes(buffer, &regionIndex, 1);
+				appendRegion(buffer, region);
+				appendBytes(buffer, image.rmin, 3);
+				appendBytes(buffer, image.rmax, 3);
+			}
+		}
+	}
 
-	// send your regions
-	MPI_Allgatherv(outgoingDesiredRegionsVector.data(), num_bytes_send, MPI_BYTE, incomingDesiredRegionsVector.data(),
-				   num_bytes_receive_vec.data(), num_bytes_displacements.data(), MPI_BYTE, comm);
+	// 3. forward them to the ranks owning parts of them: requesting rank | index | region
+	std::set<std::tuple<int, int, int>> forwarded;  // (owner, requesting rank, index)
+	std::map<int, std::vector<unsigned char>> forwards;
+	for (auto& [source, buffer] : sparseExchange(queries, comm, 2)) {
+		size_t i = 0;
+		while (i < buffer.size()) {
+			int regionIndex;
+			HaloRegion region{}, image{};
+			i = readBytes(buffer, i, &regionIndex, 1);
+			i = readRegion(buffer, i, region);
+			i = readBytes(buffer, i, image.rmin, 3);
+			i = readBytes(buffer, i, image.rmax, 3);
+			for (auto& [owner, ownerRegion] : registeredRegions) {
+				if (isIncluded(&ownerRegion, &image) and forwarded.emplace(owner, source, regionIndex).second) {
+					auto& forwardBuffer = forwards[owner];
+					appendBytes(forwardBuffer, &source, 1);
+					appendBytes(forwardBuffer, &regionIndex, 1);
+					appendRegion(forwardBuffer, region);
+				}
+			}
+		}
+	}
 
-	std::vector<int> numberOfRegionsToSendToRank(num_processes, 0);       // outgoing row
+	// the same region may be forwarded by several directory owners, the map also fixes the order
+	std::map<std::pair<int, int>, HaloRegion> requestedRegions;
+	for (auto& [source, buffer] : sparseExchange(forwards, comm, 3)) {
+		size_t i = 0;
+		while (i < buffer.size()) {
+			int rank, regionIndex;
+			HaloRegion region{};
+			i = readBytes(buffer, i, &rank, 1);
+			i = readBytes(buffer, i, &regionIndex, 1);
+			i = readRegion(buffer, i, region);
+			requestedRegions.emplace(std::make_pair(rank, regionIndex), region);
+		}
+	}
 
-	int bytesOneRegion =
-		sizeof(double) * 3 + sizeof(double) * 3 + sizeof(int) * 3 + sizeof(double) + sizeof(double) * 3;
-	std::vector<std::vector<std::vector<unsigned char>>> sendingList(num_processes);  // the regions I own and want to send
+	// 4. determine the parts I own
+	std::map<int, std::vector<unsigned char>> replies;  // the regions I own and want to send
 	std::vector<CommunicationPartner> comm_partners02;
 
-	i = 0;
-	while (i != num_bytes_receive) {
-		int rank;
-		int regions;
-
-		memcpy(&rank, incomingDesiredRegionsVector.data() + i, sizeof(int));
-		i += sizeof(int);  // 4
-		memcpy(&regions, incomingDesiredRegionsVector.data() + i, sizeof(int));
-		i += sizeof(int);  // 4
-
-		for (int j = 0; j < regions; j++) {
-			HaloRegion unshiftedRegion{};
-			memcpy(unshiftedRegion.rmin, incomingDesiredRegionsVector.data() + i, sizeof(double) * 3);
-			i += sizeof(double) * 3;  // 24
-			memcpy(unshiftedRegion.rmax, incomingDesiredRegionsVector.data() + i, sizeof(double) * 3);
-			i += sizeof(double) * 3;  // 24
-			memcpy(unshiftedRegion.offset, incomingDesiredRegionsVector.data() + i, sizeof(int) * 3);
-			i += sizeof(int) * 3;  // 12
-			memcpy(&unshiftedRegion.width, incomingDesiredRegionsVector.data() + i, sizeof(double));
-			i += sizeof(double);  // 4
-
-			// msg format one region: rmin | rmax | offset | width | shift
-			auto shiftedRegionShiftPair = getPotentiallyShiftedRegions(globalDomainLength, unshiftedRegion);
-
-			std::vector<HaloRegion> regionsToTest = shiftedRegionShiftPair.first;
-			std::vector<std::array<double, 3>> shifts  = shiftedRegionShiftPair.second;
-
-			for(size_t regionIndex = 0; regionIndex < regionsToTest.size(); ++regionIndex){
-				auto regionToTest = regionsToTest[regionIndex];
-				if ((not excludeOwnRank or rank != my_rank) and isIncluded(ownRegion, &regionToTest)) {
-					auto currentShift = shifts[regionIndex];
-
-					numberOfRegionsToSendToRank[rank]++;  // this is a region I will send to rank
-
-					auto overlappedRegion = overlap(*ownRegion, regionToTest);  // different shift for the overlap?
-
-					// make a note in partners02 - don't forget to squeeze partners02
-					bool enlarged[3][2] = {{false}};
-					for (int k = 0; k < 3; k++) currentShift[k] *= -1;
-
-					comm_partners02.emplace_back(rank, overlappedRegion.rmin, overlappedRegion.rmax, overlappedRegion.rmin,
-												 overlappedRegion.rmax, currentShift.data(), overlappedRegion.offset, enlarged);
-
-					for (int k = 0; k < 3; k++) currentShift[k] *= -1;
-
-					// Undo the shift. So it is again in the perspective of the rank we got this region from.
-					// We cannot use unshiftedRegion, as it is not overlapped and thus potentially too big.
-					HaloRegion unshiftedOverlappedRegion{overlappedRegion};
-					for (int dimI = 0; dimI < 3; ++dimI) {
-						unshiftedOverlappedRegion.rmax[dimI] -= currentShift[dimI];
-						if (fabs(unshiftedOverlappedRegion.rmax[dimI]) < 1e-10 and currentShift[dimI] != 0.) {
-							// we have to ensure that if we shifted, then the rmax, etc. are correct!
-							unshiftedOverlappedRegion.rmax[dimI] = 0.;
-						}
-						unshiftedOverlappedRegion.rmin[dimI] -= currentShift[dimI];
-						if (fabs(unshiftedOverlappedRegion.rmin[dimI] - globalDomainLength[dimI]) < 1e-10 and
-							currentShift[dimI] != 0.) {
-							// we have to ensure that if we shifted, then the rmax, etc. are correct!
-							unshiftedOverlappedRegion.rmin[dimI] = globalDomainLength[dimI];
-						}
-					}
+	for (auto& [key, unshiftedRegion] : requestedRegions) {
+		const int rank = key.first;
+		auto shiftedRegionShiftPair = getPotentiallyShiftedRegions(globalDomainLength, unshiftedRegion);
 
-					std::vector<unsigned char> singleRegion(bytesOneRegion);
-
-					p = 0;
-					memcpy(&singleRegion[p], unshiftedOverlappedRegion.rmin, sizeof(double) * 3);
-					p += sizeof(double) * 3;
-					memcpy(&singleRegion[p], unshiftedOverlappedRegion.rmax, sizeof(double) * 3);
-					p += sizeof(double) * 3;
-					memcpy(&singleRegion[p], unshiftedOverlappedRegion.offset, sizeof(int) * 3);
-					p += sizeof(int) * 3;
-					memcpy(&singleRegion[p], &unshiftedOverlappedRegion.width, sizeof(double));
-					p += sizeof(double);
-					memcpy(&singleRegion[p], currentShift.data(), sizeof(double) * 3);
-					//p += sizeof(double) * 3;
-
-					sendingList[rank].push_back(std::move(singleRegion));
-				}
-			}
-		}
-	}
+		std::vector<HaloRegion> regionsToTest = shiftedRegionShiftPair.first;
+		std::vector<std::array<double, 3>> shifts  = shiftedRegionShiftPair.second;
 
-	std::vector<std::vector<unsigned char>> merged(num_processes);  // Merge each list of char arrays into one char array
-	for (int j = 0; j < num_processes; j++) {
-		if (numberOfRegionsToSendToRank[j] > 0) {
-			std::vector<unsigned char> mergedRegions(numberOfRegionsToSendToRank[j] * bytesOneRegion);
+		for(size_t regionIndex = 0; regionIndex < regionsToTest.size(); ++regionIndex){
+			auto regionToTest = regionsToTest[regionIndex];
+			if ((not excludeOwnRank or rank != my_rank) and isIncluded(ownRegion, &regionToTest)) {
+				auto currentShift = shifts[regionIndex];
 
-			for (int k = 0; k < numberOfRegionsToSendToRank[j]; k++) {
-				memcpy(&mergedRegions[k * bytesOneRegion], sendingList[j][k].data(), bytesOneRegion);
-			}
+				auto overlappedRegion = overlap(*ownRegion, regionToTest);  // different shift for the overlap?
 
-			merged[j] = std::move(mergedRegions);
-		}
-	}
+				// make a note in partners02 - don't forget to squeeze partners02
+				bool enlarged[3][2] = {{false}};
+				for (int k = 0; k < 3; k++) currentShift[k] *= -1;
 
-	// We cannot know how many regions we are going to receive from each process a-priori.
-	// So we need to figure this out.
-	/* e.g.: 4x4
-	 *
-	 * row := sender
-	 * column := receiver
-	 *
-	 *    0 1 2 3 4
-	 *   -----------
-	 * 0 | | |3| | |
-	 *   -----------
-	 * 1 | | | |2| |
-	 *   -----------
-	 * 2 | | | | | |
-	 *   -----------
-	 * 3 | | | | | |
-	 *   -----------
-	 * reduce
-	 *   | | |2|2| |
-	 *
-	 * Each process has a horizontal vector, where it marks how many regions it is going to send to another process.
-	 * In this case, process 0 will send 3 regions to process 2 and process 1 will send 2 regions to process 3.
-	 * After the Allreduce step every process has the information how many regions it will receive.
-	 */
-	std::vector<int> numberOfRegionsToReceive(num_processes, 0);  // how many bytes does each process expect?
-	MPI_Allreduce(numberOfRegionsToSendToRank.data(), numberOfRegionsToReceive.data(), num_processes, MPI_INT, MPI_SUM, comm);
+				comm_partners02.emplace_back(rank, overlappedRegion.rmin, overlappedRegion.rmax, overlappedRegion.rmin,
+											 overlappedRegion.rmax, currentShift.data(), overlappedRegion.offset, enlarged);
 
-	// all the information for the final information exchange has been collected -> final exchange
+				for (int k = 0; k < 3; k++) currentShift[k] *= -1;
 
-	std::vector<MPI_Request> requests(num_processes, MPI_REQUEST_NULL);
-	MPI_Status probe_status;
-	MPI_Status rec_status;
+				// Undo the shift. So it is again in the perspective of the rank we got this region from.
+				// We cannot use unshiftedRegion, as it is not overlapped and thus potentially too big.
+				HaloRegion unshiftedOverlappedRegion{overlappedRegion};
+				for (int dimI = 0; dimI < 3; ++dimI) {
+					unshiftedOverlappedRegion.rmax[dimI] -= currentShift[dimI];
+					if (fabs(unshiftedOverlappedRegion.rmax[dimI]) < 1e-10 and currentShift[dimI] != 0.) {
+						// we have to ensure that if we shifted, then the rmax, etc. are correct!
+						unshiftedOverlappedRegion.rmax[dimI] = 0.;
+					}
+					unshiftedOverlappedRegion.rmin[dimI] -= currentShift[dimI];
+					if (fabs(unshiftedOverlappedRegion.rmin[dimI] - globalDomainLength[dimI]) < 1e-10 and
+						currentShift[dimI] != 0.) {
+						// we have to ensure that if we shifted, then the rmax, etc. are correct!
+						unshiftedOverlappedRegion.rmin[dimI] = globalDomainLength[dimI];
+					}
+				}
 
-	// sending (non blocking)
-	for (int j = 0; j < num_processes; j++) {
-		if (numberOfRegionsToSendToRank[j] > 0) {
-			MPI_Isend(merged[j].data(), numberOfRegionsToSendToRank[j] * bytesOneRegion, MPI_BYTE, j, 1, comm,
-					  &requests[j]);  // tag is one
+				// msg format one region: rmin | rmax | offset | width | shift
+				auto& buffer = replies[rank];
+				appendRegion(buffer, unshiftedOverlappedRegion);
+				appendBytes(buffer, currentShift.data(), 3);
+			}
 		}
 	}
 
+	// 5. receive the parts the other processes own
 	std::vector<CommunicationPartner> comm_partners01;  // the communication partners
-
-	// receive data (blocking)
-	int byte_counter = 0;
-
-	/**
-	 * We now receive as many regions as we previously determined that we will receive.
-	 * For that we keep track, how many regions we received and increase this according to the number of regions
-	 * received per MPI operation.
-	 */
-	while (byte_counter < numberOfRegionsToReceive[my_rank] * bytesOneRegion) {
-		// MPI_PROBE
-		MPI_Probe(MPI_ANY_SOURCE, 1, comm, &probe_status);
-		// interpret probe
-		int source = probe_status.MPI_SOURCE;
-		int bytes;
-		MPI_Get_count(&probe_status, MPI_BYTE, &bytes);
-		// we have receive `bytes` bytes. So we increase the byte_counter.
-		byte_counter += bytes;
-		// create buffer
-		std::vector<unsigned char> raw_neighbours(bytes);
-		MPI_Recv(raw_neighbours.data(), bytes, MPI_BYTE, source, 1, comm, &rec_status);
-		// Interpret Buffer and add neighbours
-		for (int k = 0; k < (bytes / bytesOneRegion); k++) {  // number of regions from this process
+	for (auto& [source, buffer] : sparseExchange(replies, comm, 4)) {
+		size_t i = 0;
+		while (i < buffer.size()) {
 			HaloRegion region{};
 			double shift[3];
-			i = k * bytesOneRegion;
-
-			memcpy(region.rmin, raw_neighbours.data() + i, sizeof(double) * 3);
-			i += sizeof(double) * 3;
-			memcpy(region.rmax, raw_neighbours.data() + i, sizeof(double) * 3);
-			i += sizeof(double) * 3;
-			memcpy(region.offset, raw_neighbours.data() + i, sizeof(int) * 3);
-			i += sizeof(int) * 3;
-			memcpy(&region.width, raw_neighbours.data() + i, sizeof(double));
-			i += sizeof(double);
-
-			memcpy(shift, raw_neighbours.data() + i, sizeof(double) * 3);
-			i += sizeof(double) * 3;
+			i = readRegion(buffer, i, region);
+			i = readBytes(buffer, i, shift, 3);
 
 			bool enlarged[3][2] = {{false}};
 
@@ -262,15 +248,53 @@ std::tuple<std::vector<CommunicationPartner>, std::vector<CommunicationPartner>>
 		}
 	}
 
-	// ensure that all sends have been finished.
-	for (int j = 0; j < num_processes; j++) {
-		if (numberOfRegionsToSendToRank[j] > 0) MPI_Wait(&requests[j], MPI_STATUS_IGNORE);
+	return std::make_tuple(squeezePartners(comm_partners01), squeezePartners(comm_partners02));
+}
+
+std::vector<std::pair<int, std::vector<unsigned char>>> NeighborAcquirer::sparseExchange(
+	const std::map<int, std::vector<unsigned char>>& outgoing, const MPI_Comm& comm, int tag) {
+	// NBX: synchronous sends complete only once they are matched, so after all of them completed and all processes
+	// entered the barrier no message is in flight anymore.
+	std::vector<MPI_Request> sendRequests;
+	sendRequests.reserve(outgoing.size());
+	for (auto& [rank, buffer] : outgoing) {
+		sendRequests.emplace_back();
+		MPI_Issend(buffer.data(), static_cast<int>(buffer.size()), MPI_BYTE, rank, tag, comm, &sendRequests.back());
 	}
 
-	// barrier for safety.
-	MPI_Barrier(comm);
+	std::vector<std::pair<int, std::vector<unsigned char>>> incoming;
+	MPI_Request barrierRequest = MPI_REQUEST_NULL;
+	bool barrierActive = false;
+	bool done = false;
+	while (not done) {
+		int messageAvailable = 0;
+		MPI_Status status;
+		MPI_Iprobe(MPI_ANY_SOURCE, tag, comm, &messageAvailable, &status);
+		if (messageAvailable) {
+			int bytes;
+			MPI_Get_count(&status, MPI_BYTE, &bytes);
+			std::vector<unsigned char> buffer(bytes);
+			MPI_Recv(buffer.data(), bytes, MPI_BYTE, status.MPI_SOURCE, tag, comm, MPI_STATUS_IGNORE);
+			incoming.emplace_back(status.MPI_SOURCE, std::move(buffer));
+		}
+		if (barrierActive) {
+			int barrierDone = 0;
+			MPI_Test(&barrierRequest, &barrierDone, MPI_STATUS_IGNORE);
+			done = barrierDone;
+		} else {
+			int sendsDone = 0;
+			MPI_Testall(static_cast<int>(sendRequests.size()), sendRequests.data(), &sendsDone, MPI_STATUSES_IGNORE);
+			if (sendsDone) {
+				MPI_Ibarrier(comm, &barrierRequest);
+				barrierActive = true;
+			}
+		}
+	}
 
-	return std::make_tuple(squeezePartners(comm_partners01), squeezePartners(comm_partners02));
+	// independent of the arrival order
+	std::sort(incoming.begin(), incoming.end(),
+			  [](const auto& a, const auto& b) { return a.first < b.first; });
+	return incoming;
 }
 
 std::vector<CommunicationPartner> NeighborAcquirer::squeezePartners(const std::vector<CommunicationPartner> &partners) {
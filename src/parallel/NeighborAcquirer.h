@@ -7,6 +7,7 @@
 #pragma once
 #include <vector>
 #include <array>
+#include <map>
 #include "CommunicationPartner.h"
 
 class Domain;
@@ -16,6 +17,7 @@ class NeighborAcquirer {
 public:
 	/**
 	 * Acquire the needed neighbors defined through the specific desired HaloRegions.
+	 * Uses a distributed directory and sparse exchanges, so no process has to handle data of all other processes.
 	 *
 	 * @param domain The domain object.
 	 * @param ownRegion The region of the own process.
@@ -39,6 +41,18 @@ private:
 
 	static HaloRegion overlap(const HaloRegion& myRegion, const HaloRegion& inQuestion);
 
+	/**
+	 * Sparse data exchange (NBX): every process sends the buffers in outgoing to the given ranks and receives the
+	 * buffers sent to it, without knowing beforehand from whom. Costs scale with the number of messages instead of
+	 * the number of processes.
+	 * @param outgoing buffers by destination rank
+	 * @param comm the mpi communicator
+	 * @param tag mpi tag, consecutive exchanges have to use different tags
+	 * @return received buffers with their source rank, sorted by source rank
+	 */
+	static std::vector<std::pair<int, std::vector<unsigned char>>> sparseExchange(
+		const std::map<int, std::vector<unsigned char>>& outgoing, const MPI_Comm& comm, int tag);
+
 	/**
 	 * Calculates all possible shifted regions from the given region.
 	 * The shifted regions correspond to the initial region, but wrapped around the periodic boundaries.
@@ -501,6 +501,16 @@ void DirectNeighbourCommunicationScheme::initCommunicationPartners(double cutoff
 		(*_neighbours)[0] = NeighborAcquirer::squeezePartners(commPartners);
 	}
 
+	// forces of halo copies are returned to the process the copies were received from, so they can be returned in the
+	// order the copies were sent
+	for (auto* partners : {_haloImportForceExportNeighbours, _haloExportForceImportNeighbours, _neighbours}) {
+		if (partners == nullptr) {
+			continue;
+		}
+		for (auto& partner : (*partners)[0]) {
+			partner.setIndexedForceReturn(true);
+		}
+	}
 }
 
 void IndirectNeighbourCommunicationScheme::initExchangeMoleculesMPI1D(ParticleContainer* moleculeContainer,
@@ -8,27 +8,31 @@
 #ifdef ENABLE_MPI
 #include "ResilienceComm.h"
 
+#include <algorithm>
 #include <climits> /* UINT64_MAX */
-
+#include <numeric>
 #include <sstream>
 
 #include "utils/Logger.h"
 #include "utils/mardyn_assert.h"
 
-//pretty much default
+//pretty much default, duplicating the communicator is collective
 ResilienceComm::ResilienceComm(int numProcs, int rank)
 		: _numProcs(numProcs)
 		, _rank(rank) {
+	MPI_CHECK(MPI_Comm_dup(MPI_COMM_WORLD, &_comm));
 }
 
-//copy constructor
+//copy constructor, collective as well
 ResilienceComm::ResilienceComm(ResilienceComm const& rc)
 		: _numProcs(rc._numProcs)
 		, _rank(rc._rank) {
+	MPI_CHECK(MPI_Comm_dup(rc._comm, &_comm));
 }
 
 ResilienceComm::~ResilienceComm() {
-	/*do nothing*/
+	waitSnapshotExchange();
+	MPI_Comm_free(&_comm);
 }
 
 int ResilienceComm::scatterBackupInfo(std::vector<int>& backupInfo,
@@ -60,7 +64,7 @@ int ResilienceComm::scatterBackupInfo(std::vector<int>& backupInfo,
 				                totalBytesRecv,
 				                MPI_CHAR,
 				                scatteringRank,
-				                MPI_COMM_WORLD);
+				                _comm);
 	mardyn_assert(mpi_error == MPI_SUCCESS);
 	backing.resize(numberOfBackups);
 	backedBy.resize(numberOfBackups);
@@ -107,7 +111,7 @@ int ResilienceComm::exchangeSnapshotSizes(
 		dest = backedBy[ib];
 		tag = backedByTags[ib];
 		// status = MPI_Isend(&snapshotSize, sizeof(snapshotSize), MPI_CHAR, dest, tag, MPI_COMM_WORLD, &request);
-		status = MPI_Bsend(&snapshotSize, sizeof(snapshotSize), MPI_CHAR, dest, tag, MPI_COMM_WORLD);
+		status = MPI_Bsend(&snapshotSize, sizeof(snapshotSize), MPI_CHAR, dest, tag, _comm);
 		mardyn_assert(status == MPI_SUCCESS);
 	}
 	// MPI_Barrier(MPI_COMM_WORLD);
@@ -118,7 +122,7 @@ int ResilienceComm::exchangeSnapshotSizes(
 		tag = backingTags[ib];
 		void* target = &(backupDataSizes.data()[ib]);
 		// status = MPI_Irecv(target, sizeof(snapshotSize), MPI_CHAR, src, tag, MPI_COMM_WORLD, &request);
-		status = MPI_Recv(&(backupDataSizes.data()[ib]), sizeof(snapshotSize), MPI_CHAR, src, tag, MPI_COMM_WORLD, &recvStatus);
+		status = MPI_Recv(&(backupDataSizes.data()[ib]), sizeof(snapshotSize), MPI_CHAR, src, tag, _comm, &recvStatus);
 		mardyn_assert(status == MPI_SUCCESS);
 	}
 	mardyn_assert(status == MPI_SUCCESS);
@@ -155,7 +159,7 @@ int ResilienceComm::exchangeSnapshots(
 		tag = backedByTags[ib];
 		// Log::global_log->info() << "    RR: Sending " << sendData.size()
 		// 		<< " bytes to: " << dest << " using tag: " << tag << std::endl;
-		status = MPI_Bsend(sendData.data(), sendData.size(), MPI_CHAR, dest, tag, MPI_COMM_WORLD);
+		status = MPI_Bsend(sendData.data(), sendData.size(), MPI_CHAR, dest, tag, _comm);
 		mardyn_assert(status == MPI_SUCCESS);
 	}
 	// setup the receiving buffers too for all ranks the current one is backing
@@ -168,7 +172,7 @@ int ResilienceComm::exchangeSnapshots(
 		// 		<< backupDataSizes[ib] << " bytes from "
 		// 		<< src << " at "
 		// 		<< recvIndices[ib] << " using tag: " << tag << std::endl;
-		status = MPI_Recv(&recvData.data()[recvIndex], backupDataSizes[ib], MPI_CHAR, src, tag, MPI_COMM_WORLD, &recvStatus);
+		status = MPI_Recv(&recvData.data()[recvIndex], backupDataSizes[ib], MPI_CHAR, src, tag, _comm, &recvStatus);
 		mardyn_assert(status == MPI_SUCCESS);
 		//verify a bunch of stuff
 		int count;
@@ -180,4 +184,116 @@ int ResilienceComm::exchangeSnapshots(
 	}
 	return 0;
 }
+
+std::vector<int> ResilienceComm::determineBackups(int const numberOfBackups, int& sameNodeBackups) {
+	mardyn_assert(numberOfBackups > 0 and numberOfBackups < _numProcs);
+	// identify the node of each rank by the lowest rank on it
+	MPI_Comm nodeComm;
+	MPI_CHECK(MPI_Comm_split_type(_comm, MPI_COMM_TYPE_SHARED, _rank, MPI_INFO_NULL, &nodeComm));
+	int nodeInfo[2] = {_rank, -1}; // node id, index on the node
+	MPI_CHECK(MPI_Comm_rank(nodeComm, &nodeInfo[1]));
+	MPI_CHECK(MPI_Bcast(&nodeInfo[0], 1, MPI_INT, 0, nodeComm));
+	MPI_CHECK(MPI_Comm_free(&nodeComm));
+
+	constexpr int const gatheringRank = 0;
+	std::vector<int> allNodeInfo(_rank == gatheringRank ? 2 * _numProcs : 0);
+	MPI_CHECK(MPI_Gather(nodeInfo, 2, MPI_INT, allNodeInfo.data(), 2, MPI_INT, gatheringRank, _comm));
+
+	std::vector<int> backupInfo;
+	sameNodeBackups = 0;
+	if (_rank != gatheringRank) {
+		return backupInfo;
+	}
+	// round robin over the nodes: first the first rank of every node, then the second ones, ...
+	std::vector<int> order(_numProcs);
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [&allNodeInfo](int a, int b) {
+		return std::make_pair(allNodeInfo[2 * a + 1], allNodeInfo[2 * a]) <
+			   std::make_pair(allNodeInfo[2 * b + 1], allNodeInfo[2 * b]);
+	});
+	std::vector<int> position(_numProcs);
+	for (int p = 0; p < _numProcs; ++p) {
+		position[order[p]] = p;
+	}
+	// layout per rank: backing, backedBy, backingTags, backedByTags, each numberOfBackups entries
+	backupInfo.resize(RR_INTS_PER_RANK * numberOfBackups * _numProcs);
+	for (int r = 0; r < _numProcs; ++r) {
+		int* info = &backupInfo[RR_INTS_PER_RANK * numberOfBackups * r];
+		for (int ib = 0; ib < numberOfBackups; ++ib) {
+			int const backing = order[(position[r] + _numProcs - 1 - ib) % _numProcs];
+			int const backedBy = order[(position[r] + 1 + ib) % _numProcs];
+			info[0 * numberOfBackups + ib] = backing;
+			info[1 * numberOfBackups + ib] = backedBy;
+			info[2 * numberOfBackups + ib] = ib;
+			info[3 * numberOfBackups + ib] = ib;
+			if (allNodeInfo[2 * backedBy] == allNodeInfo[2 * r]) {
+				++sameNodeBackups;
+			}
+		}
+	}
+	return backupInfo;
+}
+
+int ResilienceComm::postSnapshotExchange(
+		std::vector<int> const& destinations,
+		std::vector<int> const& destinationTags,
+		std::vector<std::vector<char> const*> const& sendData,
+		std::vector<int> const& sources,
+		std::vector<int> const& sourceTags,
+		std::vector<std::vector<char>>& recvData) {
+	mardyn_assert(destinations.size() == sendData.size() and destinations.size() == destinationTags.size());
+	mardyn_assert(sources.size() == sourceTags.size());
+	waitSnapshotExchange();
+
+	// sizes first, so that the receive buffers can be allocated
+	_sendSizes.resize(destinations.size());
+	_recvSizes.resize(sources.size());
+	_exchangeSizesRequests.resize(destinations.size() + sources.size());
+	for (size_t ib = 0; ib < destinations.size(); ++ib) {
+		_sendSizes[ib] = sendData[ib]->size();
+		MPI_CHECK(MPI_Isend(&_sendSizes[ib], 1, MPI_UNSIGNED_LONG, destinations[ib], destinationTags[ib], _comm,
+							&_exchangeSizesRequests[ib]));
+	}
+	for (size_t ib = 0; ib < sources.size(); ++ib) {
+		MPI_CHECK(MPI_Irecv(&_recvSizes[ib], 1, MPI_UNSIGNED_LONG, sources[ib], sourceTags[ib], _comm,
+							&_exchangeSizesRequests[destinations.size() + ib]));
+	}
+	MPI_CHECK(MPI_Waitall(_exchangeSizesRequests.size(), _exchangeSizesRequests.data(), MPI_STATUSES_IGNORE));
+
+	// the snapshots follow with the same tags, the message order guarantees the matching
+	recvData.resize(sources.size());
+	_exchangeSnapshotRequests.resize(destinations.size() + sources.size());
+	for (size_t ib = 0; ib < destinations.size(); ++ib) {
+		MPI_CHECK(MPI_Isend(sendData[ib]->data(), sendData[ib]->size(), MPI_CHAR, destinations[ib],
+							destinationTags[ib], _comm, &_exchangeSnapshotRequests[ib]));
+	}
+	for (size_t ib = 0; ib < sources.size(); ++ib) {
+		recvData[ib].resize(_recvSizes[ib]);
+		MPI_CHECK(MPI_Irecv(recvData[ib].data(), recvData[ib].size(), MPI_CHAR, sources[ib], sourceTags[ib], _comm,
+							&_exchangeSnapshotRequests[destinations.size() + ib]));
+	}
+	return 0;
+}
+
+bool ResilienceComm::testSnapshotExchange() {
+	if (_exchangeSnapshotRequests.empty()) {
+		return true;
+	}
+	int flag = 0;
+	MPI_CHECK(MPI_Testall(_exchangeSnapshotRequests.size(), _exchangeSnapshotRequests.data(), &flag,
+						  MPI_STATUSES_IGNORE));
+	if (flag) {
+		_exchangeSnapshotRequests.clear();
+	}
+	return flag;
+}
+
+int ResilienceComm::waitSnapshotExchange() {
+	if (not _exchangeSnapshotRequests.empty()) {
+		MPI_CHECK(MPI_Waitall(_exchangeSnapshotRequests.size(), _exchangeSnapshotRequests.data(),
+							  MPI_STATUSES_IGNORE));
+		_exchangeSnapshotRequests.clear();
+	}
+	return 0;
+}
 #endif /* ENABLE_MPI */
@@ -103,9 +103,55 @@ public:
 			std::vector<char>& sendData,
 			std::vector<char>& recvData
 	);
+	/**
+	 * Determine which ranks back which, with numberOfBackups backups per rank.
+	 * The ranks are ordered round robin over the nodes (ranks sharing memory) and every rank is backed by the
+	 * numberOfBackups ranks following it in that order, so that the backups reside on other nodes whenever the
+	 * number of nodes allows it. Collective.
+	 * @param[in] numberOfBackups how many backups are made per rank, has to be smaller than the number of ranks
+	 * @param[out] sameNodeBackups number of backups residing on the same node as the backed rank (set on root only)
+	 * @return backupInfo in the layout expected by scatterBackupInfo on the root, empty on all other ranks
+	 */
+	std::vector<int> determineBackups(int const numberOfBackups, int& sameNodeBackups);
+	/**
+	 * Non-blocking counterpart of exchangeSnapshotSizes and exchangeSnapshots.
+	 * Sends the snapshot sendData[i] to destinations[i] and posts the receives of the snapshots of all sources.
+	 * Only the snapshot sizes are awaited, the snapshots themselves are transferred in the background until
+	 * waitSnapshotExchange is called. Neither the send nor the receive buffers may be touched before.
+	 * Used with backedBy as destinations and backing as sources to replicate the own snapshot, and the other way
+	 * round to return the backups to their owners.
+	 * @param[in] destinations ranks to send to
+	 * @param[in] destinationTags tags associated with the communication with the destinations
+	 * @param[in] sendData one snapshot per destination, the same buffer may be given multiple times
+	 * @param[in] sources ranks to receive from
+	 * @param[in] sourceTags tags associated with the communication with the sources
+	 * @param[out] recvData the snapshots of the sources, resized accordingly
+	 */
+	int postSnapshotExchange(
+			std::vector<int> const& destinations,
+			std::vector<int> const& destinationTags,
+			std::vector<std::vector<char> const*> const& sendData,
+			std::vector<int> const& sources,
+			std::vector<int> const& sourceTags,
+			std::vector<std::vector<char>>& recvData
+	);
+	/**
+	 * Progress the exchange started by postSnapshotExchange.
+	 * @return true, if no exchange is pending anymore
+	 */
+	bool testSnapshotExchange();
+	/**
+	 * Wait until the exchange started by postSnapshotExchange is completed.
+	 */
+	int waitSnapshotExchange();
 private:
 	int const _numProcs;
 	int const _rank;
+	MPI_Comm _comm; //!< duplicate of MPI_COMM_WORLD, so that pending snapshots can not match other messages
+	std::vector<unsigned long> _sendSizes;
+	std::vector<unsigned long> _recvSizes;
+	std::vector<MPI_Request> _exchangeSizesRequests;
+	std::vector<MPI_Request> _exchangeSnapshotRequests;
 };
 #endif /* ENABLE_MPI */
 #endif /* SRC_PARALLEL_RESILIENCECOMM_H_ */
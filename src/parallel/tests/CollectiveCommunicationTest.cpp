@@ -10,7 +10,9 @@
 #include "parallel/CollectiveCommBase.h"
 #include "parallel/CollectiveCommunication.h"
 #include "parallel/CollectiveCommunicationNonBlocking.h"
+#include "parallel/CollectiveCommunicationHierarchical.h"
 
+#include <algorithm>
 #include <sstream>
 #include <cmath>
 
@@ -103,6 +105,62 @@ void CollectiveCommunicationTest::testCollectiveCommunicationNonBlocking() {
 #endif
 }
 
+void CollectiveCommunicationTest::testCollectiveCommunicationHierarchical() {
+#if MPI_VERSION >= 3
+	CollectiveCommunicationHierarchical collComm;
+
+	testSingleIteration(collComm);
+
+	// max and min have to see the values of all nodes
+	collComm.init(MPI_COMM_WORLD, 2);
+	collComm.appendInt(_rank);
+	collComm.appendDouble(-1. * _rank);
+	collComm.allreduceCustom(ReduceType::MAX);
+	int maxRank = collComm.getInt();
+	double minusMinRank = collComm.getDouble();
+	collComm.finalize();
+	ASSERT_EQUAL(_commSize - 1, maxRank);
+	ASSERT_DOUBLES_EQUAL(0., minusMinRank, 1e-8);
+#else
+#pragma message "CollectiveCommunicationHierarchical not supported and not tested. MPI_Version is too old."
+#endif
+}
+
+void CollectiveCommunicationTest::testCollectiveCommunicationHierarchicalEmulatedNodes() {
+#if MPI_VERSION >= 3
+	for (int numNodes : {2, 3}) {
+		CollectiveCommunicationHierarchical collComm;
+		collComm.emulateNodes(numNodes);
+
+		testSingleIteration(collComm);
+		ASSERT_EQUAL(std::min(numNodes, _commSize), collComm.getNumNodes());
+
+		collComm.init(MPI_COMM_WORLD, 3);
+		collComm.appendInt(_rank);
+		collComm.appendDouble(-1. * _rank);
+		collComm.appendUnsLong(_rank % numNodes);
+		collComm.allreduceCustom(ReduceType::MAX);
+		int maxRank = collComm.getInt();
+		double minusMinRank = collComm.getDouble();
+		unsigned long maxNode = collComm.getUnsLong();
+		collComm.finalize();
+		ASSERT_EQUAL(_commSize - 1, maxRank);
+		ASSERT_DOUBLES_EQUAL(0., minusMinRank, 1e-8);
+		ASSERT_EQUAL(static_cast<unsigned long>(std::min(numNodes, _commSize) - 1), maxNode);
+
+		// every rank of every node has to get the sum of all nodes
+		collComm.init(MPI_COMM_WORLD, 1);
+		collComm.appendUnsLong(_rank + 1);
+		collComm.allreduceSum();
+		unsigned long sum = collComm.getUnsLong();
+		collComm.finalize();
+		ASSERT_EQUAL(static_cast<unsigned long>(_commSize) * (_commSize + 1) / 2, sum);
+	}
+#else
+#pragma message "CollectiveCommunicationHierarchical not supported and not tested. MPI_Version is too old."
+#endif
+}
+
 void CollectiveCommunicationTest::testSingleIteration(CollectiveCommunicationInterface& collComm) {
 	// allreduce with double
 	collComm.init(MPI_COMM_WORLD, 1);
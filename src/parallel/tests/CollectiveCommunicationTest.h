@@ -18,6 +18,8 @@ class CollectiveCommunicationTest : public utils::Test {
 	TEST_METHOD(testCollectiveCommBase);
 	TEST_METHOD(testCollectiveCommunication);
 	TEST_METHOD(testCollectiveCommunicationNonBlocking);
+	TEST_METHOD(testCollectiveCommunicationHierarchical);
+	TEST_METHOD(testCollectiveCommunicationHierarchicalEmulatedNodes);
 	TEST_SUITE_END();
 
 public:
@@ -32,6 +34,14 @@ public:
 
 	void testCollectiveCommunicationNonBlocking();
 
+	void testCollectiveCommunicationHierarchical();
+
+	/**
+	 * Splits the ranks into emulated nodes by rank parity (and into three nodes), so the two-level reductions are
+	 * exercised although the tests usually run on a single node.
+	 */
+	void testCollectiveCommunicationHierarchicalEmulatedNodes();
+
 private:
 	void testSingleIteration(CollectiveCommunicationInterface& collComm);
 	int _rank;
@@ -0,0 +1,97 @@
+/*
+ * CommunicationPartnerTest.cpp
+ */
+
+#include "CommunicationPartnerTest.h"
+
+#include <map>
+
+#include "parallel/CommunicationPartner.h"
+#include "particleContainer/LinkedCells.h"
+
+TEST_SUITE_REGISTRATION(CommunicationPartnerTest);
+
+CommunicationPartnerTest::CommunicationPartnerTest() {
+	Component dummyComponent(0);
+	dummyComponent.addLJcenter(0, 0, 0, 1, 1, 1, 0, false);
+	_components.push_back(dummyComponent);
+}
+
+void CommunicationPartnerTest::testForcesOfDeletedHaloCopies() {
+	double boxMin[3] = {0.0, 0.0, 0.0};
+	double boxMax[3] = {10.0, 10.0, 10.0};
+	LinkedCells linkedCells(boxMin, boxMax, 2.5);
+	CommunicationPartner partner(_rank);
+
+	// three received halo copies, the first two in the same cell
+	const double positions[3][3] = {{-1.0, 1.0, 1.0}, {-1.5, 1.5, 1.0}, {11.0, 1.0, 1.0}};
+	partner._receivedHaloCopiesIndexed = true;
+	partner._receivedHaloCopies.resize(3);
+	for (unsigned long i = 0; i < 3; ++i) {
+		Molecule m(100 + i, &_components[0], positions[i][0], positions[i][1], positions[i][2], 0., 0., 0., 0., 0.,
+				   0., 0., 0., 0., 0.);
+		auto& copy = partner._receivedHaloCopies[i];
+		copy.id = m.getID();
+		copy.stored = linkedCells.addHaloParticleAndGetSlot(m, copy.slot);
+		ASSERT_TRUE(copy.stored);
+	}
+
+	// the force calculation, then the first copy is deleted, which moves the second one within the cell
+	for (auto it = linkedCells.iterator(ParticleIterator::ALL_CELLS); it.isValid(); ++it) {
+		const double force[3] = {static_cast<double>(it->getID()), 0., 0.};
+		it->Fadd(force);
+	}
+	for (auto it = linkedCells.iterator(ParticleIterator::ALL_CELLS); it.isValid(); ++it) {
+		if (it->getID() == 100ul) {
+			linkedCells.deleteMolecule(it, false);
+		}
+	}
+
+	partner.collectForcesOfReceivedHaloCopies(&linkedCells);
+	ASSERT_EQUAL(3ul, partner._sendBuf.getNumForces());
+	for (unsigned long i = 0; i < 3; ++i) {
+		Molecule m;
+		partner._sendBuf.readForceMolecule(i, m);
+		ASSERT_EQUAL(100ul + i, m.getID());
+		// the deleted copy did not take part in the force calculation
+		const double expectedForce = i == 0 ? 0. : 100. + i;
+		ASSERT_DOUBLES_EQUAL(expectedForce, m.F(0), 1e-12);
+	}
+}
+
+void CommunicationPartnerTest::testForcesOfReorderedOriginals() {
+	double boxMin[3] = {0.0, 0.0, 0.0};
+	double boxMax[3] = {10.0, 10.0, 10.0};
+	LinkedCells linkedCells(boxMin, boxMax, 2.5);
+	CommunicationPartner partner(_rank);
+
+	// molecules in one cell, with decreasing z, so that sorting the cell reverses them
+	for (unsigned long id = 0; id < 5; ++id) {
+		Molecule m(id, &_components[0], 0.5, 0.5, 2.0 - 0.4 * id, 0., 0., 0., 0., 0., 0., 0., 0., 0., 0.);
+		linkedCells.addParticle(m);
+	}
+	std::vector<unsigned long> sentIds;
+	partner._sentHaloCopiesIndexed = true;
+	for (auto it = linkedCells.iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); it.isValid(); ++it) {
+		sentIds.push_back(it->getID());
+		partner._sentHaloCopySlots.push_back(linkedCells.getMoleculeSlot(it));
+	}
+	ASSERT_EQUAL(5ul, sentIds.size());
+
+	linkedCells.setCellSorting(true);
+	linkedCells.updateMoleculeCaches();
+
+	// the returned forces, in the order the halo copies were sent
+	partner._recvBuf.resizeForAppendingForceMolecules(sentIds.size());
+	for (size_t i = 0; i < sentIds.size(); ++i) {
+		Molecule m(sentIds[i], &_components[0], 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0.);
+		const double force[3] = {10. * sentIds[i], 0., 0.};
+		m.Fadd(force);
+		partner._recvBuf.addForceMolecule(i, m);
+	}
+	partner.addForcesToSentHaloCopies(&linkedCells, sentIds.size());
+
+	for (auto it = linkedCells.iterator(ParticleIterator::ALL_CELLS); it.isValid(); ++it) {
+		ASSERT_DOUBLES_EQUAL(10. * it->getID(), it->F(0), 1e-12);
+	}
+}
@@ -0,0 +1,33 @@
+/*
+ * CommunicationPartnerTest.h
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "molecules/Component.h"
+#include "utils/TestWithSimulationSetup.h"
+
+/**
+ * Tests returning the forces of halo copies by index (see CommunicationPartner::setIndexedForceReturn()), when the
+ * molecules were moved within their cells between the halo exchange and the force exchange.
+ */
+class CommunicationPartnerTest : public utils::TestWithSimulationSetup {
+	TEST_SUITE(CommunicationPartnerTest);
+	TEST_METHOD(testForcesOfDeletedHaloCopies);
+	TEST_METHOD(testForcesOfReorderedOriginals);
+	TEST_SUITE_END();
+
+public:
+	CommunicationPartnerTest();
+
+	//! received halo copies were deleted, as by removeNonPeriodicHalos, before their forces are sent back
+	void testForcesOfDeletedHaloCopies();
+
+	//! the molecules whose halo copies were sent were reordered, as by sorting the cells, before the forces arrive
+	void testForcesOfReorderedOriginals();
+
+private:
+	std::vector<Component> _components;
+};
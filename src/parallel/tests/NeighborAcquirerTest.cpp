@@ -6,6 +6,13 @@
  */
 #include <mpi.h>
 
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <random>
+#include <sstream>
+#include <tuple>
+
 #include "NeighborAcquirerTest.h"
 #include "parallel/NeighborAcquirer.h"
 
@@ -293,3 +300,190 @@ void NeighborAcquirerTest::testCorrectNeighborAcquisition() {
 		}
 	}
 }
+
+std::tuple<std::vector<CommunicationPartner>, std::vector<CommunicationPartner>>
+NeighborAcquirerTest::acquireNeighborsAllToAll(const std::array<double, 3>& globalDomainLength, HaloRegion* ownRegion,
+											   std::vector<HaloRegion>& desiredRegions, const MPI_Comm& comm,
+											   bool excludeOwnRank) {
+	int myRank, numProcesses;
+	MPI_Comm_rank(comm, &myRank);
+	MPI_Comm_size(comm, &numProcesses);
+
+	// HaloRegion is plain data, so the regions are exchanged as bytes
+	std::vector<HaloRegion> ownRegions(numProcesses);
+	MPI_Allgather(ownRegion, sizeof(HaloRegion), MPI_BYTE, ownRegions.data(), sizeof(HaloRegion), MPI_BYTE, comm);
+	int numDesired = desiredRegions.size();
+	std::vector<int> counts(numProcesses), displacements(numProcesses, 0);
+	MPI_Allgather(&numDesired, 1, MPI_INT, counts.data(), 1, MPI_INT, comm);
+	for (int r = 0; r < numProcesses; r++) {
+		counts[r] *= sizeof(HaloRegion);
+		displacements[r] = r > 0 ? displacements[r - 1] + counts[r - 1] : 0;
+	}
+	std::vector<HaloRegion> allDesired((displacements.back() + counts.back()) / sizeof(HaloRegion));
+	MPI_Allgatherv(desiredRegions.data(), numDesired * sizeof(HaloRegion), MPI_BYTE, allDesired.data(), counts.data(),
+				   displacements.data(), MPI_BYTE, comm);
+
+	bool enlarged[3][2] = {{false}};
+	std::vector<CommunicationPartner> partners01, partners02;
+	// the regions owner sends to requester for each desired region of requester, as in the previous algorithm
+	auto forEachOverlap = [&](int owner, int requester, const std::function<void(const HaloRegion&, const HaloRegion&,
+																			 std::array<double, 3>)>& f) {
+		if (excludeOwnRank and owner == requester) {
+			return;
+		}
+		for (int j = 0; j < counts[requester] / static_cast<int>(sizeof(HaloRegion)); j++) {
+			const HaloRegion& unshiftedRegion = allDesired[displacements[requester] / sizeof(HaloRegion) + j];
+			auto shiftedRegionShiftPair = NeighborAcquirer::getPotentiallyShiftedRegions(globalDomainLength, unshiftedRegion);
+			for (size_t s = 0; s < shiftedRegionShiftPair.first.size(); s++) {
+				HaloRegion regionToTest = shiftedRegionShiftPair.first[s];
+				if (not NeighborAcquirer::isIncluded(&ownRegions[owner], &regionToTest)) {
+					continue;
+				}
+				const std::array<double, 3> shift = shiftedRegionShiftPair.second[s];
+				HaloRegion overlappedRegion = NeighborAcquirer::overlap(ownRegions[owner], regionToTest);
+				// the overlap as seen by the requester
+				HaloRegion unshiftedOverlappedRegion{overlappedRegion};
+				for (int d = 0; d < 3; d++) {
+					unshiftedOverlappedRegion.rmax[d] -= shift[d];
+					if (std::fabs(unshiftedOverlappedRegion.rmax[d]) < 1e-10 and shift[d] != 0.) {
+						unshiftedOverlappedRegion.rmax[d] = 0.;
+					}
+					unshiftedOverlappedRegion.rmin[d] -= shift[d];
+					if (std::fabs(unshiftedOverlappedRegion.rmin[d] - globalDomainLength[d]) < 1e-10 and shift[d] != 0.) {
+						unshiftedOverlappedRegion.rmin[d] = globalDomainLength[d];
+					}
+				}
+				f(overlappedRegion, unshiftedOverlappedRegion, shift);
+			}
+		}
+	};
+	for (int requester = 0; requester < numProcesses; requester++) {
+		forEachOverlap(myRank, requester, [&](const HaloRegion& overlapped, const HaloRegion&, std::array<double, 3> shift) {
+			for (int d = 0; d < 3; d++) shift[d] *= -1;
+			partners02.emplace_back(requester, overlapped.rmin, overlapped.rmax, overlapped.rmin, overlapped.rmax,
+									shift.data(), overlapped.offset, enlarged);
+		});
+	}
+	for (int owner = 0; owner < numProcesses; owner++) {
+		forEachOverlap(owner, myRank, [&](const HaloRegion&, const HaloRegion& unshifted, std::array<double, 3> shift) {
+			partners01.emplace_back(owner, unshifted.rmin, unshifted.rmax, unshifted.rmin, unshifted.rmax, shift.data(),
+									unshifted.offset, enlarged);
+		});
+	}
+	return std::make_tuple(NeighborAcquirer::squeezePartners(partners01), NeighborAcquirer::squeezePartners(partners02));
+}
+
+void NeighborAcquirerTest::testAgainstAllToAllExchange() {
+	int worldRank, worldSize;
+	MPI_Comm_rank(MPI_COMM_WORLD, &worldRank);
+	MPI_Comm_size(MPI_COMM_WORLD, &worldSize);
+
+	for (int numProcesses = 1; numProcesses <= worldSize; numProcesses++) {
+		MPI_Comm comm;
+		MPI_Comm_split(MPI_COMM_WORLD, worldRank < numProcesses ? 0 : MPI_UNDEFINED, worldRank, &comm);
+		// first difference found by this process, checked by all processes of MPI_COMM_WORLD together
+		std::string failure;
+		if (comm != MPI_COMM_NULL) {
+			failure = compareWithAllToAllExchange(comm);
+			MPI_Comm_free(&comm);
+		}
+		int allMatch = failure.empty();
+		MPI_Allreduce(MPI_IN_PLACE, &allMatch, 1, MPI_INT, MPI_LAND, MPI_COMM_WORLD);
+		ASSERT_TRUE_MSG(failure, failure.empty());
+		ASSERT_TRUE_MSG("partners differ on another process", allMatch);
+	}
+}
+
+std::string NeighborAcquirerTest::compareWithAllToAllExchange(const MPI_Comm& comm) {
+	int numProcesses, rank;
+	MPI_Comm_size(comm, &numProcesses);
+	MPI_Comm_rank(comm, &rank);
+	std::string failure;
+
+	// partners in a canonical form, independent of their order
+	auto describe = [](const std::vector<CommunicationPartner>& partners) {
+		std::vector<std::string> descriptions;
+		for (auto& partner : partners) {
+			std::ostringstream description;
+			partner.print(description);
+			descriptions.push_back(description.str());
+		}
+		std::sort(descriptions.begin(), descriptions.end());
+		std::string result;
+		for (auto& description : descriptions) {
+			result += description + "\n";
+		}
+		return result;
+	};
+
+	// factorize the number of processes into a process grid
+	int grid[3] = {1, 1, 1};
+	for (int remaining = numProcesses, factor = 2, d = 0; remaining > 1;) {
+		if (remaining % factor == 0) {
+			grid[d++ % 3] *= factor;
+			remaining /= factor;
+		} else {
+			factor++;
+		}
+	}
+	const int position[3] = {rank % grid[0], (rank / grid[0]) % grid[1], rank / (grid[0] * grid[1])};
+
+	for (int trial = 0; trial < 8; trial++) {
+		// same random cuts on all processes
+		std::mt19937 generator(trial);
+		std::uniform_real_distribution<double> jitter(-0.3, 0.3);
+		const std::array<double, 3> globalDomainLength{10. + trial, 12., 9.};
+		HaloRegion ownRegion{};
+		for (int d = 0; d < 3; d++) {
+			std::vector<double> cuts{0.};
+			for (int c = 1; c < grid[d]; c++) {
+				cuts.push_back(globalDomainLength[d] * (c + jitter(generator)) / grid[d]);
+			}
+			cuts.push_back(globalDomainLength[d]);
+			ownRegion.rmin[d] = cuts[position[d]];
+			ownRegion.rmax[d] = cuts[position[d] + 1];
+		}
+
+		// halo regions of all 26 directions, every other trial the own region as for migrating molecules
+		const double cutoff = (trial % 3 == 0) ? 3.0 : 1.0;
+		std::vector<HaloRegion> desiredRegions;
+		if (trial % 2 == 0) {
+			for (int ox = -1; ox <= 1; ox++) for (int oy = -1; oy <= 1; oy++) for (int oz = -1; oz <= 1; oz++) {
+				if (ox == 0 and oy == 0 and oz == 0) continue;
+				const int direction[3] = {ox, oy, oz};
+				HaloRegion region = ownRegion;
+				for (int d = 0; d < 3; d++) {
+					if (direction[d] < 0) {
+						region.rmin[d] = ownRegion.rmin[d] - cutoff;
+						region.rmax[d] = ownRegion.rmin[d];
+					} else if (direction[d] > 0) {
+						region.rmin[d] = ownRegion.rmax[d];
+						region.rmax[d] = ownRegion.rmax[d] + cutoff;
+					}
+					region.offset[d] = direction[d];
+				}
+				region.width = cutoff;
+				desiredRegions.push_back(region);
+			}
+		} else {
+			desiredRegions.push_back(ownRegion);
+		}
+		const bool excludeOwnRank = trial % 4 != 1;
+
+		std::vector<CommunicationPartner> expected01, expected02, partners01, partners02;
+		std::tie(expected01, expected02) =
+			acquireNeighborsAllToAll(globalDomainLength, &ownRegion, desiredRegions, comm, excludeOwnRank);
+		std::tie(partners01, partners02) =
+			NeighborAcquirer::acquireNeighbors(globalDomainLength, &ownRegion, desiredRegions, comm, excludeOwnRank);
+
+		// keep going after a difference, all processes have to take part in every exchange
+		if (failure.empty() and (describe(expected01) != describe(partners01) or describe(expected02) != describe(partners02))) {
+			std::stringstream message;
+			message << "rank " << rank << " of " << numProcesses << ", trial " << trial << ": expected partners"
+					<< std::endl << describe(expected01) << describe(expected02) << "but got" << std::endl
+					<< describe(partners01) << describe(partners02);
+			failure = message.str();
+		}
+	}
+	return failure;
+}
@@ -20,6 +20,7 @@ class NeighborAcquirerTest : public utils::TestWithSimulationSetup {
 	TEST_METHOD(testOverlap);
 	TEST_METHOD(testIOwnThis);
 	TEST_METHOD(testCorrectNeighborAcquisition);
+	TEST_METHOD(testAgainstAllToAllExchange);
 	TEST_SUITE_END();
 
 	public:
@@ -29,7 +30,27 @@ class NeighborAcquirerTest : public utils::TestWithSimulationSetup {
 		void testOverlap();
 		void testIOwnThis();
 		void testCorrectNeighborAcquisition();
+		/**
+		 * Compare the partners of acquireNeighbors with those of the previous algorithm, which exchanged the desired
+		 * regions of all processes, on all process counts up to the size of MPI_COMM_WORLD and on jittered
+		 * decompositions.
+		 */
+		void testAgainstAllToAllExchange();
 	private:
+		/**
+		 * Partners as found by the previous algorithm: every process knows the own and desired regions of all
+		 * processes and computes the partners of both roles locally.
+		 */
+		static std::tuple<std::vector<CommunicationPartner>, std::vector<CommunicationPartner>> acquireNeighborsAllToAll(
+			const std::array<double, 3>& globalDomainLength, HaloRegion* ownRegion,
+			std::vector<HaloRegion>& desiredRegions, const MPI_Comm& comm, bool excludeOwnRank);
+
+		/**
+		 * Compares acquireNeighbors with acquireNeighborsAllToAll on jittered grid decompositions over comm.
+		 * @return the first difference found by this process, empty if there is none
+		 */
+		static std::string compareWithAllToAllExchange(const MPI_Comm& comm);
+
 		FullShell* _fullShell;
 };
 
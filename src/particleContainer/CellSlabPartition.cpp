@@ -0,0 +1,84 @@
+/*
+ * CellSlabPartition.cpp
+ */
+
+#include "CellSlabPartition.h"
+
+#include <algorithm>
+#include <numeric>
+#include <set>
+
+#include "WrapOpenMP.h"
+#include "utils/Logger.h"
+#include "utils/PrintThreadPinningToCPU.h"
+#include "utils/ThreeElementPermutations.h"
+#include "utils/threeDimensionalMapping.h"
+
+void CellSlabPartition::rebuild(const std::array<unsigned long, 3>& dims) {
+	using namespace Permute3Elements;
+
+	// same choice as SlicedCellPairTraversal: the slowest dimension of the base cells
+	const std::array<unsigned long, 3> baseCells = {dims[0] - 1, dims[1] - 1, dims[2] - 1};
+	const std::array<unsigned short, 3> dimensions = {0, 1, 2};
+	_slabDimension = permuteForward(getPermutationForIncreasingSorting(baseCells), dimensions)[2];
+
+	std::vector<int> nodeOfThread;
+	#if defined(_OPENMP)
+	#pragma omp parallel
+	#endif
+	{
+		#if defined(_OPENMP)
+		#pragma omp single
+		#endif
+		nodeOfThread.resize(mardyn_get_num_threads());
+
+		nodeOfThread[mardyn_get_thread_num()] = getNumaNodeOfCurrentThread();
+	}
+	const int numSlabs = static_cast<int>(nodeOfThread.size());
+
+	std::vector<int> threadOfSlab(numSlabs);
+	std::iota(threadOfSlab.begin(), threadOfSlab.end(), 0);
+	std::stable_sort(threadOfSlab.begin(), threadOfSlab.end(),
+					 [&nodeOfThread](int a, int b) { return nodeOfThread[a] < nodeOfThread[b]; });
+	_slabOfThread.resize(numSlabs);
+	for (int slab = 0; slab < numSlabs; ++slab) {
+		_slabOfThread[threadOfSlab[slab]] = slab;
+	}
+
+	// base cell layer l belongs to slab l * numSlabs / numBaseLayers, i.e. slab s starts at the first such layer
+	const unsigned long numLayers = dims[_slabDimension];
+	const unsigned long numBaseLayers = numLayers - 1;
+	_firstLayer.resize(numSlabs + 1);
+	for (int slab = 0; slab < numSlabs; ++slab) {
+		_firstLayer[slab] = (slab * numBaseLayers + numSlabs - 1) / numSlabs;
+	}
+	_firstLayer[numSlabs] = numLayers;
+
+	std::vector<int> slabOfLayer(numLayers);
+	for (int slab = 0; slab < numSlabs; ++slab) {
+		std::fill(slabOfLayer.begin() + _firstLayer[slab], slabOfLayer.begin() + _firstLayer[slab + 1], slab);
+	}
+
+	_cells.assign(numSlabs, std::vector<unsigned long>());
+	const unsigned long numCells = dims[0] * dims[1] * dims[2];
+	for (unsigned long cellIndex = 0; cellIndex < numCells; ++cellIndex) {
+		const auto layer = threeDimensionalMapping::oneToThreeD(cellIndex, dims)[_slabDimension];
+		_cells[slabOfLayer[layer]].push_back(cellIndex);
+	}
+
+	const std::set<int> nodes(nodeOfThread.begin(), nodeOfThread.end());
+	Log::global_log->info() << "CellSlabPartition: " << numSlabs << " slabs along dimension " << _slabDimension
+			<< ", threads on " << nodes.size() << " NUMA node(s)." << std::endl;
+	for (int slab = 0; slab < numSlabs; ++slab) {
+		Log::global_log->debug() << "CellSlabPartition: slab " << slab << " (layers " << _firstLayer[slab] << " to "
+				<< _firstLayer[slab + 1] << ") owned by thread " << threadOfSlab[slab] << " on NUMA node "
+				<< nodeOfThread[threadOfSlab[slab]] << std::endl;
+	}
+}
+
+int CellSlabPartition::getSlabOfCurrentThread() const {
+	if (mardyn_get_num_threads() != getNumSlabs()) {
+		return -1;
+	}
+	return _slabOfThread[mardyn_get_thread_num()];
+}
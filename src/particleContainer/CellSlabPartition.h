@@ -0,0 +1,61 @@
+/*
+ * CellSlabPartition.h
+ */
+
+#pragma once
+
+#include <array>
+#include <utility>
+#include <vector>
+
+/**
+ * \brief Partition of the cells of a LinkedCells grid into one slab of consecutive cell layers per thread.
+ * \details The slabs are cut along the dimension with the most cells, which is also the dimension
+ * SlicedCellPairTraversal slices, and base cell layer l of the n - 1 base cell layers belongs to slab
+ * l * numThreads / (n - 1); the last (halo) layer is added to the last slab. Thread s of the chain of
+ * SlicedCellPairTraversal therefore processes the base cells of slab s.
+ *
+ * The slabs are handed to the threads ordered by the NUMA node each thread runs on, then by thread id, so that
+ * neighbouring slabs and the cells shared at their borders stay on one node wherever possible. If every thread
+ * allocates, first touches and later traverses the cells of its own slab, the molecules and caches of these cells
+ * stay in memory local to the thread. This requires the threads to be pinned, e.g. OMP_PROC_BIND=close.
+ */
+class CellSlabPartition {
+public:
+	/**
+	 * @brief partition the cells among the threads of a parallel region
+	 * @param dims number of cells per dimension, halo included
+	 * @details Queries the NUMA nodes of the threads, so call it outside of parallel regions.
+	 */
+	void rebuild(const std::array<unsigned long, 3>& dims);
+
+	//! @brief number of slabs, equal to the number of threads of a parallel region at the last rebuild
+	int getNumSlabs() const { return static_cast<int>(_slabOfThread.size()); }
+
+	//! @brief dimension along which the cells are sliced
+	unsigned short getSlabDimension() const { return _slabDimension; }
+
+	//! @brief slab owned by the thread with the given id
+	int getSlabOfThread(int thread) const { return _slabOfThread[thread]; }
+
+	/**
+	 * @brief slab owned by the calling thread
+	 * @return -1 if the size of the current thread team differs from the number of slabs, e.g. outside of parallel
+	 * regions or after omp_set_num_threads; then the slabs must not be used for scheduling
+	 */
+	int getSlabOfCurrentThread() const;
+
+	//! @brief range [first, last) of the cell layers along the slab dimension belonging to the slab
+	std::pair<unsigned long, unsigned long> getLayers(int slab) const {
+		return std::make_pair(_firstLayer[slab], _firstLayer[slab + 1]);
+	}
+
+	//! @brief indices of the cells of the slab, in ascending order
+	const std::vector<unsigned long>& getCells(int slab) const { return _cells[slab]; }
+
+private:
+	unsigned short _slabDimension = 2;
+	std::vector<int> _slabOfThread;
+	std::vector<unsigned long> _firstLayer; //!< first layer of each slab, plus the number of layers at the end
+	std::vector<std::vector<unsigned long>> _cells;
+};
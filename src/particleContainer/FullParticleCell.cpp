@@ -11,6 +11,7 @@
 #include "utils/UnorderedVector.h"
 #include "utils/mardyn_assert.h"
 
+#include <algorithm>
 #include <vector>
 
 
@@ -138,6 +139,14 @@ void FullParticleCell::getRegion(double lowCorner[3], double highCorner[3], std:
 	}
 }
 
+void FullParticleCell::sortMolecules(unsigned short dimension) {
+	// the order changes little between two time steps, so mostly sorted input is the common case
+	const auto less = [dimension](const Molecule& a, const Molecule& b) { return a.r(dimension) < b.r(dimension); };
+	if (not std::is_sorted(_molecules.begin(), _molecules.end(), less)) {
+		std::sort(_molecules.begin(), _molecules.end(), less);
+	}
+}
+
 void FullParticleCell::buildSoACaches() {
 
 	// Determine the total number of centers.
@@ -193,3 +202,12 @@ void FullParticleCell::buildSoACaches() {
 void FullParticleCell::increaseMoleculeStorage(size_t numExtraMols) {
 	_molecules.reserve(_molecules.size() + numExtraMols);
 }
+
+void FullParticleCell::relocateMoleculeStorage() {
+	decltype(_molecules) molecules;
+	molecules.reserve(_molecules.capacity());
+	molecules.insert(molecules.end(), _molecules.begin(), _molecules.end());
+	_molecules.swap(molecules);
+	// empty between two updates, it is allocated again by the next one
+	decltype(_leavingMolecules)().swap(_leavingMolecules);
+}
@@ -14,6 +14,7 @@
 #include "particleContainer/ParticleCellBase.h"
 #include "particleContainer/adapter/CellDataSoA.h"
 #include "SingleCellIterator.h"
+#include "utils/PoolAllocator.h"
 
 //! @brief FullParticleCell data structure. Renamed from ParticleCell.
 //! @author Martin Buchholz
@@ -68,6 +69,12 @@ public:
 	//! removes and deallocates all elements
 	void deallocateAllParticles() override;
 
+	//! exchange the stored molecules with those of another cell without copying them
+	void swapParticles(FullParticleCell& other) {
+		_molecules.swap(other._molecules);
+		_leavingMolecules.swap(other._leavingMolecules);
+	}
+
 	//! insert a single molecule into this cell
 	bool addParticle(Molecule& particle, bool checkWhetherDuplicate = false) override;
 
@@ -97,8 +104,14 @@ public:
 
 	void buildSoACaches() override;
 
+	//! sort the molecules by their position in the given dimension, so that consecutive molecules are close
+	//! to each other (see ClusterPairCellProcessor), call before buildSoACaches
+	void sortMolecules(unsigned short dimension);
+
 	void increaseMoleculeStorage(size_t numExtraMols) override;
 
+	void relocateMoleculeStorage() override;
+
 	virtual size_t getMoleculeVectorDynamicSize() const override {
 		return _molecules.capacity() * sizeof(Molecule) + _leavingMolecules.capacity() * sizeof(Molecule);
 	}
@@ -121,12 +134,12 @@ private:
 	/**
 	 * \brief A vector of pointers to the Molecules in this cell.
 	 */
-	std::vector<Molecule> _molecules;
+	std::vector<Molecule, PoolAllocator<Molecule, MemoryPool::CELLS>> _molecules;
 
 	/**
 	 * \brief A vector of molecules, which have left this cell.
 	 */
-	std::vector<Molecule> _leavingMolecules;
+	std::vector<Molecule, PoolAllocator<Molecule, MemoryPool::CELLS>> _leavingMolecules;
 
 	/**
 	 * \brief Structure of arrays for VectorizedCellProcessor.
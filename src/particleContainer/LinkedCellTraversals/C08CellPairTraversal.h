@@ -8,6 +8,8 @@
 #ifndef SRC_PARTICLECONTAINER_LINKEDCELLTRAVERSALS_C08CELLPAIRTRAVERSAL_H_
 #define SRC_PARTICLECONTAINER_LINKEDCELLTRAVERSALS_C08CELLPAIRTRAVERSAL_H_
 
+#include <algorithm>
+
 #include "C08BasedTraversals.h"
 #include "utils/GetChunkSize.h"
 #include "utils/mardyn_assert.h"
@@ -206,6 +208,28 @@ void C08CellPairTraversal<CellTemplate, eighthShell>::traverseCellPairsBackend(C
 	const unsigned long end_x = end[0], end_y = end[1], end_z = end[2];
 	const unsigned long stride_x = stride[0], stride_y = stride[1], stride_z = stride[2];
 
+	const int slab = this->getSlabOfCurrentThread();
+	if (slab >= 0) {
+		// every thread processes the base cells in the layers of its own slab, in place of the dynamic schedule
+		const unsigned short d = this->_slabPartition->getSlabDimension();
+		const auto layers = this->_slabPartition->getLayers(slab);
+		std::array<unsigned long, 3> myStart = start, myEnd = end;
+		if (layers.first > start[d]) {
+			// first layer of the slab reached with the stride
+			myStart[d] = start[d] + (layers.first - start[d] + stride[d] - 1) / stride[d] * stride[d];
+		}
+		myEnd[d] = std::min(end[d], layers.second);
+		for (unsigned long z = myStart[2]; z < myEnd[2]; z += stride_z) {
+			for (unsigned long y = myStart[1]; y < myEnd[1]; y += stride_y) {
+				for (unsigned long x = myStart[0]; x < myEnd[0]; x += stride_x) {
+					unsigned long baseIndex = threeDimensionalMapping::threeToOneD(x, y, z, this->_dims);
+					C08BasedTraversals<CellTemplate>::template processBaseCell<eighthShell>(cellProcessor, baseIndex);
+				}
+			}
+		}
+		return;
+	}
+
 	// number of iterations:
 	const auto loop_size = static_cast<size_t>(std::ceil(static_cast<double>(end_x - start_x) / stride_x) *
 											   std::ceil(static_cast<double>(end_y - start_y) / stride_y) *
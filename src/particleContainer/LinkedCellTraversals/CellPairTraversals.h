@@ -11,6 +11,8 @@
 #include <vector>
 #include <array>
 
+#include "particleContainer/CellSlabPartition.h"
+
 class CellProcessor;
 
 struct CellPairTraversalData {
@@ -46,11 +48,21 @@ public:
 	// @brief Returns the maximum number of cells per cutoff this traversal supports.
 	virtual unsigned maxCellsInCutoff() const { return 1; }
 
+	// @brief Let each thread process the base cells of its own slab, as far as the traversal supports it,
+	// or schedule them as usual for nullptr. The partition has to outlive the traversal or be reset.
+	void setSlabPartition(const CellSlabPartition* partition) { _slabPartition = partition; }
+
 protected:
+	// @brief slab of the calling thread, -1 if the base cells are to be scheduled as usual
+	int getSlabOfCurrentThread() const {
+		return _slabPartition != nullptr ? _slabPartition->getSlabOfCurrentThread() : -1;
+	}
+
 	//TODO:
 	//void traverseCellPairsNoDep(CellProcessor& cellProcessor);
 	std::vector<CellTemplate> * _cells;
 	std::array<unsigned long, 3> _dims;
+	const CellSlabPartition* _slabPartition = nullptr;
 };
 
 #endif /* SRC_PARTICLECONTAINER_LINKEDCELLTRAVERSALS_CELLPAIRTRAVERSALS_H_ */
@@ -193,7 +193,8 @@ inline void OriginalCellPairTraversal<CellTemplate>::processBaseCell(CellProcess
 		}
 	} else
 	// loop over all boundary cells and calculate forces to forward and backward neighbours
-	if (currentCell.isBoundaryCell()) {
+	// (isBoundaryCell() also holds for halo cells next to a boundary layer, e.g. the halo cell at (1,0,0))
+	if (currentCell.isBoundaryCell() and not currentCell.isHaloCell()) {
 		cellProcessor.processCell(currentCell);
 		// loop over all forward neighbours
 		for (auto& neighbourOffset : this->_forwardNeighbourOffsets) {
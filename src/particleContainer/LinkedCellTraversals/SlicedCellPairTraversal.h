@@ -70,10 +70,11 @@ private:
 		NEXT_LOCK
 	};
 
-	void releaseMyLock();
-	void acquireLock(LockType l);
-	void initLocks();
-	void destroyLocks();
+	// myid: position of the calling thread in the chain of slices
+	void releaseMyLock(int myid);
+	void acquireLock(LockType l, int myid);
+	void initLocks(int myid);
+	void destroyLocks(int myid);
 
 	std::vector<mardyn_lock_t *> _locks;
 };
@@ -213,18 +214,20 @@ inline void SlicedCellPairTraversal<CellTemplate>::traverseCellPairsBackend(
 		std::array<unsigned long, 3> diff_permuted = permuteForward(perm, diff);
 		std::array<unsigned long, 3> start_permuted = permuteForward(perm, start);
 
-		initLocks();
-
-		int my_id = mardyn_get_thread_num();
+		// with a slab partition, the threads take the slices in the order of their slabs, see CellSlabPartition
+		const int slab = this->getSlabOfCurrentThread();
+		int my_id = slab >= 0 ? slab : mardyn_get_thread_num();
 		int num_threads = mardyn_get_num_threads();
 
+		initLocks(my_id);
+
 		const unsigned long my_start = num_cells * my_id / num_threads;
 		const unsigned long my_end = num_cells * (my_id + 1) / num_threads;
 		const unsigned long my_num_cells = my_end - my_start; // a rough measure should be enough?
 		const unsigned long slice_size = diff_permuted[0] * diff_permuted[1];
 		unsigned long my_progress_counter = 0;
 
-		acquireLock(MY_LOCK);
+		acquireLock(MY_LOCK, my_id);
 
 		#if defined(_OPENMP)
 		#pragma omp barrier
@@ -235,7 +238,7 @@ inline void SlicedCellPairTraversal<CellTemplate>::traverseCellPairsBackend(
 		// and so on, which I don't know whether is guaranteed by the OpenMP standard.
 		for (unsigned long i = my_start; i < my_end; ++i) {
 			if (my_progress_counter == my_num_cells - slice_size) {
-				acquireLock(NEXT_LOCK);
+				acquireLock(NEXT_LOCK, my_id);
 			}
 
 			// unroll
@@ -257,7 +260,7 @@ inline void SlicedCellPairTraversal<CellTemplate>::traverseCellPairsBackend(
 			++my_progress_counter;
 
 			if (my_progress_counter == slice_size) {
-				releaseMyLock();
+				releaseMyLock(my_id);
 			}
 		}
 
@@ -265,17 +268,16 @@ inline void SlicedCellPairTraversal<CellTemplate>::traverseCellPairsBackend(
 		#pragma omp barrier
 		#endif
 
-		destroyLocks();
+		destroyLocks(my_id);
 	} /* omp parallel */
 }
 
 template<class CellTemplate>
-inline void SlicedCellPairTraversal<CellTemplate>::releaseMyLock() {
+inline void SlicedCellPairTraversal<CellTemplate>::releaseMyLock(int myid) {
 //	#if defined(_OPENMP)
 //	#pragma omp parallel
 //	#endif
 	{
-		int myid = mardyn_get_thread_num();
 		if(myid != 0) {
 			mardyn_unset_lock(_locks[myid - 1]);
 		}
@@ -283,12 +285,11 @@ inline void SlicedCellPairTraversal<CellTemplate>::releaseMyLock() {
 }
 
 template<class CellTemplate>
-inline void SlicedCellPairTraversal<CellTemplate>::acquireLock(LockType l) {
+inline void SlicedCellPairTraversal<CellTemplate>::acquireLock(LockType l, int myid) {
 //	#if defined(_OPENMP)
 //	#pragma omp parallel
 //	#endif
 	{
-		int myid = mardyn_get_thread_num();
 		switch(l) {
 		case MY_LOCK:
 			if (myid != 0) {
@@ -305,12 +306,11 @@ inline void SlicedCellPairTraversal<CellTemplate>::acquireLock(LockType l) {
 }
 
 template<class CellTemplate>
-inline void SlicedCellPairTraversal<CellTemplate>::initLocks() {
+inline void SlicedCellPairTraversal<CellTemplate>::initLocks(int myid) {
 //	#if defined(_OPENMP)
 //	#pragma omp parallel
 //	#endif
 	{
-		int myid = mardyn_get_thread_num();
 		if(myid != 0) {
 			mardyn_init_lock(_locks[myid - 1]);
 		}
@@ -358,12 +358,11 @@ inline bool SlicedCellPairTraversal<CellTemplate>::isApplicable(
 }
 
 template<class CellTemplate>
-inline void SlicedCellPairTraversal<CellTemplate>::destroyLocks() {
+inline void SlicedCellPairTraversal<CellTemplate>::destroyLocks(int myid) {
 //	#if defined(_OPENMP)
 //	#pragma omp parallel
 //	#endif
 	{
-		int myid = mardyn_get_thread_num();
 		if(myid != mardyn_get_num_threads()-1) {
 			mardyn_destroy_lock(_locks[myid]);
 		}
@@ -15,6 +15,7 @@
 #include "utils/Logger.h"
 #include "utils/mardyn_assert.h"
 #include "utils/GetChunkSize.h"
+#include "utils/MemoryPool.h"
 
 #include "particleContainer/TraversalTuner.h"
 
@@ -119,11 +120,34 @@ void LinkedCells::initializeTraversal() {
 		dims[d] = _cellsPerDimension[d];
 	}
 	_traversalTuner->rebuild(_cells, dims, _cellLength, _cutoffRadius);
+	initializeSlabPartition();
+}
+
+void LinkedCells::initializeSlabPartition() {
+	if (not _numaAware or _cells.empty()) {
+		_traversalTuner->setSlabPartition(nullptr);
+		return;
+	}
+	const std::array<unsigned long, 3> dims = {static_cast<unsigned long>(_cellsPerDimension[0]),
+											   static_cast<unsigned long>(_cellsPerDimension[1]),
+											   static_cast<unsigned long>(_cellsPerDimension[2])};
+	_slabPartition.rebuild(dims);
+	_traversalTuner->setSlabPartition(&_slabPartition);
+	_relocateCellStorage = true;
+}
+
+void LinkedCells::setNumaAware(bool numaAware) {
+	_numaAware = numaAware;
+	initializeSlabPartition();
 }
 
 void LinkedCells::readXML(XMLfileUnits& xmlconfig) {
 	_cellsInCutoff = xmlconfig.getNodeValue_int("cellsInCutoffRadius", 1); // new
 	mardyn_assert(_cellsInCutoff>=1); // new
+	_numaAware = xmlconfig.getNodeValue_bool("numaAware", false);
+	if (_numaAware) {
+		Log::global_log->info() << "LinkedCells: threads own slabs of cells placed on their NUMA nodes." << std::endl;
+	}
 
 	_traversalTuner = std::unique_ptr<TraversalTuner<ParticleCell>>(new TraversalTuner<ParticleCell>()); // new way to assign _traversalTuner
 	_traversalTuner->readXML(xmlconfig);
@@ -238,11 +262,49 @@ void LinkedCells::check_molecules_in_box() {
 	}
 }
 
+template<bool dynamicSchedule, typename F>
+void LinkedCells::loopOverCells(F&& f) {
+	const int slab = _numaAware ? _slabPartition.getSlabOfCurrentThread() : -1;
+	if (slab >= 0) {
+		for (unsigned long cellIndex : _slabPartition.getCells(slab)) {
+			f(cellIndex);
+		}
+		#if defined(_OPENMP)
+		#pragma omp barrier
+		#endif
+		return;
+	}
+
+	const unsigned long numCells = _cells.size();
+	if (dynamicSchedule) {
+		// magic numbers: empirically determined to be somewhat efficient.
+		const int chunk_size = chunk_size::getChunkSize(numCells, 10000, 100);
+		#if defined(_OPENMP)
+		#pragma omp for schedule(dynamic, chunk_size)
+		#endif
+		for (unsigned long cellIndex = 0; cellIndex < numCells; cellIndex++) {
+			f(cellIndex);
+		}
+	} else {
+		#if defined(_OPENMP)
+		#pragma omp for schedule(static)
+		#endif
+		for (unsigned long cellIndex = 0; cellIndex < numCells; cellIndex++) {
+			f(cellIndex);
+		}
+	}
+}
+
 void LinkedCells::update() {
 #ifndef NDEBUG
 	check_molecules_in_box();
 #endif
 
+	if (_relocateCellStorage) {
+		relocateCellStorage();
+		_relocateCellStorage = false;
+	}
+
 	// TODO: replace via a cellProcessor and a traverseCells call ?
 #ifndef ENABLE_REDUCED_MEMORY_MODE
 	update_via_copies();
@@ -306,23 +368,15 @@ void LinkedCells::update_via_copies() {
 	std::vector<long> backwardNeighbourOffsets; // now vector
 	calculateNeighbourIndices(forwardNeighbourOffsets, backwardNeighbourOffsets);
 
-	// magic numbers: empirically determined to be somewhat efficient.
-	const int chunk_size = chunk_size::getChunkSize(_cells.size(), 10000, 100);
 	#if defined(_OPENMP)
 	#pragma omp parallel
 	#endif
 	{
-		#if defined(_OPENMP)
-		#pragma omp for schedule(dynamic, chunk_size)
-		#endif
-		for (std::vector<ParticleCell>::size_type cellIndex = 0; cellIndex < numCells; cellIndex++) {
+		loopOverCells<true>([&](unsigned long cellIndex) {
 			_cells[cellIndex].preUpdateLeavingMolecules();
-		}
+		});
 
-		#if defined(_OPENMP)
-		#pragma omp for schedule(dynamic, chunk_size)
-		#endif
-		for (std::vector<ParticleCell>::size_type cellIndex = 0; cellIndex < numCells; cellIndex++) {
+		loopOverCells<true>([&](unsigned long cellIndex) {
 			ParticleCell& cell = _cells[cellIndex];
 
 			for (unsigned long j = 0; j < backwardNeighbourOffsets.size(); j++) {
@@ -343,16 +397,28 @@ void LinkedCells::update_via_copies() {
 				}
 				cell.updateLeavingMoleculesBase(_cells[neighbourIndex]);
 			}
-		}
+		});
 
-		#if defined(_OPENMP)
-		#pragma omp for schedule(dynamic, chunk_size)
-		#endif
-		for (std::vector<ParticleCell>::size_type cellIndex = 0; cellIndex < _cells.size(); cellIndex++) {
+		loopOverCells<true>([&](unsigned long cellIndex) {
 			_cells[cellIndex].postUpdateLeavingMolecules();
-		}
+		});
 	} // end pragma omp parallel
 }
+
+void LinkedCells::relocateCellStorage() {
+	#if defined(_OPENMP)
+	#pragma omp parallel
+	#endif
+	{
+		loopOverCells<true>([&](unsigned long cellIndex) {
+			_cells[cellIndex].relocateMoleculeStorage();
+		});
+		// the freed blocks are cached by the freeing thread and lie on the old node, do not hand them out again
+		MemoryPool::instance().releaseThreadCache();
+	}
+	MemoryPool::instance().releaseSharedCache();
+}
+
 void LinkedCells::update_via_coloring() {
 	std::array<std::pair<unsigned long, unsigned long>, 14> cellPairOffsets = calculateCellPairOffsets();
 
@@ -682,6 +748,109 @@ RegionParticleIterator LinkedCells::regionIterator(const double startRegion[3],
 	return {type, &_cells, offset, stride, static_cast<int>(startRegionCellIndex), regionDimensions.data(), _cellsPerDimension, startRegion, endRegion};
 }
 
+namespace {
+/**
+ * Expresses the distance between two coordinates in cell layers.
+ * @return false if the distance is not a whole number of cell layers
+ */
+bool distanceInCellLayers(double from, double to, double cellLengthReciprocal, long& numLayers) {
+	const double layers = (to - from) * cellLengthReciprocal;
+	numLayers = std::lround(layers);
+	return std::abs(layers - numLayers) < 1e-6;
+}
+}  // namespace
+
+bool LinkedCells::isResizableInPlace(const double bBoxMin[3], const double bBoxMax[3]) const {
+	for (int d = 0; d < 3; ++d) {
+		long lowShift, highShift;
+		if (not distanceInCellLayers(_boundingBoxMin[d], bBoxMin[d], _cellLengthReciprocal[d], lowShift)
+			or not distanceInCellLayers(_boundingBoxMax[d], bBoxMax[d], _cellLengthReciprocal[d], highShift)) {
+			return false;
+		}
+		// in each dimension at least one layer of (inner+boundary) cells necessary
+		if (_boxWidthInNumCells[d] - lowShift + highShift < 1) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool LinkedCells::resizeInPlace(double bBoxMin[3], double bBoxMax[3]) {
+	mardyn_assert(isResizableInPlace(bBoxMin, bBoxMax));
+	Log::global_log->info() << "RESIZE OF LinkedCells" << std::endl;
+	Log::global_log->info() << "Bounding box: " << "[" << bBoxMin[0] << ", " << bBoxMax[0] << "]" << " x " << "["
+			<< bBoxMin[1] << ", " << bBoxMax[1] << "]" << " x " << "[" << bBoxMin[2] << ", " << bBoxMax[2] << "]"
+			<< std::endl;
+
+	// number of cell layers added at the low faces, negative if layers are removed
+	long grownLow[3];
+	int oldCellsPerDimension[3];
+	int numberOfCells = 1;
+	for (int dim = 0; dim < 3; dim++) {
+		long lowShift, highShift;
+		distanceInCellLayers(_boundingBoxMin[dim], bBoxMin[dim], _cellLengthReciprocal[dim], lowShift);
+		distanceInCellLayers(_boundingBoxMax[dim], bBoxMax[dim], _cellLengthReciprocal[dim], highShift);
+		grownLow[dim] = -lowShift;
+		oldCellsPerDimension[dim] = _cellsPerDimension[dim];
+
+		_boxWidthInNumCells[dim] += highShift - lowShift;
+		_cellsPerDimension[dim] = _boxWidthInNumCells[dim] + 2 * _haloWidthInNumCells[dim];
+		numberOfCells *= _cellsPerDimension[dim];
+
+		_boundingBoxMin[dim] = bBoxMin[dim];
+		_boundingBoxMax[dim] = bBoxMax[dim];
+		_haloBoundingBoxMin[dim] = _boundingBoxMin[dim] - _haloLength[dim];
+		_haloBoundingBoxMax[dim] = _boundingBoxMax[dim] + _haloLength[dim];
+	}
+
+	Log::global_log->info() << "Cells per dimension (incl. halo): " << _cellsPerDimension[0] << " x "
+			<< _cellsPerDimension[1] << " x " << _cellsPerDimension[2] << std::endl;
+
+	// Cells which stay part of the grid hand their molecules over to their new index. The molecules of the
+	// remaining old cells are outside of the new halo region and are lost together with these cells, as in rebuild.
+	std::vector<ParticleCell> newCells(numberOfCells);
+	#if defined(_OPENMP)
+	#pragma omp parallel for schedule(static)
+	#endif
+	for (int iz = 0; iz < _cellsPerDimension[2]; ++iz) {
+		const long oz = iz - grownLow[2];
+		if (oz < 0 or oz >= oldCellsPerDimension[2]) {
+			continue;
+		}
+		for (int iy = 0; iy < _cellsPerDimension[1]; ++iy) {
+			const long oy = iy - grownLow[1];
+			if (oy < 0 or oy >= oldCellsPerDimension[1]) {
+				continue;
+			}
+			for (int ix = 0; ix < _cellsPerDimension[0]; ++ix) {
+				const long ox = ix - grownLow[0];
+				if (ox < 0 or ox >= oldCellsPerDimension[0]) {
+					continue;
+				}
+				const long oldIndex = (oz * oldCellsPerDimension[1] + oy) * oldCellsPerDimension[0] + ox;
+				newCells[cellIndexOf3DIndex(ix, iy, iz)].swapParticles(_cells[oldIndex]);
+			}
+		}
+	}
+	_cells.swap(newCells);
+
+	bool sendParticlesTogether = true;
+	// If the width of the inner region is less than the width of the halo region
+	// leaving particles and halo copy must be sent separately.
+	if (_boxWidthInNumCells[0] < 2 * _haloWidthInNumCells[0]
+			|| _boxWidthInNumCells[1] < 2 * _haloWidthInNumCells[1]
+			|| _boxWidthInNumCells[2] < 2 * _haloWidthInNumCells[2]) {
+		sendParticlesTogether = false;
+	}
+
+	initializeCells();
+	initializeTraversal();
+
+	_cellsValid = false;
+
+	return sendParticlesTogether;
+}
+
 //################################################
 //############ PRIVATE METHODS ###################
 //################################################
@@ -1074,36 +1243,42 @@ double LinkedCells::getEnergy(ParticlePairsHandler* particlePairsHandler, Molecu
 
 void LinkedCells::updateInnerMoleculeCaches() {
 	#if defined(_OPENMP)
-	#pragma omp parallel for schedule(static)
+	#pragma omp parallel
 	#endif
-	for (size_t cellIndex = 0; cellIndex < _cells.size(); cellIndex++) {
+	loopOverCells<false>([&](unsigned long cellIndex) {
 		if(_cells[cellIndex].isInnerCell()){
-			_cells[cellIndex].buildSoACaches();
+			sortAndBuildSoACache(_cells[cellIndex]);
 		}
-	}
+	});
 }
 
 void LinkedCells::updateBoundaryAndHaloMoleculeCaches() {
 	#if defined(_OPENMP)
-	#pragma omp parallel for schedule(static)
+	#pragma omp parallel
 	#endif
-	for (size_t cellIndex = 0; cellIndex < _cells.size(); cellIndex++) {
+	loopOverCells<false>([&](unsigned long cellIndex) {
 		if (_cells[cellIndex].isHaloCell() or _cells[cellIndex].isBoundaryCell()) {
-			_cells[cellIndex].buildSoACaches();
+			sortAndBuildSoACache(_cells[cellIndex]);
 		}
-	}
+	});
 }
 
 void LinkedCells::updateMoleculeCaches() {
-	// magic numbers: empirically determined to be somewhat efficient.
-	const int chunk_size = chunk_size::getChunkSize(_cells.size(), 10000, 100);
-
 	#if defined(_OPENMP)
-	#pragma omp parallel for schedule(dynamic, chunk_size)
+	#pragma omp parallel
 	#endif
-	for (size_t cellIndex = 0; cellIndex < _cells.size(); cellIndex++) {
-		_cells[cellIndex].buildSoACaches();
+	loopOverCells<true>([&](unsigned long cellIndex) {
+		sortAndBuildSoACache(_cells[cellIndex]);
+	});
+}
+
+void LinkedCells::sortAndBuildSoACache(ParticleCell& cell) {
+#ifndef ENABLE_REDUCED_MEMORY_MODE
+	if (_sortCells) {
+		cell.sortMolecules(2);
 	}
+#endif
+	cell.buildSoACaches();
 }
 
 size_t LinkedCells::getTotalSize() {
@@ -1162,7 +1337,47 @@ std::variant<ParticleIterator, SingleCellIterator<ParticleCell>> LinkedCells::ge
 	return {};
 }
 
-bool LinkedCells::requiresForceExchange() const {return _traversalTuner->getCurrentOptimalTraversal()->requiresForceExchange();}
+ParticleContainer::MoleculeSlot LinkedCells::getMoleculeSlot(ParticleIterator& moleculeIter) {
+	return {moleculeIter.getCellIndex(), moleculeIter.getMolIndex()};
+}
+
+bool LinkedCells::addHaloParticleAndGetSlot(Molecule& particle, MoleculeSlot& slot, bool checkWhetherDuplicate) {
+	mardyn_assert(not particle.inBox(_boundingBoxMin, _boundingBoxMax));
+	if (not particle.inBox(_haloBoundingBoxMin, _haloBoundingBoxMax)) {
+		return false;
+	}
+	slot.cell = getCellIndexOfMolecule(&particle);
+	ParticleCell& cell = _cells[slot.cell];
+	if (not cell.addParticle(particle, checkWhetherDuplicate)) {
+		return false;
+	}
+	// molecules are appended to the cell
+	slot.index = cell.getMoleculeCount() - 1;
+	return true;
+}
+
+SingleCellIterator<ParticleCell> LinkedCells::getMoleculeAtSlot(const MoleculeSlot& slot, unsigned long id) {
+	mardyn_assert(slot.cell < _cells.size());
+	ParticleCell& cell = _cells[slot.cell];
+	if (slot.index < static_cast<size_t>(cell.getMoleculeCount())) {
+		SingleCellIterator<ParticleCell> atSlot(&cell, slot.index);
+		if (atSlot->getID() == id) {
+			return atSlot;
+		}
+	}
+	// molecules of the cell were deleted or reordered since the slot was determined
+	size_t index;
+	if (cell.findMoleculeByID(index, id)) {
+		return SingleCellIterator<ParticleCell>(&cell, index);
+	}
+	return {};
+}
+
+bool LinkedCells::requiresForceExchange() const {
+	// no traversal is selected before the first traversal
+	const auto* traversal = _traversalTuner->getCurrentOptimalTraversal();
+	return traversal != nullptr and traversal->requiresForceExchange();
+}
 
 std::vector<unsigned long> LinkedCells::getParticleCellStatistics() {
 	int maxParticles = 0;
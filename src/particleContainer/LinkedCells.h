@@ -10,6 +10,7 @@
 #include "particleContainer/ParticleIterator.h"
 #include "particleContainer/RegionParticleIterator.h"
 #include "particleContainer/ParticleCell.h"
+#include "particleContainer/CellSlabPartition.h"
 
 #include "WrapOpenMP.h"
 
@@ -104,6 +105,9 @@ public:
 	 * \code{.xml}
 		<datastructure type="LinkedCells">
 			<cellsInCutoffRadius>INTEGER</cellsInCutoffRadius>
+			<!-- each thread owns a slab of cells, allocates their molecules and caches and traverses them with c08
+				and sliced, so that they stay on its NUMA node; requires pinned threads, e.g. OMP_PROC_BIND=close -->
+			<numaAware>BOOL</numaAware>  <!-- default false -->
 			<!-- from TraversalTuner: -->
 			<!-- select traversal algorithm
 				possible values are:
@@ -138,6 +142,14 @@ public:
 	// documentation see father class (ParticleContainer.h)
 	bool rebuild(double bBoxMin[3], double bBoxMax[3]) override;
 
+	//! The new region can be reached in place if all its faces lie on the current cell grid,
+	//! i.e. each face moves by a whole number of cell layers, and at least one layer of inner cells remains.
+	bool isResizableInPlace(const double bBoxMin[3], const double bBoxMax[3]) const override;
+
+	//! Adds and removes whole cell layers at each face. The cells which stay part of the grid are re-indexed,
+	//! their molecules are moved over without copying them, the cell length stays unchanged.
+	bool resizeInPlace(double bBoxMin[3], double bBoxMax[3]) override;
+
 	//! Pointers to the particles are put into cells depending on the spacial position
 	//! of the particles.
 	//! Before the call of this method, this distribution might have become invalid.
@@ -215,6 +227,15 @@ public:
 	 */
 	std::variant<ParticleIterator, SingleCellIterator<ParticleCell>> getMoleculeAtPosition(const double pos[3]) override;
 
+	//! @return false while the cells are sorted, as sorting moves the molecules after the halo exchange recorded their slots
+	bool providesMoleculeSlots() const override { return not _sortCells; }
+
+	MoleculeSlot getMoleculeSlot(ParticleIterator& moleculeIter) override;
+
+	bool addHaloParticleAndGetSlot(Molecule& particle, MoleculeSlot& slot, bool checkWhetherDuplicate = false) override;
+
+	SingleCellIterator<ParticleCell> getMoleculeAtSlot(const MoleculeSlot& slot, unsigned long id) override;
+
 	//! @brief Get the index in the cell vector to which this Molecule belongs
 	//!
 	//! each spatial position within the bounding box of the linked cells
@@ -244,6 +265,20 @@ public:
 	// documentation in base class
 	virtual void updateMoleculeCaches() override;
 
+	//! @brief sort the molecules of each cell along z whenever the caches are updated
+	//!
+	//! Consecutive molecules are then close to each other, as required by ClusterPairCellProcessor. The returned halo
+	//! forces are then matched to the molecules by position (getMoleculeAtPosition()) instead of by slot, see
+	//! providesMoleculeSlots().
+	void setCellSorting(bool sortCells) { _sortCells = sortCells; }
+
+	//! @brief let each thread own a slab of cells and place the storage of these cells on its NUMA node
+	//! @details see CellSlabPartition; the cells are relocated at the beginning of the next update()
+	void setNumaAware(bool numaAware);
+
+	//! @brief the tuner holding all traversals of the cells, e.g. to switch between them for benchmarking
+	TraversalTuner<ParticleCell>& getTraversalTuner() { return *_traversalTuner; }
+
 	ParticleIterator iterator (ParticleIterator::Type t) override {
 		const ParticleIterator::CellIndex_T offset = mardyn_get_thread_num();
 		const ParticleIterator::CellIndex_T stride = mardyn_get_num_threads();
@@ -282,6 +317,22 @@ private:
 
 	void initializeTraversal();
 
+	//! @brief rebuild the slab partition of the cells if NUMA-aware, and pass it to the traversals
+	void initializeSlabPartition();
+
+	//! @brief call f(cellIndex) for all cells from within a parallel region, with a barrier at the end
+	//!
+	//! If NUMA-aware, every thread visits the cells of its own slab, otherwise the cells are scheduled
+	//! dynamically or, if dynamicSchedule is false, statically.
+	template<bool dynamicSchedule, typename F>
+	void loopOverCells(F&& f);
+
+	//! @brief let the owner of each cell allocate its molecule storage anew (first touch)
+	void relocateCellStorage();
+
+	//! @brief sort the molecules of the cell if requested by setCellSorting, then build its cache
+	void sortAndBuildSoACache(ParticleCell& cell);
+
 	//! @brief Calculate neighbour indices.
 	//!
 	//! This method is executed once for the molecule container and not for
@@ -349,6 +400,10 @@ private:
 	double _cellLengthReciprocal[3]; //!< 1.0 / _cellLength, to speed-up particle sorting
 	double _cutoffRadius; //!< RDF/electrostatics cutoff radius
 	unsigned _cellsInCutoff = 1; //!< Cells in cutoff radius -> cells with size cutoff / cellsInCutoff
+	bool _sortCells = false; //!< sort the molecules of each cell before building its cache, see setCellSorting
+	bool _numaAware = false; //!< threads own the cells of their slab, see setNumaAware
+	bool _relocateCellStorage = false; //!< relocate the cells at the next update, set when the slabs change
+	CellSlabPartition _slabPartition; //!< cells of each thread if NUMA-aware
 
 	//! @brief True if all Particles are in the right cell
 	//!
@@ -0,0 +1,174 @@
+/*
+ * LocalDensity.cpp
+ */
+
+#include "LocalDensity.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <utility>
+
+#include "WrapOpenMP.h"
+#include "molecules/Molecule.h"
+#include "particleContainer/ParticleContainer.h"
+
+void LocalDensity::bin(ParticleContainer* container, double cutoff) {
+	_cutoff = cutoff;
+	double boxMin[3], boxMax[3], binMax[3];
+	for (int d = 0; d < 3; d++) {
+		boxMin[d] = container->getBoundingBoxMin(d);
+		boxMax[d] = container->getBoundingBoxMax(d);
+		// halo copies farther away than the cutoff radius are no neighbours of owned molecules
+		_binMin[d] = boxMin[d] - cutoff;
+		binMax[d] = boxMax[d] + cutoff;
+		const double extent = binMax[d] - _binMin[d];
+		// bins of at least the cutoff radius, so only the direct neighbour bins have to be searched
+		_numBins[d] = std::max(1, static_cast<int>(std::floor(extent / cutoff)));
+		_binLengthReciprocal[d] = _numBins[d] / extent;
+	}
+	const size_t totalBins = static_cast<size_t>(_numBins[0]) * _numBins[1] * _numBins[2];
+
+	// collect bin index, position and component of the molecules per thread, then sort them into the bins (counting
+	// sort)
+	struct BinnedMolecule {
+		size_t bin;
+		std::array<double, 3> r;
+		int componentId;
+	};
+	std::vector<std::vector<BinnedMolecule>> threadData(mardyn_get_max_threads());
+	std::vector<std::vector<Molecule*>> threadMolecules(mardyn_get_max_threads());
+	#if defined(_OPENMP)
+	#pragma omp parallel
+	#endif
+	{
+		auto& local = threadData[mardyn_get_thread_num()];
+		auto& localMolecules = threadMolecules[mardyn_get_thread_num()];
+		for (auto m = container->regionIterator(_binMin, binMax, ParticleIterator::ALL_CELLS); m.isValid(); ++m) {
+			int b[3];
+			for (int d = 0; d < 3; d++) {
+				b[d] = std::min(static_cast<int>(std::floor((m->r(d) - _binMin[d]) * _binLengthReciprocal[d])),
+								_numBins[d] - 1);
+			}
+			local.push_back({(static_cast<size_t>(b[2]) * _numBins[1] + b[1]) * _numBins[0] + b[0],
+							 {m->r(0), m->r(1), m->r(2)}, static_cast<int>(m->componentid())});
+			if (m->inBox(boxMin, boxMax)) {
+				localMolecules.push_back(&(*m));
+			}
+		}
+	}
+
+	_binStart.assign(totalBins + 1, 0);
+	size_t numBinned = 0;
+	for (const auto& local : threadData) {
+		for (const auto& entry : local) {
+			++_binStart[entry.bin + 1];
+		}
+		numBinned += local.size();
+	}
+	for (size_t b = 0; b < totalBins; b++) {
+		_binStart[b + 1] += _binStart[b];
+	}
+
+	_binnedX.resize(numBinned);
+	_binnedY.resize(numBinned);
+	_binnedZ.resize(numBinned);
+	_binnedComponent.resize(numBinned);
+	std::vector<size_t> next(_binStart.begin(), _binStart.end() - 1);
+	for (const auto& local : threadData) {
+		for (const auto& entry : local) {
+			const size_t j = next[entry.bin]++;
+			_binnedX[j] = entry.r[0];
+			_binnedY[j] = entry.r[1];
+			_binnedZ[j] = entry.r[2];
+			_binnedComponent[j] = entry.componentId;
+		}
+	}
+
+	_ownedMolecules.clear();
+	for (const auto& localMolecules : threadMolecules) {
+		_ownedMolecules.insert(_ownedMolecules.end(), localMolecules.begin(), localMolecules.end());
+	}
+}
+
+unsigned LocalDensity::countNeighbours(const double r[3], unsigned maxCount, int halfSpaceDim, int componentId) const {
+	const double cutoffSquare = _cutoff * _cutoff;
+	const double* const x = _binnedX.data();
+	const double* const y = _binnedY.data();
+	const double* const z = _binnedZ.data();
+	const int* const component = _binnedComponent.data();
+	const bool anyComponent = componentId < 0;
+	// without a half space, a coordinate difference of -1 always passes the test
+	const double* const half = halfSpaceDim == 0 ? x : (halfSpaceDim == 1 ? y : z);
+	const double halfRef = halfSpaceDim < 0 ? 0. : r[halfSpaceDim];
+	const double halfScale = halfSpaceDim < 0 ? 0. : 1.;
+	const double halfOffset = halfSpaceDim < 0 ? -1. : 0.;
+
+	int b[3];
+	for (int d = 0; d < 3; d++) {
+		b[d] = std::min(static_cast<int>(std::floor((r[d] - _binMin[d]) * _binLengthReciprocal[d])), _numBins[d] - 1);
+		if (b[d] < 0) {
+			b[d] = 0;
+		}
+	}
+
+	unsigned neighbours = 0;
+	for (int bz = std::max(b[2] - 1, 0); bz <= std::min(b[2] + 1, _numBins[2] - 1); bz++) {
+		for (int by = std::max(b[1] - 1, 0); by <= std::min(b[1] + 1, _numBins[1] - 1); by++) {
+			// the bins along x are contiguous in memory
+			const size_t rowOffset = (static_cast<size_t>(bz) * _numBins[1] + by) * _numBins[0];
+			const size_t begin = _binStart[rowOffset + std::max(b[0] - 1, 0)];
+			const size_t end = _binStart[rowOffset + std::min(b[0] + 1, _numBins[0] - 1) + 1];
+
+			unsigned rowNeighbours = 0;
+			#if defined(_OPENMP)
+			#pragma omp simd reduction(+ : rowNeighbours)
+			#endif
+			for (size_t j = begin; j < end; j++) {
+				const double dx = x[j] - r[0];
+				const double dy = y[j] - r[1];
+				const double dz = z[j] - r[2];
+				const double dh = (half[j] - halfRef) * halfScale + halfOffset;
+				const bool componentMatches = anyComponent or component[j] == componentId;
+				rowNeighbours += (dx * dx + dy * dy + dz * dz < cutoffSquare and dh <= 0. and componentMatches) ? 1 : 0;
+			}
+			neighbours += rowNeighbours;
+			if (neighbours > maxCount) {
+				return neighbours;
+			}
+		}
+	}
+	return neighbours;
+}
+
+void LocalDensity::computeDensities(const double regionMin[3], const double regionMax[3], double liquidDensity,
+									Densities& result, int halfSpaceDim, int componentId) const {
+	result.molecules.clear();
+	for (Molecule* m : _ownedMolecules) {
+		if (componentId >= 0 and static_cast<int>(m->componentid()) != componentId) {
+			continue;
+		}
+		if (m->r(0) >= regionMin[0] and m->r(0) < regionMax[0] and m->r(1) >= regionMin[1] and
+			m->r(1) < regionMax[1] and m->r(2) >= regionMin[2] and m->r(2) < regionMax[2]) {
+			result.molecules.push_back(m);
+		}
+	}
+
+	const double sphereVolume = 4. / 3. * M_PI * _cutoff * _cutoff * _cutoff;
+	const double invVolume = 1. / (halfSpaceDim < 0 ? sphereVolume : 0.5 * sphereVolume);
+	const long numMolecules = result.molecules.size();
+	result.densities.resize(numMolecules);
+	result.phases.resize(numMolecules);
+	#if defined(_OPENMP)
+	#pragma omp parallel for schedule(static)
+	#endif
+	for (long i = 0; i < numMolecules; i++) {
+		const Molecule& m = *result.molecules[i];
+		const double r[3] = {m.r(0), m.r(1), m.r(2)};
+		// the molecule itself is binned as well
+		const unsigned neighbours =
+			countNeighbours(r, std::numeric_limits<unsigned>::max(), halfSpaceDim, componentId) - 1;
+		result.densities[i] = neighbours * invVolume;
+		result.phases[i] = result.densities[i] >= liquidDensity ? LIQUID : VAPOR;
+	}
+}
@@ -0,0 +1,85 @@
+/*
+ * LocalDensity.h
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "molecules/MoleculeForwardDeclaration.h"
+
+class ParticleContainer;
+
+/**
+ * \brief Neighbour counts, local densities and phase labels of molecules within a short cutoff radius.
+ * \details The positions of all molecules of the container, halo copies included, are sorted into a grid of bins at
+ * least one cutoff radius wide (CSR layout, coordinates in separate arrays). The neighbours of a point are then counted
+ * by a vectorized distance check against the molecules of the 27 surrounding bins. One pass over the owned molecules
+ * of a region yields their local densities and a vapor/liquid label, so plugins tracking phases or interfaces do not
+ * need pair loops of their own.
+ *
+ * The binning does not depend on the region, the component or the liquid density, so all plugins using the same
+ * cutoff radius in a time step can share one instance, see Domain::getLocalDensity.
+ *
+ * The halo of the container has to be at least as wide as the cutoff radius, otherwise molecules near the subdomain
+ * boundaries miss neighbours.
+ */
+class LocalDensity {
+public:
+	enum Phase : uint8_t {
+		VAPOR = 0, LIQUID = 1
+	};
+
+	//! @brief owned molecules of a region with their local densities and phases, see computeDensities
+	struct Densities {
+		std::vector<Molecule*> molecules;
+		std::vector<double> densities;
+		std::vector<Phase> phases;
+	};
+
+	/**
+	 * @brief sort all molecules of the container, halo copies included, into the bins
+	 * @param container the molecules
+	 * @param cutoff radius of the neighbourhood
+	 */
+	void bin(ParticleContainer* container, double cutoff);
+
+	double getCutoff() const {
+		return _cutoff;
+	}
+
+	/**
+	 * @brief number of binned molecules closer than the cutoff radius to r
+	 * @param maxCount counting stops as soon as this number is exceeded
+	 * @param halfSpaceDim if not negative, only molecules with a coordinate in this dimension not larger than the one
+	 * of r are counted
+	 * @param componentId only molecules of this component (zero based) are counted, all if negative
+	 */
+	unsigned countNeighbours(const double r[3], unsigned maxCount = std::numeric_limits<unsigned>::max(),
+							 int halfSpaceDim = -1, int componentId = -1) const;
+
+	/**
+	 * @brief local density and phase of all owned molecules inside the region
+	 * @details The local density is the number of neighbours (without the molecule itself) per volume of the sphere,
+	 * or half sphere with halfSpaceDim (see countNeighbours). Molecules with a local density of at least liquidDensity
+	 * are labelled liquid.
+	 * @param componentId only molecules of this component (zero based) are labelled and counted as neighbours, all if
+	 * negative
+	 */
+	void computeDensities(const double regionMin[3], const double regionMax[3], double liquidDensity,
+						  Densities& result, int halfSpaceDim = -1, int componentId = -1) const;
+
+private:
+	double _cutoff = 0.;
+	double _binMin[3] = {0., 0., 0.};
+	double _binLengthReciprocal[3] = {1., 1., 1.};
+	int _numBins[3] = {0, 0, 0};
+	std::vector<size_t> _binStart;
+	std::vector<double> _binnedX, _binnedY, _binnedZ;
+	std::vector<int> _binnedComponent;
+
+	std::vector<Molecule*> _ownedMolecules;
+};
@@ -63,6 +63,10 @@ public:
 
 	virtual void increaseMoleculeStorage(size_t numMols) = 0;
 
+	//! @brief move the stored molecules to storage newly allocated, and thereby first touched, by the calling thread
+	//! @details Used to place the cells on the NUMA node of the thread owning them, does nothing by default.
+	virtual void relocateMoleculeStorage() {}
+
 	virtual bool testPointInCell(const double point[3]) const {
 		double boxMin[3] = {getBoxMin(0), getBoxMin(1), getBoxMin(2)};
 		double boxMax[3] = {getBoxMax(0), getBoxMax(1), getBoxMax(2)};
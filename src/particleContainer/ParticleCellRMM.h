@@ -5,6 +5,8 @@
 #include "SingleCellIterator.h"
 #include "particleContainer/adapter/CellDataSoARMM.h"
 
+#include <utility>
+
 class ParticleCellRMM: public ParticleCellBase {
 public:
 	ParticleCellRMM();
@@ -45,6 +47,11 @@ public:
 
 	void swapMolecules(int i, ParticleCellRMM& other, int j);
 
+	//! exchange the stored molecules with those of another cell
+	void swapParticles(ParticleCellRMM& other) {
+		std::swap(_cellDataSoARMM, other._cellDataSoARMM);
+	}
+
 	CellDataSoARMM & getCellDataSoA() {return _cellDataSoARMM;}
 
 	size_t getMoleculeVectorDynamicSize() const override {return 0;}
@@ -2,6 +2,9 @@
 
 #include "molecules/Molecule.h"
 #include "utils/Logger.h"
+#include "utils/mardyn_assert.h"
+
+#include <sstream>
 
 
 ParticleContainer::ParticleContainer(double bBoxMin[3], double bBoxMax[3]) {
@@ -49,3 +52,25 @@ bool ParticleContainer::addHaloParticle(Molecule& particle, bool inBoxCheckedAlr
 	mardyn_assert(not particle.inBox(_boundingBoxMin,_boundingBoxMax));
 	return addParticle(particle, inBoxCheckedAlready, checkWhetherDuplicate, rebuildCaches);
 }
+
+ParticleContainer::MoleculeSlot ParticleContainer::getMoleculeSlot(ParticleIterator& /*moleculeIter*/) {
+	std::ostringstream error_message;
+	error_message << "ParticleContainer: this container does not provide molecule slots." << std::endl;
+	MARDYN_EXIT(error_message.str());
+	return {};
+}
+
+bool ParticleContainer::addHaloParticleAndGetSlot(Molecule& /*particle*/, MoleculeSlot& /*slot*/,
+												  bool /*checkWhetherDuplicate*/) {
+	std::ostringstream error_message;
+	error_message << "ParticleContainer: this container does not provide molecule slots." << std::endl;
+	MARDYN_EXIT(error_message.str());
+	return false;
+}
+
+SingleCellIterator<ParticleCell> ParticleContainer::getMoleculeAtSlot(const MoleculeSlot& /*slot*/, unsigned long /*id*/) {
+	std::ostringstream error_message;
+	error_message << "ParticleContainer: this container does not provide molecule slots." << std::endl;
+	MARDYN_EXIT(error_message.str());
+	return {};
+}
@@ -95,6 +95,28 @@ public:
 	//! @parameter bBoxMax maximum of the box
 	virtual bool rebuild(double bBoxMin[3], double bBoxMax[3]);
 
+	//! @brief check whether resizeInPlace can be used to move the datastructure to the given region
+	//!
+	//! Containers which can not adapt their datastructure to a new region without rebuilding it
+	//! return false, which is the default.
+	//! @parameter bBoxMin minimum of the new box
+	//! @parameter bBoxMax maximum of the new box
+	virtual bool isResizableInPlace(const double /*bBoxMin*/[3], const double /*bBoxMax*/[3]) const {
+		return false;
+	}
+
+	//! @brief move the datastructure to a new region, keeping the particles stored within
+	//!
+	//! In contrast to rebuild, the particles are not copied out and sorted in again. Only particles
+	//! outside of the new halo region are lost, so the caller has to send them away beforehand.
+	//! May only be called if isResizableInPlace returns true for the same region.
+	//! @parameter bBoxMin minimum of the new box
+	//! @parameter bBoxMax maximum of the new box
+	//! @return same as for rebuild
+	virtual bool resizeInPlace(double bBoxMin[3], double bBoxMax[3]) {
+		return rebuild(bBoxMin, bBoxMax);
+	}
+
 	//! @brief do necessary updates resulting from changed particle positions
 	//!
 	//! For some implementations of the interface ParticleContainer, the place
@@ -227,6 +249,38 @@ public:
 	 */
 	virtual std::variant<ParticleIterator, SingleCellIterator<ParticleCell>> getMoleculeAtPosition(const double pos[3]) = 0;
 
+	/**
+	 * @brief Storage location of a molecule, which allows to access it again without a search.
+	 *
+	 * The cell of a slot stays valid until the container is updated. Deleting molecules from the cell or sorting it
+	 * moves the molecules within the cell, therefore getMoleculeAtSlot() checks the id of the molecule at the slot.
+	 */
+	struct MoleculeSlot {
+		size_t cell;   //!< index of the cell
+		size_t index;  //!< index of the molecule within the cell
+	};
+
+	//! @return true, if the container supports getMoleculeSlot(), addHaloParticleAndGetSlot() and getMoleculeAtSlot()
+	virtual bool providesMoleculeSlots() const { return false; }
+
+	//! @return the slot of the molecule the iterator points to
+	virtual MoleculeSlot getMoleculeSlot(ParticleIterator& moleculeIter);
+
+	/**
+	 * @brief Adds a halo molecule like addHaloParticle() and determines where it is stored.
+	 * @param slot set to the slot of the added molecule
+	 * @param checkWhetherDuplicate if true, the molecule is not added if a molecule with the same id is stored already
+	 * @return true if the molecule was added, false if it is a duplicate or outside the halo
+	 */
+	virtual bool addHaloParticleAndGetSlot(Molecule& particle, MoleculeSlot& slot, bool checkWhetherDuplicate = false);
+
+	/**
+	 * @brief Gets a molecule by its slot.
+	 * @param id id of the molecule; if the slot holds another molecule, the cell of the slot is searched for it
+	 * @return Iterator to the molecule, invalid if the cell does not contain it any more.
+	 */
+	virtual SingleCellIterator<ParticleCell> getMoleculeAtSlot(const MoleculeSlot& slot, unsigned long id);
+
 	// @brief Should the domain decomposition exchange calculated forces at the boundaries,
 	// or does this particle container calculate all forces.
 	virtual bool requiresForceExchange() const {return false;}
@@ -84,6 +84,9 @@ public:
 
 	CellIndex_T getCellIndex(){return _cell_index;}
 
+	//! @return index of the current molecule within its cell
+	MolIndex_T getMolIndex() const {return _cell_iterator.getIndex();}
+
 	bool isValid() const {
 		return _cells != nullptr and _cell_index < _cells->size() and _cell_iterator.isValid();
 	}
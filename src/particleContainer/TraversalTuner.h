@@ -2,6 +2,7 @@
 #define TRAVERSALTUNER_H_
 
 #include <algorithm>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -67,10 +68,33 @@ public:
 	bool isTraversalApplicable(traversalNames name, const std::array<unsigned long, 3> &dims) const; // new
 
 
+	bool isTraversalApplicable(traversalNames name) const { return isTraversalApplicable(name, _dims); }
+
+
 	traversalNames getSelectedTraversal() const {
 		return selectedTraversal;
 	}
 
+	/**
+	 * Select the traversal used from the next traversal on, e.g. to compare the traversals on the same cells.
+	 * The cells have to be built already (see rebuild()).
+	 */
+	void selectTraversal(traversalNames name) {
+		selectedTraversal = name;
+		_optimalTraversal = nullptr;
+	}
+
+	static std::string getTraversalName(traversalNames name);
+
+	//! @brief pass the slab partition of the cells to all traversals, see CellPairTraversals::setSlabPartition
+	void setSlabPartition(const CellSlabPartition* partition) {
+		for (auto& t : _traversals) {
+			if (t.first != nullptr) {
+				t.first->setSlabPartition(partition);
+			}
+		}
+	}
+
 	CellPairTraversals<ParticleCell> *getCurrentOptimalTraversal() { return _optimalTraversal; }
 
 private:
@@ -364,6 +388,22 @@ void TraversalTuner<CellTemplate>::traverseCellPairsInner(CellProcessor &cellPro
 	_optimalTraversal->traverseCellPairsInner(cellProcessor, stage, stageCount);
 }
 
+template<class CellTemplate>
+std::string TraversalTuner<CellTemplate>::getTraversalName(traversalNames name) {
+	switch (name) {
+		case ORIGINAL: return "ori";
+		case C08: return "c08";
+		case C04: return "c04";
+		case SLICED: return "sliced";
+		case HS: return "hs";
+		case MP: return "mp";
+		case C08ES: return "c08es";
+		case NT: return "nt";
+		case QSCHED: return "quicksched";
+	}
+	return "unknown";
+}
+
 template<class CellTemplate>
 inline bool TraversalTuner<CellTemplate>::isTraversalApplicable(
 		traversalNames name, const std::array<unsigned long, 3> &dims) const {
@@ -14,6 +14,7 @@
 #include "vectorization/SIMD_TYPES.h"
 #include <cstdint>
 #include <array>
+#include <vector>
 
 /**
  * \brief Structure of Arrays for vectorized force calculation.
@@ -31,6 +32,15 @@ public:
 		resize(mol_arg, ljc_arg, charges_arg, dipoles_arg, quadrupoles_arg);
 	}
 
+	/**
+	 * \brief	Type of each LJ center lookup id, copied to _ljc_type when the SoA is filled.
+	 * \details	Set by the VectorizedCellProcessor: centers of one type share their LJ parameters,
+	 * 			which are stored in a compact table indexed by the types of both centers.
+	 * 			Increment ljcTypesVersion whenever the types change, see refreshLJCTypes().
+	 */
+	inline static std::vector<vcp_ljc_id_t> ljcTypes;
+	inline static unsigned long ljcTypesVersion = 0;
+
 	/**
 	 * \brief
 	 */
@@ -43,6 +53,7 @@ public:
 	size_t _dipoles_num;
 	size_t _quadrupoles_num;
 	size_t _centers_num;
+	unsigned long _ljc_types_version = 0; // version of ljcTypes copied to _ljc_type
 
 	// entries per molecule
 	AlignedArrayTriplet<vcp_real_calc> _mol_pos;
@@ -59,6 +70,7 @@ public:
 
 	// entries per lj center
 	AlignedArray<vcp_ljc_id_t> _ljc_id;
+	AlignedArray<vcp_ljc_id_t> _ljc_type; // see ljcTypes
 
 	// entries per charge
 	AlignedArray<vcp_real_calc> _charges_q;
@@ -139,6 +151,20 @@ public:
 		setTripletCalc(moleculePos, QuantityType::MOL_POSITION, SiteType::LJC, index);
 		setTripletCalc(centerPos, QuantityType::CENTER_POSITION, SiteType::LJC, index);
 		_ljc_id[index] = lookUpIndex;
+		_ljc_type[index] = lookUpIndex < ljcTypes.size() ? ljcTypes[lookUpIndex] : 0;
+	}
+
+	/**
+	 * \brief	Copy the types of all LJ centers again, if ljcTypes changed after the SoA was filled.
+	 */
+	void refreshLJCTypes() {
+		if (_ljc_types_version == ljcTypesVersion) {
+			return;
+		}
+		for (size_t i = 0; i < _ljc_num; ++i) {
+			_ljc_type[i] = _ljc_id[i] < ljcTypes.size() ? ljcTypes[_ljc_id[i]] : 0;
+		}
+		_ljc_types_version = ljcTypesVersion;
 	}
 
 	/**
@@ -230,6 +256,8 @@ public:
 
 		// entries per lj center
 		_ljc_id.resize_zero_shrink(_ljc_num, true);
+		_ljc_type.resize_zero_shrink(_ljc_num, true);
+		_ljc_types_version = ljcTypesVersion; // filled by pushBackLJC
 
 		// entries per charge
 		_charges_q.resize_zero_shrink(_charges_num);
@@ -8,6 +8,8 @@
 #include "molecules/MoleculeForwardDeclaration.h"
 #include "particleContainer/ParticleCellForwardDeclaration.h"
 
+class ExternalSiteField;
+
 /**
  * Interface for traversal of cells to allow a cell-wise treatment of molecules.
  *
@@ -30,6 +32,7 @@ class CellProcessor {
 protected:
 	double _cutoffRadiusSquare;
 	double _LJCutoffRadiusSquare;
+	bool _calculateMacroscopic {true};
 
 public:
 	CellProcessor(const double cutoffRadius, const double LJCutoffRadius) :
@@ -51,6 +54,20 @@ public:
 	void setCutoffRadiusSquare(const double c) {_cutoffRadiusSquare = c;}
 	void setLJCutoffRadiusSquare(const double ljc) {_LJCutoffRadiusSquare = ljc;}
 
+	/**
+	 * Whether potential energy and virial (global and per molecule) are needed from the following traversals.
+	 * Cell processors which always compute them may ignore this.
+	 */
+	void setCalculateMacroscopic(const bool calculateMacroscopic) {_calculateMacroscopic = calculateMacroscopic;}
+	bool getCalculateMacroscopic() const {return _calculateMacroscopic;}
+
+	/**
+	 * Register an external field, which is applied to the LJ centers during the following traversals.
+	 * The field is not owned by the cell processor.
+	 * @return false if this cell processor does not support fields, the caller has to apply it itself then
+	 */
+	virtual bool addSiteField(ExternalSiteField* /*field*/) {return false;}
+
 
 	/**
 	 * called before the traversal starts.
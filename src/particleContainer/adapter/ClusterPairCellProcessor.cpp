@@ -0,0 +1,468 @@
+/**
+ * \file
+ * \brief ClusterPairCellProcessor.cpp
+ */
+
+#include "ClusterPairCellProcessor.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include "CellDataSoA.h"
+#include "Domain.h"
+#include "Simulation.h"
+#include "WrapOpenMP.h"
+#include "ensemble/EnsembleBase.h"
+#include "molecules/Component.h"
+#include "particleContainer/FullParticleCell.h"
+#include "particleContainer/ParticleCell.h"
+#include "utils/Logger.h"
+#include "utils/mardyn_assert.h"
+#include "vectorization/MaskGatherChooser.h"
+#include "vectorization/SIMD_VectorizedCellProcessorHelpers.h"
+
+namespace {
+/**
+ * \brief Force between the center 1 and the centers of a j-cluster, see VectorizedCellProcessor::_loopBodyLJ.
+ */
+template<bool calculateMacroscopic>
+vcp_inline void clusterLoopBodyLJ(
+		const RealCalcVec& m1_r_x, const RealCalcVec& m1_r_y, const RealCalcVec& m1_r_z,
+		const RealCalcVec& r1_x, const RealCalcVec& r1_y, const RealCalcVec& r1_z,
+		const RealCalcVec& m2_r_x, const RealCalcVec& m2_r_y, const RealCalcVec& m2_r_z,
+		const RealCalcVec& r2_x, const RealCalcVec& r2_y, const RealCalcVec& r2_z,
+		RealCalcVec& f_x, RealCalcVec& f_y, RealCalcVec& f_z,
+		RealAccumVec& V_x, RealAccumVec& V_y, RealAccumVec& V_z,
+		RealAccumVec& sum_upot6lj, RealAccumVec& sum_virial,
+		const MaskCalcVec& forceMask,
+		const RealCalcVec& eps_24, const RealCalcVec& sig2, const RealCalcVec& shift6) {
+	const RealCalcVec c_dx = r1_x - r2_x;
+	const RealCalcVec c_dy = r1_y - r2_y;
+	const RealCalcVec c_dz = r1_z - r2_z;
+
+	const RealCalcVec c_r2 = RealCalcVec::scal_prod(c_dx, c_dy, c_dz, c_dx, c_dy, c_dz);
+	const RealCalcVec r2_inv = RealCalcVec::fastReciprocal_mask(c_r2, forceMask);
+
+	const RealCalcVec lj2 = sig2 * r2_inv;
+	const RealCalcVec lj4 = lj2 * lj2;
+	const RealCalcVec lj6 = lj4 * lj2;
+	const RealCalcVec lj12 = lj6 * lj6;
+	const RealCalcVec lj12m6 = lj12 - lj6;
+
+	const RealCalcVec eps24r2inv = eps_24 * r2_inv;
+	const RealCalcVec lj12lj12m6 = lj12 + lj12m6;
+	const RealCalcVec scale = eps24r2inv * lj12lj12m6;
+
+	f_x = c_dx * scale;
+	f_y = c_dy * scale;
+	f_z = c_dz * scale;
+	const RealCalcVec m_dx = m1_r_x - m2_r_x;
+	const RealCalcVec m_dy = m1_r_y - m2_r_y;
+	const RealCalcVec m_dz = m1_r_z - m2_r_z;
+
+	V_x = RealAccumVec::convertCalcToAccum(m_dx * f_x);
+	V_y = RealAccumVec::convertCalcToAccum(m_dy * f_y);
+	V_z = RealAccumVec::convertCalcToAccum(m_dz * f_z);
+
+	if (calculateMacroscopic) {
+		// shift6 is not masked
+		const RealCalcVec upot_sh = RealCalcVec::fmadd(eps_24, lj12m6, shift6);
+		const RealCalcVec upot_masked = RealCalcVec::apply_mask(upot_sh, forceMask);
+		sum_upot6lj = sum_upot6lj + RealAccumVec::convertCalcToAccum(upot_masked);
+		sum_virial = sum_virial + V_x + V_y + V_z;
+	}
+}
+
+//! squared distance of two boxes, 0 if they overlap
+vcp_inline vcp_real_calc boxDistanceSquare(const vcp_real_calc low1[3], const vcp_real_calc high1[3],
+										   const vcp_real_calc low2[3], const vcp_real_calc high2[3]) {
+	vcp_real_calc distanceSquare = 0;
+	for (int d = 0; d < 3; ++d) {
+		const vcp_real_calc gap = std::max(std::max(low2[d] - high1[d], low1[d] - high2[d]), vcp_real_calc(0));
+		distanceSquare += gap * gap;
+	}
+	return distanceSquare;
+}
+}  // namespace
+
+ClusterPairCellProcessor::ThreadData::ThreadData() {
+	_upot6ljV.resize(VCP_VEC_SIZE);
+	_virialV.resize(VCP_VEC_SIZE);
+	for (size_t j = 0; j < VCP_VEC_SIZE; ++j) {
+		_upot6ljV[j] = 0.0;
+		_virialV[j] = 0.0;
+	}
+}
+
+ClusterPairCellProcessor::ClusterPairCellProcessor(Domain& domain, double cutoffRadius, double LJcutoffRadius)
+	: CellProcessor(cutoffRadius, LJcutoffRadius),
+	  _domain(domain),
+	  _ljParameters(),
+	  _eps_sig(),
+	  _shift6(),
+	  _threadData(mardyn_get_max_threads()),
+	  _upot6lj(0.0),
+	  _virial(0.0) {
+	const std::vector<Component>& components = *(_simulation.getEnsemble()->getComponents());
+	for (const Component& component : components) {
+		if (component.numCharges() + component.numDipoles() + component.numQuadrupoles() > 0) {
+			std::ostringstream error_message;
+			error_message << "ClusterPairCellProcessor: component " << component.ID() + 1
+						  << " has electrostatic sites, only Lennard-Jones centers are supported." << std::endl;
+			MARDYN_EXIT(error_message.str());
+		}
+	}
+	if (not _simulation.getEnsemble()->getTabulatedPotentials().empty()) {
+		std::ostringstream error_message;
+		error_message << "ClusterPairCellProcessor: tabulated potentials are not supported." << std::endl;
+		MARDYN_EXIT(error_message.str());
+	}
+
+	// Assign a center list start index for each component, as done for the lookup ids of the molecules.
+	size_t maxID = 0;
+	for (const Component& component : components) {
+		maxID = std::max(maxID, static_cast<size_t>(component.ID()));
+	}
+	std::vector<size_t> compIDs(maxID + 1, 0);
+	size_t centers = 0;
+	for (const Component& component : components) {
+		compIDs[component.ID()] = centers;
+		centers += component.numLJcenters();
+	}
+
+	// One row for each LJ center: one pair (epsilon*24, sigma^2) for each LJ center, followed by shift*6 for each
+	// LJ center. Every row starts at a cache line.
+	const size_t lineElements = 64 / sizeof(vcp_real_calc);
+	const size_t rowStride = ((3 * centers + lineElements - 1) / lineElements) * lineElements;
+	_ljParameters.resize(std::max(rowStride * centers, size_t(1)));
+	_ljParameters.zero();
+	for (const Component& comp_i : components) {
+		for (const Component& comp_j : components) {
+			ParaStrm& p = _domain.getComp2Params()(comp_i.ID(), comp_j.ID());
+			p.reset_read();
+			for (size_t center_i = 0; center_i < comp_i.numLJcenters(); ++center_i) {
+				for (size_t center_j = 0; center_j < comp_j.numLJcenters(); ++center_j) {
+					double eps, sig, shift;
+					p >> eps;
+					p >> sig;
+					p >> shift;
+					vcp_real_calc* const row = &_ljParameters[(compIDs[comp_i.ID()] + center_i) * rowStride];
+					const size_t col = compIDs[comp_j.ID()] + center_j;
+					row[2 * col] = static_cast<vcp_real_calc>(eps);
+					row[2 * col + 1] = static_cast<vcp_real_calc>(sig);
+					row[2 * centers + col] = static_cast<vcp_real_calc>(shift);
+				}
+			}
+		}
+	}
+	_eps_sig.resize(centers);
+	_shift6.resize(centers);
+	for (size_t id = 0; id < centers; ++id) {
+		_eps_sig[id] = &_ljParameters[id * rowStride];
+		_shift6[id] = _eps_sig[id] + 2 * centers;
+	}
+
+	Log::global_log->info() << "ClusterPairCellProcessor: clusters of " << VCP_VEC_SIZE << " LJ centers, "
+							<< centers << " LJ centers in the parameter table, " << _threadData.size()
+							<< " threads." << std::endl;
+}
+
+void ClusterPairCellProcessor::initTraversal() {
+	#if defined(_OPENMP)
+	#pragma omp master
+	#endif
+	{
+		_upot6lj = 0.0;
+		_virial = 0.0;
+	} // end pragma omp master
+}
+
+void ClusterPairCellProcessor::endTraversal() {
+	vcp_real_accum glob_upot6lj = 0.0;
+	vcp_real_accum glob_virial = 0.0;
+
+	#if defined(_OPENMP)
+	#pragma omp parallel reduction(+:glob_upot6lj, glob_virial)
+	#endif
+	{
+		ThreadData& threadData = _threadData[mardyn_get_thread_num()];
+		vcp_real_accum thread_upot = 0.0, thread_virial = 0.0;
+		load_hSum_Store_Clear(&thread_upot, threadData._upot6ljV);
+		load_hSum_Store_Clear(&thread_virial, threadData._virialV);
+		glob_upot6lj += thread_upot;
+		glob_virial += thread_virial;
+	} // end pragma omp parallel reduction
+
+	_upot6lj = glob_upot6lj;
+	_virial = glob_virial;
+	_domain.setLocalVirial(_virial);
+	_domain.setLocalUpot(_upot6lj / 6.0);
+}
+
+void ClusterPairCellProcessor::buildClusterBoxes(CellDataSoA& soa, std::vector<ClusterBox>& boxes) {
+	typedef ConcSites::SiteType SiteType;
+	typedef ConcSites::CoordinateType Coordinate;
+	typedef CellDataSoA::QuantityType QuantityType;
+
+	const vcp_real_calc* const m_r[3] = {
+		soa.getBeginCalc(QuantityType::MOL_POSITION, SiteType::LJC, Coordinate::X),
+		soa.getBeginCalc(QuantityType::MOL_POSITION, SiteType::LJC, Coordinate::Y),
+		soa.getBeginCalc(QuantityType::MOL_POSITION, SiteType::LJC, Coordinate::Z)};
+	const vcp_ljc_id_t* const ljc_id = soa._ljc_id;
+
+	const size_t numCenters = soa._ljc_num;
+	boxes.resize(vcp_ceil_to_vec_size(numCenters) / VCP_VEC_SIZE);
+	for (size_t c = 0; c < boxes.size(); ++c) {
+		ClusterBox& box = boxes[c];
+		const size_t begin = c * VCP_VEC_SIZE;
+		const size_t end = std::min(begin + VCP_VEC_SIZE, numCenters);
+		for (int d = 0; d < 3; ++d) {
+			box.low[d] = box.high[d] = m_r[d][begin];
+		}
+		box.ljcId = static_cast<int>(ljc_id[begin]);
+		for (size_t k = begin + 1; k < end; ++k) {
+			for (int d = 0; d < 3; ++d) {
+				box.low[d] = std::min(box.low[d], m_r[d][k]);
+				box.high[d] = std::max(box.high[d], m_r[d][k]);
+			}
+			if (box.ljcId != static_cast<int>(ljc_id[k])) {
+				box.ljcId = -1;
+			}
+		}
+	}
+}
+
+template<bool SingleCell, bool CalculateMacroscopic>
+void ClusterPairCellProcessor::calculateClusterPairs(CellDataSoA& soa1, CellDataSoA& soa2) {
+	ThreadData& threadData = _threadData[mardyn_get_thread_num()];
+	const bool calculateVirials = _calculateMacroscopic;
+
+	typedef ConcSites::SiteType SiteType;
+	typedef ConcSites::CoordinateType Coordinate;
+	typedef CellDataSoA::QuantityType QuantityType;
+
+	const vcp_real_calc* const soa1_ljc_m_r_x = soa1.getBeginCalc(QuantityType::MOL_POSITION, SiteType::LJC, Coordinate::X);
+	const vcp_real_calc* const soa1_ljc_m_r_y = soa1.getBeginCalc(QuantityType::MOL_POSITION, SiteType::LJC, Coordinate::Y);
+	const vcp_real_calc* const soa1_ljc_m_r_z = soa1.getBeginCalc(QuantityType::MOL_POSITION, SiteType::LJC, Coordinate::Z);
+	const vcp_real_calc* const soa1_ljc_r_x = soa1.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::LJC, Coordinate::X);
+	const vcp_real_calc* const soa1_ljc_r_y = soa1.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::LJC, Coordinate::Y);
+	const vcp_real_calc* const soa1_ljc_r_z = soa1.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::LJC, Coordinate::Z);
+		 vcp_real_accum* const soa1_ljc_f_x = soa1.getBeginAccum(QuantityType::FORCE, SiteType::LJC, Coordinate::X);
+		 vcp_real_accum* const soa1_ljc_f_y = soa1.getBeginAccum(QuantityType::FORCE, SiteType::LJC, Coordinate::Y);
+		 vcp_real_accum* const soa1_ljc_f_z = soa1.getBeginAccum(QuantityType::FORCE, SiteType::LJC, Coordinate::Z);
+		 vcp_real_accum* const soa1_ljc_V_x = soa1.getBeginAccum(QuantityType::VIRIAL, SiteType::LJC, Coordinate::X);
+		 vcp_real_accum* const soa1_ljc_V_y = soa1.getBeginAccum(QuantityType::VIRIAL, SiteType::LJC, Coordinate::Y);
+		 vcp_real_accum* const soa1_ljc_V_z = soa1.getBeginAccum(QuantityType::VIRIAL, SiteType::LJC, Coordinate::Z);
+	const vcp_ljc_id_t* const soa1_ljc_id = soa1._ljc_id;
+
+	const vcp_real_calc* const soa2_ljc_m_r_x = soa2.getBeginCalc(QuantityType::MOL_POSITION, SiteType::LJC, Coordinate::X);
+	const vcp_real_calc* const soa2_ljc_m_r_y = soa2.getBeginCalc(QuantityType::MOL_POSITION, SiteType::LJC, Coordinate::Y);
+	const vcp_real_calc* const soa2_ljc_m_r_z = soa2.getBeginCalc(QuantityType::MOL_POSITION, SiteType::LJC, Coordinate::Z);
+	const vcp_real_calc* const soa2_ljc_r_x = soa2.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::LJC, Coordinate::X);
+	const vcp_real_calc* const soa2_ljc_r_y = soa2.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::LJC, Coordinate::Y);
+	const vcp_real_calc* const soa2_ljc_r_z = soa2.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::LJC, Coordinate::Z);
+		 vcp_real_accum* const soa2_ljc_f_x = soa2.getBeginAccum(QuantityType::FORCE, SiteType::LJC, Coordinate::X);
+		 vcp_real_accum* const soa2_ljc_f_y = soa2.getBeginAccum(QuantityType::FORCE, SiteType::LJC, Coordinate::Y);
+		 vcp_real_accum* const soa2_ljc_f_z = soa2.getBeginAccum(QuantityType::FORCE, SiteType::LJC, Coordinate::Z);
+		 vcp_real_accum* const soa2_ljc_V_x = soa2.getBeginAccum(QuantityType::VIRIAL, SiteType::LJC, Coordinate::X);
+		 vcp_real_accum* const soa2_ljc_V_y = soa2.getBeginAccum(QuantityType::VIRIAL, SiteType::LJC, Coordinate::Y);
+		 vcp_real_accum* const soa2_ljc_V_z = soa2.getBeginAccum(QuantityType::VIRIAL, SiteType::LJC, Coordinate::Z);
+	const vcp_ljc_id_t* const soa2_ljc_id = soa2._ljc_id;
+
+	std::vector<ClusterBox>& boxes1 = threadData._boxes1;
+	buildClusterBoxes(soa1, boxes1);
+	std::vector<ClusterBox>& boxes2 = SingleCell ? threadData._boxes1 : threadData._boxes2;
+	if (not SingleCell) {
+		buildClusterBoxes(soa2, boxes2);
+	}
+
+	const vcp_real_calc rc2 = static_cast<vcp_real_calc>(_LJCutoffRadiusSquare);
+	const RealCalcVec ljrc2 = RealCalcVec::set1(rc2);
+	const size_t soa1_ljc_num = soa1._ljc_num;
+	const size_t soa2_ljc_num = soa2._ljc_num;
+
+	RealAccumVec sum_upot6lj = RealAccumVec::zero();
+	RealAccumVec sum_virial = RealAccumVec::zero();
+
+	// accumulators of the centers of the i-cluster
+	RealAccumVec sum_fx1[VCP_VEC_SIZE], sum_fy1[VCP_VEC_SIZE], sum_fz1[VCP_VEC_SIZE];
+	RealAccumVec sum_Vx1[VCP_VEC_SIZE], sum_Vy1[VCP_VEC_SIZE], sum_Vz1[VCP_VEC_SIZE];
+
+	for (size_t ci = 0; ci < boxes1.size(); ++ci) {
+		const ClusterBox& box1 = boxes1[ci];
+		const size_t i_begin = ci * VCP_VEC_SIZE;
+		const size_t i_end = std::min(i_begin + VCP_VEC_SIZE, soa1_ljc_num);
+		for (size_t k = 0; k < VCP_VEC_SIZE; ++k) {
+			sum_fx1[k] = sum_fy1[k] = sum_fz1[k] = RealAccumVec::zero();
+			sum_Vx1[k] = sum_Vy1[k] = sum_Vz1[k] = RealAccumVec::zero();
+		}
+		bool clusterInteracts = false;
+
+		// within one cell, every cluster pair is computed once, starting with the i-cluster itself
+		for (size_t cj = SingleCell ? ci : 0; cj < boxes2.size(); ++cj) {
+			const ClusterBox& box2 = boxes2[cj];
+			if (boxDistanceSquare(box1.low, box1.high, box2.low, box2.high) >= rc2) {
+				continue;
+			}
+			clusterInteracts = true;
+
+			const size_t j = cj * VCP_VEC_SIZE;
+			const size_t j_num = std::min(static_cast<size_t>(VCP_VEC_SIZE), soa2_ljc_num - j);
+			const MaskCalcVec clusterMask = j_num == VCP_VEC_SIZE ? MaskCalcVec::ones() : vcp_simd_getRemainderMask(j_num);
+
+			const RealCalcVec m_r_x2 = RealCalcVec::aligned_load_mask(soa2_ljc_m_r_x + j, clusterMask);
+			const RealCalcVec m_r_y2 = RealCalcVec::aligned_load_mask(soa2_ljc_m_r_y + j, clusterMask);
+			const RealCalcVec m_r_z2 = RealCalcVec::aligned_load_mask(soa2_ljc_m_r_z + j, clusterMask);
+			const RealCalcVec c_r_x2 = RealCalcVec::aligned_load_mask(soa2_ljc_r_x + j, clusterMask);
+			const RealCalcVec c_r_y2 = RealCalcVec::aligned_load_mask(soa2_ljc_r_y + j, clusterMask);
+			const RealCalcVec c_r_z2 = RealCalcVec::aligned_load_mask(soa2_ljc_r_z + j, clusterMask);
+
+			RealAccumVec sum_fx2 = RealAccumVec::zero();
+			RealAccumVec sum_fy2 = RealAccumVec::zero();
+			RealAccumVec sum_fz2 = RealAccumVec::zero();
+			RealAccumVec sum_Vx2 = RealAccumVec::zero();
+			RealAccumVec sum_Vy2 = RealAccumVec::zero();
+			RealAccumVec sum_Vz2 = RealAccumVec::zero();
+
+			for (size_t i = i_begin; i < i_end; ++i) {
+				const RealCalcVec m_r_x1 = RealCalcVec::broadcast(soa1_ljc_m_r_x + i);
+				const RealCalcVec m_r_y1 = RealCalcVec::broadcast(soa1_ljc_m_r_y + i);
+				const RealCalcVec m_r_z1 = RealCalcVec::broadcast(soa1_ljc_m_r_z + i);
+
+				const RealCalcVec m_dx = m_r_x1 - m_r_x2;
+				const RealCalcVec m_dy = m_r_y1 - m_r_y2;
+				const RealCalcVec m_dz = m_r_z1 - m_r_z2;
+				const RealCalcVec m_r2 = RealCalcVec::scal_prod(m_dx, m_dy, m_dz, m_dx, m_dy, m_dz);
+
+				MaskCalcVec forceMask = clusterMask and (m_r2 < ljrc2);
+				if (SingleCell) {
+					// no pairs of centers of the same molecule, only j > i within the i-cluster
+					forceMask = forceMask and (m_r2 != RealCalcVec::zero());
+					if (cj == ci) {
+						forceMask = forceMask and vcp_simd_getInitMask(i);
+					}
+				}
+				if (not forceMask.movemask()) {
+					continue;
+				}
+
+				const vcp_ljc_id_t id_i = soa1_ljc_id[i];
+				RealCalcVec eps_24, sig2, shift6;
+				if (box2.ljcId >= 0) {
+					eps_24 = RealCalcVec::set1(_eps_sig[id_i][2 * box2.ljcId]);
+					sig2 = RealCalcVec::set1(_eps_sig[id_i][2 * box2.ljcId + 1]);
+					shift6 = RealCalcVec::set1(_shift6[id_i][box2.ljcId]);
+				} else {
+					unpackEps24Sig2<MaskGatherC>(eps_24, sig2, _eps_sig[id_i], soa2_ljc_id, (vcp_ljc_id_t)j, forceMask);
+					unpackShift6<MaskGatherC>(shift6, _shift6[id_i], soa2_ljc_id, (vcp_ljc_id_t)j, forceMask);
+				}
+
+				RealCalcVec fx, fy, fz;
+				RealAccumVec Vx, Vy, Vz;
+				clusterLoopBodyLJ<CalculateMacroscopic>(
+					m_r_x1, m_r_y1, m_r_z1,
+					RealCalcVec::broadcast(soa1_ljc_r_x + i), RealCalcVec::broadcast(soa1_ljc_r_y + i), RealCalcVec::broadcast(soa1_ljc_r_z + i),
+					m_r_x2, m_r_y2, m_r_z2, c_r_x2, c_r_y2, c_r_z2,
+					fx, fy, fz,
+					Vx, Vy, Vz,
+					sum_upot6lj, sum_virial,
+					forceMask,
+					eps_24, sig2, shift6);
+
+				const RealAccumVec a_fx = RealAccumVec::convertCalcToAccum(fx);
+				const RealAccumVec a_fy = RealAccumVec::convertCalcToAccum(fy);
+				const RealAccumVec a_fz = RealAccumVec::convertCalcToAccum(fz);
+
+				const size_t lane = i - i_begin;
+				sum_fx1[lane] = sum_fx1[lane] + a_fx;
+				sum_fy1[lane] = sum_fy1[lane] + a_fy;
+				sum_fz1[lane] = sum_fz1[lane] + a_fz;
+				sum_fx2 = sum_fx2 + a_fx;
+				sum_fy2 = sum_fy2 + a_fy;
+				sum_fz2 = sum_fz2 + a_fz;
+
+				sum_Vx1[lane] = sum_Vx1[lane] + Vx;
+				sum_Vy1[lane] = sum_Vy1[lane] + Vy;
+				sum_Vz1[lane] = sum_Vz1[lane] + Vz;
+				sum_Vx2 = sum_Vx2 + Vx;
+				sum_Vy2 = sum_Vy2 + Vy;
+				sum_Vz2 = sum_Vz2 + Vz;
+			}
+
+			// the j-cluster is done, the masked lanes contain zeros
+			(RealAccumVec::aligned_load(soa2_ljc_f_x + j) - sum_fx2).aligned_store(soa2_ljc_f_x + j);
+			(RealAccumVec::aligned_load(soa2_ljc_f_y + j) - sum_fy2).aligned_store(soa2_ljc_f_y + j);
+			(RealAccumVec::aligned_load(soa2_ljc_f_z + j) - sum_fz2).aligned_store(soa2_ljc_f_z + j);
+			if (calculateVirials) {
+				sum_Vx2.aligned_load_add_store(soa2_ljc_V_x + j);
+				sum_Vy2.aligned_load_add_store(soa2_ljc_V_y + j);
+				sum_Vz2.aligned_load_add_store(soa2_ljc_V_z + j);
+			}
+		}
+
+		if (not clusterInteracts) {
+			continue;
+		}
+		for (size_t i = i_begin; i < i_end; ++i) {
+			const size_t lane = i - i_begin;
+			hSum_Add_Store(soa1_ljc_f_x + i, sum_fx1[lane]);
+			hSum_Add_Store(soa1_ljc_f_y + i, sum_fy1[lane]);
+			hSum_Add_Store(soa1_ljc_f_z + i, sum_fz1[lane]);
+			if (calculateVirials) {
+				hSum_Add_Store(soa1_ljc_V_x + i, sum_Vx1[lane]);
+				hSum_Add_Store(soa1_ljc_V_y + i, sum_Vy1[lane]);
+				hSum_Add_Store(soa1_ljc_V_z + i, sum_Vz1[lane]);
+			}
+		}
+	}
+
+	if (CalculateMacroscopic) {
+		sum_upot6lj.aligned_load_add_store(&threadData._upot6ljV[0]);
+		sum_virial.aligned_load_add_store(&threadData._virialV[0]);
+	}
+}
+
+template<bool SingleCell>
+void ClusterPairCellProcessor::calculateClusterPairsMacroscopicIf(bool calculateMacroscopic, CellDataSoA& soa1,
+																  CellDataSoA& soa2) {
+	if (calculateMacroscopic) {
+		calculateClusterPairs<SingleCell, true>(soa1, soa2);
+	} else {
+		calculateClusterPairs<SingleCell, false>(soa1, soa2);
+	}
+}
+
+void ClusterPairCellProcessor::processCell(ParticleCell& c) {
+	FullParticleCell& full_c = downcastCellReferenceFull(c);
+	CellDataSoA& soa = full_c.getCellDataSoA();
+	if (c.isHaloCell() or soa.getMolNum() < 2) {
+		return;
+	}
+	calculateClusterPairsMacroscopicIf<true>(_calculateMacroscopic, soa, soa);
+}
+
+void ClusterPairCellProcessor::processCellPair(ParticleCell& c1, ParticleCell& c2, bool sumAll) {
+	mardyn_assert(&c1 != &c2);
+	FullParticleCell& full_c1 = downcastCellReferenceFull(c1);
+	FullParticleCell& full_c2 = downcastCellReferenceFull(c2);
+
+	CellDataSoA& soa1 = full_c1.getCellDataSoA();
+	CellDataSoA& soa2 = full_c2.getCellDataSoA();
+	if (soa1.getMolNum() == 0 or soa2.getMolNum() == 0) {
+		return;
+	}
+
+	const bool c1Halo = full_c1.isHaloCell();
+	const bool c2Halo = full_c2.isHaloCell();
+	if (sumAll) {
+		calculateClusterPairsMacroscopicIf<false>(_calculateMacroscopic, soa1, soa2);
+		return;
+	}
+	if (c1Halo and c2Halo) {
+		return;
+	}
+	// same rules for the macroscopic values as in VectorizedCellProcessor::processCellPair
+	const bool calculateMacroscopic =
+		_calculateMacroscopic and ((not c1Halo and not c2Halo) or full_c1.getCellIndex() < full_c2.getCellIndex());
+	calculateClusterPairsMacroscopicIf<false>(calculateMacroscopic, soa1, soa2);
+}
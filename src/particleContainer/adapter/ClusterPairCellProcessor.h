@@ -0,0 +1,99 @@
+/**
+ * \file
+ * \brief ClusterPairCellProcessor.h
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "CellProcessor.h"
+#include "utils/AlignedArray.h"
+#include "vectorization/SIMD_TYPES.h"
+
+class CellDataSoA;
+class Domain;
+
+/**
+ * \brief Lennard-Jones force calculation on clusters of VCP_VEC_SIZE consecutive LJ centers.
+ * \details VectorizedCellProcessor computes one center against the centers of a whole cell, so the lanes of the
+ * centers outside of the cutoff sphere are wasted and the center is broadcast again for every cell pair. Here the LJ
+ * centers of a cell are split into clusters of one SIMD vector each, with the bounding box of their molecule
+ * positions. Cluster pairs whose boxes are further apart than the LJ cutoff radius are skipped, for the others the
+ * centers of the i-cluster are computed against the whole j-cluster: the forces and virials of the j-cluster stay in
+ * registers until the i-cluster is done, those of the i-centers until all j-clusters are done (4x4 for AVX2, 8x8 for
+ * AVX512 in double precision).
+ *
+ * The clusters are compact if the molecules of a cell are sorted spatially, see LinkedCells::setCellSorting. The cutoff
+ * is applied to the distance of the molecules as in VectorizedCellProcessor, so both compute the same pairs.
+ *
+ * Only components with Lennard-Jones centers (one or more) are supported, neither charges, dipoles and quadrupoles nor
+ * tabulated potentials and external site fields.
+ */
+class ClusterPairCellProcessor : public CellProcessor {
+public:
+	ClusterPairCellProcessor& operator=(const ClusterPairCellProcessor&) = delete;
+
+	/**
+	 * \brief Construct and set up the internal parameter table.
+	 * \details Components and parameters should be finalized before this call.
+	 */
+	ClusterPairCellProcessor(Domain& domain, double cutoffRadius, double LJcutoffRadius);
+
+	void initTraversal() override;
+	void preprocessCell(ParticleCell& /*cell*/) override {}
+	void processCellPair(ParticleCell& cell1, ParticleCell& cell2, bool sumAll = false) override;
+	void processCell(ParticleCell& cell) override;
+	double processSingleMolecule(Molecule* /*m1*/, ParticleCell& /*cell2*/) override { return 0.0; }
+	void postprocessCell(ParticleCell& /*cell*/) override {}
+	/**
+	 * \brief Store macroscopic values in the Domain.
+	 */
+	void endTraversal() override;
+
+private:
+	/**
+	 * \brief Bounding box of the molecule positions of one cluster.
+	 */
+	struct ClusterBox {
+		vcp_real_calc low[3];
+		vcp_real_calc high[3];
+		//! LJ center id shared by all centers of the cluster, -1 if they differ
+		int ljcId;
+	};
+
+	struct alignas(64) ThreadData {
+		ThreadData();
+		AlignedArray<vcp_real_accum> _upot6ljV, _virialV;
+		std::vector<ClusterBox> _boxes1, _boxes2;
+	};
+
+	static void buildClusterBoxes(CellDataSoA& soa, std::vector<ClusterBox>& boxes);
+
+	/**
+	 * \brief Computes the cluster pairs of soa1 and soa2, or the ones within soa1 for SingleCell.
+	 */
+	template<bool SingleCell, bool CalculateMacroscopic>
+	void calculateClusterPairs(CellDataSoA& soa1, CellDataSoA& soa2);
+
+	template<bool SingleCell>
+	void calculateClusterPairsMacroscopicIf(bool calculateMacroscopic, CellDataSoA& soa1, CellDataSoA& soa2);
+
+	Domain& _domain;
+
+	/**
+	 * \brief Parameter rows of the LJ centers, see VectorizedCellProcessor.
+	 * \details Each row contains the pairs (epsilon*24, sigma^2) of one center with all centers, followed by shift*6.
+	 */
+	AlignedArray<vcp_real_calc> _ljParameters;
+	std::vector<const vcp_real_calc*> _eps_sig;
+	std::vector<const vcp_real_calc*> _shift6;
+
+	std::vector<ThreadData> _threadData;
+
+	/**
+	 * \brief Sum of all LJ potentials, multiplied by 6.0.
+	 */
+	double _upot6lj;
+	double _virial;
+};
@@ -0,0 +1,40 @@
+/**
+ * \file
+ * \brief ExternalSiteField.h
+ */
+
+#ifndef EXTERNALSITEFIELD_H_
+#define EXTERNALSITEFIELD_H_
+
+#include <cstddef>
+
+#include "vectorization/SIMD_TYPES.h"
+
+/**
+ * \brief External potential acting on single LJ centers, e.g. a wall.
+ * \details Cell processors which support fields (see CellProcessor::addSiteField) apply them to the
+ * LJ centers of each inner cell within reach while the CellDataSoA of the cell is processed anyway,
+ * so the field needs no separate pass over the particle container. Calls for different cells may
+ * happen concurrently.
+ */
+class ExternalSiteField {
+public:
+	virtual ~ExternalSiteField() {}
+
+	/**
+	 * \brief Whether the field can act on LJ centers of molecules whose center of mass lies in the box [low, high).
+	 */
+	virtual bool reaches(const double low[3], const double high[3]) const = 0;
+
+	/**
+	 * \brief Add the field force to num LJ centers.
+	 * \param r    center positions, one array per coordinate
+	 * \param ids  LJ center look-up ids (component look-up id + center index)
+	 * \param f    center forces, one array per coordinate
+	 * \return potential energy of the centers in the field
+	 */
+	virtual double applyLJ(size_t num, const vcp_real_calc* const r[3], const vcp_ljc_id_t* ids,
+			vcp_real_accum* const f[3]) const = 0;
+};
+
+#endif /* EXTERNALSITEFIELD_H_ */
@@ -0,0 +1,160 @@
+/**
+ * @file HeatFluxCellProcessor.cpp
+ */
+
+#include "HeatFluxCellProcessor.h"
+
+#include "WrapOpenMP.h"
+#include "molecules/Molecule.h"
+#include "molecules/potforce.h"
+#include "particleContainer/ParticleCell.h"
+
+namespace {
+//! velocity and angular velocity (lab frame) at the end of the time step, see FullMolecule::upd_postF
+void velocitiesAfterStep(const Molecule& molecule, double dtHalf, double v[3], double w[3]) {
+	const double dtInv2m = dtHalf / molecule.mass();
+	for (unsigned short d = 0; d < 3; ++d) {
+		v[d] = molecule.v(d) + dtInv2m * molecule.F(d);
+		w[d] = 0.;
+	}
+	if (molecule.getI(0) == 0. and molecule.getI(1) == 0. and molecule.getI(2) == 0.) {
+		return;  // single site
+	}
+	std::array<double, 3> L;
+	for (unsigned short d = 0; d < 3; ++d) {
+		L[d] = molecule.D(d) + dtHalf * molecule.M(d);
+	}
+	std::array<double, 3> wBody = molecule.q().rotateinv(L);
+	for (unsigned short d = 0; d < 3; ++d) {
+		const double I = molecule.getI(d);
+		wBody[d] = (I > 0.) ? wBody[d] / I : 0.;
+	}
+	const std::array<double, 3> wLab = molecule.q().rotate(wBody);
+	for (unsigned short d = 0; d < 3; ++d) {
+		w[d] = wLab[d];
+	}
+}
+}  // namespace
+
+HeatFluxCellProcessor::HeatFluxCellProcessor(double cutoffRadius, double LJCutoffRadius, Comp2Param& comp2params,
+											 double timestepLength)
+	: CellProcessor(cutoffRadius, LJCutoffRadius),
+	  _comp2params(mardyn_get_max_threads(), comp2params),
+	  _threadData(mardyn_get_max_threads()),
+	  _heatFlux{0., 0., 0.},
+	  _timestepLength(timestepLength) {}
+
+void HeatFluxCellProcessor::initTraversal() {
+	for (auto& data : _threadData) {
+		data.heatFlux = {0., 0., 0.};
+	}
+}
+
+void HeatFluxCellProcessor::endTraversal() {
+	_heatFlux = {0., 0., 0.};
+	for (const auto& data : _threadData) {
+		for (unsigned short d = 0; d < 3; ++d) {
+			_heatFlux[d] += data.heatFlux[d];
+		}
+	}
+}
+
+void HeatFluxCellProcessor::processCell(ParticleCell& cell) {
+	if (cell.isHaloCell()) {
+		return;
+	}
+	const int thread = mardyn_get_thread_num();
+	for (auto it1 = cell.iterator(); it1.isValid(); ++it1) {
+		auto it2 = it1;
+		++it2;
+		for (; it2.isValid(); ++it2) {
+			processPair(*it1, *it2, true, true, thread);
+		}
+	}
+}
+
+void HeatFluxCellProcessor::processCellPair(ParticleCell& cell1, ParticleCell& cell2, bool /*sumAll*/) {
+	// only the owned molecules contribute, every pair with at least one of them is visited once by the traversal
+	const bool owned1 = not cell1.isHaloCell();
+	const bool owned2 = not cell2.isHaloCell();
+	if (not owned1 and not owned2) {
+		return;
+	}
+	const int thread = mardyn_get_thread_num();
+	for (auto it1 = cell1.iterator(); it1.isValid(); ++it1) {
+		for (auto it2 = cell2.iterator(); it2.isValid(); ++it2) {
+			processPair(*it1, *it2, owned1, owned2, thread);
+		}
+	}
+}
+
+void HeatFluxCellProcessor::processPair(Molecule& molecule1, Molecule& molecule2, bool owned1, bool owned2,
+										int thread) {
+	if (molecule1.getID() == molecule2.getID()) {
+		return;
+	}
+	double drm[3];
+	double dd = 0.;
+	for (unsigned short d = 0; d < 3; ++d) {
+		drm[d] = molecule1.r(d) - molecule2.r(d);
+		dd += drm[d] * drm[d];
+	}
+	if (dd >= _LJCutoffRadiusSquare) {
+		return;
+	}
+
+	ParaStrm& params = _comp2params[thread](molecule1.componentid(), molecule2.componentid());
+	params.reset_read();
+	// force, pair energy and torques acting on molecule 1, the torques on molecule 2 for its sites
+	double F[3] = {0., 0., 0.};
+	double u = 0.;
+	double tau1[3] = {0., 0., 0.};
+	double tau2[3] = {0., 0., 0.};
+	const unsigned int nc1 = molecule1.numLJcenters();
+	const unsigned int nc2 = molecule2.numLJcenters();
+	for (unsigned int si = 0; si < nc1; ++si) {
+		const std::array<double, 3> dii = molecule1.ljcenter_d_abs(si);
+		for (unsigned int sj = 0; sj < nc2; ++sj) {
+			const std::array<double, 3> djj = molecule2.ljcenter_d_abs(sj);
+			double drs[3], dr2, f[3], u6;
+			SiteSiteDistanceAbs(dii.data(), djj.data(), drs, dr2);
+			double eps24, sig2, shift6;
+			params >> eps24;
+			params >> sig2;
+			params >> shift6;
+			PotForceLJ(drs, dr2, eps24, sig2, f, u6);
+			u += (u6 + shift6) / 6.;
+			// torques with respect to the centers of mass, the force on molecule 2 is -f
+			const double a1[3] = {dii[0] - molecule1.r(0), dii[1] - molecule1.r(1), dii[2] - molecule1.r(2)};
+			const double a2[3] = {djj[0] - molecule2.r(0), djj[1] - molecule2.r(1), djj[2] - molecule2.r(2)};
+			tau1[0] += a1[1] * f[2] - a1[2] * f[1];
+			tau1[1] += a1[2] * f[0] - a1[0] * f[2];
+			tau1[2] += a1[0] * f[1] - a1[1] * f[0];
+			tau2[0] -= a2[1] * f[2] - a2[2] * f[1];
+			tau2[1] -= a2[2] * f[0] - a2[0] * f[2];
+			tau2[2] -= a2[0] * f[1] - a2[1] * f[0];
+			for (unsigned short d = 0; d < 3; ++d) {
+				F[d] += f[d];
+			}
+		}
+	}
+
+	// r_21 F_21 = r_12 F_12, so both molecules use drm and F
+	std::array<double, 3>& heatFlux = _threadData[thread].heatFlux;
+	const double dtHalf = 0.5 * _timestepLength;
+	double v[3], w[3];
+	if (owned1) {
+		velocitiesAfterStep(molecule1, dtHalf, v, w);
+		const double work = F[0] * v[0] + F[1] * v[1] + F[2] * v[2] + tau1[0] * w[0] + tau1[1] * w[1] + tau1[2] * w[2];
+		for (unsigned short d = 0; d < 3; ++d) {
+			heatFlux[d] += 0.5 * (u * v[d] + drm[d] * work);
+		}
+	}
+	if (owned2) {
+		velocitiesAfterStep(molecule2, dtHalf, v, w);
+		const double work = F[0] * v[0] + F[1] * v[1] + F[2] * v[2] - tau2[0] * w[0] - tau2[1] * w[1] - tau2[2] * w[2];
+		for (unsigned short d = 0; d < 3; ++d) {
+			heatFlux[d] += 0.5 * (u * v[d] + drm[d] * work);
+		}
+	}
+}
@@ -0,0 +1,56 @@
+/**
+ * @file HeatFluxCellProcessor.h
+ */
+
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "CellProcessor.h"
+#include "molecules/Comp2Param.h"
+
+/**
+ * Computes the potential part of the heat flux of the owned molecules, the contributions of the pair energies and of
+ * the work of the pair forces and torques,
+ * \f$ \frac{1}{2} \sum_i \sum_{j \neq i} \left[ u_{ij} \mathbf{v}_i
+ *     + \mathbf{r}_{ij} \left( \mathbf{F}_{ij} \cdot \mathbf{v}_i + \boldsymbol{\tau}_{ij} \cdot \boldsymbol{\omega}_i \right) \right] \f$.
+ *
+ * Only Lennard-Jones centers are supported. The traversal has to visit all pairs of an owned molecule, i.e. the halo
+ * has to be complete, and takes place after the forces of the time step are known: the velocities and angular
+ * velocities are advanced by half a time step with the forces and torques, as done by the integrator afterwards.
+ */
+class HeatFluxCellProcessor : public CellProcessor {
+public:
+	HeatFluxCellProcessor& operator=(const HeatFluxCellProcessor&) = delete;
+
+	/**
+	 * @param comp2params interaction parameters of the components, copied for every thread
+	 * @param timestepLength length of the time step, to obtain the velocities at the end of the time step
+	 */
+	HeatFluxCellProcessor(double cutoffRadius, double LJCutoffRadius, Comp2Param& comp2params,
+						  double timestepLength);
+
+	void initTraversal() override;
+	void preprocessCell(ParticleCell& /*cell*/) override {}
+	void processCellPair(ParticleCell& cell1, ParticleCell& cell2, bool sumAll = false) override;
+	void processCell(ParticleCell& cell) override;
+	double processSingleMolecule(Molecule* /*m1*/, ParticleCell& /*cell2*/) override { return 0.0; }
+	void postprocessCell(ParticleCell& /*cell*/) override {}
+	void endTraversal() override;
+
+	//! @brief local potential part of the heat flux, valid after the traversal
+	const std::array<double, 3>& getHeatFlux() const { return _heatFlux; }
+
+private:
+	void processPair(Molecule& molecule1, Molecule& molecule2, bool owned1, bool owned2, int thread);
+
+	struct alignas(64) ThreadData {
+		std::array<double, 3> heatFlux;
+	};
+
+	std::vector<Comp2Param> _comp2params;
+	std::vector<ThreadData> _threadData;
+	std::array<double, 3> _heatFlux;
+	double _timestepLength;
+};
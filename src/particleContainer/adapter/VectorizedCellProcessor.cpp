@@ -5,14 +5,19 @@
 
 #include "VectorizedCellProcessor.h"
 #include "CellDataSoA.h"
+#include "ExternalSiteField.h"
 #include "molecules/Molecule.h"
 #include "particleContainer/ParticleCell.h"
 #include "particleContainer/FullParticleCell.h"
 #include "Domain.h"
 #include "utils/Logger.h"
 #include "ensemble/EnsembleBase.h"
+#include "molecules/TabulatedPotential.h"
 #include "Simulation.h"
+#include "utils/mardyn_assert.h"
 #include <algorithm>
+#include <limits>
+#include <sstream>
 #include "vectorization/MaskGatherChooser.h"
 
 
@@ -20,7 +25,8 @@ VectorizedCellProcessor::VectorizedCellProcessor(Domain & domain, double cutoffR
 		CellProcessor(cutoffRadius, LJcutoffRadius), _domain(domain),
 		// maybe move the following to somewhere else:
 		_epsRFInvrc3(2. * (domain.getepsilonRF() - 1.) / ((cutoffRadius * cutoffRadius * cutoffRadius) * (2. * domain.getepsilonRF() + 1.))),
-		_eps_sig(), _shift6(), _upot6lj(0.0), _upotXpoles(0.0), _virial(0.0), _myRF(0.0){
+		_ljParameters(), _numLJTypes(0), _tabulatedCoefficients(), _tabulatedOffset(), _numLJCenters(0), _hasTabulated(), _hasLJ(),
+		_tabulatedR2Min(0.0), _tabulatedInvDelta(0.0), _tabulatedBins(1), _siteFields(), _upotFields(0.0), _upot6lj(0.0), _upotXpoles(0.0), _virial(0.0), _myRF(0.0){
 
 #if VCP_VEC_TYPE==VCP_NOVEC
 	Log::global_log->info() << "VectorizedCellProcessor: using no intrinsics." << std::endl;
@@ -52,9 +58,8 @@ VectorizedCellProcessor::VectorizedCellProcessor(Domain & domain, double cutoffR
 		centers += c->numLJcenters();
 	}
 
-	// One row for each LJ Center, one pair (epsilon*24, sigma^2) for each LJ Center in each row.
-	_eps_sig.resize(centers, AlignedArray<vcp_real_calc>(centers * 2));
-	_shift6.resize(centers, AlignedArray<vcp_real_calc>(centers));
+	// One row for each LJ Center: one pair (epsilon*24, sigma^2) for each LJ Center, followed by shift*6 for each LJ Center.
+	std::vector<std::vector<vcp_real_calc> > rows(centers, std::vector<vcp_real_calc>(3 * centers, 0.0));
 
 	// Construct the parameter tables.
 	for (size_t comp_i = 0; comp_i < components.size(); ++comp_i) {
@@ -72,14 +77,119 @@ VectorizedCellProcessor::VectorizedCellProcessor(Domain & domain, double cutoffR
 					p >> eps;
 					p >> sig;
 					p >> shift;
-					_eps_sig[compIDs[comp_i] + center_i][2 * (compIDs[comp_j] + center_j)] = static_cast <vcp_real_calc>(eps);
-					_eps_sig[compIDs[comp_i] + center_i][2 * (compIDs[comp_j] + center_j) + 1] = static_cast<vcp_real_calc>(sig);
-					_shift6[compIDs[comp_i] + center_i][compIDs[comp_j] + center_j] = static_cast<vcp_real_calc>(shift);
+					std::vector<vcp_real_calc>& row = rows[compIDs[comp_i] + center_i];
+					row[2 * (compIDs[comp_j] + center_j)] = static_cast <vcp_real_calc>(eps);
+					row[2 * (compIDs[comp_j] + center_j) + 1] = static_cast<vcp_real_calc>(sig);
+					row[2 * centers + compIDs[comp_j] + center_j] = static_cast<vcp_real_calc>(shift);
 				}
 			}
 		}
 	}
 
+	// Tabulated potentials replace the LJ interaction of all center pairs of their component pair.
+	const auto& tabulatedPotentials = _simulation.getEnsemble()->getTabulatedPotentials();
+	const TabulationGrid& grid = _simulation.getEnsemble()->getTabulationGrid();
+	_numLJCenters = centers;
+	_tabulatedOffset.resize(centers * centers);
+	_tabulatedOffset.zero();
+	_hasTabulated.resize(centers, 0);
+	std::vector<double> coefficients(TabulatedPotential::numCoefficients, 0.0);  // zero bin
+	for (const auto& potential : tabulatedPotentials) {
+		const int offset = static_cast<int>(coefficients.size());
+		const std::vector<double> table = potential->tabulate(grid, LJcutoffRadius);
+		coefficients.insert(coefficients.end(), table.begin(), table.end());
+		const int cids[2] = {potential->getCid1(), potential->getCid2()};
+		for (int side = 0; side < 2; ++side) {
+			const Component& comp_i = components[cids[side]];
+			const Component& comp_j = components[cids[1 - side]];
+			for (size_t center_i = 0; center_i < comp_i.numLJcenters(); ++center_i) {
+				const size_t row = compIDs[comp_i.ID()] + center_i;
+				_hasTabulated[row] = 1;
+				for (size_t center_j = 0; center_j < comp_j.numLJcenters(); ++center_j) {
+					const size_t col = compIDs[comp_j.ID()] + center_j;
+					_tabulatedOffset[row * centers + col] = offset;
+					rows[row][2 * col] = 0.0;
+					rows[row][2 * col + 1] = 0.0;
+					rows[row][2 * centers + col] = 0.0;
+				}
+			}
+		}
+	}
+	if (not tabulatedPotentials.empty()) {
+		if (coefficients.size() > static_cast<size_t>(std::numeric_limits<int>::max())) {
+			std::ostringstream error_message;
+			error_message << "VectorizedCellProcessor: tabulated potentials too large, reduce the number of bins." << std::endl;
+			MARDYN_EXIT(error_message.str());
+		}
+		_tabulatedCoefficients.resize(coefficients.size());
+		std::copy(coefficients.begin(), coefficients.end(), &_tabulatedCoefficients[0]);
+		_tabulatedR2Min = static_cast<vcp_real_calc>(grid.rmin * grid.rmin);
+		_tabulatedInvDelta = static_cast<vcp_real_calc>(grid.bins / (LJcutoffRadius * LJcutoffRadius - grid.rmin * grid.rmin));
+		_tabulatedBins = static_cast<int>(grid.bins);
+		Log::global_log->info() << "VectorizedCellProcessor: " << tabulatedPotentials.size() << " tabulated potential(s), "
+								<< _tabulatedCoefficients.get_size() * sizeof(vcp_real_calc) / 1024 << " KB of coefficients." << std::endl;
+	}
+
+	_hasLJ.resize(centers);
+	for (size_t id = 0; id < centers; ++id) {
+		_hasLJ[id] = std::any_of(rows[id].begin(), rows[id].end(), [](vcp_real_calc p) { return p != 0.0; });
+	}
+
+	// Compress the parameter table: centers with identical rows (and hence, by symmetry, identical columns)
+	// are of the same type. Types are ordered by the number of molecules using them, so the entries needed
+	// most often are adjacent in memory. The center ids of the SoA are also read as component lookup ids
+	// elsewhere (e.g. ODF, Permittivity) and by the site fields, so the types are stored next to them (_ljc_type).
+	std::vector<size_t> ljType(centers);
+	std::vector<size_t> typeRepresentative;
+	std::vector<unsigned long> typeFrequency;
+	for (ComponentList::const_iterator c = components.begin(); c != end; ++c) {
+		for (size_t center = 0; center < c->numLJcenters(); ++center) {
+			const size_t id = compIDs[c->ID()] + center;
+			size_t type = 0;
+			while (type < typeRepresentative.size() and rows[typeRepresentative[type]] != rows[id]) {
+				++type;
+			}
+			if (type == typeRepresentative.size()) {
+				typeRepresentative.push_back(id);
+				typeFrequency.push_back(0);
+			}
+			typeFrequency[type] += c->getNumMolecules();
+			ljType[id] = type;
+		}
+	}
+	std::vector<size_t> typeOrder(typeRepresentative.size());
+	for (size_t type = 0; type < typeOrder.size(); ++type) {
+		typeOrder[type] = type;
+	}
+	std::stable_sort(typeOrder.begin(), typeOrder.end(),
+			[&typeFrequency](size_t a, size_t b) { return typeFrequency[a] > typeFrequency[b]; });
+	std::vector<size_t> typeRank(typeOrder.size());
+	for (size_t rank = 0; rank < typeOrder.size(); ++rank) {
+		typeRank[typeOrder[rank]] = rank;
+	}
+
+	// one entry (epsilon*24, sigma^2, shift*6, 0) for each pair of types
+	_numLJTypes = typeOrder.size();
+	_ljParameters.resize(4 * _numLJTypes * _numLJTypes);
+	for (size_t type_i = 0; type_i < _numLJTypes; ++type_i) {
+		const std::vector<vcp_real_calc>& row = rows[typeRepresentative[typeOrder[type_i]]];
+		for (size_t type_j = 0; type_j < _numLJTypes; ++type_j) {
+			const size_t col = typeRepresentative[typeOrder[type_j]];
+			vcp_real_calc* const entry = &_ljParameters[4 * (type_i * _numLJTypes + type_j)];
+			entry[0] = row[2 * col];
+			entry[1] = row[2 * col + 1];
+			entry[2] = row[2 * centers + col];
+			entry[3] = 0.0;
+		}
+	}
+	CellDataSoA::ljcTypes.resize(centers);
+	for (size_t id = 0; id < centers; ++id) {
+		CellDataSoA::ljcTypes[id] = static_cast<vcp_ljc_id_t>(typeRank[ljType[id]]);
+	}
+	++CellDataSoA::ljcTypesVersion;
+	Log::global_log->info() << "VectorizedCellProcessor: " << centers << " LJ centers of " << _numLJTypes
+							<< " distinct types, parameter table " << _ljParameters.get_size() * sizeof(vcp_real_calc) << " bytes." << std::endl;
+
 	// initialize thread data
 	_numThreads = mardyn_get_max_threads();
 	Log::global_log->info() << "VectorizedCellProcessor: allocate data for " << _numThreads << " threads." << std::endl;
@@ -115,6 +225,7 @@ void VectorizedCellProcessor::initTraversal() {
 		_upot6lj = 0.0;
 		_upotXpoles = 0.0;
 		_myRF = 0.0;
+		_upotFields = 0.0;
 	} // end pragma omp master
 }
 
@@ -124,9 +235,10 @@ void VectorizedCellProcessor::endTraversal() {
 	vcp_real_accum glob_upotXpoles = 0.0;
 	vcp_real_accum glob_virial = 0.0;
 	vcp_real_accum glob_myRF = 0.0;
+	vcp_real_accum glob_upotFields = 0.0;
 
 	#if defined(_OPENMP)
-	#pragma omp parallel reduction(+:glob_upot6lj, glob_upotXpoles, glob_virial, glob_myRF)
+	#pragma omp parallel reduction(+:glob_upot6lj, glob_upotXpoles, glob_virial, glob_myRF, glob_upotFields)
 	#endif
 	{
 		const int tid = mardyn_get_thread_num();
@@ -144,6 +256,8 @@ void VectorizedCellProcessor::endTraversal() {
 		glob_upotXpoles += thread_upotXpoles;
 		glob_virial += thread_virial;
 		glob_myRF += thread_myRF;
+		glob_upotFields += _threadData[tid]->_upotFields;
+		_threadData[tid]->_upotFields = 0.0;
 	} // end pragma omp parallel reduction
 
 	_upot6lj = glob_upot6lj;
@@ -152,6 +266,21 @@ void VectorizedCellProcessor::endTraversal() {
 	_myRF = glob_myRF;
 	_domain.setLocalVirial(_virial + 3.0 * _myRF);
 	_domain.setLocalUpot(_upot6lj / 6.0 + _upotXpoles + _myRF);
+
+	if (not _siteFields.empty()) {
+		_upotFields = glob_upotFields;
+		_domain.setLocalUpotCompSpecific(_domain.getLocalUpotCompSpecific() + _upotFields);
+	}
+}
+
+bool VectorizedCellProcessor::addSiteField(ExternalSiteField* field) {
+#ifdef MARDYN_AUTOPAS
+	// AutoPas only uses the parameters of this cell processor, processCell is never called
+	return false;
+#else
+	_siteFields.push_back(field);
+	return true;
+#endif
 }
 
 	//const DoubleVec minus_one = DoubleVec::set1(-1.0); //currently not used, would produce warning
@@ -224,6 +353,71 @@ void VectorizedCellProcessor::endTraversal() {
 	}
 
 
+	template<bool calculateMacroscopic, class MaskGatherChooser>
+	vcp_inline void VectorizedCellProcessor :: _loopBodyTabulated(
+			const RealCalcVec& m1_r_x, const RealCalcVec& m1_r_y, const RealCalcVec& m1_r_z,
+			const RealCalcVec& r1_x, const RealCalcVec& r1_y, const RealCalcVec& r1_z,
+			const RealCalcVec& m2_r_x, const RealCalcVec& m2_r_y, const RealCalcVec& m2_r_z,
+			const RealCalcVec& r2_x, const RealCalcVec& r2_y, const RealCalcVec& r2_z,
+			RealCalcVec& f_x, RealCalcVec& f_y, RealCalcVec& f_z,
+			RealAccumVec& V_x, RealAccumVec& V_y, RealAccumVec& V_z,
+			RealAccumVec& sum_upot6lj, RealAccumVec& sum_virial,
+			const MaskCalcVec& forceMask,
+			const int* const tabulatedOffsetI, const vcp_ljc_id_t* const id_j,
+			const size_t& offset, const vcp_lookupOrMask_vec& lookupORforceMask)
+	{
+		const RealCalcVec c_dx = r1_x - r2_x;
+		const RealCalcVec c_dy = r1_y - r2_y;
+		const RealCalcVec c_dz = r1_z - r2_z;
+
+		const RealCalcVec c_r2 = RealCalcVec::scal_prod(c_dx, c_dy, c_dz, c_dx, c_dy, c_dz);
+
+		// position in the grid and bin index, clamped to the grid as masked lanes may contain arbitrary distances
+		const RealCalcVec s = (c_r2 - RealCalcVec::set1(_tabulatedR2Min)) * RealCalcVec::set1(_tabulatedInvDelta);
+		alignas(64) int coefficientOffsets[16];
+		const RealCalcVec t = vcp_simd_bin_index(s, _tabulatedBins, coefficientOffsets);
+
+		// table offset per lane, depends on the LJ center of the lane
+		alignas(64) int tableOffsets[16];
+		unpackTabulatedOffset<MaskGatherChooser>(tableOffsets, tabulatedOffsetI, id_j, static_cast<vcp_ljc_id_t>(offset), lookupORforceMask);
+		for (size_t k = 0; k < VCP_VEC_SIZE; ++k) {
+			coefficientOffsets[k] = tableOffsets[k] == 0 ? 0 : tableOffsets[k] + coefficientOffsets[k] * static_cast<int>(TabulatedPotential::numCoefficients);
+		}
+
+		// Horner scheme for the force scale w = F/r
+		const vcp_real_calc* const coefficients = _tabulatedCoefficients;
+		RealCalcVec w = vcp_simd_gather(coefficients + 7, coefficientOffsets);
+		w = RealCalcVec::fmadd(w, t, vcp_simd_gather(coefficients + 6, coefficientOffsets));
+		w = RealCalcVec::fmadd(w, t, vcp_simd_gather(coefficients + 5, coefficientOffsets));
+		w = RealCalcVec::fmadd(w, t, vcp_simd_gather(coefficients + 4, coefficientOffsets));
+		const RealCalcVec scale = RealCalcVec::apply_mask(w, forceMask);
+
+		const RealCalcVec tf_x = c_dx * scale;
+		const RealCalcVec tf_y = c_dy * scale;
+		const RealCalcVec tf_z = c_dz * scale;
+		f_x = f_x + tf_x;
+		f_y = f_y + tf_y;
+		f_z = f_z + tf_z;
+
+		const RealAccumVec tV_x = RealAccumVec::convertCalcToAccum((m1_r_x - m2_r_x) * tf_x);
+		const RealAccumVec tV_y = RealAccumVec::convertCalcToAccum((m1_r_y - m2_r_y) * tf_y);
+		const RealAccumVec tV_z = RealAccumVec::convertCalcToAccum((m1_r_z - m2_r_z) * tf_z);
+		V_x = V_x + tV_x;
+		V_y = V_y + tV_y;
+		V_z = V_z + tV_z;
+
+		if (calculateMacroscopic) {
+			RealCalcVec upot6 = vcp_simd_gather(coefficients + 3, coefficientOffsets);
+			upot6 = RealCalcVec::fmadd(upot6, t, vcp_simd_gather(coefficients + 2, coefficientOffsets));
+			upot6 = RealCalcVec::fmadd(upot6, t, vcp_simd_gather(coefficients + 1, coefficientOffsets));
+			upot6 = RealCalcVec::fmadd(upot6, t, vcp_simd_gather(coefficients + 0, coefficientOffsets));
+
+			sum_upot6lj = sum_upot6lj + RealAccumVec::convertCalcToAccum(RealCalcVec::apply_mask(upot6, forceMask));
+			sum_virial = sum_virial + tV_x + tV_y + tV_z;
+		}
+	}
+
+
 	template<bool calculateMacroscopic>
 	vcp_inline void VectorizedCellProcessor :: _loopBodyCharge(
 			const RealCalcVec& m1_r_x, const RealCalcVec& m1_r_y, const RealCalcVec& m1_r_z,
@@ -795,6 +989,9 @@ template<class ForcePolicy, bool CalculateMacroscopic, class MaskGatherChooser>
 void VectorizedCellProcessor::_calculatePairs(CellDataSoA & soa1, CellDataSoA & soa2) {
 	const int tid = mardyn_get_thread_num();
 	VLJCPThreadData &my_threadData = *_threadData[tid];
+	// The per-site virials follow the flag of the time step, not CalculateMacroscopic: pairs excluded from the
+	// macroscopic sums (halo pairs) still contribute to the virials of their sites.
+	const bool calculateVirials = _calculateMacroscopic;
 
 	// initialize dist lookups
 	soa2.initDistLookupPointers(my_threadData._centers_dist_lookup,
@@ -824,6 +1021,7 @@ void VectorizedCellProcessor::_calculatePairs(CellDataSoA & soa1, CellDataSoA &
 		 vcp_real_accum * const soa1_ljc_V_z = soa1.getBeginAccum(QuantityType::VIRIAL, SiteType::LJC, Coordinate::Z);
 	const int * const soa1_mol_ljc_num = soa1._mol_ljc_num;
 	const vcp_ljc_id_t * const soa1_ljc_id = soa1._ljc_id;
+	const vcp_ljc_id_t * const soa1_ljc_type = soa1._ljc_type;
 
 
 	const vcp_real_calc * const soa2_ljc_m_r_x = soa2.getBeginCalc(QuantityType::MOL_POSITION, SiteType::LJC, Coordinate::X);
@@ -839,6 +1037,13 @@ void VectorizedCellProcessor::_calculatePairs(CellDataSoA & soa1, CellDataSoA &
 		 vcp_real_accum * const soa2_ljc_V_y = soa2.getBeginAccum(QuantityType::VIRIAL, SiteType::LJC, Coordinate::Y);
 		 vcp_real_accum * const soa2_ljc_V_z = soa2.getBeginAccum(QuantityType::VIRIAL, SiteType::LJC, Coordinate::Z);
 	const vcp_ljc_id_t * const soa2_ljc_id = soa2._ljc_id;
+	const vcp_ljc_id_t * const soa2_ljc_type = soa2._ljc_type;
+
+	// If all LJ centers of the second cell are of the same type, the parameters of each type pair are broadcast instead of gathered.
+	bool soa2_ljc_single_type = soa2._ljc_num > 0;
+	for (size_t k = 1; soa2_ljc_single_type and k < soa2._ljc_num; ++k) {
+		soa2_ljc_single_type = soa2_ljc_type[k] == soa2_ljc_type[0];
+	}
 
 	vcp_lookupOrMask_single* const soa2_ljc_dist_lookup = my_threadData._ljc_dist_lookup;
 
@@ -1044,6 +1249,13 @@ void VectorizedCellProcessor::_calculatePairs(CellDataSoA & soa1, CellDataSoA &
 				const RealCalcVec c_r_y1 = RealCalcVec::broadcast(soa1_ljc_r_y + i_ljc_idx);
 				const RealCalcVec c_r_z1 = RealCalcVec::broadcast(soa1_ljc_r_z + i_ljc_idx);
 
+				const vcp_ljc_id_t id_i = soa1_ljc_id[i_ljc_idx];
+				const vcp_real_calc* const ljParametersI = &_ljParameters[4 * _numLJTypes * soa1_ljc_type[i_ljc_idx]];
+				const size_t type_j_single = soa2_ljc_single_type ? soa2_ljc_type[0] : 0;
+				const RealCalcVec eps_24_single = RealCalcVec::set1(ljParametersI[4 * type_j_single]);
+				const RealCalcVec sig2_single = RealCalcVec::set1(ljParametersI[4 * type_j_single + 1]);
+				const RealCalcVec shift6_single = RealCalcVec::set1(ljParametersI[4 * type_j_single + 2]);
+
 				// Iterate over each pair of centers in the second cell.
 				size_t j = ForcePolicy::InitJ2(i_ljc_idx);
 				for (; j < end_ljc_loop; j += VCP_VEC_SIZE) {//over (all/some) lj-centers -- amount depends on ForcePolicy::InitJ (two cells: all, within one cell: only do i,j not j,i)
@@ -1058,26 +1270,38 @@ void VectorizedCellProcessor::_calculatePairs(CellDataSoA & soa1, CellDataSoA &
 						const RealCalcVec m_r_y2 = MaskGatherChooser::load(soa2_ljc_m_r_y, j, lookupORforceMask);
 						const RealCalcVec m_r_z2 = MaskGatherChooser::load(soa2_ljc_m_r_z, j, lookupORforceMask);
 
-						const vcp_ljc_id_t id_i = soa1_ljc_id[i_ljc_idx];
-						RealCalcVec fx, fy, fz;
-						RealAccumVec Vx, Vy, Vz;
-
-						RealCalcVec eps_24;
-						RealCalcVec sig2;
-						unpackEps24Sig2<MaskGatherChooser>(eps_24, sig2, _eps_sig[id_i], soa2_ljc_id, (vcp_ljc_id_t)j, lookupORforceMask);
-
-						RealCalcVec shift6;
-						unpackShift6<MaskGatherChooser>(shift6, _shift6[id_i], soa2_ljc_id, (vcp_ljc_id_t)j, lookupORforceMask);
-
-						_loopBodyLJ<CalculateMacroscopic>(
-							m1_r_x, m1_r_y, m1_r_z, c_r_x1, c_r_y1, c_r_z1,
-							m_r_x2, m_r_y2, m_r_z2, c_r_x2, c_r_y2, c_r_z2,
-							fx, fy, fz,
-							Vx, Vy, Vz,
-							sum_upot6lj, sum_virial,
-							MaskGatherChooser::getForceMask(lookupORforceMask),
-							eps_24, sig2,
-							shift6);
+						RealCalcVec fx = RealCalcVec::zero(), fy = RealCalcVec::zero(), fz = RealCalcVec::zero();
+						RealAccumVec Vx = RealAccumVec::zero(), Vy = RealAccumVec::zero(), Vz = RealAccumVec::zero();
+
+						if (_hasLJ[id_i]) {
+							RealCalcVec eps_24 = eps_24_single;
+							RealCalcVec sig2 = sig2_single;
+							RealCalcVec shift6 = shift6_single;
+							if (not soa2_ljc_single_type) {
+								unpackEps24Sig2Shift6<MaskGatherChooser>(eps_24, sig2, shift6, ljParametersI, soa2_ljc_type, (vcp_ljc_id_t)j, lookupORforceMask);
+							}
+
+							_loopBodyLJ<CalculateMacroscopic>(
+								m1_r_x, m1_r_y, m1_r_z, c_r_x1, c_r_y1, c_r_z1,
+								m_r_x2, m_r_y2, m_r_z2, c_r_x2, c_r_y2, c_r_z2,
+								fx, fy, fz,
+								Vx, Vy, Vz,
+								sum_upot6lj, sum_virial,
+								MaskGatherChooser::getForceMask(lookupORforceMask),
+								eps_24, sig2,
+								shift6);
+						}
+
+						if (_hasTabulated[id_i]) {
+							_loopBodyTabulated<CalculateMacroscopic, MaskGatherChooser>(
+								m1_r_x, m1_r_y, m1_r_z, c_r_x1, c_r_y1, c_r_z1,
+								m_r_x2, m_r_y2, m_r_z2, c_r_x2, c_r_y2, c_r_z2,
+								fx, fy, fz,
+								Vx, Vy, Vz,
+								sum_upot6lj, sum_virial,
+								MaskGatherChooser::getForceMask(lookupORforceMask),
+								&_tabulatedOffset[id_i * _numLJCenters], soa2_ljc_id, j, lookupORforceMask);
+						}
 
 						RealAccumVec a_fx = RealAccumVec::convertCalcToAccum(fx);
 						RealAccumVec a_fy = RealAccumVec::convertCalcToAccum(fy);
@@ -1091,9 +1315,11 @@ void VectorizedCellProcessor::_calculatePairs(CellDataSoA & soa1, CellDataSoA &
 						sum_fy1 = sum_fy1 + a_fy;
 						sum_fz1 = sum_fz1 + a_fz;
 
-						vcp_simd_load_add_store<MaskGatherChooser>(soa2_ljc_V_x, j, Vx, lookupORforceMask);
-						vcp_simd_load_add_store<MaskGatherChooser>(soa2_ljc_V_y, j, Vy, lookupORforceMask);
-						vcp_simd_load_add_store<MaskGatherChooser>(soa2_ljc_V_z, j, Vz, lookupORforceMask);
+						if (calculateVirials) {
+							vcp_simd_load_add_store<MaskGatherChooser>(soa2_ljc_V_x, j, Vx, lookupORforceMask);
+							vcp_simd_load_add_store<MaskGatherChooser>(soa2_ljc_V_y, j, Vy, lookupORforceMask);
+							vcp_simd_load_add_store<MaskGatherChooser>(soa2_ljc_V_z, j, Vz, lookupORforceMask);
+						}
 
 						sum_Vx1 = sum_Vx1 + Vx;
 						sum_Vy1 = sum_Vy1 + Vy;
@@ -1119,26 +1345,38 @@ void VectorizedCellProcessor::_calculatePairs(CellDataSoA & soa1, CellDataSoA &
 						const RealCalcVec m_r_y2 = MaskGatherChooser::load(soa2_ljc_m_r_y, j, lookupORforceMask);
 						const RealCalcVec m_r_z2 = MaskGatherChooser::load(soa2_ljc_m_r_z, j, lookupORforceMask);
 
-						const size_t id_i = soa1_ljc_id[i_ljc_idx];
-						RealCalcVec fx, fy, fz;
-						RealAccumVec Vx, Vy, Vz;
-
-						RealCalcVec eps_24;
-						RealCalcVec sig2;
-						unpackEps24Sig2<MaskGatherChooser>(eps_24, sig2, _eps_sig[id_i], soa2_ljc_id, (vcp_ljc_id_t)j, lookupORforceMask);
-
-						RealCalcVec shift6;
-						unpackShift6<MaskGatherChooser>(shift6, _shift6[id_i], soa2_ljc_id, (vcp_ljc_id_t)j, lookupORforceMask);
-
-						_loopBodyLJ<CalculateMacroscopic>(
-							m1_r_x, m1_r_y, m1_r_z, c_r_x1, c_r_y1, c_r_z1,
-							m_r_x2, m_r_y2, m_r_z2, c_r_x2, c_r_y2, c_r_z2,
-							fx, fy, fz,
-							Vx, Vy, Vz,
-							sum_upot6lj, sum_virial,
-							remainderM,//use remainder mask as forcemask
-							eps_24, sig2,
-							shift6);
+						RealCalcVec fx = RealCalcVec::zero(), fy = RealCalcVec::zero(), fz = RealCalcVec::zero();
+						RealAccumVec Vx = RealAccumVec::zero(), Vy = RealAccumVec::zero(), Vz = RealAccumVec::zero();
+
+						if (_hasLJ[id_i]) {
+							RealCalcVec eps_24 = eps_24_single;
+							RealCalcVec sig2 = sig2_single;
+							RealCalcVec shift6 = shift6_single;
+							if (not soa2_ljc_single_type) {
+								unpackEps24Sig2Shift6<MaskGatherChooser>(eps_24, sig2, shift6, ljParametersI, soa2_ljc_type, (vcp_ljc_id_t)j, lookupORforceMask);
+							}
+
+							_loopBodyLJ<CalculateMacroscopic>(
+								m1_r_x, m1_r_y, m1_r_z, c_r_x1, c_r_y1, c_r_z1,
+								m_r_x2, m_r_y2, m_r_z2, c_r_x2, c_r_y2, c_r_z2,
+								fx, fy, fz,
+								Vx, Vy, Vz,
+								sum_upot6lj, sum_virial,
+								remainderM,//use remainder mask as forcemask
+								eps_24, sig2,
+								shift6);
+						}
+
+						if (_hasTabulated[id_i]) {
+							_loopBodyTabulated<CalculateMacroscopic, MaskGatherChooser>(
+								m1_r_x, m1_r_y, m1_r_z, c_r_x1, c_r_y1, c_r_z1,
+								m_r_x2, m_r_y2, m_r_z2, c_r_x2, c_r_y2, c_r_z2,
+								fx, fy, fz,
+								Vx, Vy, Vz,
+								sum_upot6lj, sum_virial,
+								remainderM,
+								&_tabulatedOffset[id_i * _numLJCenters], soa2_ljc_id, j, lookupORforceMask);
+						}
 
 						RealAccumVec a_fx = RealAccumVec::convertCalcToAccum(fx);
 						RealAccumVec a_fy = RealAccumVec::convertCalcToAccum(fy);
@@ -1152,9 +1390,11 @@ void VectorizedCellProcessor::_calculatePairs(CellDataSoA & soa1, CellDataSoA &
 						sum_fy1 = sum_fy1 + a_fy;
 						sum_fz1 = sum_fz1 + a_fz;
 
-						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_ljc_V_x, j, Vx, lookupORforceMask, remainderM);
-						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_ljc_V_y, j, Vy, lookupORforceMask, remainderM);
-						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_ljc_V_z, j, Vz, lookupORforceMask, remainderM);
+						if (calculateVirials) {
+							vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_ljc_V_x, j, Vx, lookupORforceMask, remainderM);
+							vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_ljc_V_y, j, Vy, lookupORforceMask, remainderM);
+							vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_ljc_V_z, j, Vz, lookupORforceMask, remainderM);
+						}
 
 
 						sum_Vx1 = sum_Vx1 + Vx;
@@ -1169,9 +1409,11 @@ void VectorizedCellProcessor::_calculatePairs(CellDataSoA & soa1, CellDataSoA &
 				hSum_Add_Store(soa1_ljc_f_y + i_ljc_idx, sum_fy1);
 				hSum_Add_Store(soa1_ljc_f_z + i_ljc_idx, sum_fz1);
 
-				hSum_Add_Store(soa1_ljc_V_x + i_ljc_idx, sum_Vx1);
-				hSum_Add_Store(soa1_ljc_V_y + i_ljc_idx, sum_Vy1);
-				hSum_Add_Store(soa1_ljc_V_z + i_ljc_idx, sum_Vz1);
+				if (calculateVirials) {
+					hSum_Add_Store(soa1_ljc_V_x + i_ljc_idx, sum_Vx1);
+					hSum_Add_Store(soa1_ljc_V_y + i_ljc_idx, sum_Vy1);
+					hSum_Add_Store(soa1_ljc_V_z + i_ljc_idx, sum_Vz1);
+				}
 
 				i_ljc_idx++;
 			}
@@ -1246,9 +1488,11 @@ void VectorizedCellProcessor::_calculatePairs(CellDataSoA & soa1, CellDataSoA &
 						sum_V1_y = sum_V1_y + Vy;
 						sum_V1_z = sum_V1_z + Vz;
 
-						vcp_simd_load_add_store<MaskGatherChooser>(soa2_charges_V_x, j, Vx, lookupORforceMask);
-						vcp_simd_load_add_store<MaskGatherChooser>(soa2_charges_V_y, j, Vy, lookupORforceMask);
-						vcp_simd_load_add_store<MaskGatherChooser>(soa2_charges_V_z, j, Vz, lookupORforceMask);
+						if (calculateVirials) {
+							vcp_simd_load_add_store<MaskGatherChooser>(soa2_charges_V_x, j, Vx, lookupORforceMask);
+							vcp_simd_load_add_store<MaskGatherChooser>(soa2_charges_V_y, j, Vy, lookupORforceMask);
+							vcp_simd_load_add_store<MaskGatherChooser>(soa2_charges_V_z, j, Vz, lookupORforceMask);
+						}
 					}
 				}
 #if VCP_VEC_TYPE == VCP_VEC_KNL_GATHER or VCP_VEC_TYPE == VCP_VEC_AVX512F_GATHER
@@ -1298,9 +1542,11 @@ void VectorizedCellProcessor::_calculatePairs(CellDataSoA & soa1, CellDataSoA &
 						sum_V1_y = sum_V1_y + Vy;
 						sum_V1_z = sum_V1_z + Vz;
 
-						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_charges_V_x, j, Vx, lookupORforceMask, remainderM);
-						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_charges_V_y, j, Vy, lookupORforceMask, remainderM);
-						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_charges_V_z, j, Vz, lookupORforceMask, remainderM);
+						if (calculateVirials) {
+							vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_charges_V_x, j, Vx, lookupORforceMask, remainderM);
+							vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_charges_V_y, j, Vy, lookupORforceMask, remainderM);
+							vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_charges_V_z, j, Vz, lookupORforceMask, remainderM);
+						}
 					}
 				}
 #endif
@@ -1310,9 +1556,11 @@ void VectorizedCellProcessor::_calculatePairs(CellDataSoA & soa1, CellDataSoA &
 				hSum_Add_Store(soa1_charges_f_y + i_charge_idx + local_i, sum_f1_y);
 				hSum_Add_Store(soa1_charges_f_z + i_charge_idx + local_i, sum_f1_z);
 				// Add old virial and summed calculated virials for center 1
-				hSum_Add_Store(soa1_charges_V_x + i_charge_idx + local_i, sum_V1_x);
-				hSum_Add_Store(soa1_charges_V_y + i_charge_idx + local_i, sum_V1_y);
-				hSum_Add_Store(soa1_charges_V_z + i_charge_idx + local_i, sum_V1_z);
+				if (calculateVirials) {
+					hSum_Add_Store(soa1_charges_V_x + i_charge_idx + local_i, sum_V1_x);
+					hSum_Add_Store(soa1_charges_V_y + i_charge_idx + local_i, sum_V1_y);
+					hSum_Add_Store(soa1_charges_V_z + i_charge_idx + local_i, sum_V1_z);
+				}
 
 			}
 
@@ -1386,9 +1634,11 @@ void VectorizedCellProcessor::_calculatePairs(CellDataSoA & soa1, CellDataSoA &
 						sum_V1_y = sum_V1_y + Vy;
 						sum_V1_z = sum_V1_z + Vz;
 
-						vcp_simd_load_add_store<MaskGatherChooser>(soa2_charges_V_x, j, Vx, lookupORforceMask);//newton 3
-						vcp_simd_load_add_store<MaskGatherChooser>(soa2_charges_V_y, j, Vy, lookupORforceMask);//newton 3
-						vcp_simd_load_add_store<MaskGatherChooser>(soa2_charges_V_z, j, Vz, lookupORforceMask);//newton 3
+						if (calculateVirials) {
+							vcp_simd_load_add_store<MaskGatherChooser>(soa2_charges_V_x, j, Vx, lookupORforceMask);//newton 3
+							vcp_simd_load_add_store<MaskGatherChooser>(soa2_charges_V_y, j, Vy, lookupORforceMask);//newton 3
+							vcp_simd_load_add_store<MaskGatherChooser>(soa2_charges_V_z, j, Vz, lookupORforceMask);//newton 3
+						}
 
 						// Store torque
 
@@ -1448,9 +1698,11 @@ void VectorizedCellProcessor::_calculatePairs(CellDataSoA & soa1, CellDataSoA &
 						sum_V1_y = sum_V1_y + Vy;
 						sum_V1_z = sum_V1_z + Vz;
 
-						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_charges_V_x, j, Vx, lookupORforceMask, remainderM);//newton 3
-						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_charges_V_y, j, Vy, lookupORforceMask, remainderM);//newton 3
-						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_charges_V_z, j, Vz, lookupORforceMask, remainderM);//newton 3
+						if (calculateVirials) {
+							vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_charges_V_x, j, Vx, lookupORforceMask, remainderM);//newton 3
+							vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_charges_V_y, j, Vy, lookupORforceMask, remainderM);//newton 3
+							vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_charges_V_z, j, Vz, lookupORforceMask, remainderM);//newton 3
+						}
 
 						// Store torque
 
@@ -1466,9 +1718,11 @@ void VectorizedCellProcessor::_calculatePairs(CellDataSoA & soa1, CellDataSoA &
 				hSum_Add_Store(soa1_dipoles_f_z + i_dipole_charge_idx, sum_f1_z);
 
 				// Add old virials and summed calculated virials for center 1
-				hSum_Add_Store(soa1_dipoles_V_x + i_dipole_charge_idx, sum_V1_x);
-				hSum_Add_Store(soa1_dipoles_V_y + i_dipole_charge_idx, sum_V1_y);
-				hSum_Add_Store(soa1_dipoles_V_z + i_dipole_charge_idx, sum_V1_z);
+				if (calculateVirials) {
+					hSum_Add_Store(soa1_dipoles_V_x + i_dipole_charge_idx, sum_V1_x);
+					hSum_Add_Store(soa1_dipoles_V_y + i_dipole_charge_idx, sum_V1_y);
+					hSum_Add_Store(soa1_dipoles_V_z + i_dipole_charge_idx, sum_V1_z);
+				}
 
 				// Add old torques and summed calculated torques for center 1
 				hSum_Add_Store(soa1_dipoles_M_x + i_dipole_charge_idx, sum_M_x);
@@ -1550,9 +1804,11 @@ void VectorizedCellProcessor::_calculatePairs(CellDataSoA & soa1, CellDataSoA &
 						sum_V1_y = sum_V1_y + Vy;
 						sum_V1_z = sum_V1_z + Vz;
 
-						vcp_simd_load_add_store<MaskGatherChooser>(soa2_charges_V_x, j, Vx, lookupORforceMask);//newton 3
-						vcp_simd_load_add_store<MaskGatherChooser>(soa2_charges_V_y, j, Vy, lookupORforceMask);//newton 3
-						vcp_simd_load_add_store<MaskGatherChooser>(soa2_charges_V_z, j, Vz, lookupORforceMask);//newton 3
+						if (calculateVirials) {
+							vcp_simd_load_add_store<MaskGatherChooser>(soa2_charges_V_x, j, Vx, lookupORforceMask);//newton 3
+							vcp_simd_load_add_store<MaskGatherChooser>(soa2_charges_V_y, j, Vy, lookupORforceMask);//newton 3
+							vcp_simd_load_add_store<MaskGatherChooser>(soa2_charges_V_z, j, Vz, lookupORforceMask);//newton 3
+						}
 
 
 						// Store torque
@@ -1615,9 +1871,11 @@ void VectorizedCellProcessor::_calculatePairs(CellDataSoA & soa1, CellDataSoA &
 						sum_V1_z = sum_V1_z + Vz;
 
 
-						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_charges_V_x, j, Vx, lookupORforceMask, remainderM);//newton 3
-						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_charges_V_y, j, Vy, lookupORforceMask, remainderM);//newton 3
-						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_charges_V_z, j, Vz, lookupORforceMask, remainderM);//newton 3
+						if (calculateVirials) {
+							vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_charges_V_x, j, Vx, lookupORforceMask, remainderM);//newton 3
+							vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_charges_V_y, j, Vy, lookupORforceMask, remainderM);//newton 3
+							vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_charges_V_z, j, Vz, lookupORforceMask, remainderM);//newton 3
+						}
 
 
 						// Store torque
@@ -1635,9 +1893,11 @@ void VectorizedCellProcessor::_calculatePairs(CellDataSoA & soa1, CellDataSoA &
 				hSum_Add_Store(soa1_quadrupoles_f_z + i_quadrupole_charge_idx, sum_f1_z);
 
 				// Add old virials and summed calculated virials for center 1
-				hSum_Add_Store(soa1_quadrupoles_V_x + i_quadrupole_charge_idx, sum_V1_x);
-				hSum_Add_Store(soa1_quadrupoles_V_y + i_quadrupole_charge_idx, sum_V1_y);
-				hSum_Add_Store(soa1_quadrupoles_V_z + i_quadrupole_charge_idx, sum_V1_z);
+				if (calculateVirials) {
+					hSum_Add_Store(soa1_quadrupoles_V_x + i_quadrupole_charge_idx, sum_V1_x);
+					hSum_Add_Store(soa1_quadrupoles_V_y + i_quadrupole_charge_idx, sum_V1_y);
+					hSum_Add_Store(soa1_quadrupoles_V_z + i_quadrupole_charge_idx, sum_V1_z);
+				}
 
 				// Add old torques and summed calculated torques for center 1
 				hSum_Add_Store(soa1_quadrupoles_M_x + i_quadrupole_charge_idx, sum_M1_x);
@@ -1735,9 +1995,11 @@ void VectorizedCellProcessor::_calculatePairs(CellDataSoA & soa1, CellDataSoA &
 						sum_V1_y = sum_V1_y + Vy;
 						sum_V1_z = sum_V1_z + Vz;
 
-						vcp_simd_load_add_store<MaskGatherChooser>(soa2_dipoles_V_x, j, Vx, lookupORforceMask);//newton 3
-						vcp_simd_load_add_store<MaskGatherChooser>(soa2_dipoles_V_y, j, Vy, lookupORforceMask);//newton 3
-						vcp_simd_load_add_store<MaskGatherChooser>(soa2_dipoles_V_z, j, Vz, lookupORforceMask);//newton 3
+						if (calculateVirials) {
+							vcp_simd_load_add_store<MaskGatherChooser>(soa2_dipoles_V_x, j, Vx, lookupORforceMask);//newton 3
+							vcp_simd_load_add_store<MaskGatherChooser>(soa2_dipoles_V_y, j, Vy, lookupORforceMask);//newton 3
+							vcp_simd_load_add_store<MaskGatherChooser>(soa2_dipoles_V_z, j, Vz, lookupORforceMask);//newton 3
+						}
 
 
 						// Store torque
@@ -1807,9 +2069,11 @@ void VectorizedCellProcessor::_calculatePairs(CellDataSoA & soa1, CellDataSoA &
 						sum_V1_y = sum_V1_y + Vy;
 						sum_V1_z = sum_V1_z + Vz;
 
-						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_dipoles_V_x, j, Vx, lookupORforceMask, remainderM);//newton 3
-						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_dipoles_V_y, j, Vy, lookupORforceMask, remainderM);//newton 3
-						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_dipoles_V_z, j, Vz, lookupORforceMask, remainderM);//newton 3
+						if (calculateVirials) {
+							vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_dipoles_V_x, j, Vx, lookupORforceMask, remainderM);//newton 3
+							vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_dipoles_V_y, j, Vy, lookupORforceMask, remainderM);//newton 3
+							vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_dipoles_V_z, j, Vz, lookupORforceMask, remainderM);//newton 3
+						}
 
 
 						// Store torque
@@ -1831,9 +2095,11 @@ void VectorizedCellProcessor::_calculatePairs(CellDataSoA & soa1, CellDataSoA &
 				hSum_Add_Store(soa1_dipoles_f_z + i_dipole_idx + local_i, sum_f1_z);
 
 				// Add old virials and summed calculated virials for center 1
-				hSum_Add_Store(soa1_dipoles_V_x + i_dipole_idx + local_i, sum_V1_x);
-				hSum_Add_Store(soa1_dipoles_V_y + i_dipole_idx + local_i, sum_V1_y);
-				hSum_Add_Store(soa1_dipoles_V_z + i_dipole_idx + local_i, sum_V1_z);
+				if (calculateVirials) {
+					hSum_Add_Store(soa1_dipoles_V_x + i_dipole_idx + local_i, sum_V1_x);
+					hSum_Add_Store(soa1_dipoles_V_y + i_dipole_idx + local_i, sum_V1_y);
+					hSum_Add_Store(soa1_dipoles_V_z + i_dipole_idx + local_i, sum_V1_z);
+				}
 
 				// Add old torques and summed calculated torques for center 1
 				hSum_Add_Store(soa1_dipoles_M_x + i_dipole_idx + local_i, sum_M1_x);
@@ -1911,9 +2177,11 @@ void VectorizedCellProcessor::_calculatePairs(CellDataSoA & soa1, CellDataSoA &
 						sum_V1_y = sum_V1_y + Vy;
 						sum_V1_z = sum_V1_z + Vz;
 
-						vcp_simd_load_add_store<MaskGatherChooser>(soa2_dipoles_V_x, j, Vx, lookupORforceMask);//newton 3
-						vcp_simd_load_add_store<MaskGatherChooser>(soa2_dipoles_V_y, j, Vy, lookupORforceMask);//newton 3
-						vcp_simd_load_add_store<MaskGatherChooser>(soa2_dipoles_V_z, j, Vz, lookupORforceMask);//newton 3
+						if (calculateVirials) {
+							vcp_simd_load_add_store<MaskGatherChooser>(soa2_dipoles_V_x, j, Vx, lookupORforceMask);//newton 3
+							vcp_simd_load_add_store<MaskGatherChooser>(soa2_dipoles_V_y, j, Vy, lookupORforceMask);//newton 3
+							vcp_simd_load_add_store<MaskGatherChooser>(soa2_dipoles_V_z, j, Vz, lookupORforceMask);//newton 3
+						}
 
 						// Store torque
 
@@ -1978,9 +2246,11 @@ void VectorizedCellProcessor::_calculatePairs(CellDataSoA & soa1, CellDataSoA &
 						sum_V1_y = sum_V1_y + Vy;
 						sum_V1_z = sum_V1_z + Vz;
 
-						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_dipoles_V_x, j, Vx, lookupORforceMask, remainderM);//newton 3
-						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_dipoles_V_y, j, Vy, lookupORforceMask, remainderM);//newton 3
-						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_dipoles_V_z, j, Vz, lookupORforceMask, remainderM);//newton 3
+						if (calculateVirials) {
+							vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_dipoles_V_x, j, Vx, lookupORforceMask, remainderM);//newton 3
+							vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_dipoles_V_y, j, Vy, lookupORforceMask, remainderM);//newton 3
+							vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_dipoles_V_z, j, Vz, lookupORforceMask, remainderM);//newton 3
+						}
 
 						// Store torque
 
@@ -1996,9 +2266,11 @@ void VectorizedCellProcessor::_calculatePairs(CellDataSoA & soa1, CellDataSoA &
 				hSum_Add_Store(soa1_charges_f_z + i_charge_dipole_idx, sum_f1_z);
 
 				// Add old virials and summed calculated virials for center 1
-				hSum_Add_Store(soa1_charges_V_x + i_charge_dipole_idx, sum_V1_x);
-				hSum_Add_Store(soa1_charges_V_y + i_charge_dipole_idx, sum_V1_y);
-				hSum_Add_Store(soa1_charges_V_z + i_charge_dipole_idx, sum_V1_z);
+				if (calculateVirials) {
+					hSum_Add_Store(soa1_charges_V_x + i_charge_dipole_idx, sum_V1_x);
+					hSum_Add_Store(soa1_charges_V_y + i_charge_dipole_idx, sum_V1_y);
+					hSum_Add_Store(soa1_charges_V_z + i_charge_dipole_idx, sum_V1_z);
+				}
 
 				i_charge_dipole_idx++;
 			}
@@ -2077,9 +2349,11 @@ void VectorizedCellProcessor::_calculatePairs(CellDataSoA & soa1, CellDataSoA &
 						sum_V1_y = sum_V1_y + Vy;
 						sum_V1_z = sum_V1_z + Vz;
 
-						vcp_simd_load_add_store<MaskGatherChooser>(soa2_dipoles_V_x, j, Vx, lookupORforceMask);//newton 3
-						vcp_simd_load_add_store<MaskGatherChooser>(soa2_dipoles_V_y, j, Vy, lookupORforceMask);//newton 3
-						vcp_simd_load_add_store<MaskGatherChooser>(soa2_dipoles_V_z, j, Vz, lookupORforceMask);//newton 3
+						if (calculateVirials) {
+							vcp_simd_load_add_store<MaskGatherChooser>(soa2_dipoles_V_x, j, Vx, lookupORforceMask);//newton 3
+							vcp_simd_load_add_store<MaskGatherChooser>(soa2_dipoles_V_y, j, Vy, lookupORforceMask);//newton 3
+							vcp_simd_load_add_store<MaskGatherChooser>(soa2_dipoles_V_z, j, Vz, lookupORforceMask);//newton 3
+						}
 
 						// Store torque
 
@@ -2147,9 +2421,11 @@ void VectorizedCellProcessor::_calculatePairs(CellDataSoA & soa1, CellDataSoA &
 						sum_V1_y = sum_V1_y + Vy;
 						sum_V1_z = sum_V1_z + Vz;
 
-						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_dipoles_V_x, j, Vx, lookupORforceMask, remainderM);//newton 3
-						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_dipoles_V_y, j, Vy, lookupORforceMask, remainderM);//newton 3
-						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_dipoles_V_z, j, Vz, lookupORforceMask, remainderM);//newton 3
+						if (calculateVirials) {
+							vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_dipoles_V_x, j, Vx, lookupORforceMask, remainderM);//newton 3
+							vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_dipoles_V_y, j, Vy, lookupORforceMask, remainderM);//newton 3
+							vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_dipoles_V_z, j, Vz, lookupORforceMask, remainderM);//newton 3
+						}
 
 
 
@@ -2173,9 +2449,11 @@ void VectorizedCellProcessor::_calculatePairs(CellDataSoA & soa1, CellDataSoA &
 				hSum_Add_Store(soa1_quadrupoles_f_z + i_quadrupole_dipole_idx, sum_f1_z);
 
 				// Add old virials and summed calculated virials for center 1
-				hSum_Add_Store(soa1_quadrupoles_V_x + i_quadrupole_dipole_idx, sum_V1_x);
-				hSum_Add_Store(soa1_quadrupoles_V_y + i_quadrupole_dipole_idx, sum_V1_y);
-				hSum_Add_Store(soa1_quadrupoles_V_z + i_quadrupole_dipole_idx, sum_V1_z);
+				if (calculateVirials) {
+					hSum_Add_Store(soa1_quadrupoles_V_x + i_quadrupole_dipole_idx, sum_V1_x);
+					hSum_Add_Store(soa1_quadrupoles_V_y + i_quadrupole_dipole_idx, sum_V1_y);
+					hSum_Add_Store(soa1_quadrupoles_V_z + i_quadrupole_dipole_idx, sum_V1_z);
+				}
 
 				// Add old torques and summed calculated torques for center 1
 				hSum_Add_Store(soa1_quadrupoles_M_x + i_quadrupole_dipole_idx, sum_M1_x);
@@ -2273,9 +2551,11 @@ void VectorizedCellProcessor::_calculatePairs(CellDataSoA & soa1, CellDataSoA &
 						sum_V1_y = sum_V1_y + Vy;
 						sum_V1_z = sum_V1_z + Vz;
 
-						vcp_simd_load_add_store<MaskGatherChooser>(soa2_quadrupoles_V_x, j, Vx, lookupORforceMask);//newton 3
-						vcp_simd_load_add_store<MaskGatherChooser>(soa2_quadrupoles_V_y, j, Vy, lookupORforceMask);//newton 3
-						vcp_simd_load_add_store<MaskGatherChooser>(soa2_quadrupoles_V_z, j, Vz, lookupORforceMask);//newton 3
+						if (calculateVirials) {
+							vcp_simd_load_add_store<MaskGatherChooser>(soa2_quadrupoles_V_x, j, Vx, lookupORforceMask);//newton 3
+							vcp_simd_load_add_store<MaskGatherChooser>(soa2_quadrupoles_V_y, j, Vy, lookupORforceMask);//newton 3
+							vcp_simd_load_add_store<MaskGatherChooser>(soa2_quadrupoles_V_z, j, Vz, lookupORforceMask);//newton 3
+						}
 
 						// Store torque
 
@@ -2341,9 +2621,11 @@ void VectorizedCellProcessor::_calculatePairs(CellDataSoA & soa1, CellDataSoA &
 						sum_V1_y = sum_V1_y + Vy;
 						sum_V1_z = sum_V1_z + Vz;
 
-						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_quadrupoles_V_x, j, Vx, lookupORforceMask, remainderM);//newton 3
-						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_quadrupoles_V_y, j, Vy, lookupORforceMask, remainderM);//newton 3
-						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_quadrupoles_V_z, j, Vz, lookupORforceMask, remainderM);//newton 3
+						if (calculateVirials) {
+							vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_quadrupoles_V_x, j, Vx, lookupORforceMask, remainderM);//newton 3
+							vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_quadrupoles_V_y, j, Vy, lookupORforceMask, remainderM);//newton 3
+							vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_quadrupoles_V_z, j, Vz, lookupORforceMask, remainderM);//newton 3
+						}
 
 
 						// Store torque
@@ -2364,9 +2646,11 @@ void VectorizedCellProcessor::_calculatePairs(CellDataSoA & soa1, CellDataSoA &
 				hSum_Add_Store(soa1_quadrupoles_f_z + i_quadrupole_idx + local_i, sum_f1_z);
 
 				// Add old virials and summed calculated virials for center 1
-				hSum_Add_Store(soa1_quadrupoles_V_x + i_quadrupole_idx + local_i, sum_V1_x);
-				hSum_Add_Store(soa1_quadrupoles_V_y + i_quadrupole_idx + local_i, sum_V1_y);
-				hSum_Add_Store(soa1_quadrupoles_V_z + i_quadrupole_idx + local_i, sum_V1_z);
+				if (calculateVirials) {
+					hSum_Add_Store(soa1_quadrupoles_V_x + i_quadrupole_idx + local_i, sum_V1_x);
+					hSum_Add_Store(soa1_quadrupoles_V_y + i_quadrupole_idx + local_i, sum_V1_y);
+					hSum_Add_Store(soa1_quadrupoles_V_z + i_quadrupole_idx + local_i, sum_V1_z);
+				}
 
 				// Add old torques and summed calculated torques for center 1
 				hSum_Add_Store(soa1_quadrupoles_M_x + i_quadrupole_idx + local_i, sum_M1_x);
@@ -2442,9 +2726,11 @@ void VectorizedCellProcessor::_calculatePairs(CellDataSoA & soa1, CellDataSoA &
 						sum_V1_y = sum_V1_y + Vy;
 						sum_V1_z = sum_V1_z + Vz;
 
-						vcp_simd_load_add_store<MaskGatherChooser>(soa2_quadrupoles_V_x, j, Vx, lookupORforceMask);//newton 3
-						vcp_simd_load_add_store<MaskGatherChooser>(soa2_quadrupoles_V_y, j, Vy, lookupORforceMask);//newton 3
-						vcp_simd_load_add_store<MaskGatherChooser>(soa2_quadrupoles_V_z, j, Vz, lookupORforceMask);//newton 3
+						if (calculateVirials) {
+							vcp_simd_load_add_store<MaskGatherChooser>(soa2_quadrupoles_V_x, j, Vx, lookupORforceMask);//newton 3
+							vcp_simd_load_add_store<MaskGatherChooser>(soa2_quadrupoles_V_y, j, Vy, lookupORforceMask);//newton 3
+							vcp_simd_load_add_store<MaskGatherChooser>(soa2_quadrupoles_V_z, j, Vz, lookupORforceMask);//newton 3
+						}
 
 
 						// Store torque
@@ -2509,9 +2795,11 @@ void VectorizedCellProcessor::_calculatePairs(CellDataSoA & soa1, CellDataSoA &
 						sum_V1_y = sum_V1_y + Vy;
 						sum_V1_z = sum_V1_z + Vz;
 
-						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_quadrupoles_V_x, j, Vx, lookupORforceMask, remainderM);//newton 3
-						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_quadrupoles_V_y, j, Vy, lookupORforceMask, remainderM);//newton 3
-						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_quadrupoles_V_z, j, Vz, lookupORforceMask, remainderM);//newton 3
+						if (calculateVirials) {
+							vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_quadrupoles_V_x, j, Vx, lookupORforceMask, remainderM);//newton 3
+							vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_quadrupoles_V_y, j, Vy, lookupORforceMask, remainderM);//newton 3
+							vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_quadrupoles_V_z, j, Vz, lookupORforceMask, remainderM);//newton 3
+						}
 
 
 						// Store torque
@@ -2528,9 +2816,11 @@ void VectorizedCellProcessor::_calculatePairs(CellDataSoA & soa1, CellDataSoA &
 				hSum_Add_Store(soa1_charges_f_y + i_charge_quadrupole_idx, sum_f1_y);
 				hSum_Add_Store(soa1_charges_f_z + i_charge_quadrupole_idx, sum_f1_z);
 				// Add old virials and summed calculated virials for center 1
-				hSum_Add_Store(soa1_charges_V_x + i_charge_quadrupole_idx, sum_V1_x);
-				hSum_Add_Store(soa1_charges_V_y + i_charge_quadrupole_idx, sum_V1_y);
-				hSum_Add_Store(soa1_charges_V_z + i_charge_quadrupole_idx, sum_V1_z);
+				if (calculateVirials) {
+					hSum_Add_Store(soa1_charges_V_x + i_charge_quadrupole_idx, sum_V1_x);
+					hSum_Add_Store(soa1_charges_V_y + i_charge_quadrupole_idx, sum_V1_y);
+					hSum_Add_Store(soa1_charges_V_z + i_charge_quadrupole_idx, sum_V1_z);
+				}
 
 				i_charge_quadrupole_idx++;
 			}
@@ -2610,9 +2900,11 @@ void VectorizedCellProcessor::_calculatePairs(CellDataSoA & soa1, CellDataSoA &
 						sum_V1_y = sum_V1_y + Vy;
 						sum_V1_z = sum_V1_z + Vz;
 
-						vcp_simd_load_add_store<MaskGatherChooser>(soa2_quadrupoles_V_x, j, Vx, lookupORforceMask);//newton 3
-						vcp_simd_load_add_store<MaskGatherChooser>(soa2_quadrupoles_V_y, j, Vy, lookupORforceMask);//newton 3
-						vcp_simd_load_add_store<MaskGatherChooser>(soa2_quadrupoles_V_z, j, Vz, lookupORforceMask);//newton 3
+						if (calculateVirials) {
+							vcp_simd_load_add_store<MaskGatherChooser>(soa2_quadrupoles_V_x, j, Vx, lookupORforceMask);//newton 3
+							vcp_simd_load_add_store<MaskGatherChooser>(soa2_quadrupoles_V_y, j, Vy, lookupORforceMask);//newton 3
+							vcp_simd_load_add_store<MaskGatherChooser>(soa2_quadrupoles_V_z, j, Vz, lookupORforceMask);//newton 3
+						}
 
 
 						// Store torque
@@ -2680,9 +2972,11 @@ void VectorizedCellProcessor::_calculatePairs(CellDataSoA & soa1, CellDataSoA &
 						sum_V1_y = sum_V1_y + Vy;
 						sum_V1_z = sum_V1_z + Vz;
 
-						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_quadrupoles_V_x, j, Vx, lookupORforceMask, remainderM);//newton 3
-						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_quadrupoles_V_y, j, Vy, lookupORforceMask, remainderM);//newton 3
-						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_quadrupoles_V_z, j, Vz, lookupORforceMask, remainderM);//newton 3
+						if (calculateVirials) {
+							vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_quadrupoles_V_x, j, Vx, lookupORforceMask, remainderM);//newton 3
+							vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_quadrupoles_V_y, j, Vy, lookupORforceMask, remainderM);//newton 3
+							vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_quadrupoles_V_z, j, Vz, lookupORforceMask, remainderM);//newton 3
+						}
 
 
 						// Store torque
@@ -2704,9 +2998,11 @@ void VectorizedCellProcessor::_calculatePairs(CellDataSoA & soa1, CellDataSoA &
 				hSum_Add_Store(soa1_dipoles_f_z + i_dipole_quadrupole_idx, sum_f1_z);
 
 				// Add old virials and summed calculated virials for center 1
-				hSum_Add_Store(soa1_dipoles_V_x + i_dipole_quadrupole_idx, sum_V1_x);
-				hSum_Add_Store(soa1_dipoles_V_y + i_dipole_quadrupole_idx, sum_V1_y);
-				hSum_Add_Store(soa1_dipoles_V_z + i_dipole_quadrupole_idx, sum_V1_z);
+				if (calculateVirials) {
+					hSum_Add_Store(soa1_dipoles_V_x + i_dipole_quadrupole_idx, sum_V1_x);
+					hSum_Add_Store(soa1_dipoles_V_y + i_dipole_quadrupole_idx, sum_V1_y);
+					hSum_Add_Store(soa1_dipoles_V_z + i_dipole_quadrupole_idx, sum_V1_z);
+				}
 
 				// Add old torques and summed calculated torques for center 1
 				hSum_Add_Store(soa1_dipoles_M_x + i_dipole_quadrupole_idx, sum_M1_x);
@@ -2721,24 +3017,69 @@ void VectorizedCellProcessor::_calculatePairs(CellDataSoA & soa1, CellDataSoA &
 		}
 	}
 
-	sum_upot6lj.aligned_load_add_store(&my_threadData._upot6ljV[0]);
-	sum_upotXpoles.aligned_load_add_store(&my_threadData._upotXpolesV[0]);
-	sum_virial.aligned_load_add_store(&my_threadData._virialV[0]);
-	const RealAccumVec negative_sum_myRF = RealAccumVec::zero() - sum_myRF;
-	negative_sum_myRF.aligned_load_add_store(&my_threadData._myRFV[0]);
+	if (CalculateMacroscopic) {
+		sum_upot6lj.aligned_load_add_store(&my_threadData._upot6ljV[0]);
+		sum_upotXpoles.aligned_load_add_store(&my_threadData._upotXpolesV[0]);
+		sum_virial.aligned_load_add_store(&my_threadData._virialV[0]);
+		const RealAccumVec negative_sum_myRF = RealAccumVec::zero() - sum_myRF;
+		negative_sum_myRF.aligned_load_add_store(&my_threadData._myRFV[0]);
+	}
 
 } // void LennardJonesCellHandler::CalculatePairs_(LJSoA & soa1, LJSoA & soa2)
 
+template<class ForcePolicy>
+void VectorizedCellProcessor::_calculatePairsMacroscopicIf(const bool calculateMacroscopic, CellDataSoA & soa1, CellDataSoA & soa2) {
+	if (calculateMacroscopic) {
+		_calculatePairs<ForcePolicy, true, MaskGatherC>(soa1, soa2);
+	} else {
+		_calculatePairs<ForcePolicy, false, MaskGatherC>(soa1, soa2);
+	}
+}
+
+void VectorizedCellProcessor::_applySiteFields(ParticleCell& cell, CellDataSoA& soa) {
+	const double low[3] = {cell.getBoxMin(0), cell.getBoxMin(1), cell.getBoxMin(2)};
+	const double high[3] = {cell.getBoxMax(0), cell.getBoxMax(1), cell.getBoxMax(2)};
+
+	typedef ConcSites::SiteType SiteType;
+	typedef ConcSites::CoordinateType Coordinate;
+	typedef CellDataSoA::QuantityType QuantityType;
+
+	const vcp_real_calc* const r[3] = {
+		soa.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::LJC, Coordinate::X),
+		soa.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::LJC, Coordinate::Y),
+		soa.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::LJC, Coordinate::Z)};
+	vcp_real_accum* const f[3] = {
+		soa.getBeginAccum(QuantityType::FORCE, SiteType::LJC, Coordinate::X),
+		soa.getBeginAccum(QuantityType::FORCE, SiteType::LJC, Coordinate::Y),
+		soa.getBeginAccum(QuantityType::FORCE, SiteType::LJC, Coordinate::Z)};
+
+	double upot = 0.0;
+	for (const ExternalSiteField* field : _siteFields) {
+		if (field->reaches(low, high)) {
+			upot += field->applyLJ(soa._ljc_num, r, soa._ljc_id, f);
+		}
+	}
+	_threadData[mardyn_get_thread_num()]->_upotFields += upot;
+}
+
 void VectorizedCellProcessor::processCell(ParticleCell & c) {
 	FullParticleCell & full_c = downcastCellReferenceFull(c);
 
 	CellDataSoA& soa = full_c.getCellDataSoA();
-	if (c.isHaloCell() or soa.getMolNum() < 2) {
+	if (c.isHaloCell()) {
+		return;
+	}
+	// every inner cell is processed exactly once per traversal
+	if (not _siteFields.empty()) {
+		_applySiteFields(c, soa);
+	}
+	if (soa.getMolNum() < 2) {
 		return;
 	}
-	const bool CalculateMacroscopic = true;
+	soa.refreshLJCTypes();
+	const bool CalculateMacroscopic = _calculateMacroscopic;
 	const bool ApplyCutoff = true;
-	_calculatePairs<SingleCellPolicy_<ApplyCutoff>, CalculateMacroscopic, MaskGatherC>(soa, soa);
+	_calculatePairsMacroscopicIf<SingleCellPolicy_<ApplyCutoff> >(CalculateMacroscopic, soa, soa);
 }
 
 void VectorizedCellProcessor::processCellPair(ParticleCell & c1, ParticleCell & c2, bool sumAll) {
@@ -2753,6 +3094,9 @@ void VectorizedCellProcessor::processCellPair(ParticleCell & c1, ParticleCell &
 	if (soa1.getMolNum() == 0 or soa2.getMolNum() == 0) {
 		return;
 	}
+	// caches built before this cell processor set the LJ center types
+	soa1.refreshLJCTypes();
+	soa2.refreshLJCTypes();
 
 	const bool c1Halo = full_c1.isHaloCell();
 	const bool c2Halo = full_c2.isHaloCell();
@@ -2769,12 +3113,12 @@ void VectorizedCellProcessor::processCellPair(ParticleCell & c1, ParticleCell &
 
 		const bool ApplyCutoff = true;
 
-		const bool CalculateMacroscopic = true;
+		const bool CalculateMacroscopic = _calculateMacroscopic;
 
 		if (calc_soa1_soa2) {
-			_calculatePairs<CellPairPolicy_<ApplyCutoff>, CalculateMacroscopic, MaskGatherC>(soa1, soa2);
+			_calculatePairsMacroscopicIf<CellPairPolicy_<ApplyCutoff> >(CalculateMacroscopic, soa1, soa2);
 		} else {
-			_calculatePairs<CellPairPolicy_<ApplyCutoff>, CalculateMacroscopic, MaskGatherC>(soa2, soa1);
+			_calculatePairsMacroscopicIf<CellPairPolicy_<ApplyCutoff> >(CalculateMacroscopic, soa2, soa1);
 		}
 	} else {
 		// if one cell is empty, or both cells are Halo, skip
@@ -2795,12 +3139,12 @@ void VectorizedCellProcessor::processCellPair(ParticleCell & c1, ParticleCell &
 		if ((not c1Halo and not c2Halo) or						// no cell is halo or
 				(full_c1.getCellIndex() < full_c2.getCellIndex())) 		// one of them is halo, but full_c1.index < full_c2.index
 		{
-			const bool CalculateMacroscopic = true;
+			const bool CalculateMacroscopic = _calculateMacroscopic;
 
 			if (calc_soa1_soa2) {
-				_calculatePairs<CellPairPolicy_<ApplyCutoff>, CalculateMacroscopic, MaskGatherC>(soa1, soa2);
+				_calculatePairsMacroscopicIf<CellPairPolicy_<ApplyCutoff> >(CalculateMacroscopic, soa1, soa2);
 			} else {
-				_calculatePairs<CellPairPolicy_<ApplyCutoff>, CalculateMacroscopic, MaskGatherC>(soa2, soa1);
+				_calculatePairsMacroscopicIf<CellPairPolicy_<ApplyCutoff> >(CalculateMacroscopic, soa2, soa1);
 			}
 
 		} else {
@@ -2810,9 +3154,9 @@ void VectorizedCellProcessor::processCellPair(ParticleCell & c1, ParticleCell &
 			const bool CalculateMacroscopic = false;
 
 			if (calc_soa1_soa2) {
-				_calculatePairs<CellPairPolicy_<ApplyCutoff>, CalculateMacroscopic, MaskGatherC>(soa1, soa2);
+				_calculatePairsMacroscopicIf<CellPairPolicy_<ApplyCutoff> >(CalculateMacroscopic, soa1, soa2);
 			} else {
-				_calculatePairs<CellPairPolicy_<ApplyCutoff>, CalculateMacroscopic, MaskGatherC>(soa2, soa1);
+				_calculatePairsMacroscopicIf<CellPairPolicy_<ApplyCutoff> >(CalculateMacroscopic, soa2, soa1);
 			}
 		}
 	}
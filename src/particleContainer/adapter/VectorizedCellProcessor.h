@@ -21,6 +21,7 @@ class Component;
 class Domain;
 class Comp2Param;
 class CellDataSoA;
+class ExternalSiteField;
 
 /**
  * \brief Vectorized calculation of the force.
@@ -70,6 +71,11 @@ public:
 	 */
 	void endTraversal();
 
+	/**
+	 * \brief Apply field to the LJ centers of each inner cell it reaches in processCell.
+	 */
+	bool addSiteField(ExternalSiteField* field);
+
 
 private:
 	/**
@@ -105,17 +111,53 @@ private:
 	 */
 
 	/**
-	 * \brief Epsilon and sigma for pairs of LJcenters.
-	 * \details Each DoubleArray contains parameters for one center combined with all centers.<br>
-	 * Each set of parameters is a pair (epsilon*24.0, sigma^2).
+	 * \brief Epsilon, sigma and shift for pairs of LJ center types.
+	 * \details Centers with identical interactions are of one type, see CellDataSoA::ljcTypes.<br>
+	 * Each row contains the parameters of one type combined with all types.<br>
+	 * Each set of parameters is (epsilon*24.0, sigma^2, shift*6.0, 0), so one aligned load holds all three.
+	 */
+	AlignedArray<vcp_real_calc> _ljParameters;
+	/**
+	 * \brief Number of LJ center types, i.e. rows and columns of _ljParameters.
+	 */
+	size_t _numLJTypes;
+	/**
+	 * \brief Interpolation coefficients of all tabulated potentials, see TabulatedPotential.
+	 * \details Starts with one bin of zeros, which is used for pairs without tabulated potential.
+	 */
+	AlignedArray<vcp_real_calc> _tabulatedCoefficients;
+	/**
+	 * \brief Offset of the table in _tabulatedCoefficients for pairs of LJ centers, 0 if there is none.
+	 * \details One row of (number of centers) offsets for each LJ center, gathered like the LJ parameters.<br>
+	 * The LJ parameters of pairs with tabulated potential are set to zero.
+	 */
+	AlignedArray<int> _tabulatedOffset;
+	/**
+	 * \brief Number of LJ centers of all components, i.e. rows and columns of _tabulatedOffset.
+	 */
+	size_t _numLJCenters;
+	/**
+	 * \brief Whether an LJ center has a tabulated potential with any other LJ center.
+	 */
+	std::vector<char> _hasTabulated;
+	/**
+	 * \brief Whether an LJ center has nonzero LJ parameters with any other LJ center.
+	 * \details _loopBodyLJ is skipped for centers without, e.g. if tabulated potentials replace all their pairs.
+	 */
+	std::vector<char> _hasLJ;
+	/**
+	 * \brief Tabulation grid in r^2: lower bound, inverse bin width, number of bins.
+	 */
+	vcp_real_calc _tabulatedR2Min, _tabulatedInvDelta;
+	int _tabulatedBins;
+	/**
+	 * \brief External fields applied to the LJ centers, see addSiteField.
 	 */
-	std::vector<AlignedArray<vcp_real_calc> > _eps_sig;
+	std::vector<ExternalSiteField*> _siteFields;
 	/**
-	 * \brief Shift for pairs of LJcenters.
-	 * \details Each DoubleArray contains the LJ shift*6.0 for one center combined<br>
-	 * with all centers.
+	 * \brief Potential energy of all LJ centers in the external fields.
 	 */
-	std::vector<AlignedArray<vcp_real_calc> > _shift6;
+	double _upotFields;
 	/**
 	 * \brief Sum of all LJ potentials.
 	 * \details Multiplied by 6.0 for performance reasons.
@@ -181,6 +223,8 @@ private:
 		vcp_lookupOrMask_single* _quadrupoles_dist_lookup;
 
 		AlignedArray<vcp_real_accum> _upot6ljV, _upotXpolesV, _virialV, _myRFV;
+
+		vcp_real_accum _upotFields {0.0};
 	};
 
 	std::vector<VLJCPThreadData *> _threadData;
@@ -201,6 +245,24 @@ private:
 			const RealCalcVec& eps_24, const RealCalcVec& sig2,
 			const RealCalcVec& shift6);
 
+	/**
+	 * \brief Adds the forces of tabulated potentials to those of _loopBodyLJ.
+	 * \details The coefficients are gathered per lane from _tabulatedCoefficients,
+	 * lanes without tabulated potential use the zero bin.
+	 */
+	template<bool calculateMacroscopic, class MaskGatherChooser>
+	inline void _loopBodyTabulated(
+		const RealCalcVec& m1_r_x, const RealCalcVec& m1_r_y, const RealCalcVec& m1_r_z,
+		const RealCalcVec& r1_x, const RealCalcVec& r1_y, const RealCalcVec& r1_z,
+		const RealCalcVec& m2_r_x, const RealCalcVec& m2_r_y, const RealCalcVec& m2_r_z,
+		const RealCalcVec& r2_x, const RealCalcVec& r2_y, const RealCalcVec& r2_z,
+		RealCalcVec& f_x, RealCalcVec& f_y, RealCalcVec& f_z,
+		RealAccumVec& V_x, RealAccumVec& V_y, RealAccumVec& V_z,
+		RealAccumVec& sum_upot6lj, RealAccumVec& sum_virial,
+		const MaskCalcVec& forceMask,
+		const int* const tabulatedOffsetI, const vcp_ljc_id_t* const id_j,
+		const size_t& offset, const vcp_lookupOrMask_vec& lookupORforceMask);
+
 	template<bool calculateMacroscopic>
 	inline void _loopBodyCharge(
 		const RealCalcVec& m1_r_x, const RealCalcVec& m1_r_y, const RealCalcVec& m1_r_z,
@@ -318,6 +380,18 @@ private:
 	template<class ForcePolicy, bool CalculateMacroscopic, class MaskGatherChooser>
 	void _calculatePairs(CellDataSoA & soa1, CellDataSoA & soa2);
 
+	/**
+	 * \brief Apply the external fields reaching cell to its LJ centers.
+	 */
+	void _applySiteFields(ParticleCell& cell, CellDataSoA& soa);
+
+	/**
+	 * \brief Calls _calculatePairs, with CalculateMacroscopic only if calculateMacroscopic is true.
+	 * \details Without macroscopic values neither energies nor global or per-site virials are accumulated.
+	 */
+	template<class ForcePolicy>
+	void _calculatePairsMacroscopicIf(const bool calculateMacroscopic, CellDataSoA & soa1, CellDataSoA & soa2);
+
 }; /* end of class VectorizedCellProcessor */
 
 #endif /* VECTORIZEDCELLPROCESSOR_H_ */
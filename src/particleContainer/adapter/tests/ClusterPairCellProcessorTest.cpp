@@ -0,0 +1,91 @@
+/*
+ * ClusterPairCellProcessorTest.cpp
+ */
+
+#include "ClusterPairCellProcessorTest.h"
+
+#include <array>
+#include <map>
+
+#include "Domain.h"
+#include "parallel/DomainDecompBase.h"
+#include "particleContainer/LinkedCells.h"
+#include "particleContainer/adapter/ClusterPairCellProcessor.h"
+#include "particleContainer/adapter/VectorizedCellProcessor.h"
+
+#ifndef ENABLE_REDUCED_MEMORY_MODE
+TEST_SUITE_REGISTRATION(ClusterPairCellProcessorTest);
+#else
+#pragma message "Compilation info: ClusterPairCellProcessorTest disabled in reduced memory mode"
+#endif
+
+void ClusterPairCellProcessorTest::testSingleSite() {
+	compareWithVectorizedCellProcessor("VectorizationLennardJones1CLJ.inp", 25.0, false);
+}
+
+void ClusterPairCellProcessorTest::testMultiSite() {
+	compareWithVectorizedCellProcessor("VectorizationLennardJones.inp", 25.0, false);
+}
+
+void ClusterPairCellProcessorTest::testSortedCells() {
+	compareWithVectorizedCellProcessor("VectorizationLennardJones.inp", 25.0, true);
+}
+
+void ClusterPairCellProcessorTest::compareWithVectorizedCellProcessor(const char* filename, double cutoff,
+																	  bool sortCells) {
+	if (_domainDecomposition->getNumProcs() != 1) {
+		test_log->info() << "ClusterPairCellProcessorTest::compareWithVectorizedCellProcessor()"
+						 << " not executed (rerun with only 1 Process!)" << std::endl;
+		return;
+	}
+
+#if VCP_PREC == VCP_SPSP or VCP_PREC == VCP_SPDP
+	const double Tolerance = 1e-4;
+#else /* VCP_DPDP */
+	const double Tolerance = 1e-10;
+#endif
+
+	// force, torque and virial of each molecule
+	std::map<unsigned long, std::array<double, 9>> reference;
+	ParticleContainer* container_1 = initializeFromFile(ParticleContainerFactory::LinkedCell, filename, cutoff);
+	VectorizedCellProcessor vectorized_cell_proc(*_domain, cutoff, cutoff);
+	container_1->traverseCells(vectorized_cell_proc);
+	for (auto m = container_1->iterator(ParticleIterator::ALL_CELLS); m.isValid(); ++m) {
+		m->calcFM();
+		reference[m->getID()] = {m->F(0), m->F(1), m->F(2), m->M(0), m->M(1), m->M(2), m->Vi(0), m->Vi(1), m->Vi(2)};
+	}
+	const double vectorized_u_pot = _domain->getLocalUpot();
+	const double vectorized_virial = _domain->getLocalVirial();
+	delete container_1;
+
+	tearDown(); setUp();
+
+	ParticleContainer* container_2 = initializeFromFile(ParticleContainerFactory::LinkedCell, filename, cutoff);
+	if (sortCells) {
+		dynamic_cast<LinkedCells*>(container_2)->setCellSorting(true);
+		container_2->updateMoleculeCaches();
+	}
+	ClusterPairCellProcessor cluster_cell_proc(*_domain, cutoff, cutoff);
+	container_2->traverseCells(cluster_cell_proc);
+
+	size_t numMolecules = 0;
+	for (auto m = container_2->iterator(ParticleIterator::ALL_CELLS); m.isValid(); ++m) {
+		m->calcFM();
+		const std::array<double, 9> values = {m->F(0), m->F(1), m->F(2), m->M(0), m->M(1), m->M(2),
+											  m->Vi(0), m->Vi(1), m->Vi(2)};
+		ASSERT_EQUAL(size_t(1), reference.count(m->getID()));
+		const std::array<double, 9>& expected = reference[m->getID()];
+		for (int i = 0; i < 9; i++) {
+			std::stringstream str;
+			str << "Molecule id=" << m->getID() << " value i=" << i << std::endl;
+			ASSERT_DOUBLES_EQUAL_MSG(str.str(), expected[i], values[i], Tolerance);
+		}
+		numMolecules++;
+	}
+	ASSERT_EQUAL(reference.size(), numMolecules);
+
+	ASSERT_DOUBLES_EQUAL(vectorized_u_pot, _domain->getLocalUpot(), Tolerance);
+	ASSERT_DOUBLES_EQUAL(vectorized_virial, _domain->getLocalVirial(), Tolerance);
+
+	delete container_2;
+}
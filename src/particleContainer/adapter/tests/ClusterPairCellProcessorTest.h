@@ -0,0 +1,41 @@
+/*
+ * ClusterPairCellProcessorTest.h
+ */
+
+#pragma once
+
+#include "utils/TestWithSimulationSetup.h"
+
+/**
+ * Tests the ClusterPairCellProcessor against the VectorizedCellProcessor.
+ */
+class ClusterPairCellProcessorTest : public utils::TestWithSimulationSetup {
+
+	TEST_SUITE(ClusterPairCellProcessorTest);
+
+	TEST_METHOD(testSingleSite);
+	TEST_METHOD(testMultiSite);
+	TEST_METHOD(testSortedCells);
+
+	TEST_SUITE_END();
+
+public:
+	/**
+	 * Forces, torques, molecule-wise virials and the macroscopic values for single-centered Lennard-Jones molecules.
+	 */
+	void testSingleSite();
+
+	/**
+	 * Same for a two-centered Lennard-Jones component with different center parameters.
+	 */
+	void testMultiSite();
+
+	/**
+	 * Same as testMultiSite with the molecules of the cells sorted as done for the simulation, the molecules are
+	 * compared by their ids.
+	 */
+	void testSortedCells();
+
+private:
+	void compareWithVectorizedCellProcessor(const char* filename, double cutoff, bool sortCells);
+};
@@ -197,6 +197,7 @@ void VCP1CLJRMMTest__initFullCellSoA(const ParticleCellRMM & cell_RMM, CellDataS
 		fullSoA.getBeginCalc(QuantityType::CENTER_POSITION, LJC, Coordinate::Y)[ind] = it->r(1);
 		fullSoA.getBeginCalc(QuantityType::CENTER_POSITION, LJC, Coordinate::Z)[ind] = it->r(2);
 		fullSoA._ljc_id[ind] = 0;
+		fullSoA._ljc_type[ind] = 0;
 
 		// clear FM
 		std::array<vcp_real_accum, 3> clearance = { 0., 0., 0. };
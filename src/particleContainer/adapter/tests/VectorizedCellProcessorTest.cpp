@@ -7,12 +7,17 @@
 
 #include "VectorizedCellProcessorTest.h"
 #include "Domain.h"
+#include "Simulation.h"
+#include "ensemble/EnsembleBase.h"
+#include "molecules/TabulatedPotential.h"
 #include "parallel/DomainDecompBase.h"
 #include "particleContainer/ParticleContainer.h"
 #include "particleContainer/adapter/ParticlePairs2PotForceAdapter.h"
 #include "particleContainer/adapter/LegacyCellProcessor.h"
 #include "particleContainer/adapter/VectorizedCellProcessor.h"
 
+#include <cmath>
+
 #ifndef ENABLE_REDUCED_MEMORY_MODE
 TEST_SUITE_REGISTRATION(VectorizedCellProcessorTest);
 #else
@@ -133,6 +138,115 @@ void VectorizedCellProcessorTest::testForcePotentialCalculationF0() {
 	delete container;
 }
 
+void VectorizedCellProcessorTest::testSkipMacroscopicValues() {
+	if (_domainDecomposition->getNumProcs() != 1) {
+		test_log->info() << "VectorizedCellProcessorTest::testSkipMacroscopicValues()"
+				<< " not executed (rerun with only 1 Process!)" << std::endl;
+		std::cout << "numProcs:" << _domainDecomposition->getNumProcs() << std::endl;
+		return;
+	}
+
+	#if VCP_PREC == VCP_SPSP or VCP_PREC == VCP_SPDP
+		const double Tolerance = 1e-4;
+	#else /* VCP_DPDP */
+		const double Tolerance = 1e-8;
+	#endif
+
+	double forces[4][3] = { { -24, -24, 0 },
+	                        {  24, -24, 0 },
+	                        { -24,  24, 0 },
+	                        {  24,  24, 0 }};
+
+	ParticleContainer* container = initializeFromFile(ParticleContainerFactory::LinkedCell, "ForceCalculationTestU0.inp", 1.1);
+
+	VectorizedCellProcessor cellProcessor( *_domain, 1.1, 1.1);
+	cellProcessor.setCalculateMacroscopic(false);
+	container->traverseCells(cellProcessor);
+
+	for (auto m = container->iterator(ParticleIterator::ALL_CELLS); m.isValid(); ++m) {
+		m->calcFM();
+		for (int i = 0; i < 3; i++) {
+			std::stringstream str;
+			str << "Molecule id=" << m->getID() << " index i="<< i << std::endl;
+			ASSERT_DOUBLES_EQUAL_MSG(str.str(), forces[m->getID()-1][i], m->F(i), Tolerance);
+			ASSERT_DOUBLES_EQUAL_MSG(str.str(), 0.0, m->Vi(i), Tolerance);
+		}
+	}
+
+	ASSERT_DOUBLES_EQUAL(0.0, _domain->getLocalUpot(), Tolerance);
+	ASSERT_DOUBLES_EQUAL(0.0, _domain->getLocalVirial(), Tolerance);
+
+	delete container;
+}
+
+void VectorizedCellProcessorTest::testTabulatedPotential() {
+	if (_domainDecomposition->getNumProcs() != 1) {
+		test_log->info() << "VectorizedCellProcessorTest::testTabulatedPotential()"
+				<< " not executed (rerun with only 1 Process!)" << std::endl;
+		std::cout << "numProcs:" << _domainDecomposition->getNumProcs() << std::endl;
+		return;
+	}
+
+	#if VCP_PREC == VCP_SPSP or VCP_PREC == VCP_SPDP
+		const double Tolerance = 1e-3;
+	#else /* VCP_DPDP */
+		const double Tolerance = 1e-6;
+	#endif
+
+	double forces[4][3] = { { -24, -24, 0 },
+	                        {  24, -24, 0 },
+	                        { -24,  24, 0 },
+	                        {  24,  24, 0 }};
+
+	const char* filenames[2] = {"ForceCalculationTestU0.inp", "ForceCalculationTestF0.inp"};
+	const double cutoffs[2] = {1.1, 1.3};
+	const double upots[2] = {0.0, -4.0};
+	const double virials[2] = {96.0, 0.0};
+
+	// each scenario unshifted and shifted, the four molecules form four pairs within the cutoff radius
+	for (int run = 0; run < 4; ++run) {
+		const int scenario = run % 2;
+		const bool shifted = run >= 2;
+		if (run > 0) {
+			tearDown(); setUp();
+		}
+		ParticleContainer* container = initializeFromFile(ParticleContainerFactory::LinkedCell, filenames[scenario], cutoffs[scenario]);
+
+		// Mie 12-6 equals LJ 12-6
+		TabulationGrid grid;
+		grid.rmin = 0.8;
+		auto potential = std::make_shared<TabulatedPotential>();
+		potential->setCids(0, 0);
+		potential->setMie(1.0, 1.0, 12.0, 6.0);
+		potential->setShifted(shifted);
+		global_simulation->getEnsemble()->setTabulationGrid(grid);
+		global_simulation->getEnsemble()->addTabulatedPotential(potential);
+
+		VectorizedCellProcessor cellProcessor(*_domain, cutoffs[scenario], cutoffs[scenario]);
+		container->traverseCells(cellProcessor);
+
+		for (auto m = container->iterator(ParticleIterator::ALL_CELLS); m.isValid(); ++m) {
+			m->calcFM();
+		}
+
+		for (auto m = container->iterator(ParticleIterator::ALL_CELLS); m.isValid(); ++m) {
+			for (int i = 0; i < 3; i++) {
+				std::stringstream str;
+				str << "Molecule id=" << m->getID() << " index i="<< i << " F[i]=" << m->F(i) << std::endl;
+				const double expected = scenario == 0 ? forces[m->getID()-1][i] : 0.0;
+				ASSERT_DOUBLES_EQUAL_MSG(str.str(), expected, m->F(i), Tolerance);
+			}
+		}
+
+		const double Ucutoff = 4.0 * (std::pow(cutoffs[scenario], -12.0) - std::pow(cutoffs[scenario], -6.0));
+		const double expectedUpot = shifted ? upots[scenario] - 4.0 * Ucutoff : upots[scenario];
+		ASSERT_DOUBLES_EQUAL(expectedUpot, _domain->getLocalUpot(), Tolerance);
+		ASSERT_DOUBLES_EQUAL(virials[scenario], _domain->getLocalVirial(), Tolerance);
+
+		delete container;
+	}
+}
+
 void VectorizedCellProcessorTest::testLennardJonesVectorization() {
 	if (_domainDecomposition->getNumProcs() != 1) {
 		test_log->info() << "VectorizedCellProcessorTest::testLennardJonesVectorization()"
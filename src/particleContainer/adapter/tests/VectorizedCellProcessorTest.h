@@ -20,8 +20,10 @@ class VectorizedCellProcessorTest : public utils::TestWithSimulationSetup {
 
 	TEST_METHOD(testForcePotentialCalculationU0);
 	TEST_METHOD(testForcePotentialCalculationF0);
+	TEST_METHOD(testSkipMacroscopicValues);
 
 	TEST_METHOD(testLennardJonesVectorization);
+	TEST_METHOD(testTabulatedPotential);
 
 	TEST_METHOD(testChargeChargeVectorization);
 	TEST_METHOD(testChargeDipoleVectorization);
@@ -58,6 +60,12 @@ public:
 	 */
 	void testForcePotentialCalculationU0();
 
+	/**
+	 * Same scenarios as testForcePotentialCalculationU0 and testForcePotentialCalculationF0,
+	 * but the LJ interaction is replaced by a tabulated Mie 12-6 potential.
+	 */
+	void testTabulatedPotential();
+
 	/**
 	 * Same setup as above, however potential should be U= and force F=0.
 	 *
@@ -65,6 +73,12 @@ public:
 	 */
 	void testForcePotentialCalculationF0();
 
+	/**
+	 * Scenario of testForcePotentialCalculationU0 with macroscopic values switched off:
+	 * forces are unchanged, potential energy and virial are not accumulated.
+	 */
+	void testSkipMacroscopicValues();
+
 	/**
 	 * Run first the Legacy- and then the VectorizedCellProcessor on the same
 	 * input file. Then verify all forces and torques on each molecule, as well as
@@ -11,6 +11,8 @@
 #ifndef  SIMD_VECTORIZEDCELLPROCESSORHELPERS_H
 #define  SIMD_VECTORIZEDCELLPROCESSORHELPERS_H
 
+#include <algorithm>
+
 #include "SIMD_TYPES.h"
 #include "utils/AlignedArray.h"
 
@@ -24,7 +26,7 @@
  */
 template <class MaskGatherChooser>
 static vcp_inline
-void unpackEps24Sig2(RealCalcVec& eps_24, RealCalcVec& sig2, const AlignedArray<vcp_real_calc>& eps_sigI,
+void unpackEps24Sig2(RealCalcVec& eps_24, RealCalcVec& sig2, const vcp_real_calc* const eps_sigI,
 		const vcp_ljc_id_t* const id_j, const vcp_ljc_id_t& offset, const vcp_lookupOrMask_vec& lookupORforceMask __attribute__((unused))) {
 
 #if VCP_VEC_TYPE != VCP_VEC_KNL_GATHER and VCP_VEC_TYPE != VCP_VEC_AVX512F_GATHER
@@ -158,7 +160,7 @@ void unpackEps24Sig2(RealCalcVec& eps_24, RealCalcVec& sig2, const AlignedArray<
  */
 template <class MaskGatherChooser>
 static vcp_inline
-void unpackShift6(RealCalcVec& shift6, const AlignedArray<vcp_real_calc>& shift6I,
+void unpackShift6(RealCalcVec& shift6, const vcp_real_calc* const shift6I,
 		const vcp_ljc_id_t* id_j, const vcp_ljc_id_t& offset, const vcp_lookupOrMask_vec& lookupORforceMask) {
 #if VCP_VEC_TYPE != VCP_VEC_KNL_GATHER
 	const vcp_ljc_id_t* id_j_shifted = id_j + offset;//this is the pointer, to where the stuff is stored.
@@ -261,6 +263,195 @@ void unpackShift6(RealCalcVec& shift6, const AlignedArray<vcp_real_calc>& shift6
 }
 #pragma GCC diagnostic pop
 
+/**
+ * unpacks eps_24, sig2 and shift6 from one row of the compact LJ parameter table according to the type array type_j
+ * (for avx2 and avx512: use gather). Each entry of the row holds (eps_24, sig2, shift6, 0) for one type.
+ * @param eps_24 vector in which eps_24 is saved
+ * @param sig2 vector in which sig2 is saved
+ * @param shift6 vector in which shift6 is saved
+ * @param ljParametersI row of the type of center i
+ * @param type_j array of LJ center types
+ * @param offset offset of the type_j array
+ */
+template <class MaskGatherChooser>
+static vcp_inline
+void unpackEps24Sig2Shift6(RealCalcVec& eps_24, RealCalcVec& sig2, RealCalcVec& shift6, const vcp_real_calc* const ljParametersI,
+		const vcp_ljc_id_t* const type_j, const vcp_ljc_id_t& offset, const vcp_lookupOrMask_vec& lookupORforceMask __attribute__((unused))) {
+
+#if VCP_VEC_TYPE != VCP_VEC_KNL_GATHER and VCP_VEC_TYPE != VCP_VEC_AVX512F_GATHER
+	const vcp_ljc_id_t* type_j_shifted = type_j + offset;//this is the pointer, to where the stuff is stored.
+#endif
+
+#if VCP_VEC_TYPE==VCP_NOVEC //novec comes first. For NOVEC no specific types are specified -- use build in ones.
+	eps_24 = ljParametersI[4 * type_j_shifted[0]];
+	sig2 = ljParametersI[4 * type_j_shifted[0] + 1];
+	shift6 = ljParametersI[4 * type_j_shifted[0] + 2];
+
+#elif VCP_VEC_TYPE==VCP_VEC_SSE3 //sse3
+
+	#if VCP_PREC == VCP_SPSP or VCP_PREC == VCP_SPDP
+		__m128 p0 = _mm_load_ps(ljParametersI + 4 * type_j_shifted[0]);
+		__m128 p1 = _mm_load_ps(ljParametersI + 4 * type_j_shifted[1]);
+		__m128 p2 = _mm_load_ps(ljParametersI + 4 * type_j_shifted[2]);
+		__m128 p3 = _mm_load_ps(ljParametersI + 4 * type_j_shifted[3]);
+		_MM_TRANSPOSE4_PS(p0, p1, p2, p3);
+		eps_24 = p0;
+		sig2 = p1;
+		shift6 = p2;
+
+	#else /* VCP_DPDP */
+		const RealCalcVec e0s0 = RealCalcVec::aligned_load(ljParametersI + 4 * type_j_shifted[0]);
+		const RealCalcVec e1s1 = RealCalcVec::aligned_load(ljParametersI + 4 * type_j_shifted[1]);
+		const RealCalcVec sh0 = RealCalcVec::aligned_load(ljParametersI + 4 * type_j_shifted[0] + 2);
+		const RealCalcVec sh1 = RealCalcVec::aligned_load(ljParametersI + 4 * type_j_shifted[1] + 2);
+		eps_24 = RealCalcVec::unpack_lo(e0s0, e1s1);
+		sig2 = RealCalcVec::unpack_hi(e0s0, e1s1);
+		shift6 = RealCalcVec::unpack_lo(sh0, sh1);
+	#endif
+
+#elif VCP_VEC_TYPE==VCP_VEC_AVX //avx
+
+	#if VCP_PREC == VCP_SPSP or VCP_PREC == VCP_SPDP
+		__m128 p0 = _mm_load_ps(ljParametersI + 4 * type_j_shifted[0]);
+		__m128 p1 = _mm_load_ps(ljParametersI + 4 * type_j_shifted[1]);
+		__m128 p2 = _mm_load_ps(ljParametersI + 4 * type_j_shifted[2]);
+		__m128 p3 = _mm_load_ps(ljParametersI + 4 * type_j_shifted[3]);
+		__m128 p4 = _mm_load_ps(ljParametersI + 4 * type_j_shifted[4]);
+		__m128 p5 = _mm_load_ps(ljParametersI + 4 * type_j_shifted[5]);
+		__m128 p6 = _mm_load_ps(ljParametersI + 4 * type_j_shifted[6]);
+		__m128 p7 = _mm_load_ps(ljParametersI + 4 * type_j_shifted[7]);
+		_MM_TRANSPOSE4_PS(p0, p1, p2, p3);
+		_MM_TRANSPOSE4_PS(p4, p5, p6, p7);
+		eps_24 = _mm256_insertf128_ps(_mm256_castps128_ps256(p0), p4, 1);
+		sig2 = _mm256_insertf128_ps(_mm256_castps128_ps256(p1), p5, 1);
+		shift6 = _mm256_insertf128_ps(_mm256_castps128_ps256(p2), p6, 1);
+
+	#else /* VCP_DPDP */
+		const __m256d e0s0sh0 = _mm256_load_pd(ljParametersI + 4 * type_j_shifted[0]);
+		const __m256d e1s1sh1 = _mm256_load_pd(ljParametersI + 4 * type_j_shifted[1]);
+		const __m256d e2s2sh2 = _mm256_load_pd(ljParametersI + 4 * type_j_shifted[2]);
+		const __m256d e3s3sh3 = _mm256_load_pd(ljParametersI + 4 * type_j_shifted[3]);
+
+		const __m256d e0e1sh0sh1 = _mm256_unpacklo_pd(e0s0sh0, e1s1sh1);
+		const __m256d s0s1 = _mm256_unpackhi_pd(e0s0sh0, e1s1sh1);
+		const __m256d e2e3sh2sh3 = _mm256_unpacklo_pd(e2s2sh2, e3s3sh3);
+		const __m256d s2s3 = _mm256_unpackhi_pd(e2s2sh2, e3s3sh3);
+
+		eps_24 = _mm256_permute2f128_pd(e0e1sh0sh1, e2e3sh2sh3, 1<<5);
+		sig2 = _mm256_permute2f128_pd(s0s1, s2s3, 1<<5);
+		shift6 = _mm256_permute2f128_pd(e0e1sh0sh1, e2e3sh2sh3, 1 | 3<<4);
+	#endif
+
+#elif VCP_VEC_TYPE==VCP_VEC_AVX2 //avx2 knows gather
+
+	#if VCP_PREC == VCP_SPSP or VCP_PREC == VCP_SPDP
+		__m256i indices = _mm256_maskload_epi32((const int*)(type_j_shifted), MaskCalcVec::ones());
+		indices = _mm256_slli_epi32(indices, 2); // only every fourth...
+		eps_24 = _mm256_i32gather_ps(ljParametersI, indices, 4);
+		sig2 = _mm256_i32gather_ps(ljParametersI+1, indices, 4);
+		shift6 = _mm256_i32gather_ps(ljParametersI+2, indices, 4);
+
+	#else /* VCP_DPDP */
+		__m256i indices = _mm256_maskload_epi64((const long long *)(type_j_shifted), MaskCalcVec::ones());
+		indices = _mm256_slli_epi64(indices, 2); // only every fourth...
+		eps_24 = _mm256_i64gather_pd(ljParametersI, indices, 8);
+		sig2 = _mm256_i64gather_pd(ljParametersI+1, indices, 8);
+		shift6 = _mm256_i64gather_pd(ljParametersI+2, indices, 8);
+	#endif /* VCP_PREC */
+
+#elif VCP_VEC_TYPE==VCP_VEC_KNL or VCP_VEC_TYPE==VCP_VEC_AVX512F
+
+	#if VCP_PREC == VCP_SPSP or VCP_PREC == VCP_SPDP
+		__m512i indices = _mm512_load_epi32(type_j_shifted);
+		indices = _mm512_slli_epi32(indices, 2);//only every fourth...
+		eps_24 = _mm512_i32gather_ps(indices, ljParametersI, 4);
+		sig2 = _mm512_i32gather_ps(indices, ljParametersI+1, 4);
+		shift6 = _mm512_i32gather_ps(indices, ljParametersI+2, 4);
+	#else /*VCP_DPDP */
+		__m512i indices = _mm512_load_epi64(type_j_shifted);
+		indices = _mm512_slli_epi64(indices, 2);//only every fourth...
+		eps_24 = _mm512_i64gather_pd(indices, ljParametersI, 8);
+		sig2 = _mm512_i64gather_pd(indices, ljParametersI+1, 8);
+		shift6 = _mm512_i64gather_pd(indices, ljParametersI+2, 8);
+	#endif
+
+#elif VCP_VEC_TYPE==VCP_VEC_KNL_GATHER or VCP_VEC_TYPE == VCP_VEC_AVX512F_GATHER
+
+	#if VCP_PREC == VCP_SPSP or VCP_PREC == VCP_SPDP
+		__m512i indices = _mm512_i32gather_epi32(lookupORforceMask, (const int *) type_j, 4);
+		indices = _mm512_slli_epi32(indices, 2);//only every fourth...
+		eps_24 = _mm512_i32gather_ps(indices, ljParametersI, 4);
+		sig2 = _mm512_i32gather_ps(indices, ljParametersI+1, 4);
+		shift6 = _mm512_i32gather_ps(indices, ljParametersI+2, 4);
+	#else /*VCP_DPDP*/
+		__m256i lookupORforceMask_256i = _mm512_castsi512_si256 (lookupORforceMask);
+		__m512i indices = _mm512_i32gather_epi64(lookupORforceMask_256i, (const long long *) type_j, 8);//gather type_j using the indices
+		indices = _mm512_slli_epi64(indices, 2);//only every fourth...
+		eps_24 = _mm512_i64gather_pd(indices, ljParametersI, 8);
+		sig2 = _mm512_i64gather_pd(indices, ljParametersI+1, 8);
+		shift6 = _mm512_i64gather_pd(indices, ljParametersI+2, 8);
+	#endif /*VCP_PREC*/
+#endif
+}
+
+/**
+ * unpacks the table offsets of the tabulated potentials from the row tabulatedOffsetI according to the index array id_j
+ * (for avx2 and avx512: use gather)
+ * @param tableOffsets array of VCP_VEC_SIZE entries in which the offsets are saved
+ * @param tabulatedOffsetI row of the tabulated offsets of center i
+ * @param id_j array of displacements
+ * @param offset offset of the id_j array
+ */
+template <class MaskGatherChooser>
+static vcp_inline
+void unpackTabulatedOffset(int* const tableOffsets, const int* const tabulatedOffsetI,
+		const vcp_ljc_id_t* const id_j, const vcp_ljc_id_t& offset, const vcp_lookupOrMask_vec& lookupORforceMask __attribute__((unused))) {
+
+#if VCP_VEC_TYPE != VCP_VEC_KNL_GATHER and VCP_VEC_TYPE != VCP_VEC_AVX512F_GATHER
+	const vcp_ljc_id_t* id_j_shifted = id_j + offset;//this is the pointer, to where the stuff is stored.
+#endif
+
+#if VCP_VEC_TYPE==VCP_VEC_AVX2 //avx2 knows gather
+
+	#if VCP_PREC == VCP_SPSP or VCP_PREC == VCP_SPDP
+		const __m256i indices = _mm256_maskload_epi32((const int*)(id_j_shifted), MaskCalcVec::ones());
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(tableOffsets), _mm256_i32gather_epi32(tabulatedOffsetI, indices, 4));
+
+	#else /* VCP_DPDP */
+		const __m256i indices = _mm256_maskload_epi64((const long long *)(id_j_shifted), MaskCalcVec::ones());
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(tableOffsets), _mm256_i64gather_epi32(tabulatedOffsetI, indices, 4));
+	#endif
+
+#elif VCP_VEC_TYPE==VCP_VEC_KNL or VCP_VEC_TYPE==VCP_VEC_AVX512F
+
+	#if VCP_PREC == VCP_SPSP or VCP_PREC == VCP_SPDP
+		const __m512i indices = _mm512_load_epi32(id_j_shifted);
+		_mm512_storeu_si512(tableOffsets, _mm512_i32gather_epi32(indices, tabulatedOffsetI, 4));
+
+	#else /* VCP_DPDP */
+		const __m512i indices = _mm512_load_epi64(id_j_shifted);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(tableOffsets), _mm512_i64gather_epi32(indices, tabulatedOffsetI, 4));
+	#endif
+
+#elif VCP_VEC_TYPE==VCP_VEC_KNL_GATHER or VCP_VEC_TYPE == VCP_VEC_AVX512F_GATHER
+
+	#if VCP_PREC == VCP_SPSP or VCP_PREC == VCP_SPDP
+		const __m512i indices = _mm512_i32gather_epi32(lookupORforceMask, (const int *) id_j, 4);
+		_mm512_storeu_si512(tableOffsets, _mm512_i32gather_epi32(indices, tabulatedOffsetI, 4));
+
+	#else /* VCP_DPDP */
+		__m256i lookupORforceMask_256i = _mm512_castsi512_si256 (lookupORforceMask);
+		const __m512i indices = _mm512_i32gather_epi64(lookupORforceMask_256i, (const long long *) id_j, 8);//gather id_j using the lookupindices
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(tableOffsets), _mm512_i64gather_epi32(indices, tabulatedOffsetI, 4));
+	#endif
+
+#else // novec, sse3 and avx have no gather
+	for (size_t k = 0; k < VCP_VEC_SIZE; ++k) {
+		tableOffsets[k] = tabulatedOffsetI[id_j_shifted[k]];
+	}
+#endif
+}
+
 /**
  * sums up values in a and adds the result to *mem_addr
  */
@@ -472,4 +663,71 @@ static vcp_inline calcDistLookup (const size_t & i_center_idx, const size_t & so
 }
 
 
+/**
+ * \brief Gathers base[offsets[k]] into lane k, e.g. for lookups in tabulated potentials.
+ * \details offsets has to provide VCP_VEC_SIZE entries.
+ */
+vcp_inline RealCalcVec vcp_simd_gather(const vcp_real_calc* const base, const int* const offsets) {
+#if VCP_VEC_TYPE==VCP_VEC_KNL or VCP_VEC_TYPE==VCP_VEC_KNL_GATHER or VCP_VEC_TYPE==VCP_VEC_AVX512F or VCP_VEC_TYPE==VCP_VEC_AVX512F_GATHER
+	#if VCP_PREC == VCP_SPSP or VCP_PREC == VCP_SPDP
+		return _mm512_i32gather_ps(_mm512_loadu_si512(offsets), base, 4);
+	#else /* VCP_DPDP */
+		return _mm512_i32gather_pd(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(offsets)), base, 8);
+	#endif
+#elif VCP_VEC_TYPE==VCP_VEC_AVX2
+	#if VCP_PREC == VCP_SPSP or VCP_PREC == VCP_SPDP
+		return _mm256_i32gather_ps(base, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(offsets)), 4);
+	#else /* VCP_DPDP */
+		return _mm256_i32gather_pd(base, _mm_loadu_si128(reinterpret_cast<const __m128i*>(offsets)), 8);
+	#endif
+#else
+	alignas(64) vcp_real_calc lanes[VCP_VEC_SIZE];
+	for (size_t k = 0; k < VCP_VEC_SIZE; ++k) {
+		lanes[k] = base[offsets[k]];
+	}
+	return RealCalcVec::aligned_load(lanes);
+#endif
+}
+
+/**
+ * \brief Splits the grid coordinates s into bin indices, clamped to [0, numBins), and the local coordinates within the bins.
+ * \details bins has to provide VCP_VEC_SIZE entries. Coordinates outside of the grid are clamped to its ends.
+ * \return local coordinates in [0, 1]
+ */
+vcp_inline RealCalcVec vcp_simd_bin_index(const RealCalcVec& s, const int numBins, int* const bins) {
+#if VCP_VEC_TYPE==VCP_VEC_KNL or VCP_VEC_TYPE==VCP_VEC_KNL_GATHER or VCP_VEC_TYPE==VCP_VEC_AVX512F or VCP_VEC_TYPE==VCP_VEC_AVX512F_GATHER
+	#if VCP_PREC == VCP_SPSP or VCP_PREC == VCP_SPDP
+		const __m512 clamped = _mm512_min_ps(_mm512_max_ps(s, _mm512_setzero_ps()), _mm512_set1_ps(numBins));
+		const __m512 bin = _mm512_min_ps(_mm512_roundscale_ps(clamped, _MM_FROUND_TO_NEG_INF), _mm512_set1_ps(numBins - 1));
+		_mm512_storeu_si512(bins, _mm512_cvttps_epi32(bin));
+	#else /* VCP_DPDP */
+		const __m512d clamped = _mm512_min_pd(_mm512_max_pd(s, _mm512_setzero_pd()), _mm512_set1_pd(numBins));
+		const __m512d bin = _mm512_min_pd(_mm512_roundscale_pd(clamped, _MM_FROUND_TO_NEG_INF), _mm512_set1_pd(numBins - 1));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(bins), _mm512_cvttpd_epi32(bin));
+	#endif
+	return RealCalcVec(clamped) - RealCalcVec(bin);
+#elif VCP_VEC_TYPE==VCP_VEC_AVX or VCP_VEC_TYPE==VCP_VEC_AVX2
+	#if VCP_PREC == VCP_SPSP or VCP_PREC == VCP_SPDP
+		const __m256 clamped = _mm256_min_ps(_mm256_max_ps(s, _mm256_setzero_ps()), _mm256_set1_ps(numBins));
+		const __m256 bin = _mm256_min_ps(_mm256_floor_ps(clamped), _mm256_set1_ps(numBins - 1));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(bins), _mm256_cvttps_epi32(bin));
+	#else /* VCP_DPDP */
+		const __m256d clamped = _mm256_min_pd(_mm256_max_pd(s, _mm256_setzero_pd()), _mm256_set1_pd(numBins));
+		const __m256d bin = _mm256_min_pd(_mm256_floor_pd(clamped), _mm256_set1_pd(numBins - 1));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(bins), _mm256_cvttpd_epi32(bin));
+	#endif
+	return RealCalcVec(clamped) - RealCalcVec(bin);
+#else
+	alignas(64) vcp_real_calc lanes[VCP_VEC_SIZE];
+	s.aligned_store(lanes);
+	for (size_t k = 0; k < VCP_VEC_SIZE; ++k) {
+		const vcp_real_calc clamped = lanes[k] > 0 ? std::min(lanes[k], static_cast<vcp_real_calc>(numBins)) : 0;
+		bins[k] = std::min(static_cast<int>(clamped), numBins - 1);
+		lanes[k] = clamped - bins[k];
+	}
+	return RealCalcVec::aligned_load(lanes);
+#endif
+}
+
+
 #endif /* SIMD_VECTORIZEDCELLPROCESSORHELPERS_H */
@@ -0,0 +1,68 @@
+/*
+ * CellSlabPartitionTest.cpp
+ */
+
+#include "CellSlabPartitionTest.h"
+
+#include <vector>
+
+#include "particleContainer/CellSlabPartition.h"
+#include "utils/threeDimensionalMapping.h"
+#include "WrapOpenMP.h"
+
+TEST_SUITE_REGISTRATION(CellSlabPartitionTest);
+
+void CellSlabPartitionTest::testCellsArePartitioned() {
+	const std::array<unsigned long, 3> dims = {5, 23, 6};
+	CellSlabPartition partition;
+	partition.rebuild(dims);
+
+	const int numSlabs = partition.getNumSlabs();
+	ASSERT_EQUAL(mardyn_get_max_threads(), numSlabs);
+	ASSERT_EQUAL(static_cast<unsigned short>(1), partition.getSlabDimension());
+
+	// every thread owns exactly one slab
+	std::vector<int> threadsOfSlab(numSlabs, 0);
+	for (int thread = 0; thread < numSlabs; ++thread) {
+		threadsOfSlab[partition.getSlabOfThread(thread)]++;
+	}
+	for (int slab = 0; slab < numSlabs; ++slab) {
+		ASSERT_EQUAL(1, threadsOfSlab[slab]);
+	}
+
+	// every cell belongs to exactly one slab, the one containing its layer
+	std::vector<int> slabsOfCell(dims[0] * dims[1] * dims[2], 0);
+	unsigned long nextLayer = 0;
+	for (int slab = 0; slab < numSlabs; ++slab) {
+		const auto layers = partition.getLayers(slab);
+		ASSERT_EQUAL(nextLayer, layers.first);
+		nextLayer = layers.second;
+		for (unsigned long cellIndex : partition.getCells(slab)) {
+			const auto layer = threeDimensionalMapping::oneToThreeD(cellIndex, dims)[1];
+			ASSERT_TRUE(layers.first <= layer and layer < layers.second);
+			slabsOfCell[cellIndex]++;
+		}
+	}
+	ASSERT_EQUAL(dims[1], nextLayer);
+	for (int count : slabsOfCell) {
+		ASSERT_EQUAL(1, count);
+	}
+}
+
+void CellSlabPartitionTest::testSlabsMatchSlices() {
+	const std::array<unsigned long, 3> dims = {8, 7, 40};
+	CellSlabPartition partition;
+	partition.rebuild(dims);
+	ASSERT_EQUAL(static_cast<unsigned short>(2), partition.getSlabDimension());
+
+	const unsigned long numSlabs = partition.getNumSlabs();
+	const unsigned long numBaseLayers = dims[2] - 1;
+	const unsigned long sliceSize = (dims[0] - 1) * (dims[1] - 1);
+	const unsigned long numBaseCells = numBaseLayers * sliceSize;
+	for (unsigned long slab = 0; slab < numSlabs; ++slab) {
+		// first base cell of the thread at chain position slab, see SlicedCellPairTraversal
+		const unsigned long firstBaseCell = numBaseCells * slab / numSlabs;
+		const unsigned long firstFullLayer = (firstBaseCell + sliceSize - 1) / sliceSize;
+		ASSERT_EQUAL(firstFullLayer, partition.getLayers(slab).first);
+	}
+}
@@ -0,0 +1,21 @@
+/*
+ * CellSlabPartitionTest.h
+ */
+
+#pragma once
+
+#include "utils/Testing.h"
+
+class CellSlabPartitionTest : public utils::Test {
+
+	TEST_SUITE(CellSlabPartitionTest);
+	TEST_METHOD(testCellsArePartitioned);
+	TEST_METHOD(testSlabsMatchSlices);
+	TEST_SUITE_END();
+
+public:
+	void testCellsArePartitioned();
+
+	//! the base cells of a slab are those SlicedCellPairTraversal gives to the thread at the same chain position
+	void testSlabsMatchSlices();
+};
@@ -727,3 +727,107 @@ void LinkedCellsTest::doForceComparisonTest(std::string inputFile,
 	delete containerTest;
 
 }
+
+void LinkedCellsTest::testResizeInPlace() {
+	double bMin[3] = {0., 0., 0.};
+	double bMax[3] = {10., 10., 10.};
+	LinkedCells LC(bMin, bMax, 2.5);
+
+	// one molecule in the center of each of the 4x4x4 inner cells
+	unsigned long id = 0;
+	for (int iz = 0; iz < 4; ++iz) {
+		for (int iy = 0; iy < 4; ++iy) {
+			for (int ix = 0; ix < 4; ++ix) {
+				Molecule m(id++, &_components[0], 1.25 + ix * 2.5, 1.25 + iy * 2.5, 1.25 + iz * 2.5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+				LC.addParticle(m);
+			}
+		}
+	}
+	LC.update();
+
+	double notOnGridMin[3] = {0.1, 0., 0.};
+	ASSERT_TRUE_MSG("box not on the cell grid", not LC.isResizableInPlace(notOnGridMin, bMax));
+	double tooSmallMax[3] = {10., 10., -2.5};
+	ASSERT_TRUE_MSG("box without inner cells", not LC.isResizableInPlace(bMin, tooSmallMax));
+
+	// shift in x, shrink in y, grow in z
+	double newMin[3] = {2.5, 0., -2.5};
+	double newMax[3] = {12.5, 7.5, 10.};
+	ASSERT_TRUE_MSG("box on the cell grid", LC.isResizableInPlace(newMin, newMax));
+
+	// the caller is responsible for the molecules leaving the region
+	LC.deleteParticlesOutsideBox(newMin, newMax);
+	ASSERT_EQUAL(3ul * 3ul * 4ul, LC.getNumberOfParticles());
+
+	LC.resizeInPlace(newMin, newMax);
+	ASSERT_EQUAL(6, LC._cellsPerDimension[0]);
+	ASSERT_EQUAL(5, LC._cellsPerDimension[1]);
+	ASSERT_EQUAL(7, LC._cellsPerDimension[2]);
+	for (int d = 0; d < 3; ++d) {
+		ASSERT_DOUBLES_EQUAL(2.5, LC._cellLength[d], 1e-12);
+		ASSERT_DOUBLES_EQUAL(newMin[d] - 2.5, LC._haloBoundingBoxMin[d], 1e-12);
+		ASSERT_DOUBLES_EQUAL(newMax[d] + 2.5, LC._haloBoundingBoxMax[d], 1e-12);
+	}
+
+	// all molecules are kept and already sorted into the right cells
+	ASSERT_EQUAL(3ul * 3ul * 4ul, LC.getNumberOfParticles());
+	for (auto it = LC.iterator(ParticleIterator::ALL_CELLS); it.isValid(); ++it) {
+		ASSERT_TRUE_MSG("molecule in wrong cell", LC._cells[it.getCellIndex()].testInBox(*it));
+		ASSERT_TRUE_MSG("molecule in halo cell", not LC._cells[it.getCellIndex()].isHaloCell());
+	}
+	LC.update();
+	ASSERT_EQUAL(3ul * 3ul * 4ul, LC.getNumberOfParticles());
+}
+
+void LinkedCellsTest::testMoleculeSlots() {
+	std::array<double, 3> boxMin = {0.0, 0.0, 0.0};
+	std::array<double, 3> boxMax = {10.0, 10.0, 10.0};
+	const double cutoff = 2.5;
+	LinkedCells linkedCells(boxMin.data(), boxMax.data(), cutoff);
+	ASSERT_TRUE(linkedCells.providesMoleculeSlots());
+
+	// owned molecules, the slots determined by an iterator have to point to the same molecules
+	for (unsigned long id = 0; id < 20; ++id) {
+		Molecule m(id, &_components[0], 0.5 * id, 1.0, 9.0, 0., 0., 0., 0., 0., 0., 0., 0., 0., 0.);
+		linkedCells.addParticle(m);
+	}
+	std::vector<std::pair<unsigned long, ParticleContainer::MoleculeSlot>> ownedSlots;
+	for (auto it = linkedCells.iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); it.isValid(); ++it) {
+		ownedSlots.emplace_back(it->getID(), linkedCells.getMoleculeSlot(it));
+	}
+	ASSERT_EQUAL(20ul, ownedSlots.size());
+
+	// halo molecules, two of them in the same cell
+	ParticleContainer::MoleculeSlot haloSlots[3];
+	Molecule halo0(100, &_components[0], -1.0, 1.0, 1.0, 0., 0., 0., 0., 0., 0., 0., 0., 0., 0.);
+	Molecule halo1(101, &_components[0], -1.5, 1.5, 1.0, 0., 0., 0., 0., 0., 0., 0., 0., 0., 0.);
+	Molecule halo2(102, &_components[0], 11.0, 1.0, 1.0, 0., 0., 0., 0., 0., 0., 0., 0., 0., 0.);
+	ASSERT_TRUE(linkedCells.addHaloParticleAndGetSlot(halo0, haloSlots[0]));
+	ASSERT_TRUE(linkedCells.addHaloParticleAndGetSlot(halo1, haloSlots[1]));
+	ASSERT_TRUE(linkedCells.addHaloParticleAndGetSlot(halo2, haloSlots[2]));
+	ASSERT_EQUAL(haloSlots[0].cell, haloSlots[1].cell);
+
+	// duplicates and molecules outside of the halo are not stored
+	ParticleContainer::MoleculeSlot notStored;
+	ASSERT_TRUE(not linkedCells.addHaloParticleAndGetSlot(halo1, notStored, true));
+	Molecule outside(103, &_components[0], -5.0, 1.0, 1.0, 0., 0., 0., 0., 0., 0., 0., 0., 0., 0.);
+	ASSERT_TRUE(not linkedCells.addHaloParticleAndGetSlot(outside, notStored));
+	ASSERT_EQUAL(23ul, linkedCells.getNumberOfParticles());
+
+	// adding molecules does not invalidate the slots
+	for (auto& [id, slot] : ownedSlots) {
+		ASSERT_EQUAL(id, linkedCells.getMoleculeAtSlot(slot, id)->getID());
+	}
+	for (unsigned long i = 0; i < 3; ++i) {
+		ASSERT_EQUAL(100ul + i, linkedCells.getMoleculeAtSlot(haloSlots[i], 100ul + i)->getID());
+	}
+
+	// deleting a molecule moves the others within the cell, they are still found by their id
+	for (auto it = linkedCells.iterator(ParticleIterator::ALL_CELLS); it.isValid(); ++it) {
+		if (it->getID() == 100ul) {
+			linkedCells.deleteMolecule(it, false);
+		}
+	}
+	ASSERT_TRUE(not linkedCells.getMoleculeAtSlot(haloSlots[0], 100ul).isValid());
+	ASSERT_EQUAL(101ul, linkedCells.getMoleculeAtSlot(haloSlots[1], 101ul)->getID());
+}
@@ -29,6 +29,10 @@ class LinkedCellsTest: public ParticleContainerTest {
 
 	TEST_METHOD(testCellBorderAndFlagManager);
 
+	TEST_METHOD(testResizeInPlace);
+
+	TEST_METHOD(testMoleculeSlots);
+
 #ifndef ENABLE_REDUCED_MEMORY_MODE
 	TEST_METHOD(testFullShellMPIDirectPP);
 	TEST_METHOD(testFullShellMPIDirect);
@@ -102,6 +106,10 @@ public:
 
 	void testCellBorderAndFlagManager();
 
+	void testResizeInPlace();
+
+	void testMoleculeSlots();
+
 private:
 
 	void doForceComparisonTest(std::string inputFile, TraversalTuner<ParticleCell>::traversalNames traversal, unsigned cellsInCutoff, std::string neighbourCommScheme, std::string commScheme);
@@ -0,0 +1,78 @@
+/*
+ * LocalDensityTest.cpp
+ */
+
+#include "LocalDensityTest.h"
+
+#include <cmath>
+#include <limits>
+#include <memory>
+
+#include "molecules/Molecule.h"
+#include "particleContainer/LocalDensity.h"
+#include "particleContainer/ParticleContainer.h"
+
+TEST_SUITE_REGISTRATION(LocalDensityTest);
+
+LocalDensityTest::LocalDensityTest() {}
+
+LocalDensityTest::~LocalDensityTest() {}
+
+void LocalDensityTest::testNeighbourCounts() {
+	compareToDirectCount(-1);
+}
+
+void LocalDensityTest::testHalfSpaceNeighbourCounts() {
+	compareToDirectCount(1);
+}
+
+void LocalDensityTest::compareToDirectCount(int halfSpaceDim) {
+	const double cutoff = 4.0;
+	std::unique_ptr<ParticleContainer> container{
+		initializeFromFile(ParticleContainerFactory::LinkedCell, "simple-lj.inp", cutoff)};
+
+	// a region in the middle of the container, so molecules outside of it have to be taken into account as neighbours
+	double regionLow[3], regionHigh[3];
+	for (int d = 0; d < 3; d++) {
+		const double lo = container->getBoundingBoxMin(d);
+		const double hi = container->getBoundingBoxMax(d);
+		regionLow[d] = lo + 0.4 * (hi - lo);
+		regionHigh[d] = hi - 0.4 * (hi - lo);
+	}
+
+	LocalDensity localDensity;
+	localDensity.bin(container.get(), cutoff);
+	LocalDensity::Densities result;
+	localDensity.computeDensities(regionLow, regionHigh, 0.5, result, halfSpaceDim);
+	const auto& molecules = result.molecules;
+	const auto& densities = result.densities;
+	ASSERT_TRUE_MSG("no molecules in the region", not molecules.empty());
+
+	const double halfSphereFactor = halfSpaceDim < 0 ? 1. : 0.5;
+	const double volume = halfSphereFactor * 4. / 3. * M_PI * cutoff * cutoff * cutoff;
+	for (size_t i = 0; i < molecules.size(); i++) {
+		const Molecule* m1 = molecules[i];
+		for (int d = 0; d < 3; d++) {
+			ASSERT_TRUE(m1->r(d) >= regionLow[d] and m1->r(d) < regionHigh[d]);
+		}
+		unsigned neighbours = 0;
+		for (auto m2 = container->iterator(ParticleIterator::ALL_CELLS); m2.isValid(); ++m2) {
+			if (m2->getID() == m1->getID()) {
+				continue;
+			}
+			if (halfSpaceDim >= 0 and m2->r(halfSpaceDim) > m1->r(halfSpaceDim)) {
+				continue;
+			}
+			double distanceSquare = 0.;
+			for (int d = 0; d < 3; d++) {
+				distanceSquare += (m2->r(d) - m1->r(d)) * (m2->r(d) - m1->r(d));
+			}
+			if (distanceSquare < cutoff * cutoff) {
+				neighbours++;
+			}
+		}
+		ASSERT_DOUBLES_EQUAL(neighbours / volume, densities[i], 1e-12);
+		const double r[3] = {m1->r(0), m1->r(1), m1->r(2)};
+		ASSERT_EQUAL(neighbours + 1, localDensity.countNeighbours(r, std::numeric_limits<unsigned>::max(), halfSpaceDim));
+	}
+}
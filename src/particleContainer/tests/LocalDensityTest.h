@@ -0,0 +1,32 @@
+/*
+ * LocalDensityTest.h
+ */
+
+#pragma once
+
+#include "utils/TestWithSimulationSetup.h"
+#include "utils/Testing.h"
+
+/**
+ * Compares the neighbour counts of LocalDensity to a direct loop over all pairs.
+ */
+class LocalDensityTest : public utils::TestWithSimulationSetup {
+
+	TEST_SUITE(LocalDensityTest);
+	TEST_METHOD(testNeighbourCounts);
+	TEST_METHOD(testHalfSpaceNeighbourCounts);
+	TEST_SUITE_END;
+
+public:
+
+	LocalDensityTest();
+
+	virtual ~LocalDensityTest();
+
+	void testNeighbourCounts();
+
+	void testHalfSpaceNeighbourCounts();
+
+private:
+	void compareToDirectCount(int halfSpaceDim);
+};
@@ -0,0 +1,212 @@
+/*
+ * GreenKubo.cpp
+ */
+
+#include "GreenKubo.h"
+
+#include <fstream>
+#include <iomanip>
+
+#include "Domain.h"
+#include "Simulation.h"
+#include "ensemble/EnsembleBase.h"
+#include "integrators/Integrator.h"
+#include "molecules/Molecule.h"
+#include "parallel/DomainDecompBase.h"
+#include "particleContainer/ParticleContainer.h"
+#include "particleContainer/adapter/HeatFluxCellProcessor.h"
+#include "utils/Logger.h"
+#include "utils/mardyn_assert.h"
+#include "utils/xmlfileUnits.h"
+
+namespace {
+//! running trapezoidal integral of f over the increasing abscissae x
+std::vector<double> runningIntegral(const std::vector<double>& x, const std::vector<double>& f) {
+	std::vector<double> integral(f.size(), 0.);
+	for (size_t i = 1; i < f.size(); i++) {
+		integral[i] = integral[i - 1] + 0.5 * (x[i] - x[i - 1]) * (f[i] + f[i - 1]);
+	}
+	return integral;
+}
+}  // namespace
+
+GreenKubo::GreenKubo()
+	: _outputPrefix("greenkubo"),
+	  _start(0),
+	  _samplingFrequency(1),
+	  _writeFrequency(10000),
+	  _heatFlux(false),
+	  _potentialHeatFlux{0., 0., 0.},
+	  _volume(0.),
+	  _timestepLength(0.),
+	  _temperatureSum(0.),
+	  _isRoot(true) {}
+
+GreenKubo::~GreenKubo() = default;
+
+void GreenKubo::readXML(XMLfileUnits& xmlconfig) {
+	xmlconfig.getNodeValue("outputprefix", _outputPrefix);
+	xmlconfig.getNodeValue("start", _start);
+	xmlconfig.getNodeValue("samplingfrequency", _samplingFrequency);
+	xmlconfig.getNodeValue("writefrequency", _writeFrequency);
+	unsigned levels = 16;
+	unsigned points = 16;
+	unsigned averaging = 2;
+	xmlconfig.getNodeValue("correlator/levels", levels);
+	xmlconfig.getNodeValue("correlator/points", points);
+	xmlconfig.getNodeValue("correlator/averaging", averaging);
+	xmlconfig.getNodeValue("heatflux", _heatFlux);
+
+	if (_samplingFrequency == 0 or _writeFrequency == 0) {
+		MARDYN_EXIT("GreenKubo: samplingfrequency and writefrequency have to be positive.");
+	}
+	_shearStressCorrelator = MultipleTauCorrelator(3, levels, points, averaging);
+	_heatFluxCorrelator = MultipleTauCorrelator(3, levels, points, averaging);
+
+	Log::global_log->info() << "GreenKubo: sampling every " << _samplingFrequency << " time steps from step "
+							<< _start << ", correlator with " << levels << " levels of " << points
+							<< " points, averaging " << averaging << ", heat flux "
+							<< (_heatFlux ? "enabled" : "disabled") << ", output " << _outputPrefix << ".dat every "
+							<< _writeFrequency << " time steps" << std::endl;
+}
+
+void GreenKubo::init(ParticleContainer* /*particleContainer*/, DomainDecompBase* domainDecomp, Domain* domain) {
+	_isRoot = domainDecomp->getRank() == 0;
+	_volume = domain->getGlobalVolume();
+	_timestepLength = global_simulation->getIntegrator()->getTimestepLength();
+
+	if (_heatFlux) {
+		for (auto& component : *(global_simulation->getEnsemble()->getComponents())) {
+			if (component.numCharges() + component.numDipoles() + component.numQuadrupoles() > 0) {
+				MARDYN_EXIT("GreenKubo: the heat flux is only implemented for Lennard-Jones centers.");
+			}
+		}
+		_heatFluxCellProcessor = std::make_unique<HeatFluxCellProcessor>(
+			global_simulation->getcutoffRadius(), global_simulation->getLJCutoff(), domain->getComp2Params(),
+			_timestepLength);
+	}
+}
+
+bool GreenKubo::isSamplingStep(unsigned long simstep) const {
+	return simstep >= _start and (simstep - _start) % _samplingFrequency == 0;
+}
+
+void GreenKubo::afterForces(ParticleContainer* particleContainer, DomainDecompBase* /*domainDecomp*/,
+							unsigned long simstep) {
+	if (not _heatFlux or not isSamplingStep(simstep)) {
+		return;
+	}
+	if (particleContainer->requiresForceExchange()) {
+		MARDYN_EXIT("GreenKubo: the heat flux requires a traversal that does not exchange forces with the halo, "
+					"e.g. c08.");
+	}
+	particleContainer->traverseCells(*_heatFluxCellProcessor);
+	_potentialHeatFlux = _heatFluxCellProcessor->getHeatFlux();
+}
+
+void GreenKubo::endStep(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp, Domain* domain,
+						unsigned long simstep) {
+	if (not isSamplingStep(simstep)) {
+		return;
+	}
+
+	// diagonal of the pressure tensor times the volume, heat flux
+	double Pxx = 0., Pyy = 0., Pzz = 0.;
+	double Jx = 0., Jy = 0., Jz = 0.;
+	const bool heatFluxEnabled = _heatFlux;
+	#if defined(_OPENMP)
+	#pragma omp parallel reduction(+:Pxx, Pyy, Pzz, Jx, Jy, Jz)
+	#endif
+	for (auto it = particleContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); it.isValid(); ++it) {
+		const double m = it->mass();
+		Pxx += m * it->v(0) * it->v(0) + it->Vi(0);
+		Pyy += m * it->v(1) * it->v(1) + it->Vi(1);
+		Pzz += m * it->v(2) * it->v(2) + it->Vi(2);
+		if (heatFluxEnabled) {
+			const double kineticEnergy = it->U_kin();
+			Jx += kineticEnergy * it->v(0);
+			Jy += kineticEnergy * it->v(1);
+			Jz += kineticEnergy * it->v(2);
+		}
+	}
+	double stress[3] = {Pxx, Pyy, Pzz};
+	double heatFlux[3] = {Jx, Jy, Jz};
+
+	domainDecomp->collCommInit(6);
+	for (unsigned short d = 0; d < 3; ++d) {
+		domainDecomp->collCommAppendDouble(stress[d]);
+		domainDecomp->collCommAppendDouble(heatFlux[d] + _potentialHeatFlux[d]);
+	}
+	domainDecomp->collCommAllreduceSum();
+	for (unsigned short d = 0; d < 3; ++d) {
+		stress[d] = domainDecomp->collCommGetDouble();
+		heatFlux[d] = domainDecomp->collCommGetDouble();
+	}
+	domainDecomp->collCommFinalize();
+
+	if (not _isRoot) {
+		return;
+	}
+	const double shearStress[3] = {
+		0.5 * (stress[0] - stress[1]) / _volume,
+		0.5 * (stress[1] - stress[2]) / _volume,
+		0.5 * (stress[2] - stress[0]) / _volume,
+	};
+	_shearStressCorrelator.add(shearStress);
+	if (_heatFlux) {
+		_heatFluxCorrelator.add(heatFlux);
+	}
+	_temperatureSum += domain->getGlobalCurrentTemperature();
+
+	if ((simstep - _start) % _writeFrequency == 0 and simstep > _start) {
+		write(simstep);
+	}
+}
+
+void GreenKubo::finish(ParticleContainer* /*particleContainer*/, DomainDecompBase* /*domainDecomp*/,
+					   Domain* /*domain*/) {
+	if (_isRoot and _shearStressCorrelator.getNumSamples() > 1) {
+		write(global_simulation->getSimulationStep());
+	}
+}
+
+void GreenKubo::write(unsigned long simstep) const {
+	const unsigned long numSamples = _shearStressCorrelator.getNumSamples();
+	const double temperature = _temperatureSum / numSamples;
+	const double sampleTime = _samplingFrequency * _timestepLength;
+
+	std::vector<unsigned long> lags;
+	std::vector<double> shear, heat;
+	_shearStressCorrelator.getCorrelation(lags, shear);
+	if (_heatFlux) {
+		_heatFluxCorrelator.getCorrelation(lags, heat);
+	}
+	std::vector<double> times(lags.size());
+	for (size_t i = 0; i < lags.size(); i++) {
+		times[i] = lags[i] * sampleTime;
+	}
+	const std::vector<double> viscosity = runningIntegral(times, shear);
+	const std::vector<double> conductivity = runningIntegral(times, heat);
+
+	const std::string filename = _outputPrefix + ".dat";
+	std::ofstream out(filename.c_str());
+	out << "# Green-Kubo autocorrelation functions and their integrals, time step " << simstep << std::endl;
+	out << "# samples: " << numSamples << ", sampling interval: " << sampleTime << ", volume: " << _volume
+		<< ", mean temperature: " << temperature << std::endl;
+	out << "# time\tC_shearstress\tviscosity";
+	if (_heatFlux) {
+		out << "\tC_heatflux\tconductivity";
+	}
+	out << std::endl;
+	out << std::setprecision(9) << std::scientific;
+	for (size_t i = 0; i < times.size(); i++) {
+		out << times[i] << "\t" << shear[i] << "\t" << _volume / temperature * viscosity[i];
+		if (_heatFlux) {
+			out << "\t" << heat[i] << "\t" << conductivity[i] / (_volume * temperature * temperature);
+		}
+		out << std::endl;
+	}
+	if (not out) {
+		Log::global_log->error() << "GreenKubo: could not write " << filename << std::endl;
+	}
+}
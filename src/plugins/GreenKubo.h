@@ -0,0 +1,98 @@
+/*
+ * GreenKubo.h
+ */
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "plugins/PluginBase.h"
+#include "utils/MultipleTauCorrelator.h"
+
+class HeatFluxCellProcessor;
+
+/**
+ * @brief Shear viscosity and thermal conductivity by the Green-Kubo relations, sampled during the simulation.
+ * @details The global stress and heat flux are sampled every samplingfrequency time steps and passed to multiple-tau
+ * correlators (see MultipleTauCorrelator), so neither time series is written. The output file contains the
+ * autocorrelation functions and their running integrals, the transport coefficients in reduced units:
+ * \f$ \eta = \frac{V}{k_B T} \int_0^t \langle P(0) P(\tau) \rangle d\tau \f$ and
+ * \f$ \lambda = \frac{1}{V k_B T^2} \int_0^t \langle J(0) J(\tau) \rangle d\tau \f$.
+ *
+ * The stress uses the per-molecule virials accumulated by the force calculation and the kinetic contribution. As the
+ * virials contain the diagonal of the tensor only, the shear stresses are the normal stress differences
+ * (P_xx - P_yy) / 2, (P_yy - P_zz) / 2 and (P_zz - P_xx) / 2, i.e. the off-diagonal elements of the pressure tensor in
+ * coordinate systems rotated by 45 degrees. For an isotropic fluid their autocorrelation functions equal the one of
+ * P_xy.
+ *
+ * The heat flux J (extensive, averaged over x, y and z) requires an additional traversal of the molecule pairs on
+ * every sampling step (see HeatFluxCellProcessor), so it is optional. It is restricted to components of
+ * Lennard-Jones centers and traversals which do not need the force exchange of the halo. The velocities of the end of
+ * the time step are used, which is only consistent for NVE simulations, as thermostats scale them afterwards.
+ */
+class GreenKubo : public PluginBase {
+public:
+	GreenKubo();
+	~GreenKubo() override;
+
+	/** @brief Read in XML configuration for GreenKubo.
+	 *
+	 * The following XML object structure is handled by this method:
+	 * \code{.xml}
+		<plugin name="GreenKubo">
+			<outputprefix>STRING</outputprefix>        <!-- the results are written to outputprefix.dat; default: greenkubo -->
+			<start>INT</start>                         <!-- first time step sampled; default: 0 -->
+			<samplingfrequency>INT</samplingfrequency> <!-- time steps between two samples; default: 1 -->
+			<writefrequency>INT</writefrequency>       <!-- time steps between two outputs; default: 10000 -->
+			<correlator>
+				<levels>INT</levels>                   <!-- default: 16 -->
+				<points>INT</points>                   <!-- lags per level, a multiple of averaging; default: 16 -->
+				<averaging>INT</averaging>             <!-- samples averaged for the next level; default: 2 -->
+			</correlator>
+			<heatflux>BOOL</heatflux>                  <!-- also compute the thermal conductivity; default: false -->
+		</plugin>
+	   \endcode
+	 */
+	void readXML(XMLfileUnits& xmlconfig) override;
+
+	void init(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp, Domain* domain) override;
+
+	/**
+	 * Computes the potential part of the heat flux on sampling steps, while the halo is still present.
+	 */
+	void afterForces(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp,
+					 unsigned long simstep) override;
+
+	void endStep(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp, Domain* domain,
+				 unsigned long simstep) override;
+
+	void finish(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp, Domain* domain) override;
+
+	std::string getPluginName() override { return std::string("GreenKubo"); }
+	static PluginBase* createInstance() { return new GreenKubo(); }
+
+private:
+	bool isSamplingStep(unsigned long simstep) const;
+	//! @brief write the correlation functions and their integrals, rank 0 only
+	void write(unsigned long simstep) const;
+
+	std::string _outputPrefix;
+	unsigned long _start;
+	unsigned long _samplingFrequency;
+	unsigned long _writeFrequency;
+	bool _heatFlux;
+
+	MultipleTauCorrelator _shearStressCorrelator;
+	MultipleTauCorrelator _heatFluxCorrelator;
+	std::unique_ptr<HeatFluxCellProcessor> _heatFluxCellProcessor;
+	//! local potential part of the heat flux of the current sampling step
+	std::array<double, 3> _potentialHeatFlux;
+
+	double _volume;
+	double _timestepLength;
+	double _temperatureSum;
+	bool _isRoot;
+};
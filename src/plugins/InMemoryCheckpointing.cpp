@@ -8,12 +8,282 @@
 #include "InMemoryCheckpointing.h"
 #include "utils/xmlfileUnits.h"
 #include "utils/Logger.h"
+#include "utils/mardyn_assert.h"
 #include "molecules/Molecule.h"
 #include "particleContainer/ParticleContainer.h"
 #include "Simulation.h"
 #include "Domain.h"
+#include "ensemble/EnsembleBase.h"
 #include "parallel/DomainDecompBase.h"
+#ifdef ENABLE_MPI
+#include "parallel/ResilienceComm.h"
+#endif
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+
+namespace {
+
+struct SnapshotHeader {
+	uint64_t numMolecules;
+	uint64_t globalNumberOfMolecules;
+	double currentTime;
+	double temperature;
+	double boxDims[3];
+	int32_t rank;
+	int32_t compressed;
+};
+
+template<typename T>
+void append(std::vector<char>& buffer, const T* data, size_t n) {
+	const size_t offset = buffer.size();
+	buffer.resize(offset + n * sizeof(T));
+	std::memcpy(buffer.data() + offset, data, n * sizeof(T));
+}
+
+template<typename T>
+void extract(const std::vector<char>& buffer, size_t& offset, T* data, size_t n) {
+	mardyn_assert(offset + n * sizeof(T) <= buffer.size());
+	std::memcpy(data, buffer.data() + offset, n * sizeof(T));
+	offset += n * sizeof(T);
+}
+
+void appendVarint(std::vector<char>& buffer, uint64_t value) {
+	while (value >= 0x80) {
+		buffer.push_back(static_cast<char>((value & 0x7f) | 0x80));
+		value >>= 7;
+	}
+	buffer.push_back(static_cast<char>(value));
+}
+
+uint64_t extractVarint(const std::vector<char>& buffer, size_t& offset) {
+	uint64_t value = 0;
+	for (int shift = 0; ; shift += 7) {
+		mardyn_assert(offset < buffer.size());
+		const auto byte = static_cast<unsigned char>(buffer[offset++]);
+		value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+		if (byte < 0x80) {
+			return value;
+		}
+	}
+}
+
+/**
+ * Non-zero bytes are stored as they are, runs of zeros as a zero followed by the length of the run.
+ */
+void appendZeroRunLength(std::vector<char>& buffer, const unsigned char* data, size_t n) {
+	for (size_t i = 0; i < n;) {
+		if (data[i] != 0) {
+			buffer.push_back(static_cast<char>(data[i++]));
+			continue;
+		}
+		size_t run = 1;
+		while (i + run < n and data[i + run] == 0) {
+			++run;
+		}
+		buffer.push_back(0);
+		appendVarint(buffer, run);
+		i += run;
+	}
+}
+
+void extractZeroRunLength(const std::vector<char>& buffer, size_t& offset, unsigned char* data, size_t n) {
+	for (size_t i = 0; i < n;) {
+		mardyn_assert(offset < buffer.size());
+		const auto byte = static_cast<unsigned char>(buffer[offset++]);
+		if (byte != 0) {
+			data[i++] = byte;
+			continue;
+		}
+		const uint64_t run = extractVarint(buffer, offset);
+		mardyn_assert(i + run <= n);
+		std::fill(data + i, data + i + run, 0);
+		i += run;
+	}
+}
+
+/**
+ * For every id the position of the same id in referenceIds, -1 if it is not contained. Both have to be sorted.
+ */
+std::vector<long> matchIds(const std::vector<unsigned long>& ids, const std::vector<unsigned long>& referenceIds) {
+	std::vector<long> match(ids.size(), -1);
+	size_t j = 0;
+	for (size_t i = 0; i < ids.size(); ++i) {
+		while (j < referenceIds.size() and referenceIds[j] < ids[i]) {
+			++j;
+		}
+		if (j < referenceIds.size() and referenceIds[j] == ids[i]) {
+			match[i] = j;
+		}
+	}
+	return match;
+}
+
+} // namespace
+
+void InMemoryCheckpointing::Snapshot::setMolecules(const std::vector<const Molecule*>& molecules) {
+	std::vector<const Molecule*> sorted(molecules);
+	std::sort(sorted.begin(), sorted.end(), [](const Molecule* a, const Molecule* b) {
+		return a->getID() < b->getID();
+	});
+
+	const size_t N = sorted.size();
+	_ids.resize(N);
+	_componentIds.resize(N);
+	_values.resize(NUM_VALUES * N);
+	#if defined(_OPENMP)
+	#pragma omp parallel for schedule(static)
+	#endif
+	for (size_t i = 0; i < N; ++i) {
+		const Molecule& m = *sorted[i];
+		_ids[i] = m.getID();
+		_componentIds[i] = m.componentid();
+		for (unsigned short d = 0; d < 3; ++d) {
+			_values[(RX + d) * N + i] = m.r(d);
+			_values[(VX + d) * N + i] = m.v(d);
+			_values[(DX + d) * N + i] = m.D(d);
+			_values[(FX + d) * N + i] = m.F(d);
+			_values[(MX + d) * N + i] = m.M(d);
+		}
+		const Quaternion& q = m.q();
+		_values[QW * N + i] = q.qw();
+		_values[QX * N + i] = q.qx();
+		_values[QY * N + i] = q.qy();
+		_values[QZ * N + i] = q.qz();
+	}
+}
+
+std::vector<Molecule> InMemoryCheckpointing::Snapshot::getMolecules(std::vector<Component>& components) const {
+	const size_t N = _ids.size();
+	std::vector<Molecule> molecules;
+	molecules.reserve(N);
+	for (size_t i = 0; i < N; ++i) {
+		auto value = [this, N, i](Value v) { return _values[v * N + i]; };
+		mardyn_assert(_componentIds[i] < components.size());
+		molecules.emplace_back(_ids[i], &components[_componentIds[i]],
+							   value(RX), value(RY), value(RZ), value(VX), value(VY), value(VZ),
+							   value(QW), value(QX), value(QY), value(QZ), value(DX), value(DY), value(DZ));
+		double F[3] = {value(FX), value(FY), value(FZ)};
+		double M[3] = {value(MX), value(MY), value(MZ)};
+		molecules.back().setF(F);
+		molecules.back().setM(M);
+	}
+	return molecules;
+}
+
+void InMemoryCheckpointing::Snapshot::serialize(std::vector<char>& buffer, const Snapshot* reference) const {
+	const size_t N = _ids.size();
+	SnapshotHeader header;
+	header.numMolecules = N;
+	header.globalNumberOfMolecules = _globalNumberOfMolecules;
+	header.currentTime = _currentTime;
+	header.temperature = _temperature;
+	std::copy(_boxDims.begin(), _boxDims.end(), header.boxDims);
+	header.rank = _rank;
+	header.compressed = reference != nullptr;
+
+	buffer.clear();
+	append(buffer, &header, 1);
+	if (reference == nullptr) {
+		buffer.reserve(buffer.size() + N * (sizeof(unsigned long) + sizeof(unsigned int) + NUM_VALUES * sizeof(double)));
+		append(buffer, _ids.data(), N);
+		append(buffer, _componentIds.data(), N);
+		append(buffer, _values.data(), _values.size());
+		return;
+	}
+
+	// ids are sorted, so their differences are small
+	unsigned long previousId = 0;
+	for (size_t i = 0; i < N; ++i) {
+		appendVarint(buffer, _ids[i] - previousId);
+		previousId = _ids[i];
+	}
+	for (size_t i = 0; i < N; ++i) {
+		appendVarint(buffer, _componentIds[i]);
+	}
+
+	// values XOR the reference values share the leading bytes, which become zero; gather the bytes by significance
+	const std::vector<long> match = matchIds(_ids, reference->_ids);
+	const size_t referenceN = reference->_ids.size();
+	const size_t numValues = _values.size();
+	std::vector<unsigned char> planes(numValues * sizeof(uint64_t));
+	#if defined(_OPENMP)
+	#pragma omp parallel for schedule(static)
+	#endif
+	for (int v = 0; v < NUM_VALUES; ++v) {
+		for (size_t i = 0; i < N; ++i) {
+			uint64_t bits, referenceBits = 0;
+			std::memcpy(&bits, &_values[v * N + i], sizeof(bits));
+			if (match[i] >= 0) {
+				std::memcpy(&referenceBits, &reference->_values[v * referenceN + match[i]], sizeof(referenceBits));
+			}
+			bits ^= referenceBits;
+			for (size_t b = 0; b < sizeof(uint64_t); ++b) {
+				planes[b * numValues + v * N + i] = static_cast<unsigned char>(bits >> (8 * b));
+			}
+		}
+	}
+	appendZeroRunLength(buffer, planes.data(), planes.size());
+}
+
+void InMemoryCheckpointing::Snapshot::deserialize(const std::vector<char>& buffer, const Snapshot& reference) {
+	SnapshotHeader header;
+	size_t offset = 0;
+	extract(buffer, offset, &header, 1);
+	const size_t N = header.numMolecules;
+	_globalNumberOfMolecules = header.globalNumberOfMolecules;
+	_currentTime = header.currentTime;
+	_temperature = header.temperature;
+	std::copy(header.boxDims, header.boxDims + 3, _boxDims.begin());
+	_rank = header.rank;
+
+	_ids.resize(N);
+	_componentIds.resize(N);
+	_values.resize(NUM_VALUES * N);
+	if (not header.compressed) {
+		extract(buffer, offset, _ids.data(), N);
+		extract(buffer, offset, _componentIds.data(), N);
+		extract(buffer, offset, _values.data(), _values.size());
+		return;
+	}
+
+	unsigned long previousId = 0;
+	for (size_t i = 0; i < N; ++i) {
+		_ids[i] = previousId + extractVarint(buffer, offset);
+		previousId = _ids[i];
+	}
+	for (size_t i = 0; i < N; ++i) {
+		_componentIds[i] = extractVarint(buffer, offset);
+	}
+
+	const std::vector<long> match = matchIds(_ids, reference._ids);
+	const size_t referenceN = reference._ids.size();
+	const size_t numValues = _values.size();
+	std::vector<unsigned char> planes(numValues * sizeof(uint64_t));
+	extractZeroRunLength(buffer, offset, planes.data(), planes.size());
+	#if defined(_OPENMP)
+	#pragma omp parallel for schedule(static)
+	#endif
+	for (int v = 0; v < NUM_VALUES; ++v) {
+		for (size_t i = 0; i < N; ++i) {
+			uint64_t bits = 0, referenceBits = 0;
+			for (size_t b = 0; b < sizeof(uint64_t); ++b) {
+				bits |= static_cast<uint64_t>(planes[b * numValues + v * N + i]) << (8 * b);
+			}
+			if (match[i] >= 0) {
+				std::memcpy(&referenceBits, &reference._values[v * referenceN + match[i]], sizeof(referenceBits));
+			}
+			bits ^= referenceBits;
+			std::memcpy(&_values[v * N + i], &bits, sizeof(bits));
+		}
+	}
+}
+
+InMemoryCheckpointing::InMemoryCheckpointing() = default;
+
+InMemoryCheckpointing::~InMemoryCheckpointing() = default;
 
 void InMemoryCheckpointing::readXML(XMLfileUnits& xmlconfig) {
 	_writeFrequency = 5;
@@ -23,6 +293,70 @@ void InMemoryCheckpointing::readXML(XMLfileUnits& xmlconfig) {
 	_restartAtIteration = 10;
 	xmlconfig.getNodeValue("restartAtIteration", _restartAtIteration);
 	Log::global_log->info() << "Restart at iteration (for development purposes): " << _restartAtIteration << std::endl;
+
+	_numberOfBackups = 1;
+	xmlconfig.getNodeValue("backups", _numberOfBackups);
+	Log::global_log->info() << "Number of backups on buddy ranks: " << _numberOfBackups << std::endl;
+
+	_compress = false;
+	xmlconfig.getNodeValue("compress", _compress);
+	Log::global_log->info() << "Compress snapshots: " << (_compress ? "yes" : "no") << std::endl;
+
+	_restoreFromBackup = false;
+	xmlconfig.getNodeValue("restoreFromBackup", _restoreFromBackup);
+	Log::global_log->info() << "Restore from backup (for development purposes): " << (_restoreFromBackup ? "yes" : "no") << std::endl;
+}
+
+void InMemoryCheckpointing::init(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp,
+								 Domain* domain) {
+#ifdef ENABLE_MPI
+	const int numProcs = domainDecomp->getNumProcs();
+	if (numProcs > 1 and _numberOfBackups > 0) {
+		if (_numberOfBackups >= numProcs) {
+			Log::global_log->warning() << "InMemoryCheckpointing: reducing the number of backups to " << numProcs - 1
+									   << std::endl;
+			_numberOfBackups = numProcs - 1;
+		}
+		_resilienceComm = std::make_unique<ResilienceComm>(numProcs, domainDecomp->getRank());
+		int sameNodeBackups = 0;
+		std::vector<int> backupInfo = _resilienceComm->determineBackups(_numberOfBackups, sameNodeBackups);
+		_resilienceComm->scatterBackupInfo(backupInfo, _numberOfBackups, RR_INTS_PER_RANK, _backing, _backedBy,
+										   _backingTags, _backedByTags);
+		_backups.resize(_backing.size());
+		if (sameNodeBackups > 0) {
+			Log::global_log->warning() << "InMemoryCheckpointing: " << sameNodeBackups << " of "
+									   << _numberOfBackups * numProcs
+									   << " backups reside on the node of the rank they back up" << std::endl;
+		}
+		return;
+	}
+#endif
+	if (_numberOfBackups > 0) {
+		Log::global_log->info() << "InMemoryCheckpointing: single process, snapshots are kept locally only" << std::endl;
+	}
+	_numberOfBackups = 0;
+	if (_restoreFromBackup) {
+		Log::global_log->warning() << "InMemoryCheckpointing: no backups, restoring from the local snapshot" << std::endl;
+		_restoreFromBackup = false;
+	}
+}
+
+void InMemoryCheckpointing::completeBackups() {
+#ifdef ENABLE_MPI
+	if (not _receivePending) {
+		return;
+	}
+	_resilienceComm->waitSnapshotExchange();
+	// decode right away, as the next snapshots refer to these
+	for (size_t ib = 0; ib < _backing.size(); ++ib) {
+		Snapshot backup;
+		backup.deserialize(_recvBuffers[ib], _backups[ib]);
+		std::swap(_backups[ib], backup);
+		std::vector<char>().swap(_recvBuffers[ib]);
+	}
+	std::vector<char>().swap(_sendBuffer);
+	_receivePending = false;
+#endif
 }
 
 void InMemoryCheckpointing::beforeEventNewTimestep(
@@ -31,53 +365,113 @@ void InMemoryCheckpointing::beforeEventNewTimestep(
 	if (simstep != _restartAtIteration) {
 		return;
 	}
-	Log::global_log->info() << "InMemoryCheckpointWriter: resetting time to: " << _snapshot.getCurrentTime() << std::endl;
+	completeBackups();
+
+	const Snapshot* snapshot = &_snapshot;
+#ifdef ENABLE_MPI
+	Snapshot restored;
+	if (_restoreFromBackup) {
+		// every rank returns the backups it keeps to their owners
+		std::vector<std::vector<char>> backupBuffers(_backing.size());
+		std::vector<std::vector<char> const*> sendData(_backing.size());
+		for (size_t ib = 0; ib < _backing.size(); ++ib) {
+			_backups[ib].serialize(backupBuffers[ib], nullptr);
+			sendData[ib] = &backupBuffers[ib];
+		}
+		std::vector<std::vector<char>> returnedBuffers;
+		_resilienceComm->postSnapshotExchange(_backing, _backingTags, sendData, _backedBy, _backedByTags,
+											  returnedBuffers);
+		_resilienceComm->waitSnapshotExchange();
+		restored.deserialize(returnedBuffers[0], Snapshot());
+		mardyn_assert(restored.getCurrentTime() == _snapshot.getCurrentTime());
+		snapshot = &restored;
+	}
+#endif
+	Log::global_log->info() << "InMemoryCheckpointWriter: resetting time to: " << snapshot->getCurrentTime() << std::endl;
 	Domain * domain = global_simulation->getDomain();
 
+	std::vector<Molecule> molecules = snapshot->getMolecules(*global_simulation->getEnsemble()->getComponents());
+	// the molecules are inserted as they are, so the own domain must not have changed since the snapshot
+	for (const Molecule& m : molecules) {
+		for (unsigned short d = 0; d < 3; ++d) {
+			if (m.r(d) < particleContainer->getBoundingBoxMin(d) or m.r(d) >= particleContainer->getBoundingBoxMax(d)) {
+				std::ostringstream error_message;
+				error_message << "InMemoryCheckpointing: molecule " << m.getID()
+							  << " of the snapshot lies outside of the current domain, the domain decomposition must "
+								 "not change between taking and restoring a snapshot" << std::endl;
+				MARDYN_EXIT(error_message.str());
+			}
+		}
+	}
+
 	// erase all current molecules
 	particleContainer->clear();
 
 	// fill new molecules
-	particleContainer->addParticles(const_cast<std::vector<Molecule>& >(_snapshot.getMolecules()));
-
-	// there should be no need to compute the forces again!
-	// They are saved in the Molecule objects this time, due to the copy constructor.
+	particleContainer->addParticles(molecules);
 
+	// there should be no need to compute the forces again, they are part of the snapshot.
 	// Note that the forces, rotational moments are usually not saved in checkpoints and have to be recomputed in prepare_start()
-	// so eventually, the following calls may be necessary:
-	// * Simulation::updateParticleContainerAndDecomposition,
-	// * ParticleContainer::traverseCells(cellProcessor)
-	// * Simulation::updateForces()
 
 
 	// set globals
-	global_simulation->setSimulationTime(_snapshot.getCurrentTime());
-	domain->setGlobalTemperature(_snapshot.getTemperature());
+	global_simulation->setSimulationTime(snapshot->getCurrentTime());
+	domain->setGlobalTemperature(snapshot->getTemperature());
 
-	mardyn_assert(_snapshot.getGlobalNumberOfMolecules() == domain->getglobalNumMolecules(true, particleContainer, domainDecomp));
-	mardyn_assert(domainDecomp->getRank() == _snapshot.getRank());
+	mardyn_assert(snapshot->getGlobalNumberOfMolecules() == domain->getglobalNumMolecules(true, particleContainer, domainDecomp));
+	mardyn_assert(domainDecomp->getRank() == snapshot->getRank());
 
 }
 
 void InMemoryCheckpointing::endStep(ParticleContainer* particleContainer,
 		DomainDecompBase* domainDecomp, Domain* domain, unsigned long simstep) {
+#ifdef ENABLE_MPI
+	// drive the replication of the last snapshot
+	if (_receivePending and _resilienceComm->testSnapshotExchange()) {
+		completeBackups();
+	}
+#endif
 	if (simstep % _writeFrequency != 0) {
 		return;
 	}
+	completeBackups();
 
 	// else, write snapshot
 	Log::global_log->info() << "InMemoryCheckpointWriter: writing snapshot: " << std::endl;
 
-	// put the molecules in the buffer
-	_snapshot.clearMolecules();
+	// collect the molecules
+	std::vector<const Molecule*> molecules;
+	molecules.reserve(particleContainer->getNumberOfParticles(ParticleIterator::ONLY_INNER_AND_BOUNDARY));
 	for (auto m = particleContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); m.isValid(); ++m) {
-		_snapshot.addMolecule(*m);
+		molecules.push_back(&(*m));
 	}
+	Snapshot snapshot;
+	snapshot.setMolecules(molecules);
+
+	//set time, global number of molecules and target temperature
+	snapshot.setCurrentTime(global_simulation->getSimulationTime());
+	snapshot.setGlobalNumberOfMolecules(domain->getglobalNumMolecules(true, particleContainer, domainDecomp));
+	snapshot.setTemperature(domain->getTargetTemperature(0));
+	snapshot.setRank(domainDecomp->getRank());
+	snapshot.setBoxDims({domain->getGlobalLength(0), domain->getGlobalLength(1), domain->getGlobalLength(2)});
 
-	//set time, global number of molecules and temperature
-	_snapshot.setCurrentTime(global_simulation->getSimulationTime());
-	_snapshot.setGlobalNumberOfMolecules(domain->getglobalNumMolecules(true, particleContainer, domainDecomp));
-	_snapshot.setTemperature(domain->getGlobalCurrentTemperature());
-	_snapshot.setRank(domainDecomp->getRank());
+#ifdef ENABLE_MPI
+	if (_numberOfBackups > 0) {
+		// the previous snapshot is the reference of the differences, the buddy ranks still keep it
+		snapshot.serialize(_sendBuffer, _compress ? &_snapshot : nullptr);
+		Log::global_log->info() << "InMemoryCheckpointWriter: sending " << _sendBuffer.size() << " bytes for "
+								<< snapshot.getNumberOfMolecules() << " molecules to " << _backedBy.size()
+								<< " buddy rank(s)" << std::endl;
+		std::vector<std::vector<char> const*> sendData(_backedBy.size(), &_sendBuffer);
+		_resilienceComm->postSnapshotExchange(_backedBy, _backedByTags, sendData, _backing, _backingTags,
+											  _recvBuffers);
+		_receivePending = true;
+	}
+#endif
+	std::swap(_snapshot, snapshot);
+}
 
+void InMemoryCheckpointing::finish(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp,
+								   Domain* domain) {
+	completeBackups();
 }
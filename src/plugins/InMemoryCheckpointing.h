@@ -11,17 +11,43 @@
 #include "PluginBase.h"
 #include "molecules/MoleculeForwardDeclaration.h"
 
+#include <array>
+#include <memory>
 #include <vector>
 
-class Snapshot;
+class Component;
+#ifdef ENABLE_MPI
+class ResilienceComm;
+#endif
 
+/**
+ * @brief Keeps checkpoints in memory instead of writing them to the file system.
+ *
+ * Every writefrequency steps the state of the local molecules is stored in a compact snapshot (structure of arrays of
+ * id, component, position, velocity, orientation, angular momentum, force and torque, sorted by id), so that the
+ * simulation can continue from it without recomputing the forces.
+ * With MPI the snapshot is replicated to buddy ranks, preferably residing on other nodes, using non-blocking sends
+ * which complete in the background during the following time steps.
+ * With compression enabled, only the XOR difference to the previous snapshot of the same molecules is sent, with its
+ * bytes reordered by significance and runs of zeros collapsed.
+ *
+ * \code{.xml}
+	<plugin name="InMemoryCheckpointing">
+		<writefrequency>5</writefrequency>             <!-- take a snapshot every 5 steps -->
+		<restartAtIteration>10</restartAtIteration>    <!-- restore the latest snapshot at this step (for development purposes) -->
+		<backups>1</backups>                           <!-- number of buddy ranks keeping a copy, 0 disables the replication -->
+		<compress>true</compress>                      <!-- send differences to the previous snapshot, compressed; default: false -->
+		<restoreFromBackup>false</restoreFromBackup>   <!-- restore from the copy of the buddy rank (for development purposes) -->
+	</plugin>
+   \endcode
+ */
 class InMemoryCheckpointing: public PluginBase {
 public:
-	InMemoryCheckpointing() {}
-	virtual ~InMemoryCheckpointing() {}
+	InMemoryCheckpointing();
+	virtual ~InMemoryCheckpointing();
 
 	void init(ParticleContainer* particleContainer,
-			DomainDecompBase* domainDecomp, Domain* domain) {}
+			DomainDecompBase* domainDecomp, Domain* domain);
 
     void readXML(XMLfileUnits& xmlconfig);
 
@@ -38,20 +64,20 @@ public:
             unsigned long simstep
     ){}
 
-    /**
-     * @brief writing takes place here
-     */
     void afterForces(
             ParticleContainer* particleContainer, DomainDecompBase* domainDecomp,
             unsigned long simstep
     ) {}
 
+    /**
+     * @brief writing takes place here
+     */
     void endStep(
             ParticleContainer* particleContainer, DomainDecompBase* domainDecomp,
             Domain* domain, unsigned long simstep);
 
     void finish(ParticleContainer* particleContainer,
-                              DomainDecompBase* domainDecomp, Domain* domain){}
+                              DomainDecompBase* domainDecomp, Domain* domain);
 
     std::string getPluginName() {
     	return std::string("InMemoryCheckpointing");
@@ -61,10 +87,41 @@ public:
 
 	class Snapshot {
 	public:
-		void addMolecule(const Molecule& m) {
-			_molecules.push_back(m);
+		//! values stored per molecule: r, v, q, D, F, M
+		enum Value {
+			RX = 0, RY, RZ, VX, VY, VZ, QW, QX, QY, QZ, DX, DY, DZ, FX, FY, FZ, MX, MY, MZ, NUM_VALUES
+		};
+
+		/**
+		 * @brief replace the molecules of the snapshot with the given ones, sorted by id
+		 */
+		void setMolecules(const std::vector<const Molecule*>& molecules);
+
+		/**
+		 * @brief create the molecules of the snapshot
+		 * @param components the components the molecules refer to
+		 */
+		std::vector<Molecule> getMolecules(std::vector<Component>& components) const;
+
+		size_t getNumberOfMolecules() const {
+			return _ids.size();
 		}
 
+		/**
+		 * @brief serialize the snapshot
+		 * @param buffer the snapshot is written to
+		 * @param reference if not nullptr, only the difference to the values of the molecules with the same id in the
+		 * reference snapshot (usually the previous one) is stored, compressed. The same reference has to be passed to
+		 * deserialize.
+		 */
+		void serialize(std::vector<char>& buffer, const Snapshot* reference) const;
+
+		/**
+		 * @brief reconstruct the snapshot from a buffer created by serialize
+		 * @param reference the reference passed to serialize, only used if the buffer is compressed
+		 */
+		void deserialize(const std::vector<char>& buffer, const Snapshot& reference);
+
 		double getCurrentTime() const {
 			return _currentTime;
 		}
@@ -105,30 +162,48 @@ public:
 			_rank = rank;
 		}
 
-		const std::vector<Molecule>& getMolecules() const {
-			return _molecules;
-		}
-
 		void clearMolecules() {
-			_molecules.clear();
+			_ids.clear();
+			_componentIds.clear();
+			_values.clear();
 		}
 
 	private:
-		std::vector<Molecule> _molecules;
-		double _currentTime;
-		int _rank; // who do these molecules belong to?
+		std::vector<unsigned long> _ids;
+		std::vector<unsigned int> _componentIds;
+		std::vector<double> _values; // value v of molecule i at _values[v * N + i]
+		double _currentTime = 0.;
+		int _rank = 0; // who do these molecules belong to?
 
 		// the following fields are maybe unnecessary, but leaving them here now for consistency to written headers in file-checkpoints
-		unsigned long _globalNumberOfMolecules;
-		double _temperature; // maybe not necessary; for consistency to currently written headers
-		std::array<double, 3> _boxDims; // maybe not necessary; for consistency to currently written headers
+		unsigned long _globalNumberOfMolecules = 0;
+		double _temperature = 0.; // maybe not necessary; for consistency to currently written headers
+		std::array<double, 3> _boxDims = {{0., 0., 0.}}; // maybe not necessary; for consistency to currently written headers
 
 	};
 
 private:
+	//! @brief complete pending replications and decode the received snapshots
+	void completeBackups();
+
 	Snapshot _snapshot; // make an std::vector eventually
 	unsigned long _writeFrequency;
 	unsigned long _restartAtIteration;
+	bool _compress;
+	bool _restoreFromBackup;
+	int _numberOfBackups;
+
+#ifdef ENABLE_MPI
+	std::unique_ptr<ResilienceComm> _resilienceComm;
+	std::vector<int> _backing; // ranks whose snapshots are kept here
+	std::vector<int> _backedBy; // ranks keeping the own snapshot
+	std::vector<int> _backingTags;
+	std::vector<int> _backedByTags;
+	std::vector<char> _sendBuffer; // serialized _snapshot, until it has been sent
+	std::vector<std::vector<char>> _recvBuffers;
+	bool _receivePending = false;
+	std::vector<Snapshot> _backups; // latest snapshots of the ranks in _backing
+#endif
 };
 
 #endif /* SRC_PLUGINS_INMEMORYCHECKPOINTING_H_ */
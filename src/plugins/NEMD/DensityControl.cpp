@@ -12,7 +12,9 @@
 #include <cstdint>
 #include <cstdlib>
 #include <iostream>
+#include <limits>
 #include <random>
+#include <sstream>
 #include <string>
 #include <utility>
 #include <vector>
@@ -77,6 +79,35 @@ void DensityControl::readXML(XMLfileUnits& xmlconfig) {
 	xmlconfig.getNodeValue("range/zmax", _range.zmax);
 	_range.volume = (_range.xmax - _range.xmin) * (_range.ymax - _range.ymin) * (_range.zmax - _range.zmin);
 
+	// phase
+	_phaseFilter.enabled = false;
+	_phaseFilter.phase = LocalDensity::VAPOR;
+	_phaseFilter.cutoff = 2.5;
+	_phaseFilter.density = 0.;
+	_phaseFilter.simstep = std::numeric_limits<uint64_t>::max();
+	std::string strPhase;
+	if (xmlconfig.getNodeValue("range/phase/type", strPhase)) {
+		if ("vapor" == strPhase) {
+			_phaseFilter.phase = LocalDensity::VAPOR;
+		} else if ("liquid" == strPhase) {
+			_phaseFilter.phase = LocalDensity::LIQUID;
+		} else {
+			std::ostringstream error_message;
+			error_message << "[DensityControl] Wrong value of element <range><phase><type>: " << strPhase
+						  << ", expected: vapor | liquid. Programm exit ..." << std::endl;
+			MARDYN_EXIT(error_message.str());
+		}
+		xmlconfig.getNodeValue("range/phase/cutoff", _phaseFilter.cutoff);
+		if (not xmlconfig.getNodeValue("range/phase/density", _phaseFilter.density)) {
+			std::ostringstream error_message;
+			error_message << "[DensityControl] Missing element <range><phase><density>. Programm exit ..." << std::endl;
+			MARDYN_EXIT(error_message.str());
+		}
+		_phaseFilter.enabled = true;
+		Log::global_log->info() << "[DensityControl] Controlling " << strPhase << " phase only, liquid if local density >= "
+						   << _phaseFilter.density << " within radius " << _phaseFilter.cutoff << std::endl;
+	}
+
 	// priority (Usually: Molecule size sorted in descending order)
 	const uint32_t numComponents = global_simulation->getEnsemble()->getComponents()->size();
 	std::string strPrio = "";
@@ -142,6 +173,15 @@ void DensityControl::beforeForces(ParticleContainer* particleContainer, DomainDe
 	this->controlDensity(particleContainer, domainDecomp, simstep);
 }
 
+void DensityControl::afterForces(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp,
+								 unsigned long simstep) {
+	const uint64_t nextStep = simstep + 1;
+	const bool control = nextStep >= _control.start && nextStep <= _control.stop && nextStep % _control.freq == 0;
+	if (_phaseFilter.enabled && (nextStep == _control.start || control)) {
+		this->updatePhase(particleContainer, domainDecomp, simstep, nextStep);
+	}
+}
+
 void DensityControl::controlDensity(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp,
 									unsigned long simstep) {
 	Domain* domain = global_simulation->getDomain();
@@ -172,6 +212,11 @@ void DensityControl::controlDensity(ParticleContainer* particleContainer, Domain
 
 	CommVar<std::vector<pacIDtype> > vec_pacID;
 
+	// phases are usually determined after the forces of the previous time step, otherwise without halo
+	if (_phaseFilter.enabled && _phaseFilter.simstep != simstep) {
+		this->updatePhase(particleContainer, domainDecomp, simstep, simstep);
+	}
+
 	auto begin = particleContainer->regionIterator(regionLowCorner, regionHighCorner,
 												   ParticleIterator::ONLY_INNER_AND_BOUNDARY);  // over all cell types
 	for (auto it = begin; it.isValid(); ++it) {
@@ -182,6 +227,7 @@ void DensityControl::controlDensity(ParticleContainer* particleContainer, Domain
 		if (not this->moleculeInsideRange(pos)) continue;
 
 		const uint64_t pid = it->getID();
+		if (not this->moleculeInsidePhase(pid)) continue;
 		const uint32_t cid_ub = it->componentid() + 1;
 		pacIDtype pacID;
 		pacID.pid = pid;
@@ -322,6 +368,7 @@ void DensityControl::controlDensity(ParticleContainer* particleContainer, Domain
 		pos[1] = it->r(1);
 		pos[2] = it->r(2);
 		if (not this->moleculeInsideRange(pos)) continue;
+		if (not this->moleculeInsidePhase(pid)) continue;
 
 		// swap components
 		std::vector<Component>* ptrComps = global_simulation->getEnsemble()->getComponents();
@@ -390,6 +437,8 @@ void DensityControl::controlDensity(ParticleContainer* particleContainer, Domain
 		}
 		particleContainer->addParticles(particles, true);
 	}
+	// components were exchanged, molecules deleted and added
+	domain->invalidateLocalDensities();
 }
 
 bool DensityControl::moleculeInsideRange(const std::array<double, 3>& r) {
@@ -397,6 +446,61 @@ bool DensityControl::moleculeInsideRange(const std::array<double, 3>& r) {
 		   r[2] >= _range.zmin && r[2] < _range.zmax;
 }
 
+void DensityControl::updatePhase(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp,
+								 uint64_t simstep, uint64_t validStep) {
+	double regionLowCorner[3] = {_range.xmin, _range.ymin, _range.zmin};
+	double regionHighCorner[3] = {_range.xmax, _range.ymax, _range.zmax};
+	const LocalDensity& localDensity =
+		global_simulation->getDomain()->getLocalDensity(particleContainer, _phaseFilter.cutoff, simstep);
+	localDensity.computeDensities(regionLowCorner, regionHighCorner, _phaseFilter.density, _phaseDensities);
+
+	// only molecules closer than the halo width to the subdomain boundary can move to another process until validStep
+	const bool shareBoundary = validStep != simstep;
+	double innerLowCorner[3], innerHighCorner[3];
+	for (unsigned d = 0; d < 3; d++) {
+		innerLowCorner[d] = particleContainer->getBoundingBoxMin(d) + particleContainer->getHaloWidthForDimension(d);
+		innerHighCorner[d] = particleContainer->getBoundingBoxMax(d) - particleContainer->getHaloWidthForDimension(d);
+	}
+	const auto& molecules = _phaseDensities.molecules;
+	const auto& phases = _phaseDensities.phases;
+	std::vector<uint64_t> pidsBoundary;
+	_phaseFilter.pids.clear();
+	for (size_t i = 0; i < molecules.size(); i++) {
+		if (phases[i] != _phaseFilter.phase) {
+			continue;
+		}
+		_phaseFilter.pids.push_back(molecules[i]->getID());
+		if (shareBoundary and not molecules[i]->inBox(innerLowCorner, innerHighCorner)) {
+			pidsBoundary.push_back(molecules[i]->getID());
+		}
+	}
+
+#ifdef ENABLE_MPI
+	if (shareBoundary) {
+		MPI_Comm comm = domainDecomp->getCommunicator();
+		const int numProcs = domainDecomp->getNumProcs();
+		int numBoundary = static_cast<int>(pidsBoundary.size());
+		std::vector<int> recvcounts(numProcs);
+		MPI_Allgather(&numBoundary, 1, MPI_INT, recvcounts.data(), 1, MPI_INT, comm);
+		std::vector<int> displs(numProcs, 0);
+		for (int i = 1; i < numProcs; i++) {
+			displs[i] = displs[i - 1] + recvcounts[i - 1];
+		}
+		std::vector<uint64_t> pidsBoundaryGlobal(displs.back() + recvcounts.back());
+		MPI_Allgatherv(pidsBoundary.data(), numBoundary, MPI_UINT64_T, pidsBoundaryGlobal.data(), recvcounts.data(),
+					   displs.data(), MPI_UINT64_T, comm);
+		_phaseFilter.pids.insert(_phaseFilter.pids.end(), pidsBoundaryGlobal.begin(), pidsBoundaryGlobal.end());
+	}
+#endif
+	std::sort(_phaseFilter.pids.begin(), _phaseFilter.pids.end());
+	_phaseFilter.pids.erase(std::unique(_phaseFilter.pids.begin(), _phaseFilter.pids.end()), _phaseFilter.pids.end());
+	_phaseFilter.simstep = validStep;
+}
+
+bool DensityControl::moleculeInsidePhase(uint64_t pid) const {
+	return not _phaseFilter.enabled or std::binary_search(_phaseFilter.pids.begin(), _phaseFilter.pids.end(), pid);
+}
+
 void DensityControl::updateBalanceVector(std::vector<int64_t>& vecBalance,
 										 std::map<int, std::vector<uint64_t> >& pidMap, uint32_t& numComponents) {
 	vecBalance[0] = 0;
@@ -459,6 +563,11 @@ void DensityControl::initTargetValues(ParticleContainer* particleContainer, Doma
 	}
 	std::array<double, 3> pos;
 
+	// called at the start time step, see controlDensity
+	if (_phaseFilter.enabled && _phaseFilter.simstep != _control.start) {
+		this->updatePhase(particleContainer, domainDecomp, _control.start, _control.start);
+	}
+
 	auto begin = particleContainer->regionIterator(regionLowCorner, regionHighCorner,
 												   ParticleIterator::ONLY_INNER_AND_BOUNDARY);  // over all cell types
 	for (auto it = begin; it.isValid(); ++it) {
@@ -468,6 +577,7 @@ void DensityControl::initTargetValues(ParticleContainer* particleContainer, Doma
 		pos[2] = it->r(2);
 
 		if (not this->moleculeInsideRange(pos)) continue;
+		if (not this->moleculeInsidePhase(it->getID())) continue;
 
 		const uint32_t cid_ub = it->componentid() + 1;
 		numMolecules.local.at(cid_ub)++;
@@ -21,6 +21,7 @@ class DensityControlTest;
 #endif
 
 #include "molecules/MoleculeForwardDeclaration.h"
+#include "particleContainer/LocalDensity.h"
 #include "particleContainer/ParticleContainer.h"
 #include "plugins/PluginBase.h"
 #include "utils/CommVar.h"
@@ -73,6 +74,11 @@ public:
 				<xmin>FLOAT</xmin> <xmax>FLOAT</xmax>  <!-- range x-axis -->
 				<ymin>FLOAT</ymin> <ymax>FLOAT</ymax>  <!-- range y-axis -->
 				<zmin>FLOAT</zmin> <zmax>FLOAT</zmax>  <!-- range z-axis -->
+				<phase>                        <!-- optional: only control molecules of one phase inside the range -->
+					<type>vapor</type>         <!-- vapor | liquid -->
+					<cutoff>FLOAT</cutoff>     <!-- radius of the local density, must not exceed the halo width -->
+					<density>FLOAT</density>   <!-- molecules with a local density of at least this value are liquid -->
+				</phase>
 			</range>
 			<targets>
 				<target cid="INT">   <!-- cid: component id of target particles -->
@@ -97,6 +103,13 @@ public:
 					  unsigned long /* simstep */
 					  ) override;
 
+	/**
+	 * Determines the phases of the molecules for the next time step if the phase filter is enabled, as the halo
+	 * is not present before the forces.
+	 */
+	void afterForces(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp,
+					 unsigned long simstep) override;
+
 	void endStep(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp, Domain* domain,
 				 unsigned long simstep) override {}
 
@@ -113,6 +126,19 @@ private:
 	 * @ return True, if molecule is located inside the specified range \p _range,		otherwise False.
 	 */
 	bool moleculeInsideRange(const std::array<double, 3>& r);
+	/**
+	 * Determines the local density of all molecules in the range and stores the IDs of the molecules of the phase
+	 * selected by \p _phaseFilter . If the IDs are used in a later time step \p validStep , the IDs of the molecules
+	 * near the subdomain boundary are shared with all processes, so molecules moving to another process before the
+	 * labels are used keep their phase. Collective operation in this case.
+	 */
+	void updatePhase(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp, uint64_t simstep,
+					 uint64_t validStep);
+	/**
+	 * @return True, if no phase was specified or the molecule with ID \p pid belongs to the specified phase as
+	 * determined by the last call of updatePhase(), otherwise False.
+	 */
+	bool moleculeInsidePhase(uint64_t pid) const;
 	/**
 	 * Establishes the specified target partial densities of all components, stored in \p _densityTarget . The
 	 * target total density is calculated by the sum of all target partial densities. If the target value for a
@@ -156,6 +182,14 @@ private:
 	struct Range {
 		double xmin, xmax, ymin, ymax, zmin, zmax, volume;
 	} _range;
+	struct PhaseFilter {
+		bool enabled;
+		LocalDensity::Phase phase;
+		double cutoff, density;
+		std::vector<uint64_t> pids;  // sorted IDs of the molecules of the phase
+		uint64_t simstep;            // time step the IDs were determined for
+	} _phaseFilter;
+	LocalDensity::Densities _phaseDensities;
 	std::vector<uint32_t> _vecPriority;
 #ifdef ENABLE_MPI
 	MPI_Datatype pacID_mpi_type;
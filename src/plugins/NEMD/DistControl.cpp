@@ -40,6 +40,8 @@ DistControl::DistControl()
 		_dVaporDensity(0.),
 		_nNeighbourValsSmooth(0),
 		_nNeighbourValsDerivate(0),
+		_dLiquidDensity(0.),
+		_dLocalDensityCutoff(0.),
 		_nMethodInit(DCIM_UNKNOWN),
 		_strFilenameInit("unknown"),
 		_nRestartTimestep(0),
@@ -226,11 +228,32 @@ void DistControl::readXML(XMLfileUnits& xmlconfig)
 			MARDYN_EXIT(error_message.str());
 		}
 	}
+	else if("localdensity" == strUpdateMethodType)
+	{
+		_nMethod = DCUM_LOCAL_DENSITY;
+		bool bInputIsValid = true;
+		uint32_t nTargetCompID = 0;
+		bInputIsValid = bInputIsValid && xmlconfig.getNodeValue("method/componentID", nTargetCompID);
+		_nTargetCompID = (uint16_t)(nTargetCompID);
+		bInputIsValid = bInputIsValid && xmlconfig.getNodeValue("method/density", _dLiquidDensity);
+		bInputIsValid = bInputIsValid && xmlconfig.getNodeValue("method/cutoff",  _dLocalDensityCutoff);
+		if(true == bInputIsValid)
+		{
+			Log::global_log->info() << "[DistControl] Update method 'localdensity', molecules with a local density >= " << _dLiquidDensity << " "
+					"within radius " << _dLocalDensityCutoff << " form the liquid phase, target componentID: " << _nTargetCompID << "." << std::endl;
+		}
+		else
+		{
+			std::ostringstream error_message;
+			error_message << "[DistControl] Missing elements \"method/componentID\", \"method/density\" or \"method/cutoff\"! Programm exit..." << std::endl;
+			MARDYN_EXIT(error_message.str());
+		}
+	}
 	else
 	{
 		std::ostringstream error_message;
 		error_message << "[DistControl] Wrong attribute \"method@type\", type = " << strUpdateMethodType << ", "
-				"expected: type=\"density|denderiv\"! Programm exit..." << std::endl;
+				"expected: type=\"density|denderiv|localdensity\"! Programm exit..." << std::endl;
 		MARDYN_EXIT(error_message.str());
 	}
 }
@@ -239,6 +262,9 @@ void DistControl::init(ParticleContainer *particleContainer,
 		  DomainDecompBase *domainDecomp, Domain *domain)
 {
 	this->Init(particleContainer);
+	// the halo is only present during init and after the forces
+	if(DCUM_LOCAL_DENSITY == _nMethod)
+		this->CalcLiquidProfile(particleContainer, global_simulation->getSimulationStep());
 	this->UpdatePositionsInit(particleContainer);
 	this->WriteHeader();
 	this->WriteData(0);
@@ -260,6 +286,14 @@ void DistControl::beforeForces(ParticleContainer* particleContainer, DomainDecom
 	this->WriteDataProfiles(simstep);
 }
 
+void DistControl::afterForces(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp,
+		unsigned long simstep)
+{
+	// local densities need the halo, which is gone by the time the positions are updated in beforeForces
+	if(DCUM_LOCAL_DENSITY == _nMethod && (simstep + 1) % _controlFreqs.update == 0)
+		this->CalcLiquidProfile(particleContainer, simstep);
+}
+
 void DistControl::PrepareSubdivision()
 {
 	Domain* domain = global_simulation->getDomain();
@@ -431,7 +465,43 @@ void DistControl::EstimateInterfaceMidpointsByForce()
 	_dInterfaceMidRight = _dMidpointPositions[nIndexMin];
 }
 
-void DistControl::EstimateInterfaceMidpoint()
+void DistControl::CalcLiquidProfile(ParticleContainer* particleContainer, unsigned long simstep)
+{
+	// local density of all molecules of the subdomain in one pass
+	double regionLowCorner[3], regionHighCorner[3];
+	for (unsigned d = 0; d < 3; d++) {
+		regionLowCorner[d] = particleContainer->getBoundingBoxMin(d);
+		regionHighCorner[d] = particleContainer->getBoundingBoxMax(d);
+	}
+	const LocalDensity& localDensity = global_simulation->getDomain()->getLocalDensity(particleContainer, _dLocalDensityCutoff, simstep);
+	localDensity.computeDensities(regionLowCorner, regionHighCorner, _dLiquidDensity, _localDensities, -1, static_cast<int>(_nTargetCompID) - 1);
+
+	// count liquid molecules per bin
+	std::vector<uint64_t> nNumLiquidLocal(_binParams.count, 0);
+	std::vector<uint64_t> nNumLiquidGlobal(_binParams.count, 0);
+	const auto& molecules = _localDensities.molecules;
+	const auto& phases = _localDensities.phases;
+	for(size_t i = 0; i < molecules.size(); ++i) {
+		if(LocalDensity::LIQUID != phases[i])
+			continue;
+		unsigned int nPosIndex = (unsigned int) floor(molecules[i]->r(1) * _binParams.invWidth);
+		if(nPosIndex < _binParams.count)
+			nNumLiquidLocal[nPosIndex]++;
+	}
+
+#ifdef ENABLE_MPI
+	MPI_Allreduce( nNumLiquidLocal.data(), nNumLiquidGlobal.data(), _binParams.count, MPI_UNSIGNED_LONG, MPI_SUM, MPI_COMM_WORLD);
+#else
+	nNumLiquidGlobal = nNumLiquidLocal;
+#endif
+
+	double dInvertShellVolume = 1. / _binParams.volume;
+	_dLiquidDensityProfile.resize(_binParams.count);
+	for(auto s=0u; s<_binParams.count; ++s)
+		_dLiquidDensityProfile[s] = nNumLiquidGlobal[s] * dInvertShellVolume;
+}
+
+void DistControl::EstimateInterfaceMidpoint(const std::vector<double>& dDensityProfile)
 {
 
 /*
@@ -477,15 +547,15 @@ void DistControl::EstimateInterfaceMidpoint()
 	// determine left midpoint
 	{
 		// determine min max
-		double dMin = _dDensityProfile.at(0);
-		double dMax = _dDensityProfile.at(0);
+		double dMin = dDensityProfile.at(0);
+		double dMax = dDensityProfile.at(0);
 
 //		int nIndexMin = 0;
 //		int nIndexMax = 0;
 
 		for(auto s=0u; s<_binParams.count/2; ++s)
 		{
-			 double dDensity = _dDensityProfile.at(s);
+			 double dDensity = dDensityProfile.at(s);
 
 			// find min
 			if(dDensity < dMin)
@@ -520,7 +590,7 @@ void DistControl::EstimateInterfaceMidpoint()
 
 		for(auto s=0u; s<_binParams.count; ++s)
 		{
-			if(_dDensityProfile.at(s) > ym)
+			if(dDensityProfile.at(s) > ym)
 			{
 				nIndexSlabGreater = s;
 				break;
@@ -538,8 +608,8 @@ void DistControl::EstimateInterfaceMidpoint()
 		//3. Interpolierte Distanz dInterpol berechnen, die von dem Slab mit N < Nsoll ausgehend in Richtung N > Nsoll gegangen werden muss
 		double dx12, dx1m, y1, y2, dy12, dy1m;
 
-		y1 = _dDensityProfile.at(nIndexSlabGreater-1);
-		y2 = _dDensityProfile.at(nIndexSlabGreater);
+		y1 = dDensityProfile.at(nIndexSlabGreater-1);
+		y2 = dDensityProfile.at(nIndexSlabGreater);
 
 		dy1m = ym - y1;
 
@@ -569,14 +639,14 @@ void DistControl::EstimateInterfaceMidpoint()
 	// determine right midpoint
 	{
 		// determine min max
-		double dMin = _dDensityProfile.at(0);
-		double dMax = _dDensityProfile.at(0);
+		double dMin = dDensityProfile.at(0);
+		double dMax = dDensityProfile.at(0);
 
 //		int nIndexMin = 0;
 //		int nIndexMax = 0;
 
 		for(auto s=_binParams.count/2; s < _binParams.count; ++s) {
-			double dDensity = _dDensityProfile.at(s);
+			double dDensity = dDensityProfile.at(s);
 
 			// find min
 			if(dDensity < dMin) {
@@ -607,7 +677,7 @@ void DistControl::EstimateInterfaceMidpoint()
 
 		for(int64_t s= static_cast<int64_t>(_binParams.count) - 1; s >= 0; --s)
 		{
-			if(_dDensityProfile.at(s) > ym)
+			if(dDensityProfile.at(s) > ym)
 			{
 				nIndexSlabGreater = s;
 				break;
@@ -623,8 +693,8 @@ void DistControl::EstimateInterfaceMidpoint()
 		//3. Interpolierte Distanz dInterpol berechnen, die von dem Slab mit N < Nsoll ausgehend in Richtung N > Nsoll gegangen werden muss
 		double dx12, dx1m, y1, y2, dy12, dy1m;
 
-		y1 = _dDensityProfile.at(nIndexSlabGreater+1);
-		y2 = _dDensityProfile.at(nIndexSlabGreater);
+		y1 = dDensityProfile.at(nIndexSlabGreater+1);
+		y2 = dDensityProfile.at(nIndexSlabGreater);
 
 		dy1m = ym - y1;
 
@@ -743,11 +813,14 @@ void DistControl::UpdatePositions(const uint64_t& simstep)
 	switch(_nMethod)
 	{
 	case DCUM_DENSITY_PROFILE:
-		this->EstimateInterfaceMidpoint();
+		this->EstimateInterfaceMidpoint(_dDensityProfile);
 		break;
 	case DCUM_DENSITY_PROFILE_DERIVATION:
 		this->EstimateInterfaceMidpointsByForce();
 		break;
+	case DCUM_LOCAL_DENSITY:
+		this->EstimateInterfaceMidpoint(_dLiquidDensityProfile);
+		break;
 	case DCUM_UNKNOWN:
 	default:
 		std::ostringstream error_message;
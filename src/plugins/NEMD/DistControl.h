@@ -18,6 +18,7 @@
 #include "utils/Region.h"
 #include "utils/CommVar.h"
 #include "molecules/MoleculeForwardDeclaration.h"
+#include "particleContainer/LocalDensity.h"
 
 
 class XMLfileUnits;
@@ -33,6 +34,7 @@ enum DistControlUpdateMethods
 	DCUM_DENSITY_PROFILE = 1,
 	DCUM_DENSITY_PROFILE_DERIVATION = 2,
 //	DCUM_FORCE_PROFILE = 3,
+	DCUM_LOCAL_DENSITY = 4,
 };
 
 enum DistControlInitMethods
@@ -72,11 +74,12 @@ public:
 				<file>../path/to/file/DistControl.dat</file>                 <!-- read values from specified file -->
 				<simstep>INT</simstep>                                       <!-- read from file in line simstep=INT -->
 			</init>
-			<method type="denderiv">   <!-- type="density"|denderiv" method to determine interface positions-->
+			<method type="denderiv">   <!-- type="density|denderiv|localdensity" method to determine interface positions-->
 				<componentID>INT</componentID>                            <!-- target component, 0:all components -->
 				<neighbourvals algorithm="smooth">INT</neighbourvals>     <!-- neighbour values used to smooth the profile -->
 				<neighbourvals algorithm="derivate">INT</neighbourvals>   <!-- neighbour values used to calculate derivation profile by linear regression -->
-				<density>FLOAT</density>                                  <!-- vapor density to identify vapor phase -->
+				<density>FLOAT</density>                                  <!-- vapor density to identify vapor phase; localdensity: liquid density threshold of the local density -->
+				<cutoff>FLOAT</cutoff>                                    <!-- localdensity: radius of the local density, must not exceed the halo width -->
 			</method>
 		</plugin>
 	   \endcode
@@ -95,7 +98,7 @@ public:
 	void siteWiseForces(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp,
 			unsigned long simstep) override {};
 	void afterForces(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp,
-			unsigned long simstep) override {}
+			unsigned long simstep) override;
 
 	void endStep(ParticleContainer *particleContainer,
 			DomainDecompBase *domainDecomp, Domain *domain,
@@ -142,7 +145,8 @@ public:
 private:
 	// place methods after the loop
 	void CalcProfiles();
-	void EstimateInterfaceMidpoint();  // called by UpdatePositions
+	void EstimateInterfaceMidpoint(const std::vector<double>& dDensityProfile);  // called by UpdatePositions
+	void CalcLiquidProfile(ParticleContainer* particleContainer, unsigned long simstep);  // density profile of molecules in the liquid phase, needs the halo
 	void EstimateInterfaceMidpointsByForce();
 	void ResetLocalValues();
 
@@ -179,6 +183,10 @@ private:
 	double _dVaporDensity;
 	uint16_t _nNeighbourValsSmooth;
 	uint16_t _nNeighbourValsDerivate;
+	double _dLiquidDensity;
+	double _dLocalDensityCutoff;
+	LocalDensity::Densities _localDensities;
+	std::vector<double> _dLiquidDensityProfile;
 
 	int _nMethodInit;
 	std::string _strFilenameInit;
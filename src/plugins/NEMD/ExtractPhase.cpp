@@ -14,6 +14,8 @@
 #include "utils/Logger.h"
 #include "utils/CommVar.h"
 
+#include <algorithm>
+
 ExtractPhase::ExtractPhase()
 {
 	_bDone.beforeForces = false;
@@ -127,81 +129,40 @@ void ExtractPhase::afterForces(ParticleContainer* particleContainer, DomainDecom
 		}
 	}
 
-	// Delete/mark particles of vapor particles inside the interface range
-	// ensure that we do not iterate over things outside of the container.
-	for (unsigned d = 0; d < 3; d++) {
-		regionLowCorner[d] = particleContainer->getBoundingBoxMin(d) - _densityTarget.cutoff;
-		regionHighCorner[d] = particleContainer->getBoundingBoxMax(d) + _densityTarget.cutoff;
-	}
-	regionLowCorner[1] = std::max(_interface.range.left - _densityTarget.cutoff, regionLowCorner[1]);
-	regionHighCorner[1] = std::min(_interface.range.right + _densityTarget.cutoff, regionHighCorner[1]);
-
-	double pi = 3.14159265;
-	double rad1 = _densityTarget.cutoff;
-	double rad2 = rad1*rad1;
-	double rad3 = rad1*rad2;
-	double hsv = 2./3.*pi*rad3;  // half sphere volume
-	double hsv_inv = 1. / hsv;  // reciprocal half sphere volume
-	std::vector<uint32_t> delList;  // list of particles to delete
-
-	// the author intends to copy this iterator
-	const auto begin = particleContainer->regionIterator(regionLowCorner, regionHighCorner,
-														 ParticleIterator::ALL_CELLS);  // over all cell types
-	for (auto it1 = begin; it1.isValid(); ++it1) {
-		uint32_t pid1 = it1->getID();
-		uint32_t numParticles_hsv = 0;
-		double r1[3];
-		r1[0] = it1->r(0);
-		r1[1] = it1->r(1);
-		r1[2] = it1->r(2);
-
-		// only consider particles within interface range
-		if(INTT_VAPOR_LIQUID == _interface.type && r1[1] > _interface.range.right)
-			continue;
-		if(INTT_LIQUID_VAPOR == _interface.type && r1[1] < _interface.range.left)
+	// Delete/mark particles of vapor particles inside the interface range, identified by the local density in the
+	// half sphere below them (y axis)
+	regionLowCorner[1] = _interface.range.left;
+	regionHighCorner[1] = _interface.range.right;
+	Domain* domain = global_simulation->getDomain();
+	const LocalDensity& localDensity = domain->getLocalDensity(particleContainer, _densityTarget.cutoff, simstep);
+	LocalDensity::Densities densities;
+	localDensity.computeDensities(regionLowCorner, regionHighCorner, _densityTarget.value * _densityTarget.percent,
+								  densities, 1);
+
+	const auto& molecules = densities.molecules;
+	const auto& phases = densities.phases;
+	std::vector<unsigned long> delList;  // IDs of particles to delete, sorted
+	Component* comp_new = nullptr;
+	if(_compChange.enabled)
+		comp_new = global_simulation->getEnsemble()->getComponent(_compChange.cid_ub-1);
+	for(size_t i = 0; i < molecules.size(); i++) {
+		if(LocalDensity::LIQUID == phases[i])
 			continue;
-
-		for(auto it2 = begin; it2.isValid(); ++it2) {
-			uint32_t pid2 = it2->getID();
-			if(pid2 == pid1)
-				continue;
-			double r2[3];
-			r2[0] = it2->r(0);
-			r2[1] = it2->r(1);
-			r2[2] = it2->r(2);
-			if(r2[1] > r1[1])
-				continue;
-			double diff[3];
-			diff[0] = r2[0] - r1[0];
-			diff[1] = r2[1] - r1[1];
-			diff[2] = r2[2] - r1[2];
-			double dist = diff[0]*diff[0] + diff[1]*diff[1] + diff[2]*diff[2];
-			if(dist <= rad2) {
-				numParticles_hsv++;
-			}
-		}
-		double rho = numParticles_hsv * hsv_inv;
-		if(rho < (_densityTarget.value * _densityTarget.percent) ) {
-			if(_compChange.enabled) {
-				Component* comp_new = global_simulation->getEnsemble()->getComponent(_compChange.cid_ub-1);
-				it1->setComponent(comp_new);
-			}
-			else
-				delList.push_back(pid1);
-		}
+		if(_compChange.enabled)
+			molecules[i]->setComponent(comp_new);
+		else
+			delList.push_back(molecules[i]->getID());
 	}
+	std::sort(delList.begin(), delList.end());
 
-	for(auto it = begin; it.isValid(); ++it) {
-		uint32_t pid1 = it->getID();
-		bool bFound = false;
-		for(auto pid2:delList) {
-			if(pid2 == pid1)
-				bFound = true;
-		}
-		if(bFound) {
-			particleContainer->deleteMolecule(it, false);
+	// halo copies included
+	if(not delList.empty()) {
+		for(auto it = particleContainer->iterator(ParticleIterator::ALL_CELLS); it.isValid(); ++it) {
+			if(std::binary_search(delList.begin(), delList.end(), it->getID()))
+				particleContainer->deleteMolecule(it, false);
 		}
 	}
+	domain->invalidateLocalDensities();
 
 	// Perform action only once
 	_bDone.afterForces = true;
@@ -9,6 +9,7 @@
 #define EXTRACT_PHASE_H_
 
 #include "plugins/PluginBase.h"
+#include "particleContainer/LocalDensity.h"
 #include <cstdint>
 
 class ParticleContainer;
@@ -35,7 +36,7 @@ public:
 			<density>
 				<value>FLOAT</value>        <!-- use this value as liquid density -->
 				<percent>FLOAT</percent>    <!-- percentage of liquid density identifies begin of vapor phase -->
-				<cutoff>FLOAT</cutoff>      <!-- cutoff radius for calculating local density -->
+				<cutoff>FLOAT</cutoff>      <!-- cutoff radius for calculating local density, must not exceed the halo width -->
 				<range>					    <!-- range in which liquid density is calculated -->
 					<left>DOUBLE</left>     <!-- left boundary -->
 					<right>DOUBLE</right>   <!-- right boundary -->
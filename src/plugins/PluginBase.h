@@ -145,6 +145,14 @@ public:
     /** @brief return the name of the plugin */
     virtual std::string getPluginName()  = 0;
 
+    /** @brief Whether the plugin needs the potential energy and virials (global and per molecule)
+     *  of the force calculation in time step simstep.
+     *
+     *  The force kernels skip their computation on steps no plugin and no ensemble needs them.
+     *  Plugins which do not override this method are assumed to need them on every step.
+     */
+    virtual bool requiresMacroscopicValues(unsigned long /* simstep */) { return true; }
+
 	/**
 	 * Register callbacks to callbackMap.
 	 * This allows to make functions of a plugin accessible to other plugins.
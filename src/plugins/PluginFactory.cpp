@@ -35,6 +35,7 @@
 #include "io/ResultWriter.h"
 #include "io/SysMonOutput.h"
 #include "io/TimerWriter.h"
+#include "io/VTKMoleculeWriter.h"
 #include "io/XyzWriter.h"
 
 // General plugins
@@ -44,6 +45,7 @@
 #include "plugins/Dropaligner.h"
 #include "plugins/ExamplePlugin.h"
 #include "plugins/FixRegion.h"
+#include "plugins/GreenKubo.h"
 #include "plugins/InMemoryCheckpointing.h"
 #include "plugins/LoadImbalanceThroughSleepPlugin.h"
 #include "plugins/MaxCheck.h"
@@ -70,7 +72,6 @@
 
 #ifdef VTK
 #include "io/vtk/VTKGridWriter.h"
-#include "io/vtk/VTKMoleculeWriter.h"
 #endif
 
 #ifdef MAMICO_COUPLING
@@ -101,6 +102,7 @@ void PluginFactory<PluginBase>::registerDefaultPlugins() {
 	REGISTER_PLUGIN(FixRegion);
 	REGISTER_PLUGIN(FlopRateWriter);
 	REGISTER_PLUGIN(GammaWriter);
+	REGISTER_PLUGIN(GreenKubo);
 	REGISTER_PLUGIN(HaloParticleWriter);
 	REGISTER_PLUGIN(InMemoryCheckpointing);
 	REGISTER_PLUGIN(SpatialProfile);
@@ -136,8 +138,8 @@ void PluginFactory<PluginBase>::registerDefaultPlugins() {
 	REGISTER_PLUGIN(WallPotential);
 	REGISTER_PLUGIN(XyzWriter);
 	REGISTER_PLUGIN(EnergyRAPL);
-#ifdef VTK
 	REGISTER_PLUGIN(VTKMoleculeWriter);
+#ifdef VTK
 #ifndef MARDYN_AUTOPAS
 	REGISTER_PLUGIN(VTKGridWriter);
 #endif
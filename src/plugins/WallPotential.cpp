@@ -5,9 +5,12 @@
 
 #include "WallPotential.h"
 
+#include <algorithm>
+#include <cmath>
 #include <sstream>
 
 #include "Simulation.h"
+#include "particleContainer/adapter/CellProcessor.h"
 #include "utils/mardyn_assert.h"
 
 /**
@@ -96,6 +99,55 @@ void WallPotential::readXML(XMLfileUnits &xmlconfig) {
 
 }
 
+void WallPotential::init(ParticleContainer *particleContainer, DomainDecompBase *domainDecomp, Domain *domain) {
+    Log::global_log -> debug() << "[WallPotential] Wall enabled" << std::endl;
+    _domain = domain;
+
+    initSiteParameters(global_simulation->getEnsemble()->getComponents());
+    _inTraversal = global_simulation->getCellProcessor()->addSiteField(this);
+    if(_inTraversal){
+        Log::global_log->info() << "[WallPotential] Wall is applied by the cell processor during the force calculation." << std::endl;
+    }
+}
+
+/**
+ * @brief copy the per component parameters to tables indexed by the LJ center look-up id
+ *
+ * @param components vector of components
+ */
+void WallPotential::initSiteParameters(const std::vector<Component> *components) {
+    unsigned numLJcenters = 0;
+    for (const auto& component : *components) {
+        numLJcenters += component.numLJcenters();
+    }
+    _ljcPrefactor.assign(numLJcenters, 0.0);
+    _ljcSig.assign(numLJcenters, 1.0);
+    _ljcShift.assign(numLJcenters, 0.0);
+
+    _siteReach = 0.0;
+    for (unsigned cid = 0; cid < components->size(); cid++) {
+        const Component& component = components->at(cid);
+        for (unsigned si = 0; si < component.numLJcenters(); si++) {
+            const LJcenter& ljc = component.ljcenter(si);
+            _siteReach = std::max(_siteReach, std::sqrt(ljc.rx() * ljc.rx() + ljc.ry() * ljc.ry() + ljc.rz() * ljc.rz()));
+
+            if (false == _bConsiderComponent.at(cid)) {
+                continue;
+            }
+            const unsigned id = component.getLookUpId() + si;
+            if (_potential == LJ9_3) {
+                _ljcPrefactor[id] = 4.0 * M_PI * _rhoW * _eps_wi[cid] * _sig3_wi[cid];
+                _ljcSig[id] = std::cbrt(_sig3_wi[cid]);
+                _ljcShift[id] = _uShift_9_3[cid];
+            } else {
+                _ljcPrefactor[id] = 2 * M_PI * _eps_wi[cid] * _rhoW * _sig2_wi[cid] * _delta;
+                _ljcSig[id] = _sig_wi[cid];
+                _ljcShift[id] = _uShift_10_4_3[cid];
+            }
+        }
+    }
+}
+
 /**
  * @brief initialize the LJ93 potential and calculate potential energy at cutoff
  *
@@ -187,7 +239,7 @@ void WallPotential::initializeLJ1043(const std::vector<Component> *components,
         double bracket = y + 0.61 * _delta;
         double bracket3 = bracket * bracket * bracket;
 
-        _uShift_10_4_3[i] = 2 * M_PI * _eps_wi[i] * _rhoW * _sig2_wi[i] * _delta * ((2 / 5) * (sig10_sf / y10) - sig4_sf / y4 - sig4_sf / (3 * _delta * bracket3));
+        _uShift_10_4_3[i] = 2 * M_PI * _eps_wi[i] * _rhoW * _sig2_wi[i] * _delta * ((2.0 / 5.0) * (sig10_sf / y10) - sig4_sf / y4 - sig4_sf / (3 * _delta * bracket3));
         _uPot_10_4_3[i] = 0.0;
     }
 }
@@ -256,7 +308,10 @@ void WallPotential::calcTSLJ_9_3(ParticleContainer *partContainer) {
     }
 
     double u_pot;
-    u_pot = _uPot_9_3[0] + _domain -> getLocalUpotCompSpecific();
+    u_pot = _domain -> getLocalUpotCompSpecific();
+    for(unsigned cid = 0; cid < _nc; cid++) {
+        u_pot += _uPot_9_3[cid];
+    }
     _domain->setLocalUpotCompSpecific(u_pot);
     for(unsigned cid = 0; cid < _nc; cid++) {
         _uPot_9_3[cid] = 0.0;
@@ -321,7 +376,7 @@ void WallPotential::calcTSLJ_10_4(ParticleContainer *partContainer) {
                     double term2 = sig4_wi / y4;
                     double term3 = sig4_wi / (3 * _delta * bracket3);
                     double preFactor = 2 * M_PI * _eps_wi[cid] * _rhoW * sig2_wi * _delta;
-                    _uPot_10_4_3[cid] += preFactor * ((2 / 5) * term1 - term2 - term3) - _uShift_10_4_3[cid];
+                    _uPot_10_4_3[cid] += preFactor * ((2.0 / 5.0) * term1 - term2 - term3) - _uShift_10_4_3[cid];
                     f[1] = preFactor * (4 * (sig10_wi / y11) - 4 * (sig4_wi / y5) - term3 * 3 / bracket);
                     if(ryRel < 0){
                         f[1] = -f[1];
@@ -338,8 +393,10 @@ void WallPotential::calcTSLJ_10_4(ParticleContainer *partContainer) {
     }
 
     double u_pot;
-    // TODO: sum up upot for all components
-    u_pot = _uPot_10_4_3[0] + _domain -> getLocalUpotCompSpecific();
+    u_pot = _domain -> getLocalUpotCompSpecific();
+    for(unsigned cid = 0; cid < _nc; cid++) {
+        u_pot += _uPot_10_4_3[cid];
+    }
     _domain->setLocalUpotCompSpecific(u_pot);
     for(unsigned cid = 0; cid < _nc; cid++) {
         _uPot_10_4_3[cid] = 0.0;
@@ -347,6 +404,18 @@ void WallPotential::calcTSLJ_10_4(ParticleContainer *partContainer) {
 }
 // end method calcTSLJ_10_4(...)
 
+/**
+ * @brief skip the wall in the traversal of step 0 like siteWiseForces does in the separate sweep
+ *
+ * @param particleContainer
+ * @param domainDecomp
+ * @param simstep
+ */
+void WallPotential::beforeForces(ParticleContainer *particleContainer, DomainDecompBase *domainDecomp,
+                                 unsigned long simstep) {
+    _skipStep = (simstep == 0);
+}
+
 /**
  * @brief gets called during the force update step. calls the appropriate calculation function.
  *
@@ -357,7 +426,7 @@ void WallPotential::calcTSLJ_10_4(ParticleContainer *partContainer) {
 void WallPotential::siteWiseForces(ParticleContainer *particleContainer, DomainDecompBase *domainDecomp,
                                    unsigned long simstep) {
 
-    if(simstep == 0){
+    if(simstep == 0 || _inTraversal){
         return;
     }
     if(_potential == LJ9_3){
@@ -372,3 +441,79 @@ void WallPotential::siteWiseForces(ParticleContainer *particleContainer, DomainD
     }
 
 }
+
+/**
+ * @brief whether LJ centers of molecules in the box can be within the cutoff of the wall, never in a skipped step
+ */
+bool WallPotential::reaches(const double low[3], const double high[3]) const {
+    if (_skipStep) {
+        return false;
+    }
+    return high[1] + _siteReach > _yOff - _dWidthHalf - _yc && low[1] - _siteReach < _yOff + _dWidthHalf + _yc;
+}
+
+/**
+ * @brief same as calcTSLJ_9_3 and calcTSLJ_10_4, but for the LJ centers of one cell given as SoA
+ *
+ * Written branch-free so that the loops vectorize, centers out of reach or of components not considered get zero force.
+ */
+double WallPotential::applyLJ(size_t num, const vcp_real_calc* const r[3], const vcp_ljc_id_t* ids,
+                              vcp_real_accum* const f[3]) const {
+    const vcp_real_calc* const ry = r[1];
+    vcp_real_accum* const fy = f[1];
+    const double* const prefactor = _ljcPrefactor.data();
+    const double* const sig = _ljcSig.data();
+    const double* const shift = _ljcShift.data();
+    const double yOff = _yOff, yLow = _yOff - _dWidthHalf, yHigh = _yOff + _dWidthHalf, yc = _yc, delta = _delta;
+
+    double upot = 0.0;
+    if(_potential == LJ9_3){
+#if defined(_OPENMP)
+        #pragma omp simd reduction(+:upot)
+#endif
+        for (size_t k = 0; k < num; ++k) {
+            const double ryRel = (ry[k] > yOff) ? (ry[k] - yHigh) : (ry[k] - yLow);
+            const double y = std::abs(ryRel);
+            const bool inRange = y < yc;
+            const double yInv = 1.0 / (inRange ? y : yc);
+            const double yInv3 = yInv * yInv * yInv;
+            const double yInv9 = yInv3 * yInv3 * yInv3;
+            const double sig3 = sig[ids[k]] * sig[ids[k]] * sig[ids[k]];
+            const double sig9 = sig3 * sig3 * sig3;
+            const double pre = prefactor[ids[k]];
+
+            const double fAbs = pre * (sig9 / 5.0 * yInv9 - sig3 / 2.0 * yInv3) * yInv;
+            const double u = pre * (sig9 / 45.0 * yInv9 - sig3 / 6.0 * yInv3) - shift[ids[k]];
+            fy[k] += inRange ? ((ryRel < 0) ? -fAbs : fAbs) : 0.0;
+            upot += inRange ? u : 0.0;
+        }
+    }
+    else {
+#if defined(_OPENMP)
+        #pragma omp simd reduction(+:upot)
+#endif
+        for (size_t k = 0; k < num; ++k) {
+            const double ryRel = (ry[k] > yOff) ? (ry[k] - yHigh) : (ry[k] - yLow);
+            const double y = std::abs(ryRel);
+            const bool inRange = y < yc;
+            const double yInv = 1.0 / (inRange ? y : yc);
+            const double yInv2 = yInv * yInv;
+            const double yInv4 = yInv2 * yInv2;
+            const double yInv10 = yInv4 * yInv4 * yInv2;
+            const double sig2 = sig[ids[k]] * sig[ids[k]];
+            const double sig4 = sig2 * sig2;
+            const double sig10 = sig4 * sig4 * sig2;
+            const double pre = prefactor[ids[k]];
+
+            const double bracket = (inRange ? y : yc) + 0.61 * delta;
+            const double term1 = sig10 * yInv10;
+            const double term2 = sig4 * yInv4;
+            const double term3 = sig4 / (3 * delta * bracket * bracket * bracket);
+            const double fAbs = pre * (4 * term1 * yInv - 4 * term2 * yInv - term3 * 3 / bracket);
+            const double u = pre * ((2.0 / 5.0) * term1 - term2 - term3) - shift[ids[k]];
+            fy[k] += inRange ? ((ryRel < 0) ? -fAbs : fAbs) : 0.0;
+            upot += inRange ? u : 0.0;
+        }
+    }
+    return upot;
+}
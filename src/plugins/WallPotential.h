@@ -10,6 +10,7 @@
 #include "particleContainer/ParticleContainer.h"
 #include "Domain.h"
 #include "parallel/DomainDecompBase.h"
+#include "particleContainer/adapter/ExternalSiteField.h"
 
 /**
  * @brief WallPotential exerts the force of a Lennard-Jones potential on the Lennard-Jones centers of particles
@@ -18,7 +19,9 @@
  * All significant values of these potentials can also be set there.<br>
  * Components to be considered can be set via <component> <br>
  * Their individual xi and eta can also be set in xml-format<br>
- * The Potential is applied once per simulation step in the Plugin::afterForces call<br>
+ * The Potential is applied once per simulation step. If the cell processor supports external fields
+ * (vectorized cell processor), it is evaluated for each cell within reach of the wall during the force
+ * calculation, otherwise in a separate sweep in the siteWiseForces call<br>
  *
  * Usage:<br>
  * <br>
@@ -39,7 +42,8 @@
     </plugin>
  * \endcode
  */
-class WallPotential  : public PluginBase{
+class WallPotential  : public PluginBase, public ExternalSiteField {
+    friend class WallPotentialTest;
 
 private:
     double _rhoW, _yc, _yOff, _delta;
@@ -63,6 +67,19 @@ private:
     };
     int _potential;
 
+    // parameters per LJ center look-up id for applyLJ, all zero for components not considered
+    std::vector<double> _ljcPrefactor;
+    std::vector<double> _ljcSig;
+    std::vector<double> _ljcShift;
+    // largest distance of an LJ center from the center of mass of its molecule
+    double _siteReach;
+    // whether the cell processor applies the wall during the force calculation
+    bool _inTraversal;
+    // whether the wall is left out of the force calculation of the current step, as siteWiseForces does at step 0
+    bool _skipStep;
+
+    void initSiteParameters(const std::vector<Component> *components);
+
 public:
     WallPotential(): _rhoW(0.),
                      _yc(0.),
@@ -78,7 +95,10 @@ public:
                      _uPot_10_4_3(nullptr),
                      _nc(0),
                      _dWidth(0.),
-                     _dWidthHalf(0.){
+                     _dWidthHalf(0.),
+                     _siteReach(0.),
+                     _inTraversal(false),
+                     _skipStep(false){
 
     };
     ~WallPotential(){
@@ -93,10 +113,7 @@ public:
         delete [] _uPot_10_4_3;
     };
 
-    void init(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp, Domain* domain) override {
-        Log::global_log -> debug() << "[WallPotential] Wall enabled" << std::endl;
-        _domain = domain;
-    }
+    void init(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp, Domain* domain) override;
 
     void readXML (XMLfileUnits& xmlconfig) override;
 
@@ -121,8 +138,16 @@ public:
 
     void calcTSLJ_10_4(ParticleContainer *partContainer);
 
+    void beforeForces(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp,
+                      unsigned long simstep) override;
+
     void siteWiseForces(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp,
                    unsigned long simstep) override;
+
+    bool reaches(const double low[3], const double high[3]) const override;
+
+    double applyLJ(size_t num, const vcp_real_calc* const r[3], const vcp_ljc_id_t* ids,
+                   vcp_real_accum* const f[3]) const override;
 };
 
 
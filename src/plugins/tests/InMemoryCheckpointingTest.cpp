@@ -0,0 +1,78 @@
+#include "InMemoryCheckpointingTest.h"
+
+#include "Simulation.h"
+#include "ensemble/EnsembleBase.h"
+#include "molecules/Molecule.h"
+#include "particleContainer/ParticleContainer.h"
+#include "utils/Testing.h"
+
+TEST_SUITE_REGISTRATION(InMemoryCheckpointingTest);
+
+InMemoryCheckpointingTest::InMemoryCheckpointingTest() {}
+
+InMemoryCheckpointingTest::~InMemoryCheckpointingTest() {}
+
+void InMemoryCheckpointingTest::testSnapshotSerialization() {
+	using Snapshot = InMemoryCheckpointing::Snapshot;
+
+	std::unique_ptr<ParticleContainer> container{initializeFromFile(ParticleContainerFactory::LinkedCell, "1clj-regular-12x12x12.inp", 1.0)};
+	std::vector<Component>& components = *global_simulation->getEnsemble()->getComponents();
+
+	std::vector<const Molecule*> molecules;
+	for (auto m = container->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); m.isValid(); ++m) {
+		molecules.push_back(&(*m));
+	}
+	Snapshot previous;
+	previous.setMolecules(molecules);
+
+	// move the molecules a bit and drop some of them, as between two snapshots
+	std::vector<Molecule> moved;
+	for (const Molecule* m : molecules) {
+		if (m->getID() % 7 == 0) {
+			continue;
+		}
+		moved.push_back(*m);
+		for (unsigned short d = 0; d < 3; ++d) {
+			moved.back().setr(d, m->r(d) + 1e-3 * (d + 1));
+			moved.back().setv(d, m->v(d) * 0.99);
+			moved.back().setF(d, 0.5 * d - m->r(d));
+		}
+	}
+	std::vector<const Molecule*> movedPointers;
+	for (auto it = moved.rbegin(); it != moved.rend(); ++it) {
+		movedPointers.push_back(&(*it));
+	}
+	Snapshot current;
+	current.setMolecules(movedPointers);
+	current.setCurrentTime(1.25);
+	current.setGlobalNumberOfMolecules(moved.size());
+	current.setRank(3);
+
+	for (const Snapshot* reference : std::vector<const Snapshot*>{nullptr, &previous}) {
+		std::vector<char> buffer;
+		current.serialize(buffer, reference);
+		Snapshot restored;
+		restored.deserialize(buffer, previous);
+
+		ASSERT_EQUAL(1.25, restored.getCurrentTime());
+		ASSERT_EQUAL(moved.size(), restored.getGlobalNumberOfMolecules());
+		ASSERT_EQUAL(3, restored.getRank());
+		std::vector<Molecule> expected = current.getMolecules(components);
+		std::vector<Molecule> actual = restored.getMolecules(components);
+		ASSERT_EQUAL(moved.size(), actual.size());
+		for (size_t i = 0; i < actual.size(); ++i) {
+			ASSERT_EQUAL(expected[i].getID(), actual[i].getID());
+			ASSERT_EQUAL(expected[i].componentid(), actual[i].componentid());
+			if (i > 0) {
+				ASSERT_TRUE(actual[i - 1].getID() < actual[i].getID());
+			}
+			for (unsigned short d = 0; d < 3; ++d) {
+				ASSERT_EQUAL(expected[i].r(d), actual[i].r(d));
+				ASSERT_EQUAL(expected[i].v(d), actual[i].v(d));
+				ASSERT_EQUAL(expected[i].F(d), actual[i].F(d));
+				ASSERT_EQUAL(expected[i].D(d), actual[i].D(d));
+			}
+			ASSERT_EQUAL(expected[i].q().qw(), actual[i].q().qw());
+		}
+	}
+}
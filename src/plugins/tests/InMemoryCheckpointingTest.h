@@ -0,0 +1,24 @@
+#pragma once
+
+#include "utils/TestWithSimulationSetup.h"
+#include "utils/Testing.h"
+#include "plugins/InMemoryCheckpointing.h"
+
+// Test of the snapshots of the InMemoryCheckpointing plugin
+// Serialized snapshots, plain and as compressed difference to a previous snapshot, have to reproduce all values exactly
+
+class InMemoryCheckpointingTest : public utils::TestWithSimulationSetup {
+
+	TEST_SUITE(InMemoryCheckpointingTest);
+	TEST_METHOD(testSnapshotSerialization);
+	TEST_SUITE_END;
+
+public:
+
+	InMemoryCheckpointingTest();
+
+	virtual ~InMemoryCheckpointingTest();
+
+	void testSnapshotSerialization();
+
+};
@@ -0,0 +1,108 @@
+#include "WallPotentialTest.h"
+
+#include "Simulation.h"
+#include "ensemble/EnsembleBase.h"
+#include "particleContainer/adapter/VectorizedCellProcessor.h"
+
+TEST_SUITE_REGISTRATION(WallPotentialTest);
+
+WallPotentialTest::WallPotentialTest() {}
+
+WallPotentialTest::~WallPotentialTest() {}
+
+void WallPotentialTest::testFieldInTraversal() {
+    if (_domainDecomposition->getNumProcs() != 1) {
+        test_log->info() << "WallPotentialTest::testFieldInTraversal() not executed (rerun with only 1 Process!)" << std::endl;
+        return;
+    }
+
+#if defined(MARDYN_DPDP)
+    const double tolerance = 1e-10;
+#else
+    const double tolerance = 1e-4;
+#endif
+
+    // molecules at y = 1 and y = 11, wall surfaces at y = 5 and y = 7
+    const char* filename = "2clj-regular.inp";
+    const double cutoff = 3.5;
+
+    // walls of the components of the current simulation setup
+    auto createWall = [this](int potential) {
+        std::vector<Component>* components = global_simulation->getEnsemble()->getComponents();
+        std::vector<double> xi(components->size(), 1.0);
+        std::vector<double> eta(components->size(), 1.0);
+        std::unique_ptr<WallPotential> wall{new WallPotential()};
+        wall->_domain = _domain;
+        wall->_bConsiderComponent.assign(components->size(), true);
+        wall->_dWidth = 2.0;
+        wall->_dWidthHalf = 1.0;
+        wall->_delta = 1.0;
+        if (potential == 93) {
+            wall->_potential = WallPotential::LJ9_3;
+            wall->initializeLJ93(components, 1.0, 1.0, 1.0, xi, eta, 6.0, 5.0);
+        } else {
+            wall->_potential = WallPotential::LJ10_4;
+            wall->initializeLJ1043(components, 1.0, 1.0, 1.0, xi, eta, 6.0, 5.0);
+        }
+        wall->initSiteParameters(components);
+        return wall;
+    };
+
+    for (int potential : {93, 104}) {
+        // reading the same file again adds its LJ centers to the existing components, so start from a fresh setup
+        tearDown(); setUp();
+
+        std::unique_ptr<ParticleContainer> sweepContainer{
+            initializeFromFile(ParticleContainerFactory::LinkedCell, filename, cutoff)};
+        std::unique_ptr<WallPotential> sweepWall = createWall(potential);
+
+        VectorizedCellProcessor sweepCellProcessor(*_domain, cutoff, cutoff);
+        _domain->setLocalUpotCompSpecific(0.0);
+        sweepContainer->traverseCells(sweepCellProcessor);
+        if (potential == 93) {
+            sweepWall->calcTSLJ_9_3(sweepContainer.get());
+        } else {
+            sweepWall->calcTSLJ_10_4(sweepContainer.get());
+        }
+        const double sweepUpot = _domain->getLocalUpotCompSpecific();
+        // the components are freed by the next setup, so sum up the molecule forces now
+        for (auto m = sweepContainer->iterator(ParticleIterator::ALL_CELLS); m.isValid(); ++m) {
+            m->calcFM();
+        }
+
+        tearDown(); setUp();
+
+        std::unique_ptr<ParticleContainer> traversalContainer{
+            initializeFromFile(ParticleContainerFactory::LinkedCell, filename, cutoff)};
+        std::unique_ptr<WallPotential> traversalWall = createWall(potential);
+
+        VectorizedCellProcessor traversalCellProcessor(*_domain, cutoff, cutoff);
+        ASSERT_TRUE(traversalCellProcessor.addSiteField(traversalWall.get()));
+        _domain->setLocalUpotCompSpecific(0.0);
+        traversalContainer->traverseCells(traversalCellProcessor);
+        const double traversalUpot = _domain->getLocalUpotCompSpecific();
+
+        ASSERT_TRUE(sweepUpot != 0.0);
+        ASSERT_DOUBLES_EQUAL(sweepUpot, traversalUpot, tolerance * std::abs(sweepUpot));
+
+        auto sweepMolecule = sweepContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY);
+        auto traversalMolecule = traversalContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY);
+        for (; sweepMolecule.isValid(); ++sweepMolecule, ++traversalMolecule) {
+            ASSERT_TRUE(traversalMolecule.isValid());
+            ASSERT_EQUAL(sweepMolecule->getID(), traversalMolecule->getID());
+            traversalMolecule->calcFM();
+            for (int d = 0; d < 3; d++) {
+                ASSERT_DOUBLES_EQUAL(sweepMolecule->F(d), traversalMolecule->F(d), tolerance);
+            }
+        }
+        ASSERT_TRUE(not traversalMolecule.isValid());
+
+        // like the separate sweep, the traversal leaves the wall out at step 0
+        const double low[3] = {0.0, 0.0, 0.0};
+        const double high[3] = {17.5, 17.5, 17.5};
+        traversalWall->beforeForces(traversalContainer.get(), _domainDecomposition, 0);
+        ASSERT_TRUE(not traversalWall->reaches(low, high));
+        traversalWall->beforeForces(traversalContainer.get(), _domainDecomposition, 1);
+        ASSERT_TRUE(traversalWall->reaches(low, high));
+    }
+}
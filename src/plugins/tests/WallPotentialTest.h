@@ -0,0 +1,27 @@
+#ifndef WALLPOTENTIALTEST_H
+#define WALLPOTENTIALTEST_H
+
+#include "utils/TestWithSimulationSetup.h"
+#include "plugins/WallPotential.h"
+
+class WallPotentialTest : public utils::TestWithSimulationSetup {
+
+    TEST_SUITE(WallPotentialTest);
+    TEST_METHOD(testFieldInTraversal);
+    TEST_SUITE_END;
+
+public:
+
+    WallPotentialTest();
+
+    virtual ~WallPotentialTest();
+
+    /**
+     * Apply the 9-3 and the 10-4 wall once in a separate sweep and once during the traversal of the
+     * VectorizedCellProcessor, forces and wall energy have to agree.
+     */
+    void testFieldInTraversal();
+
+};
+
+#endif //WALLPOTENTIALTEST_H
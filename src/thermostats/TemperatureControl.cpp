@@ -50,10 +50,10 @@ ControlRegionT::ControlRegionT(TemperatureControl* const parent)
 	  _nuAndersen(0.0),
 	  _timestep(0.0),
 	  _nuDt(0.0),
-	  _rand(Random()),
 	  _bIsObserver(false) {
 	// ID
 	_nID = ++_nStaticID;
+	_rand = CounterBasedRandom(_nID, RNG_PURPOSE_ANDERSEN);
 }
 
 ControlRegionT::~ControlRegionT() { delete _accumulator; }
@@ -364,7 +364,7 @@ void ControlRegionT::MeasureKineticEnergy(Molecule* mol, DomainDecompBase* /*dom
 	localTV._numRotationalDOF += mol->component()->getRotationalDegreesOfFreedom();
 }
 
-void ControlRegionT::ControlTemperature(Molecule* mol) {
+void ControlRegionT::ControlTemperature(Molecule* mol, unsigned long simstep) {
 	// check componentID
 	if (mol->componentid() + 1 != _nTargetComponentID &&
 		0 != _nTargetComponentID)  // program intern componentID starts with 0
@@ -410,12 +410,16 @@ void ControlRegionT::ControlTemperature(Molecule* mol) {
 		mol->scale_D(Dcorr);
 	} else if (_localMethod == Andersen) {
 		double stdDevTrans, stdDevRot;
-		if (_rand.rnd() < _nuDt) {
+		double collision;
+		_rand.uniform(mol->getID(), simstep, &collision, 1);
+		if (collision < _nuDt) {
+			double normal[6];
+			_rand.normal(mol->getID(), simstep, normal, 6, 1);
 			stdDevTrans = sqrt(_dTargetTemperature / mol->mass());
 			for (unsigned short d = 0; d < 3; d++) {
 				stdDevRot = sqrt(_dTargetTemperature * mol->getI(d));
-				mol->setv(d, _rand.gaussDeviate(stdDevTrans));
-				mol->setD(d, _rand.gaussDeviate(stdDevRot));
+				mol->setv(d, stdDevTrans * normal[2 * d]);
+				mol->setD(d, stdDevRot * normal[2 * d + 1]);
 			}
 		}
 	} else {
@@ -682,7 +686,7 @@ void TemperatureControl::ControlTemperature(Molecule* mol, unsigned long simstep
 	if (simstep <= this->GetStart() || simstep > this->GetStop()) return;
 
 	for (auto&& reg : _vecControlRegions) {
-		reg->ControlTemperature(mol);
+		reg->ControlTemperature(mol, simstep);
 	}
 }
 
@@ -17,8 +17,8 @@
 #include "molecules/Molecule.h"
 #include "plugins/NEMD/DistControl.h"
 #include "utils/CommVar.h"
+#include "utils/CounterBasedRandom.h"
 #include "utils/ObserverBase.h"
-#include "utils/Random.h"
 #include "utils/Region.h"
 
 class DistControl;
@@ -85,7 +85,7 @@ public:
 	void VelocityScalingInit(XMLfileUnits& xmlconfig, std::string strDirections);
 	void CalcGlobalValues(DomainDecompBase* domainDecomp);
 	void MeasureKineticEnergy(Molecule* mol, DomainDecompBase* domainDecomp);
-	void ControlTemperature(Molecule* mol);
+	void ControlTemperature(Molecule* mol, unsigned long simstep);
 	void ResetLocalValues();
 
 	// beta log file
@@ -139,7 +139,7 @@ private:
 	double _nuAndersen;
 	double _timestep;
 	double _nuDt;
-	Random _rand;
+	CounterBasedRandom _rand;  //!< keyed by molecule ID and simstep, so the Andersen thermostat can run multi-threaded
 
 	bool _bIsObserver;
 
@@ -15,6 +15,7 @@
 #include <vector>
 #include "utils/mardyn_assert.h"
 #include "AlignedAllocator.h"
+#include "PoolAllocator.h"
 
 #define CACHE_LINE_SIZE 64
 
@@ -67,6 +68,7 @@
 /**
  * \brief An aligned array.
  * \details Has pointer to T semantics. Internal size is rounded up to fill up full cache-lines.
+ * The storage is taken from the MemoryPool and accounted to its SoA caches.
  * \tparam T The type of the array elements.
  * \tparam alignment The alignment restriction. Must be a power of 2, should not be 8.
  * \author Johannes Heckl, Nikola Tchipev, Micha Mueller
@@ -234,7 +236,7 @@ public:
 
 protected:
 
-	std::vector<T, AlignedAllocator<T, alignment>> _vec;
+	std::vector<T, PoolAllocator<T, MemoryPool::SOA, alignment>> _vec;
 
 };
 
@@ -0,0 +1,153 @@
+#ifndef COUNTERBASEDRANDOM_H_
+#define COUNTERBASEDRANDOM_H_
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+
+/** Purposes for which random numbers are drawn, every purpose uses an independent stream. */
+enum RandomPurpose : uint32_t {
+	RNG_PURPOSE_DEFAULT = 0,
+	RNG_PURPOSE_LATTICE_OCCUPANCY = 1,
+	RNG_PURPOSE_VELOCITY = 2,
+	RNG_PURPOSE_ANDERSEN = 3,
+	RNG_PURPOSE_CAVITY = 4,
+};
+
+/** @brief Counter-based random number generator (Philox4x32-10)
+ *
+ * Instead of advancing an internal state, every block of random numbers is a pure function of
+ * a key (seed, purpose) and a counter (e.g. molecule id and time step). The numbers drawn for an
+ * object therefore do not depend on the order of the calls, the number of threads or the domain
+ * decomposition, and the generator can be used concurrently from several threads.
+ *
+ * J. K. Salmon et al., Parallel random numbers: as easy as 1, 2, 3, SC'11.
+ */
+class CounterBasedRandom {
+public:
+	typedef std::array<uint32_t, 4> Block;
+
+	CounterBasedRandom(uint64_t seed = 0, uint32_t purpose = RNG_PURPOSE_DEFAULT) {
+		_key[0] = static_cast<uint32_t>(seed);
+		_key[1] = static_cast<uint32_t>(seed >> 32) ^ (purpose * 0x9E3779B9u);
+	}
+
+	/** @brief Philox4x32-10 applied to the counter */
+	Block block(Block counter) const {
+		philox(counter[0], counter[1], counter[2], counter[3]);
+		return counter;
+	}
+
+	/** @brief Block number blockIndex of the stream belonging to (id, step) */
+	Block block(uint64_t id, uint32_t step, uint32_t blockIndex = 0) const {
+		return block(Block{static_cast<uint32_t>(id), static_cast<uint32_t>(id >> 32), step, blockIndex});
+	}
+
+	/** @brief Fill out[0..n) with uniform numbers in (0,1) of the stream belonging to (id, step)
+	 *
+	 * firstBlock allows to draw further numbers of the same stream, every block yields two numbers.
+	 */
+	void uniform(uint64_t id, uint32_t step, double* out, unsigned n, uint32_t firstBlock = 0) const {
+		for (unsigned i = 0; i < n; i += 2) {
+			const Block b = block(id, step, firstBlock + i / 2);
+			out[i] = toUniform(b[0], b[1]);
+			if (i + 1 < n) {
+				out[i + 1] = toUniform(b[2], b[3]);
+			}
+		}
+	}
+
+	/** @brief Fill out[0..n) with standard normal numbers of the stream belonging to (id, step) (Box-Muller) */
+	void normal(uint64_t id, uint32_t step, double* out, unsigned n, uint32_t firstBlock = 0) const {
+		for (unsigned i = 0; i < n; i += 2) {
+			const Block b = block(id, step, firstBlock + i / 2);
+			const double radius = std::sqrt(-2.0 * std::log(toUniform(b[0], b[1])));
+			const double phi = 2.0 * M_PI * toUniform(b[2], b[3]);
+			out[i] = radius * std::cos(phi);
+			if (i + 1 < n) {
+				out[i + 1] = radius * std::sin(phi);
+			}
+		}
+	}
+
+	/** @brief Uniform numbers of the streams of many ids at once
+	 *
+	 * Gives the same numbers as uniform() called for every id, number j of ids[i] is stored in out[j * numIds + i].
+	 * The ids are processed in independent lanes, so that the Philox rounds are vectorized.
+	 */
+	void uniformBulk(const uint64_t* ids, size_t numIds, uint32_t step, double* out, unsigned n) const {
+		for (unsigned j = 0; j < n; j += 2) {
+			forEachBlock(ids, numIds, step, j / 2, [&](size_t i, uint32_t b0, uint32_t b1, uint32_t b2, uint32_t b3) {
+				out[j * numIds + i] = toUniform(b0, b1);
+				if (j + 1 < n) {
+					out[(j + 1) * numIds + i] = toUniform(b2, b3);
+				}
+			});
+		}
+	}
+
+	/** @brief Standard normal numbers of the streams of many ids at once, layout as for uniformBulk() */
+	void normalBulk(const uint64_t* ids, size_t numIds, uint32_t step, double* out, unsigned n) const {
+		for (unsigned j = 0; j < n; j += 2) {
+			forEachBlock(ids, numIds, step, j / 2, [&](size_t i, uint32_t b0, uint32_t b1, uint32_t b2, uint32_t b3) {
+				const double radius = std::sqrt(-2.0 * std::log(toUniform(b0, b1)));
+				const double phi = 2.0 * M_PI * toUniform(b2, b3);
+				out[j * numIds + i] = radius * std::cos(phi);
+				if (j + 1 < n) {
+					out[(j + 1) * numIds + i] = radius * std::sin(phi);
+				}
+			});
+		}
+	}
+
+	/** @brief Uniform double in (0,1) from 53 bits of two 32 bit numbers */
+	static double toUniform(uint32_t hi, uint32_t lo) {
+		const uint64_t bits = (static_cast<uint64_t>(hi) << 21) ^ (lo >> 11);
+		return (static_cast<double>(bits & ((uint64_t(1) << 53) - 1)) + 0.5) * (1.0 / 9007199254740992.0);
+	}
+
+private:
+	/** @brief the ten Philox rounds on a counter given as four words */
+	inline void philox(uint32_t& c0, uint32_t& c1, uint32_t& c2, uint32_t& c3) const {
+		uint32_t k0 = _key[0];
+		uint32_t k1 = _key[1];
+		for (int round = 0; round < 10; ++round) {
+			const uint64_t p0 = static_cast<uint64_t>(0xD2511F53u) * c0;
+			const uint64_t p1 = static_cast<uint64_t>(0xCD9E8D57u) * c2;
+			c0 = static_cast<uint32_t>(p1 >> 32) ^ c1 ^ k0;
+			c1 = static_cast<uint32_t>(p1);
+			c2 = static_cast<uint32_t>(p0 >> 32) ^ c3 ^ k1;
+			c3 = static_cast<uint32_t>(p0);
+			k0 += 0x9E3779B9u;
+			k1 += 0xBB67AE85u;
+		}
+	}
+
+	/** @brief Compute block blockIndex of (ids[i], step) for all i in chunks of independent lanes and pass it to f */
+	template<typename F>
+	void forEachBlock(const uint64_t* ids, size_t numIds, uint32_t step, uint32_t blockIndex, F f) const {
+		constexpr size_t chunkSize = 64;
+		uint32_t c0[chunkSize], c1[chunkSize], c2[chunkSize], c3[chunkSize];
+		for (size_t start = 0; start < numIds; start += chunkSize) {
+			const size_t num = std::min(chunkSize, numIds - start);
+			#pragma omp simd
+			for (size_t l = 0; l < num; ++l) {
+				c0[l] = static_cast<uint32_t>(ids[start + l]);
+				c1[l] = static_cast<uint32_t>(ids[start + l] >> 32);
+				c2[l] = step;
+				c3[l] = blockIndex;
+				philox(c0[l], c1[l], c2[l], c3[l]);
+			}
+			for (size_t l = 0; l < num; ++l) {
+				f(start + l, c0[l], c1[l], c2[l], c3[l]);
+			}
+		}
+	}
+
+	uint32_t _key[2];
+};
+
+#endif /* COUNTERBASEDRANDOM_H_ */
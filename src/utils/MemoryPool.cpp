@@ -0,0 +1,211 @@
+/*
+ * MemoryPool.cpp
+ */
+
+#include "MemoryPool.h"
+
+#include <cstdlib>
+#include <new>
+#include <sstream>
+
+#include "utils/Logger.h"
+
+namespace {
+// trivially destructible, so it can still be queried after the cache of the thread was destroyed
+thread_local bool threadCacheDestroyed = false;
+}
+
+MemoryPool::MemoryPool() :
+		_bytesCached(0), _maxCachedBytesPerThread(size_t(32) << 20), _sharedCachedBytes(0) {
+	for (auto& bytes : _bytesInUse) {
+		bytes = 0;
+	}
+}
+
+MemoryPool& MemoryPool::instance() {
+	// never destroyed: containers with static storage duration may still return blocks at exit
+	static MemoryPool* pool = new MemoryPool();
+	return *pool;
+}
+
+MemoryProfilable** MemoryPool::profilable() {
+	static MemoryProfilable* pool = &instance();
+	return &pool;
+}
+
+int MemoryPool::sizeClass(size_t numBytes) {
+	if (numBytes <= (size_t(1) << MIN_EXPONENT)) {
+		return 0;
+	}
+	const size_t m = numBytes - 1;
+	int e = MIN_EXPONENT;
+	while ((m >> (e + 1)) != 0) {
+		++e;
+	}
+	if (e >= MAX_EXPONENT) {
+		return -1;
+	}
+	const size_t k = (m - (size_t(1) << e)) >> (e - 2);
+	return 1 + 4 * (e - MIN_EXPONENT) + static_cast<int>(k);
+}
+
+size_t MemoryPool::sizeOfClass(int sizeClass) {
+	if (sizeClass == 0) {
+		return size_t(1) << MIN_EXPONENT;
+	}
+	const int e = MIN_EXPONENT + (sizeClass - 1) / 4;
+	const size_t k = (sizeClass - 1) % 4;
+	return (size_t(1) << e) + ((k + 1) << (e - 2));
+}
+
+MemoryPool::ThreadCache::~ThreadCache() {
+	{
+		std::lock_guard<std::mutex> lock(_pool._sharedCacheMutex);
+		for (int c = 0; c < NUM_CLASSES; ++c) {
+			auto& shared = _pool._sharedFreeBlocks[c];
+			shared.insert(shared.end(), _freeBlocks[c].begin(), _freeBlocks[c].end());
+		}
+		_pool._sharedCachedBytes.fetch_add(_cachedBytes, std::memory_order_relaxed);
+	}
+	// blocks returned later during thread exit, e.g. by other thread_local objects, go to the heap
+	threadCacheDestroyed = true;
+}
+
+MemoryPool::ThreadCache* MemoryPool::threadCache() {
+	if (threadCacheDestroyed) {
+		return nullptr;
+	}
+	thread_local ThreadCache cache(*this);
+	return &cache;
+}
+
+void* MemoryPool::takeFromSharedCache(int sizeClass) {
+	if (_sharedCachedBytes.load(std::memory_order_relaxed) == 0) {
+		return nullptr;
+	}
+	std::lock_guard<std::mutex> lock(_sharedCacheMutex);
+	std::vector<void*>& freeBlocks = _sharedFreeBlocks[sizeClass];
+	if (freeBlocks.empty()) {
+		return nullptr;
+	}
+	void* ptr = freeBlocks.back();
+	freeBlocks.pop_back();
+	_sharedCachedBytes.fetch_sub(sizeOfClass(sizeClass), std::memory_order_relaxed);
+	return ptr;
+}
+
+void* MemoryPool::heapAllocate(size_t numBytes, size_t alignment) {
+	void* ptr = nullptr;
+	if (posix_memalign(&ptr, alignment < sizeof(void*) ? sizeof(void*) : alignment, numBytes) != 0) {
+		throw std::bad_alloc();
+	}
+	return ptr;
+}
+
+void MemoryPool::heapFree(void* ptr) {
+	free(ptr);
+}
+
+void* MemoryPool::allocate(size_t numBytes, size_t alignment, Subsystem subsystem) {
+	if (numBytes == 0) {
+		numBytes = 1;
+	}
+	const int c = alignment > CACHE_LINE_SIZE ? -1 : sizeClass(numBytes);
+	if (c < 0) {
+		_bytesInUse[subsystem].fetch_add(numBytes, std::memory_order_relaxed);
+		return heapAllocate(numBytes, alignment);
+	}
+	const size_t blockSize = sizeOfClass(c);
+	_bytesInUse[subsystem].fetch_add(blockSize, std::memory_order_relaxed);
+
+	ThreadCache* cache = threadCache();
+	if (cache != nullptr and not cache->_freeBlocks[c].empty()) {
+		std::vector<void*>& freeBlocks = cache->_freeBlocks[c];
+		void* ptr = freeBlocks.back();
+		freeBlocks.pop_back();
+		cache->_cachedBytes -= blockSize;
+		_bytesCached.fetch_sub(blockSize, std::memory_order_relaxed);
+		return ptr;
+	}
+	if (void* ptr = takeFromSharedCache(c)) {
+		_bytesCached.fetch_sub(blockSize, std::memory_order_relaxed);
+		return ptr;
+	}
+	return heapAllocate(blockSize, CACHE_LINE_SIZE);
+}
+
+void MemoryPool::deallocate(void* ptr, size_t numBytes, size_t alignment, Subsystem subsystem) {
+	if (ptr == nullptr) {
+		return;
+	}
+	if (numBytes == 0) {
+		numBytes = 1;
+	}
+	const int c = alignment > CACHE_LINE_SIZE ? -1 : sizeClass(numBytes);
+	if (c < 0) {
+		_bytesInUse[subsystem].fetch_sub(numBytes, std::memory_order_relaxed);
+		heapFree(ptr);
+		return;
+	}
+	const size_t blockSize = sizeOfClass(c);
+	_bytesInUse[subsystem].fetch_sub(blockSize, std::memory_order_relaxed);
+
+	ThreadCache* cache = threadCache();
+	if (cache == nullptr or cache->_cachedBytes + blockSize > _maxCachedBytesPerThread) {
+		heapFree(ptr);
+		return;
+	}
+	cache->_freeBlocks[c].push_back(ptr);
+	cache->_cachedBytes += blockSize;
+	_bytesCached.fetch_add(blockSize, std::memory_order_relaxed);
+}
+
+void MemoryPool::releaseThreadCache() {
+	ThreadCache* cache = threadCache();
+	if (cache == nullptr) {
+		return;
+	}
+	for (auto& freeBlocks : cache->_freeBlocks) {
+		for (void* ptr : freeBlocks) {
+			heapFree(ptr);
+		}
+		freeBlocks.clear();
+		freeBlocks.shrink_to_fit();
+	}
+	_bytesCached.fetch_sub(cache->_cachedBytes, std::memory_order_relaxed);
+	cache->_cachedBytes = 0;
+}
+
+void MemoryPool::releaseSharedCache() {
+	std::lock_guard<std::mutex> lock(_sharedCacheMutex);
+	for (auto& freeBlocks : _sharedFreeBlocks) {
+		for (void* ptr : freeBlocks) {
+			heapFree(ptr);
+		}
+		freeBlocks.clear();
+		freeBlocks.shrink_to_fit();
+	}
+	const size_t released = _sharedCachedBytes.exchange(0, std::memory_order_relaxed);
+	_bytesCached.fetch_sub(released, std::memory_order_relaxed);
+}
+
+size_t MemoryPool::getTotalSize() {
+	size_t total = getBytesCached();
+	for (int s = 0; s < NUM_SUBSYSTEMS; ++s) {
+		total += getBytesInUse(static_cast<Subsystem>(s));
+	}
+	return total;
+}
+
+void MemoryPool::printSubInfo(int offset) {
+	std::stringstream offsetstream;
+	for (int i = 0; i < offset; i++) {
+		offsetstream << "\t";
+	}
+	Log::global_log->info() << offsetstream.str() << "cells:\t\t\t" << getBytesInUse(CELLS) / 1.e6 << " MB" << std::endl;
+	Log::global_log->info() << offsetstream.str() << "SoA caches:\t\t" << getBytesInUse(SOA) / 1.e6 << " MB" << std::endl;
+	Log::global_log->info() << offsetstream.str() << "communication buffers:\t" << getBytesInUse(COMMUNICATION) / 1.e6
+			<< " MB" << std::endl;
+	Log::global_log->info() << offsetstream.str() << "cached free blocks:\t" << getBytesCached() / 1.e6 << " MB"
+			<< std::endl;
+}
@@ -0,0 +1,126 @@
+/*
+ * MemoryPool.h
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "io/MemoryProfiler.h"
+
+#define CACHE_LINE_SIZE 64
+
+/**
+ * \brief Process wide pool for the memory of cells, SoA caches and communication buffers.
+ * \details Freed blocks are not returned to the heap, but kept in a cache of the freeing thread, sorted into
+ * size classes (four per power of two). The next allocation of the same size class on that thread reuses
+ * the block, so after the first time steps particle migration and halo exchange cause no more heap traffic.
+ * When a thread exits, its cached blocks move to a shared cache, from which threads take blocks before they
+ * go to the heap. Allocated and cached bytes are counted per subsystem and reported to the MemoryProfiler.
+ *
+ * The pool does not place memory on NUMA nodes itself. A new block lands on the node of the thread touching it
+ * first, and reused blocks keep their node; LinkedCells::relocateCellStorage() releases the cache of each thread
+ * where this matters.
+ *
+ * Blocks are aligned to CACHE_LINE_SIZE. Requests with a larger alignment or larger than the largest size
+ * class bypass the pool.
+ */
+class MemoryPool : public MemoryProfilable {
+public:
+	//! subsystems with separate accounting
+	enum Subsystem {
+		CELLS = 0, SOA, COMMUNICATION, NUM_SUBSYSTEMS
+	};
+
+	//! @brief the pool of this process
+	static MemoryPool& instance();
+
+	//! @brief pointer to the pool for MemoryProfiler::registerObject
+	static MemoryProfilable** profilable();
+
+	//! @brief allocate at least numBytes with the given alignment
+	void* allocate(size_t numBytes, size_t alignment, Subsystem subsystem);
+
+	//! @brief return a block obtained from allocate with the same numBytes, alignment and subsystem
+	void deallocate(void* ptr, size_t numBytes, size_t alignment, Subsystem subsystem);
+
+	//! @brief free all blocks cached by the calling thread
+	void releaseThreadCache();
+
+	//! @brief free all blocks in the shared cache of exited threads
+	void releaseSharedCache();
+
+	//! @brief bytes currently handed out to the subsystem
+	size_t getBytesInUse(Subsystem subsystem) const {
+		return _bytesInUse[subsystem].load(std::memory_order_relaxed);
+	}
+
+	//! @brief bytes of freed blocks cached for reuse by all threads
+	size_t getBytesCached() const {
+		return _bytesCached.load(std::memory_order_relaxed);
+	}
+
+	//! @brief upper bound of the bytes cached per thread (default 32 MB), further freed blocks go back to the heap
+	void setMaxCachedBytesPerThread(size_t maxBytes) {
+		_maxCachedBytesPerThread = maxBytes;
+	}
+
+	//! @brief size of the size class numBytes is rounded up to, numBytes if it is not pooled
+	static size_t roundUpToSizeClass(size_t numBytes) {
+		const int c = sizeClass(numBytes);
+		return c < 0 ? numBytes : sizeOfClass(c);
+	}
+
+	// from MemoryProfilable
+	size_t getTotalSize() override;
+	void printSubInfo(int offset) override;
+	std::string getName() override {
+		return "MemoryPool";
+	}
+
+private:
+	MemoryPool();
+	MemoryPool(const MemoryPool&) = delete;
+	MemoryPool& operator=(const MemoryPool&) = delete;
+
+	// size classes: 64 bytes, then four classes per power of two up to 2^MAX_EXPONENT bytes
+	static constexpr int MIN_EXPONENT = 6;
+	static constexpr int MAX_EXPONENT = 30;
+	static constexpr int NUM_CLASSES = 1 + 4 * (MAX_EXPONENT - MIN_EXPONENT);
+
+	static int sizeClass(size_t numBytes);
+	static size_t sizeOfClass(int sizeClass);
+
+	typedef std::array<std::vector<void*>, NUM_CLASSES> FreeBlocks;
+
+	//! blocks cached by one thread, handed to the shared cache when the thread exits
+	struct ThreadCache {
+		explicit ThreadCache(MemoryPool& pool) : _pool(pool) {}
+		~ThreadCache();
+		MemoryPool& _pool;
+		FreeBlocks _freeBlocks;
+		size_t _cachedBytes = 0;
+	};
+
+	//! @return cache of the calling thread, nullptr once it has been destroyed during thread exit
+	ThreadCache* threadCache();
+
+	//! @brief take a block of the size class from the shared cache, nullptr if there is none
+	void* takeFromSharedCache(int sizeClass);
+
+	static void* heapAllocate(size_t numBytes, size_t alignment);
+	static void heapFree(void* ptr);
+
+	std::array<std::atomic<size_t>, NUM_SUBSYSTEMS> _bytesInUse;
+	std::atomic<size_t> _bytesCached;
+	size_t _maxCachedBytesPerThread;
+
+	std::mutex _sharedCacheMutex;
+	FreeBlocks _sharedFreeBlocks;
+	std::atomic<size_t> _sharedCachedBytes;
+};
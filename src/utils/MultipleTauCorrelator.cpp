@@ -0,0 +1,104 @@
+#include "utils/MultipleTauCorrelator.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include "utils/mardyn_assert.h"
+
+MultipleTauCorrelator::MultipleTauCorrelator(unsigned numChannels, unsigned numLevels, unsigned pointsPerLevel,
+											 unsigned averagingWidth)
+	: _numChannels(numChannels),
+	  _numLevels(numLevels),
+	  _pointsPerLevel(pointsPerLevel),
+	  _averagingWidth(averagingWidth),
+	  _numSamples(0) {
+	if (numChannels == 0 or numLevels == 0 or averagingWidth == 0 or pointsPerLevel < averagingWidth or
+		pointsPerLevel % averagingWidth != 0) {
+		std::ostringstream error_message;
+		error_message << "MultipleTauCorrelator: invalid configuration (" << numChannels << " channels, " << numLevels
+					  << " levels, " << pointsPerLevel << " points per level, averaging width " << averagingWidth
+					  << "). The points per level have to be a multiple of the averaging width." << std::endl;
+		MARDYN_EXIT(error_message.str());
+	}
+	_shift.assign(_numLevels, std::vector<double>(_pointsPerLevel * _numChannels));
+	_insertIndex.assign(_numLevels, 0);
+	_numValues.assign(_numLevels, 0);
+	_accumulator.assign(_numLevels, std::vector<double>(_numChannels));
+	_numAccumulated.assign(_numLevels, 0);
+	_correlation.assign(_numLevels, std::vector<double>(_pointsPerLevel));
+	_numProducts.assign(_numLevels, std::vector<unsigned long>(_pointsPerLevel));
+	reset();
+}
+
+void MultipleTauCorrelator::reset() {
+	_numSamples = 0;
+	for (unsigned level = 0; level < _numLevels; level++) {
+		std::fill(_shift[level].begin(), _shift[level].end(), 0.);
+		std::fill(_accumulator[level].begin(), _accumulator[level].end(), 0.);
+		std::fill(_correlation[level].begin(), _correlation[level].end(), 0.);
+		std::fill(_numProducts[level].begin(), _numProducts[level].end(), 0);
+		_insertIndex[level] = 0;
+		_numValues[level] = 0;
+		_numAccumulated[level] = 0;
+	}
+}
+
+void MultipleTauCorrelator::add(const double* values) {
+	_numSamples++;
+	add(values, 0);
+}
+
+void MultipleTauCorrelator::add(const double* values, unsigned level) {
+	const unsigned p = _pointsPerLevel;
+	const unsigned index = _insertIndex[level];
+	double* const newest = &_shift[level][index * _numChannels];
+	for (unsigned c = 0; c < _numChannels; c++) {
+		newest[c] = values[c];
+		_accumulator[level][c] += values[c];
+	}
+	if (_numValues[level] < p) {
+		_numValues[level]++;
+	}
+
+	// the lags below p/m of the higher levels are already covered by the finer level
+	const unsigned firstLag = (level == 0) ? 0 : p / _averagingWidth;
+	for (unsigned lag = firstLag; lag < _numValues[level]; lag++) {
+		const double* const older = &_shift[level][((index + p - lag) % p) * _numChannels];
+		double product = 0.;
+		for (unsigned c = 0; c < _numChannels; c++) {
+			product += newest[c] * older[c];
+		}
+		_correlation[level][lag] += product;
+		_numProducts[level][lag]++;
+	}
+	_insertIndex[level] = (index + 1) % p;
+
+	if (++_numAccumulated[level] == _averagingWidth) {
+		if (level + 1 < _numLevels) {
+			std::vector<double> average(_numChannels);
+			for (unsigned c = 0; c < _numChannels; c++) {
+				average[c] = _accumulator[level][c] / _averagingWidth;
+			}
+			add(average.data(), level + 1);
+		}
+		std::fill(_accumulator[level].begin(), _accumulator[level].end(), 0.);
+		_numAccumulated[level] = 0;
+	}
+}
+
+void MultipleTauCorrelator::getCorrelation(std::vector<unsigned long>& lags, std::vector<double>& correlation) const {
+	lags.clear();
+	correlation.clear();
+	unsigned long lagFactor = 1;  // averagingWidth^level
+	for (unsigned level = 0; level < _numLevels; level++) {
+		const unsigned firstLag = (level == 0) ? 0 : _pointsPerLevel / _averagingWidth;
+		for (unsigned lag = firstLag; lag < _pointsPerLevel; lag++) {
+			if (_numProducts[level][lag] == 0) {
+				continue;
+			}
+			lags.push_back(lag * lagFactor);
+			correlation.push_back(_correlation[level][lag] / (_numProducts[level][lag] * _numChannels));
+		}
+		lagFactor *= _averagingWidth;
+	}
+}
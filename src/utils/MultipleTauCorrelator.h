@@ -0,0 +1,65 @@
+#pragma once
+
+#include <vector>
+
+/**
+ * @brief Autocorrelation function of a time series computed on the fly with the multiple-tau algorithm.
+ * @details The correlator consists of a hierarchy of levels with pointsPerLevel lag times each. Level 0 correlates
+ * every sample, level k the averages of averagingWidth^k consecutive samples, so the lag times grow geometrically
+ * while memory and work per sample stay bounded by numLevels * pointsPerLevel. The samples themselves are never
+ * stored, only the shift registers of the levels (Ramirez et al., J. Chem. Phys. 133, 154103 (2010)).
+ *
+ * A sample can consist of several channels, e.g. the components of a vector. Their autocorrelation functions are
+ * averaged.
+ */
+class MultipleTauCorrelator {
+public:
+	/**
+	 * @param numChannels number of values per sample
+	 * @param numLevels number of levels, the largest lag time is about pointsPerLevel * averagingWidth^(numLevels-1)
+	 * @param pointsPerLevel lag times per level, has to be a multiple of averagingWidth
+	 * @param averagingWidth number of values of a level averaged into one value of the next level
+	 */
+	MultipleTauCorrelator(unsigned numChannels = 1, unsigned numLevels = 16, unsigned pointsPerLevel = 16,
+						  unsigned averagingWidth = 2);
+
+	//! @brief add the next sample, numChannels values
+	void add(const double* values);
+
+	//! @brief discard all samples
+	void reset();
+
+	/**
+	 * @brief the autocorrelation function, averaged over the channels
+	 * @param[out] lags lag times in number of samples, increasing
+	 * @param[out] correlation the correlation for each lag time
+	 */
+	void getCorrelation(std::vector<unsigned long>& lags, std::vector<double>& correlation) const;
+
+	//! @brief number of samples added since construction or the last reset
+	unsigned long getNumSamples() const { return _numSamples; }
+
+	unsigned getNumChannels() const { return _numChannels; }
+
+private:
+	void add(const double* values, unsigned level);
+
+	unsigned _numChannels;
+	unsigned _numLevels;
+	unsigned _pointsPerLevel;
+	unsigned _averagingWidth;
+	unsigned long _numSamples;
+
+	//! the last pointsPerLevel values of each level, ring buffers of numChannels values per entry
+	std::vector<std::vector<double>> _shift;
+	//! index of the entry the next value of a level is written to
+	std::vector<unsigned> _insertIndex;
+	//! number of valid entries of the ring buffer of a level
+	std::vector<unsigned> _numValues;
+	//! sum of the values of a level not yet passed to the next level
+	std::vector<std::vector<double>> _accumulator;
+	std::vector<unsigned> _numAccumulated;
+	//! sum of the products and number of products for each level and lag
+	std::vector<std::vector<double>> _correlation;
+	std::vector<std::vector<unsigned long>> _numProducts;
+};
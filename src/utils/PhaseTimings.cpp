@@ -0,0 +1,38 @@
+#include "PhaseTimings.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+void PhaseTimings::add(const std::string& phase, double seconds) {
+	auto& samples = _samples[phase];
+	if (samples.empty()) {
+		_phases.push_back(phase);
+	}
+	samples.push_back(seconds);
+}
+
+PhaseTimings::Summary PhaseTimings::getSummary(const std::string& phase) const {
+	Summary summary{0, 0., 0., 0., 0., 0.};
+	const auto it = _samples.find(phase);
+	if (it == _samples.end() or it->second.empty()) {
+		return summary;
+	}
+	std::vector<double> sorted(it->second);
+	std::sort(sorted.begin(), sorted.end());
+	summary.count = sorted.size();
+	summary.mean = std::accumulate(sorted.begin(), sorted.end(), 0.) / sorted.size();
+	summary.min = sorted.front();
+	summary.median = percentile(sorted, 50.);
+	summary.p90 = percentile(sorted, 90.);
+	summary.max = sorted.back();
+	return summary;
+}
+
+double PhaseTimings::percentile(const std::vector<double>& sortedSamples, double p) {
+	const double position = p / 100. * (sortedSamples.size() - 1);
+	const size_t lower = static_cast<size_t>(std::floor(position));
+	const size_t upper = std::min(lower + 1, sortedSamples.size() - 1);
+	const double weight = position - lower;
+	return (1. - weight) * sortedSamples[lower] + weight * sortedSamples[upper];
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Run times of named phases over repeated executions, e.g. for benchmarks.
+ * @details All samples are stored, so percentiles are exact. The phases are kept in the order of their first sample.
+ */
+class PhaseTimings {
+public:
+	struct Summary {
+		unsigned long count;
+		double mean;
+		double min;
+		double median;
+		double p90;
+		double max;
+	};
+
+	//! @brief add one run time of phase in seconds
+	void add(const std::string& phase, double seconds);
+
+	//! @brief names of the phases with samples, in the order of their first sample
+	const std::vector<std::string>& getPhases() const { return _phases; }
+
+	//! @brief mean, minimum, percentiles and maximum of the samples of phase, all zero if there are none
+	Summary getSummary(const std::string& phase) const;
+
+	/**
+	 * @brief percentile of samples with linear interpolation between the closest ranks
+	 * @param sortedSamples samples in ascending order, must not be empty
+	 * @param p percentile in [0, 100]
+	 */
+	static double percentile(const std::vector<double>& sortedSamples, double p);
+
+private:
+	std::vector<std::string> _phases;
+	std::map<std::string, std::vector<double>> _samples;
+};
@@ -0,0 +1,78 @@
+/**
+ * PoolAllocator.h
+ */
+
+#ifndef POOLALLOCATOR_H
+#define POOLALLOCATOR_H
+
+#include <limits>
+#include <new>
+#include <utility>
+
+#include "utils/MemoryPool.h"
+
+/**
+ * \brief Allocator taking its memory from the MemoryPool
+ * \details Intended to be used by std::vector, like AlignedAllocator.
+ * \tparam T The type of the elements this class should allocate memory for
+ * \tparam Subsystem The MemoryPool subsystem the memory is accounted to
+ * \tparam Alignment The alignment restriction. Must be a power of 2.
+ */
+template<typename T, MemoryPool::Subsystem Subsystem, size_t Alignment = CACHE_LINE_SIZE>
+struct PoolAllocator {
+
+	typedef T value_type;
+	typedef T* pointer;
+	typedef const T* const_pointer;
+	typedef T& reference;
+	typedef const T& const_reference;
+	typedef size_t size_type;
+
+	template<class U>
+	struct rebind {
+		typedef PoolAllocator<U, Subsystem, Alignment> other;
+	};
+
+	PoolAllocator() = default;
+
+	template<class U>
+	PoolAllocator(const PoolAllocator<U, Subsystem, Alignment>&) {
+	}
+
+	size_t max_size() const noexcept {
+		return (std::numeric_limits<size_t>::max() - size_t(Alignment)) / sizeof(T);
+	}
+
+	T* allocate(std::size_t n) {
+		if (n > max_size()) {
+			throw std::bad_alloc();
+		}
+		return static_cast<T*>(MemoryPool::instance().allocate(sizeof(T) * n, Alignment, Subsystem));
+	}
+
+	void deallocate(T* ptr, std::size_t n) {
+		MemoryPool::instance().deallocate(ptr, sizeof(T) * n, Alignment, Subsystem);
+	}
+
+	template<class U, class ...Args>
+	void construct(U* p, Args&&... args) noexcept(noexcept(U(std::forward<Args>(args)...))) {
+		::new ((void*) p) U(std::forward<Args>(args)...);
+	}
+
+	template<class U>
+	void destroy(U* p) noexcept(noexcept(p->~U())) {
+		p->~U();
+	}
+};
+
+template<typename T, MemoryPool::Subsystem TSubsystem, size_t TAlignment, typename U, MemoryPool::Subsystem USubsystem, size_t UAlignment>
+inline bool operator ==(const PoolAllocator<T, TSubsystem, TAlignment>&, const PoolAllocator<U, USubsystem, UAlignment>&) {
+	return TSubsystem == USubsystem and TAlignment == UAlignment;
+}
+
+template<typename T, MemoryPool::Subsystem TSubsystem, size_t TAlignment, typename U, MemoryPool::Subsystem USubsystem, size_t UAlignment>
+inline bool operator !=(const PoolAllocator<T, TSubsystem, TAlignment>& a, const PoolAllocator<U, USubsystem, UAlignment>& b) {
+	return !(a == b);
+}
+
+#endif /*POOLALLOCATOR_H*/
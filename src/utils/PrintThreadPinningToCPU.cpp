@@ -13,6 +13,18 @@
 
 #if !defined(__INTEL_COMPILER) and !defined(_SX)
 #include <sched.h> /* int sched_getcpu(void); */
+#include <sys/syscall.h>
+#include <unistd.h>
+
+int getNumaNodeOfCurrentThread() {
+#ifdef SYS_getcpu
+	unsigned cpu = 0, node = 0;
+	if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0) {
+		return static_cast<int>(node);
+	}
+#endif
+	return 0;
+}
 
 void PrintThreadPinningToCPU() {
 	int mastercpu = sched_getcpu();
@@ -24,13 +36,16 @@ void PrintThreadPinningToCPU() {
 	#pragma omp parallel
 	#endif
 	{
-		int cpu;
+		int cpu, node;
 
 		// protect the call to sched_getcpu, just in case. It is "MT-Safe" but let's be super safe.
 		#if defined(_OPENMP)
 		#pragma omp critical (sched_getcpu)
 		#endif
-		cpu = sched_getcpu();
+		{
+			cpu = sched_getcpu();
+			node = getNumaNodeOfCurrentThread();
+		}
 
 
 		const int myID = mardyn_get_thread_num();
@@ -38,7 +53,7 @@ void PrintThreadPinningToCPU() {
 
 		for (int i = 0; i < numThreads; ++i) {
 			if (i == myID) {
-				Log::global_log->info() << "		Thread with id " << myID << " is running on " << cpu << "." << std::endl;
+				Log::global_log->info() << "		Thread with id " << myID << " is running on " << cpu << " (NUMA node " << node << ")." << std::endl;
 			}
 
 			#if defined(_OPENMP)
@@ -49,6 +64,10 @@ void PrintThreadPinningToCPU() {
 }
 #else
 
+int getNumaNodeOfCurrentThread() {
+	return 0;
+}
+
 void PrintThreadPinningToCPU() {
 	Log::global_log->warning() << "Thread pinning information cannot be obtained for this system/compiler by ls1. "
 						  "Instead, please use OpenMP runtime system capabilities, e.g. KMP_AFFINITY=verbose for the Intel Compiler." << std::endl;
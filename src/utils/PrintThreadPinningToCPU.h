@@ -14,4 +14,11 @@
  */
 void PrintThreadPinningToCPU();
 
+/**
+ * NUMA node of the cpu the calling thread is currently running on,
+ * 0 if this cannot be determined for this system/compiler.
+ * Meaningful only if the threads are pinned.
+ */
+int getNumaNodeOfCurrentThread();
+
 #endif /* SRC_UTILS_PRINTTHREADPINNINGTOCPU_H_ */
@@ -9,24 +9,32 @@
  */
 class EqualVelocityAssigner : public VelocityAssignerBase {
 public:
-	EqualVelocityAssigner(double T = 0, long seed = 0) : VelocityAssignerBase(T), _mt(seed), _uniformDistribution(0, 1) {}
+	EqualVelocityAssigner(double T = 0, long seed = 0) : VelocityAssignerBase(T, seed), _mt(seed), _uniformDistribution(0, 1) {}
 	~EqualVelocityAssigner(){}
 
 	void assignVelocity(Molecule *molecule) {
+		const double uniform[2] = {_uniformDistribution(_mt), _uniformDistribution(_mt)};
+		setVelocity(molecule, uniform);
+	}
+
+	void assignVelocity(Molecule *molecule, unsigned long key) const {
+		double uniform[2];
+		keyedRandom().uniform(key, 0, uniform, 2);
+		setVelocity(molecule, uniform);
+	}
+private:
+	/** Set the velocity with absolute value matching the temperature in the direction given by two uniform random numbers in [0,1). */
+	void setVelocity(Molecule *molecule, const double uniform[2]) const {
 		double v_abs = sqrt(/*kB=1*/ (3+molecule->component()->getRotationalDegreesOfFreedom())*T() / molecule->component()->m());
-		/* pick angels for uniform distributino on S^2. */
+		/* pick angles for uniform distribution on S^2. */
 		double phi, theta;
-		phi   = 2*M_PI * _uniformDistribution(_mt);
-		theta = acos(2 * _uniformDistribution(_mt) - 1);
-		double v[3];
-		v[0] = v_abs * sin(phi);
-		v[1] = v_abs * cos(phi) * sin(theta);
-		v[2] = v_abs * cos(phi) * cos(theta);
-		for(int d = 0; d < 3; d++) {
-			molecule->setv(d, v[d]);
-		}
+		phi   = 2*M_PI * uniform[0];
+		theta = acos(2 * uniform[1] - 1);
+		molecule->setv(0, v_abs * sin(phi));
+		molecule->setv(1, v_abs * cos(phi) * sin(theta));
+		molecule->setv(2, v_abs * cos(phi) * cos(theta));
 	}
-private:
+
 	std::mt19937 _mt; //!< Mersenne twister used as input for the uniform distribution
 	std::uniform_real_distribution<double> _uniformDistribution;
 };
@@ -15,7 +15,9 @@
 #include "utils/generator/Objects.h"
 #include "utils/Coordinate3D.h"
 #include "molecules/Molecule.h"
+#include "utils/CounterBasedRandom.h"
 
+#include <algorithm>
 #include <iostream>
 #include <cmath>
 
@@ -35,6 +37,12 @@ void GridFiller::init() {
     _object->getBboxMin(bBoxMin);
     _object->getBboxMax(bBoxMax);
     _baseCount = 0;
+    _nextRow = 0;
+    _gen.seed(_seed);
+    _baseMolecules.clear();
+    for(size_t b = 0; b < _basis.numMolecules(); b++) {
+        _baseMolecules.push_back(_basis.getMolecule(b));
+    }
 
     /* transpose (a,b,c) */
     double *A[3];
@@ -155,3 +163,87 @@ int GridFiller::getMolecule(Molecule* molecule) {
 	}
 	return 1;
 }
+
+unsigned long GridFiller::getMolecules(std::vector<Molecule>& molecules, unsigned long maxMolecules) {
+	const long* dimsMin = _lattice.dimsMin();
+	const long* dimsMax = _lattice.dimsMax();
+	const long rowsPerLayer = dimsMax[1] - dimsMin[1];
+	const long totalRows = rowsPerLayer * (dimsMax[2] - dimsMin[2]);
+	const int numCenters = _lattice.numCenters();
+	const int numBase = _basis.numMolecules();
+	const unsigned long pointsPerRow = (dimsMax[0] - dimsMin[0]) * numCenters * numBase;
+
+	const std::vector<Molecule>& baseMolecules = _baseMolecules;
+	const CounterBasedRandom occupancyRandom(_seed, RNG_PURPOSE_LATTICE_OCCUPANCY);
+
+	unsigned long numMolecules = 0;
+	while(numMolecules == 0 && _nextRow < totalRows) {
+		const long firstRow = _nextRow;
+		const long numRows = std::min(totalRows - firstRow, std::max(1l, static_cast<long>(maxMolecules / std::max(1ul, pointsPerRow))));
+		_nextRow += numRows;
+
+		std::vector<std::vector<Molecule>> rowMolecules(numRows);
+		#if defined(_OPENMP)
+		#pragma omp parallel
+		#endif
+		{
+			std::vector<std::array<double, 3>> points;
+			std::vector<int> pointBase;
+			std::vector<char> inside;
+
+			#if defined(_OPENMP)
+			#pragma omp for schedule(dynamic)
+			#endif
+			for(long row = 0; row < numRows; row++) {
+				long pos[3];
+				pos[1] = dimsMin[1] + (firstRow + row) % rowsPerLayer;
+				pos[2] = dimsMin[2] + (firstRow + row) / rowsPerLayer;
+				points.clear();
+				pointBase.clear();
+				for(pos[0] = dimsMin[0]; pos[0] < dimsMax[0]; pos[0]++) {
+					for(int c = 0; c < numCenters; c++) {
+						double latticePoint[3];
+						if(not _lattice.getPoint(pos, c, latticePoint)) {
+							continue;
+						}
+						for(int b = 0; b < numBase; b++) {
+							if(_latticeOccupancy < 1.0) {
+								const CounterBasedRandom::Block random = occupancyRandom.block(CounterBasedRandom::Block{
+									static_cast<uint32_t>(pos[0]), static_cast<uint32_t>(pos[1]), static_cast<uint32_t>(pos[2]),
+									static_cast<uint32_t>(c * numBase + b)});
+								if(CounterBasedRandom::toUniform(random[0], random[1]) > _latticeOccupancy) {
+									continue;
+								}
+							}
+							std::array<double, 3> r;
+							for(int d = 0; d < 3; d++) {
+								r[d] = _origin[d] + latticePoint[d] + baseMolecules[b].r(d);
+							}
+							points.push_back(r);
+							pointBase.push_back(b);
+						}
+					}
+				}
+
+				inside.assign(points.size(), 1);
+				_object->classifyInside(points, inside);
+
+				std::vector<Molecule>& rowResult = rowMolecules[row];
+				for(size_t i = 0; i < points.size(); i++) {
+					if(inside[i]) {
+						rowResult.push_back(baseMolecules[pointBase[i]]);
+						for(int d = 0; d < 3; d++) {
+							rowResult.back().setr(d, points[i][d]);
+						}
+					}
+				}
+			}
+		}
+
+		for(auto& rowResult : rowMolecules) {
+			molecules.insert(molecules.end(), rowResult.begin(), rowResult.end());
+			numMolecules += rowResult.size();
+		}
+	}
+	return numMolecules;
+}
@@ -22,7 +22,7 @@
 /** The GridFiller returns molecules within an object placed on a lattice using a specified lattice basis. */
 class GridFiller : public ObjectFillerBase {
 public:
-	   GridFiller() : _lattice(), _basis(), _origin{{0.0, 0.0, 0.0}}, _object(nullptr), _latticeOccupancy(1.0), _dis(0.0, 1.0), _gen(0) {}
+	   GridFiller() : _lattice(), _basis(), _origin{{0.0, 0.0, 0.0}}, _object(nullptr), _latticeOccupancy(1.0), _dis(0.0, 1.0), _gen(0), _seed(0) {}
 	   ~GridFiller(){}
 
 	/** @brief Read in XML configuration for GridFiller and all its included objects.
@@ -58,6 +58,9 @@ public:
 	/* Set object to fill */
 	void setObject(std::shared_ptr<Object> object) { _object = object; }
 
+	/** Set the seed of the lattice occupancy, call before init */
+	void setSeed(long seed) override { _seed = seed; }
+
 	/** Get a single molecule
 	 * By subsequent calls all molecules will be returned, one by one.
 	 * @param[out] molecule  Pointer to molecule data structure where to store the molecule data (coordinate and component id)
@@ -65,6 +68,16 @@ public:
 	 */
 	int getMolecule(Molecule *molecule);
 
+	/** Get a batch of molecules
+	 * The lattice is processed in rows along the first lattice vector, rows are generated in parallel and
+	 * classified against the object in bulk. The lattice occupancy is drawn from a counter-based random
+	 * number generator keyed by the lattice position, so the result does not depend on the number of threads.
+	 * @param[out] molecules     vector to which the molecules are appended
+	 * @param[in]  maxMolecules  batch size hint, at least one row of lattice points is processed
+	 * @return     number of molecules appended, 0 if no more molecules can be returned
+	 */
+	unsigned long getMolecules(std::vector<Molecule>& molecules, unsigned long maxMolecules) override;
+
 	std::string getPluginName() { return std::string("GridFiller"); }
 	static ObjectFillerBase* createInstance() { return new GridFiller(); }
 
@@ -77,10 +90,16 @@ private:
 
 	std::uniform_real_distribution<> _dis;
 	std::mt19937 _gen;
+	long _seed;
+
+	/* Molecules of the basis, copied once by init for getMolecules */
+	std::vector<Molecule> _baseMolecules;
 
 	/* Internal values/counters used during the creation by getMolecule */
 	long _baseCount;
 	double _lattice_point[3];
+	/* Next lattice row (along a) to be processed by getMolecules */
+	long _nextRow;
 };
 
 #endif  // GRIDFILLER_H_
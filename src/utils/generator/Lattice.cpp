@@ -149,6 +149,20 @@ int Lattice::getPoint(double* r) {
 	return 1;
 }
 
+bool Lattice::getPoint(const long pos[3], int centering, double r[3]) const {
+	/* for hexagonal lattic we have to skip mid points of hexagons */
+	if( (_system == hexagonal) && ( (pos[0] - pos[1] + 2) % 3 == 0) ) {
+		return false;
+	}
+	double ia = pos[0] + LatticeCenteringCoords[_centering][centering][0];
+	double ib = pos[1] + LatticeCenteringCoords[_centering][centering][1];
+	double ic = pos[2] + LatticeCenteringCoords[_centering][centering][2];
+	for(int d = 0; d < 3; d++) {
+		r[d] = ia * _a[d] + ib * _b[d] + ic * _c[d];
+	}
+	return true;
+}
+
 bool Lattice::checkValidity(){
 	/* Checks for validity of system centering combination */
 	switch(_system) {
@@ -90,6 +90,20 @@ public:
 		*/
 	int getPoint(double* r);
 
+	/** Get the point with given centering in the given lattice cell.
+		* In contrast to getPoint this does not change the internal position marker and can be called concurrently.
+		* @param[in]   pos        lattice cell in multiples of the lattice vectors
+		* @param[in]   centering  index of the centering position in the cell, 0 <= centering < numCenters()
+		* @param[out]  r          the point's coordinates
+		* @return      false if the lattice has no point at this position (mid points of hexagons), true otherwise
+		*/
+	bool getPoint(const long pos[3], int centering, double r[3]) const;
+
+	/** Get lower corner of lattice in multiples of the lattice vectors */
+	const long* dimsMin() const { return _dimsMin; }
+	/** Get upper corner (excluded) of lattice in multiples of the lattice vectors */
+	const long* dimsMax() const { return _dimsMax; }
+
 	/** Check if lattice specifications represent a valid Bravais lattice
 		* @return true if valid Bravais lattice, false otherwise
 		*/
@@ -10,20 +10,28 @@
  */
 class MaxwellVelocityAssigner : public VelocityAssignerBase {
 public:
-	MaxwellVelocityAssigner(double T = 0, long seed = 0) : VelocityAssignerBase(T), _mt(seed), _normalDistribution(0.0, 1.0) {}
+	MaxwellVelocityAssigner(double T = 0, long seed = 0) : VelocityAssignerBase(T, seed), _mt(seed), _normalDistribution(0.0, 1.0) {}
 	~MaxwellVelocityAssigner() {}
 
 	void assignVelocity(Molecule *molecule) {
+		const double normal[3] = {_normalDistribution(_mt), _normalDistribution(_mt), _normalDistribution(_mt)};
+		setVelocity(molecule, normal);
+	}
+
+	void assignVelocity(Molecule *molecule, unsigned long key) const {
+		double normal[3];
+		keyedRandom().normal(key, 0, normal, 3);
+		setVelocity(molecule, normal);
+	}
+private:
+	/** Scale three standard normal random numbers to the velocity components matching the temperature. */
+	void setVelocity(Molecule *molecule, const double normal[3]) const {
 		double v_abs = sqrt(/*kB=1*/ (1+molecule->component()->getRotationalDegreesOfFreedom()/3.)*T() / molecule->component()->m());
-		double v[3];
-		v[0] = v_abs * _normalDistribution(_mt);
-		v[1] = v_abs * _normalDistribution(_mt);
-		v[2] = v_abs * _normalDistribution(_mt);
 		for(int d = 0; d < 3; d++) {
-			molecule->setv(d, v[d]);
+			molecule->setv(d, v_abs * normal[d]);
 		}
 	}
-private:
+
 	std::mt19937 _mt; //!< Mersenne twister used as input for the normal distribution
 	std::normal_distribution<double> _normalDistribution;
 };
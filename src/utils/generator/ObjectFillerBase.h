@@ -2,6 +2,7 @@
 #define OBJECTFILLERBASE_H_
 
 #include <string>
+#include <vector>
 
 #include "molecules/Molecule.h"
 #include "utils/generator/Objects.h"
@@ -30,6 +31,9 @@ public:
 	/* Set object to fill */
 	virtual void setObject(std::shared_ptr<Object> object) = 0;
 
+	/** Set the seed of the random numbers drawn by the filler, e.g. for a partial lattice occupancy */
+	virtual void setSeed(long /*seed*/) {}
+
 	/** Get a single molecule
 	 * By subsequent calls all molecules will be returned, one by one.
 	 * @param[out] molecule  Pointer to molecule data structure where to store the molecule data (coordinate and component id)
@@ -37,6 +41,23 @@ public:
 	 */
 	virtual int getMolecule(Molecule *molecule) = 0;
 
+	/** Get a batch of molecules
+	 * Appends about maxMolecules molecules to the vector. By subsequent calls all molecules will be returned.
+	 * Fillers may override this to generate the molecules in parallel, the default implementation calls getMolecule.
+	 * @param[out] molecules     vector to which the molecules are appended
+	 * @param[in]  maxMolecules  batch size hint
+	 * @return     number of molecules appended, 0 if no more molecules can be returned
+	 */
+	virtual unsigned long getMolecules(std::vector<Molecule>& molecules, unsigned long maxMolecules) {
+		unsigned long numMolecules = 0;
+		Molecule molecule;
+		while(numMolecules < maxMolecules && getMolecule(&molecule) > 0) {
+			molecules.push_back(molecule);
+			numMolecules++;
+		}
+		return numMolecules;
+	}
+
 	virtual std::string getPluginName() = 0;
 };
 
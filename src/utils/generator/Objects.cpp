@@ -35,6 +35,21 @@ bool Cuboid::isInsideNoBorder(double r[3]) {
 		&& (lowerCorner(2) < r[2] && r[2] < upperCorner(2));
 }
 
+void Cuboid::classifyInside(std::vector<std::array<double, 3>>& r, std::vector<char>& inside) {
+	const std::array<double, 3>* const points = r.data();
+	char* const flags = inside.data();
+	const double lx = _lowerCorner[0], ly = _lowerCorner[1], lz = _lowerCorner[2];
+	const double ux = _upperCorner[0], uy = _upperCorner[1], uz = _upperCorner[2];
+	const size_t n = r.size();
+	#pragma omp simd
+	for(size_t i = 0; i < n; i++) {
+		const bool in = (lx <= points[i][0]) & (points[i][0] <= ux)
+			& (ly <= points[i][1]) & (points[i][1] <= uy)
+			& (lz <= points[i][2]) & (points[i][2] <= uz);
+		flags[i] = (flags[i] != 0) & in;
+	}
+}
+
 void Cuboid::getBboxMin(double rmin[3]) {
 	for(int d = 0; d < 3; d++) {
 		rmin[d] = _lowerCorner[d];
@@ -85,6 +100,21 @@ bool Sphere::isInsideNoBorder(double r[3]) {
 	return (dr2 < _radiusSquare);
 }
 
+void Sphere::classifyInside(std::vector<std::array<double, 3>>& r, std::vector<char>& inside) {
+	const std::array<double, 3>* const points = r.data();
+	char* const flags = inside.data();
+	const double cx = _center[0], cy = _center[1], cz = _center[2];
+	const double radiusSquare = _radiusSquare;
+	const size_t n = r.size();
+	#pragma omp simd
+	for(size_t i = 0; i < n; i++) {
+		const double dx = points[i][0] - cx;
+		const double dy = points[i][1] - cy;
+		const double dz = points[i][2] - cz;
+		flags[i] = (flags[i] != 0) & (dx * dx + dy * dy + dz * dz <= radiusSquare);
+	}
+}
+
 void Sphere::getBboxMin(double rmin[3]) {
 	for(int d = 0; d < 3; d++) {
 		rmin[d] = _center[d] - _radius;
@@ -11,8 +11,10 @@
 #ifndef OBJECTS_H
 #define OBJECTS_H
 
+#include <array>
 #include <memory>
 #include <cstdint>
+#include <vector>
 
 #include "utils/xmlfileUnits.h"
 
@@ -31,6 +33,15 @@ public:
 	virtual bool isInside(double r[3]) = 0;
 	/** Determines if the given point is inside the object excluding it's border  */
 	virtual bool isInsideNoBorder(double r[3]) = 0;
+	/** Bulk version of isInside: clears inside[i] for all points r[i] outside of the object.
+	 * Points with inside[i] == 0 are not tested, so successive calls for several objects give their intersection. */
+	virtual void classifyInside(std::vector<std::array<double, 3>>& r, std::vector<char>& inside) {
+		for(size_t i = 0; i < r.size(); i++) {
+			if(inside[i]) {
+				inside[i] = isInside(r[i].data());
+			}
+		}
+	}
 	/** Get lower corner of a bounding box around the object */
 	virtual void getBboxMin(double rmin[3]) = 0;
 	/** Get upper corner of a bounding box around the object */
@@ -64,6 +75,7 @@ public:
 
 	bool isInside(double r[3]);
 	bool isInsideNoBorder(double r[3]);
+	void classifyInside(std::vector<std::array<double, 3>>& r, std::vector<char>& inside) override;
 	void getBboxMin(double rmin[3]);
 	void getBboxMax(double rmax[3]);
 
@@ -97,6 +109,7 @@ public:
 
 	bool isInside(double r[3]);
 	bool isInsideNoBorder(double r[3]);
+	void classifyInside(std::vector<std::array<double, 3>>& r, std::vector<char>& inside) override;
 	void getBboxMin(double rmin[3]);
 	void getBboxMax(double rmax[3]);
 
@@ -280,6 +293,11 @@ public:
 		return _ob1->isInside(r) && _ob2->isInside(r);
 	}
 
+	void classifyInside(std::vector<std::array<double, 3>>& r, std::vector<char>& inside) override {
+		_ob1->classifyInside(r, inside);
+		_ob2->classifyInside(r, inside);
+	}
+
 	bool isInsideNoBorder(double r[3]) {
 		return _ob1->isInsideNoBorder(r) && _ob2->isInsideNoBorder(r);
 	}
@@ -236,3 +236,16 @@ int ReplicaFiller::getMolecule(Molecule* molecule) {
 	}
 	return ret;
 }
+
+unsigned long ReplicaFiller::getMolecules(std::vector<Molecule>& molecules, unsigned long maxMolecules) {
+	const size_t first = molecules.size();
+	unsigned long numMolecules = _gridFiller.getMolecules(molecules, maxMolecules);
+	// change component if specified
+	if (not _keepComponent) {
+		Component* component = global_simulation->getEnsemble()->getComponent(_componentid);
+		for (size_t i = first; i < molecules.size(); ++i) {
+			molecules[i].setComponent(component);
+		}
+	}
+	return numMolecules;
+}
@@ -63,6 +63,8 @@ class ReplicaFiller : public ObjectFillerBase {
 	 */
 	int getMolecule(Molecule* molecule);
 
+	unsigned long getMolecules(std::vector<Molecule>& molecules, unsigned long maxMolecules) override;
+
 	std::string getPluginName() { return std::string("ReplicaFiller"); }
 
 	static ObjectFillerBase* createInstance() { return new ReplicaFiller(); }
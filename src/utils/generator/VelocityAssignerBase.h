@@ -2,18 +2,25 @@
 #define SRC_UTILS_GENERATOR_VELOCITYASSIGNERBASE_H_
 
 #include "molecules/Molecule.h"
+#include "utils/CounterBasedRandom.h"
 
 /** The VelocityAssignerBase implements the gernal functionality and interface to assign velocity vectors mathing to a given temperature.
  */
 class VelocityAssignerBase {
 public:
-	VelocityAssignerBase(double T = 0) : _T(T) {}
+	VelocityAssignerBase(double T = 0, long seed = 0) : _T(T), _keyedRandom(seed, RNG_PURPOSE_VELOCITY) {}
 	virtual ~VelocityAssignerBase(){}
 	void setTemperature(double T) { _T = T; }
-	double T() { return _T; }
+	double T() const { return _T; }
 	virtual void assignVelocity(Molecule *molecule) = 0;
+	/** Assign a velocity drawn from a counter-based random number generator keyed by the given key (e.g. the molecule ID).
+	 * The velocity does not depend on the order of calls, so this may be called concurrently from several threads. */
+	virtual void assignVelocity(Molecule *molecule, unsigned long key) const = 0;
+protected:
+	const CounterBasedRandom& keyedRandom() const { return _keyedRandom; }
 private:
 	double _T;  //!< coressponding target temperature
+	CounterBasedRandom _keyedRandom;  //!< generator used for keyed velocity assignment
 };
 
 #endif  // SRC_UTILS_GENERATOR_VELOCITYASSIGNERBASE_H_
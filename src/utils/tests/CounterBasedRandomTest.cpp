@@ -0,0 +1,116 @@
+/*
+ * CounterBasedRandomTest.cpp
+ */
+
+#include "CounterBasedRandomTest.h"
+#include "../CounterBasedRandom.h"
+
+#include <vector>
+
+TEST_SUITE_REGISTRATION(CounterBasedRandomTest);
+
+void CounterBasedRandomTest::testKnownAnswers() {
+	const CounterBasedRandom::Block zeros = CounterBasedRandom(0).block(CounterBasedRandom::Block{0u, 0u, 0u, 0u});
+	ASSERT_EQUAL(0x6627e8d5u, zeros[0]);
+	ASSERT_EQUAL(0xe169c58du, zeros[1]);
+	ASSERT_EQUAL(0xbc57ac4cu, zeros[2]);
+	ASSERT_EQUAL(0x9b00dbd8u, zeros[3]);
+
+	const CounterBasedRandom::Block ones =
+		CounterBasedRandom(~0ull).block(CounterBasedRandom::Block{~0u, ~0u, ~0u, ~0u});
+	ASSERT_EQUAL(0x408f276du, ones[0]);
+	ASSERT_EQUAL(0x41c83b0eu, ones[1]);
+	ASSERT_EQUAL(0xa20bc7c6u, ones[2]);
+	ASSERT_EQUAL(0x6d5451fdu, ones[3]);
+
+	const CounterBasedRandom::Block pi = CounterBasedRandom(0xa4093822ull | (0x299f31d0ull << 32))
+		.block(CounterBasedRandom::Block{0x243f6a88u, 0x85a308d3u, 0x13198a2eu, 0x03707344u});
+	ASSERT_EQUAL(0xd16cfe09u, pi[0]);
+	ASSERT_EQUAL(0x94fdccebu, pi[1]);
+	ASSERT_EQUAL(0x5001e420u, pi[2]);
+	ASSERT_EQUAL(0x24126ea1u, pi[3]);
+}
+
+void CounterBasedRandomTest::testOrderIndependence() {
+	const CounterBasedRandom rng(42, RNG_PURPOSE_VELOCITY);
+	const int numIds = 1000;
+	std::vector<double> forward(3 * numIds);
+	for (int id = 0; id < numIds; ++id) {
+		rng.normal(id, 7, &forward[3 * id], 3);
+	}
+
+	std::vector<double> parallel(3 * numIds);
+	#if defined(_OPENMP)
+	#pragma omp parallel for schedule(dynamic, 7)
+	#endif
+	for (int id = numIds - 1; id >= 0; --id) {
+		rng.normal(id, 7, &parallel[3 * id], 3);
+	}
+
+	for (int i = 0; i < 3 * numIds; ++i) {
+		ASSERT_EQUAL(forward[i], parallel[i]);
+	}
+
+	// other purposes and steps give other streams
+	double other[3];
+	CounterBasedRandom(42, RNG_PURPOSE_LATTICE_OCCUPANCY).normal(0, 7, other, 3);
+	ASSERT_TRUE(other[0] != forward[0]);
+	rng.normal(0, 8, other, 3);
+	ASSERT_TRUE(other[0] != forward[0]);
+}
+
+void CounterBasedRandomTest::testDistributions() {
+	const CounterBasedRandom rng(1);
+	const int numSamples = 100000;
+	double uniformSum = 0.0, uniformSquareSum = 0.0;
+	double normalSum = 0.0, normalSquareSum = 0.0;
+	for (int id = 0; id < numSamples; ++id) {
+		double uniform[3], normal[3];
+		rng.uniform(id, 0, uniform, 3);
+		rng.normal(id, 1, normal, 3);
+		for (int d = 0; d < 3; ++d) {
+			ASSERT_TRUE(uniform[d] > 0.0);
+			ASSERT_TRUE(uniform[d] < 1.0);
+			uniformSum += uniform[d];
+			uniformSquareSum += uniform[d] * uniform[d];
+			normalSum += normal[d];
+			normalSquareSum += normal[d] * normal[d];
+		}
+	}
+	const double n = 3.0 * numSamples;
+	ASSERT_DOUBLES_EQUAL(0.5, uniformSum / n, 0.005);
+	ASSERT_DOUBLES_EQUAL(1.0 / 12.0, uniformSquareSum / n - (uniformSum / n) * (uniformSum / n), 0.002);
+	ASSERT_DOUBLES_EQUAL(0.0, normalSum / n, 0.01);
+	ASSERT_DOUBLES_EQUAL(1.0, normalSquareSum / n, 0.01);
+}
+
+void CounterBasedRandomTest::testBulkGeneration() {
+	const CounterBasedRandom rng(3, RNG_PURPOSE_CAVITY);
+	// more ids than fit into one chunk of lanes, ids using the upper 32 bits
+	const size_t numIds = 150;
+	std::vector<uint64_t> ids(numIds);
+	for (size_t i = 0; i < numIds; ++i) {
+		ids[i] = 7919 * i + (static_cast<uint64_t>(i) << 33);
+	}
+	const unsigned n = 5;
+	std::vector<double> uniformBulk(n * numIds), normalBulk(n * numIds);
+	rng.uniformBulk(ids.data(), numIds, 11, uniformBulk.data(), n);
+	rng.normalBulk(ids.data(), numIds, 11, normalBulk.data(), n);
+
+	for (size_t i = 0; i < numIds; ++i) {
+		double uniform[n], normal[n];
+		rng.uniform(ids[i], 11, uniform, n);
+		rng.normal(ids[i], 11, normal, n);
+		for (unsigned j = 0; j < n; ++j) {
+			ASSERT_EQUAL(uniform[j], uniformBulk[j * numIds + i]);
+			ASSERT_EQUAL(normal[j], normalBulk[j * numIds + i]);
+		}
+	}
+
+	// further numbers of a stream continue where the first ones ended
+	double first[4], second[2];
+	rng.uniform(ids[1], 11, first, 4);
+	rng.uniform(ids[1], 11, second, 2, 1);
+	ASSERT_EQUAL(first[2], second[0]);
+	ASSERT_EQUAL(first[3], second[1]);
+}
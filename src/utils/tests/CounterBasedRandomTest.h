@@ -0,0 +1,33 @@
+/*
+ * CounterBasedRandomTest.h
+ */
+
+#pragma once
+
+#include "../Testing.h"
+
+class CounterBasedRandomTest : public utils::Test {
+
+	TEST_SUITE(CounterBasedRandomTest);
+	TEST_METHOD(testKnownAnswers);
+	TEST_METHOD(testOrderIndependence);
+	TEST_METHOD(testDistributions);
+	TEST_METHOD(testBulkGeneration);
+	TEST_SUITE_END();
+
+public:
+	CounterBasedRandomTest() {}
+	virtual ~CounterBasedRandomTest() {}
+
+	/** Compare against the Philox4x32-10 known answer tests of the Random123 library. */
+	void testKnownAnswers();
+
+	/** Numbers of a stream must not depend on the thread which draws them or on other draws. */
+	void testOrderIndependence();
+
+	/** Check range, mean and variance of uniform and normal numbers. */
+	void testDistributions();
+
+	/** Bulk generation for many ids has to give the same numbers as drawing them id by id. */
+	void testBulkGeneration();
+};
@@ -0,0 +1,139 @@
+/*
+ * MemoryPoolTest.cpp
+ */
+
+#include "MemoryPoolTest.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "utils/MemoryPool.h"
+#include "utils/PoolAllocator.h"
+#include "WrapOpenMP.h"
+
+TEST_SUITE_REGISTRATION(MemoryPoolTest);
+
+void MemoryPoolTest::testSizeClasses() {
+	size_t previous = 0;
+	for (size_t numBytes = 1; numBytes < (size_t(1) << 24); numBytes = numBytes * 5 / 4 + 1) {
+		const size_t rounded = MemoryPool::roundUpToSizeClass(numBytes);
+		ASSERT_TRUE(rounded >= numBytes);
+		ASSERT_TRUE(rounded >= previous);
+		if (numBytes > 64) {
+			ASSERT_TRUE(rounded < numBytes + numBytes / 4 + 1);
+		}
+		previous = rounded;
+	}
+	// larger than the largest size class: not pooled
+	const size_t huge = size_t(1) << 31;
+	ASSERT_EQUAL(huge, MemoryPool::roundUpToSizeClass(huge));
+}
+
+void MemoryPoolTest::testReuseWithinThread() {
+	MemoryPool& pool = MemoryPool::instance();
+	pool.releaseThreadCache();
+	const size_t inUse = pool.getBytesInUse(MemoryPool::SOA);
+	const size_t numBytes = 3000;
+	const size_t blockSize = MemoryPool::roundUpToSizeClass(numBytes);
+
+	void* first = pool.allocate(numBytes, CACHE_LINE_SIZE, MemoryPool::SOA);
+	ASSERT_EQUAL(reinterpret_cast<uintptr_t>(first) % CACHE_LINE_SIZE, uintptr_t(0));
+	ASSERT_EQUAL(inUse + blockSize, pool.getBytesInUse(MemoryPool::SOA));
+	pool.deallocate(first, numBytes, CACHE_LINE_SIZE, MemoryPool::SOA);
+	ASSERT_EQUAL(inUse, pool.getBytesInUse(MemoryPool::SOA));
+
+	// any request of the same size class gets the cached block
+	void* second = pool.allocate(blockSize - 10, CACHE_LINE_SIZE, MemoryPool::SOA);
+	ASSERT_TRUE(first == second);
+	pool.deallocate(second, blockSize - 10, CACHE_LINE_SIZE, MemoryPool::SOA);
+
+	const size_t cached = pool.getBytesCached();
+	pool.releaseThreadCache();
+	ASSERT_EQUAL(cached - blockSize, pool.getBytesCached());
+}
+
+void MemoryPoolTest::testReuseAfterThreadExit() {
+	MemoryPool& pool = MemoryPool::instance();
+	pool.releaseThreadCache();
+	pool.releaseSharedCache();
+	const size_t numBytes = 100000;
+	const size_t blockSize = MemoryPool::roundUpToSizeClass(numBytes);
+	const size_t cached = pool.getBytesCached();
+
+	void* freedByOtherThread = nullptr;
+	std::thread worker([&]() {
+		freedByOtherThread = pool.allocate(numBytes, CACHE_LINE_SIZE, MemoryPool::COMMUNICATION);
+		pool.deallocate(freedByOtherThread, numBytes, CACHE_LINE_SIZE, MemoryPool::COMMUNICATION);
+	});
+	worker.join();
+	ASSERT_EQUAL(cached + blockSize, pool.getBytesCached());
+
+	void* reused = pool.allocate(numBytes, CACHE_LINE_SIZE, MemoryPool::COMMUNICATION);
+	ASSERT_TRUE(reused == freedByOtherThread);
+	ASSERT_EQUAL(cached, pool.getBytesCached());
+	pool.deallocate(reused, numBytes, CACHE_LINE_SIZE, MemoryPool::COMMUNICATION);
+	pool.releaseThreadCache();
+}
+
+void MemoryPoolTest::testConcurrentAllocation() {
+	MemoryPool& pool = MemoryPool::instance();
+	const size_t inUse = pool.getBytesInUse(MemoryPool::CELLS);
+	const int numBlocks = 200;
+	std::atomic<int> corruptedBlocks(0);
+
+	auto work = [&pool, &corruptedBlocks, numBlocks](int seed) {
+		std::vector<std::pair<void*, size_t>> blocks;
+		for (int round = 0; round < 5; ++round) {
+			for (int i = 0; i < numBlocks; ++i) {
+				const size_t numBytes = 64 + ((seed + 37 * i) % 50) * 97;
+				void* ptr = pool.allocate(numBytes, CACHE_LINE_SIZE, MemoryPool::CELLS);
+				// the block must be exclusively ours: write the whole block
+				std::fill(static_cast<char*>(ptr), static_cast<char*>(ptr) + numBytes, static_cast<char>(seed));
+				blocks.emplace_back(ptr, numBytes);
+			}
+			for (auto& block : blocks) {
+				const char* data = static_cast<const char*>(block.first);
+				if (data[0] != static_cast<char>(seed) or data[block.second - 1] != static_cast<char>(seed)) {
+					++corruptedBlocks;
+				}
+				pool.deallocate(block.first, block.second, CACHE_LINE_SIZE, MemoryPool::CELLS);
+			}
+			blocks.clear();
+		}
+	};
+
+	#if defined(_OPENMP)
+	#pragma omp parallel
+	#endif
+	work(10 + mardyn_get_thread_num());
+
+	std::vector<std::thread> workers;
+	for (int t = 0; t < 4; ++t) {
+		workers.emplace_back(work, t + 1);
+	}
+	for (auto& worker : workers) {
+		worker.join();
+	}
+
+	ASSERT_EQUAL(0, corruptedBlocks.load());
+	ASSERT_EQUAL(inUse, pool.getBytesInUse(MemoryPool::CELLS));
+
+	// the blocks of the exited threads are in the shared cache
+	const size_t cached = pool.getBytesCached();
+	pool.releaseSharedCache();
+	ASSERT_TRUE(pool.getBytesCached() < cached);
+}
+
+void MemoryPoolTest::testPoolAllocator() {
+	MemoryPool& pool = MemoryPool::instance();
+	const size_t inUse = pool.getBytesInUse(MemoryPool::SOA);
+	{
+		std::vector<double, PoolAllocator<double, MemoryPool::SOA>> v(1000, 1.0);
+		ASSERT_EQUAL(reinterpret_cast<uintptr_t>(v.data()) % CACHE_LINE_SIZE, uintptr_t(0));
+		ASSERT_EQUAL(inUse + MemoryPool::roundUpToSizeClass(1000 * sizeof(double)), pool.getBytesInUse(MemoryPool::SOA));
+	}
+	ASSERT_EQUAL(inUse, pool.getBytesInUse(MemoryPool::SOA));
+}
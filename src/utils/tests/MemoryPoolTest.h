@@ -0,0 +1,37 @@
+/*
+ * MemoryPoolTest.h
+ */
+
+#pragma once
+
+#include "../Testing.h"
+
+class MemoryPoolTest : public utils::Test {
+
+	TEST_SUITE(MemoryPoolTest);
+	TEST_METHOD(testSizeClasses);
+	TEST_METHOD(testReuseWithinThread);
+	TEST_METHOD(testReuseAfterThreadExit);
+	TEST_METHOD(testConcurrentAllocation);
+	TEST_METHOD(testPoolAllocator);
+	TEST_SUITE_END();
+
+public:
+	MemoryPoolTest() {}
+	virtual ~MemoryPoolTest() {}
+
+	/** Size classes cover each request with less than 25% waste and are increasing. */
+	void testSizeClasses();
+
+	/** A freed block is handed out again by the next allocation of its size class on the same thread. */
+	void testReuseWithinThread();
+
+	/** The blocks cached by a thread move to the shared cache when it exits and are reused by other threads. */
+	void testReuseAfterThreadExit();
+
+	/** Threads allocating and freeing concurrently keep the byte counts consistent. */
+	void testConcurrentAllocation();
+
+	/** std::vector with PoolAllocator accounts its memory to the subsystem. */
+	void testPoolAllocator();
+};
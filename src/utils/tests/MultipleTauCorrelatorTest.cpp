@@ -0,0 +1,68 @@
+#include "MultipleTauCorrelatorTest.h"
+#include "../MultipleTauCorrelator.h"
+
+#include <cmath>
+#include <vector>
+
+TEST_SUITE_REGISTRATION(MultipleTauCorrelatorTest);
+
+void MultipleTauCorrelatorTest::testLags() {
+	MultipleTauCorrelator correlator(1, 3, 4, 2);
+	const double value = 1.;
+	for (int i = 0; i < 100; i++) {
+		correlator.add(&value);
+	}
+	std::vector<unsigned long> lags;
+	std::vector<double> correlation;
+	correlator.getCorrelation(lags, correlation);
+
+	// level 0: 0..3, level 1: 2*2, 3*2, level 2: 2*4, 3*4
+	const std::vector<unsigned long> expected = {0, 1, 2, 3, 4, 6, 8, 12};
+	ASSERT_EQUAL(expected.size(), lags.size());
+	for (size_t i = 0; i < expected.size(); i++) {
+		ASSERT_EQUAL(expected[i], lags[i]);
+	}
+	ASSERT_EQUAL(100ul, correlator.getNumSamples());
+}
+
+void MultipleTauCorrelatorTest::testConstantSignal() {
+	// the averages of all levels are the constant again, the correlation of every lag is its square
+	MultipleTauCorrelator correlator(3, 4, 8, 4);
+	const double values[3] = {2., -1., 3.};
+	for (int i = 0; i < 1000; i++) {
+		correlator.add(values);
+	}
+	std::vector<unsigned long> lags;
+	std::vector<double> correlation;
+	correlator.getCorrelation(lags, correlation);
+	ASSERT_TRUE(not correlation.empty());
+	for (double c : correlation) {
+		ASSERT_DOUBLES_EQUAL((4. + 1. + 9.) / 3., c, 1e-12);
+	}
+}
+
+void MultipleTauCorrelatorTest::testFirstLevelExact() {
+	// the lags of level 0 are the plain time average of x(t) * x(t - lag)
+	const unsigned points = 8;
+	std::vector<double> series;
+	for (int i = 0; i < 200; i++) {
+		series.push_back(std::sin(0.3 * i) + 0.1 * ((i * 7919) % 13));
+	}
+
+	MultipleTauCorrelator correlator(1, 5, points, 2);
+	for (double x : series) {
+		correlator.add(&x);
+	}
+	std::vector<unsigned long> lags;
+	std::vector<double> correlation;
+	correlator.getCorrelation(lags, correlation);
+
+	for (unsigned lag = 0; lag < points; lag++) {
+		double sum = 0.;
+		for (size_t t = lag; t < series.size(); t++) {
+			sum += series[t] * series[t - lag];
+		}
+		ASSERT_EQUAL(static_cast<unsigned long>(lag), lags[lag]);
+		ASSERT_DOUBLES_EQUAL(sum / (series.size() - lag), correlation[lag], 1e-12);
+	}
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "../Testing.h"
+
+class MultipleTauCorrelatorTest : public utils::Test {
+	TEST_SUITE(MultipleTauCorrelatorTest);
+	TEST_METHOD(testLags);
+	TEST_METHOD(testConstantSignal);
+	TEST_METHOD(testFirstLevelExact);
+	TEST_SUITE_END();
+
+public:
+	static void testLags();
+	static void testConstantSignal();
+	static void testFirstLevelExact();
+};
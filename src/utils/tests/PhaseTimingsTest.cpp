@@ -0,0 +1,48 @@
+#include "PhaseTimingsTest.h"
+#include "../PhaseTimings.h"
+
+#include <vector>
+
+TEST_SUITE_REGISTRATION(PhaseTimingsTest);
+
+void PhaseTimingsTest::testPercentile() {
+	const std::vector<double> samples = {1., 2., 3., 4., 5.};
+	ASSERT_DOUBLES_EQUAL(1., PhaseTimings::percentile(samples, 0.), 1e-15);
+	ASSERT_DOUBLES_EQUAL(3., PhaseTimings::percentile(samples, 50.), 1e-15);
+	ASSERT_DOUBLES_EQUAL(4.6, PhaseTimings::percentile(samples, 90.), 1e-15);
+	ASSERT_DOUBLES_EQUAL(5., PhaseTimings::percentile(samples, 100.), 1e-15);
+
+	const std::vector<double> single = {7.};
+	ASSERT_DOUBLES_EQUAL(7., PhaseTimings::percentile(single, 90.), 1e-15);
+}
+
+void PhaseTimingsTest::testSummary() {
+	PhaseTimings timings;
+	// unsorted on purpose
+	for (double t : {4., 1., 3., 2.}) {
+		timings.add("traversal", t);
+	}
+	const auto summary = timings.getSummary("traversal");
+	ASSERT_EQUAL(4ul, summary.count);
+	ASSERT_DOUBLES_EQUAL(2.5, summary.mean, 1e-15);
+	ASSERT_DOUBLES_EQUAL(1., summary.min, 1e-15);
+	ASSERT_DOUBLES_EQUAL(2.5, summary.median, 1e-15);
+	ASSERT_DOUBLES_EQUAL(3.7, summary.p90, 1e-15);
+	ASSERT_DOUBLES_EQUAL(4., summary.max, 1e-15);
+
+	ASSERT_EQUAL(0ul, timings.getSummary("unknown").count);
+}
+
+void PhaseTimingsTest::testPhaseOrder() {
+	PhaseTimings timings;
+	timings.add("update", 1.);
+	timings.add("exchange", 1.);
+	timings.add("update", 2.);
+	timings.add("caches", 1.);
+	const std::vector<std::string> expected = {"update", "exchange", "caches"};
+	ASSERT_EQUAL(expected.size(), timings.getPhases().size());
+	for (size_t i = 0; i < expected.size(); i++) {
+		ASSERT_EQUAL(expected[i], timings.getPhases()[i]);
+	}
+	ASSERT_EQUAL(2ul, timings.getSummary("update").count);
+}
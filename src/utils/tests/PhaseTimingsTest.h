@@ -0,0 +1,16 @@
+#pragma once
+
+#include "../Testing.h"
+
+class PhaseTimingsTest : public utils::Test {
+	TEST_SUITE(PhaseTimingsTest);
+	TEST_METHOD(testPercentile);
+	TEST_METHOD(testSummary);
+	TEST_METHOD(testPhaseOrder);
+	TEST_SUITE_END();
+
+public:
+	static void testPercentile();
+	static void testSummary();
+	static void testPhaseOrder();
+};